@@ -1,7 +1,6 @@
 #version 410 core
 
-#define MAX_LIGHTS 128
-#define MAX_SHADOW_MAPS_2D 16
+#define LIGHT_RECORD_TEXELS 7
 #define MAX_SHADOW_MAPS_CUBE 2
 #define PI 3.14159265359
 
@@ -14,6 +13,7 @@ struct Light {
     vec4 shadow;             // x=bias, y=normalBias, z=cascadeCount, w=debugMode
     vec4 cascadeSplits;      // view-space split distances
     mat4 lightMatrices[4];   // directional cascades / spot uses [0]
+    vec4 shadowAtlasRects[4]; // per cascade atlas tile: xy=uv offset, zw=uv scale
 };
 
 in vec2 v_uv;
@@ -24,7 +24,6 @@ uniform sampler2D gNormal;
 uniform sampler2D gMaterial;
 uniform sampler2D gSurface;
 uniform sampler2D gDepth;
-uniform isampler2D gTileLightData;
 uniform sampler2D gSsaoRaw;
 uniform sampler2D gSsao;
 uniform sampler2D gGi;
@@ -53,19 +52,129 @@ uniform int u_useGi;
 uniform float u_ssaoIntensity;
 uniform int u_ssaoDebugView;
 uniform int u_lightPassMode; // 0=final composite, 1=direct diffuse prepass
-uniform int u_useLightTiles;
-uniform vec2 u_tileGrid;
-uniform int u_tileSize;
 uniform int u_debugShadows; // 0=off,1=visibility,2=cascade index,3=proj bounds
 uniform int u_debugSelectedLightIndex;
 uniform float u_shadowReceiverNormalBlend;
-uniform sampler2D u_shadowMaps2D[MAX_SHADOW_MAPS_2D];
+uniform sampler2D u_shadowAtlas;
 uniform samplerCubeShadow u_shadowMapsCube[MAX_SHADOW_MAPS_CUBE];
 
+// Feature switches; see Shader_Frag_PBR.frag. Scene picks the permutation per light pass.
+#ifdef SHADER_VARIANT
+    #ifdef USE_ENV_MAP
+        #define HAS_ENV_MAP true
+    #else
+        #define HAS_ENV_MAP false
+    #endif
+    #ifdef USE_LOCAL_PROBE
+        #define HAS_LOCAL_PROBE true
+    #else
+        #define HAS_LOCAL_PROBE false
+    #endif
+    #ifdef USE_FOG
+        #define HAS_FOG true
+    #else
+        #define HAS_FOG false
+    #endif
+    #ifdef USE_SSAO
+        #define HAS_SSAO true
+    #else
+        #define HAS_SSAO false
+    #endif
+    #ifdef USE_GI
+        #define HAS_GI true
+    #else
+        #define HAS_GI false
+    #endif
+#else
+    #define HAS_ENV_MAP     (u_useEnvMap != 0)
+    #define HAS_LOCAL_PROBE (u_useLocalProbe != 0)
+    #define HAS_FOG         (u_fogEnabled != 0)
+    #define HAS_SSAO        (u_useSsao != 0)
+    #define HAS_GI          (u_useGi != 0)
+#endif
+
 layout(std140) uniform LightBlock {
-    vec4 u_lightHeader;      // x=lightCount
-    Light u_lights[MAX_LIGHTS];
+    vec4 u_lightHeader;        // x=lightCount, y=clustersEnabled, z=cluster range texel, w=cluster index texel
+    vec4 u_clusterGrid;        // x=tilesX, y=tilesY, z=sliceCount, w=tile size in pixels
+    vec4 u_clusterDepth;       // x=near, y=far, z=slice scale, w=slice bias
+    vec4 u_clusterProjection;  // x=tan(fovX/2), y=tan(fovY/2), z=viewport width, w=viewport height
+    mat4 u_clusterView;
 };
+uniform samplerBuffer u_lightBuffer; // light records, shadow records, cluster ranges, cluster light indices
+
+// Mirrors the u_lightBuffer packing in LightUtils.cpp (LightRecord, LightShadowRecord and the
+// cluster tables). fetchLight() through getClusterLightIndex() are kept identical in every
+// forward, PBR and deferred-light fragment shader; change them all together with the packer.
+Light fetchLight(int lightIndex){
+    int base = lightIndex * LIGHT_RECORD_TEXELS;
+    Light light;
+    light.meta = texelFetch(u_lightBuffer, base + 0);
+    light.position = texelFetch(u_lightBuffer, base + 1);
+    light.direction = texelFetch(u_lightBuffer, base + 2);
+    light.color = texelFetch(u_lightBuffer, base + 3);
+    light.params = texelFetch(u_lightBuffer, base + 4);
+    light.shadow = texelFetch(u_lightBuffer, base + 5);
+    light.cascadeSplits = texelFetch(u_lightBuffer, base + 6);
+
+    int shadowBase = int(light.position.w);
+    for(int m = 0; m < 4; ++m){
+        if(shadowBase >= 0){
+            int matrixBase = shadowBase + (m * 4);
+            light.lightMatrices[m] = mat4(
+                texelFetch(u_lightBuffer, matrixBase + 0),
+                texelFetch(u_lightBuffer, matrixBase + 1),
+                texelFetch(u_lightBuffer, matrixBase + 2),
+                texelFetch(u_lightBuffer, matrixBase + 3)
+            );
+            light.shadowAtlasRects[m] = texelFetch(u_lightBuffer, shadowBase + 16 + m);
+        }else{
+            light.lightMatrices[m] = mat4(1.0);
+            light.shadowAtlasRects[m] = vec4(0.0);
+        }
+    }
+    return light;
+}
+
+// Returns -1 when worldPos is outside the cluster grid; callers then walk every light.
+int findLightCluster(vec3 worldPos){
+    if(u_lightHeader.y < 0.5){
+        return -1;
+    }
+    vec3 viewPos = (u_clusterView * vec4(worldPos, 1.0)).xyz;
+    float depth = -viewPos.z;
+    if(depth <= u_clusterDepth.x || depth >= u_clusterDepth.y){
+        return -1;
+    }
+    vec2 ndc = viewPos.xy / (depth * u_clusterProjection.xy);
+    if(abs(ndc.x) >= 1.0 || abs(ndc.y) >= 1.0){
+        return -1;
+    }
+
+    ivec3 grid = ivec3(u_clusterGrid.xyz + vec3(0.5));
+    ivec2 tile = ivec2(((ndc * 0.5) + 0.5) * u_clusterProjection.zw / u_clusterGrid.w);
+    int slice = int(floor((log(depth) * u_clusterDepth.z) + u_clusterDepth.w));
+    tile = clamp(tile, ivec2(0), grid.xy - ivec2(1));
+    slice = clamp(slice, 0, grid.z - 1);
+    return tile.x + (tile.y * grid.x) + (slice * grid.x * grid.y);
+}
+
+// x=first list entry, y=light count.
+ivec2 getLightClusterRange(int clusterIndex){
+    if(clusterIndex < 0){
+        return ivec2(0, int(u_lightHeader.x + 0.5));
+    }
+    vec4 range = texelFetch(u_lightBuffer, int(u_lightHeader.z + 0.5) + clusterIndex);
+    return ivec2(range.xy + vec2(0.5));
+}
+
+int getClusterLightIndex(int clusterIndex, ivec2 clusterRange, int listIndex){
+    if(clusterIndex < 0){
+        return listIndex;
+    }
+    int entry = clusterRange.x + listIndex;
+    vec4 packedIndices = texelFetch(u_lightBuffer, int(u_lightHeader.w + 0.5) + (entry / 4));
+    return int(packedIndices[entry % 4] + 0.5);
+}
 
 int resolveEffectiveShadowType(int lightIndex, Light light);
 
@@ -93,32 +202,6 @@ ivec2 getDeferredPixelCoord(vec2 uv){
     return ivec2(pixel);
 }
 
-ivec2 getDeferredTileCoord(vec2 uv){
-    ivec2 tileGrid = max(ivec2(u_tileGrid + vec2(0.5)), ivec2(1));
-    ivec2 tileCoord = getDeferredPixelCoord(uv) / max(u_tileSize, 1);
-    return clamp(tileCoord, ivec2(0), tileGrid - ivec2(1));
-}
-
-int getDeferredTileIndex(vec2 uv){
-    ivec2 tileGrid = max(ivec2(u_tileGrid + vec2(0.5)), ivec2(1));
-    ivec2 tileCoord = getDeferredTileCoord(uv);
-    return tileCoord.x + (tileCoord.y * tileGrid.x);
-}
-
-int getDeferredLightCount(int tileIndex, int fallbackLightCount){
-    if(u_useLightTiles == 0){
-        return fallbackLightCount;
-    }
-    return clamp(texelFetch(gTileLightData, ivec2(0, tileIndex), 0).r, 0, MAX_LIGHTS);
-}
-
-int getDeferredLightIndex(int tileIndex, int listIndex){
-    if(u_useLightTiles == 0){
-        return listIndex;
-    }
-    return texelFetch(gTileLightData, ivec2(listIndex + 1, tileIndex), 0).r;
-}
-
 vec3 getShadowDirection(Light light, vec3 fragPos){
     int lightType = int(light.meta.x + 0.5);
     return (lightType == 1)
@@ -156,20 +239,21 @@ float computeSpotConeAttenuation(vec3 lightToFragDir, vec3 spotForwardDir, float
     return smoothstep(cosOuter, cosInner, cosTheta);
 }
 
-float compareShadowDepth2D(int mapIndex, vec2 uv, float compareDepth){
-    float storedDepth = texture(u_shadowMaps2D[mapIndex], uv).r;
+float compareShadowDepth2D(vec4 atlasRect, vec2 uv, float compareDepth){
+    float storedDepth = texture(u_shadowAtlas, atlasRect.xy + uv * atlasRect.zw).r;
     return (compareDepth <= storedDepth) ? 1.0 : 0.0;
 }
 
-float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bias, float filterScale, vec3 receiverPos, float receiverGradScale) {
-    if(mapIndex < 0 || mapIndex >= MAX_SHADOW_MAPS_2D) return 1.0;
+float sampleShadow2D(int shadowType, int mapIndex, vec4 atlasRect, vec4 lightSpacePos, float bias, float filterScale, vec3 receiverPos, float receiverGradScale) {
+    if(atlasRect.z <= 0.0 || atlasRect.w <= 0.0) return 1.0;
 
     vec3 projCoords = lightSpacePos.xyz / lightSpacePos.w;
     projCoords = projCoords * 0.5 + 0.5;
     if(projCoords.z > 1.001 || projCoords.z < -0.001) return 1.0;
     if(projCoords.x < 0.0 || projCoords.x > 1.0 || projCoords.y < 0.0 || projCoords.y > 1.0) return 1.0;
 
-    vec2 texelSize = 1.0 / vec2(textureSize(u_shadowMaps2D[mapIndex], 0));
+    // Filtering runs in tile-local UVs; one texel of the tile is 1 / (atlas texels * tile scale).
+    vec2 texelSize = 1.0 / (vec2(textureSize(u_shadowAtlas, 0)) * atlasRect.zw);
     float clampedFilterScale = max(filterScale, 0.5);
     vec2 pcfTexel = texelSize * clampedFilterScale;
     float pcfBias = 0.0;
@@ -227,7 +311,7 @@ float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bia
     mat2 kernelRot = rotate2D(rotation);
 
     if(shadowType == 0){
-        return compareShadowDepth2D(mapIndex, clamp(projCoords.xy, uvMin, uvMax), compareDepth);
+        return compareShadowDepth2D(atlasRect, clamp(projCoords.xy, uvMin, uvMax), compareDepth);
     }
 
     float shadow = 0.0;
@@ -251,7 +335,7 @@ float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bia
             float weight = 1.0 - smoothstep(0.75, 1.10, length(kernel[i]));
             float receiverOffset = clamp(dot(receiverDepthGrad, tapOffset), -0.00045 * clampedFilterScale, 0.00045 * clampedFilterScale);
             float compareDepthTap = clamp(compareDepth + receiverOffset, 0.0, 1.0);
-            shadow += compareShadowDepth2D(mapIndex, sampleUv, compareDepthTap) * weight;
+            shadow += compareShadowDepth2D(atlasRect, sampleUv, compareDepthTap) * weight;
             weightSum += weight;
         }
     }else{
@@ -272,7 +356,7 @@ float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bia
             float weight = 1.0 - smoothstep(0.70, 1.15, length(kernel[i]));
             float receiverOffset = clamp(dot(receiverDepthGrad, tapOffset), -0.00075 * clampedFilterScale, 0.00075 * clampedFilterScale);
             float compareDepthTap = clamp(compareDepth + receiverOffset, 0.0, 1.0);
-            shadow += compareShadowDepth2D(mapIndex, sampleUv, compareDepthTap) * weight;
+            shadow += compareShadowDepth2D(atlasRect, sampleUv, compareDepthTap) * weight;
             weightSum += weight;
         }
     }
@@ -502,13 +586,13 @@ float sampleShadowForLight(int lightIndex, Light light, vec3 normal, vec3 fragPo
         }
     }
     vec4 lightSpacePos = light.lightMatrices[cascadeIndex] * vec4(receiverPos, 1.0);
-    float visibility = sampleShadow2D(shadowType, baseIndex + cascadeIndex, lightSpacePos, bias, filterScale, receiverPos, receiverGradScale);
+    float visibility = sampleShadow2D(shadowType, baseIndex + cascadeIndex, light.shadowAtlasRects[cascadeIndex], lightSpacePos, bias, filterScale, receiverPos, receiverGradScale);
     if(lightType == 1 && cascadeCount > 1 && cascadeIndex == (cascadeCount - 1) && shadowType != 0){
         float prevSplit = (cascadeIndex > 0) ? light.cascadeSplits[cascadeIndex - 1] : 0.0;
         float splitDist = light.cascadeSplits[cascadeIndex];
         float cascadeSpan = max(splitDist - prevSplit, 0.001);
         float localCascadeT = clamp((viewDepth - prevSplit) / cascadeSpan, 0.0, 1.0);
-        float hardVisibility = sampleShadow2D(0, baseIndex + cascadeIndex, lightSpacePos, bias, 1.0, receiverPos, 0.0);
+        float hardVisibility = sampleShadow2D(0, baseIndex + cascadeIndex, light.shadowAtlasRects[cascadeIndex], lightSpacePos, bias, 1.0, receiverPos, 0.0);
         float filterToHard = smoothstep(0.25, 0.95, localCascadeT);
         visibility = mix(visibility, hardVisibility, filterToHard);
     }
@@ -525,7 +609,7 @@ float sampleShadowForLight(int lightIndex, Light light, vec3 normal, vec3 fragPo
         float blendT = clamp((viewDepth - blendStart) / blendRange, 0.0, 1.0);
         if(blendT > 0.0){
             vec4 nextLightSpacePos = light.lightMatrices[cascadeIndex + 1] * vec4(receiverPos, 1.0);
-            float nextVisibility = sampleShadow2D(shadowType, baseIndex + cascadeIndex + 1, nextLightSpacePos, bias, filterScale, receiverPos, receiverGradScale);
+            float nextVisibility = sampleShadow2D(shadowType, baseIndex + cascadeIndex + 1, light.shadowAtlasRects[cascadeIndex + 1], nextLightSpacePos, bias, filterScale, receiverPos, receiverGradScale);
             visibility = mix(visibility, nextVisibility, blendT);
         }
     }
@@ -585,7 +669,7 @@ vec3 sampleCubeSpecular(samplerCube cubeMap, vec3 reflectionDir, float roughness
 }
 
 float computeLocalProbeInfluence(vec3 worldPos){
-    if(u_useLocalProbe == 0){
+    if(!HAS_LOCAL_PROBE){
         return 0.0;
     }
     vec3 probeCenter = (u_localProbeInfluenceMin + u_localProbeInfluenceMax) * 0.5;
@@ -626,7 +710,7 @@ vec3 sampleEnvironmentSpecular(vec3 reflectionDir, float roughness){
 }
 
 float computeFogFactor(float distanceToCamera){
-    if(u_fogEnabled == 0){
+    if(!HAS_FOG){
         return 0.0;
     }
 
@@ -719,7 +803,7 @@ void main(){
     }
 
     if(u_lightPassMode != 1){
-        if(u_useSsao != 0){
+        if(HAS_SSAO){
             ssaoBlur = clamp(texture(gSsao, v_uv).r, 0.0, 1.0);
             float ssaoOcclusion = clamp(1.0 - ssaoBlur, 0.0, 1.0);
             ssaoFactor = 1.0 - (ssaoOcclusion * max(u_ssaoIntensity, 0.0));
@@ -729,7 +813,7 @@ void main(){
         }
         ssaoFactor = clamp(ssaoFactor, 0.0, 1.0);
         combinedAo = clamp(ao * ssaoFactor, 0.0, 1.0);
-        if(u_useGi != 0){
+        if(HAS_GI){
             giIrradiance = max(texture(gGi, v_uv).rgb, vec3(0.0));
         }
     }
@@ -763,9 +847,8 @@ void main(){
     vec3 N = safeNormalize(normalMetal.rgb);
     vec3 V = safeNormalize(u_viewPos - fragPos);
     vec3 shadowNormal = computeShadowNormal(N, fragPos);
-    int fallbackLightCount = int(u_lightHeader.x + 0.5);
-    int tileIndex = getDeferredTileIndex(v_uv);
-    int lightCount = getDeferredLightCount(tileIndex, fallbackLightCount);
+    int clusterIndex = findLightCluster(fragPos);
+    ivec2 clusterRange = getLightClusterRange(clusterIndex);
 
     bool legacyUnlit = (packedMode < -0.75);
     bool legacyLit = (packedMode < 0.0 && !legacyUnlit);
@@ -784,12 +867,9 @@ void main(){
     if(legacyLit){
         vec3 LoLegacyDiffuse = vec3(0.0);
         vec3 LoLegacySpec = vec3(0.0);
-        for(int listIndex = 0; listIndex < lightCount && listIndex < MAX_LIGHTS; ++listIndex){
-            int i = getDeferredLightIndex(tileIndex, listIndex);
-            if(i < 0 || i >= MAX_LIGHTS){
-                continue;
-            }
-            Light light = u_lights[i];
+        for(int listIndex = 0; listIndex < clusterRange.y; ++listIndex){
+            int i = getClusterLightIndex(clusterIndex, clusterRange, listIndex);
+            Light light = fetchLight(i);
             int lightType = int(light.meta.x + 0.5);
 
             vec3 L = vec3(0.0);
@@ -872,12 +952,9 @@ void main(){
     vec3 LoSpecular = vec3(0.0);
     vec3 debugColorAccum = vec3(0.0);
     float debugWeight = 0.0;
-    for(int listIndex = 0; listIndex < lightCount && listIndex < MAX_LIGHTS; ++listIndex){
-        int i = getDeferredLightIndex(tileIndex, listIndex);
-        if(i < 0 || i >= MAX_LIGHTS){
-            continue;
-        }
-        Light light = u_lights[i];
+    for(int listIndex = 0; listIndex < clusterRange.y; ++listIndex){
+        int i = getClusterLightIndex(clusterIndex, clusterRange, listIndex);
+        Light light = fetchLight(i);
         int lightType = int(light.meta.x + 0.5);
         int debugModeForLight = resolveShadowDebugMode(i, light);
 
@@ -1023,18 +1100,18 @@ void main(){
         ambient *= 0.45;
     }
     vec3 envSpec = vec3(0.0);
-    if(u_useEnvMap != 0 || u_useLocalProbe != 0){
+    if(HAS_ENV_MAP || HAS_LOCAL_PROBE){
         vec3 R = reflect(-V, N);
         float NdotV = max(dot(N, V), 0.0);
         vec3 Fenv = FresnelSchlickRoughness(NdotV, F0, roughness);
         float localProbeInfluence = computeLocalProbeInfluence(fragPos);
         vec3 envSample = vec3(0.0);
-        if(u_useEnvMap != 0){
+        if(HAS_ENV_MAP){
             envSample = sampleEnvironmentSpecular(R, roughness);
         }
         if(localProbeInfluence > 1e-4){
             vec3 localProbeSample = sampleLocalProbeSpecular(fragPos, R, roughness);
-            envSample = (u_useEnvMap != 0)
+            envSample = HAS_ENV_MAP
                 ? mix(envSample, localProbeSample, localProbeInfluence)
                 : localProbeSample;
         }
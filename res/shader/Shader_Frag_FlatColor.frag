@@ -1,7 +1,6 @@
 #version 410 core
 
-#define MAX_LIGHTS 128
-#define MAX_SHADOW_MAPS_2D 16
+#define LIGHT_RECORD_TEXELS 7
 #define MAX_SHADOW_MAPS_CUBE 2
 
 struct Light {
@@ -13,6 +12,7 @@ struct Light {
     vec4 shadow;         // x=bias, y=normalBias, z=cascadeCount, w=debugMode
     vec4 cascadeSplits;  // view-space split distances
     mat4 lightMatrices[4];   // directional cascades / spot uses [0]
+    vec4 shadowAtlasRects[4]; // per cascade atlas tile: xy=uv offset, zw=uv scale
 };
     
 in vec3 v_fragPos;
@@ -30,11 +30,89 @@ uniform int u_debugShadows; // 0=off,1=visibility,2=cascade index,3=proj bounds
 uniform int u_debugSelectedLightIndex;
 
 layout(std140) uniform LightBlock {
-    vec4 u_lightHeader;  // x=lightCount
-    Light u_lights[MAX_LIGHTS];
+    vec4 u_lightHeader;        // x=lightCount, y=clustersEnabled, z=cluster range texel, w=cluster index texel
+    vec4 u_clusterGrid;        // x=tilesX, y=tilesY, z=sliceCount, w=tile size in pixels
+    vec4 u_clusterDepth;       // x=near, y=far, z=slice scale, w=slice bias
+    vec4 u_clusterProjection;  // x=tan(fovX/2), y=tan(fovY/2), z=viewport width, w=viewport height
+    mat4 u_clusterView;
 };
+uniform samplerBuffer u_lightBuffer; // light records, shadow records, cluster ranges, cluster light indices
+
+// Mirrors the u_lightBuffer packing in LightUtils.cpp (LightRecord, LightShadowRecord and the
+// cluster tables). fetchLight() through getClusterLightIndex() are kept identical in every
+// forward, PBR and deferred-light fragment shader; change them all together with the packer.
+Light fetchLight(int lightIndex){
+    int base = lightIndex * LIGHT_RECORD_TEXELS;
+    Light light;
+    light.meta = texelFetch(u_lightBuffer, base + 0);
+    light.position = texelFetch(u_lightBuffer, base + 1);
+    light.direction = texelFetch(u_lightBuffer, base + 2);
+    light.color = texelFetch(u_lightBuffer, base + 3);
+    light.params = texelFetch(u_lightBuffer, base + 4);
+    light.shadow = texelFetch(u_lightBuffer, base + 5);
+    light.cascadeSplits = texelFetch(u_lightBuffer, base + 6);
+
+    int shadowBase = int(light.position.w);
+    for(int m = 0; m < 4; ++m){
+        if(shadowBase >= 0){
+            int matrixBase = shadowBase + (m * 4);
+            light.lightMatrices[m] = mat4(
+                texelFetch(u_lightBuffer, matrixBase + 0),
+                texelFetch(u_lightBuffer, matrixBase + 1),
+                texelFetch(u_lightBuffer, matrixBase + 2),
+                texelFetch(u_lightBuffer, matrixBase + 3)
+            );
+            light.shadowAtlasRects[m] = texelFetch(u_lightBuffer, shadowBase + 16 + m);
+        }else{
+            light.lightMatrices[m] = mat4(1.0);
+            light.shadowAtlasRects[m] = vec4(0.0);
+        }
+    }
+    return light;
+}
+
+// Returns -1 when worldPos is outside the cluster grid; callers then walk every light.
+int findLightCluster(vec3 worldPos){
+    if(u_lightHeader.y < 0.5){
+        return -1;
+    }
+    vec3 viewPos = (u_clusterView * vec4(worldPos, 1.0)).xyz;
+    float depth = -viewPos.z;
+    if(depth <= u_clusterDepth.x || depth >= u_clusterDepth.y){
+        return -1;
+    }
+    vec2 ndc = viewPos.xy / (depth * u_clusterProjection.xy);
+    if(abs(ndc.x) >= 1.0 || abs(ndc.y) >= 1.0){
+        return -1;
+    }
+
+    ivec3 grid = ivec3(u_clusterGrid.xyz + vec3(0.5));
+    ivec2 tile = ivec2(((ndc * 0.5) + 0.5) * u_clusterProjection.zw / u_clusterGrid.w);
+    int slice = int(floor((log(depth) * u_clusterDepth.z) + u_clusterDepth.w));
+    tile = clamp(tile, ivec2(0), grid.xy - ivec2(1));
+    slice = clamp(slice, 0, grid.z - 1);
+    return tile.x + (tile.y * grid.x) + (slice * grid.x * grid.y);
+}
+
+// x=first list entry, y=light count.
+ivec2 getLightClusterRange(int clusterIndex){
+    if(clusterIndex < 0){
+        return ivec2(0, int(u_lightHeader.x + 0.5));
+    }
+    vec4 range = texelFetch(u_lightBuffer, int(u_lightHeader.z + 0.5) + clusterIndex);
+    return ivec2(range.xy + vec2(0.5));
+}
+
+int getClusterLightIndex(int clusterIndex, ivec2 clusterRange, int listIndex){
+    if(clusterIndex < 0){
+        return listIndex;
+    }
+    int entry = clusterRange.x + listIndex;
+    vec4 packedIndices = texelFetch(u_lightBuffer, int(u_lightHeader.w + 0.5) + (entry / 4));
+    return int(packedIndices[entry % 4] + 0.5);
+}
 
-uniform sampler2D u_shadowMaps2D[MAX_SHADOW_MAPS_2D];
+uniform sampler2D u_shadowAtlas;
 uniform samplerCubeShadow u_shadowMapsCube[MAX_SHADOW_MAPS_CUBE];
 
 vec3 safeNormalize(vec3 v){
@@ -62,20 +140,21 @@ mat2 rotate2D(float angle){
 }
 
 
-float compareShadowDepth2D(int mapIndex, vec2 uv, float compareDepth){
-    float storedDepth = texture(u_shadowMaps2D[mapIndex], uv).r;
+float compareShadowDepth2D(vec4 atlasRect, vec2 uv, float compareDepth){
+    float storedDepth = texture(u_shadowAtlas, atlasRect.xy + uv * atlasRect.zw).r;
     return (compareDepth <= storedDepth) ? 1.0 : 0.0;
 }
 
-float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bias, float filterScale, vec3 receiverPos, float receiverGradScale) {
-    if(mapIndex < 0 || mapIndex >= MAX_SHADOW_MAPS_2D) return 1.0;
+float sampleShadow2D(int shadowType, int mapIndex, vec4 atlasRect, vec4 lightSpacePos, float bias, float filterScale, vec3 receiverPos, float receiverGradScale) {
+    if(atlasRect.z <= 0.0 || atlasRect.w <= 0.0) return 1.0;
 
     vec3 projCoords = lightSpacePos.xyz / lightSpacePos.w;
     projCoords = projCoords * 0.5 + 0.5;
     if(projCoords.z > 1.001 || projCoords.z < -0.001) return 1.0;
     if(projCoords.x < 0.0 || projCoords.x > 1.0 || projCoords.y < 0.0 || projCoords.y > 1.0) return 1.0;
 
-    vec2 texelSize = 1.0 / vec2(textureSize(u_shadowMaps2D[mapIndex], 0));
+    // Filtering runs in tile-local UVs; one texel of the tile is 1 / (atlas texels * tile scale).
+    vec2 texelSize = 1.0 / (vec2(textureSize(u_shadowAtlas, 0)) * atlasRect.zw);
     float clampedFilterScale = max(filterScale, 0.5);
     vec2 pcfTexel = texelSize * clampedFilterScale;
     float pcfBias = 0.0;
@@ -119,7 +198,7 @@ float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bia
     mat2 kernelRot = rotate2D(rotation);
 
     if(shadowType == 0){
-        return compareShadowDepth2D(mapIndex, clamp(projCoords.xy, uvMin, uvMax), compareDepth);
+        return compareShadowDepth2D(atlasRect, clamp(projCoords.xy, uvMin, uvMax), compareDepth);
     }
 
     float shadow = 0.0;
@@ -143,7 +222,7 @@ float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bia
             float weight = 1.0 - smoothstep(0.75, 1.10, length(kernel[i]));
             float receiverOffset = clamp(dot(receiverDepthGrad, tapOffset), -0.0012 * clampedFilterScale, 0.0012 * clampedFilterScale);
             float compareDepthTap = clamp(compareDepth + receiverOffset, 0.0, 1.0);
-            shadow += compareShadowDepth2D(mapIndex, sampleUv, compareDepthTap) * weight;
+            shadow += compareShadowDepth2D(atlasRect, sampleUv, compareDepthTap) * weight;
             weightSum += weight;
         }
     }else{
@@ -164,7 +243,7 @@ float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bia
             float weight = 1.0 - smoothstep(0.70, 1.15, length(kernel[i]));
             float receiverOffset = clamp(dot(receiverDepthGrad, tapOffset), -0.0020 * clampedFilterScale, 0.0020 * clampedFilterScale);
             float compareDepthTap = clamp(compareDepth + receiverOffset, 0.0, 1.0);
-            shadow += compareShadowDepth2D(mapIndex, sampleUv, compareDepthTap) * weight;
+            shadow += compareShadowDepth2D(atlasRect, sampleUv, compareDepthTap) * weight;
             weightSum += weight;
         }
     }
@@ -387,9 +466,11 @@ void main() {
     vec3 totalLight = vec3(0.0);
     vec3 debugColorAccum = vec3(0.0);
     float debugWeight = 0.0;
-    int lightCount = int(u_lightHeader.x + 0.5);
-    for (int i = 0; i < lightCount && i < MAX_LIGHTS; i++) {
-        Light light = u_lights[i];
+    int clusterIndex = findLightCluster(v_fragPos);
+    ivec2 clusterRange = getLightClusterRange(clusterIndex);
+    for (int listIndex = 0; listIndex < clusterRange.y; listIndex++) {
+        int i = getClusterLightIndex(clusterIndex, clusterRange, listIndex);
+        Light light = fetchLight(i);
         int debugModeForLight = resolveShadowDebugMode(i, light);
         vec3 lightContribution = calculateLight(light, norm, v_fragPos);
 
@@ -444,13 +525,13 @@ void main() {
                                              projCoords.z < 0.0 || projCoords.z > 1.0);
                     projectionDepth = clamp(projCoords.z, 0.0, 1.0);
                 }
-                visibility = sampleShadow2D(sType, baseIndex + cascadeIndex, lightSpacePos, bias, filterScale, shadowPos, receiverGradScale);
+                visibility = sampleShadow2D(sType, baseIndex + cascadeIndex, light.shadowAtlasRects[cascadeIndex], lightSpacePos, bias, filterScale, shadowPos, receiverGradScale);
                 if(lType == 1 && cascadeCount > 1 && cascadeIndex == (cascadeCount - 1) && sType != 0){
                     float prevSplit = (cascadeIndex > 0) ? light.cascadeSplits[cascadeIndex - 1] : 0.0;
                     float splitDist = light.cascadeSplits[cascadeIndex];
                     float cascadeSpan = max(splitDist - prevSplit, 0.001);
                     float localCascadeT = clamp((viewDepth - prevSplit) / cascadeSpan, 0.0, 1.0);
-                    float hardVisibility = sampleShadow2D(0, baseIndex + cascadeIndex, lightSpacePos, bias, 1.0, shadowPos, 0.0);
+                    float hardVisibility = sampleShadow2D(0, baseIndex + cascadeIndex, light.shadowAtlasRects[cascadeIndex], lightSpacePos, bias, 1.0, shadowPos, 0.0);
                     float filterToHard = smoothstep(0.25, 0.95, localCascadeT);
                     visibility = mix(visibility, hardVisibility, filterToHard);
                 }
@@ -464,7 +545,7 @@ void main() {
                     float blendT = clamp((viewDepth - blendStart) / blendRange, 0.0, 1.0);
                     if(blendT > 0.0){
                         vec4 nextLightSpacePos = light.lightMatrices[cascadeIndex + 1] * vec4(shadowPos, 1.0);
-                        float nextVisibility = sampleShadow2D(sType, baseIndex + cascadeIndex + 1, nextLightSpacePos, bias, filterScale, shadowPos, receiverGradScale);
+                        float nextVisibility = sampleShadow2D(sType, baseIndex + cascadeIndex + 1, light.shadowAtlasRects[cascadeIndex + 1], nextLightSpacePos, bias, filterScale, shadowPos, receiverGradScale);
                         visibility = mix(visibility, nextVisibility, blendT);
                     }
                 }
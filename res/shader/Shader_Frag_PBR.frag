@@ -1,7 +1,6 @@
 #version 410 core
 
-#define MAX_LIGHTS 128
-#define MAX_SHADOW_MAPS_2D 16
+#define LIGHT_RECORD_TEXELS 7
 #define MAX_SHADOW_MAPS_CUBE 2
 #define PI 3.14159265359
 
@@ -14,6 +13,7 @@ struct Light {
     vec4 shadow;             // x=bias, y=normalBias, z=cascadeCount, w=debugMode
     vec4 cascadeSplits;      // view-space split distances
     mat4 lightMatrices[4];   // directional cascades / spot uses [0]
+    vec4 shadowAtlasRects[4]; // per cascade atlas tile: xy=uv offset, zw=uv scale
 };
 
 in vec3 v_fragPos;
@@ -55,12 +55,6 @@ uniform samplerCube u_envMap;
 uniform int u_useEnvMap;
 uniform float u_envStrength;
 uniform samplerCube u_localProbe;
-uniform int u_useLocalProbe;
-uniform vec3 u_localProbeCenter;
-uniform vec3 u_localProbeCaptureMin;
-uniform vec3 u_localProbeCaptureMax;
-uniform vec3 u_localProbeInfluenceMin;
-uniform vec3 u_localProbeInfluenceMax;
 
 uniform vec2 u_uvScale;
 uniform vec2 u_uvOffset;
@@ -91,33 +85,206 @@ uniform vec2 u_waveDirection;
 uniform float u_waveTextureInfluence;
 uniform vec2 u_waveTextureSpeed;
 uniform sampler2D u_ssrColor;
-uniform int u_useSceneColor;
 uniform sampler2D u_sceneDepth;
-uniform int u_useSceneDepth;
-uniform int u_useSsr;
-uniform float u_ssrIntensity;
-uniform float u_ssrMaxDistance;
-uniform float u_ssrThickness;
-uniform float u_ssrStride;
-uniform float u_ssrJitter;
-uniform int u_ssrMaxSteps;
-uniform float u_ssrRoughnessCutoff;
-uniform float u_ssrEdgeFade;
-uniform mat4 u_invProjection;
 uniform sampler2D u_planarReflectionTex;
-uniform int u_usePlanarReflection;
-uniform mat4 u_planarReflectionMatrix;
-uniform float u_planarReflectionStrength;
-uniform vec3 u_planarReflectionCenter;
-uniform vec3 u_planarReflectionNormal;
-uniform float u_planarReflectionReceiverFadeDistance;
+
+// Written once per pass by PassUniformUploader; each vec3 shares a std140 slot with the scalar after it.
+layout(std140) uniform PassBlock {
+    mat4 u_invProjection;
+    mat4 u_planarReflectionMatrix;
+    vec3 u_localProbeCenter;
+    int u_useLocalProbe;
+    vec3 u_localProbeCaptureMin;
+    int u_usePlanarReflection;
+    vec3 u_localProbeCaptureMax;
+    float u_planarReflectionStrength;
+    vec3 u_localProbeInfluenceMin;
+    float u_planarReflectionReceiverFadeDistance;
+    vec3 u_localProbeInfluenceMax;
+    int u_useSceneColor;
+    vec3 u_planarReflectionCenter;
+    int u_useSceneDepth;
+    vec3 u_planarReflectionNormal;
+    int u_useSsr;
+    float u_ssrIntensity;
+    float u_ssrMaxDistance;
+    float u_ssrThickness;
+    float u_ssrStride;
+    float u_ssrJitter;
+    int u_ssrMaxSteps;
+    float u_ssrRoughnessCutoff;
+    float u_ssrEdgeFade;
+};
+
+// Feature switches. Permutations compiled by ShaderVariantSet define SHADER_VARIANT plus one
+// USE_* keyword per enabled feature, so disabled paths fold away at compile time. The plain
+// program (no SHADER_VARIANT) keeps branching on the runtime flags.
+#ifdef SHADER_VARIANT
+    #ifdef USE_BASE_COLOR_TEX
+        #define HAS_BASE_COLOR_TEX true
+    #else
+        #define HAS_BASE_COLOR_TEX false
+    #endif
+    #ifdef USE_ROUGHNESS_TEX
+        #define HAS_ROUGHNESS_TEX true
+    #else
+        #define HAS_ROUGHNESS_TEX false
+    #endif
+    #ifdef USE_METALLIC_ROUGHNESS_TEX
+        #define HAS_METALLIC_ROUGHNESS_TEX true
+    #else
+        #define HAS_METALLIC_ROUGHNESS_TEX false
+    #endif
+    #ifdef USE_NORMAL_TEX
+        #define HAS_NORMAL_TEX true
+    #else
+        #define HAS_NORMAL_TEX false
+    #endif
+    #ifdef USE_HEIGHT_TEX
+        #define HAS_HEIGHT_TEX true
+    #else
+        #define HAS_HEIGHT_TEX false
+    #endif
+    #ifdef USE_EMISSIVE_TEX
+        #define HAS_EMISSIVE_TEX true
+    #else
+        #define HAS_EMISSIVE_TEX false
+    #endif
+    #ifdef USE_OCCLUSION_TEX
+        #define HAS_OCCLUSION_TEX true
+    #else
+        #define HAS_OCCLUSION_TEX false
+    #endif
+    #ifdef USE_ENV_MAP
+        #define HAS_ENV_MAP true
+    #else
+        #define HAS_ENV_MAP false
+    #endif
+    #ifdef USE_SCENE_COLOR
+        #define HAS_SCENE_COLOR true
+    #else
+        #define HAS_SCENE_COLOR false
+    #endif
+    #ifdef USE_SCENE_DEPTH
+        #define HAS_SCENE_DEPTH true
+    #else
+        #define HAS_SCENE_DEPTH false
+    #endif
+    #ifdef USE_SSR
+        #define HAS_SSR true
+    #else
+        #define HAS_SSR false
+    #endif
+    #ifdef USE_PLANAR_REFLECTION
+        #define HAS_PLANAR_REFLECTION true
+    #else
+        #define HAS_PLANAR_REFLECTION false
+    #endif
+    #ifdef USE_LOCAL_PROBE
+        #define HAS_LOCAL_PROBE true
+    #else
+        #define HAS_LOCAL_PROBE false
+    #endif
+#else
+    #define HAS_BASE_COLOR_TEX         (u_useBaseColorTex != 0)
+    #define HAS_ROUGHNESS_TEX          (u_useRoughnessTex != 0)
+    #define HAS_METALLIC_ROUGHNESS_TEX (u_useMetallicRoughnessTex != 0)
+    #define HAS_NORMAL_TEX             (u_useNormalTex != 0)
+    #define HAS_HEIGHT_TEX             (u_useHeightTex != 0)
+    #define HAS_EMISSIVE_TEX           (u_useEmissiveTex != 0)
+    #define HAS_OCCLUSION_TEX          (u_useOcclusionTex != 0)
+    #define HAS_ENV_MAP                (u_useEnvMap != 0)
+    #define HAS_SCENE_COLOR            (u_useSceneColor != 0)
+    #define HAS_SCENE_DEPTH            (u_useSceneDepth != 0)
+    #define HAS_SSR                    (u_useSsr != 0)
+    #define HAS_PLANAR_REFLECTION      (u_usePlanarReflection != 0)
+    #define HAS_LOCAL_PROBE            (u_useLocalProbe != 0)
+#endif
 
 layout(std140) uniform LightBlock {
-    vec4 u_lightHeader;      // x=lightCount
-    Light u_lights[MAX_LIGHTS];
+    vec4 u_lightHeader;        // x=lightCount, y=clustersEnabled, z=cluster range texel, w=cluster index texel
+    vec4 u_clusterGrid;        // x=tilesX, y=tilesY, z=sliceCount, w=tile size in pixels
+    vec4 u_clusterDepth;       // x=near, y=far, z=slice scale, w=slice bias
+    vec4 u_clusterProjection;  // x=tan(fovX/2), y=tan(fovY/2), z=viewport width, w=viewport height
+    mat4 u_clusterView;
 };
+uniform samplerBuffer u_lightBuffer; // light records, shadow records, cluster ranges, cluster light indices
+
+// Mirrors the u_lightBuffer packing in LightUtils.cpp (LightRecord, LightShadowRecord and the
+// cluster tables). fetchLight() through getClusterLightIndex() are kept identical in every
+// forward, PBR and deferred-light fragment shader; change them all together with the packer.
+Light fetchLight(int lightIndex){
+    int base = lightIndex * LIGHT_RECORD_TEXELS;
+    Light light;
+    light.meta = texelFetch(u_lightBuffer, base + 0);
+    light.position = texelFetch(u_lightBuffer, base + 1);
+    light.direction = texelFetch(u_lightBuffer, base + 2);
+    light.color = texelFetch(u_lightBuffer, base + 3);
+    light.params = texelFetch(u_lightBuffer, base + 4);
+    light.shadow = texelFetch(u_lightBuffer, base + 5);
+    light.cascadeSplits = texelFetch(u_lightBuffer, base + 6);
+
+    int shadowBase = int(light.position.w);
+    for(int m = 0; m < 4; ++m){
+        if(shadowBase >= 0){
+            int matrixBase = shadowBase + (m * 4);
+            light.lightMatrices[m] = mat4(
+                texelFetch(u_lightBuffer, matrixBase + 0),
+                texelFetch(u_lightBuffer, matrixBase + 1),
+                texelFetch(u_lightBuffer, matrixBase + 2),
+                texelFetch(u_lightBuffer, matrixBase + 3)
+            );
+            light.shadowAtlasRects[m] = texelFetch(u_lightBuffer, shadowBase + 16 + m);
+        }else{
+            light.lightMatrices[m] = mat4(1.0);
+            light.shadowAtlasRects[m] = vec4(0.0);
+        }
+    }
+    return light;
+}
+
+// Returns -1 when worldPos is outside the cluster grid; callers then walk every light.
+int findLightCluster(vec3 worldPos){
+    if(u_lightHeader.y < 0.5){
+        return -1;
+    }
+    vec3 viewPos = (u_clusterView * vec4(worldPos, 1.0)).xyz;
+    float depth = -viewPos.z;
+    if(depth <= u_clusterDepth.x || depth >= u_clusterDepth.y){
+        return -1;
+    }
+    vec2 ndc = viewPos.xy / (depth * u_clusterProjection.xy);
+    if(abs(ndc.x) >= 1.0 || abs(ndc.y) >= 1.0){
+        return -1;
+    }
+
+    ivec3 grid = ivec3(u_clusterGrid.xyz + vec3(0.5));
+    ivec2 tile = ivec2(((ndc * 0.5) + 0.5) * u_clusterProjection.zw / u_clusterGrid.w);
+    int slice = int(floor((log(depth) * u_clusterDepth.z) + u_clusterDepth.w));
+    tile = clamp(tile, ivec2(0), grid.xy - ivec2(1));
+    slice = clamp(slice, 0, grid.z - 1);
+    return tile.x + (tile.y * grid.x) + (slice * grid.x * grid.y);
+}
+
+// x=first list entry, y=light count.
+ivec2 getLightClusterRange(int clusterIndex){
+    if(clusterIndex < 0){
+        return ivec2(0, int(u_lightHeader.x + 0.5));
+    }
+    vec4 range = texelFetch(u_lightBuffer, int(u_lightHeader.z + 0.5) + clusterIndex);
+    return ivec2(range.xy + vec2(0.5));
+}
+
+int getClusterLightIndex(int clusterIndex, ivec2 clusterRange, int listIndex){
+    if(clusterIndex < 0){
+        return listIndex;
+    }
+    int entry = clusterRange.x + listIndex;
+    vec4 packedIndices = texelFetch(u_lightBuffer, int(u_lightHeader.w + 0.5) + (entry / 4));
+    return int(packedIndices[entry % 4] + 0.5);
+}
 
-uniform sampler2D u_shadowMaps2D[MAX_SHADOW_MAPS_2D];
+uniform sampler2D u_shadowAtlas;
 uniform samplerCubeShadow u_shadowMapsCube[MAX_SHADOW_MAPS_CUBE];
 
 vec3 safeNormalize(vec3 v){
@@ -174,7 +341,7 @@ float sampleProceduralWave(vec2 wavePos, float timeSec){
 }
 
 float sampleTextureWave(vec2 uv, float timeSec){
-    if(u_useHeightTex == 0 || u_waveTextureInfluence <= 1e-4){
+    if(!HAS_HEIGHT_TEX || u_waveTextureInfluence <= 1e-4){
         return 0.0;
     }
     vec2 flowUv = uv + (u_waveTextureSpeed * timeSec);
@@ -338,20 +505,21 @@ mat2 rotate2D(float angle){
     return mat2(c, -s, s, c);
 }
 
-float compareShadowDepth2D(int mapIndex, vec2 uv, float compareDepth){
-    float storedDepth = texture(u_shadowMaps2D[mapIndex], uv).r;
+float compareShadowDepth2D(vec4 atlasRect, vec2 uv, float compareDepth){
+    float storedDepth = texture(u_shadowAtlas, atlasRect.xy + uv * atlasRect.zw).r;
     return (compareDepth <= storedDepth) ? 1.0 : 0.0;
 }
 
-float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bias, float filterScale, vec3 receiverPos, float receiverGradScale) {
-    if(mapIndex < 0 || mapIndex >= MAX_SHADOW_MAPS_2D) return 1.0;
+float sampleShadow2D(int shadowType, int mapIndex, vec4 atlasRect, vec4 lightSpacePos, float bias, float filterScale, vec3 receiverPos, float receiverGradScale) {
+    if(atlasRect.z <= 0.0 || atlasRect.w <= 0.0) return 1.0;
 
     vec3 projCoords = lightSpacePos.xyz / lightSpacePos.w;
     projCoords = projCoords * 0.5 + 0.5;
     if(projCoords.z > 1.001 || projCoords.z < -0.001) return 1.0;
     if(projCoords.x < 0.0 || projCoords.x > 1.0 || projCoords.y < 0.0 || projCoords.y > 1.0) return 1.0;
 
-    vec2 texelSize = 1.0 / vec2(textureSize(u_shadowMaps2D[mapIndex], 0));
+    // Filtering runs in tile-local UVs; one texel of the tile is 1 / (atlas texels * tile scale).
+    vec2 texelSize = 1.0 / (vec2(textureSize(u_shadowAtlas, 0)) * atlasRect.zw);
     float clampedFilterScale = max(filterScale, 0.5);
     vec2 pcfTexel = texelSize * clampedFilterScale;
     float pcfBias = 0.0;
@@ -395,7 +563,7 @@ float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bia
     mat2 kernelRot = rotate2D(rotation);
 
     if(shadowType == 0){
-        return compareShadowDepth2D(mapIndex, clamp(projCoords.xy, uvMin, uvMax), compareDepth);
+        return compareShadowDepth2D(atlasRect, clamp(projCoords.xy, uvMin, uvMax), compareDepth);
     }
 
     float shadow = 0.0;
@@ -419,7 +587,7 @@ float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bia
             float weight = 1.0 - smoothstep(0.75, 1.10, length(kernel[i]));
             float receiverOffset = clamp(dot(receiverDepthGrad, tapOffset), -0.0012 * clampedFilterScale, 0.0012 * clampedFilterScale);
             float compareDepthTap = clamp(compareDepth + receiverOffset, 0.0, 1.0);
-            shadow += compareShadowDepth2D(mapIndex, sampleUv, compareDepthTap) * weight;
+            shadow += compareShadowDepth2D(atlasRect, sampleUv, compareDepthTap) * weight;
             weightSum += weight;
         }
     }else{
@@ -440,7 +608,7 @@ float sampleShadow2D(int shadowType, int mapIndex, vec4 lightSpacePos, float bia
             float weight = 1.0 - smoothstep(0.70, 1.15, length(kernel[i]));
             float receiverOffset = clamp(dot(receiverDepthGrad, tapOffset), -0.0020 * clampedFilterScale, 0.0020 * clampedFilterScale);
             float compareDepthTap = clamp(compareDepth + receiverOffset, 0.0, 1.0);
-            shadow += compareShadowDepth2D(mapIndex, sampleUv, compareDepthTap) * weight;
+            shadow += compareShadowDepth2D(atlasRect, sampleUv, compareDepthTap) * weight;
             weightSum += weight;
         }
     }
@@ -626,7 +794,7 @@ vec2 applyHeightMapParallax(vec2 uv, vec2 duvDx, vec2 duvDy, vec3 viewDirWS, mat
 }
 
 vec3 getNormal(vec2 uv, vec2 duvDx, vec2 duvDy, vec3 N, mat3 TBN, vec3 viewDirWS){
-    if(u_useNormalTex == 0){
+    if(!HAS_NORMAL_TEX){
         return N;
     }
 
@@ -710,7 +878,7 @@ vec3 sampleEnvironmentSpecular(vec3 reflectionDir, float roughness){
 }
 
 float computeLocalProbeInfluence(vec3 worldPos){
-    if(u_useLocalProbe == 0){
+    if(!HAS_LOCAL_PROBE){
         return 0.0;
     }
     vec3 probeCenter = (u_localProbeInfluenceMin + u_localProbeInfluenceMax) * 0.5;
@@ -751,7 +919,7 @@ vec3 sampleLocalProbeSpecular(vec3 worldPos, vec3 reflectionDir, float roughness
 
 vec3 samplePlanarReflection(vec3 worldPos, vec3 worldReflectDir, float roughness, out float weight){
     weight = 0.0;
-    if(u_usePlanarReflection == 0){
+    if(!HAS_PLANAR_REFLECTION){
         return vec3(0.0);
     }
 
@@ -861,7 +1029,7 @@ void main() {
     mat3 TBN = buildTBN(uvBase, baseN, v_tangent);
     vec2 uv = applyHeightMapParallax(uvBase, duvDx, duvDy, V, TBN);
     int bsdfModel = clamp(u_bsdfModel, 0, 2);
-    vec4 baseTex = (u_useBaseColorTex != 0) ? textureGrad(u_baseColorTex, uv, duvDx, duvDy) : vec4(1.0);
+    vec4 baseTex = HAS_BASE_COLOR_TEX ? textureGrad(u_baseColorTex, uv, duvDx, duvDy) : vec4(1.0);
     float alphaTex = (bsdfModel == 0) ? baseTex.a : 1.0;
     vec4 baseColor = vec4(
         (u_baseColor.rgb * baseTex.rgb) * v_color.rgb,
@@ -879,18 +1047,18 @@ void main() {
 
     float metallic = u_metallic;
     float roughness = clamp(u_roughness, 0.04, 1.0);
-    if(u_useRoughnessTex != 0){
+    if(HAS_ROUGHNESS_TEX){
         float roughSample = textureGrad(u_roughnessTex, uv, duvDx, duvDy).r;
         roughness = clamp(roughness * roughSample, 0.04, 1.0);
     }
-    if(u_useMetallicRoughnessTex != 0){
+    if(HAS_METALLIC_ROUGHNESS_TEX){
         vec4 mr = textureGrad(u_metallicRoughnessTex, uv, duvDx, duvDy);
         roughness = clamp(roughness * mr.g, 0.04, 1.0);
         metallic = clamp(metallic * mr.b, 0.0, 1.0);
     }
 
     float ao = 1.0;
-    if(u_useOcclusionTex != 0){
+    if(HAS_OCCLUSION_TEX){
         float occl = textureGrad(u_occlusionTex, uv, duvDx, duvDy).r;
         ao = applyOcclusionStrength(occl, u_aoStrength);
     }
@@ -929,9 +1097,11 @@ void main() {
     vec3 Lo = vec3(0.0);
     vec3 debugColorAccum = vec3(0.0);
     float debugWeight = 0.0;
-    int lightCount = int(u_lightHeader.x + 0.5);
-    for (int i = 0; i < lightCount && i < MAX_LIGHTS; i++) {
-        Light light = u_lights[i];
+    int clusterIndex = findLightCluster(v_fragPos);
+    ivec2 clusterRange = getLightClusterRange(clusterIndex);
+    for (int listIndex = 0; listIndex < clusterRange.y; listIndex++) {
+        int i = getClusterLightIndex(clusterIndex, clusterRange, listIndex);
+        Light light = fetchLight(i);
         int lightType = int(light.meta.x + 0.5);
         int debugModeForLight = resolveShadowDebugMode(i, light);
 
@@ -1060,13 +1230,13 @@ void main() {
                                              projCoords.z < 0.0 || projCoords.z > 1.0);
                     projectionDepth = clamp(projCoords.z, 0.0, 1.0);
                 }
-                visibility = sampleShadow2D(sType, baseIndex + cascadeIndex, lightSpacePos, bias, filterScale, shadowPos, receiverGradScale);
+                visibility = sampleShadow2D(sType, baseIndex + cascadeIndex, light.shadowAtlasRects[cascadeIndex], lightSpacePos, bias, filterScale, shadowPos, receiverGradScale);
                 if(lType == 1 && cascadeCount > 1 && cascadeIndex == (cascadeCount - 1) && sType != 0){
                     float prevSplit = (cascadeIndex > 0) ? light.cascadeSplits[cascadeIndex - 1] : 0.0;
                     float splitDist = light.cascadeSplits[cascadeIndex];
                     float cascadeSpan = max(splitDist - prevSplit, 0.001);
                     float localCascadeT = clamp((viewDepth - prevSplit) / cascadeSpan, 0.0, 1.0);
-                    float hardVisibility = sampleShadow2D(0, baseIndex + cascadeIndex, lightSpacePos, bias, 1.0, shadowPos, 0.0);
+                    float hardVisibility = sampleShadow2D(0, baseIndex + cascadeIndex, light.shadowAtlasRects[cascadeIndex], lightSpacePos, bias, 1.0, shadowPos, 0.0);
                     float filterToHard = smoothstep(0.25, 0.95, localCascadeT);
                     visibility = mix(visibility, hardVisibility, filterToHard);
                 }
@@ -1080,7 +1250,7 @@ void main() {
                     float blendT = clamp((viewDepth - blendStart) / blendRange, 0.0, 1.0);
                     if(blendT > 0.0){
                         vec4 nextLightSpacePos = light.lightMatrices[cascadeIndex + 1] * vec4(shadowPos, 1.0);
-                        float nextVisibility = sampleShadow2D(sType, baseIndex + cascadeIndex + 1, nextLightSpacePos, bias, filterScale, shadowPos, receiverGradScale);
+                        float nextVisibility = sampleShadow2D(sType, baseIndex + cascadeIndex + 1, light.shadowAtlasRects[cascadeIndex + 1], nextLightSpacePos, bias, filterScale, shadowPos, receiverGradScale);
                         visibility = mix(visibility, nextVisibility, blendT);
                     }
                 }
@@ -1139,14 +1309,14 @@ void main() {
     }else{
         envContrib *= mix(0.85, 1.65, metallic);
     }
-    if(u_useEnvMap != 0 || localProbeInfluence > 1e-4){
+    if(HAS_ENV_MAP || localProbeInfluence > 1e-4){
         vec3 envSample = vec3(0.0);
-        if(u_useEnvMap != 0){
+        if(HAS_ENV_MAP){
             envSample = sampleEnvironmentSpecular(R, roughness);
         }
         if(localProbeInfluence > 1e-4){
             vec3 localProbeSample = sampleLocalProbeSpecular(v_fragPos, R, roughness);
-            envSample = (u_useEnvMap != 0)
+            envSample = HAS_ENV_MAP
                 ? mix(envSample, localProbeSample, localProbeInfluence)
                 : localProbeSample;
         }
@@ -1160,7 +1330,7 @@ void main() {
         vec3 planarEnvSample = samplePlanarReflection(v_fragPos, R, roughness, planarEnvWeight);
         if(planarEnvWeight > 1e-4){
             vec3 planarSpec = planarEnvSample * Fenv * envContrib * max(u_planarReflectionStrength, 0.0);
-            envSpec = (u_useEnvMap != 0)
+            envSpec = HAS_ENV_MAP
                 ? mix(envSpec, planarSpec, planarEnvWeight)
                 : (planarSpec * planarEnvWeight);
         }
@@ -1168,8 +1338,8 @@ void main() {
     vec3 normalView = safeNormalize(mat3(u_view) * N);
     vec3 surfaceViewPos = (u_view * vec4(v_fragPos, 1.0)).xyz;
     vec3 viewIncident = safeNormalize(surfaceViewPos);
-    bool hasSceneColor = (u_useSceneColor != 0);
-    bool hasSceneDepth = (u_useSceneDepth != 0);
+    bool hasSceneColor = HAS_SCENE_COLOR;
+    bool hasSceneDepth = HAS_SCENE_DEPTH;
     vec2 sceneTexSize = vec2(0.0);
     vec2 sceneTexelSize = vec2(0.0);
     vec2 sceneUv = vec2(0.5);
@@ -1283,7 +1453,7 @@ void main() {
         vec3 reflectionSample = vec3(0.0);
         float reflectionWeight = 0.0;
         bool hit = false;
-        if(u_useSsr != 0 &&
+        if(HAS_SSR &&
            hasSceneColor &&
            hasSceneDepth &&
            roughness <= max(u_ssrRoughnessCutoff, 0.05)){
@@ -1307,7 +1477,7 @@ void main() {
             }
         }
 
-        if(reflectionWeight <= 1e-4 && u_usePlanarReflection != 0){
+        if(reflectionWeight <= 1e-4 && HAS_PLANAR_REFLECTION){
             float planarReflectionWeight = 0.0;
             vec3 planarReflectionSample = samplePlanarReflection(v_fragPos, R, roughness, planarReflectionWeight);
             if(planarReflectionWeight > 1e-4){
@@ -1316,13 +1486,13 @@ void main() {
             }
         }
 
-        if(reflectionWeight <= 1e-4 && (u_useEnvMap != 0 || localProbeInfluence > 1e-4)){
-            if(u_useEnvMap != 0){
+        if(reflectionWeight <= 1e-4 && (HAS_ENV_MAP || localProbeInfluence > 1e-4)){
+            if(HAS_ENV_MAP){
                 reflectionSample = sampleEnvironmentSpecular(reflect(-V, N), roughness);
             }
             if(localProbeInfluence > 1e-4){
                 vec3 localProbeSample = sampleLocalProbeSpecular(v_fragPos, reflect(-V, N), roughness);
-                reflectionSample = (u_useEnvMap != 0)
+                reflectionSample = HAS_ENV_MAP
                     ? mix(reflectionSample, localProbeSample, localProbeInfluence)
                     : localProbeSample;
             }
@@ -1337,7 +1507,7 @@ void main() {
                 ? smoothstep(0.0, max(u_ssrEdgeFade, 1e-4), screenEdge)
                 : 1.0;
             float reflectionAmount = reflectionWeight * fresnelAmount * screenEdgeFade;
-            if(u_useSsr != 0 && hit){
+            if(HAS_SSR && hit){
                 reflectionAmount *= clamp(u_ssrIntensity, 0.0, 4.0);
             }
             reflectionCompositeColor = reflectionSample * reflectionTint;
@@ -1345,7 +1515,7 @@ void main() {
         }
     }
     vec3 emissive = u_emissiveColor * u_emissiveStrength;
-    if(u_useEmissiveTex != 0){
+    if(HAS_EMISSIVE_TEX){
         emissive *= textureGrad(u_emissiveTex, uv, duvDx, duvDy).rgb;
     }
 
@@ -4,6 +4,7 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec4 aColor;
 layout (location = 2) in vec3 aNormal;
 layout (location = 3) in vec2 aTexCoord;
+layout (location = 5) in mat4 aInstanceModel; // identity unless drawn instanced
         
 uniform mat4 u_model;
 uniform mat4 u_view;
@@ -15,7 +16,7 @@ out vec2 v_uv;
     
 void main() {
     v_uv = aTexCoord;
-    vec4 worldPos = u_model * vec4(aPos, 1.0);
+    vec4 worldPos = u_model * aInstanceModel * vec4(aPos, 1.0);
     gl_ClipDistance[0] = (u_useUserClipPlane != 0) ? dot(worldPos, u_userClipPlane) : 1.0;
     gl_Position = u_projection * u_view * worldPos;
 }
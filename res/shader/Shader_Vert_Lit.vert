@@ -5,6 +5,7 @@ layout (location = 1) in vec4 aColor;
 layout (location = 2) in vec3 aNormal;
 layout (location = 3) in vec2 aTexCoord;
 layout (location = 4) in vec4 aTangent;
+layout (location = 5) in mat4 aInstanceModel; // identity unless drawn instanced
         
 uniform mat4 u_model;
 uniform mat4 u_view;
@@ -27,6 +28,17 @@ uniform int u_useHeightTex;
 uniform vec2 u_uvScale;
 uniform vec2 u_uvOffset;
 
+// Shader_Frag_PBR.frag permutations pass the same keywords to this stage.
+#ifdef SHADER_VARIANT
+    #ifdef USE_HEIGHT_TEX
+        #define HAS_HEIGHT_TEX true
+    #else
+        #define HAS_HEIGHT_TEX false
+    #endif
+#else
+    #define HAS_HEIGHT_TEX (u_useHeightTex != 0)
+#endif
+
 out vec3 v_fragPos;
 out vec3 v_normal;
 out vec2 v_uv;
@@ -57,7 +69,7 @@ float sampleProceduralWave(vec2 wavePos, float timeSec){
 }
 
 float sampleTextureWave(vec2 uv, float timeSec){
-    if(u_useHeightTex == 0 || u_waveTextureInfluence <= 1e-4){
+    if(!HAS_HEIGHT_TEX || u_waveTextureInfluence <= 1e-4){
         return 0.0;
     }
     vec2 flowUv = uv + (u_waveTextureSpeed * timeSec);
@@ -104,8 +116,9 @@ void main() {
         localNormal = normalize(mix(localNormal, waveNormal, 0.85));
     }
 
-    mat3 normalMatrix = mat3(transpose(inverse(u_model)));
-    vec4 worldPos4 = u_model * vec4(localPos, 1.0);
+    mat4 model = u_model * aInstanceModel;
+    mat3 normalMatrix = mat3(transpose(inverse(model)));
+    vec4 worldPos4 = model * vec4(localPos, 1.0);
     v_fragPos = worldPos4.xyz;
     v_normal = normalize(normalMatrix * localNormal);
     vec3 tangentWs = normalMatrix * aTangent.xyz;
@@ -119,8 +119,8 @@ void DemoScene::init(){
         auto* aa = demoCameraObject->getComponent<AntiAliasingComponent>();
 
         if(demoCameraTransform){
-            demoCameraTransform->local.setPosition(Math3D::Vec3(0.0f, 1.5f, 8.0f));
-            demoCameraTransform->local.setRotation(Math3D::Vec3(0.0f, -180.0f, 0.0f));
+            demoCameraTransform->editLocal().setPosition(Math3D::Vec3(0.0f, 1.5f, 8.0f));
+            demoCameraTransform->editLocal().setRotation(Math3D::Vec3(0.0f, -180.0f, 0.0f));
         }
 
         if(demoCameraComponent){
@@ -132,7 +132,7 @@ void DemoScene::init(){
             );
             cam = demoCameraComponent->camera;
             if(demoCameraTransform && cam){
-                cam->setTransform(demoCameraTransform->local);
+                cam->setTransform(demoCameraTransform->getLocal());
             }
         }
 
@@ -325,23 +325,23 @@ void DemoScene::init(){
 
     if(renderBoxGameObject){
         if(auto* transform = renderBoxGameObject->getComponent<TransformComponent>()){
-            transform->local.setPosition(Math3D::Vec3(-7, -2, 10));
+            transform->editLocal().setPosition(Math3D::Vec3(-7, -2, 10));
         }
     }
 
     if(lucilleObject){
         if(auto* transform = lucilleObject->getComponent<TransformComponent>()){
-            transform->local.setPosition(Math3D::Vec3(0, 0, -5.0f));
+            transform->editLocal().setPosition(Math3D::Vec3(0, 0, -5.0f));
         }
     }
     if(cubeObject){
         if(auto* transform = cubeObject->getComponent<TransformComponent>()){
-            transform->local.setPosition(Math3D::Vec3(-10.0f,0,-10.0f));
+            transform->editLocal().setPosition(Math3D::Vec3(-10.0f,0,-10.0f));
         }
     }
     if(orbObject){
         if(auto* transform = orbObject->getComponent<TransformComponent>()){
-            transform->local.setPosition(Math3D::Vec3(-10.0f,0,30.0f));
+            transform->editLocal().setPosition(Math3D::Vec3(-10.0f,0,30.0f));
         }
     }
 
@@ -349,7 +349,7 @@ void DemoScene::init(){
     if(lSun){
         auto sunTransform = lSun->getComponent<TransformComponent>();
         if(sunTransform) 
-            sunTransform->local.rotateAxisAngle(Math3D::Vec3(1,0,0),90); // face down.
+            sunTransform->editLocal().rotateAxisAngle(Math3D::Vec3(1,0,0),90); // face down.
     }
 
     createLightGameObject("KeyLight", KeyPoint, nullptr, true, false);
@@ -372,24 +372,24 @@ void DemoScene::update(float deltaTime){
     }
 
     if(demoCameraTransform && cam){
-        demoCameraTransform->local = cam->transform();
+        demoCameraTransform->setLocal(cam->transform());
     }
 
     if(lucilleObject){
         if(auto* transform = lucilleObject->getComponent<TransformComponent>()){
-            transform->local.rotateAxisAngle(Math3D::Vec3(1.0f, 1.0f, 1.0f), 50 * deltaTime);
+            transform->editLocal().rotateAxisAngle(Math3D::Vec3(1.0f, 1.0f, 1.0f), 50 * deltaTime);
         }
     }
 
     if(cubeObject){
         if(auto* transform = cubeObject->getComponent<TransformComponent>()){
-            transform->local.rotateAxisAngle(Math3D::Vec3(1,1,1), 50 * deltaTime);
+            transform->editLocal().rotateAxisAngle(Math3D::Vec3(1,1,1), 50 * deltaTime);
         }
     }
 
     if(orbObject){
         if(auto* transform = orbObject->getComponent<TransformComponent>()){
-            transform->local.rotateAxisAngle(Math3D::Vec3(1,1,1), 50 * deltaTime);
+            transform->editLocal().rotateAxisAngle(Math3D::Vec3(1,1,1), 50 * deltaTime);
         }
     }
 }
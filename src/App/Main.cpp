@@ -7,11 +7,80 @@
 #include "App/Demo/DemoScene.h"
 #include "Editor/Core/EditorScene.h"
 #include "App/Bootstrap/ManifestSceneInstaller.h"
+#include "Assets/Bundles/AssetBundleBenchmark.h"
+#include "Assets/Importers/OBJLoaderBenchmark.h"
+#include "Foundation/IO/FileReadBenchmark.h"
+#include "Foundation/Threading/WorkerPoolBenchmark.h"
+#include "Foundation/Logging/Logbot.h"
+#include "Rendering/Core/BoundsBVHBenchmark.h"
+#include "Rendering/Core/FrustumCullingSelfTest.h"
+#include "Rendering/Lighting/ShadowAtlasAllocatorSelfTest.h"
+#include "Rendering/Shaders/ProgramBinaryCache.h"
+#include "Scene/SceneSnapshotBenchmark.h"
+#include "Serialization/IO/CookedIO.h"
+#include "Serialization/IO/SceneLoadBenchmark.h"
+
+#include <cstring>
+#include <filesystem>
 
 int main(int argc, char** argv){
     
-    (void)argc;
-    (void)argv;
+    for(int i = 1; i < argc; ++i){
+        if(std::strcmp(argv[i], "--bench-jobs") == 0){
+            WorkerPoolBenchmark::Run();
+            return 0;
+        }
+        if(std::strcmp(argv[i], "--bench-file-read") == 0){
+            // --bench-file-read [res directory]
+            const std::filesystem::path resRoot = (i + 1 < argc) ? std::filesystem::path(argv[i + 1]) : std::filesystem::current_path() / "res";
+            return FileReadBenchmark::Run(FileReadBenchmark::DefaultPaths(resRoot)).valid ? 0 : 1;
+        }
+        if(std::strcmp(argv[i], "--bench-bundles") == 0){
+            // --bench-bundles [bundle directory]
+            const std::filesystem::path bundleDir = (i + 1 < argc) ? std::filesystem::path(argv[i + 1]) : std::filesystem::current_path() / "res" / "bundles";
+            return AssetBundleBenchmark::Run(bundleDir).valid ? 0 : 1;
+        }
+        if(std::strcmp(argv[i], "--bench-obj") == 0){
+            // --bench-obj [.obj file]
+            const std::filesystem::path objPath = (i + 1 < argc) ? std::filesystem::path(argv[i + 1]) : std::filesystem::current_path() / "res" / "models" / "lucille" / "lucille4x.obj";
+            return OBJLoaderBenchmark::Run(objPath).matched ? 0 : 1;
+        }
+        if(std::strcmp(argv[i], "--test-culling") == 0){
+            return FrustumCullingSelfTest::Run().passed ? 0 : 1;
+        }
+        if(std::strcmp(argv[i], "--test-shadow-atlas") == 0){
+            return ShadowAtlasAllocatorSelfTest::Run().passed ? 0 : 1;
+        }
+        if(std::strcmp(argv[i], "--bench-bvh") == 0){
+            return BoundsBVHBenchmark::Run().matched ? 0 : 1;
+        }
+        if(std::strcmp(argv[i], "--bench-snapshot") == 0){
+            SceneSnapshotBenchmark::Run();
+            SceneSnapshotBenchmark::RunLayoutComparison();
+            return 0;
+        }
+        if(std::strcmp(argv[i], "--bench-scene-load") == 0 && i + 1 < argc){
+            return SceneLoadBenchmark::Run(argv[i + 1]).valid ? 0 : 1;
+        }
+        if(std::strcmp(argv[i], "--cook") == 0 && i + 2 < argc){
+            // --cook <source .scene/.prefab> <cooked output>
+            std::string error;
+            if(!CookedIO::CookFile(argv[i + 1], argv[i + 2], &error)){
+                LogBot.Log(LOG_ERRO, "Failed to cook '%s': %s", argv[i + 1], error.c_str());
+                return 1;
+            }
+            LogBot.Log(LOG_INFO, "Cooked '%s' -> '%s'.", argv[i + 1], argv[i + 2]);
+            return 0;
+        }
+        if(std::strcmp(argv[i], "--no-program-cache") == 0){
+            // Cold-start comparison: compile every program from source.
+            ProgramBinaryCache::SetEnabled(false);
+        }
+        if(std::strcmp(argv[i], "--clear-program-cache") == 0){
+            LogBot.Log(LOG_INFO, "Removed %llu cached program binary(ies).",
+                       static_cast<unsigned long long>(ProgramBinaryCache::Clear()));
+        }
+    }
 
     DisplayMode mode = DisplayMode::New(1280, 720);
     mode.resizable = true;
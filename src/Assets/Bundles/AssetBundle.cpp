@@ -32,14 +32,14 @@ std::string stripBundleSuffix(const std::filesystem::path& path){
     return path.stem().string();
 }
 
-std::string crcToHexString(const BinaryBuffer& data){
+std::string crcToHexString(std::uint32_t crc){
     std::ostringstream stream;
     stream << "crc32:";
     stream.setf(std::ios::hex, std::ios::basefield);
     stream.setf(std::ios::uppercase);
     stream.width(8);
     stream.fill('0');
-    stream << CompressedFile::ComputeCRC32(data);
+    stream << crc;
     return stream.str();
 }
 
@@ -85,14 +85,19 @@ std::string AssetBundle::NormalizeAlias(const std::string& alias){
 }
 
 void AssetBundle::clear(){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     bundlePath.clear();
     bundleAlias.clear();
     manifest.Clear();
-    archive = CompressedFile{};
+    archive = std::make_shared<const CompressedFile>();
     cachedEntryData.clear();
+    readCacheData.clear();
+    readCacheOrder.clear();
+    readCacheBytes = 0;
 }
 
 bool AssetBundle::open(const std::filesystem::path& path, std::string* outError){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     clear();
 
     if(!IsBundlePath(path)){
@@ -131,7 +136,7 @@ bool AssetBundle::open(const std::filesystem::path& path, std::string* outError)
     bundlePath = path;
     bundleAlias = nextAlias;
     manifest = nextManifest;
-    archive = nextArchive;
+    archive = std::make_shared<const CompressedFile>(std::move(nextArchive));
 
     if(!validateArchiveEntries(outError)){
         clear();
@@ -142,6 +147,7 @@ bool AssetBundle::open(const std::filesystem::path& path, std::string* outError)
 }
 
 bool AssetBundle::createEmpty(const std::filesystem::path& path, const std::string& alias, std::string* outError){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     clear();
 
     if(!IsBundlePath(path)){
@@ -166,6 +172,7 @@ bool AssetBundle::createEmpty(const std::filesystem::path& path, const std::stri
 }
 
 bool AssetBundle::save(std::string* outError){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     if(bundlePath.empty()){
         setAssetBundleError(outError, "Asset bundle has not been opened yet.");
         return false;
@@ -187,6 +194,7 @@ std::string AssetBundle::aliasToken() const{
 }
 
 bool AssetBundle::setAlias(const std::string& alias, std::string* outError){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     const std::string normalized = NormalizeAlias(alias);
     if(normalized.empty()){
         setAssetBundleError(outError, "Asset bundle alias must contain at least one valid character.");
@@ -199,6 +207,7 @@ bool AssetBundle::setAlias(const std::string& alias, std::string* outError){
 }
 
 bool AssetBundle::setRootEntry(const std::string& entryPath, std::string* outError){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     if(entryPath.empty()){
         manifest.rootEntry.clear();
         return true;
@@ -219,6 +228,7 @@ bool AssetBundle::setRootEntry(const std::string& entryPath, std::string* outErr
 }
 
 bool AssetBundle::readEntryBytes(const std::string& entryPath, BinaryBuffer& outData, std::string* outError){
+    std::unique_lock<std::recursive_mutex> lock(contentMutex);
     outData.clear();
 
     const std::string normalized = CompressedFile::NormalizeEntryPath(entryPath);
@@ -251,13 +261,37 @@ bool AssetBundle::readEntryBytes(const std::string& entryPath, BinaryBuffer& out
         return true;
     }
 
-    if(!archive.readEntry(normalized, outData, outError)){
+    auto readCached = readCacheData.find(normalized);
+    if(readCached != readCacheData.end()){
+        readCacheOrder.splice(readCacheOrder.begin(), readCacheOrder, readCached->second.lruIt);
+        outData = readCached->second.data;
+        return true;
+    }
+
+    // Decompress from the current snapshot without the lock so concurrent reads run in parallel.
+    const std::shared_ptr<const CompressedFile> snapshot = archive;
+    lock.unlock();
+    if(!snapshot->readEntry(normalized, outData, outError)){
         return false;
     }
-    cachedEntryData[normalized] = outData;
+    lock.lock();
+    if(archive == snapshot && findManifestEntry(normalized) && cachedEntryData.find(normalized) == cachedEntryData.end()){
+        cacheArchiveRead(normalized, outData);
+    }
     return true;
 }
 
+void AssetBundle::setReadCacheBudgetBytes(std::uint64_t budgetBytes){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
+    readCacheBudgetBytes = budgetBytes;
+    trimReadCache();
+}
+
+std::uint64_t AssetBundle::getReadCacheBytes(){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
+    return readCacheBytes;
+}
+
 bool AssetBundle::readEntryText(const std::string& entryPath, std::string& outText, std::string* outError){
     BinaryBuffer data;
     if(!readEntryBytes(entryPath, data, outError)){
@@ -268,6 +302,7 @@ bool AssetBundle::readEntryText(const std::string& entryPath, std::string& outTe
 }
 
 std::shared_ptr<Asset> AssetBundle::loadAsset(const std::string& entryPath, std::string* outError){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     const std::string normalized = CompressedFile::NormalizeEntryPath(entryPath);
     const JsonSchema::AssetManifestSchema::Entry* manifestEntry = findManifestEntry(normalized);
     if(manifestEntry && manifestEntry->kind == "directory"){
@@ -279,7 +314,7 @@ std::shared_ptr<Asset> AssetBundle::loadAsset(const std::string& entryPath, std:
     if(!readEntryBytes(normalized, data, outError)){
         return nullptr;
     }
-    auto inMemoryFile = std::make_unique<File>(aliasToken() + "/" + normalized, data);
+    auto inMemoryFile = std::make_unique<File>(aliasToken() + "/" + normalized, std::move(data));
     if(!inMemoryFile){
         setAssetBundleError(outError, "Failed to create in-memory file for bundle entry.");
         return nullptr;
@@ -294,6 +329,7 @@ bool AssetBundle::addOrUpdateFileFromBuffer(
     const std::string& sourceRef,
     std::string* outError)
 {
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     const std::string normalized = CompressedFile::NormalizeEntryPath(entryPath);
     if(normalized.empty()){
         setAssetBundleError(outError, "Bundle entry path is invalid.");
@@ -316,9 +352,10 @@ bool AssetBundle::addOrUpdateFileFromBuffer(
     entry->kind = "file";
     entry->sourceRef = sourceRef;
     entry->size = static_cast<std::uint64_t>(data.size());
-    entry->hash = crcToHexString(data);
+    entry->hash = crcToHexString(CompressedFile::ComputeCRC32(data));
     entry->compression.clear();
 
+    dropArchiveRead(normalized);
     cachedEntryData[normalized] = data;
     if(manifest.rootEntry.empty()){
         manifest.rootEntry = normalized;
@@ -354,6 +391,7 @@ bool AssetBundle::addOrUpdateFileFromAbsolutePath(
 }
 
 bool AssetBundle::ensureDirectory(const std::string& entryPath, std::string* outError){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     const std::string normalized = CompressedFile::NormalizeEntryPath(entryPath, true);
     if(normalized.empty()){
         setAssetBundleError(outError, "Bundle directory path is invalid.");
@@ -379,10 +417,12 @@ bool AssetBundle::ensureDirectory(const std::string& entryPath, std::string* out
     entry->hash.clear();
     entry->compression.clear();
     cachedEntryData.erase(normalized);
+    dropArchiveRead(normalized);
     return true;
 }
 
 bool AssetBundle::renameEntry(const std::string& entryPath, const std::string& newEntryPath, std::string* outError){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     const std::string normalizedFile = CompressedFile::NormalizeEntryPath(entryPath);
     const std::string normalizedDir = CompressedFile::NormalizeEntryPath(entryPath, true);
     const JsonSchema::AssetManifestSchema::Entry* oldDirEntry = normalizedDir.empty() ? nullptr : findManifestEntry(normalizedDir);
@@ -448,11 +488,8 @@ bool AssetBundle::renameEntry(const std::string& entryPath, const std::string& n
             const std::string originalPath = entry.path;
             const std::string suffix = originalPath.substr(oldPath.size());
             entry.path = newPath + suffix;
-
-            auto cachedIt = cachedEntryData.find(originalPath);
-            if(cachedIt != cachedEntryData.end()){
-                cachedEntryData[entry.path] = cachedIt->second;
-                cachedEntryData.erase(cachedIt);
+            if(entry.kind != "directory"){
+                moveEntryData(originalPath, entry.path);
             }
         }
 
@@ -468,11 +505,7 @@ bool AssetBundle::renameEntry(const std::string& entryPath, const std::string& n
         }
 
         entry->path = newPath;
-        auto cachedIt = cachedEntryData.find(oldPath);
-        if(cachedIt != cachedEntryData.end()){
-            cachedEntryData[newPath] = cachedIt->second;
-            cachedEntryData.erase(cachedIt);
-        }
+        moveEntryData(oldPath, newPath);
 
         if(manifest.rootEntry == oldPath){
             manifest.rootEntry = newPath;
@@ -484,6 +517,7 @@ bool AssetBundle::renameEntry(const std::string& entryPath, const std::string& n
 }
 
 bool AssetBundle::removeEntry(const std::string& entryPath, std::string* outError){
+    std::lock_guard<std::recursive_mutex> lock(contentMutex);
     const std::string normalizedFile = CompressedFile::NormalizeEntryPath(entryPath);
     const std::string normalizedDir = CompressedFile::NormalizeEntryPath(entryPath, true);
     if(normalizedFile.empty() && normalizedDir.empty()){
@@ -503,6 +537,7 @@ bool AssetBundle::removeEntry(const std::string& entryPath, std::string* outErro
 
         if(removeCurrent){
             cachedEntryData.erase(it->path);
+            dropArchiveRead(it->path);
             it = manifest.entries.erase(it);
             removedAny = true;
         }else{
@@ -589,6 +624,7 @@ void AssetBundle::pruneEmptyDirectories(){
     for(auto it = manifest.entries.begin(); it != manifest.entries.end();){
         if(it->kind == "directory" && requiredDirectories.find(it->path) == requiredDirectories.end()){
             cachedEntryData.erase(it->path);
+            dropArchiveRead(it->path);
             it = manifest.entries.erase(it);
         }else{
             ++it;
@@ -614,7 +650,7 @@ bool AssetBundle::validateArchiveEntries(std::string* outError){
             setAssetBundleError(outError, "Manifest contains duplicate or invalid entry path: " + entry.path);
             return false;
         }
-        const CompressedFile::Entry* archiveEntry = archive.findEntry(entry.path);
+        const CompressedFile::Entry* archiveEntry = archive->findEntry(entry.path);
         if(!archiveEntry){
             setAssetBundleError(outError, "Manifest entry is missing from the archive: " + entry.path);
             return false;
@@ -633,6 +669,57 @@ bool AssetBundle::validateArchiveEntries(std::string* outError){
     return true;
 }
 
+void AssetBundle::cacheArchiveRead(const std::string& entryPath, const BinaryBuffer& data){
+    dropArchiveRead(entryPath);
+    if(static_cast<std::uint64_t>(data.size()) > readCacheBudgetBytes){
+        return;
+    }
+
+    readCacheOrder.push_front(entryPath);
+    ReadCacheEntry& entry = readCacheData[entryPath];
+    entry.data = data;
+    entry.lruIt = readCacheOrder.begin();
+    readCacheBytes += static_cast<std::uint64_t>(data.size());
+    trimReadCache();
+}
+
+void AssetBundle::dropArchiveRead(const std::string& entryPath){
+    auto it = readCacheData.find(entryPath);
+    if(it == readCacheData.end()){
+        return;
+    }
+    readCacheBytes -= static_cast<std::uint64_t>(it->second.data.size());
+    readCacheOrder.erase(it->second.lruIt);
+    readCacheData.erase(it);
+}
+
+void AssetBundle::trimReadCache(){
+    while(readCacheBytes > readCacheBudgetBytes && !readCacheOrder.empty()){
+        dropArchiveRead(readCacheOrder.back());
+    }
+}
+
+void AssetBundle::moveEntryData(const std::string& fromPath, const std::string& toPath){
+    BinaryBuffer data;
+    auto cachedIt = cachedEntryData.find(fromPath);
+    if(cachedIt != cachedEntryData.end()){
+        data = std::move(cachedIt->second);
+        cachedEntryData.erase(cachedIt);
+    }else{
+        auto readIt = readCacheData.find(fromPath);
+        if(readIt != readCacheData.end()){
+            data = readIt->second.data;
+        }else if(!archive->readEntry(fromPath, data, nullptr)){
+            // Unreadable entries are reported by the next save().
+            return;
+        }
+    }
+
+    // The archive only knows the old path, so the bytes stay pinned until the next save.
+    dropArchiveRead(fromPath);
+    cachedEntryData[toPath] = std::move(data);
+}
+
 bool AssetBundle::rebuildArchive(std::string* outError){
     if(bundlePath.empty()){
         setAssetBundleError(outError, "Asset bundle path is empty.");
@@ -661,21 +748,30 @@ bool AssetBundle::rebuildArchive(std::string* outError){
         }
 
         entry.path = CompressedFile::NormalizeEntryPath(entry.path);
-        BinaryBuffer data;
-        if(!readEntryBytes(entry.path, data, outError)){
-            return false;
-        }
-
-        entry.size = static_cast<std::uint64_t>(data.size());
-        entry.hash = crcToHexString(data);
         entry.compression.clear();
 
         CompressedFile::WriteEntry writeEntry;
         writeEntry.path = entry.path;
-        writeEntry.data = data;
         writeEntry.isDirectory = false;
         writeEntry.preferCompression = true;
-        writeEntries.push_back(writeEntry);
+
+        // Entries untouched since the last save keep their compressed bytes and CRC from the archive.
+        const CompressedFile::Entry* storedEntry = archive->findEntry(entry.path);
+        if(cachedEntryData.find(entry.path) == cachedEntryData.end() && storedEntry && !storedEntry->isDirectory){
+            entry.size = static_cast<std::uint64_t>(storedEntry->uncompressedSize);
+            entry.hash = crcToHexString(storedEntry->crc32);
+            writeEntry.sourceArchive = archive.get();
+            writeEntry.sourceEntryPath = entry.path;
+            writeEntries.push_back(std::move(writeEntry));
+            continue;
+        }
+
+        if(!readEntryBytes(entry.path, writeEntry.data, outError)){
+            return false;
+        }
+        entry.size = static_cast<std::uint64_t>(writeEntry.data.size());
+        entry.hash = crcToHexString(CompressedFile::ComputeCRC32(writeEntry.data));
+        writeEntries.push_back(std::move(writeEntry));
     }
 
     std::string manifestJson;
@@ -687,7 +783,13 @@ bool AssetBundle::rebuildArchive(std::string* outError){
     manifestWriteEntry.path = ManifestEntryPath;
     manifestWriteEntry.data.assign(manifestJson.begin(), manifestJson.end());
     manifestWriteEntry.preferCompression = true;
-    writeEntries.insert(writeEntries.begin(), manifestWriteEntry);
+    writeEntries.insert(writeEntries.begin(), std::move(manifestWriteEntry));
 
-    return archive.writeToPath(bundlePath, writeEntries, outError);
+    CompressedFile nextArchive;
+    nextArchive.setCompressionLevel(archive->getCompressionLevel());
+    if(!nextArchive.writeToPath(bundlePath, writeEntries, outError)){
+        return false;
+    }
+    archive = std::make_shared<const CompressedFile>(std::move(nextArchive));
+    return true;
 }
@@ -6,9 +6,12 @@
 #ifndef ASSET_BUNDLE_H
 #define ASSET_BUNDLE_H
 
+#include <cstdint>
 #include <filesystem>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -22,8 +25,23 @@ class AssetBundle {
         std::filesystem::path bundlePath;
         std::string bundleAlias;
         JsonSchema::AssetManifestSchema manifest;
-        CompressedFile archive;
+        // Immutable once published: readers decompress from a snapshot outside `contentMutex`
+        // and saves swap in a new archive instead of rewriting this one.
+        std::shared_ptr<const CompressedFile> archive = std::make_shared<const CompressedFile>();
+        // Bytes the archive does not hold yet (added, updated or renamed entries); kept until save().
         std::map<std::string, BinaryBuffer> cachedEntryData;
+        /// @brief Holds data for ReadCacheEntry. `lruIt` points into `readCacheOrder`.
+        struct ReadCacheEntry {
+            BinaryBuffer data;
+            std::list<std::string>::iterator lruIt;
+        };
+        // Decompressed archive reads, most recently used first, held to `readCacheBudgetBytes`.
+        std::map<std::string, ReadCacheEntry> readCacheData;
+        std::list<std::string> readCacheOrder;
+        std::uint64_t readCacheBytes = 0;
+        std::uint64_t readCacheBudgetBytes = DefaultReadCacheBudgetBytes;
+        // Entry reads can arrive from AssetManager I/O workers while the editor edits the bundle.
+        std::recursive_mutex contentMutex;
 
         /**
          * @brief Finds a manifest entry by key.
@@ -58,9 +76,31 @@ class AssetBundle {
          * @return True when the operation succeeds; otherwise false.
          */
         bool rebuildArchive(std::string* outError);
+        /**
+         * @brief Stores a clean archive read in the read cache and trims it to budget.
+         * @param entryPath Normalized entry path.
+         * @param data Entry bytes.
+         */
+        void cacheArchiveRead(const std::string& entryPath, const BinaryBuffer& data);
+        /**
+         * @brief Drops an entry from the read cache.
+         * @param entryPath Normalized entry path.
+         */
+        void dropArchiveRead(const std::string& entryPath);
+        /**
+         * @brief Evicts least recently used reads until the read cache fits its budget.
+         */
+        void trimReadCache();
+        /**
+         * @brief Moves an entry's bytes to a new path so they survive the next save().
+         * @param fromPath Normalized entry path before the rename.
+         * @param toPath Normalized entry path after the rename.
+         */
+        void moveEntryData(const std::string& fromPath, const std::string& toPath);
 
     public:
         static constexpr const char* ManifestEntryPath = ".MANIFEST";
+        static constexpr std::uint64_t DefaultReadCacheBudgetBytes = 32ull * 1024ull * 1024ull;
 
         /**
          * @brief Checks whether bundle path.
@@ -118,6 +158,16 @@ class AssetBundle {
 
         bool readEntryBytes(const std::string& entryPath, BinaryBuffer& outData, std::string* outError = nullptr);
         bool readEntryText(const std::string& entryPath, std::string& outText, std::string* outError = nullptr);
+        /**
+         * @brief Sets the byte budget for decompressed archive reads and evicts down to it.
+         * @param budgetBytes Budget in bytes.
+         */
+        void setReadCacheBudgetBytes(std::uint64_t budgetBytes);
+        /**
+         * @brief Returns the bytes currently held by the read cache.
+         * @return Resident byte count.
+         */
+        std::uint64_t getReadCacheBytes();
         std::shared_ptr<Asset> loadAsset(const std::string& entryPath, std::string* outError = nullptr);
 
         bool addOrUpdateFileFromBuffer(
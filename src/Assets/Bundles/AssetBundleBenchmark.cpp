@@ -0,0 +1,298 @@
+/**
+ * @file src/Assets/Bundles/AssetBundleBenchmark.cpp
+ * @brief Implementation for AssetBundleBenchmark.
+ */
+
+#include "Assets/Bundles/AssetBundleBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <string>
+
+#include "Assets/Bundles/AssetBundle.h"
+#include "Foundation/Compression/Deflate.h"
+#include "Foundation/Logging/Logbot.h"
+#include "Foundation/Threading/WorkerPool.h"
+
+#include "STB/stb_image.h"
+// Private copy of the encoder CompressedFile used before Deflate, for the codec comparison.
+#define STB_IMAGE_WRITE_STATIC
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "STB/stb_image_write.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    // CompressedFile passed this quality to stbi_zlib_compress.
+    constexpr int kStbQuality = 8;
+
+    double elapsedMs(const BenchClock::time_point& start){
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    double bestOf(int iterations, const std::function<double()>& run){
+        double best = std::numeric_limits<double>::max();
+        for(int i = 0; i < iterations; ++i){
+            best = std::min(best, run());
+        }
+        return best;
+    }
+
+    /// @brief Holds data for BundleEntry: one file entry and its decoded bytes.
+    struct BundleEntry {
+        std::string path;
+        BinaryBuffer data;
+    };
+
+    bool loadEntries(AssetBundle& bundle, std::vector<BundleEntry>& outEntries, std::string* outError){
+        outEntries.clear();
+        for(const auto& entry : bundle.getEntries()){
+            if(entry.kind == "directory"){
+                continue;
+            }
+            BundleEntry loaded;
+            loaded.path = entry.path;
+            if(!bundle.readEntryBytes(entry.path, loaded.data, outError)){
+                return false;
+            }
+            outEntries.push_back(std::move(loaded));
+        }
+        return true;
+    }
+
+    bool entriesMatch(const std::filesystem::path& path, const std::vector<BundleEntry>& expected){
+        AssetBundle bundle;
+        std::vector<BundleEntry> actual;
+        if(!bundle.open(path, nullptr) || !loadEntries(bundle, actual, nullptr) || actual.size() != expected.size()){
+            return false;
+        }
+        for(size_t i = 0; i < expected.size(); ++i){
+            if(actual[i].path != expected[i].path || actual[i].data != expected[i].data){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Opens a fresh copy with the read cache disabled so every read decodes.
+    double timeReads(const std::filesystem::path& path, const std::vector<BundleEntry>& entries, bool parallel){
+        AssetBundle bundle;
+        bundle.open(path, nullptr);
+        bundle.setReadCacheBudgetBytes(0);
+        const BenchClock::time_point start = BenchClock::now();
+        auto readRange = [&](size_t, size_t begin, size_t end){
+            BinaryBuffer data;
+            for(size_t i = begin; i < end; ++i){
+                bundle.readEntryBytes(entries[i].path, data, nullptr);
+            }
+        };
+        if(parallel){
+            WorkerPool::Instance().parallelFor(entries.size(), 1, readRange);
+        }else{
+            readRange(0, 0, entries.size());
+        }
+        return elapsedMs(start);
+    }
+
+    double timeSave(const std::filesystem::path& path, const std::vector<BundleEntry>& entries, bool editAll){
+        AssetBundle bundle;
+        bundle.open(path, nullptr);
+        if(editAll){
+            // Re-adding the same bytes marks every entry edited, so save() recompresses all of them.
+            for(const BundleEntry& entry : entries){
+                bundle.addOrUpdateFileFromBuffer(entry.path, entry.data, std::string(), nullptr);
+            }
+        }
+        const BenchClock::time_point start = BenchClock::now();
+        bundle.save(nullptr);
+        return elapsedMs(start);
+    }
+
+    void setPoolWorkers(bool parallel){
+        WorkerPool& pool = WorkerPool::Instance();
+        pool.stop();
+        if(parallel){
+            pool.start();
+        }
+    }
+
+    bool measureCodecs(const std::vector<BundleEntry>& entries, int iterations, AssetBundleBenchmark::Sample& sample){
+        bool matched = true;
+        std::vector<BinaryBuffer> stbStreams(entries.size());
+        std::vector<BinaryBuffer> deflateStreams(entries.size());
+
+        sample.stbCompressMs = bestOf(iterations, [&](){
+            const BenchClock::time_point start = BenchClock::now();
+            for(size_t i = 0; i < entries.size(); ++i){
+                const BinaryBuffer& data = entries[i].data;
+                stbStreams[i].clear();
+                if(data.empty()){
+                    continue;
+                }
+                int wrappedSize = 0;
+                unsigned char* wrapped = stbi_zlib_compress(const_cast<unsigned char*>(data.data()),
+                                                            static_cast<int>(data.size()),
+                                                            &wrappedSize,
+                                                            kStbQuality);
+                // Strip the 2-byte zlib header and 4-byte Adler-32 trailer, as CompressedFile did.
+                if(wrapped && wrappedSize > 6){
+                    stbStreams[i].assign(wrapped + 2, wrapped + wrappedSize - 4);
+                }
+                STBIW_FREE(wrapped);
+            }
+            return elapsedMs(start);
+        });
+
+        sample.deflateCompressMs = bestOf(iterations, [&](){
+            const BenchClock::time_point start = BenchClock::now();
+            for(size_t i = 0; i < entries.size(); ++i){
+                // Empty entries are stored, not compressed, so neither codec sees them.
+                deflateStreams[i].clear();
+                if(entries[i].data.empty()){
+                    continue;
+                }
+                Deflate::Compress(entries[i].data.data(), entries[i].data.size(), Deflate::DefaultLevel, deflateStreams[i]);
+            }
+            return elapsedMs(start);
+        });
+
+        sample.stbCompressedBytes = 0;
+        sample.deflateCompressedBytes = 0;
+        for(size_t i = 0; i < entries.size(); ++i){
+            sample.stbCompressedBytes += stbStreams[i].size();
+            sample.deflateCompressedBytes += deflateStreams[i].size();
+        }
+
+        sample.stbDecompressMs = bestOf(iterations, [&](){
+            const BenchClock::time_point start = BenchClock::now();
+            for(size_t i = 0; i < entries.size(); ++i){
+                if(entries[i].data.empty()){
+                    continue;
+                }
+                int decodedSize = 0;
+                char* decoded = stbi_zlib_decode_noheader_malloc(reinterpret_cast<const char*>(stbStreams[i].data()),
+                                                                 static_cast<int>(stbStreams[i].size()),
+                                                                 &decodedSize);
+                const BinaryBuffer& expected = entries[i].data;
+                if(!decoded ||
+                   static_cast<size_t>(decodedSize) != expected.size() ||
+                   !std::equal(expected.begin(), expected.end(), reinterpret_cast<const uint8_t*>(decoded))){
+                    matched = false;
+                }
+                stbi_image_free(decoded);
+            }
+            return elapsedMs(start);
+        });
+
+        BinaryBuffer decoded;
+        sample.deflateDecompressMs = bestOf(iterations, [&](){
+            const BenchClock::time_point start = BenchClock::now();
+            for(size_t i = 0; i < entries.size(); ++i){
+                const BinaryBuffer& expected = entries[i].data;
+                if(expected.empty()){
+                    continue;
+                }
+                decoded.resize(expected.size());
+                if(!Deflate::Decompress(deflateStreams[i].data(), deflateStreams[i].size(), decoded.data(), decoded.size()) ||
+                   decoded != expected){
+                    matched = false;
+                }
+            }
+            return elapsedMs(start);
+        });
+        return matched;
+    }
+}
+
+AssetBundleBenchmark::Result AssetBundleBenchmark::Run(const std::filesystem::path& bundleDir, int iterations){
+    Result result;
+    iterations = std::max(iterations, 1);
+
+    std::error_code ec;
+    std::vector<std::filesystem::path> sources;
+    for(std::filesystem::directory_iterator it(bundleDir, ec), end; !ec && it != end; it.increment(ec)){
+        if(it->is_regular_file(ec) && AssetBundle::IsBundlePath(it->path())){
+            sources.push_back(it->path());
+        }
+    }
+    std::sort(sources.begin(), sources.end());
+    if(sources.empty()){
+        LogBot.Log(LOG_ERRO, "Bundle benchmark: no .bundle.asset files in '%s'.", bundleDir.generic_string().c_str());
+        return result;
+    }
+
+    const std::filesystem::path workDir = std::filesystem::temp_directory_path(ec) / "bundle-benchmark";
+    std::filesystem::create_directories(workDir, ec);
+    result.valid = true;
+
+    for(const std::filesystem::path& source : sources){
+        Sample sample;
+        sample.path = source;
+        const std::filesystem::path copy = workDir / source.filename();
+        std::filesystem::copy_file(source, copy, std::filesystem::copy_options::overwrite_existing, ec);
+
+        std::string error;
+        AssetBundle reference;
+        std::vector<BundleEntry> entries;
+        if(ec || !reference.open(copy, &error) || !loadEntries(reference, entries, &error)){
+            LogBot.Log(LOG_ERRO, "Bundle benchmark: failed to load '%s': %s",
+                       source.generic_string().c_str(),
+                       ec ? ec.message().c_str() : error.c_str());
+            result.valid = false;
+            continue;
+        }
+        sample.fileEntries = entries.size();
+        for(const BundleEntry& entry : entries){
+            sample.uncompressedBytes += entry.data.size();
+        }
+
+        setPoolWorkers(false);
+        sample.openMs = bestOf(iterations, [&](){
+            AssetBundle bundle;
+            const BenchClock::time_point start = BenchClock::now();
+            bundle.open(copy, nullptr);
+            return elapsedMs(start);
+        });
+        sample.readSerialMs = bestOf(iterations, [&](){ return timeReads(copy, entries, false); });
+        sample.saveUnchangedMs = bestOf(iterations, [&](){ return timeSave(copy, entries, false); });
+        sample.saveAllSerialMs = bestOf(iterations, [&](){ return timeSave(copy, entries, true); });
+
+        setPoolWorkers(true);
+        sample.readParallelMs = bestOf(iterations, [&](){ return timeReads(copy, entries, true); });
+        sample.saveAllParallelMs = bestOf(iterations, [&](){ return timeSave(copy, entries, true); });
+        setPoolWorkers(false);
+
+        sample.matched = entriesMatch(copy, entries) && measureCodecs(entries, iterations, sample);
+        if(!sample.matched){
+            result.valid = false;
+            LogBot.Log(LOG_ERRO, "Bundle benchmark: '%s' did not round-trip byte for byte.", source.filename().string().c_str());
+        }
+
+        LogBot.Log(LOG_INFO, "Bundle benchmark: %s (%llu entries, %.2f MiB) | open %.2f ms | read %.2f ms serial, %.2f ms parallel | save %.2f ms unchanged, %.2f ms all edited serial, %.2f ms parallel",
+                   source.filename().string().c_str(),
+                   static_cast<unsigned long long>(sample.fileEntries),
+                   static_cast<double>(sample.uncompressedBytes) / (1024.0 * 1024.0),
+                   sample.openMs,
+                   sample.readSerialMs,
+                   sample.readParallelMs,
+                   sample.saveUnchangedMs,
+                   sample.saveAllSerialMs,
+                   sample.saveAllParallelMs);
+        LogBot.Log(LOG_INFO, "Bundle benchmark: %s codecs | stb %llu bytes, %.2f ms encode, %.2f ms decode | Deflate level %d %llu bytes, %.2f ms encode, %.2f ms decode",
+                   source.filename().string().c_str(),
+                   static_cast<unsigned long long>(sample.stbCompressedBytes),
+                   sample.stbCompressMs,
+                   sample.stbDecompressMs,
+                   Deflate::DefaultLevel,
+                   static_cast<unsigned long long>(sample.deflateCompressedBytes),
+                   sample.deflateCompressMs,
+                   sample.deflateDecompressMs);
+        result.samples.push_back(sample);
+    }
+
+    std::filesystem::remove_all(workDir, ec);
+    return result;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file src/Assets/Bundles/AssetBundleBenchmark.h
+ * @brief Declarations for AssetBundleBenchmark.
+ */
+
+#ifndef ASSET_BUNDLE_BENCHMARK_H
+#define ASSET_BUNDLE_BENCHMARK_H
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+/// @brief Times opening, reading and saving asset bundles, and the old stb codec against Deflate.
+namespace AssetBundleBenchmark {
+    /// @brief Holds data for Sample: one bundle from the measured directory.
+    struct Sample {
+        std::filesystem::path path;
+        size_t fileEntries = 0;
+        size_t uncompressedBytes = 0;
+        /// Best time for AssetBundle::open().
+        double openMs = 0.0;
+        /// Best time to decode every entry on the calling thread, then across the worker pool.
+        double readSerialMs = 0.0;
+        double readParallelMs = 0.0;
+        /// Best save() with no entry edited, so every payload is copied as stored.
+        double saveUnchangedMs = 0.0;
+        /// Best save() with every entry edited, compressing on the calling thread, then across the pool.
+        double saveAllSerialMs = 0.0;
+        double saveAllParallelMs = 0.0;
+        /// Every entry encoded with stbi_zlib_compress (the codec before Deflate) and with Deflate.
+        size_t stbCompressedBytes = 0;
+        size_t deflateCompressedBytes = 0;
+        double stbCompressMs = 0.0;
+        double deflateCompressMs = 0.0;
+        double stbDecompressMs = 0.0;
+        double deflateDecompressMs = 0.0;
+        /// True when every round trip and every re-saved entry matched the original bytes.
+        bool matched = false;
+    };
+
+    /// @brief Holds data for Result.
+    struct Result {
+        std::vector<Sample> samples;
+        bool valid = false;
+    };
+
+    /**
+     * @brief Copies every `.bundle.asset` in `bundleDir` to a temporary directory and measures it there.
+     *
+     * The originals are never written. WorkerPool::Instance() is started for the parallel
+     * measurements and left stopped afterwards.
+     * @param bundleDir Directory to scan, normally res/bundles.
+     * @param iterations Runs per measurement; the fastest one is reported.
+     * @return Measured values; `valid` is false when a bundle failed to load or round-trip.
+     */
+    Result Run(const std::filesystem::path& bundleDir, int iterations = 5);
+}
+
+#endif // ASSET_BUNDLE_BENCHMARK_H
@@ -6,15 +6,58 @@
 
 #include <cstdlib>
 #include <cstdint>
+#include <iterator>
 #include <stdexcept>
 #include <vector>
 
 #include "Assets/Core/Asset.h"
 #include "Foundation/Logging/Logbot.h"
+#include "Foundation/Threading/WorkerPool.h"
 #include "Foundation/Util/StringUtils.h"
 
 inline static Logbot assetLogger = Logbot::CreateInstance("Asset Loader");
 
+namespace {
+    constexpr size_t kAssetIoThreadCount = 4;
+    constexpr const char* kFileSystemCacheBucket = "files";
+
+    // Disk-bound loads get their own threads so they never queue behind CPU work on WorkerPool::Instance().
+    WorkerPool& assetIoPool(){
+        static WorkerPool pool(kAssetIoThreadCount);
+        return pool;
+    }
+
+    // Source formats the engine only ever imports. Anything else (scenes, prefabs, materials,
+    // descriptors, bundles, cooked files) may be rewritten by the editor while an Asset still
+    // holds it, and a live mapping blocks that write on Windows, so those are always copied.
+    constexpr const char* kMappableExtensions[] = {
+        ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".dds", ".hdr",
+        ".obj", ".fbx", ".gltf", ".glb",
+        ".ttf", ".otf"
+    };
+
+    bool isMappableSourceFile(const std::string& path){
+        const size_t separator = path.find_last_of("/\\");
+        const size_t dot = path.find_last_of('.');
+        if(dot == std::string::npos || (separator != std::string::npos && dot < separator)){
+            return false;
+        }
+        const std::string extension = StringUtils::ToLowerCase(path.substr(dot));
+        for(const char* mappable : kMappableExtensions){
+            if(extension == mappable){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    AssetManager::AssetFuture makeReadyAssetFuture(std::shared_ptr<Asset> asset){
+        std::promise<std::shared_ptr<Asset>> promise;
+        promise.set_value(std::move(asset));
+        return promise.get_future().share();
+    }
+}
+
 AssetManager AssetManager::Instance;
 
 Asset::Asset(std::unique_ptr<File> currentFileHandle){
@@ -43,7 +86,14 @@ std::unique_ptr<File>& Asset::getFileHandle(){
 bool Asset::load(){
     if(this->isLoaded) return true;
     try{
-        this->fblob = FileReader::Read(this->fileHandle.get());
+        // Bundle entries borrow the in-memory file this asset owns; large import-only sources are
+        // mapped; everything else is read into memory so the editor can overwrite it.
+        File* file = this->fileHandle.get();
+        if(file && (file->isInMemoryFile() || isMappableSourceFile(file->getPath()))){
+            this->fblob = FileReader::Map(file);
+        }else{
+            this->fblob = FileReader::Read(file);
+        }
         this->isLoaded = true;
     }catch(const std::exception& e){
         assetLogger.LogVerbose(LOG_ERRO, "Failed to load asset '%s': %s",
@@ -77,7 +127,12 @@ std::string Asset::asString(){
 
 BinaryBuffer Asset::asRaw(){
     if(!this->isLoaded) return BinaryBuffer();
-    return this->fblob.data;
+    return this->fblob.view().toBuffer();
+}
+
+ByteView Asset::view() const{
+    if(!this->isLoaded) return ByteView();
+    return this->fblob.view();
 }
 
 void Asset::setCacheKey(const std::string& key){
@@ -88,6 +143,10 @@ const std::string& Asset::getCacheKey() const{
     return cacheKey;
 }
 
+size_t Asset::getResidentBytes() const{
+    return this->isLoaded ? this->fblob.size() : 0;
+}
+
 AssetManager::AssetManager(){
     registerBuiltInProviders();
 }
@@ -151,6 +210,70 @@ std::string AssetManager::NormalizeFileSystemKey(const std::string& name){
     return key;
 }
 
+std::string AssetManager::CacheBucketForKey(const std::string& cacheKey){
+    if(cacheKey.empty() || cacheKey[0] != '@'){
+        return kFileSystemCacheBucket;
+    }
+    return NormalizeAliasToken(cacheKey);
+}
+
+void AssetManager::storeAssetLocked(const std::string& cacheKey, const std::shared_ptr<Asset>& assetPtr){
+    auto existing = assetMap.find(cacheKey);
+    if(existing != assetMap.end()){
+        eraseAssetLocked(existing);
+    }
+
+    CacheEntry entry;
+    entry.asset = assetPtr;
+    entry.bytes = static_cast<std::uint64_t>(assetPtr->getResidentBytes());
+    entry.aliasKey = CacheBucketForKey(cacheKey);
+    lruOrder.push_front(cacheKey);
+    entry.lruIt = lruOrder.begin();
+
+    residentBytes += entry.bytes;
+    residentBytesByAlias[entry.aliasKey] += entry.bytes;
+    assetMap.emplace(cacheKey, std::move(entry));
+    evictToBudgetLocked();
+}
+
+std::unordered_map<std::string, AssetManager::CacheEntry>::iterator AssetManager::eraseAssetLocked(std::unordered_map<std::string, CacheEntry>::iterator it){
+    CacheEntry& entry = it->second;
+    residentBytes -= entry.bytes;
+    auto aliasIt = residentBytesByAlias.find(entry.aliasKey);
+    if(aliasIt != residentBytesByAlias.end()){
+        aliasIt->second -= entry.bytes;
+        if(aliasIt->second == 0){
+            residentBytesByAlias.erase(aliasIt);
+        }
+    }
+    lruOrder.erase(entry.lruIt);
+    return assetMap.erase(it);
+}
+
+void AssetManager::evictToBudgetLocked(){
+    if(residentBytes <= cacheBudgetBytes){
+        return;
+    }
+
+    // Walk from the least recently used end; assets still held elsewhere cannot be freed by eviction.
+    auto lruIt = lruOrder.end();
+    while(residentBytes > cacheBudgetBytes && lruIt != lruOrder.begin()){
+        --lruIt;
+        auto it = assetMap.find(*lruIt);
+        if(it == assetMap.end() || it->second.asset.use_count() > 1){
+            continue;
+        }
+
+        auto next = std::next(lruIt);
+        assetLogger.LogVerbose(LOG_INFO, "Evicting cached asset '%s' (%llu bytes).",
+                               it->first.c_str(),
+                               static_cast<unsigned long long>(it->second.bytes));
+        eraseAssetLocked(it);
+        ++cacheEvictions;
+        lruIt = next;
+    }
+}
+
 bool AssetManager::resolveRequest(const std::string& name, ResolvedRequest& outResolved, std::string* outError) const{
     outResolved = ResolvedRequest{};
     if(name.empty()){
@@ -163,14 +286,22 @@ bool AssetManager::resolveRequest(const std::string& name, ResolvedRequest& outR
     std::string alias;
     std::string remainder;
     if(ExtractAliasToken(name, alias, remainder)){
-        auto it = aliasResolvers.find(alias);
-        if(it == aliasResolvers.end()){
+        // Resolvers run unlocked; a copy keeps this one alive if it is unregistered meanwhile.
+        AliasResolver resolver;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            auto it = aliasResolvers.find(alias);
+            if(it != aliasResolvers.end()){
+                resolver = it->second;
+            }
+        }
+        if(!resolver){
             if(outError){
                 *outError = "No asset alias provider is registered for '" + alias + "'.";
             }
             return false;
         }
-        return it->second(name, outResolved, outError);
+        return resolver(name, outResolved, outError);
     }
 
     outResolved.cacheKey = NormalizeFileSystemKey(name);
@@ -233,7 +364,8 @@ void AssetManager::manageAsset(std::shared_ptr<Asset> assetPtr){
     }
 
     assetPtr->setCacheKey(key);
-    assetMap[key] = assetPtr;
+    std::lock_guard<std::mutex> lock(stateMutex);
+    storeAssetLocked(key, assetPtr);
 }
 
 void AssetManager::unmanageAsset(const std::string& name){
@@ -245,9 +377,10 @@ void AssetManager::unmanageAsset(const std::string& name){
         return;
     }
 
+    std::lock_guard<std::mutex> lock(stateMutex);
     auto it = assetMap.find(resolved.cacheKey);
     if(it != assetMap.end()){
-        assetMap.erase(it);
+        eraseAssetLocked(it);
     }
 }
 
@@ -258,9 +391,10 @@ void AssetManager::unmanageAliasAssets(const std::string& alias){
     }
 
     const std::string prefix = normalizedAlias + "/";
+    std::lock_guard<std::mutex> lock(stateMutex);
     for(auto it = assetMap.begin(); it != assetMap.end();){
         if(it->first == normalizedAlias || StringUtils::BeginsWith(it->first, prefix)){
-            it = assetMap.erase(it);
+            it = eraseAssetLocked(it);
         }else{
             ++it;
         }
@@ -273,8 +407,72 @@ bool AssetManager::hasAsset(const std::string& name){
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(stateMutex);
     auto it = assetMap.find(resolved.cacheKey);
-    return it != assetMap.end() && static_cast<bool>(it->second);
+    return it != assetMap.end() && static_cast<bool>(it->second.asset);
+}
+
+AssetManager::LoadTicket AssetManager::acquireLoadTicket(const std::string& cacheKey){
+    LoadTicket ticket;
+    std::lock_guard<std::mutex> lock(stateMutex);
+
+    auto cached = assetMap.find(cacheKey);
+    if(cached != assetMap.end()){
+        if(cached->second.asset){
+            ticket.cached = cached->second.asset;
+            lruOrder.splice(lruOrder.begin(), lruOrder, cached->second.lruIt);
+            ++cacheHits;
+            return ticket;
+        }
+        eraseAssetLocked(cached);
+    }
+    ++cacheMisses;
+
+    auto revisionIt = assetRevisions.find(cacheKey);
+    ticket.revision = (revisionIt != assetRevisions.end()) ? revisionIt->second : 0;
+
+    auto pending = pendingLoads.find(cacheKey);
+    if(pending != pendingLoads.end() && pending->second.revision == ticket.revision){
+        ticket.future = pending->second.future;
+        return ticket;
+    }
+
+    ticket.promise = std::make_shared<std::promise<std::shared_ptr<Asset>>>();
+    ticket.future = ticket.promise->get_future().share();
+    pendingLoads[cacheKey] = PendingLoad{ticket.future, ticket.revision};
+    return ticket;
+}
+
+std::shared_ptr<Asset> AssetManager::runLoad(const ResolvedRequest& resolved, std::uint64_t startRevision){
+    std::shared_ptr<Asset> assetPtr;
+    try{
+        assetPtr = resolved.loader();
+        if(assetPtr){
+            assetPtr->setCacheKey(resolved.cacheKey);
+            if(!assetPtr->load()){
+                assetPtr.reset();
+            }
+        }
+    }catch(const std::exception& e){
+        assetLogger.LogVerbose(LOG_ERRO, "Failed to load asset '%s': %s", resolved.cacheKey.c_str(), e.what());
+        assetPtr.reset();
+    }catch(...){
+        assetLogger.LogVerbose(LOG_ERRO, "Failed to load asset '%s': unknown exception", resolved.cacheKey.c_str());
+        assetPtr.reset();
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    auto pending = pendingLoads.find(resolved.cacheKey);
+    if(pending != pendingLoads.end() && pending->second.revision == startRevision){
+        pendingLoads.erase(pending);
+    }
+
+    auto revisionIt = assetRevisions.find(resolved.cacheKey);
+    const std::uint64_t currentRevision = (revisionIt != assetRevisions.end()) ? revisionIt->second : 0;
+    if(assetPtr && currentRevision == startRevision){
+        storeAssetLocked(resolved.cacheKey, assetPtr);
+    }
+    return assetPtr;
 }
 
 std::shared_ptr<Asset> AssetManager::getOrLoad(const std::string& name){
@@ -283,26 +481,46 @@ std::shared_ptr<Asset> AssetManager::getOrLoad(const std::string& name){
         return nullptr;
     }
 
-    auto cached = assetMap.find(resolved.cacheKey);
-    if(cached != assetMap.end()){
-        if(cached->second){
-            return cached->second;
-        }
-        assetMap.erase(cached);
+    LoadTicket ticket = acquireLoadTicket(resolved.cacheKey);
+    if(ticket.cached){
+        return ticket.cached;
+    }
+    if(!ticket.promise){
+        // Another thread is already reading this asset; share its result.
+        return ticket.future.get();
     }
 
-    auto assetPtr = resolved.loader();
-    if(!assetPtr){
-        return nullptr;
+    std::shared_ptr<Asset> assetPtr = runLoad(resolved, ticket.revision);
+    ticket.promise->set_value(assetPtr);
+    return assetPtr;
+}
+
+AssetManager::AssetFuture AssetManager::getOrLoadAsync(const std::string& name){
+    ResolvedRequest resolved;
+    if(!resolveRequest(name, resolved, nullptr) || resolved.cacheKey.empty() || !resolved.loader){
+        return makeReadyAssetFuture(nullptr);
     }
 
-    assetPtr->setCacheKey(resolved.cacheKey);
-    if(assetPtr->load()){
-        manageAsset(assetPtr);
-        return assetPtr;
+    LoadTicket ticket = acquireLoadTicket(resolved.cacheKey);
+    if(ticket.cached){
+        return makeReadyAssetFuture(ticket.cached);
+    }
+    if(ticket.promise){
+        auto promise = ticket.promise;
+        const std::uint64_t revision = ticket.revision;
+        assetIoPool().submit([this, resolved, promise, revision](){
+            promise->set_value(runLoad(resolved, revision));
+        });
     }
+    return ticket.future;
+}
 
-    return nullptr;
+void AssetManager::prefetch(const std::vector<std::string>& names){
+    for(const std::string& name : names){
+        if(!name.empty()){
+            getOrLoadAsync(name);
+        }
+    }
 }
 
 bool AssetManager::registerAliasProvider(const std::string& alias, const AliasResolver& resolver){
@@ -311,6 +529,7 @@ bool AssetManager::registerAliasProvider(const std::string& alias, const AliasRe
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(stateMutex);
     aliasResolvers[normalizedAlias] = resolver;
     return true;
 }
@@ -321,6 +540,7 @@ void AssetManager::unregisterAliasProvider(const std::string& alias){
         return;
     }
 
+    std::lock_guard<std::mutex> lock(stateMutex);
     aliasResolvers.erase(normalizedAlias);
 }
 
@@ -330,6 +550,7 @@ bool AssetManager::hasAliasProvider(const std::string& alias) const{
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(stateMutex);
     return aliasResolvers.find(normalizedAlias) != aliasResolvers.end();
 }
 
@@ -361,6 +582,7 @@ std::uint64_t AssetManager::getRevision(const std::string& name) const{
         return 0;
     }
 
+    std::lock_guard<std::mutex> lock(stateMutex);
     auto it = assetRevisions.find(cacheKey);
     if(it == assetRevisions.end()){
         return 0;
@@ -373,6 +595,7 @@ int AssetManager::addChangeListener(const AssetChangeListener& listener){
         return -1;
     }
 
+    std::lock_guard<std::mutex> lock(stateMutex);
     const int handle = nextChangeListenerHandle++;
     changeListeners[handle] = listener;
     return handle;
@@ -383,6 +606,7 @@ void AssetManager::removeChangeListener(int handle){
         return;
     }
 
+    std::lock_guard<std::mutex> lock(stateMutex);
     changeListeners.erase(handle);
 }
 
@@ -392,19 +616,27 @@ void AssetManager::notifyAssetChanged(const std::string& name){
         return;
     }
 
-    assetMap.erase(cacheKey);
-    const std::uint64_t revision = ++assetRevisions[cacheKey];
-
     AssetChangeEvent event;
     event.request = name;
     event.cacheKey = cacheKey;
-    event.revision = revision;
 
+    // Listeners run unlocked so they can reload through the manager.
     std::vector<AssetChangeListener> listeners;
-    listeners.reserve(changeListeners.size());
-    for(const auto& kv : changeListeners){
-        if(kv.second){
-            listeners.push_back(kv.second);
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        auto cached = assetMap.find(cacheKey);
+        if(cached != assetMap.end()){
+            eraseAssetLocked(cached);
+        }
+        // Loads still in flight finish for their waiters but are no longer cached or joined.
+        pendingLoads.erase(cacheKey);
+        event.revision = ++assetRevisions[cacheKey];
+
+        listeners.reserve(changeListeners.size());
+        for(const auto& kv : changeListeners){
+            if(kv.second){
+                listeners.push_back(kv.second);
+            }
         }
     }
 
@@ -413,3 +645,31 @@ void AssetManager::notifyAssetChanged(const std::string& name){
     }
 }
 
+void AssetManager::setCacheBudgetBytes(std::uint64_t budgetBytes){
+    std::lock_guard<std::mutex> lock(stateMutex);
+    cacheBudgetBytes = budgetBytes;
+    evictToBudgetLocked();
+}
+
+std::uint64_t AssetManager::getCacheBudgetBytes() const{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return cacheBudgetBytes;
+}
+
+void AssetManager::trimCache(){
+    std::lock_guard<std::mutex> lock(stateMutex);
+    evictToBudgetLocked();
+}
+
+AssetManager::CacheStats AssetManager::getCacheStats() const{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    CacheStats stats;
+    stats.residentBytes = residentBytes;
+    stats.budgetBytes = cacheBudgetBytes;
+    stats.residentCount = static_cast<std::uint64_t>(assetMap.size());
+    stats.hits = cacheHits;
+    stats.misses = cacheMisses;
+    stats.evictions = cacheEvictions;
+    stats.residentBytesByAlias = residentBytesByAlias;
+    return stats;
+}
@@ -17,7 +17,11 @@
 #include <filesystem>
 #include <functional>
 #include <cstdint>
+#include <future>
+#include <list>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 
 #define ASSET_DELIMITER "@assets"
@@ -73,6 +77,14 @@ class Asset{
          * @return Raw binary asset buffer.
          */
         BinaryBuffer asRaw();
+        /**
+         * @brief Returns loaded asset bytes without copying them.
+         *
+         * The view stays valid while this asset is alive; prefer it over asRaw() and asString()
+         * for parsers that only read the bytes.
+         * @return View over the asset contents, empty when not loaded.
+         */
+        ByteView view() const;
         /**
          * @brief Sets the cache key.
          * @param key Value for key.
@@ -89,6 +101,11 @@ class Asset{
          * @return True when the operation succeeds; otherwise false.
          */
         inline bool loaded() const {return isLoaded;};
+        /**
+         * @brief Returns the number of payload bytes this asset keeps in memory.
+         * @return Loaded byte count, or zero when not loaded.
+         */
+        size_t getResidentBytes() const;
 
         /**
          * @brief Loads all assets in a pack.
@@ -104,7 +121,16 @@ class Asset{
         static Asset CopyAsset(const Asset &asset);
 };
 
-/// @brief Represents the AssetManager type.
+/**
+ * @brief Caches assets by normalized key and loads them on demand.
+ *
+ * All members are safe to call from any thread. Concurrent requests for the same cache key
+ * share one load, whether they come through getOrLoad() or getOrLoadAsync().
+ *
+ * The cache is held to a byte budget. When an insert pushes it over, the least recently used
+ * assets that nothing outside the cache still references are evicted; referenced assets stay
+ * resident even if that leaves the cache over budget.
+ */
 class AssetManager{
     public:
         /// @brief Holds data for ResolvedRequest.
@@ -122,9 +148,55 @@ class AssetManager{
 
         using AliasResolver = std::function<bool(const std::string& request, ResolvedRequest& outResolved, std::string* outError)>;
         using AssetChangeListener = std::function<void(const AssetChangeEvent&)>;
+        using AssetFuture = std::shared_future<std::shared_ptr<Asset>>;
+
+        /// @brief Holds data for CacheStats.
+        struct CacheStats {
+            std::uint64_t residentBytes = 0;
+            std::uint64_t budgetBytes = 0;
+            std::uint64_t residentCount = 0;
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            std::uint64_t evictions = 0;
+            // Keyed by alias token (`@bundle`) for alias assets and "files" for filesystem assets.
+            std::map<std::string, std::uint64_t> residentBytesByAlias;
+        };
+
+        static constexpr std::uint64_t DefaultCacheBudgetBytes = 512ull * 1024ull * 1024ull;
 
     private:
-        std::map<std::string, std::shared_ptr<Asset>> assetMap;
+        /// @brief Holds data for PendingLoad.
+        struct PendingLoad {
+            AssetFuture future;
+            std::uint64_t revision = 0;
+        };
+
+        /// @brief Holds data for LoadTicket. `promise` is set when the caller owns a new load.
+        struct LoadTicket {
+            std::shared_ptr<Asset> cached;
+            AssetFuture future;
+            std::shared_ptr<std::promise<std::shared_ptr<Asset>>> promise;
+            std::uint64_t revision = 0;
+        };
+
+        /// @brief Holds data for CacheEntry. `lruIt` points into `lruOrder`.
+        struct CacheEntry {
+            std::shared_ptr<Asset> asset;
+            std::uint64_t bytes = 0;
+            std::string aliasKey;
+            std::list<std::string>::iterator lruIt;
+        };
+
+        mutable std::mutex stateMutex;
+        std::unordered_map<std::string, CacheEntry> assetMap;
+        std::list<std::string> lruOrder; // Most recently used first.
+        std::map<std::string, std::uint64_t> residentBytesByAlias;
+        std::uint64_t residentBytes = 0;
+        std::uint64_t cacheBudgetBytes = DefaultCacheBudgetBytes;
+        std::uint64_t cacheHits = 0;
+        std::uint64_t cacheMisses = 0;
+        std::uint64_t cacheEvictions = 0;
+        std::unordered_map<std::string, PendingLoad> pendingLoads;
         std::map<std::string, AliasResolver> aliasResolvers;
         std::unordered_map<std::string, std::uint64_t> assetRevisions;
         std::unordered_map<int, AssetChangeListener> changeListeners;
@@ -150,6 +222,28 @@ class AssetManager{
          * @return Resulting string value.
          */
         static std::string NormalizeFileSystemKey(const std::string& name);
+        /**
+         * @brief Returns the accounting bucket for a cache key.
+         * @param cacheKey Normalized cache key.
+         * @return Alias token for alias keys, otherwise "files".
+         */
+        static std::string CacheBucketForKey(const std::string& cacheKey);
+        /**
+         * @brief Inserts or replaces a cache entry and trims the cache to budget. Requires `stateMutex`.
+         * @param cacheKey Normalized cache key.
+         * @param assetPtr Asset to cache.
+         */
+        void storeAssetLocked(const std::string& cacheKey, const std::shared_ptr<Asset>& assetPtr);
+        /**
+         * @brief Removes a cache entry and its accounting. Requires `stateMutex`.
+         * @param it Entry to remove.
+         * @return Iterator following the removed entry.
+         */
+        std::unordered_map<std::string, CacheEntry>::iterator eraseAssetLocked(std::unordered_map<std::string, CacheEntry>::iterator it);
+        /**
+         * @brief Evicts unreferenced entries from the LRU tail until the cache fits its budget. Requires `stateMutex`.
+         */
+        void evictToBudgetLocked();
         /**
          * @brief Resolves an asset request into a loader and cache key.
          * @param name Name used for name.
@@ -162,6 +256,21 @@ class AssetManager{
          * @brief Registers built in providers.
          */
         void registerBuiltInProviders();
+        /**
+         * @brief Returns the cached asset for a key, joins its in-flight load, or registers a new load.
+         * @param cacheKey Normalized cache key.
+         * @return Ticket describing how the caller obtains the asset.
+         */
+        LoadTicket acquireLoadTicket(const std::string& cacheKey);
+        /**
+         * @brief Reads a resolved asset and publishes it to the cache.
+         *
+         * The result is cached only when the asset was not invalidated while loading.
+         * @param resolved Resolved request to load.
+         * @param startRevision Asset revision when the load was registered.
+         * @return Loaded asset, or null on failure.
+         */
+        std::shared_ptr<Asset> runLoad(const ResolvedRequest& resolved, std::uint64_t startRevision);
 
     public:
         /**
@@ -195,6 +304,22 @@ class AssetManager{
          * @return Shared pointer to the resolved asset.
          */
         std::shared_ptr<Asset> getOrLoad(const std::string& name);
+        /**
+         * @brief Returns a future for a cached asset, loading it on an I/O worker when needed.
+         *
+         * The future is already ready for cached assets and resolves to null when the request
+         * cannot be resolved or read.
+         * @param name Asset cache key or request name.
+         * @return Shared future for the asset.
+         */
+        AssetFuture getOrLoadAsync(const std::string& name);
+        /**
+         * @brief Starts background loads for several assets without waiting for them.
+         *
+         * Later getOrLoad() calls for the same assets join the in-flight loads or hit the cache.
+         * @param names Asset cache keys or request names.
+         */
+        void prefetch(const std::vector<std::string>& names);
         /**
          * @brief Registers alias provider.
          * @param alias Value for alias.
@@ -249,6 +374,25 @@ class AssetManager{
          * @param name Asset request, asset ref, or absolute path.
          */
         void notifyAssetChanged(const std::string& name);
+        /**
+         * @brief Sets the cache byte budget and evicts down to it.
+         * @param budgetBytes Budget in bytes; zero keeps only referenced assets.
+         */
+        void setCacheBudgetBytes(std::uint64_t budgetBytes);
+        /**
+         * @brief Returns the cache byte budget.
+         * @return Budget in bytes.
+         */
+        std::uint64_t getCacheBudgetBytes() const;
+        /**
+         * @brief Evicts unreferenced assets until the cache fits its budget.
+         */
+        void trimCache();
+        /**
+         * @brief Returns cache residency and hit/miss/eviction counters.
+         * @return Snapshot of the cache statistics.
+         */
+        CacheStats getCacheStats() const;
 
         static AssetManager Instance;
         
@@ -486,6 +486,18 @@ bool SaveToAssetRef(const std::string& assetRef, const ImageAssetData& data, std
     return writeTextAsset(assetRef, text, outError);
 }
 
+void PrefetchTextureSources(const std::vector<std::string>& imageOrAssetRefs){
+    std::vector<std::string> sourceRefs;
+    sourceRefs.reserve(imageOrAssetRefs.size());
+    for(const std::string& ref : imageOrAssetRefs){
+        std::string sourceRef;
+        if(ResolveTextureSourceAssetRef(ref, sourceRef, nullptr, nullptr) && !sourceRef.empty()){
+            sourceRefs.push_back(sourceRef);
+        }
+    }
+    AssetManager::Instance.prefetch(sourceRefs);
+}
+
 std::shared_ptr<Texture> InstantiateTexture(const ImageAssetData& data, std::string* outError){
     const std::string sourceRef = trimCopy(data.sourceImageRef);
     if(sourceRef.empty()){
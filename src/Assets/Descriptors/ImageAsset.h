@@ -10,6 +10,7 @@
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "Rendering/Textures/Texture.h"
 
@@ -77,6 +78,8 @@ namespace ImageAssetIO {
     bool SaveToAbsolutePath(const std::filesystem::path& path, const ImageAssetData& data, std::string* outError = nullptr);
     bool SaveToAssetRef(const std::string& assetRef, const ImageAssetData& data, std::string* outError = nullptr);
 
+    void PrefetchTextureSources(const std::vector<std::string>& imageOrAssetRefs);
+
     std::shared_ptr<Texture> InstantiateTexture(const ImageAssetData& data, std::string* outError = nullptr);
     std::shared_ptr<Texture> InstantiateTextureFromRef(const std::string& imageOrAssetRef,
                                                        std::string* outResolvedImageAssetRef = nullptr,
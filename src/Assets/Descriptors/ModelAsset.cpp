@@ -245,7 +245,18 @@ std::shared_ptr<Model> InstantiateModel(const ModelAssetData& data, std::string*
         return nullptr;
     }
 
-    auto sourceAsset = AssetManager::Instance.getOrLoad(sourceRef);
+    // Read the source on an I/O worker while the default material and its textures load here.
+    AssetManager::AssetFuture sourceFuture = AssetManager::Instance.getOrLoadAsync(sourceRef);
+
+    std::shared_ptr<Material> fallbackMaterial;
+    if(!data.defaultMaterialRef.empty()){
+        fallbackMaterial = MaterialAssetIO::InstantiateMaterialFromRef(data.defaultMaterialRef, nullptr, nullptr);
+    }
+    if(!fallbackMaterial){
+        fallbackMaterial = MaterialDefaults::LitColorMaterial::Create(Color::WHITE);
+    }
+
+    auto sourceAsset = sourceFuture.get();
     if(!sourceAsset){
         sourceAsset = std::make_shared<Asset>(sourcePath.string());
         if(!sourceAsset || !sourceAsset->load()){
@@ -256,14 +267,6 @@ std::shared_ptr<Model> InstantiateModel(const ModelAssetData& data, std::string*
         }
     }
 
-    std::shared_ptr<Material> fallbackMaterial;
-    if(!data.defaultMaterialRef.empty()){
-        fallbackMaterial = MaterialAssetIO::InstantiateMaterialFromRef(data.defaultMaterialRef, nullptr, nullptr);
-    }
-    if(!fallbackMaterial){
-        fallbackMaterial = MaterialDefaults::LitColorMaterial::Create(Color::WHITE);
-    }
-
     if(sourceExt == ".obj"){
         const bool forceSmooth = (data.forceSmoothNormals != 0);
         auto model = OBJLoader::LoadFromAsset(sourceAsset, fallbackMaterial, forceSmooth);
@@ -223,6 +223,16 @@ std::shared_ptr<SkyBox> InstantiateSkyBox(const SkyboxAssetData& data, std::stri
         return nullptr;
     }
 
+    // Read all six faces in parallel; the loads below then join them in order.
+    ImageAssetIO::PrefetchTextureSources({
+        trimCopy(data.rightFaceRef),
+        trimCopy(data.leftFaceRef),
+        trimCopy(data.topFaceRef),
+        trimCopy(data.bottomFaceRef),
+        trimCopy(data.frontFaceRef),
+        trimCopy(data.backFaceRef)
+    });
+
     SkyBox6Face faces;
     if(!loadFaceAsset(trimCopy(data.rightFaceRef), faces.rightFaceAsset, outError) ||
        !loadFaceAsset(trimCopy(data.leftFaceRef), faces.leftFaceAsset, outError) ||
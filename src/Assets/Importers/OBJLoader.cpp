@@ -12,12 +12,14 @@
 #include "Assets/Importers/MtlMaterialImporter.h"
 #include "Foundation/Util/StringUtils.h"
 
+#include "Foundation/Threading/WorkerPool.h"
+
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cstring>
 #include <filesystem>
 #include <map>
-#include <sstream>
-#include <tuple>
 #include <unordered_map>
 
 #include <glm/glm.hpp>
@@ -31,14 +33,77 @@ namespace {
         return StringUtils::ToLowerCase(value);
     }
 
-    int parseObjIndex(const std::string& token, int count){
+    // Inputs larger than this are parsed as several line-aligned chunks.
+    constexpr size_t kObjParseChunkBytes = 256 * 1024;
+
+    bool isObjSpace(char c){
+        return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    const char* skipObjSpaces(const char* cursor, const char* end){
+        while(cursor < end && isObjSpace(*cursor)){
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    std::string_view readObjToken(const char*& cursor, const char* end){
+        cursor = skipObjSpaces(cursor, end);
+        const char* tokenStart = cursor;
+        while(cursor < end && !isObjSpace(*cursor)){
+            ++cursor;
+        }
+        return std::string_view(tokenStart, static_cast<size_t>(cursor - tokenStart));
+    }
+
+    std::string_view trimObjView(std::string_view value){
+        while(!value.empty() && isObjSpace(value.front())){
+            value.remove_prefix(1);
+        }
+        while(!value.empty() && isObjSpace(value.back())){
+            value.remove_suffix(1);
+        }
+        return value;
+    }
+
+    /// @brief Reads the next line in `[cursor, end)` and advances past its newline.
+    std::string_view nextObjLine(const char*& cursor, const char* end){
+        const char* lineStart = cursor;
+        const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        if(!lineEnd){
+            lineEnd = end;
+            cursor = end;
+        }else{
+            cursor = lineEnd + 1;
+        }
+        return std::string_view(lineStart, static_cast<size_t>(lineEnd - lineStart));
+    }
+
+    /// @brief Parses up to `count` floats, leaving the rest untouched once a value fails to parse.
+    void parseObjFloats(const char* cursor, const char* end, float* outValues, int count){
+        for(int i = 0; i < count; ++i){
+            cursor = skipObjSpaces(cursor, end);
+            if(cursor < end && *cursor == '+'){
+                ++cursor;
+            }
+            const std::from_chars_result result = std::from_chars(cursor, end, outValues[i]);
+            if(result.ec != std::errc()){
+                return;
+            }
+            cursor = result.ptr;
+        }
+    }
+
+    int parseObjIndex(std::string_view token, int count){
+        if(!token.empty() && token.front() == '+'){
+            token.remove_prefix(1);
+        }
         if(token.empty()){
             return -1;
         }
         int raw = 0;
-        try{
-            raw = std::stoi(token);
-        }catch(...){
+        const std::from_chars_result result = std::from_chars(token.data(), token.data() + token.size(), raw);
+        if(result.ec != std::errc()){
             return -1;
         }
 
@@ -51,7 +116,61 @@ namespace {
         return -1;
     }
 
-    std::vector<std::string> parseMtllibTokens(const std::string& raw){
+    /// @brief Identifies the OBJ statements the loader understands.
+    enum class ObjKeyword {
+        Other,
+        Position,
+        Normal,
+        TexCoord,
+        Face,
+        UseMaterial,
+        MaterialLibrary
+    };
+
+    ObjKeyword classifyObjKeyword(std::string_view keyword){
+        if(keyword == "v"){
+            return ObjKeyword::Position;
+        }
+        if(keyword == "vn"){
+            return ObjKeyword::Normal;
+        }
+        if(keyword == "vt"){
+            return ObjKeyword::TexCoord;
+        }
+        if(keyword == "f"){
+            return ObjKeyword::Face;
+        }
+        if(keyword == "usemtl"){
+            return ObjKeyword::UseMaterial;
+        }
+        if(keyword == "mtllib"){
+            return ObjKeyword::MaterialLibrary;
+        }
+        return ObjKeyword::Other;
+    }
+
+    /// @brief Holds data for ObjVertexKey.
+    struct ObjVertexKey {
+        int posIdx = -1;
+        int texIdx = -1;
+        int normIdx = -1;
+
+        bool operator==(const ObjVertexKey& other) const{
+            return posIdx == other.posIdx && texIdx == other.texIdx && normIdx == other.normIdx;
+        }
+    };
+
+    /// @brief Hashes ObjVertexKey values.
+    struct ObjVertexKeyHash {
+        size_t operator()(const ObjVertexKey& key) const{
+            std::uint64_t hash = static_cast<std::uint32_t>(key.posIdx);
+            hash = hash * 0x9E3779B97F4A7C15ull + static_cast<std::uint32_t>(key.texIdx);
+            hash = hash * 0x9E3779B97F4A7C15ull + static_cast<std::uint32_t>(key.normIdx);
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+    };
+
+    std::vector<std::string> parseMtllibTokens(std::string_view raw){
         std::vector<std::string> out;
         std::string current;
         bool inQuotes = false;
@@ -96,79 +215,199 @@ namespace {
     }
 }
 
-OBJLoader::OBJData OBJLoader::ParseOBJData(const std::string& content){
+OBJLoader::OBJData OBJLoader::ParseOBJData(std::string_view content){
     OBJData data;
-    std::istringstream stream(content);
-    std::string line;
-    std::string currentMaterialName;
-
-    while(std::getline(stream, line)){
-        std::string trimmed = trimCopy(line);
-        if(trimmed.empty() || trimmed[0] == '#'){
-            continue;
-        }
+    data.materialNames.push_back(std::string());
+
+    // Split into line-aligned chunks; small files stay a single chunk.
+    const char* const contentBegin = content.data();
+    const char* const contentEnd = content.data() + content.size();
+    const size_t chunkCount = std::max<size_t>(1, content.size() / kObjParseChunkBytes);
+    std::vector<const char*> chunkStarts(chunkCount + 1, contentEnd);
+    chunkStarts[0] = contentBegin;
+    for(size_t i = 1; i < chunkCount; ++i){
+        const char* split = std::max(contentBegin + (content.size() * i) / chunkCount, chunkStarts[i - 1]);
+        const char* newline = static_cast<const char*>(std::memchr(split, '\n', static_cast<size_t>(contentEnd - split)));
+        chunkStarts[i] = newline ? newline + 1 : contentEnd;
+    }
 
-        std::istringstream iss(trimmed);
-        std::string prefix;
-        iss >> prefix;
-
-        if(prefix == "v"){
-            float x = 0.0f;
-            float y = 0.0f;
-            float z = 0.0f;
-            iss >> x >> y >> z;
-            data.positions.push_back(Math3D::Vec3(x, y, z));
-        }else if(prefix == "vn"){
-            float x = 0.0f;
-            float y = 0.0f;
-            float z = 0.0f;
-            iss >> x >> y >> z;
-            data.normals.push_back(Math3D::Vec3(x, y, z));
-        }else if(prefix == "vt"){
-            float u = 0.0f;
-            float v = 0.0f;
-            iss >> u >> v;
-            data.texCoords.push_back(Math3D::Vec2(u, v));
-        }else if(prefix == "usemtl"){
-            std::string materialName;
-            std::getline(iss, materialName);
-            currentMaterialName = trimCopy(materialName);
-        }else if(prefix == "mtllib"){
-            std::string libRemainder;
-            std::getline(iss, libRemainder);
-            for(const std::string& token : parseMtllibTokens(libRemainder)){
-                if(!token.empty()){
-                    data.materialLibs.push_back(token);
-                }
-            }
-        }else if(prefix == "f"){
-            FaceDefinition face;
-            face.materialName = currentMaterialName;
+    /// @brief Holds data for ChunkCounts, gathered by the counting pass.
+    struct ChunkCounts {
+        size_t positions = 0;
+        size_t normals = 0;
+        size_t texCoords = 0;
+        bool setsMaterial = false;
+        std::string_view lastMaterial;
+    };
 
-            std::string vertexToken;
-            while(iss >> vertexToken){
-                std::vector<std::string> parts = StringUtils::Split(vertexToken, "/");
+    /// @brief Holds data for ChunkFaces. Face material indices refer to `materialNames`.
+    struct ChunkFaces {
+        std::vector<VertexIndex> faceVertices;
+        std::vector<FaceDefinition> faces;
+        std::vector<std::string> materialNames;
+        std::vector<std::string> materialLibs;
+    };
 
-                VertexIndex idx;
-                if(!parts.empty() && !parts[0].empty()){
-                    idx.posIdx = parseObjIndex(parts[0], static_cast<int>(data.positions.size()));
-                }
-                if(parts.size() > 1 && !parts[1].empty()){
-                    idx.texIdx = parseObjIndex(parts[1], static_cast<int>(data.texCoords.size()));
-                }
-                if(parts.size() > 2 && !parts[2].empty()){
-                    idx.normIdx = parseObjIndex(parts[2], static_cast<int>(data.normals.size()));
+    std::vector<ChunkCounts> counts(chunkCount);
+    WorkerPool::Instance().parallelFor(chunkCount, 1, [&](size_t, size_t begin, size_t end){
+        for(size_t chunk = begin; chunk < end; ++chunk){
+            ChunkCounts& chunkCounts = counts[chunk];
+            const char* cursor = chunkStarts[chunk];
+            const char* const chunkEnd = chunkStarts[chunk + 1];
+            while(cursor < chunkEnd){
+                const std::string_view line = nextObjLine(cursor, chunkEnd);
+                const char* lineCursor = line.data();
+                const char* const lineEnd = line.data() + line.size();
+                switch(classifyObjKeyword(readObjToken(lineCursor, lineEnd))){
+                    case ObjKeyword::Position: chunkCounts.positions++; break;
+                    case ObjKeyword::Normal: chunkCounts.normals++; break;
+                    case ObjKeyword::TexCoord: chunkCounts.texCoords++; break;
+                    case ObjKeyword::UseMaterial:
+                        chunkCounts.setsMaterial = true;
+                        chunkCounts.lastMaterial = trimObjView(std::string_view(lineCursor, static_cast<size_t>(lineEnd - lineCursor)));
+                        break;
+                    default: break;
                 }
+            }
+        }
+    });
+
+    std::vector<size_t> positionBase(chunkCount, 0);
+    std::vector<size_t> normalBase(chunkCount, 0);
+    std::vector<size_t> texCoordBase(chunkCount, 0);
+    std::vector<std::string_view> inheritedMaterial(chunkCount);
+    size_t positionTotal = 0;
+    size_t normalTotal = 0;
+    size_t texCoordTotal = 0;
+    std::string_view currentMaterial;
+    for(size_t chunk = 0; chunk < chunkCount; ++chunk){
+        positionBase[chunk] = positionTotal;
+        normalBase[chunk] = normalTotal;
+        texCoordBase[chunk] = texCoordTotal;
+        inheritedMaterial[chunk] = currentMaterial;
+        positionTotal += counts[chunk].positions;
+        normalTotal += counts[chunk].normals;
+        texCoordTotal += counts[chunk].texCoords;
+        if(counts[chunk].setsMaterial){
+            currentMaterial = counts[chunk].lastMaterial;
+        }
+    }
 
-                if(idx.posIdx >= 0 && idx.posIdx < static_cast<int>(data.positions.size())){
-                    face.vertices.push_back(idx);
+    data.positions.resize(positionTotal, Math3D::Vec3(0.0f, 0.0f, 0.0f));
+    data.normals.resize(normalTotal, Math3D::Vec3(0.0f, 0.0f, 0.0f));
+    data.texCoords.resize(texCoordTotal, Math3D::Vec2(0.0f, 0.0f));
+
+    std::vector<ChunkFaces> chunkFaces(chunkCount);
+    WorkerPool::Instance().parallelFor(chunkCount, 1, [&](size_t, size_t begin, size_t end){
+        for(size_t chunk = begin; chunk < end; ++chunk){
+            ChunkFaces& out = chunkFaces[chunk];
+            size_t positionCount = positionBase[chunk];
+            size_t normalCount = normalBase[chunk];
+            size_t texCoordCount = texCoordBase[chunk];
+            out.materialNames.push_back(std::string(inheritedMaterial[chunk]));
+            std::uint32_t materialIndex = 0;
+
+            const char* cursor = chunkStarts[chunk];
+            const char* const chunkEnd = chunkStarts[chunk + 1];
+            while(cursor < chunkEnd){
+                const std::string_view line = nextObjLine(cursor, chunkEnd);
+                const char* lineCursor = line.data();
+                const char* const lineEnd = line.data() + line.size();
+                const ObjKeyword keyword = classifyObjKeyword(readObjToken(lineCursor, lineEnd));
+
+                if(keyword == ObjKeyword::Position || keyword == ObjKeyword::Normal){
+                    float xyz[3] = {0.0f, 0.0f, 0.0f};
+                    parseObjFloats(lineCursor, lineEnd, xyz, 3);
+                    if(keyword == ObjKeyword::Position){
+                        data.positions[positionCount++] = Math3D::Vec3(xyz[0], xyz[1], xyz[2]);
+                    }else{
+                        data.normals[normalCount++] = Math3D::Vec3(xyz[0], xyz[1], xyz[2]);
+                    }
+                }else if(keyword == ObjKeyword::TexCoord){
+                    float uv[2] = {0.0f, 0.0f};
+                    parseObjFloats(lineCursor, lineEnd, uv, 2);
+                    data.texCoords[texCoordCount++] = Math3D::Vec2(uv[0], uv[1]);
+                }else if(keyword == ObjKeyword::UseMaterial){
+                    const std::string_view materialName = trimObjView(std::string_view(lineCursor, static_cast<size_t>(lineEnd - lineCursor)));
+                    auto existing = std::find(out.materialNames.begin(), out.materialNames.end(), materialName);
+                    if(existing == out.materialNames.end()){
+                        out.materialNames.push_back(std::string(materialName));
+                        existing = out.materialNames.end() - 1;
+                    }
+                    materialIndex = static_cast<std::uint32_t>(existing - out.materialNames.begin());
+                }else if(keyword == ObjKeyword::MaterialLibrary){
+                    for(const std::string& token : parseMtllibTokens(std::string_view(lineCursor, static_cast<size_t>(lineEnd - lineCursor)))){
+                        if(!token.empty()){
+                            out.materialLibs.push_back(token);
+                        }
+                    }
+                }else if(keyword == ObjKeyword::Face){
+                    FaceDefinition face;
+                    face.firstVertex = static_cast<std::uint32_t>(out.faceVertices.size());
+                    face.materialIndex = materialIndex;
+
+                    for(std::string_view vertexToken = readObjToken(lineCursor, lineEnd);
+                        !vertexToken.empty();
+                        vertexToken = readObjToken(lineCursor, lineEnd)){
+                        // Fields are position[/texcoord[/normal]], any of the last two may be empty.
+                        std::string_view parts[3];
+                        for(int part = 0; part < 3 && !vertexToken.empty(); ++part){
+                            const size_t slash = vertexToken.find('/');
+                            parts[part] = vertexToken.substr(0, slash);
+                            vertexToken = (slash == std::string_view::npos) ? std::string_view() : vertexToken.substr(slash + 1);
+                        }
+
+                        VertexIndex idx;
+                        idx.posIdx = parseObjIndex(parts[0], static_cast<int>(positionCount));
+                        idx.texIdx = parseObjIndex(parts[1], static_cast<int>(texCoordCount));
+                        idx.normIdx = parseObjIndex(parts[2], static_cast<int>(normalCount));
+                        if(idx.posIdx >= 0 && idx.posIdx < static_cast<int>(positionCount)){
+                            out.faceVertices.push_back(idx);
+                        }
+                    }
+
+                    face.vertexCount = static_cast<std::uint32_t>(out.faceVertices.size() - face.firstVertex);
+                    if(face.vertexCount >= 3){
+                        out.faces.push_back(face);
+                    }else{
+                        out.faceVertices.resize(face.firstVertex);
+                    }
                 }
             }
-
-            if(face.vertices.size() >= 3){
-                data.faces.push_back(std::move(face));
+        }
+    });
+
+    // Stitch chunks together in file order, remapping chunk-local material slots.
+    size_t faceVertexTotal = 0;
+    size_t faceTotal = 0;
+    for(const ChunkFaces& chunk : chunkFaces){
+        faceVertexTotal += chunk.faceVertices.size();
+        faceTotal += chunk.faces.size();
+    }
+    data.faceVertices.reserve(faceVertexTotal);
+    data.faces.reserve(faceTotal);
+
+    std::unordered_map<std::string, std::uint32_t> materialSlots;
+    materialSlots.emplace(std::string(), 0u);
+    std::vector<std::uint32_t> slotRemap;
+    for(ChunkFaces& chunk : chunkFaces){
+        slotRemap.clear();
+        for(const std::string& materialName : chunk.materialNames){
+            auto inserted = materialSlots.emplace(materialName, static_cast<std::uint32_t>(data.materialNames.size()));
+            if(inserted.second){
+                data.materialNames.push_back(materialName);
             }
+            slotRemap.push_back(inserted.first->second);
+        }
+
+        const std::uint32_t vertexOffset = static_cast<std::uint32_t>(data.faceVertices.size());
+        for(FaceDefinition face : chunk.faces){
+            face.firstVertex += vertexOffset;
+            face.materialIndex = slotRemap[face.materialIndex];
+            data.faces.push_back(face);
         }
+        data.faceVertices.insert(data.faceVertices.end(), chunk.faceVertices.begin(), chunk.faceVertices.end());
+        data.materialLibs.insert(data.materialLibs.end(), chunk.materialLibs.begin(), chunk.materialLibs.end());
     }
 
     return data;
@@ -205,13 +444,14 @@ std::vector<Math3D::Vec3> OBJLoader::BuildSmoothNormals(const OBJData& data){
     };
 
     for(const auto& face : data.faces){
-        if(face.vertices.size() < 3){
+        if(face.vertexCount < 3){
             continue;
         }
 
-        const int base = face.vertices[0].posIdx;
-        for(size_t i = 1; i + 1 < face.vertices.size(); ++i){
-            accumulateTriangleNormal(base, face.vertices[i].posIdx, face.vertices[i + 1].posIdx);
+        const VertexIndex* corners = data.faceVertices.data() + face.firstVertex;
+        const int base = corners[0].posIdx;
+        for(size_t i = 1; i + 1 < face.vertexCount; ++i){
+            accumulateTriangleNormal(base, corners[i].posIdx, corners[i + 1].posIdx);
         }
     }
 
@@ -226,6 +466,128 @@ std::vector<Math3D::Vec3> OBJLoader::BuildSmoothNormals(const OBJData& data){
     return smoothNormals;
 }
 
+void OBJLoader::BuildParts(const OBJData& data, bool forceSmoothNormals, std::vector<PartGeometry>& outParts){
+    outParts.clear();
+
+    std::vector<Math3D::Vec3> smoothNormals;
+    if(forceSmoothNormals){
+        smoothNormals = BuildSmoothNormals(data);
+    }
+
+    /// @brief Represents Part Build State data.
+    struct PartBuildState {
+        PartGeometry geometry;
+        std::unordered_map<ObjVertexKey, std::uint32_t, ObjVertexKeyHash> vertexMap;
+    };
+
+    std::map<std::string, PartBuildState> partStates;
+
+    // Resolve each usemtl name once; faces then index straight into their part.
+    std::vector<PartBuildState*> partsByMaterial(data.materialNames.size(), nullptr);
+    auto partForMaterial = [&](std::uint32_t materialIndex) -> PartBuildState& {
+        PartBuildState*& cached = partsByMaterial[materialIndex];
+        if(!cached){
+            const std::string key = toLowerCopy(trimCopy(data.materialNames[materialIndex]));
+            cached = &partStates[key];
+            cached->geometry.materialKey = key;
+        }
+        return *cached;
+    };
+
+    std::vector<std::uint32_t> faceIndices;
+    for(const auto& face : data.faces){
+        if(face.vertexCount < 3){
+            continue;
+        }
+
+        PartBuildState& partState = partForMaterial(face.materialIndex);
+        std::vector<Vertex>& vertices = partState.geometry.vertices;
+
+        faceIndices.clear();
+        const VertexIndex* corners = data.faceVertices.data() + face.firstVertex;
+        for(std::uint32_t corner = 0; corner < face.vertexCount; ++corner){
+            const VertexIndex& vidx = corners[corner];
+            if(vidx.posIdx < 0 || vidx.posIdx >= static_cast<int>(data.positions.size())){
+                continue;
+            }
+
+            const ObjVertexKey key{vidx.posIdx, vidx.texIdx, vidx.normIdx};
+            auto existing = partState.vertexMap.find(key);
+            if(existing == partState.vertexMap.end()){
+                Vertex vtx = Vertex::Build();
+                vtx.Position = data.positions[vidx.posIdx];
+
+                if(forceSmoothNormals && vidx.posIdx >= 0 && vidx.posIdx < static_cast<int>(smoothNormals.size())){
+                    vtx.Normal = smoothNormals[vidx.posIdx];
+                }else if(vidx.normIdx >= 0 && vidx.normIdx < static_cast<int>(data.normals.size())){
+                    vtx.Normal = data.normals[vidx.normIdx];
+                }else{
+                    vtx.Normal = Math3D::Vec3(0.0f, 1.0f, 0.0f);
+                }
+
+                if(vidx.texIdx >= 0 && vidx.texIdx < static_cast<int>(data.texCoords.size())){
+                    vtx.TexCoords = data.texCoords[vidx.texIdx];
+                }else{
+                    vtx.TexCoords = Math3D::Vec2(0.0f, 0.0f);
+                }
+
+                vtx.Color = Math3D::Vec4(1.0f, 1.0f, 1.0f, 1.0f);
+
+                const std::uint32_t index = static_cast<std::uint32_t>(vertices.size());
+                vertices.push_back(vtx);
+                partState.vertexMap.emplace(key, index);
+                faceIndices.push_back(index);
+            }else{
+                faceIndices.push_back(existing->second);
+            }
+        }
+
+        if(faceIndices.size() < 3){
+            continue;
+        }
+
+        std::vector<std::uint32_t>& indices = partState.geometry.indices;
+        if(faceIndices.size() == 4){
+            // Same split as ModelPartFactory::defineFace() for quads.
+            indices.insert(indices.end(), {faceIndices[0], faceIndices[1], faceIndices[2],
+                                           faceIndices[2], faceIndices[3], faceIndices[0]});
+        }else{
+            for(size_t i = 1; i + 1 < faceIndices.size(); ++i){
+                indices.insert(indices.end(), {faceIndices[0], faceIndices[i], faceIndices[i + 1]});
+            }
+        }
+    }
+
+    for(auto& kv : partStates){
+        if(!kv.second.geometry.indices.empty()){
+            outParts.push_back(std::move(kv.second.geometry));
+        }
+    }
+}
+
+bool OBJLoader::BuildGeometry(std::string_view content,
+                              bool forceSmoothNormals,
+                              std::vector<PartGeometry>& outParts,
+                              std::string* outError){
+    outParts.clear();
+    const OBJData data = ParseOBJData(content);
+    if(data.positions.empty()){
+        if(outError){
+            *outError = "No vertices found in OBJ data";
+        }
+        return false;
+    }
+    if(data.faces.empty()){
+        if(outError){
+            *outError = "No faces found in OBJ data";
+        }
+        return false;
+    }
+
+    BuildParts(data, forceSmoothNormals, outParts);
+    return true;
+}
+
 std::shared_ptr<Model> OBJLoader::LoadFromAsset(PAsset asset, PMaterial material, bool forceSmoothNormals){
     if(!asset){
         LogBot.Log(LOG_ERRO, "OBJLoader::LoadFromAsset - Asset is null");
@@ -237,7 +599,7 @@ std::shared_ptr<Model> OBJLoader::LoadFromAsset(PAsset asset, PMaterial material
         return nullptr;
     }
 
-    const std::string objContent = asset->asString();
+    const std::string_view objContent = asset->view().asStringView();
     if(objContent.empty()){
         LogBot.Log(LOG_ERRO, "OBJLoader::LoadFromAsset - Asset content is empty");
         return nullptr;
@@ -253,11 +615,6 @@ std::shared_ptr<Model> OBJLoader::LoadFromAsset(PAsset asset, PMaterial material
         return nullptr;
     }
 
-    std::vector<Math3D::Vec3> smoothNormals;
-    if(forceSmoothNormals){
-        smoothNormals = BuildSmoothNormals(data);
-    }
-
     std::shared_ptr<Material> fallbackMaterial = material;
     if(!fallbackMaterial){
         fallbackMaterial = MaterialDefaults::LitColorMaterial::Create(Color::WHITE);
@@ -318,111 +675,43 @@ std::shared_ptr<Model> OBJLoader::LoadFromAsset(PAsset asset, PMaterial material
 
     const std::unordered_map<std::string, std::shared_ptr<Material>> importedMaterials = loadObjMaterials();
 
-    /// @brief Represents Part Build State data.
-    struct PartBuildState {
-        ModelPartFactory factory;
-        std::map<std::tuple<int, int, int>, int> vertexMap;
-        bool initialized = false;
-        size_t faceCount = 0;
-    };
-
-    std::map<std::string, PartBuildState> partStates;
-
-    auto resolvePartMaterial = [&](const std::string& rawMaterialName) -> std::pair<std::string, std::shared_ptr<Material>> {
-        const std::string materialName = trimCopy(rawMaterialName);
-        if(materialName.empty()){
-            return {"__default__", fallbackMaterial};
-        }
+    std::vector<PartGeometry> geometry;
+    BuildParts(data, forceSmoothNormals, geometry);
 
-        const std::string lookupKey = toLowerCopy(materialName);
-        auto importedIt = importedMaterials.find(lookupKey);
-        if(importedIt != importedMaterials.end() && importedIt->second){
-            return {std::string("mat:") + lookupKey, importedIt->second};
-        }
-
-        // Keep unknown material slots separated so part-level splits still match usemtl groups.
-        return {std::string("missing:") + lookupKey, fallbackMaterial};
-    };
-
-    for(const auto& face : data.faces){
-        if(face.vertices.size() < 3){
+    // Order parts by resolved key, as the per-material factories were ordered before.
+    std::map<std::string, std::pair<const PartGeometry*, std::shared_ptr<Material>>> partsByKey;
+    for(const PartGeometry& part : geometry){
+        if(part.materialKey.empty()){
+            partsByKey["__default__"] = {&part, fallbackMaterial};
             continue;
         }
-
-        auto materialInfo = resolvePartMaterial(face.materialName);
-        auto& partState = partStates[materialInfo.first];
-        if(!partState.initialized){
-            partState.factory = ModelPartFactory::Create(materialInfo.second);
-            partState.initialized = true;
-        }
-
-        std::vector<int> faceIndices;
-        faceIndices.reserve(face.vertices.size());
-        for(const auto& vidx : face.vertices){
-            if(vidx.posIdx < 0 || vidx.posIdx >= static_cast<int>(data.positions.size())){
-                continue;
-            }
-
-            const auto key = std::make_tuple(vidx.posIdx, vidx.texIdx, vidx.normIdx);
-            auto existing = partState.vertexMap.find(key);
-            if(existing == partState.vertexMap.end()){
-                Vertex vtx = Vertex::Build();
-                vtx.Position = data.positions[vidx.posIdx];
-
-                if(forceSmoothNormals && vidx.posIdx >= 0 && vidx.posIdx < static_cast<int>(smoothNormals.size())){
-                    vtx.Normal = smoothNormals[vidx.posIdx];
-                }else if(vidx.normIdx >= 0 && vidx.normIdx < static_cast<int>(data.normals.size())){
-                    vtx.Normal = data.normals[vidx.normIdx];
-                }else{
-                    vtx.Normal = Math3D::Vec3(0.0f, 1.0f, 0.0f);
-                }
-
-                if(vidx.texIdx >= 0 && vidx.texIdx < static_cast<int>(data.texCoords.size())){
-                    vtx.TexCoords = data.texCoords[vidx.texIdx];
-                }else{
-                    vtx.TexCoords = Math3D::Vec2(0.0f, 0.0f);
-                }
-
-                vtx.Color = Math3D::Vec4(1.0f, 1.0f, 1.0f, 1.0f);
-
-                int index = -1;
-                partState.factory.addVertex(vtx, &index);
-                partState.vertexMap[key] = index;
-                faceIndices.push_back(index);
-            }else{
-                faceIndices.push_back(existing->second);
-            }
-        }
-
-        if(faceIndices.size() < 3){
-            continue;
-        }
-
-        if(faceIndices.size() == 3){
-            partState.factory.defineFace(faceIndices[0], faceIndices[1], faceIndices[2]);
-        }else if(faceIndices.size() == 4){
-            partState.factory.defineFace(faceIndices[0], faceIndices[1], faceIndices[2], faceIndices[3]);
+        auto importedIt = importedMaterials.find(part.materialKey);
+        if(importedIt != importedMaterials.end() && importedIt->second){
+            partsByKey[std::string("mat:") + part.materialKey] = {&part, importedIt->second};
         }else{
-            for(size_t i = 1; i + 1 < faceIndices.size(); ++i){
-                partState.factory.defineFace(faceIndices[0], faceIndices[i], faceIndices[i + 1]);
-            }
+            // Keep unknown material slots separated so part-level splits still match usemtl groups.
+            partsByKey[std::string("missing:") + part.materialKey] = {&part, fallbackMaterial};
         }
-
-        partState.faceCount++;
     }
 
     auto model = Model::Create();
     size_t totalVertexCount = 0;
-    for(auto& kv : partStates){
-        PartBuildState& state = kv.second;
-        if(!state.initialized || state.faceCount == 0){
-            continue;
+    for(const auto& kv : partsByKey){
+        const PartGeometry& part = *kv.second.first;
+        ModelPartFactory factory = ModelPartFactory::Create(kv.second.second);
+        for(const Vertex& vtx : part.vertices){
+            factory.addVertex(vtx);
+        }
+        for(size_t i = 0; i + 2 < part.indices.size(); i += 3){
+            factory.defineFace(static_cast<int>(part.indices[i]),
+                               static_cast<int>(part.indices[i + 1]),
+                               static_cast<int>(part.indices[i + 2]));
         }
 
-        totalVertexCount += state.vertexMap.size();
-        auto part = state.factory.assemble();
-        if(part){
-            model->addPart(part);
+        totalVertexCount += part.vertices.size();
+        auto assembled = factory.assemble();
+        if(assembled){
+            model->addPart(assembled);
         }
     }
 
@@ -6,9 +6,11 @@
 #ifndef OBJ_LOADER_H
 #define OBJ_LOADER_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "Assets/Core/Asset.h"
 #include "Rendering/Geometry/Model.h"
@@ -18,6 +20,15 @@
 
 /// @brief Represents the OBJLoader type.
 class OBJLoader {
+public:
+    /// @brief Holds data for PartGeometry: one `usemtl` group's deduplicated vertices and triangle list.
+    struct PartGeometry {
+        /// Trimmed, lower-cased `usemtl` name; empty for faces before any `usemtl`.
+        std::string materialKey;
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+    };
+
 private:
     /// @brief Holds data for VertexIndex.
     struct VertexIndex {
@@ -26,33 +37,47 @@ private:
         int normIdx = -1;
     };
 
-    /// @brief Holds data for FaceDefinition.
+    /// @brief Holds data for FaceDefinition. Corners are `OBJData::faceVertices[firstVertex, firstVertex + vertexCount)`.
     struct FaceDefinition {
-        std::vector<VertexIndex> vertices;
-        std::string materialName;
+        std::uint32_t firstVertex = 0;
+        std::uint32_t vertexCount = 0;
+        std::uint32_t materialIndex = 0;
     };
 
-    /// @brief Holds data for OBJData.
+    /// @brief Holds data for OBJData. `materialNames[0]` is the empty name used before any `usemtl`.
     struct OBJData {
         std::vector<Math3D::Vec3> positions;
         std::vector<Math3D::Vec3> normals;
         std::vector<Math3D::Vec2> texCoords;
+        std::vector<VertexIndex> faceVertices;
         std::vector<FaceDefinition> faces;
+        std::vector<std::string> materialNames;
         std::vector<std::string> materialLibs;
     };
 
     /**
      * @brief Parses OBJ file data.
+     *
+     * Large inputs are split into line-aligned chunks parsed in parallel on the WorkerPool.
+     * A counting pass first finds each chunk's vertex offsets and inherited `usemtl` so
+     * relative indices and material groups resolve exactly as in a serial read.
      * @param content Value for content.
      * @return Result of this operation.
      */
-    static OBJData ParseOBJData(const std::string& content);
+    static OBJData ParseOBJData(std::string_view content);
     /**
      * @brief Builds smooth normals.
      * @param data Value for data.
      * @return Result of this operation.
      */
     static std::vector<Math3D::Vec3> BuildSmoothNormals(const OBJData& data);
+    /**
+     * @brief Deduplicates face corners into per-material vertex and index arrays.
+     * @param data Parsed OBJ data.
+     * @param forceSmoothNormals Replace file normals with BuildSmoothNormals() output.
+     * @param outParts Receives parts sorted by material key (replaced).
+     */
+    static void BuildParts(const OBJData& data, bool forceSmoothNormals, std::vector<PartGeometry>& outParts);
     
 public:
     /**
@@ -60,6 +85,22 @@ public:
      */
     OBJLoader() = delete;
 
+    /**
+     * @brief Parses OBJ text and builds the vertex and index data of every part, without GL.
+     *
+     * Parts are sorted by material key. Quads are split the way ModelPartFactory::defineFace()
+     * splits them, so uploading these arrays gives the meshes LoadFromAsset() builds.
+     * @param content OBJ file text.
+     * @param forceSmoothNormals Replace file normals with area-weighted per-position normals.
+     * @param outParts Receives the parts (replaced).
+     * @param outError Output value for error.
+     * @return True when the operation succeeds; otherwise false.
+     */
+    static bool BuildGeometry(std::string_view content,
+                              bool forceSmoothNormals,
+                              std::vector<PartGeometry>& outParts,
+                              std::string* outError = nullptr);
+
     // Load OBJ from an asset
     static std::shared_ptr<Model> LoadFromAsset(
         PAsset asset,
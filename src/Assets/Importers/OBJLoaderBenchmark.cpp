@@ -0,0 +1,422 @@
+/**
+ * @file src/Assets/Importers/OBJLoaderBenchmark.cpp
+ * @brief Implementation for OBJLoaderBenchmark.
+ */
+
+#include "Assets/Importers/OBJLoaderBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Assets/Importers/OBJLoader.h"
+#include "Foundation/IO/File.h"
+#include "Foundation/Logging/Logbot.h"
+#include "Foundation/Threading/WorkerPool.h"
+#include "Foundation/Util/StringUtils.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+    using PartGeometry = OBJLoader::PartGeometry;
+
+    double elapsedMs(const BenchClock::time_point& start){
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    // The loader as it was before chunked parsing, minus material and GL work. Parsing is
+    // unchanged; parts are keyed by material name and written into PartGeometry instead of
+    // a ModelPartFactory.
+    namespace legacy {
+        /// @brief Holds data for VertexIndex.
+        struct VertexIndex {
+            int posIdx = -1;
+            int texIdx = -1;
+            int normIdx = -1;
+        };
+
+        /// @brief Holds data for FaceDefinition.
+        struct FaceDefinition {
+            std::vector<VertexIndex> vertices;
+            std::string materialName;
+        };
+
+        /// @brief Holds data for OBJData.
+        struct OBJData {
+            std::vector<Math3D::Vec3> positions;
+            std::vector<Math3D::Vec3> normals;
+            std::vector<Math3D::Vec2> texCoords;
+            std::vector<FaceDefinition> faces;
+        };
+
+        int parseObjIndex(const std::string& token, int count){
+            if(token.empty()){
+                return -1;
+            }
+            int raw = 0;
+            try{
+                raw = std::stoi(token);
+            }catch(...){
+                return -1;
+            }
+
+            if(raw > 0){
+                return raw - 1;
+            }
+            if(raw < 0){
+                return count + raw;
+            }
+            return -1;
+        }
+
+        OBJData parseOBJData(const std::string& content){
+            OBJData data;
+            std::istringstream stream(content);
+            std::string line;
+            std::string currentMaterialName;
+
+            while(std::getline(stream, line)){
+                std::string trimmed = StringUtils::Trim(line);
+                if(trimmed.empty() || trimmed[0] == '#'){
+                    continue;
+                }
+
+                std::istringstream iss(trimmed);
+                std::string prefix;
+                iss >> prefix;
+
+                if(prefix == "v"){
+                    float x = 0.0f;
+                    float y = 0.0f;
+                    float z = 0.0f;
+                    iss >> x >> y >> z;
+                    data.positions.push_back(Math3D::Vec3(x, y, z));
+                }else if(prefix == "vn"){
+                    float x = 0.0f;
+                    float y = 0.0f;
+                    float z = 0.0f;
+                    iss >> x >> y >> z;
+                    data.normals.push_back(Math3D::Vec3(x, y, z));
+                }else if(prefix == "vt"){
+                    float u = 0.0f;
+                    float v = 0.0f;
+                    iss >> u >> v;
+                    data.texCoords.push_back(Math3D::Vec2(u, v));
+                }else if(prefix == "usemtl"){
+                    std::string materialName;
+                    std::getline(iss, materialName);
+                    currentMaterialName = StringUtils::Trim(materialName);
+                }else if(prefix == "f"){
+                    FaceDefinition face;
+                    face.materialName = currentMaterialName;
+
+                    std::string vertexToken;
+                    while(iss >> vertexToken){
+                        std::vector<std::string> parts = StringUtils::Split(vertexToken, "/");
+
+                        VertexIndex idx;
+                        if(!parts.empty() && !parts[0].empty()){
+                            idx.posIdx = parseObjIndex(parts[0], static_cast<int>(data.positions.size()));
+                        }
+                        if(parts.size() > 1 && !parts[1].empty()){
+                            idx.texIdx = parseObjIndex(parts[1], static_cast<int>(data.texCoords.size()));
+                        }
+                        if(parts.size() > 2 && !parts[2].empty()){
+                            idx.normIdx = parseObjIndex(parts[2], static_cast<int>(data.normals.size()));
+                        }
+
+                        if(idx.posIdx >= 0 && idx.posIdx < static_cast<int>(data.positions.size())){
+                            face.vertices.push_back(idx);
+                        }
+                    }
+
+                    if(face.vertices.size() >= 3){
+                        data.faces.push_back(std::move(face));
+                    }
+                }
+            }
+
+            return data;
+        }
+
+        std::vector<Math3D::Vec3> buildSmoothNormals(const OBJData& data){
+            std::vector<Math3D::Vec3> smoothNormals(data.positions.size(), Math3D::Vec3(0.0f, 0.0f, 0.0f));
+            if(data.positions.empty()){
+                return smoothNormals;
+            }
+
+            auto accumulateTriangleNormal = [&](int i0, int i1, int i2){
+                if(i0 < 0 || i1 < 0 || i2 < 0){
+                    return;
+                }
+                if(i0 >= static_cast<int>(data.positions.size()) ||
+                   i1 >= static_cast<int>(data.positions.size()) ||
+                   i2 >= static_cast<int>(data.positions.size())){
+                    return;
+                }
+
+                const glm::vec3 p0 = static_cast<glm::vec3>(data.positions[i0]);
+                const glm::vec3 p1 = static_cast<glm::vec3>(data.positions[i1]);
+                const glm::vec3 p2 = static_cast<glm::vec3>(data.positions[i2]);
+                const glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);
+                if(glm::dot(faceNormal, faceNormal) <= 1e-12f){
+                    return;
+                }
+
+                const Math3D::Vec3 n(faceNormal);
+                smoothNormals[i0] += n;
+                smoothNormals[i1] += n;
+                smoothNormals[i2] += n;
+            };
+
+            for(const auto& face : data.faces){
+                if(face.vertices.size() < 3){
+                    continue;
+                }
+
+                const int base = face.vertices[0].posIdx;
+                for(size_t i = 1; i + 1 < face.vertices.size(); ++i){
+                    accumulateTriangleNormal(base, face.vertices[i].posIdx, face.vertices[i + 1].posIdx);
+                }
+            }
+
+            for(auto& n : smoothNormals){
+                if(n.length() > 1e-6f){
+                    n = n.normalize();
+                }else{
+                    n = Math3D::Vec3(0.0f, 1.0f, 0.0f);
+                }
+            }
+
+            return smoothNormals;
+        }
+
+        std::vector<PartGeometry> buildParts(const std::string& content, bool forceSmoothNormals){
+            OBJData data = parseOBJData(content);
+
+            std::vector<Math3D::Vec3> smoothNormals;
+            if(forceSmoothNormals){
+                smoothNormals = buildSmoothNormals(data);
+            }
+
+            /// @brief Represents Part Build State data.
+            struct PartBuildState {
+                PartGeometry geometry;
+                std::map<std::tuple<int, int, int>, int> vertexMap;
+            };
+
+            std::map<std::string, PartBuildState> partStates;
+
+            for(const auto& face : data.faces){
+                if(face.vertices.size() < 3){
+                    continue;
+                }
+
+                const std::string materialKey = StringUtils::ToLowerCase(StringUtils::Trim(face.materialName));
+                auto& partState = partStates[materialKey];
+                partState.geometry.materialKey = materialKey;
+
+                std::vector<int> faceIndices;
+                faceIndices.reserve(face.vertices.size());
+                for(const auto& vidx : face.vertices){
+                    if(vidx.posIdx < 0 || vidx.posIdx >= static_cast<int>(data.positions.size())){
+                        continue;
+                    }
+
+                    const auto key = std::make_tuple(vidx.posIdx, vidx.texIdx, vidx.normIdx);
+                    auto existing = partState.vertexMap.find(key);
+                    if(existing == partState.vertexMap.end()){
+                        Vertex vtx = Vertex::Build();
+                        vtx.Position = data.positions[vidx.posIdx];
+
+                        if(forceSmoothNormals && vidx.posIdx >= 0 && vidx.posIdx < static_cast<int>(smoothNormals.size())){
+                            vtx.Normal = smoothNormals[vidx.posIdx];
+                        }else if(vidx.normIdx >= 0 && vidx.normIdx < static_cast<int>(data.normals.size())){
+                            vtx.Normal = data.normals[vidx.normIdx];
+                        }else{
+                            vtx.Normal = Math3D::Vec3(0.0f, 1.0f, 0.0f);
+                        }
+
+                        if(vidx.texIdx >= 0 && vidx.texIdx < static_cast<int>(data.texCoords.size())){
+                            vtx.TexCoords = data.texCoords[vidx.texIdx];
+                        }else{
+                            vtx.TexCoords = Math3D::Vec2(0.0f, 0.0f);
+                        }
+
+                        vtx.Color = Math3D::Vec4(1.0f, 1.0f, 1.0f, 1.0f);
+
+                        const int index = static_cast<int>(partState.geometry.vertices.size());
+                        partState.geometry.vertices.push_back(vtx);
+                        partState.vertexMap[key] = index;
+                        faceIndices.push_back(index);
+                    }else{
+                        faceIndices.push_back(existing->second);
+                    }
+                }
+
+                if(faceIndices.size() < 3){
+                    continue;
+                }
+
+                // ModelPartFactory::defineFace() triangulation.
+                std::vector<std::uint32_t>& indices = partState.geometry.indices;
+                auto triangle = [&](int a, int b, int c){
+                    indices.push_back(static_cast<std::uint32_t>(a));
+                    indices.push_back(static_cast<std::uint32_t>(b));
+                    indices.push_back(static_cast<std::uint32_t>(c));
+                };
+                if(faceIndices.size() == 3){
+                    triangle(faceIndices[0], faceIndices[1], faceIndices[2]);
+                }else if(faceIndices.size() == 4){
+                    triangle(faceIndices[0], faceIndices[1], faceIndices[2]);
+                    triangle(faceIndices[2], faceIndices[3], faceIndices[0]);
+                }else{
+                    for(size_t i = 1; i + 1 < faceIndices.size(); ++i){
+                        triangle(faceIndices[0], faceIndices[i], faceIndices[i + 1]);
+                    }
+                }
+            }
+
+            std::vector<PartGeometry> parts;
+            for(auto& kv : partStates){
+                if(!kv.second.geometry.indices.empty()){
+                    parts.push_back(std::move(kv.second.geometry));
+                }
+            }
+            return parts;
+        }
+    }
+
+    bool sameFloats(const float* a, const float* b, int count){
+        for(int i = 0; i < count; ++i){
+            if(a[i] != b[i]){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool sameVertex(const Vertex& a, const Vertex& b){
+        return sameFloats(&a.Position.x, &b.Position.x, 3) &&
+               sameFloats(&a.Normal.x, &b.Normal.x, 3) &&
+               sameFloats(&a.TexCoords.x, &b.TexCoords.x, 2) &&
+               sameFloats(&a.Color.x, &b.Color.x, 4);
+    }
+
+    // Logs the first difference; returns true when both part lists are identical.
+    bool compareParts(const std::vector<PartGeometry>& expected, const std::vector<PartGeometry>& actual, const char* mode){
+        if(expected.size() != actual.size()){
+            LogBot.Log(LOG_ERRO, "OBJ benchmark (%s): %llu parts from the old loader, %llu from the new one.",
+                       mode,
+                       static_cast<unsigned long long>(expected.size()),
+                       static_cast<unsigned long long>(actual.size()));
+            return false;
+        }
+        for(size_t p = 0; p < expected.size(); ++p){
+            const PartGeometry& a = expected[p];
+            const PartGeometry& b = actual[p];
+            if(a.materialKey != b.materialKey ||
+               a.vertices.size() != b.vertices.size() ||
+               a.indices != b.indices){
+                LogBot.Log(LOG_ERRO, "OBJ benchmark (%s): part '%s' differs (%llu/%llu vertices, %llu/%llu indices).",
+                           mode,
+                           a.materialKey.c_str(),
+                           static_cast<unsigned long long>(a.vertices.size()),
+                           static_cast<unsigned long long>(b.vertices.size()),
+                           static_cast<unsigned long long>(a.indices.size()),
+                           static_cast<unsigned long long>(b.indices.size()));
+                return false;
+            }
+            for(size_t v = 0; v < a.vertices.size(); ++v){
+                if(!sameVertex(a.vertices[v], b.vertices[v])){
+                    LogBot.Log(LOG_ERRO, "OBJ benchmark (%s): part '%s' vertex %llu differs.",
+                               mode,
+                               a.materialKey.c_str(),
+                               static_cast<unsigned long long>(v));
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    double timeNewLoader(std::string_view content, int iterations, std::vector<PartGeometry>& outParts){
+        double best = std::numeric_limits<double>::max();
+        for(int i = 0; i < iterations; ++i){
+            const BenchClock::time_point start = BenchClock::now();
+            OBJLoader::BuildGeometry(content, false, outParts);
+            best = std::min(best, elapsedMs(start));
+        }
+        return best;
+    }
+}
+
+OBJLoaderBenchmark::Result OBJLoaderBenchmark::Run(const std::filesystem::path& objPath, int iterations){
+    Result result;
+    iterations = std::max(iterations, 1);
+
+    FileBlob blob;
+    try{
+        File file(objPath.string());
+        blob = FileReader::Read(&file);
+    }catch(const std::exception& e){
+        result.error = std::string("Failed to read OBJ: ") + e.what();
+        LogBot.Log(LOG_ERRO, "OBJ benchmark: %s [%s]", result.error.c_str(), objPath.generic_string().c_str());
+        return result;
+    }
+    const std::string_view content = blob.view().asStringView();
+    result.fileBytes = content.size();
+
+    std::vector<PartGeometry> newParts;
+    if(!OBJLoader::BuildGeometry(content, false, newParts, &result.error)){
+        LogBot.Log(LOG_ERRO, "OBJ benchmark: %s [%s]", result.error.c_str(), objPath.generic_string().c_str());
+        return result;
+    }
+    result.valid = true;
+
+    // The old loader received the asset as a std::string copy, so that copy is part of its time.
+    std::vector<PartGeometry> legacyParts;
+    result.legacyMs = std::numeric_limits<double>::max();
+    for(int i = 0; i < iterations; ++i){
+        const BenchClock::time_point start = BenchClock::now();
+        const std::string text(content);
+        legacyParts = legacy::buildParts(text, false);
+        result.legacyMs = std::min(result.legacyMs, elapsedMs(start));
+    }
+
+    WorkerPool& pool = WorkerPool::Instance();
+    pool.stop();
+    result.serialMs = timeNewLoader(content, iterations, newParts);
+    pool.start();
+    result.parallelMs = timeNewLoader(content, iterations, newParts);
+
+    result.matched = compareParts(legacyParts, newParts, "file normals");
+    std::vector<PartGeometry> smoothNew;
+    OBJLoader::BuildGeometry(content, true, smoothNew);
+    pool.stop();
+    result.matched = compareParts(legacy::buildParts(std::string(content), true), smoothNew, "smooth normals") && result.matched;
+
+    result.partCount = newParts.size();
+    for(const PartGeometry& part : newParts){
+        result.vertexCount += part.vertices.size();
+        result.indexCount += part.indices.size();
+    }
+
+    LogBot.Log(result.matched ? LOG_INFO : LOG_ERRO,
+               "OBJ benchmark: %s (%.2f MiB, %llu parts, %llu vertices, %llu indices) | old %.2f ms | new %.2f ms serial, %.2f ms parallel | output %s",
+               objPath.filename().string().c_str(),
+               static_cast<double>(result.fileBytes) / (1024.0 * 1024.0),
+               static_cast<unsigned long long>(result.partCount),
+               static_cast<unsigned long long>(result.vertexCount),
+               static_cast<unsigned long long>(result.indexCount),
+               result.legacyMs,
+               result.serialMs,
+               result.parallelMs,
+               result.matched ? "identical" : "DIFFERS");
+    return result;
+}
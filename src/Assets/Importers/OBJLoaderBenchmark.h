@@ -0,0 +1,44 @@
+/**
+ * @file src/Assets/Importers/OBJLoaderBenchmark.h
+ * @brief Declarations for OBJLoaderBenchmark.
+ */
+
+#ifndef OBJ_LOADER_BENCHMARK_H
+#define OBJ_LOADER_BENCHMARK_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+/// @brief Compares the chunked OBJ parser against the istringstream parser it replaced.
+namespace OBJLoaderBenchmark {
+    /// @brief Holds data for Result.
+    struct Result {
+        bool valid = false;
+        /// True when both loaders built identical parts, vertices and indices, with and without smooth normals.
+        bool matched = false;
+        size_t fileBytes = 0;
+        size_t partCount = 0;
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        /// Best time from file text to per-part vertex and index arrays.
+        double legacyMs = 0.0;
+        double serialMs = 0.0;
+        double parallelMs = 0.0;
+        std::string error;
+    };
+
+    /**
+     * @brief Times the old and new OBJ loaders on one file and compares their output. GL-free.
+     *
+     * The old loader is the baseline ParseOBJData and part build: one istringstream per line,
+     * std::stoi indices and a std::map vertex cache. The new one is OBJLoader::BuildGeometry(),
+     * timed with WorkerPool::Instance() stopped and then started; the pool is left stopped.
+     * @param objPath OBJ file to load.
+     * @param iterations Loads per variant; the fastest one is reported.
+     * @return Measured values, or `valid == false` with `error` set.
+     */
+    Result Run(const std::filesystem::path& objPath, int iterations = 5);
+}
+
+#endif // OBJ_LOADER_BENCHMARK_H
@@ -9,6 +9,7 @@
 #include "Rendering/Core/Graphics2D.h"
 #include "Scene/Scene.h"
 #include "Engine/Core/GameEngine.h"
+#include "Assets/Core/Asset.h"
 #include <cstdio>
 #include <algorithm>
 
@@ -36,6 +37,7 @@ public:
     char ecsLine[256] = {};
     char engineLine[256] = {};
     char renderBreakdownLine[256] = {};
+    char assetLine[256] = {};
     float graphSampleAccumTime = 0.0f;
     float graphSampleAccumDt = 0.0f;
     int graphSampleAccumFrames = 0;
@@ -73,6 +75,19 @@ public:
 
     EngineInfo engineInfo{};
 
+    /// @brief Holds data for AssetInfo.
+    struct AssetInfo {
+        float residentMb = 0.0f;
+        float budgetMb = 0.0f;
+        unsigned long long residentCount = 0;
+        unsigned long long hits = 0;
+        unsigned long long misses = 0;
+        unsigned long long evictions = 0;
+        bool hasData = false;
+    };
+
+    AssetInfo assetInfo{};
+
     /**
      * @brief Constructs a new FrameTimeGraph instance.
      */
@@ -149,6 +164,8 @@ public:
             engineInfo.hasData = false;
         }
 
+        setAssetInfo(AssetManager::Instance.getCacheStats());
+
         overlayRefreshAccum = 0.0f;
     }
 
@@ -205,6 +222,17 @@ public:
         ecsInfo.hasData = true;
     }
 
+    void setAssetInfo(const AssetManager::CacheStats& cacheStats){
+        constexpr float bytesPerMb = 1024.0f * 1024.0f;
+        assetInfo.residentMb = (float)cacheStats.residentBytes / bytesPerMb;
+        assetInfo.budgetMb = (float)cacheStats.budgetBytes / bytesPerMb;
+        assetInfo.residentCount = cacheStats.residentCount;
+        assetInfo.hits = cacheStats.hits;
+        assetInfo.misses = cacheStats.misses;
+        assetInfo.evictions = cacheStats.evictions;
+        assetInfo.hasData = true;
+    }
+
     void setEngineInfo(float updateMs,
                        float updateWaitMs,
                        float renderMs,
@@ -334,6 +362,20 @@ public:
                 renderBreakdownLine[0] = '\0';
             }
 
+            if(assetInfo.hasData){
+                std::snprintf(assetLine, sizeof(assetLine),
+                    "[Assets] Resident: %.1f / %.0f MB (%llu) | Hits: %llu | Misses: %llu | Evicted: %llu",
+                    assetInfo.residentMb,
+                    assetInfo.budgetMb,
+                    assetInfo.residentCount,
+                    assetInfo.hits,
+                    assetInfo.misses,
+                    assetInfo.evictions
+                );
+            }else{
+                assetLine[0] = '\0';
+            }
+
             lastTextRefreshTime = globalTime;
         }
 
@@ -350,6 +392,12 @@ public:
             Graphics2D::DrawString(g, engineLine, x, y - 50, true);
             Graphics2D::DrawString(g, renderBreakdownLine, x, y - 68, true);
         }
+
+        if(assetInfo.hasData){
+            const float assetLineY = engineInfo.hasData ? (y - 86) : (ecsInfo.hasData ? (y - 50) : (y - 32));
+            Graphics2D::SetBackgroundColor(g, Color::WHITE);
+            Graphics2D::DrawString(g, assetLine, x, assetLineY, true);
+        }
     }
 };
 
@@ -1946,20 +1946,20 @@ void TransformComponent::drawPropertyWidget(NeoECS::NeoECS* ecsPtr, PScene scene
 
     auto transform = this;
 
-    Math3D::Vec3 pos = transform->local.position;
-    Math3D::Vec3 rot = transform->local.rotation.ToEuler();
-    Math3D::Vec3 scale = transform->local.scale;
+    Math3D::Vec3 pos = transform->getLocal().position;
+    Math3D::Vec3 rot = transform->getLocal().rotation.ToEuler();
+    Math3D::Vec3 scale = transform->getLocal().scale;
 
     if(EditorPropertyUI::DragFloat3("Position", &pos.x, 0.1f)){
-        transform->local.position = pos;
+        transform->editLocal().position = pos;
     }
 
     if(EditorPropertyUI::DragFloat3("Rotation", &rot.x, 0.5f)){
-        transform->local.setRotation(rot);
+        transform->editLocal().setRotation(rot);
     }
 
     if(EditorPropertyUI::DragFloat3("Scale", &scale.x, 0.1f)){
-        transform->local.scale = scale;
+        transform->editLocal().scale = scale;
     }
 }
 
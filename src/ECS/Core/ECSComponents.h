@@ -133,7 +133,50 @@ struct EntityPropertiesComponent : public IEditorCompatibleComponent {
 /// @brief Holds data for TransformComponent.
 struct TransformComponent : public IEditorCompatibleComponent {
     using IEditorCompatibleComponent::IEditorCompatibleComponent;
-    Math3D::Transform local;
+
+    /// @brief Cached world-matrix state maintained by TransformHierarchy.
+    struct WorldCache {
+        Math3D::Mat4 world;
+        std::uint64_t revision = 0;      // Unique id of the cached world matrix value.
+        std::uint64_t parentRevision = 0; // Revision of the parent world this was built against (0 = identity).
+        bool dirty = true;               // Local transform changed since `world` was built.
+    };
+    mutable WorldCache worldCache;
+
+    /**
+     * @brief Returns the local transform.
+     * @return Local transform relative to the parent entity.
+     */
+    const Math3D::Transform& getLocal() const { return local; }
+
+    /**
+     * @brief Replaces the local transform and marks this subtree's world matrices dirty.
+     * @param value New local transform.
+     */
+    void setLocal(const Math3D::Transform& value){
+        local = value;
+        markWorldDirty();
+    }
+
+    /**
+     * @brief Returns the local transform for in-place edits and marks this subtree dirty.
+     *
+     * Use for immediate edits only; holding the reference across frames bypasses dirty tracking.
+     * @return Mutable local transform.
+     */
+    Math3D::Transform& editLocal(){
+        markWorldDirty();
+        return local;
+    }
+
+    /**
+     * @brief Forces the cached world matrix of this transform and its subtree to be rebuilt.
+     *
+     * Children are refreshed through their parent revision, so only this node is flagged.
+     */
+    void markWorldDirty(){
+        worldCache.dirty = true;
+    }
 
     /**
      * @brief Transform components are always shown in editor panels.
@@ -147,6 +190,9 @@ struct TransformComponent : public IEditorCompatibleComponent {
      * @param scenePtr Scene context used by editor widgets.
      */
     void drawPropertyWidget(NeoECS::NeoECS* ecsPtr = nullptr, PScene scenePtr = nullptr) override;
+
+    private:
+        Math3D::Transform local;
 };
 
 /// @brief Holds data for MeshRendererComponent.
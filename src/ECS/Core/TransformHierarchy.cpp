@@ -0,0 +1,113 @@
+/**
+ * @file src/ECS/Core/TransformHierarchy.cpp
+ * @brief Implementation for TransformHierarchy.
+ */
+
+#include "ECS/Core/TransformHierarchy.h"
+
+#include "ECS/Core/ECSComponents.h"
+
+#include <atomic>
+
+namespace {
+    // Revision 0 is reserved for "identity parent", so real world matrices start at 1.
+    std::atomic<std::uint64_t> gWorldRevisionCounter{0};
+
+    const Math3D::Mat4 kIdentity(1.0f);
+
+    // Returns true when the cached matrix had to be rebuilt.
+    bool refreshWorldCache(const TransformComponent& transform,
+                           const Math3D::Mat4& parentWorld,
+                           std::uint64_t parentRevision){
+        auto& cache = transform.worldCache;
+        if(!cache.dirty && cache.revision != 0 && cache.parentRevision == parentRevision){
+            return false;
+        }
+
+        cache.world = parentWorld * transform.getLocal().toMat4();
+        cache.parentRevision = parentRevision;
+        cache.revision = gWorldRevisionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+        cache.dirty = false;
+        return true;
+    }
+
+    std::uint64_t resolveWorldRecursive(NeoECS::ECSEntity* entity,
+                                        NeoECS::ECSComponentManager* manager,
+                                        Math3D::Mat4& outWorld){
+        Math3D::Mat4 parentWorld(1.0f);
+        std::uint64_t parentRevision = 0;
+        if(auto* parent = entity->getParent()){
+            parentRevision = resolveWorldRecursive(parent, manager, parentWorld);
+        }
+
+        auto* transform = manager->getECSComponent<TransformComponent>(entity);
+        if(!transform){
+            // Transform-less entities pass their parent's world through unchanged.
+            outWorld = parentWorld;
+            return parentRevision;
+        }
+
+        refreshWorldCache(*transform, parentWorld, parentRevision);
+        outWorld = transform->worldCache.world;
+        return transform->worldCache.revision;
+    }
+}
+
+Math3D::Mat4 TransformHierarchy::ResolveWorldMatrix(NeoECS::ECSEntity* entity, NeoECS::ECSComponentManager* manager){
+    Math3D::Mat4 world(1.0f);
+    if(!entity || !manager){
+        return world;
+    }
+
+    // The parent chain is always walked: parent revisions catch local writes and reparenting on any
+    // ancestor without a change counter, and only stale nodes are multiplied.
+    resolveWorldRecursive(entity, manager, world);
+    return world;
+}
+
+void TransformHierarchy::update(NeoECS::ECSEntityManager* entityManager, NeoECS::ECSComponentManager* manager){
+    lastRecomputedCount = 0;
+    if(!entityManager || !manager){
+        return;
+    }
+
+    // Parent links can change without a local write, so the walk always runs; it only multiplies dirty nodes.
+    pending.clear();
+    const auto& entities = entityManager->getEntities();
+    for(const auto& entityPtr : entities){
+        auto* entity = entityPtr.get();
+        if(entity && entity->getParent() == nullptr){
+            PendingNode root;
+            root.entity = entity;
+            root.parentWorld = &kIdentity;
+            pending.push_back(root);
+        }
+    }
+
+    // Depth-first walk: a node is always processed before any of its children are pushed.
+    while(!pending.empty()){
+        PendingNode node = pending.back();
+        pending.pop_back();
+
+        const Math3D::Mat4* world = node.parentWorld;
+        std::uint64_t revision = node.parentRevision;
+        if(auto* transform = manager->getECSComponent<TransformComponent>(node.entity)){
+            if(refreshWorldCache(*transform, *node.parentWorld, node.parentRevision)){
+                ++lastRecomputedCount;
+            }
+            world = &transform->worldCache.world;
+            revision = transform->worldCache.revision;
+        }
+
+        for(const auto& childKv : node.entity->children()){
+            if(!childKv.second){
+                continue;
+            }
+            PendingNode child;
+            child.entity = childKv.second;
+            child.parentWorld = world;
+            child.parentRevision = revision;
+            pending.push_back(child);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * @file src/ECS/Core/TransformHierarchy.h
+ * @brief Cached world-transform resolution for ECS entity hierarchies.
+ */
+
+#ifndef TRANSFORM_HIERARCHY_H
+#define TRANSFORM_HIERARCHY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Foundation/Math/Math3D.h"
+#include "neoecs.hpp"
+
+/**
+ * @brief Maintains the world matrices cached on TransformComponent.
+ *
+ * Writes through TransformComponent::setLocal()/editLocal() flag the node dirty. The
+ * per-tick update() visits nodes parent-first and rebuilds a matrix only when the node
+ * is flagged or its parent produced a new world revision (which also covers reparenting),
+ * so clean subtrees cost a flag test per node instead of a matrix product per ancestor.
+ */
+class TransformHierarchy {
+    public:
+        /**
+         * @brief Returns the cached world matrix for an entity.
+         *
+         * Walks the entity's ancestors and rebuilds only the caches that are flagged dirty or
+         * were built against a different parent world, so writes and reparenting since the
+         * last update() are picked up without any notification.
+         * @param entity Entity to evaluate.
+         * @param manager ECS component manager.
+         * @return World transform matrix (identity when the entity is null).
+         */
+        static Math3D::Mat4 ResolveWorldMatrix(NeoECS::ECSEntity* entity, NeoECS::ECSComponentManager* manager);
+
+        /**
+         * @brief Rebuilds dirty world matrices in parent-before-child order.
+         *
+         * After this pass all caches are clean, so concurrent ResolveWorldMatrix()
+         * calls only read until the next ECS mutation.
+         * @param entityManager ECS entity manager.
+         * @param manager ECS component manager.
+         */
+        void update(NeoECS::ECSEntityManager* entityManager, NeoECS::ECSComponentManager* manager);
+
+        /**
+         * @brief Returns how many world matrices were recomputed by the last update().
+         * @return Recomputed matrix count.
+         */
+        size_t getLastRecomputedCount() const { return lastRecomputedCount; }
+
+    private:
+        /// @brief Holds data for PendingNode.
+        struct PendingNode {
+            NeoECS::ECSEntity* entity = nullptr;
+            const Math3D::Mat4* parentWorld = nullptr;
+            std::uint64_t parentRevision = 0;
+        };
+
+        std::vector<PendingNode> pending;
+        size_t lastRecomputedCount = 0;
+};
+
+#endif // TRANSFORM_HIERARCHY_H
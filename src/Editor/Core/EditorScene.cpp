@@ -32,6 +32,9 @@
 #include "Serialization/IO/PrefabIO.h"
 #include "Serialization/IO/SceneIO.h"
 #include "Serialization/Schema/ComponentSerializationRegistry.h"
+#include "Rendering/Core/GpuReadback.h"
+#include "Rendering/Shaders/ProgramBinaryCache.h"
+#include "Rendering/Shaders/ShaderProgram.h"
 #include "Rendering/Lighting/ShadowRenderer.h"
 #include <glad/glad.h>
 #include <SDL3/SDL.h>
@@ -52,6 +55,7 @@ namespace {
     constexpr float kIoStatusDurationSeconds = 6.0f;
     constexpr float kHelperCenterPickRadiusPx = 18.0f;
     constexpr size_t kMaxEditHistoryEntries = 64;
+    constexpr float kStartupSceneLoadBudgetMs = 8.0f;
     constexpr const char* kEditorSessionDocumentType = "editor_session";
     constexpr int kEditorSessionDocumentVersion = 1;
 
@@ -172,7 +176,7 @@ namespace {
         for(size_t i = 0; i < a.size(); ++i){
             if(a[i].type != b[i].type ||
                a[i].version != b[i].version ||
-               a[i].payloadJson != b[i].payloadJson){
+               !JsonSchema::EntitySnapshotSchemaBase::ComponentPayloadsEqual(a[i], b[i])){
                 return false;
             }
         }
@@ -469,65 +473,6 @@ namespace {
         return panelMax.y + kPanelGapY;
     }
 
-    bool applySceneSettingsRawJsonLocal(
-        PScene scene,
-        const JsonSchema::RawJsonValue& settings,
-        const std::unordered_map<std::uint64_t, NeoECS::ECSEntity*>& snapshotIdToEntity,
-        std::string* outError
-    ){
-        if(!scene || !scene->getECS() || !settings.hasValue || settings.json.empty()){
-            return true;
-        }
-
-        JsonUtils::Document doc;
-        if(!JsonUtils::LoadDocumentFromText(settings.json, doc, outError)){
-            if(outError && !outError->empty()){
-                *outError = "Failed to parse sceneSettings JSON: " + *outError;
-            }
-            return false;
-        }
-        JsonUtils::JsonVal* root = doc.root();
-        if(!root || !yyjson_is_obj(root)){
-            if(outError){
-                *outError = "sceneSettings must be a JSON object.";
-            }
-            return false;
-        }
-
-        bool outlineEnabled = scene->isOutlineEnabled();
-        JsonUtils::TryGetBool(root, "outlineEnabled", outlineEnabled);
-        scene->setOutlineEnabled(outlineEnabled);
-
-        std::uint64_t selectedSnapshotId = 0;
-        if(JsonUtils::TryGetUInt64(root, "selectedEntitySnapshotId", selectedSnapshotId)){
-            auto selectedIt = snapshotIdToEntity.find(selectedSnapshotId);
-            if(selectedIt != snapshotIdToEntity.end() && selectedIt->second){
-                scene->setSelectedEntityId(selectedIt->second->getNodeUniqueID());
-            }
-        }else{
-            std::string selectedEntityId;
-            if(JsonUtils::TryGetString(root, "selectedEntityId", selectedEntityId) && !selectedEntityId.empty()){
-                auto* selectedEntity = scene->getECS()->getEntityManager()->getSpecificEntity(selectedEntityId);
-                if(selectedEntity){
-                    scene->setSelectedEntityId(selectedEntityId);
-                }
-            }
-        }
-
-        std::uint64_t preferredCameraSnapshotId = 0;
-        if(JsonUtils::TryGetUInt64(root, "preferredCameraSnapshotId", preferredCameraSnapshotId)){
-            auto preferredIt = snapshotIdToEntity.find(preferredCameraSnapshotId);
-            if(preferredIt != snapshotIdToEntity.end() && preferredIt->second){
-                auto* cameraComp = scene->getECS()->getComponentManager()->getECSComponent<CameraComponent>(preferredIt->second);
-                if(cameraComp && IsComponentActive(cameraComp) && cameraComp->camera){
-                    scene->setPreferredCamera(cameraComp->camera, true);
-                }
-            }
-        }
-
-        return true;
-    }
-
     void ensurePreferredCameraAfterSceneLoad(PScene scene){
         if(!scene || scene->getPreferredCamera() || !scene->getECS()){
             return;
@@ -1145,7 +1090,6 @@ bool EditorScene::applyEntityReparent(std::uint64_t entityStableId,
         }
         return false;
     }
-
     stableEntityRuntimeIds[entityStableId] = entity->getNodeUniqueID();
     return true;
 }
@@ -1613,7 +1557,7 @@ void EditorScene::observeTransientEditorSessionState(){
         currentCameraTransform = editorCamera->transform();
         hasCameraTransform = true;
     }else if(editorCameraTransform){
-        currentCameraTransform = editorCameraTransform->local;
+        currentCameraTransform = editorCameraTransform->getLocal();
         hasCameraTransform = true;
     }
 
@@ -1754,7 +1698,7 @@ bool EditorScene::saveEditorSessionToDisk(std::string* outError){
     if(editorCamera){
         cameraTransform = editorCamera->transform();
     }else if(editorCameraTransform){
-        cameraTransform = editorCameraTransform->local;
+        cameraTransform = editorCameraTransform->getLocal();
     }
 
     JsonUtils::JsonMutVal* cameraTransformObj = yyjson_mut_obj_add_obj(doc.get(), refs.payload, "editorCameraTransform");
@@ -1890,7 +1834,7 @@ bool EditorScene::loadEditorSessionFromDisk(std::string* outError){
             editorCamera->setTransform(savedCameraTransform);
         }
         if(editorCameraTransform){
-            editorCameraTransform->local = savedCameraTransform;
+            editorCameraTransform->setLocal(savedCameraTransform);
         }
         editorYaw = savedEditorYaw;
         editorPitch = savedEditorPitch;
@@ -2249,7 +2193,7 @@ void EditorScene::applyActiveSceneState(){
             }
 
             if(targetCamera && editorCameraTransform){
-                editorCameraTransform->local = targetCamera->transform();
+                editorCameraTransform->setLocal(targetCamera->transform());
                 Math3D::Vec3 euler = targetCamera->transform().rotation.ToEuler();
                 editorPitch = euler.x;
                 editorYaw = euler.y;
@@ -2361,7 +2305,7 @@ void EditorScene::applyStartupSessionUiState(){
             editorCamera->setTransform(startupSessionCameraTransform);
         }
         if(editorCameraTransform){
-            editorCameraTransform->local = startupSessionCameraTransform;
+            editorCameraTransform->setLocal(startupSessionCameraTransform);
         }
         editorYaw = startupSessionEditorYaw;
         editorPitch = startupSessionEditorPitch;
@@ -2391,15 +2335,9 @@ void EditorScene::applyStartupSessionUiState(){
 }
 
 void EditorScene::clearStartupCachedSceneLoadState(){
-    startupLoadPhase = StartupLoadPhase::None;
+    startupSceneLoad.reset();
     startupLoadScene.reset();
     startupLoadScenePath.clear();
-    startupLoadSchema.Clear();
-    startupLoadRecordsById.clear();
-    startupLoadPendingRecords.clear();
-    startupLoadGameObjectsBySnapshotId.clear();
-    startupLoadEntitiesBySnapshotId.clear();
-    startupLoadDeserializeIndex = 0;
 }
 
 bool EditorScene::beginStartupCachedSceneLoad(const std::filesystem::path& scenePath, std::string* outError){
@@ -2445,150 +2383,32 @@ bool EditorScene::beginStartupCachedSceneLoad(const std::filesystem::path& scene
         }
     }
 
-    if(!startupLoadSchema.LoadFromAbsolutePath(normalizedPath, outError)){
+    // The scene is fresh, so there is nothing to clear; settings are applied when the load finalizes.
+    SceneIO::SceneLoadOptions loadOptions;
+    loadOptions.clearExistingScene = false;
+    loadOptions.applySceneSettings = true;
+    loadOptions.registry = &Serialization::DefaultComponentSerializationRegistry();
+    startupSceneLoad = std::make_unique<SceneIO::IncrementalSceneLoad>();
+    if(!startupSceneLoad->beginFromAbsolutePath(startupLoadScene, normalizedPath, loadOptions, outError)){
         clearStartupCachedSceneLoadState();
         return false;
     }
 
-    startupLoadRecordsById.reserve(startupLoadSchema.entities.size());
-    startupLoadPendingRecords.reserve(startupLoadSchema.entities.size());
-    for(const auto& record : startupLoadSchema.entities){
-        if(record.id == 0){
-            if(outError){
-                *outError = "Snapshot entity has invalid id (0).";
-            }
-            clearStartupCachedSceneLoadState();
-            return false;
-        }
-        if(startupLoadRecordsById.find(record.id) != startupLoadRecordsById.end()){
-            if(outError){
-                *outError = "Snapshot contains duplicate entity id: " + std::to_string(record.id);
-            }
-            clearStartupCachedSceneLoadState();
-            return false;
-        }
-        startupLoadRecordsById[record.id] = &record;
-        startupLoadPendingRecords.push_back(&record);
-    }
-
-    startupLoadGameObjectsBySnapshotId.reserve(startupLoadSchema.entities.size());
-    startupLoadEntitiesBySnapshotId.reserve(startupLoadSchema.entities.size());
     startupLoadScenePath = normalizedPath;
-    startupLoadDeserializeIndex = 0;
-    startupLoadPhase = StartupLoadPhase::CreateEntities;
     return true;
 }
 
 bool EditorScene::stepStartupCachedSceneLoad(std::string* outError){
-    if(startupLoadPhase == StartupLoadPhase::None || !startupLoadScene || !startupLoadScene->getECS()){
+    if(!startupSceneLoad || !startupSceneLoad->isActive() || !startupLoadScene || !startupLoadScene->getECS()){
         return false;
     }
 
-    if(startupLoadPhase == StartupLoadPhase::CreateEntities){
-        constexpr size_t kCreateBudgetPerUpdate = 64;
-        size_t createdThisUpdate = 0;
-        while(createdThisUpdate < kCreateBudgetPerUpdate && !startupLoadPendingRecords.empty()){
-            bool progressed = false;
-            for(size_t i = 0; i < startupLoadPendingRecords.size() && createdThisUpdate < kCreateBudgetPerUpdate;){
-                const auto* record = startupLoadPendingRecords[i];
-                NeoECS::GameObject* parentObject = nullptr;
-                if(record->hasParentId){
-                    auto parentCreated = startupLoadGameObjectsBySnapshotId.find(record->parentId);
-                    if(parentCreated == startupLoadGameObjectsBySnapshotId.end()){
-                        auto parentExists = startupLoadRecordsById.find(record->parentId);
-                        if(parentExists == startupLoadRecordsById.end()){
-                            if(outError){
-                                *outError = "Snapshot entity references missing parent id: " + std::to_string(record->parentId);
-                            }
-                            return false;
-                        }
-                        ++i;
-                        continue;
-                    }
-                    parentObject = parentCreated->second;
-                }
-
-                const std::string entityName = record->name.empty() ? std::string("GameObject") : record->name;
-                NeoECS::GameObject* createdObject = startupLoadScene->createECSGameObject(entityName, parentObject);
-                if(!createdObject || !createdObject->gameobject()){
-                    if(outError){
-                        *outError = "Failed to instantiate startup snapshot entity: " + entityName;
-                    }
-                    return false;
-                }
-
-                startupLoadGameObjectsBySnapshotId[record->id] = createdObject;
-                startupLoadEntitiesBySnapshotId[record->id] = createdObject->gameobject();
-                startupLoadPendingRecords.erase(startupLoadPendingRecords.begin() + static_cast<std::ptrdiff_t>(i));
-                ++createdThisUpdate;
-                progressed = true;
-            }
-
-            if(!progressed){
-                if(outError){
-                    *outError = "Failed to resolve parent dependencies while instantiating startup snapshot.";
-                }
-                return false;
-            }
-        }
-
-        if(startupLoadPendingRecords.empty()){
-            startupLoadPhase = StartupLoadPhase::DeserializeComponents;
-        }
-        return true;
-    }
-
-    if(startupLoadPhase == StartupLoadPhase::DeserializeComponents){
-        auto* manager = startupLoadScene->getECS()->getComponentManager();
-        auto* context = startupLoadScene->getECS()->getContext();
-        if(!manager || !context){
-            if(outError){
-                *outError = "Startup cached scene ECS is unavailable.";
-            }
-            return false;
-        }
-
-        constexpr size_t kDeserializeBudgetPerUpdate = 1;
-        size_t deserializedThisUpdate = 0;
-        const auto& registry = Serialization::DefaultComponentSerializationRegistry();
-        while(deserializedThisUpdate < kDeserializeBudgetPerUpdate &&
-              startupLoadDeserializeIndex < startupLoadSchema.entities.size()){
-            const auto& record = startupLoadSchema.entities[startupLoadDeserializeIndex];
-            auto entityIt = startupLoadEntitiesBySnapshotId.find(record.id);
-            if(entityIt == startupLoadEntitiesBySnapshotId.end() || !entityIt->second){
-                if(outError){
-                    *outError = "Missing runtime entity for startup snapshot id: " + std::to_string(record.id);
-                }
-                return false;
-            }
-
-            if(!registry.deserializeEntityComponents(
-                    context,
-                    manager,
-                    entityIt->second,
-                    record.components,
-                    outError)){
-                if(outError && !outError->empty()){
-                    *outError = "Entity '" + record.name + "' component restore failed: " + *outError;
-                }
-                return false;
-            }
-
-            ++startupLoadDeserializeIndex;
-            ++deserializedThisUpdate;
-        }
-
-        if(startupLoadDeserializeIndex >= startupLoadSchema.entities.size()){
-            startupLoadPhase = StartupLoadPhase::Finalize;
-        }
-        return true;
+    if(!startupSceneLoad->step(kStartupSceneLoadBudgetMs, outError)){
+        return false;
     }
 
-    if(startupLoadPhase == StartupLoadPhase::Finalize){
+    if(startupSceneLoad->isDone()){
         PScene loadedScene = std::static_pointer_cast<Scene>(startupLoadScene);
-        if(!applySceneSettingsRawJsonLocal(loadedScene, startupLoadSchema.sceneSettings, startupLoadEntitiesBySnapshotId, outError)){
-            return false;
-        }
         ensurePreferredCameraAfterSceneLoad(loadedScene);
         startupLoadScene->setSourceScenePath(startupLoadScenePath);
 
@@ -2614,10 +2434,9 @@ bool EditorScene::stepStartupCachedSceneLoad(std::string* outError){
         selectedAssetPath = normalizedPath;
         resetEditHistoryToCurrentScene();
         clearStartupCachedSceneLoadState();
-        return true;
     }
 
-    return false;
+    return true;
 }
 
 void EditorScene::setInputManager(std::shared_ptr<InputManager> manager){
@@ -2669,7 +2488,7 @@ void EditorScene::update(float deltaTime){
             }
         }
 
-        if(startupLoadPhase != StartupLoadPhase::None){
+        if(startupSceneLoad){
             std::string loadError;
             if(!stepStartupCachedSceneLoad(&loadError)){
                 if(!loadError.empty()){
@@ -2677,7 +2496,7 @@ void EditorScene::update(float deltaTime){
                 }
                 clearStartupCachedSceneLoadState();
             }
-            if(startupLoadPhase != StartupLoadPhase::None){
+            if(startupSceneLoad){
                 return;
             }
         }
@@ -2905,7 +2724,7 @@ void EditorScene::update(float deltaTime){
             }
 
             if(editorCameraTransform && editorCamera){
-                editorCameraTransform->local = editorCamera->transform();
+                editorCameraTransform->setLocal(editorCamera->transform());
             }
 
             if(!allowControl && playState == PlayState::Edit){
@@ -2956,18 +2775,23 @@ void EditorScene::update(float deltaTime){
                                 lmbReleased
                             );
                         }else{
+                            Math3D::Transform editedLocal = transformComp->getLocal();
                             widgetConsumed = transformWidget.update(
                                 this,
                                 inputManager.get(),
                                 viewportCamera,
                                 viewport,
                                 worldPos,
-                                transformComp->local,
+                                editedLocal,
                                 mouseInViewportInteractive && !allowControl,
                                 lmbPressed,
                                 lmb,
                                 lmbReleased
                             );
+                            if(widgetConsumed){
+                                // The widget only writes the transform on frames it consumes.
+                                transformComp->setLocal(editedLocal);
+                            }
                             if(auto* lightComp = components->getECSComponent<LightComponent>(entity)){
                                 if(!widgetConsumed){
                                     widgetConsumed = lightWidget.update(
@@ -3041,7 +2865,7 @@ void EditorScene::update(float deltaTime){
                 transform.setPosition(pos);
                 editorCamera->setTransform(transform);
                 if(editorCameraTransform){
-                    editorCameraTransform->local = transform;
+                    editorCameraTransform->setLocal(transform);
                 }
             }else{
                 focusActive = false;
@@ -4131,7 +3955,7 @@ void EditorScene::updateViewportPrefabDragPreviewFromMouse(){
         if(!transformComp){
             continue;
         }
-        transformComp->local.position = anchorPos + viewportPrefabDragState.rootOffsets[i];
+        transformComp->editLocal().position = anchorPos + viewportPrefabDragState.rootOffsets[i];
     }
 }
 
@@ -4403,7 +4227,7 @@ void EditorScene::focusOnEntity(const std::string& id){
                 break;
         }
     }else{
-        float scale = (transformComp->local.scale.x + transformComp->local.scale.y + transformComp->local.scale.z) / 3.0f;
+        float scale = (transformComp->getLocal().scale.x + transformComp->getLocal().scale.y + transformComp->getLocal().scale.z) / 3.0f;
         radius = std::max(0.5f, scale);
     }
 
@@ -4433,6 +4257,13 @@ std::string EditorScene::pickEntityIdAtScreen(float x, float y, PCamera cam){
     float bestT = std::numeric_limits<float>::max();
     std::string bestId;
 
+    // Rendered geometry is picked against its triangles through the scene's draw-item BVH.
+    Scene::DrawItemRayHit meshHit;
+    if(targetScene->raycastDrawItems(nearPoint, rayDir, bestT, true, meshHit)){
+        bestT = meshHit.distance;
+        bestId = meshHit.entityId;
+    }
+
     for(const auto& entityPtr : entities){
         auto* entity = entityPtr.get();
         if(!entity) continue;
@@ -4442,6 +4273,7 @@ std::string EditorScene::pickEntityIdAtScreen(float x, float y, PCamera cam){
         auto* lightComp = componentManager->getECSComponent<LightComponent>(entity);
         auto* bounds = componentManager->getECSComponent<BoundsComponent>(entity);
         if(!transform) continue;
+        if(renderer && renderer->visible && (renderer->mesh || renderer->model) && !cameraComp && !lightComp) continue;
         if(!renderer && !cameraComp && !lightComp && !bounds) continue;
 
         Math3D::Mat4 world = buildWorldMatrix(entity, componentManager);
@@ -4469,7 +4301,7 @@ std::string EditorScene::pickEntityIdAtScreen(float x, float y, PCamera cam){
                     break;
             }
         }else{
-            float scale = (transform->local.scale.x + transform->local.scale.y + transform->local.scale.z) / 3.0f;
+            float scale = (transform->getLocal().scale.x + transform->getLocal().scale.y + transform->getLocal().scale.z) / 3.0f;
             radius = std::max(0.5f, scale);
         }
 
@@ -4542,7 +4374,7 @@ void EditorScene::restoreSelectionAfterReset(){
     if(resetContext.hadCamera && editorCamera){
         editorCamera->setTransform(resetContext.editorCameraTransform);
         if(editorCameraTransform){
-            editorCameraTransform->local = resetContext.editorCameraTransform;
+            editorCameraTransform->setLocal(resetContext.editorCameraTransform);
         }
     }
     resetContext = ResetContext{};
@@ -4651,10 +4483,17 @@ void EditorScene::drawViewportPanel(float x, float y, float w, float h){
         static const char* kLoadingSuffixes[] = {"", ".", "..", "..."};
         const int suffixCount = (int)(sizeof(kLoadingSuffixes) / sizeof(kLoadingSuffixes[0]));
         const Uint64 dotIndex = (SDL_GetTicks() / 1000ULL) % (Uint64)suffixCount;
-        const std::string loadingText = StringUtils::Format(
+        std::string loadingText = StringUtils::Format(
             "Please wait as the Scene is Loaded%s",
             kLoadingSuffixes[(size_t)dotIndex]
         );
+        if(startupSceneLoad && startupSceneLoad->isActive()){
+            const SceneIO::IncrementalLoadProgress progress = startupSceneLoad->getProgress();
+            loadingText += StringUtils::Format(" %d%%", (int)(progress.fraction * 100.0f));
+            if(progress.etaSeconds >= 0.0f){
+                loadingText += StringUtils::Format(" (%.1fs left)", progress.etaSeconds);
+            }
+        }
         const ImVec2 textSize = ImGui::CalcTextSize(loadingText.c_str());
         const ImVec2 textPos(
             viewportRect.x + ((viewportRect.w - textSize.x) * 0.5f),
@@ -4773,7 +4612,7 @@ void EditorScene::drawViewportPanel(float x, float y, float w, float h){
                 if(boundsModeActive){
                     boundsWidget.draw(drawList, this, viewportCamera, viewport, world, *boundsComp);
                 }else{
-                    transformWidget.draw(drawList, this, viewportCamera, viewport, worldPos, transformComp->local, viewportHovered);
+                    transformWidget.draw(drawList, this, viewportCamera, viewport, worldPos, transformComp->getLocal(), viewportHovered);
                     if(auto* cameraComp = components->getECSComponent<CameraComponent>(entity)){
                         if(cameraComp->camera){
                             cameraWidget.draw(
@@ -5102,6 +4941,16 @@ void EditorScene::drawViewportPanel(float x, float y, float w, float h){
         const float postFxMs = debugStats.postFxMs.load(std::memory_order_relaxed);
         const int drawCount = debugStats.drawCount.load(std::memory_order_relaxed);
         const int postFxEffectCount = debugStats.postFxEffectCount.load(std::memory_order_relaxed);
+        const int worldMatrixUpdateCount = debugStats.worldMatrixUpdateCount.load(std::memory_order_relaxed);
+        const int uniformUploadCount = debugStats.uniformUploadCount.load(std::memory_order_relaxed);
+        const int drawCallCount = debugStats.drawCallCount.load(std::memory_order_relaxed);
+        const int shaderChangeCount = debugStats.shaderChangeCount.load(std::memory_order_relaxed);
+        const int materialChangeCount = debugStats.materialChangeCount.load(std::memory_order_relaxed);
+        const int cullChangeCount = debugStats.cullChangeCount.load(std::memory_order_relaxed);
+        const int shadowStateChangeCount = debugStats.shadowStateChangeCount.load(std::memory_order_relaxed);
+        const GpuReadback::Stats readbackStats = GpuReadback::GetStats();
+        const ShaderCacheStats& shaderStats = ShaderCache::Stats();
+        const ProgramBinaryCache::Stats& binaryCacheStats = ProgramBinaryCache::GetStats();
 
         float updateMs = 0.0f;
         float renderMs = 0.0f;
@@ -5122,7 +4971,11 @@ void EditorScene::drawViewportPanel(float x, float y, float w, float h){
             "Scene Performance\n"
             "FPS %.1f | Frame %.1f ms | Renderer %s\n"
             "Entities %d | Meshes %d | Lights %d | Cameras %d\n"
-            "Draws %d | PostFX %d | Snapshot %.2f ms\n"
+            "Draws %d (%d calls) | Uniforms %d | PostFX %d | Snapshot %.2f ms (%d xforms)\n"
+            "State Changes: Shader %d | Material %d | Cull %d | Shadow %d\n"
+            "Readbacks %d (%d skipped) | Stall Avoided %.1f ms total\n"
+            "Shader Variants %d (%d failed) | Compile %.1f ms variants, %.1f ms programs\n"
+            "Program Cache %d hit / %d miss (%d rejected) | Load %.1f ms vs %.1f ms source\n"
             "Shadow %.2f ms | Draw %.2f ms | PostFX %.2f ms\n"
             "Update %.2f ms | Render %.2f ms | Swap %.2f ms",
             fps,
@@ -5133,8 +4986,27 @@ void EditorScene::drawViewportPanel(float x, float y, float w, float h){
             counts.lightCount,
             counts.cameraCount,
             drawCount,
+            drawCallCount,
+            uniformUploadCount,
             postFxEffectCount,
             snapshotMs,
+            worldMatrixUpdateCount,
+            shaderChangeCount,
+            materialChangeCount,
+            cullChangeCount,
+            shadowStateChangeCount,
+            static_cast<int>(readbackStats.completed),
+            static_cast<int>(readbackStats.skipped),
+            readbackStats.stallAvoidedMs,
+            static_cast<int>(shaderStats.variantsCompiled),
+            static_cast<int>(shaderStats.variantsFailed),
+            shaderStats.variantCompileMs,
+            shaderStats.programCompileMs,
+            static_cast<int>(binaryCacheStats.hits),
+            static_cast<int>(binaryCacheStats.misses),
+            static_cast<int>(binaryCacheStats.rejected),
+            binaryCacheStats.loadMs,
+            binaryCacheStats.recordedCompileMs,
             shadowMs,
             drawMs,
             postFxMs,
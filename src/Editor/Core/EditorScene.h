@@ -29,6 +29,7 @@
 #include "Editor/Widgets/WorkspacePanel.h"
 #include "Rendering/Textures/Texture.h"
 #include "Serialization/IO/PrefabIO.h"
+#include "Serialization/IO/SceneIO.h"
 
 class LoadedScene;
 
@@ -298,12 +299,6 @@ class EditorScene : public Scene {
         bool lastObservedShowSceneGrid = true;
         bool lastObservedShowSceneGizmos = true;
         bool lastObservedShowScenePerformanceInfo = false;
-        enum class StartupLoadPhase {
-            None = 0,
-            CreateEntities,
-            DeserializeComponents,
-            Finalize
-        };
         bool startupBootstrapPending = true;
         bool startupUiFramePresented = false;
         bool startupLoadingOverlayActive = true;
@@ -318,15 +313,9 @@ class EditorScene : public Scene {
         bool startupSessionShowSceneGrid = true;
         bool startupSessionShowSceneGizmos = true;
         bool startupSessionShowScenePerformanceInfo = false;
-        StartupLoadPhase startupLoadPhase = StartupLoadPhase::None;
         std::shared_ptr<LoadedScene> startupLoadScene;
         std::filesystem::path startupLoadScenePath;
-        JsonSchema::SceneSchema startupLoadSchema;
-        std::unordered_map<std::uint64_t, const JsonSchema::EntitySnapshotSchemaBase::EntityRecord*> startupLoadRecordsById;
-        std::vector<const JsonSchema::EntitySnapshotSchemaBase::EntityRecord*> startupLoadPendingRecords;
-        std::unordered_map<std::uint64_t, NeoECS::GameObject*> startupLoadGameObjectsBySnapshotId;
-        std::unordered_map<std::uint64_t, NeoECS::ECSEntity*> startupLoadEntitiesBySnapshotId;
-        size_t startupLoadDeserializeIndex = 0;
+        std::unique_ptr<SceneIO::IncrementalSceneLoad> startupSceneLoad;
 
         void ensureTargetInitialized();
         void applyActiveSceneState();
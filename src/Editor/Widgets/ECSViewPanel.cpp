@@ -615,7 +615,8 @@ void ECSViewPanel::applyPendingActions(PScene targetScene,
                 std::unique_ptr<NeoECS::GameObject> wrapper = createEntityWrapper(targetScene, entity);
                 std::unique_ptr<NeoECS::GameObject> parentWrapper = createEntityWrapper(targetScene, parentEntity);
                 if(wrapper){
-                    if(wrapper->setParent(parentWrapper.get()) && changeCallbacks.onEntityReparented){
+                    const bool reparented = wrapper->setParent(parentWrapper.get());
+                    if(reparented && changeCallbacks.onEntityReparented){
                         changeCallbacks.onEntityReparented(action.entityId, oldParentId, action.targetEntityId);
                     }
                 }
@@ -634,7 +635,8 @@ void ECSViewPanel::applyPendingActions(PScene targetScene,
                 std::unique_ptr<NeoECS::GameObject> wrapper = createEntityWrapper(targetScene, entity);
                 std::unique_ptr<NeoECS::GameObject> rootWrapper = createEntityWrapper(targetScene, sceneRoot);
                 if(wrapper){
-                    if(wrapper->setParent(rootWrapper.get()) && changeCallbacks.onEntityReparented){
+                    const bool reparented = wrapper->setParent(rootWrapper.get());
+                    if(reparented && changeCallbacks.onEntityReparented){
                         changeCallbacks.onEntityReparented(action.entityId, oldParentId, "");
                     }
                 }
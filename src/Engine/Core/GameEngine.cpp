@@ -12,9 +12,11 @@
 #include "App/Demo/DefaultState.h"
 #include "Assets/Bundles/AssetBundleRegistry.h"
 #include "Foundation/Logging/Logbot.h"
+#include "Foundation/Threading/WorkerPool.h"
 #include "Editor/Core/ImGuiLayer.h"
 #include "Editor/Core/EditorScene.h"
 #include "Platform/Crash/CrashReporter.h"
+#include "Rendering/Shaders/ProgramBinaryCache.h"
 #include "Rendering/Textures/Texture.h"
 
 GameEngine* GameEngine::Engine = nullptr;
@@ -214,6 +216,8 @@ void GameEngine::tick(float deltaTime){
     }
 
     if(scene){
+        // Tick and render stay serialized: the render snapshot ring hands over draw lists, but the
+        // snapshot mesh/material tables and the ECS itself are still shared with the renderer.
         auto execWaitStart = clock::now();
         std::unique_lock<std::mutex> execLock(sceneExecutionMutex);
         auto execWaitEnd = clock::now();
@@ -390,6 +394,7 @@ void GameEngine::dispose(){
     }
 
     ImGuiLayer::Shutdown();
+    ProgramBinaryCache::LogStats("session");
 
     if(windowPtr){
         windowPtr->dispose();
@@ -440,6 +445,13 @@ bool GameEngine::enterState(int id){
 }
 
 void GameEngine::run(){ // Render Thread.
+    // The render thread owns the GL context, so it is the one that drains main-thread jobs.
+    WorkerPool::Instance().setMainThread();
+
+    // Startup is measured to the end of the first presented frame, since most programs compile on first draw.
+    const auto startupStart = std::chrono::steady_clock::now();
+    bool firstFrameLogged = false;
+
     try{
         init();
     }catch(const std::exception& e){
@@ -491,6 +503,7 @@ void GameEngine::run(){ // Render Thread.
             renderTickAccumulator = 0.0f;
         }
 
+        WorkerPool::Instance().runMainThreadJobs();
         render();
 
         if(windowPtr){
@@ -510,6 +523,13 @@ void GameEngine::run(){ // Render Thread.
             runtimeDebugStats.swapMs.store(0.0f, std::memory_order_relaxed);
         }
 
+        if(!firstFrameLogged){
+            firstFrameLogged = true;
+            LogBot.Log(LOG_INFO, "Startup to first frame: %.1f ms.",
+                       std::chrono::duration<double, std::milli>(frameClock::now() - startupStart).count());
+            ProgramBinaryCache::LogStats("first frame");
+        }
+
         int frameCap = frameCapFps.load(std::memory_order_relaxed);
         if(frameCap != kFrameCapUncapped){
             auto targetFrameDuration = std::chrono::duration<float>(1.0f / static_cast<float>(frameCap));
@@ -537,6 +557,9 @@ void GameEngine::start(){ // Local Logic Thread.
     running = true;
     renderReady = false;
 
+    WorkerPool::Instance().start();
+    LogBot.Log(LOG_INFO, "Started %llu job worker(s).", static_cast<unsigned long long>(WorkerPool::Instance().getWorkerCount()));
+
     mainRenderThread = std::thread(&GameEngine::run, this);
 
     {
@@ -578,6 +601,8 @@ void GameEngine::start(){ // Local Logic Thread.
     if(mainRenderThread.joinable()){
         mainRenderThread.join();
     }
+
+    WorkerPool::Instance().stop();
 }
 
 void GameEngine::exit(int code){
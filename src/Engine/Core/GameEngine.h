@@ -253,6 +253,8 @@ class GameEngine{
 
         /**
          * @brief Starts the engine and enters the main loop.
+         *
+         * WorkerPool::Instance() is started before the render thread and stopped after it exits.
          */
         void start();
         /**
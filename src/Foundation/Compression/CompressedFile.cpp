@@ -6,17 +6,15 @@
 #include "Foundation/Compression/CompressedFile.h"
 
 #include "Foundation/Logging/Logbot.h"
+#include "Foundation/Threading/WorkerPool.h"
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <fstream>
 #include <limits>
 #include <set>
 
-#include "STB/stb_image.h"
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include "STB/stb_image_write.h"
-
 namespace {
 
 inline static Logbot compressedFileLogger = Logbot::CreateInstance("CompressedFile");
@@ -114,10 +112,11 @@ bool writeFileBytes(const std::filesystem::path& path, const BinaryBuffer& data,
     return true;
 }
 
-/// @brief Represents Prepared Zip Write Entry data.
+/// @brief Represents Prepared Zip Write Entry data. `payload` views `ownedPayload` or caller-owned bytes.
 struct PreparedZipWriteEntry {
     std::string path;
-    BinaryBuffer payload;
+    BinaryBuffer ownedPayload;
+    ByteView payload;
     std::uint16_t compressionMethod = kZipMethodStore;
     std::uint32_t crc32 = 0;
     std::uint32_t compressedSize = 0;
@@ -126,7 +125,7 @@ struct PreparedZipWriteEntry {
     bool isDirectory = false;
 };
 
-bool prepareWriteEntry(const CompressedFile::WriteEntry& source, PreparedZipWriteEntry& outEntry, std::string* outError){
+bool prepareWriteEntry(const CompressedFile::WriteEntry& source, int compressionLevel, PreparedZipWriteEntry& outEntry, std::string* outError){
     outEntry = PreparedZipWriteEntry{};
     outEntry.isDirectory = source.isDirectory;
     outEntry.path = CompressedFile::NormalizeEntryPath(source.path, source.isDirectory);
@@ -140,7 +139,23 @@ bool prepareWriteEntry(const CompressedFile::WriteEntry& source, PreparedZipWrit
     }
 
     if(source.isDirectory){
-        outEntry.payload.clear();
+        return true;
+    }
+
+    if(source.sourceArchive){
+        // Unchanged entry: copy its stored bytes instead of decoding and recompressing them.
+        const CompressedFile::Entry* storedEntry = nullptr;
+        if(!source.sourceArchive->readStoredPayload(source.sourceEntryPath, storedEntry, outEntry.payload, outError)){
+            return false;
+        }
+        if(storedEntry->isDirectory){
+            setCompressedFileError(outError, "Archive entry to copy is a directory: " + storedEntry->path);
+            return false;
+        }
+        outEntry.compressionMethod = storedEntry->compressionMethod;
+        outEntry.crc32 = storedEntry->crc32;
+        outEntry.compressedSize = storedEntry->compressedSize;
+        outEntry.uncompressedSize = storedEntry->uncompressedSize;
         return true;
     }
 
@@ -151,34 +166,17 @@ bool prepareWriteEntry(const CompressedFile::WriteEntry& source, PreparedZipWrit
 
     outEntry.uncompressedSize = static_cast<std::uint32_t>(source.data.size());
     outEntry.crc32 = CompressedFile::ComputeCRC32(source.data);
-    outEntry.payload = source.data;
-    outEntry.compressedSize = static_cast<std::uint32_t>(outEntry.payload.size());
-
-    if(source.preferCompression &&
-       !source.data.empty() &&
-       source.data.size() <= static_cast<size_t>(std::numeric_limits<int>::max())){
-        int compressedSizeWithWrapper = 0;
-        unsigned char* compressedWithWrapper = stbi_zlib_compress(
-            const_cast<unsigned char*>(reinterpret_cast<const unsigned char*>(source.data.data())),
-            static_cast<int>(source.data.size()),
-            &compressedSizeWithWrapper,
-            8
-        );
-
-        if(compressedWithWrapper){
-            const bool hasWrapper = compressedSizeWithWrapper > 6;
-            if(hasWrapper){
-                const int rawDeflateSize = compressedSizeWithWrapper - 6;
-                if(rawDeflateSize > 0 && static_cast<size_t>(rawDeflateSize) < source.data.size()){
-                    outEntry.payload.assign(
-                        compressedWithWrapper + 2,
-                        compressedWithWrapper + 2 + rawDeflateSize
-                    );
-                    outEntry.compressionMethod = kZipMethodDeflate;
-                    outEntry.compressedSize = static_cast<std::uint32_t>(outEntry.payload.size());
-                }
-            }
-            STBIW_FREE(compressedWithWrapper);
+    outEntry.payload = ByteView(source.data);
+    outEntry.compressedSize = static_cast<std::uint32_t>(source.data.size());
+
+    if(source.preferCompression && compressionLevel > 0 && !source.data.empty()){
+        Deflate::Compress(source.data.data(), source.data.size(), compressionLevel, outEntry.ownedPayload);
+        if(outEntry.ownedPayload.size() < source.data.size()){
+            outEntry.payload = ByteView(outEntry.ownedPayload);
+            outEntry.compressionMethod = kZipMethodDeflate;
+            outEntry.compressedSize = static_cast<std::uint32_t>(outEntry.ownedPayload.size());
+        }else{
+            outEntry.ownedPayload.clear();
         }
     }
 
@@ -235,24 +233,33 @@ bool CompressedFile::writeToPath(const std::filesystem::path& path, const std::v
         return false;
     }
 
-    std::vector<PreparedZipWriteEntry> preparedEntries;
-    preparedEntries.reserve(entriesToWrite.size());
-    std::set<std::string> seenPaths;
+    // Entries compress independently, so spread them over the worker pool.
+    std::vector<PreparedZipWriteEntry> preparedEntries(entriesToWrite.size());
+    std::vector<std::string> prepareErrors(entriesToWrite.size());
+    std::vector<std::uint8_t> prepared(entriesToWrite.size(), 0);
+    const int level = compressionLevel;
+    WorkerPool::Instance().parallelFor(entriesToWrite.size(), 1, [&](size_t, size_t begin, size_t end){
+        for(size_t i = begin; i < end; ++i){
+            prepared[i] = prepareWriteEntry(entriesToWrite[i], level, preparedEntries[i], &prepareErrors[i]) ? 1 : 0;
+        }
+    });
 
-    for(size_t i = 0; i < entriesToWrite.size(); ++i){
-        PreparedZipWriteEntry prepared;
-        if(!prepareWriteEntry(entriesToWrite[i], prepared, outError)){
+    std::set<std::string> seenPaths;
+    size_t totalBytes = 22;
+    for(size_t i = 0; i < preparedEntries.size(); ++i){
+        if(!prepared[i]){
+            setCompressedFileError(outError, prepareErrors[i]);
             return false;
         }
-        if(!seenPaths.insert(prepared.path).second){
-            setCompressedFileError(outError, "Duplicate archive entry path: " + prepared.path);
+        if(!seenPaths.insert(preparedEntries[i].path).second){
+            setCompressedFileError(outError, "Duplicate archive entry path: " + preparedEntries[i].path);
             return false;
         }
-        preparedEntries.push_back(prepared);
+        totalBytes += 30 + 46 + 2 * preparedEntries[i].path.size() + preparedEntries[i].payload.size();
     }
 
     BinaryBuffer outBytes;
-    outBytes.reserve(1024);
+    outBytes.reserve(totalBytes);
 
     for(auto& entry : preparedEntries){
         if(outBytes.size() > static_cast<size_t>(std::numeric_limits<std::uint32_t>::max())){
@@ -325,13 +332,17 @@ bool CompressedFile::writeToPath(const std::filesystem::path& path, const std::v
     }
 
     archivePath = path;
-    archiveBytes = outBytes;
+    archiveBytes = std::move(outBytes);
     currentFormat = Format::Zip;
     entryList.clear();
     entryIndexByPath.clear();
     return parseZip(outError);
 }
 
+void CompressedFile::setCompressionLevel(int level){
+    compressionLevel = std::clamp(level, Deflate::MinLevel, Deflate::MaxLevel);
+}
+
 bool CompressedFile::hasEntry(const std::string& entryPath) const{
     return findEntry(entryPath) != nullptr;
 }
@@ -370,29 +381,12 @@ bool CompressedFile::readEntry(const std::string& entryPath, BinaryBuffer& outDa
     if(entry->compressionMethod == kZipMethodStore){
         outData.assign(payloadData, payloadData + payloadSize);
     }else if(entry->compressionMethod == kZipMethodDeflate){
-        if(entry->uncompressedSize == 0){
+        // ZIP records the decoded size, so decode straight into a buffer of that size.
+        outData.resize(entry->uncompressedSize);
+        if(!Deflate::Decompress(payloadData, payloadSize, outData.data(), outData.size())){
             outData.clear();
-        }else{
-            if(payloadSize > static_cast<size_t>(std::numeric_limits<int>::max())){
-                setCompressedFileError(outError, "Compressed ZIP entry is too large to decode: " + entry->path);
-                return false;
-            }
-            int decodedSize = 0;
-            char* decoded = stbi_zlib_decode_noheader_malloc(
-                reinterpret_cast<const char*>(payloadData),
-                static_cast<int>(payloadSize),
-                &decodedSize
-            );
-            if(!decoded){
-                setCompressedFileError(outError, "Failed to decompress archive entry: " + entry->path);
-                return false;
-            }
-
-            outData.assign(
-                reinterpret_cast<const std::uint8_t*>(decoded),
-                reinterpret_cast<const std::uint8_t*>(decoded) + decodedSize
-            );
-            stbi_image_free(decoded);
+            setCompressedFileError(outError, "Failed to decompress archive entry: " + entry->path);
+            return false;
         }
     }else{
         setCompressedFileError(
@@ -416,6 +410,26 @@ bool CompressedFile::readEntry(const std::string& entryPath, BinaryBuffer& outDa
     return true;
 }
 
+bool CompressedFile::readStoredPayload(const std::string& entryPath, const Entry*& outEntry, ByteView& outPayload, std::string* outError) const{
+    outEntry = findEntry(entryPath);
+    outPayload = ByteView();
+    if(!outEntry){
+        setCompressedFileError(outError, "Archive entry was not found: " + NormalizeEntryPath(entryPath));
+        return false;
+    }
+    if(outEntry->isDirectory){
+        return true;
+    }
+
+    const uint8_t* payloadData = nullptr;
+    size_t payloadSize = 0;
+    if(!readLocalFilePayload(*outEntry, payloadData, payloadSize, outError)){
+        return false;
+    }
+    outPayload = ByteView(payloadData, payloadSize);
+    return true;
+}
+
 std::string CompressedFile::NormalizeEntryPath(const std::string& path, bool forceDirectory){
     if(path.empty()){
         return forceDirectory ? std::string() : std::string();
@@ -469,9 +483,10 @@ std::string CompressedFile::NormalizeEntryPath(const std::string& path, bool for
 }
 
 std::uint32_t CompressedFile::ComputeCRC32(const uint8_t* data, size_t size){
-    static const std::array<std::uint32_t, 256> kTable = []() {
-        std::array<std::uint32_t, 256> table{};
-        for(std::uint32_t i = 0; i < table.size(); ++i){
+    // Slicing-by-8: kTables[k][b] is the CRC of byte b followed by k zero bytes.
+    static const std::array<std::array<std::uint32_t, 256>, 8> kTables = []() {
+        std::array<std::array<std::uint32_t, 256>, 8> tables{};
+        for(std::uint32_t i = 0; i < 256; ++i){
             std::uint32_t value = i;
             for(int bit = 0; bit < 8; ++bit){
                 if((value & 1u) != 0u){
@@ -480,14 +495,35 @@ std::uint32_t CompressedFile::ComputeCRC32(const uint8_t* data, size_t size){
                     value >>= 1;
                 }
             }
-            table[i] = value;
+            tables[0][i] = value;
+        }
+        for(std::uint32_t i = 0; i < 256; ++i){
+            for(size_t k = 1; k < tables.size(); ++k){
+                const std::uint32_t previous = tables[k - 1][i];
+                tables[k][i] = tables[0][previous & 0xffu] ^ (previous >> 8);
+            }
         }
-        return table;
+        return tables;
     }();
 
     std::uint32_t crc = 0xffffffffu;
-    for(size_t i = 0; i < size; ++i){
-        crc = kTable[(crc ^ data[i]) & 0xffu] ^ (crc >> 8);
+    size_t i = 0;
+    for(; i + 8 <= size; i += 8){
+        const std::uint32_t low = crc ^ (static_cast<std::uint32_t>(data[i]) |
+                                         (static_cast<std::uint32_t>(data[i + 1]) << 8) |
+                                         (static_cast<std::uint32_t>(data[i + 2]) << 16) |
+                                         (static_cast<std::uint32_t>(data[i + 3]) << 24));
+        crc = kTables[7][low & 0xffu] ^
+              kTables[6][(low >> 8) & 0xffu] ^
+              kTables[5][(low >> 16) & 0xffu] ^
+              kTables[4][low >> 24] ^
+              kTables[3][data[i + 4]] ^
+              kTables[2][data[i + 5]] ^
+              kTables[1][data[i + 6]] ^
+              kTables[0][data[i + 7]];
+    }
+    for(; i < size; ++i){
+        crc = kTables[0][(crc ^ data[i]) & 0xffu] ^ (crc >> 8);
     }
     return crc ^ 0xffffffffu;
 }
@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 
+#include "Foundation/Compression/Deflate.h"
 #include "Foundation/Util/Types.h"
 
 /// @brief Represents the CompressedFile type.
@@ -34,12 +35,20 @@ class CompressedFile {
             bool isDirectory = false;
         };
 
-        /// @brief Holds data for WriteEntry.
+        /**
+         * @brief Holds data for WriteEntry.
+         *
+         * When `sourceArchive` is set, the entry named `sourceEntryPath` is copied from it as
+         * stored (payload, method and CRC) without decoding or recompressing, and `data` is ignored.
+         * The source may be the archive being rewritten.
+         */
         struct WriteEntry {
             std::string path;
             BinaryBuffer data;
             bool isDirectory = false;
             bool preferCompression = true;
+            const CompressedFile* sourceArchive = nullptr;
+            std::string sourceEntryPath;
         };
 
     private:
@@ -48,6 +57,7 @@ class CompressedFile {
         BinaryBuffer archiveBytes;
         std::vector<Entry> entryList;
         std::map<std::string, size_t> entryIndexByPath;
+        int compressionLevel = Deflate::DefaultLevel;
 
         /**
          * @brief Checks whether parse zip.
@@ -109,6 +119,12 @@ class CompressedFile {
          * @return True when the operation succeeds; otherwise false.
          */
         bool writeToPath(const std::filesystem::path& path, const std::vector<WriteEntry>& entries, std::string* outError = nullptr);
+        /**
+         * @brief Sets the DEFLATE level used by later writes.
+         * @param level Level in [Deflate::MinLevel, Deflate::MaxLevel]; 0 stores entries uncompressed.
+         */
+        void setCompressionLevel(int level);
+        int getCompressionLevel() const { return compressionLevel; }
 
         /**
          * @brief Checks whether open.
@@ -121,6 +137,15 @@ class CompressedFile {
         bool hasEntry(const std::string& entryPath) const;
         const Entry* findEntry(const std::string& entryPath) const;
         bool readEntry(const std::string& entryPath, BinaryBuffer& outData, std::string* outError = nullptr) const;
+        /**
+         * @brief Returns an entry's payload exactly as stored in the archive (possibly compressed).
+         * @param entryPath Entry path.
+         * @param outEntry Receives the entry record.
+         * @param outPayload Receives a view into the archive bytes; valid until the next open or write.
+         * @param outError Output value for error.
+         * @return True when the operation succeeds; otherwise false.
+         */
+        bool readStoredPayload(const std::string& entryPath, const Entry*& outEntry, ByteView& outPayload, std::string* outError = nullptr) const;
 
         static std::string NormalizeEntryPath(const std::string& path, bool forceDirectory = false);
         static std::uint32_t ComputeCRC32(const uint8_t* data, size_t size);
@@ -0,0 +1,974 @@
+/**
+ * @file src/Foundation/Compression/Deflate.cpp
+ * @brief Implementation for Deflate.
+ */
+
+#include "Foundation/Compression/Deflate.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr int kWindowSize = 32768;
+constexpr int kWindowMask = kWindowSize - 1;
+constexpr int kHashBits = 15;
+constexpr int kMinMatch = 3;
+constexpr int kMaxMatch = 258;
+constexpr size_t kMaxStoredBlock = 65535;
+constexpr size_t kBlockSymbolLimit = 16384;
+constexpr int kLitLenSymbols = 286;
+constexpr int kDistSymbols = 30;
+constexpr int kCodeLengthSymbols = 19;
+constexpr int kMaxCodeLength = 15;
+constexpr int kMaxCodeLengthCodeLength = 7;
+constexpr int kLitLenPrimaryBits = 10;
+constexpr int kDistPrimaryBits = 8;
+constexpr int kCodeLengthPrimaryBits = 7;
+
+constexpr std::uint16_t kLengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+constexpr std::uint8_t kLengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+constexpr std::uint16_t kDistBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+constexpr std::uint8_t kDistExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+constexpr std::uint8_t kCodeLengthOrder[kCodeLengthSymbols] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+/// @brief Holds data for LevelParams.
+struct LevelParams {
+    int maxChain;
+    int niceLength;
+    bool lazy;
+};
+
+constexpr LevelParams kLevelParams[Deflate::MaxLevel + 1] = {
+    {0, 0, false},
+    {4, 8, false},
+    {8, 16, false},
+    {16, 32, false},
+    {16, 32, true},
+    {32, 64, true},
+    {128, 128, true},
+    {256, 192, true},
+    {1024, 258, true},
+    {4096, 258, true}
+};
+
+std::uint32_t reverseBits(std::uint32_t code, int length){
+    std::uint32_t result = 0;
+    for(int i = 0; i < length; ++i){
+        result = (result << 1) | (code & 1u);
+        code >>= 1;
+    }
+    return result;
+}
+
+// Builds bit-reversed canonical codes (DEFLATE writes Huffman codes LSB first).
+void buildCanonicalCodes(const std::uint8_t* lengths, int symbolCount, std::uint16_t* outCodes){
+    std::uint16_t lengthCounts[kMaxCodeLength + 1] = {};
+    for(int i = 0; i < symbolCount; ++i){
+        lengthCounts[lengths[i]]++;
+    }
+    lengthCounts[0] = 0;
+
+    std::uint32_t nextCode[kMaxCodeLength + 2] = {};
+    std::uint32_t code = 0;
+    for(int bits = 1; bits <= kMaxCodeLength; ++bits){
+        code = (code + lengthCounts[bits - 1]) << 1;
+        nextCode[bits] = code;
+    }
+
+    for(int i = 0; i < symbolCount; ++i){
+        const int length = lengths[i];
+        outCodes[i] = (length > 0) ? static_cast<std::uint16_t>(reverseBits(nextCode[length]++, length)) : 0;
+    }
+}
+
+// Huffman code lengths limited to `maxLength`; flattens the frequencies until the tree fits.
+void buildCodeLengths(const std::uint32_t* frequencies, int symbolCount, int maxLength, std::uint8_t* outLengths){
+    std::fill(outLengths, outLengths + symbolCount, std::uint8_t(0));
+
+    std::vector<std::uint32_t> weights(frequencies, frequencies + symbolCount);
+    std::vector<int> leaves;
+    leaves.reserve(static_cast<size_t>(symbolCount));
+    for(int i = 0; i < symbolCount; ++i){
+        if(weights[static_cast<size_t>(i)] > 0){
+            leaves.push_back(i);
+        }
+    }
+    if(leaves.empty()){
+        return;
+    }
+    if(leaves.size() == 1){
+        outLengths[leaves[0]] = 1;
+        return;
+    }
+
+    const size_t leafCount = leaves.size();
+    std::vector<std::uint64_t> nodeWeight(leafCount * 2);
+    std::vector<std::uint32_t> nodeParent(leafCount * 2);
+    std::vector<std::uint8_t> nodeDepth(leafCount * 2);
+
+    for(;;){
+        std::sort(leaves.begin(), leaves.end(), [&weights](int a, int b){
+            const std::uint32_t wa = weights[static_cast<size_t>(a)];
+            const std::uint32_t wb = weights[static_cast<size_t>(b)];
+            return (wa != wb) ? (wa < wb) : (a < b);
+        });
+        for(size_t i = 0; i < leafCount; ++i){
+            nodeWeight[i] = weights[static_cast<size_t>(leaves[i])];
+        }
+
+        // Two-queue construction: leaves are sorted and merged nodes come out in ascending order.
+        size_t leafCursor = 0;
+        size_t nodeCursor = leafCount;
+        size_t nextNode = leafCount;
+        auto takeSmallest = [&]() -> size_t {
+            if(leafCursor < leafCount && (nodeCursor >= nextNode || nodeWeight[leafCursor] <= nodeWeight[nodeCursor])){
+                return leafCursor++;
+            }
+            return nodeCursor++;
+        };
+        for(size_t merge = 0; merge + 1 < leafCount; ++merge){
+            const size_t a = takeSmallest();
+            const size_t b = takeSmallest();
+            nodeWeight[nextNode] = nodeWeight[a] + nodeWeight[b];
+            nodeParent[a] = static_cast<std::uint32_t>(nextNode);
+            nodeParent[b] = static_cast<std::uint32_t>(nextNode);
+            ++nextNode;
+        }
+
+        // The root is the last merged node; its depth stays at the zero it was created with.
+        const size_t root = 2 * leafCount - 2;
+        int deepest = 0;
+        for(size_t node = root; node-- > 0; ){
+            nodeDepth[node] = static_cast<std::uint8_t>(std::min<int>(nodeDepth[nodeParent[node]] + 1, 255));
+            if(node < leafCount){
+                deepest = std::max<int>(deepest, nodeDepth[node]);
+            }
+        }
+
+        if(deepest <= maxLength){
+            for(size_t i = 0; i < leafCount; ++i){
+                outLengths[leaves[i]] = nodeDepth[i];
+            }
+            return;
+        }
+
+        for(int symbol : leaves){
+            std::uint32_t& weight = weights[static_cast<size_t>(symbol)];
+            weight = (weight >> 1) | 1u;
+        }
+    }
+}
+
+void ensureTwoCodes(std::uint32_t* frequencies, int symbolCount){
+    int used = 0;
+    int lastUsed = -1;
+    for(int i = 0; i < symbolCount && used < 2; ++i){
+        if(frequencies[i] > 0){
+            ++used;
+            lastUsed = i;
+        }
+    }
+    if(used == 0){
+        frequencies[0] = 1;
+        frequencies[1] = 1;
+    }else if(used == 1){
+        frequencies[(lastUsed == 0) ? 1 : 0] = 1;
+    }
+}
+
+/// @brief Holds data for EncoderTables.
+struct EncoderTables {
+    std::uint8_t lengthCode[kMaxMatch + 1] = {};
+    std::uint8_t distCode[512] = {};
+    std::uint8_t fixedLitLenLengths[288] = {};
+    std::uint16_t fixedLitLenCodes[288] = {};
+    std::uint8_t fixedDistLengths[kDistSymbols] = {};
+    std::uint16_t fixedDistCodes[kDistSymbols] = {};
+
+    EncoderTables(){
+        for(int code = 0; code < 29; ++code){
+            const int count = 1 << kLengthExtra[code];
+            for(int i = 0; i < count && kLengthBase[code] + i <= kMaxMatch; ++i){
+                lengthCode[kLengthBase[code] + i] = static_cast<std::uint8_t>(code);
+            }
+        }
+        lengthCode[kMaxMatch] = 28;
+
+        for(int code = 0; code < kDistSymbols; ++code){
+            const int count = 1 << kDistExtra[code];
+            for(int i = 0; i < count; ++i){
+                const int d = kDistBase[code] - 1 + i;
+                if(d < 256){
+                    distCode[d] = static_cast<std::uint8_t>(code);
+                }else{
+                    distCode[256 + (d >> 7)] = static_cast<std::uint8_t>(code);
+                }
+            }
+        }
+
+        for(int i = 0; i < 288; ++i){
+            fixedLitLenLengths[i] = (i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8;
+        }
+        buildCanonicalCodes(fixedLitLenLengths, 288, fixedLitLenCodes);
+        std::fill(std::begin(fixedDistLengths), std::end(fixedDistLengths), std::uint8_t(5));
+        buildCanonicalCodes(fixedDistLengths, kDistSymbols, fixedDistCodes);
+    }
+
+    int distanceCode(int distance) const {
+        const int d = distance - 1;
+        return (d < 256) ? distCode[d] : distCode[256 + (d >> 7)];
+    }
+};
+
+const EncoderTables& encoderTables(){
+    static const EncoderTables tables;
+    return tables;
+}
+
+/// @brief Holds data for BitWriter.
+struct BitWriter {
+    BinaryBuffer& out;
+    std::uint64_t bits = 0;
+    int count = 0;
+
+    explicit BitWriter(BinaryBuffer& target) : out(target) {}
+
+    void put(std::uint32_t value, int length){
+        bits |= static_cast<std::uint64_t>(value) << count;
+        count += length;
+        if(count >= 32){
+            const std::uint8_t bytes[4] = {
+                static_cast<std::uint8_t>(bits),
+                static_cast<std::uint8_t>(bits >> 8),
+                static_cast<std::uint8_t>(bits >> 16),
+                static_cast<std::uint8_t>(bits >> 24)
+            };
+            out.insert(out.end(), bytes, bytes + 4);
+            bits >>= 32;
+            count -= 32;
+        }
+    }
+
+    void alignToByte(){
+        while(count > 0){
+            out.push_back(static_cast<std::uint8_t>(bits));
+            bits >>= 8;
+            count -= 8;
+        }
+        bits = 0;
+        count = 0;
+    }
+};
+
+/// @brief Holds data for Symbol. Literals have `distance == 0`; matches store their length.
+struct Symbol {
+    std::uint16_t literalOrLength;
+    std::uint16_t distance;
+};
+
+void writeStoredBlocks(BitWriter& writer, const std::uint8_t* data, size_t size, bool finalBlock){
+    size_t offset = 0;
+    do{
+        const size_t chunk = std::min(size - offset, kMaxStoredBlock);
+        const bool last = finalBlock && (offset + chunk == size);
+        writer.put(last ? 1u : 0u, 1);
+        writer.put(0u, 2);
+        writer.alignToByte();
+        writer.put(static_cast<std::uint32_t>(chunk), 16);
+        writer.put(static_cast<std::uint32_t>(~chunk & 0xffffu), 16);
+        writer.alignToByte();
+        if(chunk > 0){
+            writer.out.insert(writer.out.end(), data + offset, data + offset + chunk);
+        }
+        offset += chunk;
+    }while(offset < size);
+}
+
+void writeSymbols(BitWriter& writer,
+                  const std::vector<Symbol>& symbols,
+                  const std::uint16_t* litLenCodes,
+                  const std::uint8_t* litLenLengths,
+                  const std::uint16_t* distCodes,
+                  const std::uint8_t* distLengths){
+    const EncoderTables& tables = encoderTables();
+    for(const Symbol& symbol : symbols){
+        if(symbol.distance == 0){
+            writer.put(litLenCodes[symbol.literalOrLength], litLenLengths[symbol.literalOrLength]);
+            continue;
+        }
+
+        const int lengthCode = tables.lengthCode[symbol.literalOrLength];
+        writer.put(litLenCodes[257 + lengthCode], litLenLengths[257 + lengthCode]);
+        if(kLengthExtra[lengthCode] > 0){
+            writer.put(symbol.literalOrLength - kLengthBase[lengthCode], kLengthExtra[lengthCode]);
+        }
+
+        const int distCode = tables.distanceCode(symbol.distance);
+        writer.put(distCodes[distCode], distLengths[distCode]);
+        if(kDistExtra[distCode] > 0){
+            writer.put(symbol.distance - kDistBase[distCode], kDistExtra[distCode]);
+        }
+    }
+    writer.put(litLenCodes[256], litLenLengths[256]);
+}
+
+/// @brief Holds data for CodeLengthToken. `symbol` is 0-18; `extra` holds the repeat bits.
+struct CodeLengthToken {
+    std::uint8_t symbol;
+    std::uint8_t extra;
+};
+
+void tokenizeCodeLengths(const std::uint8_t* lengths, int count, std::vector<CodeLengthToken>& outTokens){
+    outTokens.clear();
+    int i = 0;
+    while(i < count){
+        const std::uint8_t current = lengths[i];
+        int run = 1;
+        while(i + run < count && lengths[i + run] == current){
+            ++run;
+        }
+        i += run;
+
+        if(current == 0){
+            while(run >= 11){
+                const int n = std::min(run, 138);
+                outTokens.push_back({18, static_cast<std::uint8_t>(n - 11)});
+                run -= n;
+            }
+            if(run >= 3){
+                outTokens.push_back({17, static_cast<std::uint8_t>(run - 3)});
+                run = 0;
+            }
+        }else{
+            outTokens.push_back({current, 0});
+            --run;
+            while(run >= 3){
+                const int n = std::min(run, 6);
+                outTokens.push_back({16, static_cast<std::uint8_t>(n - 3)});
+                run -= n;
+            }
+        }
+        for(; run > 0; --run){
+            outTokens.push_back({current, 0});
+        }
+    }
+}
+
+void writeBlock(BitWriter& writer,
+                const std::vector<Symbol>& symbols,
+                const std::uint8_t* blockData,
+                size_t blockSize,
+                bool finalBlock){
+    const EncoderTables& tables = encoderTables();
+
+    std::uint32_t litLenFreq[kLitLenSymbols] = {};
+    std::uint32_t distFreq[kDistSymbols] = {};
+    std::uint64_t extraBits = 0;
+    for(const Symbol& symbol : symbols){
+        if(symbol.distance == 0){
+            litLenFreq[symbol.literalOrLength]++;
+            continue;
+        }
+        const int lengthCode = tables.lengthCode[symbol.literalOrLength];
+        const int distCode = tables.distanceCode(symbol.distance);
+        litLenFreq[257 + lengthCode]++;
+        distFreq[distCode]++;
+        extraBits += kLengthExtra[lengthCode] + kDistExtra[distCode];
+    }
+    litLenFreq[256] = 1;
+
+    std::uint64_t fixedBits = 3 + extraBits;
+    for(int i = 0; i < kLitLenSymbols; ++i){
+        fixedBits += static_cast<std::uint64_t>(litLenFreq[i]) * tables.fixedLitLenLengths[i];
+    }
+    for(int i = 0; i < kDistSymbols; ++i){
+        fixedBits += static_cast<std::uint64_t>(distFreq[i]) * 5u;
+    }
+
+    ensureTwoCodes(litLenFreq, kLitLenSymbols);
+    ensureTwoCodes(distFreq, kDistSymbols);
+
+    std::uint8_t litLenLengths[kLitLenSymbols] = {};
+    std::uint8_t distLengths[kDistSymbols] = {};
+    buildCodeLengths(litLenFreq, kLitLenSymbols, kMaxCodeLength, litLenLengths);
+    buildCodeLengths(distFreq, kDistSymbols, kMaxCodeLength, distLengths);
+
+    int litLenCount = kLitLenSymbols;
+    while(litLenCount > 257 && litLenLengths[litLenCount - 1] == 0){
+        --litLenCount;
+    }
+    int distCount = kDistSymbols;
+    while(distCount > 1 && distLengths[distCount - 1] == 0){
+        --distCount;
+    }
+
+    std::uint8_t allLengths[kLitLenSymbols + kDistSymbols] = {};
+    std::memcpy(allLengths, litLenLengths, static_cast<size_t>(litLenCount));
+    std::memcpy(allLengths + litLenCount, distLengths, static_cast<size_t>(distCount));
+    std::vector<CodeLengthToken> tokens;
+    tokenizeCodeLengths(allLengths, litLenCount + distCount, tokens);
+
+    std::uint32_t codeLengthFreq[kCodeLengthSymbols] = {};
+    for(const CodeLengthToken& token : tokens){
+        codeLengthFreq[token.symbol]++;
+    }
+    ensureTwoCodes(codeLengthFreq, kCodeLengthSymbols);
+    std::uint8_t codeLengthLengths[kCodeLengthSymbols] = {};
+    buildCodeLengths(codeLengthFreq, kCodeLengthSymbols, kMaxCodeLengthCodeLength, codeLengthLengths);
+
+    int codeLengthCount = kCodeLengthSymbols;
+    while(codeLengthCount > 4 && codeLengthLengths[kCodeLengthOrder[codeLengthCount - 1]] == 0){
+        --codeLengthCount;
+    }
+
+    std::uint64_t dynamicBits = 3 + 14 + 3u * static_cast<std::uint64_t>(codeLengthCount) + extraBits;
+    for(const CodeLengthToken& token : tokens){
+        dynamicBits += codeLengthLengths[token.symbol];
+        dynamicBits += (token.symbol == 16) ? 2 : (token.symbol == 17) ? 3 : (token.symbol == 18) ? 7 : 0;
+    }
+    for(int i = 0; i < kLitLenSymbols; ++i){
+        dynamicBits += static_cast<std::uint64_t>(litLenFreq[i]) * litLenLengths[i];
+    }
+    for(int i = 0; i < kDistSymbols; ++i){
+        dynamicBits += static_cast<std::uint64_t>(distFreq[i]) * distLengths[i];
+    }
+
+    const std::uint64_t storedChunks = std::max<std::uint64_t>(1, (blockSize + kMaxStoredBlock - 1) / kMaxStoredBlock);
+    const std::uint64_t storedBits = storedChunks * (3 + 7 + 32) + static_cast<std::uint64_t>(blockSize) * 8u;
+
+    if(storedBits <= dynamicBits && storedBits <= fixedBits){
+        writeStoredBlocks(writer, blockData, blockSize, finalBlock);
+        return;
+    }
+
+    if(fixedBits <= dynamicBits){
+        writer.put(finalBlock ? 1u : 0u, 1);
+        writer.put(1u, 2);
+        writeSymbols(writer, symbols, tables.fixedLitLenCodes, tables.fixedLitLenLengths, tables.fixedDistCodes, tables.fixedDistLengths);
+        return;
+    }
+
+    std::uint16_t litLenCodes[kLitLenSymbols] = {};
+    std::uint16_t distCodes[kDistSymbols] = {};
+    std::uint16_t codeLengthCodes[kCodeLengthSymbols] = {};
+    buildCanonicalCodes(litLenLengths, kLitLenSymbols, litLenCodes);
+    buildCanonicalCodes(distLengths, kDistSymbols, distCodes);
+    buildCanonicalCodes(codeLengthLengths, kCodeLengthSymbols, codeLengthCodes);
+
+    writer.put(finalBlock ? 1u : 0u, 1);
+    writer.put(2u, 2);
+    writer.put(static_cast<std::uint32_t>(litLenCount - 257), 5);
+    writer.put(static_cast<std::uint32_t>(distCount - 1), 5);
+    writer.put(static_cast<std::uint32_t>(codeLengthCount - 4), 4);
+    for(int i = 0; i < codeLengthCount; ++i){
+        writer.put(codeLengthLengths[kCodeLengthOrder[i]], 3);
+    }
+    for(const CodeLengthToken& token : tokens){
+        writer.put(codeLengthCodes[token.symbol], codeLengthLengths[token.symbol]);
+        if(token.symbol == 16){
+            writer.put(token.extra, 2);
+        }else if(token.symbol == 17){
+            writer.put(token.extra, 3);
+        }else if(token.symbol == 18){
+            writer.put(token.extra, 7);
+        }
+    }
+    writeSymbols(writer, symbols, litLenCodes, litLenLengths, distCodes, distLengths);
+}
+
+/// @brief Holds data for MatchFinder. Hash chains over a sliding 32 KiB window.
+struct MatchFinder {
+    const std::uint8_t* data;
+    size_t size;
+    LevelParams params;
+    std::vector<std::int32_t> head;
+    std::vector<std::int32_t> prev;
+
+    MatchFinder(const std::uint8_t* input, size_t inputSize, const LevelParams& levelParams)
+        : data(input),
+          size(inputSize),
+          params(levelParams),
+          head(static_cast<size_t>(1) << kHashBits, -1),
+          prev(kWindowSize, -1) {}
+
+    std::uint32_t hashAt(size_t pos) const {
+        const std::uint32_t value = static_cast<std::uint32_t>(data[pos]) |
+                                    (static_cast<std::uint32_t>(data[pos + 1]) << 8) |
+                                    (static_cast<std::uint32_t>(data[pos + 2]) << 16);
+        return (value * 2654435761u) >> (32 - kHashBits);
+    }
+
+    void insert(size_t pos){
+        if(pos + kMinMatch > size){
+            return;
+        }
+        const std::uint32_t hash = hashAt(pos);
+        prev[pos & kWindowMask] = head[hash];
+        head[hash] = static_cast<std::int32_t>(pos);
+    }
+
+    int find(size_t pos, int& outDistance) const {
+        outDistance = 0;
+        if(pos + kMinMatch > size){
+            return 0;
+        }
+
+        const int maxLength = static_cast<int>(std::min<size_t>(kMaxMatch, size - pos));
+        const std::uint8_t* current = data + pos;
+        int bestLength = kMinMatch - 1;
+        int chain = params.maxChain;
+        std::int32_t candidate = head[hashAt(pos)];
+        const std::int64_t windowStart = static_cast<std::int64_t>(pos) - kWindowSize;
+
+        while(candidate >= 0 && candidate > windowStart && chain-- > 0){
+            const std::uint8_t* match = data + candidate;
+            if(match[bestLength] == current[bestLength] && match[0] == current[0] && match[1] == current[1]){
+                int length = 2;
+                while(length < maxLength && match[length] == current[length]){
+                    ++length;
+                }
+                if(length > bestLength){
+                    bestLength = length;
+                    outDistance = static_cast<int>(pos - static_cast<size_t>(candidate));
+                    if(length >= params.niceLength || length >= maxLength){
+                        break;
+                    }
+                }
+            }
+
+            const std::int32_t next = prev[static_cast<size_t>(candidate) & kWindowMask];
+            if(next >= candidate){
+                break; // Slot was reused by a newer position; the rest of the chain is gone.
+            }
+            candidate = next;
+        }
+
+        if(bestLength < kMinMatch){
+            outDistance = 0;
+            return 0;
+        }
+        return bestLength;
+    }
+};
+
+/// @brief Holds data for HuffmanTable. See buildDecodeTable() for the entry layout.
+struct HuffmanTable {
+    std::vector<std::uint32_t> entries;
+    int primaryBits = 0;
+};
+
+constexpr std::uint32_t kSubTableFlag = 0x80000000u;
+
+// Entries are `symbol | (length << 16)`, or `kSubTableFlag | (subBits << 16) | offset` for
+// codes longer than the primary index. Zero marks a bit pattern no code uses.
+bool buildDecodeTable(const std::uint8_t* lengths, int symbolCount, int primaryBits, HuffmanTable& outTable){
+    int lengthCounts[kMaxCodeLength + 1] = {};
+    for(int i = 0; i < symbolCount; ++i){
+        if(lengths[i] > kMaxCodeLength){
+            return false;
+        }
+        lengthCounts[lengths[i]]++;
+    }
+    lengthCounts[0] = 0;
+
+    int left = 1;
+    for(int bits = 1; bits <= kMaxCodeLength; ++bits){
+        left <<= 1;
+        left -= lengthCounts[bits];
+        if(left < 0){
+            return false; // Over-subscribed.
+        }
+    }
+
+    std::uint16_t codes[288] = {};
+    buildCanonicalCodes(lengths, symbolCount, codes);
+
+    const size_t primarySize = static_cast<size_t>(1) << primaryBits;
+    const std::uint32_t primaryMask = static_cast<std::uint32_t>(primarySize - 1);
+    std::vector<std::uint8_t> subBits(primarySize, 0);
+    for(int i = 0; i < symbolCount; ++i){
+        if(lengths[i] > primaryBits){
+            const std::uint32_t prefix = codes[i] & primaryMask;
+            subBits[prefix] = std::max<std::uint8_t>(subBits[prefix], static_cast<std::uint8_t>(lengths[i] - primaryBits));
+        }
+    }
+
+    outTable.primaryBits = primaryBits;
+    outTable.entries.assign(primarySize, 0);
+    size_t offset = primarySize;
+    for(size_t prefix = 0; prefix < primarySize; ++prefix){
+        if(subBits[prefix] > 0){
+            outTable.entries[prefix] = kSubTableFlag | (static_cast<std::uint32_t>(subBits[prefix]) << 16) | static_cast<std::uint32_t>(offset);
+            offset += static_cast<size_t>(1) << subBits[prefix];
+        }
+    }
+    outTable.entries.resize(offset, 0);
+
+    for(int i = 0; i < symbolCount; ++i){
+        const int length = lengths[i];
+        if(length == 0){
+            continue;
+        }
+        const std::uint32_t code = codes[i];
+        if(length <= primaryBits){
+            const std::uint32_t entry = static_cast<std::uint32_t>(i) | (static_cast<std::uint32_t>(length) << 16);
+            for(size_t index = code; index < primarySize; index += static_cast<size_t>(1) << length){
+                outTable.entries[index] = entry;
+            }
+            continue;
+        }
+
+        const std::uint32_t pointer = outTable.entries[code & primaryMask];
+        const int tableBits = static_cast<int>((pointer >> 16) & 0xffu);
+        const size_t tableOffset = pointer & 0xffffu;
+        const int remaining = length - primaryBits;
+        const std::uint32_t entry = static_cast<std::uint32_t>(i) | (static_cast<std::uint32_t>(remaining) << 16);
+        for(size_t index = code >> primaryBits; index < (static_cast<size_t>(1) << tableBits); index += static_cast<size_t>(1) << remaining){
+            outTable.entries[tableOffset + index] = entry;
+        }
+    }
+    return true;
+}
+
+/// @brief Holds data for FixedDecodeTables.
+struct FixedDecodeTables {
+    HuffmanTable litLen;
+    HuffmanTable dist;
+
+    FixedDecodeTables(){
+        std::uint8_t lengths[288] = {};
+        for(int i = 0; i < 288; ++i){
+            lengths[i] = (i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8;
+        }
+        buildDecodeTable(lengths, 288, kLitLenPrimaryBits, litLen);
+        std::uint8_t distLengths[32];
+        std::fill(std::begin(distLengths), std::end(distLengths), std::uint8_t(5));
+        buildDecodeTable(distLengths, 32, kDistPrimaryBits, dist);
+    }
+};
+
+const FixedDecodeTables& fixedDecodeTables(){
+    static const FixedDecodeTables tables;
+    return tables;
+}
+
+/// @brief Holds data for BitReader. Reads past the end yield zero bits and are tracked as padding.
+struct BitReader {
+    const std::uint8_t* in;
+    const std::uint8_t* end;
+    std::uint64_t bits = 0;
+    int count = 0;
+    int paddingBits = 0;
+
+    BitReader(const std::uint8_t* data, size_t size) : in(data), end(data + size) {}
+
+    void refill(){
+        while(count <= 56){
+            if(in < end){
+                bits |= static_cast<std::uint64_t>(*in++) << count;
+            }else{
+                paddingBits += 8;
+            }
+            count += 8;
+        }
+    }
+
+    bool overran() const { return count < paddingBits; }
+
+    std::uint32_t take(int length){
+        const std::uint32_t value = static_cast<std::uint32_t>(bits & ((static_cast<std::uint64_t>(1) << length) - 1u));
+        bits >>= length;
+        count -= length;
+        return value;
+    }
+
+    bool decode(const HuffmanTable& table, int& outSymbol){
+        std::uint32_t entry = table.entries[bits & ((1u << table.primaryBits) - 1u)];
+        if(entry & kSubTableFlag){
+            const int tableBits = static_cast<int>((entry >> 16) & 0xffu);
+            const size_t offset = entry & 0xffffu;
+            take(table.primaryBits);
+            entry = table.entries[offset + (bits & ((1u << tableBits) - 1u))];
+        }
+        if(entry == 0){
+            return false;
+        }
+        take(static_cast<int>((entry >> 16) & 0xffu));
+        outSymbol = static_cast<int>(entry & 0xffffu);
+        return true;
+    }
+};
+
+bool decodeDynamicTables(BitReader& reader, HuffmanTable& outLitLen, HuffmanTable& outDist){
+    reader.refill();
+    const int litLenCount = static_cast<int>(reader.take(5)) + 257;
+    const int distCount = static_cast<int>(reader.take(5)) + 1;
+    const int codeLengthCount = static_cast<int>(reader.take(4)) + 4;
+    if(litLenCount > kLitLenSymbols || distCount > kDistSymbols){
+        return false;
+    }
+
+    std::uint8_t codeLengthLengths[kCodeLengthSymbols] = {};
+    for(int i = 0; i < codeLengthCount; ++i){
+        reader.refill();
+        codeLengthLengths[kCodeLengthOrder[i]] = static_cast<std::uint8_t>(reader.take(3));
+    }
+    HuffmanTable codeLengthTable;
+    if(!buildDecodeTable(codeLengthLengths, kCodeLengthSymbols, kCodeLengthPrimaryBits, codeLengthTable)){
+        return false;
+    }
+
+    std::uint8_t lengths[kLitLenSymbols + kDistSymbols] = {};
+    const int total = litLenCount + distCount;
+    int filled = 0;
+    while(filled < total){
+        reader.refill();
+        int symbol = 0;
+        if(!reader.decode(codeLengthTable, symbol)){
+            return false;
+        }
+
+        if(symbol < 16){
+            lengths[filled++] = static_cast<std::uint8_t>(symbol);
+            continue;
+        }
+
+        std::uint8_t value = 0;
+        int repeat = 0;
+        if(symbol == 16){
+            if(filled == 0){
+                return false;
+            }
+            value = lengths[filled - 1];
+            repeat = 3 + static_cast<int>(reader.take(2));
+        }else if(symbol == 17){
+            repeat = 3 + static_cast<int>(reader.take(3));
+        }else{
+            repeat = 11 + static_cast<int>(reader.take(7));
+        }
+        if(filled + repeat > total){
+            return false;
+        }
+        std::fill(lengths + filled, lengths + filled + repeat, value);
+        filled += repeat;
+    }
+
+    if(reader.overran() || lengths[256] == 0){
+        return false;
+    }
+    return buildDecodeTable(lengths, litLenCount, kLitLenPrimaryBits, outLitLen) &&
+           buildDecodeTable(lengths + litLenCount, distCount, kDistPrimaryBits, outDist);
+}
+
+bool inflateBlock(BitReader& reader,
+                  const HuffmanTable& litLenTable,
+                  const HuffmanTable& distTable,
+                  std::uint8_t* out,
+                  size_t outSize,
+                  size_t& outPos){
+    for(;;){
+        if(reader.count < 48){
+            reader.refill();
+        }
+
+        int symbol = 0;
+        if(!reader.decode(litLenTable, symbol)){
+            return false;
+        }
+        if(symbol < 256){
+            if(outPos >= outSize){
+                return false;
+            }
+            out[outPos++] = static_cast<std::uint8_t>(symbol);
+            continue;
+        }
+        if(symbol == 256){
+            return !reader.overran();
+        }
+
+        const int lengthIndex = symbol - 257;
+        if(lengthIndex >= 29){
+            return false;
+        }
+        const size_t length = kLengthBase[lengthIndex] + reader.take(kLengthExtra[lengthIndex]);
+
+        int distSymbol = 0;
+        if(!reader.decode(distTable, distSymbol) || distSymbol >= kDistSymbols){
+            return false;
+        }
+        const size_t distance = kDistBase[distSymbol] + reader.take(kDistExtra[distSymbol]);
+        if(reader.overran() || distance > outPos || length > outSize - outPos){
+            return false;
+        }
+
+        std::uint8_t* dst = out + outPos;
+        const std::uint8_t* src = dst - distance;
+        if(distance >= length){
+            std::memcpy(dst, src, length);
+        }else{
+            for(size_t i = 0; i < length; ++i){
+                dst[i] = src[i];
+            }
+        }
+        outPos += length;
+    }
+}
+
+bool copyStoredBlock(BitReader& reader, std::uint8_t* out, size_t outSize, size_t& outPos){
+    reader.take(reader.count & 7);
+    reader.refill();
+    const std::uint32_t length = reader.take(16);
+    const std::uint32_t inverted = reader.take(16);
+    if(reader.overran() || length != (~inverted & 0xffffu) || length > outSize - outPos){
+        return false;
+    }
+
+    size_t remaining = length;
+    while(remaining > 0 && reader.count - reader.paddingBits >= 8){
+        out[outPos++] = static_cast<std::uint8_t>(reader.take(8));
+        --remaining;
+    }
+    if(remaining > 0){
+        // The bit buffer is drained; copy the rest straight from the input.
+        if(static_cast<size_t>(reader.end - reader.in) < remaining){
+            return false;
+        }
+        std::memcpy(out + outPos, reader.in, remaining);
+        reader.in += remaining;
+        outPos += remaining;
+        reader.bits = 0;
+        reader.count = 0;
+        reader.paddingBits = 0;
+    }
+    return true;
+}
+
+} // namespace
+
+namespace Deflate {
+
+void Compress(const uint8_t* data, size_t size, int level, BinaryBuffer& outData){
+    outData.clear();
+    level = std::clamp(level, MinLevel, MaxLevel);
+    outData.reserve(size / 2 + 64);
+    BitWriter writer(outData);
+
+    if(level == 0 || size < kMinMatch){
+        writeStoredBlocks(writer, data, size, true);
+        writer.alignToByte();
+        return;
+    }
+
+    MatchFinder finder(data, size, kLevelParams[level]);
+    const bool lazy = kLevelParams[level].lazy;
+    const int niceLength = kLevelParams[level].niceLength;
+
+    std::vector<Symbol> symbols;
+    symbols.reserve(kBlockSymbolLimit + 1);
+    size_t blockStart = 0;
+    size_t pos = 0;
+
+    // The lazy check searches pos + 1 early; its result is reused when pos advances there.
+    size_t cachedPos = static_cast<size_t>(-1);
+    int cachedLength = 0;
+    int cachedDistance = 0;
+
+    while(pos < size){
+        int distance = 0;
+        int length = 0;
+        if(pos == cachedPos){
+            length = cachedLength;
+            distance = cachedDistance;
+        }else{
+            length = finder.find(pos, distance);
+        }
+        finder.insert(pos);
+
+        if(lazy && length >= kMinMatch && length < niceLength && pos + 1 < size){
+            int nextDistance = 0;
+            const int nextLength = finder.find(pos + 1, nextDistance);
+            cachedPos = pos + 1;
+            cachedLength = nextLength;
+            cachedDistance = nextDistance;
+            if(nextLength > length){
+                length = 0;
+            }
+        }
+
+        if(length >= kMinMatch){
+            symbols.push_back({static_cast<std::uint16_t>(length), static_cast<std::uint16_t>(distance)});
+            const size_t matchEnd = pos + static_cast<size_t>(length);
+            if(level > 3 || length <= niceLength){
+                for(size_t p = pos + 1; p < matchEnd; ++p){
+                    finder.insert(p);
+                }
+            }
+            pos = matchEnd;
+        }else{
+            symbols.push_back({data[pos], 0});
+            ++pos;
+        }
+
+        if(symbols.size() >= kBlockSymbolLimit || pos >= size){
+            writeBlock(writer, symbols, data + blockStart, pos - blockStart, pos >= size);
+            symbols.clear();
+            blockStart = pos;
+        }
+    }
+
+    writer.alignToByte();
+}
+
+bool Decompress(const uint8_t* data, size_t size, uint8_t* outData, size_t outSize){
+    BitReader reader(data, size);
+    size_t outPos = 0;
+    HuffmanTable litLenTable;
+    HuffmanTable distTable;
+
+    for(;;){
+        reader.refill();
+        const std::uint32_t finalBlock = reader.take(1);
+        const std::uint32_t blockType = reader.take(2);
+        if(reader.overran()){
+            return false;
+        }
+
+        bool ok = false;
+        if(blockType == 0){
+            ok = copyStoredBlock(reader, outData, outSize, outPos);
+        }else if(blockType == 1){
+            const FixedDecodeTables& fixed = fixedDecodeTables();
+            ok = inflateBlock(reader, fixed.litLen, fixed.dist, outData, outSize, outPos);
+        }else if(blockType == 2){
+            ok = decodeDynamicTables(reader, litLenTable, distTable) &&
+                 inflateBlock(reader, litLenTable, distTable, outData, outSize, outPos);
+        }
+        if(!ok){
+            return false;
+        }
+        if(finalBlock){
+            break;
+        }
+    }
+
+    return outPos == outSize;
+}
+
+} // namespace Deflate
@@ -0,0 +1,43 @@
+/**
+ * @file src/Foundation/Compression/Deflate.h
+ * @brief Raw DEFLATE (RFC 1951) encoder and decoder used by CompressedFile.
+ */
+
+#ifndef FOUNDATION_COMPRESSION_DEFLATE_H
+#define FOUNDATION_COMPRESSION_DEFLATE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Foundation/Util/Types.h"
+
+namespace Deflate {
+    constexpr int MinLevel = 0;
+    constexpr int MaxLevel = 9;
+    constexpr int DefaultLevel = 6;
+
+    /**
+     * @brief Compresses bytes into a raw DEFLATE stream (no zlib or gzip wrapper).
+     *
+     * Level 0 emits stored blocks. Levels 1-9 trade speed for ratio through the match search
+     * depth; every block is written with whichever of dynamic Huffman, fixed Huffman or
+     * stored coding is smallest.
+     * @param data Input bytes.
+     * @param size Input byte count.
+     * @param level Compression level, clamped to [MinLevel, MaxLevel].
+     * @param outData Receives the compressed stream (replaced).
+     */
+    void Compress(const uint8_t* data, size_t size, int level, BinaryBuffer& outData);
+
+    /**
+     * @brief Decodes a raw DEFLATE stream whose decoded size is known up front.
+     * @param data Compressed bytes.
+     * @param size Compressed byte count.
+     * @param outData Destination buffer.
+     * @param outSize Exact decoded size expected.
+     * @return False when the stream is malformed or does not decode to exactly `outSize` bytes.
+     */
+    bool Decompress(const uint8_t* data, size_t size, uint8_t* outData, size_t outSize);
+}
+
+#endif // FOUNDATION_COMPRESSION_DEFLATE_H
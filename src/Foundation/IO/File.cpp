@@ -4,6 +4,7 @@
  */
 
 #include "Foundation/IO/File.h"
+#include "Foundation/IO/MappedFile.h"
 #include "Foundation/Logging/Logbot.h"
 #include "Foundation/Util/StringUtils.h"
 
@@ -54,6 +55,13 @@ File::File(std::string pathName, const BinaryBuffer& inMemoryData){
     this->virtualData = inMemoryData;
 }
 
+File::File(std::string pathName, BinaryBuffer&& inMemoryData){
+    this->filepath = pathName;
+    this->isVirtual = true;
+    this->hasVirtualData = true;
+    this->virtualData = std::move(inMemoryData);
+}
+
 bool File::exists(){
     if(hasVirtualData){
         return true;
@@ -235,12 +243,16 @@ FileBlob FileReader::Read(File* filePtr){
         auto fileInputStream = std::fstream(filePtr->getPath(), std::ios::in | std::ios::binary);
 
         if(fileInputStream.is_open()){
-            std::vector<unsigned char> buffer(std::istreambuf_iterator<char>(fileInputStream), {});
-            FileBlob fblob = FileBlob::Create(buffer.size());
-
-            for(int i = 0; i < buffer.size(); i++){
-                uint8_t value = buffer[i];
-                fblob.data[i] = value;
+            // Size the blob once and read straight into it.
+            fileInputStream.seekg(0, std::ios::end);
+            const std::streamoff length = fileInputStream.tellg();
+            fileInputStream.seekg(0, std::ios::beg);
+
+            FileBlob fblob;
+            if(length > 0){
+                fblob.data.resize(static_cast<size_t>(length));
+                fileInputStream.read(reinterpret_cast<char*>(fblob.data.data()), length);
+                fblob.data.resize(static_cast<size_t>(fileInputStream.gcount()));
             }
 
             fileInputStream.close();
@@ -256,6 +268,33 @@ FileBlob FileReader::Read(File* filePtr){
     throw std::runtime_error("Unable to Read File.");
 }
 
+FileBlob FileReader::Map(File* filePtr, size_t minMappedBytes){
+    if(filePtr && filePtr->isInMemoryFile()){
+        // An empty buffer yields a null view, which reads back as an empty owned blob.
+        FileBlob fblob;
+        fblob.external = ByteView(filePtr->getInMemoryData());
+        return fblob;
+    }
+
+    if(filePtr && filePtr->exists() && !filePtr->isDirectory()){
+        std::error_code ec;
+        const uintmax_t fileSize = std::filesystem::file_size(filePtr->getPath(), ec);
+        if(!ec && fileSize >= static_cast<uintmax_t>(minMappedBytes) && fileSize > 0){
+            std::string error;
+            std::shared_ptr<MappedFile> mapping = MappedFile::Open(filePtr->getPath(), &error);
+            if(mapping){
+                FileBlob fblob;
+                fblob.external = mapping->view();
+                fblob.mapping = std::move(mapping);
+                return fblob;
+            }
+            LogBot.LogVerbose(LOG_WARN, "%s; reading into memory instead.", error.c_str());
+        }
+    }
+
+    return Read(filePtr);
+}
+
 FileWriter::FileWriter(File* filePtr){
     this->filePtr = std::shared_ptr<File>(filePtr);
     if(!this->filePtr->isOpen()){
@@ -300,11 +339,11 @@ void FileWriter::appendData(uint8_t* data, int dataLength){
 }
 
 void FileWriter::writeBlob(FileBlob &blob, int offset){
-    writeData(blob.data.data(),offset,blob.size());
+    writeData(const_cast<uint8_t*>(blob.view().data()),offset,blob.size());
 }
 
 void FileWriter::appendBlob(FileBlob &blob){
-    appendData(blob.data.data(), blob.size());
+    appendData(const_cast<uint8_t*>(blob.view().data()), blob.size());
 }
 
 void FileWriter::put(const char* string){
@@ -18,6 +18,8 @@
 
 #define FILE_SEPARATOR "\\"
 
+class MappedFile;
+
 /// @brief Represents the File type.
 class File{
     private:
@@ -43,6 +45,12 @@ class File{
          * @param inMemoryData Input parameter.
          */
         File(std::string path, const BinaryBuffer& inMemoryData);
+        /**
+         * @brief Constructs a new File instance that takes ownership of in-memory data.
+         * @param path Filesystem path for path.
+         * @param inMemoryData Input parameter.
+         */
+        File(std::string path, BinaryBuffer&& inMemoryData);
         /**
          * @brief Executes exists.
          * @return True when the operation succeeds; otherwise false.
@@ -115,14 +123,38 @@ class File{
         static std::string GetCWD();
 };
 
-/// @brief Holds data for FileBlob.
+/**
+ * @brief Holds data for FileBlob.
+ *
+ * Bytes live either in `data` or, for blobs from FileReader::Map(), in `external`, which
+ * points into `mapping` or into the in-memory File the blob was mapped from. Use view() to
+ * read either kind without copying.
+ */
 struct FileBlob{
     BinaryBuffer data;
+    ByteView external;
+    std::shared_ptr<const MappedFile> mapping;
+
+    /**
+     * @brief Returns the blob bytes without copying.
+     * @return View over the blob contents.
+     */
+    ByteView view() const {
+        return isExternal() ? external : ByteView(data);
+    }
+
+    /**
+     * @brief Returns whether the bytes are borrowed rather than held in `data`.
+     * @return True for mapped or borrowed blobs.
+     */
+    bool isExternal() const {
+        return external.data() != nullptr || mapping != nullptr;
+    }
 
     // Helper to get string representation on the fly
     // This avoids storing the same data twice
     std::string asString() const {
-        return std::string(data.begin(), data.end());
+        return std::string(view().asStringView());
     }
 
     /**
@@ -130,7 +162,7 @@ struct FileBlob{
      * @return Computed numeric result.
      */
     size_t size() const {
-        return data.size();
+        return view().size();
     }
 
     /**
@@ -204,6 +236,20 @@ class FileReader{
          * @return Result of this operation.
          */
         static FileBlob Read(File *file);
+        /**
+         * @brief Returns the file bytes without copying them into the blob.
+         *
+         * Disk files at least `minMappedBytes` long are memory mapped; smaller ones are read
+         * like Read(). In-memory files are borrowed, so the blob must not outlive `file`.
+         * Only map files nothing rewrites while the blob lives: on Windows an open mapping
+         * makes truncating or replacing the file fail.
+         * @param file File to read.
+         * @param minMappedBytes Smallest file size worth mapping.
+         * @return Blob whose view() holds the file contents.
+         */
+        static FileBlob Map(File *file, size_t minMappedBytes = DefaultMinMappedBytes);
+
+        static constexpr size_t DefaultMinMappedBytes = 256 * 1024;
 };
 
 /// @brief Represents the FileWriter type.
@@ -0,0 +1,185 @@
+/**
+ * @file src/Foundation/IO/FileReadBenchmark.cpp
+ * @brief Implementation for FileReadBenchmark.
+ */
+
+#include "Foundation/IO/FileReadBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include "Foundation/IO/File.h"
+#include "Foundation/Logging/Logbot.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    double elapsedMs(const BenchClock::time_point& start){
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    // FileReader::Read() as it was before the mapped path: stream into a temporary vector,
+    // then copy it byte by byte into the blob.
+    FileBlob legacyRead(const std::string& path){
+        std::fstream stream(path, std::ios::in | std::ios::binary);
+        std::vector<unsigned char> buffer(std::istreambuf_iterator<char>(stream), {});
+        FileBlob fblob = FileBlob::Create(static_cast<int>(buffer.size()));
+        for(size_t i = 0; i < buffer.size(); i++){
+            fblob.data[i] = buffer[i];
+        }
+        return fblob;
+    }
+
+    constexpr size_t kPageBytes = 4096;
+
+    std::uint64_t checksum(const ByteView& bytes){
+        std::uint64_t hash = 1469598103934665603ull;
+        for(const std::uint8_t byte : bytes){
+            hash = (hash ^ byte) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Reads one byte per page so a mapping pays for its page faults inside the timed region.
+    std::uint8_t touchPages(const ByteView& bytes){
+        std::uint8_t sum = 0;
+        for(size_t offset = 0; offset < bytes.size(); offset += kPageBytes){
+            sum = static_cast<std::uint8_t>(sum + bytes.data()[offset]);
+        }
+        return sum;
+    }
+
+    bool dropFromCache(const std::filesystem::path& path){
+        #if defined(__linux__)
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if(fd < 0){
+                return false;
+            }
+            const bool dropped = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+            ::close(fd);
+            return dropped;
+        #else
+            (void)path;
+            return false;
+        #endif
+    }
+
+    enum class ReadPath { Legacy, Read, Map };
+
+    double timeRead(ReadPath readPath, const std::filesystem::path& path, std::uint64_t& outChecksum, size_t& outBytes){
+        const std::string pathString = path.string();
+        const BenchClock::time_point start = BenchClock::now();
+        FileBlob fblob;
+        if(readPath == ReadPath::Legacy){
+            fblob = legacyRead(pathString);
+        }else{
+            File file(pathString);
+            fblob = (readPath == ReadPath::Read) ? FileReader::Read(&file) : FileReader::Map(&file, 0);
+        }
+        volatile std::uint8_t touched = touchPages(fblob.view());
+        (void)touched;
+        const double milliseconds = elapsedMs(start);
+        outChecksum = checksum(fblob.view());
+        outBytes = fblob.view().size();
+        return milliseconds;
+    }
+
+    double megabytesPerSecond(size_t bytes, double milliseconds){
+        return (milliseconds > 0.0) ? (static_cast<double>(bytes) / (1024.0 * 1024.0)) / (milliseconds / 1000.0) : 0.0;
+    }
+}
+
+std::vector<std::filesystem::path> FileReadBenchmark::DefaultPaths(const std::filesystem::path& resRoot){
+    std::vector<std::filesystem::path> paths;
+    std::error_code ec;
+    const std::filesystem::path model = resRoot / "models" / "lucille" / "lucille4x.obj";
+    if(std::filesystem::is_regular_file(model, ec)){
+        paths.push_back(model);
+    }
+
+    std::vector<std::filesystem::path> bundles;
+    for(std::filesystem::directory_iterator it(resRoot / "bundles", ec), end; !ec && it != end; it.increment(ec)){
+        if(it->is_regular_file(ec)){
+            bundles.push_back(it->path());
+        }
+    }
+    std::sort(bundles.begin(), bundles.end());
+    paths.insert(paths.end(), bundles.begin(), bundles.end());
+    return paths;
+}
+
+FileReadBenchmark::Result FileReadBenchmark::Run(const std::vector<std::filesystem::path>& paths, int iterations){
+    Result result;
+    result.valid = !paths.empty();
+    result.coldIsUncached = true;
+    iterations = std::max(iterations, 1);
+    if(paths.empty()){
+        LogBot.Log(LOG_ERRO, "File read benchmark: no files to read.");
+        return result;
+    }
+
+    const ReadPath readPaths[] = {ReadPath::Legacy, ReadPath::Read, ReadPath::Map};
+    for(const std::filesystem::path& path : paths){
+        Sample sample;
+        sample.path = path;
+        sample.matched = true;
+        double* coldMs[] = {&sample.legacyColdMs, &sample.readColdMs, &sample.mapColdMs};
+        double* warmMs[] = {&sample.legacyWarmMs, &sample.readWarmMs, &sample.mapWarmMs};
+
+        try{
+            std::uint64_t expected = 0;
+            for(size_t p = 0; p < 3; ++p){
+                if(!dropFromCache(path)){
+                    result.coldIsUncached = false;
+                }
+                std::uint64_t sum = 0;
+                size_t bytes = 0;
+                *coldMs[p] = timeRead(readPaths[p], path, sum, bytes);
+                if(p == 0){
+                    expected = sum;
+                    sample.bytes = bytes;
+                }else if(sum != expected || bytes != sample.bytes){
+                    sample.matched = false;
+                }
+
+                *warmMs[p] = 1.0e30;
+                for(int i = 0; i < iterations; ++i){
+                    *warmMs[p] = std::min(*warmMs[p], timeRead(readPaths[p], path, sum, bytes));
+                }
+            }
+        }catch(const std::exception& e){
+            LogBot.Log(LOG_ERRO, "File read benchmark: failed to read '%s': %s", path.generic_string().c_str(), e.what());
+            result.valid = false;
+            continue;
+        }
+
+        if(!sample.matched){
+            result.valid = false;
+            LogBot.Log(LOG_ERRO, "File read benchmark: '%s' read back differently through Read() or Map().",
+                       path.generic_string().c_str());
+        }
+        LogBot.Log(LOG_INFO, "File read benchmark: %s (%.2f MiB) | cold %.2f / %.2f / %.2f ms | warm %.2f / %.2f / %.2f ms (%.0f / %.0f / %.0f MiB/s) [legacy / Read / Map]",
+                   path.filename().string().c_str(),
+                   static_cast<double>(sample.bytes) / (1024.0 * 1024.0),
+                   sample.legacyColdMs, sample.readColdMs, sample.mapColdMs,
+                   sample.legacyWarmMs, sample.readWarmMs, sample.mapWarmMs,
+                   megabytesPerSecond(sample.bytes, sample.legacyWarmMs),
+                   megabytesPerSecond(sample.bytes, sample.readWarmMs),
+                   megabytesPerSecond(sample.bytes, sample.mapWarmMs));
+        result.samples.push_back(sample);
+    }
+
+    if(!result.coldIsUncached){
+        LogBot.Log(LOG_WARN, "File read benchmark: could not evict files from the OS cache here; cold times may be cached reads.");
+    }
+    return result;
+}
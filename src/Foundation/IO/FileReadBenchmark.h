@@ -0,0 +1,56 @@
+/**
+ * @file src/Foundation/IO/FileReadBenchmark.h
+ * @brief Declarations for FileReadBenchmark.
+ */
+
+#ifndef FILE_READ_BENCHMARK_H
+#define FILE_READ_BENCHMARK_H
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+/// @brief Compares the old stream-and-copy file read against FileReader::Read() and FileReader::Map().
+namespace FileReadBenchmark {
+    /// @brief Holds data for Sample: one file read through every path.
+    struct Sample {
+        std::filesystem::path path;
+        size_t bytes = 0;
+        /// First read after the OS cache was dropped for the file (Linux only; see `coldIsUncached`).
+        double legacyColdMs = 0.0;
+        double readColdMs = 0.0;
+        double mapColdMs = 0.0;
+        /// Best of the repeated reads with the file cached.
+        double legacyWarmMs = 0.0;
+        double readWarmMs = 0.0;
+        double mapWarmMs = 0.0;
+        /// True when every path returned the same bytes.
+        bool matched = false;
+    };
+
+    /// @brief Holds data for Result.
+    struct Result {
+        std::vector<Sample> samples;
+        /// False where the platform offers no way to evict a file, so "cold" reads may be cached.
+        bool coldIsUncached = false;
+        bool valid = false;
+    };
+
+    /**
+     * @brief Returns the files the request measures: lucille4x.obj and every bundle in res/bundles.
+     * @param resRoot Directory holding the engine's `res` tree.
+     * @return Existing files, in a stable order.
+     */
+    std::vector<std::filesystem::path> DefaultPaths(const std::filesystem::path& resRoot);
+
+    /**
+     * @brief Reads each file cold and warm through all three paths, checks the bytes match
+     * and logs throughput. Every page is touched so mapped pages are really faulted in.
+     * @param paths Files to read.
+     * @param iterations Warm reads per path; the fastest one is reported.
+     * @return Measured values; `valid` is false when a file could not be read or paths disagree.
+     */
+    Result Run(const std::vector<std::filesystem::path>& paths, int iterations = 10);
+}
+
+#endif // FILE_READ_BENCHMARK_H
@@ -0,0 +1,123 @@
+/**
+ * @file src/Foundation/IO/MappedFile.cpp
+ * @brief Implementation for MappedFile.
+ */
+
+#include "Foundation/IO/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    void setMappedFileError(std::string* outError, const std::string& message){
+        if(outError){
+            *outError = message;
+        }
+    }
+}
+
+MappedFile::~MappedFile(){
+    release();
+}
+
+void MappedFile::release(){
+    #ifdef _WIN32
+        if(mappedData){
+            UnmapViewOfFile(mappedData);
+        }
+        if(mappingHandle){
+            CloseHandle(static_cast<HANDLE>(mappingHandle));
+        }
+        if(fileHandle){
+            CloseHandle(static_cast<HANDLE>(fileHandle));
+        }
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+    #else
+        if(mappedData){
+            munmap(const_cast<uint8_t*>(mappedData), mappedSize);
+        }
+    #endif
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
+std::shared_ptr<MappedFile> MappedFile::Open(const std::string& path, std::string* outError){
+    std::shared_ptr<MappedFile> mapping(new MappedFile());
+
+    #ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                  nullptr);
+        if(file == INVALID_HANDLE_VALUE){
+            setMappedFileError(outError, "Failed to open file for mapping: " + path);
+            return nullptr;
+        }
+        mapping->fileHandle = file;
+
+        LARGE_INTEGER fileSize{};
+        if(!GetFileSizeEx(file, &fileSize)){
+            setMappedFileError(outError, "Failed to query file size: " + path);
+            return nullptr;
+        }
+        if(fileSize.QuadPart == 0){
+            // Windows refuses to map empty files; an empty view is the correct result.
+            return mapping;
+        }
+
+        HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(!fileMapping){
+            setMappedFileError(outError, "Failed to create file mapping: " + path);
+            return nullptr;
+        }
+        mapping->mappingHandle = fileMapping;
+
+        void* view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        if(!view){
+            setMappedFileError(outError, "Failed to map view of file: " + path);
+            return nullptr;
+        }
+        mapping->mappedData = static_cast<const uint8_t*>(view);
+        mapping->mappedSize = static_cast<size_t>(fileSize.QuadPart);
+    #else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0){
+            setMappedFileError(outError, "Failed to open file for mapping: " + path);
+            return nullptr;
+        }
+
+        struct stat fileStat{};
+        if(fstat(fd, &fileStat) != 0){
+            ::close(fd);
+            setMappedFileError(outError, "Failed to query file size: " + path);
+            return nullptr;
+        }
+        if(fileStat.st_size == 0){
+            ::close(fd);
+            return mapping;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps its own reference to the file.
+        if(view == MAP_FAILED){
+            setMappedFileError(outError, "Failed to map file: " + path);
+            return nullptr;
+        }
+        madvise(view, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+        mapping->mappedData = static_cast<const uint8_t*>(view);
+        mapping->mappedSize = static_cast<size_t>(fileStat.st_size);
+    #endif
+
+    return mapping;
+}
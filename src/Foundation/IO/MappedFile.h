@@ -0,0 +1,58 @@
+/**
+ * @file src/Foundation/IO/MappedFile.h
+ * @brief Declarations for MappedFile.
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Foundation/Util/Types.h"
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The mapping stays valid for the lifetime of the object; views returned by view() must not
+ * outlive it. Share it through std::shared_ptr when several owners hand out views.
+ */
+class MappedFile{
+    private:
+        const uint8_t* mappedData = nullptr;
+        size_t mappedSize = 0;
+        #ifdef _WIN32
+            void* fileHandle = nullptr;
+            void* mappingHandle = nullptr;
+        #endif
+
+        MappedFile() = default;
+        void release();
+
+    public:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        /**
+         * @brief Destroys this MappedFile instance and unmaps the file.
+         */
+        ~MappedFile();
+
+        /**
+         * @brief Maps a file for reading.
+         * @param path Filesystem path of the file.
+         * @param outError Output value for error.
+         * @return Mapping, or null when the file cannot be opened or mapped.
+         */
+        static std::shared_ptr<MappedFile> Open(const std::string& path, std::string* outError = nullptr);
+
+        /**
+         * @brief Returns the mapped bytes.
+         * @return View over the whole file; empty for zero-length files.
+         */
+        ByteView view() const { return ByteView(mappedData, mappedSize); }
+        size_t size() const { return mappedSize; }
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,110 @@
+/**
+ * @file src/Foundation/Threading/SnapshotRing.h
+ * @brief Declarations for SnapshotRing.
+ */
+
+#ifndef SNAPSHOT_RING_H
+#define SNAPSHOT_RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Lock-free slot handoff between one writer thread and one reader thread.
+ *
+ * The ring only trades slot indices; callers keep the storage in an array of
+ * SLOT_COUNT entries. At any time the writer owns one slot, one slot sits in the shared
+ * mailbox, and the reader owns the HISTORY newest slots it has acquired. publish() and
+ * acquire() are a single atomic exchange each, so neither side ever waits and no slot is
+ * touched by both threads at once. When the writer publishes faster than the reader
+ * acquires, unread frames are recycled instead of queued.
+ *
+ * Only the slots themselves are handed off. Anything a slot refers to by index (such as
+ * Scene's snapshot mesh and material tables) is not versioned per slot and still needs
+ * the two threads to be serialized by the caller.
+ *
+ * @tparam HISTORY Number of published slots the reader keeps (2 allows interpolation).
+ */
+template<size_t HISTORY = 2>
+class SnapshotRing {
+        static_assert(HISTORY >= 1, "SnapshotRing needs at least one reader slot");
+
+    public:
+        /// @brief Total slots the caller must provide storage for.
+        static constexpr size_t SLOT_COUNT = HISTORY + 2;
+        /// @brief Returned by readIndex() when the reader does not hold a slot of that age yet.
+        static constexpr size_t INVALID_INDEX = SLOT_COUNT;
+
+        SnapshotRing(){
+            for(size_t i = 0; i < HISTORY; ++i){
+                held[i] = i + 2;
+            }
+        }
+
+        SnapshotRing(const SnapshotRing&) = delete;
+        SnapshotRing& operator=(const SnapshotRing&) = delete;
+
+        /**
+         * @brief Returns the slot the writer may fill. Writer thread only.
+         * @return Slot index.
+         */
+        size_t writeIndex() const { return writeSlot; }
+
+        /**
+         * @brief Hands the filled write slot to the reader and takes a free slot back. Writer thread only.
+         *
+         * Release ordering makes every write to the slot visible to the acquiring reader.
+         */
+        void publish(){
+            const std::uint32_t previous = mailbox.exchange(
+                static_cast<std::uint32_t>(writeSlot) | FRESH_BIT,
+                std::memory_order_acq_rel
+            );
+            writeSlot = previous & INDEX_MASK;
+        }
+
+        /**
+         * @brief Takes the newest published slot, if any, and returns the oldest held one. Reader thread only.
+         * @return True when a new slot was acquired.
+         */
+        bool acquire(){
+            if((mailbox.load(std::memory_order_acquire) & FRESH_BIT) == 0){
+                return false;
+            }
+
+            const std::uint32_t previous = mailbox.exchange(
+                static_cast<std::uint32_t>(held[HISTORY - 1]),
+                std::memory_order_acq_rel
+            );
+            for(size_t i = HISTORY - 1; i > 0; --i){
+                held[i] = held[i - 1];
+            }
+            held[0] = previous & INDEX_MASK;
+            if(heldCount < HISTORY){
+                heldCount++;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns a held slot by age. Reader thread only.
+         * @param age 0 for the newest acquired slot, 1 for the one before it, and so on.
+         * @return Slot index, or INVALID_INDEX when fewer than `age + 1` slots were acquired.
+         */
+        size_t readIndex(size_t age = 0) const {
+            return (age < heldCount) ? held[age] : INVALID_INDEX;
+        }
+
+    private:
+        static constexpr std::uint32_t FRESH_BIT = 0x80000000u;
+        static constexpr std::uint32_t INDEX_MASK = 0x7FFFFFFFu;
+
+        std::atomic<std::uint32_t> mailbox{1};
+        size_t writeSlot = 0;
+        std::array<size_t, HISTORY> held{};
+        size_t heldCount = 0;
+};
+
+#endif // SNAPSHOT_RING_H
@@ -0,0 +1,437 @@
+/**
+ * @file src/Foundation/Threading/WorkerPool.cpp
+ * @brief Implementation for WorkerPool.
+ */
+
+#include "Foundation/Threading/WorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <utility>
+
+#include "Foundation/Logging/Logbot.h"
+
+namespace {
+    // Failed pops before an idle worker sleeps, and before a waiting caller backs off.
+    constexpr int kIdleSpinCount = 64;
+    constexpr auto kWaitBackoff = std::chrono::microseconds(100);
+
+    // Set on worker threads so submissions from inside a job land on that worker's own deque.
+    thread_local const WorkerPool* t_workerPool = nullptr;
+    thread_local size_t t_workerIndex = 0;
+
+    /// @brief Shared state for one parallelFor() call, kept alive by late helper tasks.
+    struct ParallelForState {
+        const std::function<void(size_t, size_t, size_t)>* fn = nullptr;
+        size_t count = 0;
+        size_t grainSize = 1;
+        size_t chunkCount = 0;
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<size_t> completedChunks{0};
+        std::mutex doneMutex;
+        std::condition_variable doneCv;
+        std::exception_ptr firstError;
+    };
+
+    // Claims and runs chunks until none are left. Returns once this thread has no more work.
+    void drainChunks(const std::shared_ptr<ParallelForState>& state){
+        for(;;){
+            const size_t chunk = state->nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if(chunk >= state->chunkCount){
+                return;
+            }
+
+            const size_t begin = chunk * state->grainSize;
+            const size_t end = std::min(state->count, begin + state->grainSize);
+            try{
+                (*state->fn)(chunk, begin, end);
+            }catch(...){
+                std::lock_guard<std::mutex> lock(state->doneMutex);
+                if(!state->firstError){
+                    state->firstError = std::current_exception();
+                }
+            }
+
+            if(state->completedChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == state->chunkCount){
+                std::lock_guard<std::mutex> lock(state->doneMutex);
+                state->doneCv.notify_all();
+            }
+        }
+    }
+}
+
+WorkerPool::WorkerPool(size_t workerCount){
+    start(workerCount);
+}
+
+WorkerPool::~WorkerPool(){
+    stop();
+}
+
+WorkerPool& WorkerPool::Instance(){
+    static WorkerPool instance;
+    return instance;
+}
+
+size_t WorkerPool::ChunkCount(size_t count, size_t grainSize){
+    grainSize = std::max<size_t>(grainSize, 1);
+    return (count + grainSize - 1) / grainSize;
+}
+
+void WorkerPool::start(size_t workerCount){
+    if(!workers.empty()){
+        return;
+    }
+    if(workerCount == 0){
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = (hardwareThreads > 1) ? static_cast<size_t>(hardwareThreads - 1) : 1;
+    }
+
+    stopping.store(false, std::memory_order_relaxed);
+    workerQueues.clear();
+    workerQueues.reserve(workerCount);
+    for(size_t i = 0; i < workerCount; ++i){
+        workerQueues.push_back(std::make_unique<JobQueue>());
+    }
+
+    workers.reserve(workerCount);
+    for(size_t i = 0; i < workerCount; ++i){
+        workers.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+void WorkerPool::stop(){
+    if(!workers.empty()){
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping.store(true, std::memory_order_seq_cst);
+        }
+        wakeCv.notify_all();
+        for(auto& worker : workers){
+            if(worker.joinable()){
+                worker.join();
+            }
+        }
+        workers.clear();
+        workerQueues.clear();
+    }
+
+    std::deque<Job> droppedJobs;
+    {
+        std::lock_guard<std::mutex> lock(mainThreadQueue.mutex);
+        droppedJobs.swap(mainThreadQueue.jobs);
+    }
+    if(!droppedJobs.empty()){
+        LogBot.Log(LOG_WARN, "WorkerPool::stop() dropped %llu main-thread job(s).",
+                   static_cast<unsigned long long>(droppedJobs.size()));
+    }
+    for(Job& job : droppedJobs){
+        finishJob(job.counter);
+    }
+}
+
+void WorkerPool::push(Job job){
+    // Counted before it is visible so queuedJobs never drops below the jobs actually queued.
+    // Paired with the sleeping count a worker raises before checking queuedJobs, so either the
+    // worker sees this job or this thread sees the sleeper.
+    queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+    JobQueue& queue = (t_workerPool == this) ? *workerQueues[t_workerIndex] : injectQueue;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    if(sleepingWorkers.load(std::memory_order_seq_cst) > 0){
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+        }
+        wakeCv.notify_one();
+    }
+}
+
+bool WorkerPool::tryPop(Job& outJob){
+    if(queuedJobs.load(std::memory_order_acquire) == 0){
+        return false;
+    }
+
+    const bool isWorker = (t_workerPool == this);
+    const size_t queueCount = workerQueues.size();
+    if(isWorker){
+        JobQueue& own = *workerQueues[t_workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if(!own.jobs.empty()){
+            outJob = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(injectQueue.mutex);
+        if(!injectQueue.jobs.empty()){
+            outJob = std::move(injectQueue.jobs.front());
+            injectQueue.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Steal the oldest job from the next busy worker, starting past our own deque.
+    const size_t first = isWorker ? (t_workerIndex + 1) : 0;
+    for(size_t i = 0; i < queueCount; ++i){
+        const size_t victim = (first + i) % queueCount;
+        if(isWorker && victim == t_workerIndex){
+            continue;
+        }
+        JobQueue& queue = *workerQueues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.jobs.empty()){
+            outJob = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            stolenJobs.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkerPool::runJob(Job& job){
+    job.task();
+    job.task = nullptr;
+    executedJobs.fetch_add(1, std::memory_order_relaxed);
+    finishJob(job.counter);
+}
+
+void WorkerPool::finishJob(Counter* counter){
+    if(!counter){
+        return;
+    }
+    int pending = counter->pending.load(std::memory_order_relaxed);
+    while(pending > 1){
+        if(counter->pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel)){
+            return;
+        }
+    }
+
+    // The last job drops the count under the lock, so wait() cannot return and let the
+    // counter be destroyed while its continuations are still being taken.
+    std::vector<std::pair<std::function<void()>, Counter*>> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->continuationMutex);
+        if(counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1){
+            return;
+        }
+        ready.swap(counter->continuations);
+    }
+    // The continuations already hold a reference on their own counters from continueWith().
+    for(auto& continuation : ready){
+        if(workers.empty()){
+            Job job{std::move(continuation.first), continuation.second};
+            runJob(job);
+        }else{
+            push(Job{std::move(continuation.first), continuation.second});
+        }
+    }
+}
+
+void WorkerPool::workerLoop(size_t workerIndex){
+    t_workerPool = this;
+    t_workerIndex = workerIndex;
+
+    int idleSpins = 0;
+    for(;;){
+        Job job;
+        if(tryPop(job)){
+            idleSpins = 0;
+            runJob(job);
+            continue;
+        }
+        if(++idleSpins < kIdleSpinCount){
+            std::this_thread::yield();
+            continue;
+        }
+        idleSpins = 0;
+
+        sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCv.wait(lock, [this](){
+                return stopping.load(std::memory_order_relaxed) ||
+                       queuedJobs.load(std::memory_order_seq_cst) > 0;
+            });
+        }
+        sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+
+        if(stopping.load(std::memory_order_relaxed) && queuedJobs.load(std::memory_order_acquire) == 0){
+            return;
+        }
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task, Counter* counter){
+    if(!task){
+        return;
+    }
+    if(counter){
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job job{std::move(task), counter};
+    if(workers.empty()){
+        runJob(job);
+        return;
+    }
+    push(std::move(job));
+}
+
+void WorkerPool::continueWith(Counter& dependency, std::function<void()> task, Counter* counter){
+    if(!task){
+        return;
+    }
+    if(counter){
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        // finishJob() takes this lock after the count reaches zero, so a continuation is either
+        // registered before that swap or sees the finished count here.
+        std::lock_guard<std::mutex> lock(dependency.continuationMutex);
+        if(dependency.pending.load(std::memory_order_acquire) != 0){
+            dependency.continuations.emplace_back(std::move(task), counter);
+            return;
+        }
+    }
+
+    Job job{std::move(task), counter};
+    if(workers.empty()){
+        runJob(job);
+        return;
+    }
+    push(std::move(job));
+}
+
+void WorkerPool::wait(Counter& counter){
+    const bool onMainThread = isMainThread();
+    int idleSpins = 0;
+    while(!counter.isDone()){
+        Job job;
+        if(tryPop(job)){
+            runJob(job);
+            idleSpins = 0;
+            continue;
+        }
+        if(onMainThread && runMainThreadJobs(1) > 0){
+            idleSpins = 0;
+            continue;
+        }
+        if(++idleSpins < kIdleSpinCount){
+            std::this_thread::yield();
+        }else{
+            std::this_thread::sleep_for(kWaitBackoff);
+        }
+    }
+
+    // Let the job that finished the counter release its lock before the caller may destroy it.
+    std::lock_guard<std::mutex> lock(counter.continuationMutex);
+}
+
+void WorkerPool::submitMainThread(std::function<void()> task, Counter* counter){
+    if(!task){
+        return;
+    }
+    if(counter){
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(mainThreadQueue.mutex);
+    mainThreadQueue.jobs.push_back(Job{std::move(task), counter});
+}
+
+void WorkerPool::setMainThread(){
+    mainThreadId.store(std::this_thread::get_id(), std::memory_order_release);
+}
+
+bool WorkerPool::isMainThread() const{
+    return mainThreadId.load(std::memory_order_acquire) == std::this_thread::get_id();
+}
+
+size_t WorkerPool::runMainThreadJobs(size_t maxJobs){
+    if(!isMainThread()){
+        return 0;
+    }
+
+    std::deque<Job> batch;
+    {
+        std::lock_guard<std::mutex> lock(mainThreadQueue.mutex);
+        if(maxJobs >= mainThreadQueue.jobs.size()){
+            batch.swap(mainThreadQueue.jobs);
+        }else{
+            for(size_t i = 0; i < maxJobs; ++i){
+                batch.push_back(std::move(mainThreadQueue.jobs.front()));
+                mainThreadQueue.jobs.pop_front();
+            }
+        }
+    }
+
+    // Jobs queued while this batch runs wait for the next call, so one frame cannot spin forever.
+    for(Job& job : batch){
+        job.task();
+        mainThreadJobs.fetch_add(1, std::memory_order_relaxed);
+        finishJob(job.counter);
+    }
+    return batch.size();
+}
+
+WorkerPool::Stats WorkerPool::getStats() const{
+    Stats stats;
+    stats.executed = executedJobs.load(std::memory_order_relaxed);
+    stats.stolen = stolenJobs.load(std::memory_order_relaxed);
+    stats.mainThreadExecuted = mainThreadJobs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void WorkerPool::parallelFor(size_t count,
+                             size_t grainSize,
+                             const std::function<void(size_t chunkIndex, size_t begin, size_t end)>& fn){
+    if(count == 0 || !fn){
+        return;
+    }
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    const size_t chunkCount = ChunkCount(count, grainSize);
+    if(chunkCount == 1 || workers.empty()){
+        for(size_t chunk = 0; chunk < chunkCount; ++chunk){
+            const size_t begin = chunk * grainSize;
+            fn(chunk, begin, std::min(count, begin + grainSize));
+        }
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->fn = &fn;
+    state->count = count;
+    state->grainSize = grainSize;
+    state->chunkCount = chunkCount;
+
+    // Helpers claim chunks from the shared counter; ones that start after the range is done return at once.
+    const size_t helperCount = std::min(workers.size(), chunkCount - 1);
+    for(size_t i = 0; i < helperCount; ++i){
+        push(Job{[state](){ drainChunks(state); }, nullptr});
+    }
+
+    drainChunks(state);
+
+    {
+        std::unique_lock<std::mutex> lock(state->doneMutex);
+        state->doneCv.wait(lock, [&state](){
+            return state->completedChunks.load(std::memory_order_acquire) == state->chunkCount;
+        });
+    }
+
+    if(state->firstError){
+        std::rethrow_exception(state->firstError);
+    }
+}
@@ -0,0 +1,229 @@
+/**
+ * @file src/Foundation/Threading/WorkerPool.h
+ * @brief Declarations for WorkerPool.
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Work-stealing job scheduler for CPU-side engine work.
+ *
+ * Every worker owns a deque: jobs submitted from a worker go to the back of its own deque
+ * and are popped newest first, while idle workers steal the oldest jobs from the front of
+ * other deques. Jobs submitted from other threads enter a shared injection queue. Jobs can
+ * be tracked with a Counter, which callers wait on or chain continuations to. Main-thread
+ * jobs are held until the thread registered with setMainThread() (the GL thread) drains them.
+ *
+ * The calling thread always participates in parallelFor() and wait(), so nested or
+ * re-entrant use cannot deadlock even when every worker is busy.
+ */
+class WorkerPool {
+    public:
+        /**
+         * @brief Dependency counter for a group of jobs.
+         *
+         * Each job submitted against a counter raises it on submit and lowers it when the job
+         * returns. Continuations registered with continueWith() are submitted once it reaches zero.
+         * A counter must outlive every job and continuation that references it; destroy it only
+         * after WorkerPool::wait() returned for it.
+         */
+        class Counter {
+            public:
+                Counter() = default;
+                Counter(const Counter&) = delete;
+                Counter& operator=(const Counter&) = delete;
+
+                /**
+                 * @brief Returns whether every job tracked by this counter finished.
+                 * @return True when no tracked job is pending.
+                 */
+                bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+            private:
+                friend class WorkerPool;
+
+                std::atomic<int> pending{0};
+                std::mutex continuationMutex;
+                std::vector<std::pair<std::function<void()>, Counter*>> continuations;
+        };
+
+        /// @brief Holds data for Stats.
+        struct Stats {
+            std::uint64_t executed = 0;
+            std::uint64_t stolen = 0;
+            std::uint64_t mainThreadExecuted = 0;
+        };
+
+        /**
+         * @brief Constructs a stopped pool; start() launches its workers.
+         */
+        WorkerPool() = default;
+        /**
+         * @brief Constructs and starts a pool.
+         * @param workerCount Background thread count, or 0 to use hardware concurrency minus one.
+         */
+        explicit WorkerPool(size_t workerCount);
+        /**
+         * @brief Stops and joins all workers.
+         */
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /**
+         * @brief Returns the process-wide engine pool.
+         *
+         * GameEngine starts it before the render thread and stops it after shutdown. Until then
+         * it has no workers and every call runs inline on the caller.
+         * @return Shared pool instance.
+         */
+        static WorkerPool& Instance();
+
+        /**
+         * @brief Launches the worker threads. Does nothing if already running.
+         * @param workerCount Background thread count, or 0 to use hardware concurrency minus one.
+         */
+        void start(size_t workerCount = 0);
+        /**
+         * @brief Runs every queued worker job, then joins the workers.
+         *
+         * Main-thread jobs that were never drained are dropped and release their counters.
+         * No thread may submit work while the pool is stopping.
+         */
+        void stop();
+
+        /**
+         * @brief Returns the number of background worker threads.
+         * @return Worker count (the caller thread is not included).
+         */
+        size_t getWorkerCount() const { return workers.size(); }
+
+        /**
+         * @brief Runs `fn` over `[0, count)` split into chunks of at most `grainSize` indices.
+         *
+         * Blocks until every chunk completed. The first exception thrown by a chunk is
+         * rethrown on the calling thread after all chunks finished.
+         * @param count Number of indices.
+         * @param grainSize Maximum indices per chunk (0 is treated as 1).
+         * @param fn Callback receiving `(chunkIndex, begin, end)`.
+         */
+        void parallelFor(size_t count,
+                         size_t grainSize,
+                         const std::function<void(size_t chunkIndex, size_t begin, size_t end)>& fn);
+
+        /**
+         * @brief Returns the chunk count parallelFor() will use for a range.
+         * @param count Number of indices.
+         * @param grainSize Maximum indices per chunk.
+         * @return Chunk count.
+         */
+        static size_t ChunkCount(size_t count, size_t grainSize);
+
+        /**
+         * @brief Queues a job for any worker; runs it inline when the pool has no workers.
+         *
+         * Jobs must not let exceptions escape; report failures through their own result channel.
+         * @param task Job to run.
+         * @param counter Optional counter raised now and lowered when the job returns.
+         */
+        void submit(std::function<void()> task, Counter* counter = nullptr);
+
+        /**
+         * @brief Submits `task` once every job tracked by `dependency` finished.
+         *
+         * Runs through submit() immediately when `dependency` is already done.
+         * @param dependency Counter to wait for.
+         * @param task Continuation job.
+         * @param counter Optional counter raised now and lowered when the continuation returns.
+         */
+        void continueWith(Counter& dependency, std::function<void()> task, Counter* counter = nullptr);
+
+        /**
+         * @brief Blocks until `counter` is done, running queued jobs in the meantime.
+         *
+         * On the main thread, pending main-thread jobs are drained as well.
+         * @param counter Counter to wait for.
+         */
+        void wait(Counter& counter);
+
+        /**
+         * @brief Queues a job that must run on the main (GL) thread.
+         * @param task Job to run.
+         * @param counter Optional counter raised now and lowered when the job returns.
+         */
+        void submitMainThread(std::function<void()> task, Counter* counter = nullptr);
+
+        /**
+         * @brief Registers the calling thread as the one that runs main-thread jobs.
+         */
+        void setMainThread();
+
+        /**
+         * @brief Returns whether the caller is the registered main thread.
+         * @return True on the main thread.
+         */
+        bool isMainThread() const;
+
+        /**
+         * @brief Runs main-thread jobs queued before this call. Main thread only.
+         * @param maxJobs Upper bound on jobs run by this call.
+         * @return Number of jobs run.
+         */
+        size_t runMainThreadJobs(size_t maxJobs = static_cast<size_t>(-1));
+
+        /**
+         * @brief Returns totals since the pool was constructed.
+         * @return Job counters.
+         */
+        Stats getStats() const;
+
+    private:
+        /// @brief Holds data for Job.
+        struct Job {
+            std::function<void()> task;
+            Counter* counter = nullptr;
+        };
+
+        /// @brief Holds data for JobQueue.
+        struct JobQueue {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        void workerLoop(size_t workerIndex);
+        void push(Job job);
+        bool tryPop(Job& outJob);
+        void runJob(Job& job);
+        void finishJob(Counter* counter);
+
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<JobQueue>> workerQueues;
+        JobQueue injectQueue;
+        JobQueue mainThreadQueue;
+        std::atomic<size_t> queuedJobs{0};
+        std::atomic<size_t> sleepingWorkers{0};
+        std::mutex wakeMutex;
+        std::condition_variable wakeCv;
+        std::atomic<bool> stopping{false};
+        std::atomic<std::thread::id> mainThreadId{};
+
+        std::atomic<std::uint64_t> executedJobs{0};
+        std::atomic<std::uint64_t> stolenJobs{0};
+        std::atomic<std::uint64_t> mainThreadJobs{0};
+};
+
+#endif // WORKER_POOL_H
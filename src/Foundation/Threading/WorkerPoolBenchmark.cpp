@@ -0,0 +1,137 @@
+/**
+ * @file src/Foundation/Threading/WorkerPoolBenchmark.cpp
+ * @brief Implementation for WorkerPoolBenchmark.
+ */
+
+#include "Foundation/Threading/WorkerPoolBenchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "Foundation/Logging/Logbot.h"
+#include "Foundation/Threading/WorkerPool.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    constexpr size_t kEmptyJobCount = 200000;
+    constexpr size_t kNestedFanOut = 64;
+    constexpr size_t kTrivialChunkCount = 100000;
+    constexpr size_t kScalingItemCount = 1u << 22;
+    constexpr size_t kScalingGrainSize = 4096;
+    constexpr int kScalingRepeats = 3;
+
+    double elapsedMs(const BenchClock::time_point& start){
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    // Enough arithmetic per item that the scaling run measures compute, not memory bandwidth.
+    float scalingKernel(size_t index){
+        float value = static_cast<float>(index & 1023u) * 0.001f;
+        for(int i = 0; i < 16; ++i){
+            value = std::sqrt(value * value + 1.0f) * 0.5f;
+        }
+        return value;
+    }
+
+    double measureScaling(size_t workerCount, std::vector<float>& output){
+        WorkerPool pool(workerCount);
+        double best = 0.0;
+        for(int repeat = 0; repeat < kScalingRepeats; ++repeat){
+            const auto start = BenchClock::now();
+            pool.parallelFor(output.size(), kScalingGrainSize, [&](size_t, size_t begin, size_t end){
+                for(size_t i = begin; i < end; ++i){
+                    output[i] = scalingKernel(i);
+                }
+            });
+            const double ms = elapsedMs(start);
+            if(repeat == 0 || ms < best){
+                best = ms;
+            }
+        }
+        return best;
+    }
+}
+
+WorkerPoolBenchmark::Result WorkerPoolBenchmark::Run(size_t maxWorkers){
+    if(maxWorkers == 0){
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        maxWorkers = (hardwareThreads > 1) ? static_cast<size_t>(hardwareThreads - 1) : 1;
+    }
+
+    Result result;
+    result.workerCount = maxWorkers;
+    {
+        WorkerPool pool(maxWorkers);
+        std::atomic<size_t> sink{0};
+
+        {
+            WorkerPool::Counter counter;
+            const auto start = BenchClock::now();
+            for(size_t i = 0; i < kEmptyJobCount; ++i){
+                pool.submit([&sink](){ sink.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            }
+            pool.wait(counter);
+            result.submitNsPerJob = elapsedMs(start) * 1000000.0 / static_cast<double>(kEmptyJobCount);
+        }
+
+        {
+            // Each root job fans out from a worker, so children go to that worker's deque and get stolen.
+            WorkerPool::Counter counter;
+            const size_t rootCount = kEmptyJobCount / kNestedFanOut;
+            const auto start = BenchClock::now();
+            for(size_t root = 0; root < rootCount; ++root){
+                pool.submit([&pool, &sink, &counter](){
+                    for(size_t i = 0; i < kNestedFanOut; ++i){
+                        pool.submit([&sink](){ sink.fetch_add(1, std::memory_order_relaxed); }, &counter);
+                    }
+                }, &counter);
+            }
+            pool.wait(counter);
+            result.nestedNsPerJob = elapsedMs(start) * 1000000.0 / static_cast<double>(rootCount * (kNestedFanOut + 1));
+        }
+
+        {
+            const auto start = BenchClock::now();
+            pool.parallelFor(kTrivialChunkCount, 1, [&sink](size_t, size_t begin, size_t){
+                sink.fetch_add(begin & 1u, std::memory_order_relaxed);
+            });
+            result.parallelForNsPerChunk = elapsedMs(start) * 1000000.0 / static_cast<double>(kTrivialChunkCount);
+        }
+    }
+
+    // Powers of two, plus the full pool size when it is not one.
+    std::vector<size_t> workerCounts;
+    for(size_t workers = 1; workers < maxWorkers; workers *= 2){
+        workerCounts.push_back(workers);
+    }
+    workerCounts.push_back(maxWorkers);
+
+    std::vector<float> output(kScalingItemCount, 0.0f);
+    double baselineMs = 0.0;
+    for(size_t workers : workerCounts){
+        ScalingSample sample;
+        sample.workerCount = workers;
+        sample.milliseconds = measureScaling(workers, output);
+        if(result.scaling.empty()){
+            baselineMs = sample.milliseconds;
+        }
+        sample.speedup = (sample.milliseconds > 0.0) ? (baselineMs / sample.milliseconds) : 0.0;
+        result.scaling.push_back(sample);
+    }
+
+    LogBot.Log(LOG_INFO, "WorkerPool benchmark (%llu workers): submit %.1f ns/job | nested %.1f ns/job | parallelFor %.1f ns/chunk",
+               static_cast<unsigned long long>(result.workerCount),
+               result.submitNsPerJob,
+               result.nestedNsPerJob,
+               result.parallelForNsPerChunk);
+    for(const ScalingSample& sample : result.scaling){
+        LogBot.Log(LOG_INFO, "WorkerPool scaling: %llu worker(s) %.2f ms (x%.2f)",
+                   static_cast<unsigned long long>(sample.workerCount),
+                   sample.milliseconds,
+                   sample.speedup);
+    }
+    return result;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file src/Foundation/Threading/WorkerPoolBenchmark.h
+ * @brief Declarations for WorkerPoolBenchmark.
+ */
+
+#ifndef WORKER_POOL_BENCHMARK_H
+#define WORKER_POOL_BENCHMARK_H
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Microbenchmarks for WorkerPool scheduling overhead and scaling.
+namespace WorkerPoolBenchmark {
+    /// @brief Holds data for ScalingSample: one parallelFor run at a given worker count.
+    struct ScalingSample {
+        size_t workerCount = 0;
+        double milliseconds = 0.0;
+        double speedup = 1.0;
+    };
+
+    /// @brief Holds data for Result.
+    struct Result {
+        size_t workerCount = 0;
+        /// Submit-to-completion cost of an empty job, from a non-worker thread.
+        double submitNsPerJob = 0.0;
+        /// Cost of an empty job submitted from inside a job, onto a worker's own deque.
+        double nestedNsPerJob = 0.0;
+        /// Cost per chunk of a parallelFor with trivial chunks.
+        double parallelForNsPerChunk = 0.0;
+        /// Fixed CPU-bound workload, from one worker up to workerCount.
+        std::vector<ScalingSample> scaling;
+    };
+
+    /**
+     * @brief Runs every benchmark on private pools and logs a summary.
+     * @param maxWorkers Largest pool size to measure, or 0 for hardware concurrency minus one.
+     * @return Measured values.
+     */
+    Result Run(size_t maxWorkers = 0);
+}
+
+#endif // WORKER_POOL_BENCHMARK_H
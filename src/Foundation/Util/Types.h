@@ -7,11 +7,45 @@
 #define TYPES_H
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string_view>
 
 typedef std::vector<uint8_t> BinaryBuffer;
 
+/// @brief Non-owning view over a contiguous byte range. The owner must outlive the view.
+struct ByteView{
+    const uint8_t* ptr = nullptr;
+    size_t length = 0;
+
+    ByteView() = default;
+    ByteView(const uint8_t* data, size_t size) : ptr(data), length(size) {};
+    ByteView(const BinaryBuffer& buffer) : ptr(buffer.data()), length(buffer.size()) {};
+
+    const uint8_t* data() const { return ptr; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    const uint8_t* begin() const { return ptr; }
+    const uint8_t* end() const { return ptr + length; }
+
+    /**
+     * @brief Returns the bytes as text without copying.
+     * @return String view over the same bytes.
+     */
+    std::string_view asStringView() const {
+        return std::string_view(reinterpret_cast<const char*>(ptr), length);
+    }
+
+    /**
+     * @brief Copies the bytes into an owning buffer.
+     * @return Copied bytes.
+     */
+    BinaryBuffer toBuffer() const {
+        return (length > 0) ? BinaryBuffer(ptr, ptr + length) : BinaryBuffer();
+    }
+};
+
 
 /// @brief Represents the Nullable type.
 template<typename T>
@@ -0,0 +1,312 @@
+/**
+ * @file src/Rendering/Core/BoundsBVH.cpp
+ * @brief Implementation for BoundsBVH.
+ */
+
+#include "Rendering/Core/BoundsBVH.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Rendering/Core/FrustumCulling.h"
+
+namespace {
+    constexpr std::uint32_t kMaxLeafItems = 4;
+    // Refitting keeps topology, so boxes that drift apart inflate the tree; rebuild past this growth.
+    constexpr float kRebuildSurfaceAreaRatio = 1.6f;
+
+    bool isFiniteBox(const Math3D::Vec3& minV, const Math3D::Vec3& maxV){
+        return std::isfinite(minV.x) && std::isfinite(minV.y) && std::isfinite(minV.z) &&
+               std::isfinite(maxV.x) && std::isfinite(maxV.y) && std::isfinite(maxV.z);
+    }
+
+    void expandBox(Math3D::Vec3& outMin, Math3D::Vec3& outMax, const Math3D::Vec3& minV, const Math3D::Vec3& maxV){
+        outMin.x = std::min(outMin.x, minV.x);
+        outMin.y = std::min(outMin.y, minV.y);
+        outMin.z = std::min(outMin.z, minV.z);
+        outMax.x = std::max(outMax.x, maxV.x);
+        outMax.y = std::max(outMax.y, maxV.y);
+        outMax.z = std::max(outMax.z, maxV.z);
+    }
+
+    float boxSurfaceArea(const Math3D::Vec3& minV, const Math3D::Vec3& maxV){
+        const float dx = std::max(0.0f, maxV.x - minV.x);
+        const float dy = std::max(0.0f, maxV.y - minV.y);
+        const float dz = std::max(0.0f, maxV.z - minV.z);
+        return 2.0f * ((dx * dy) + (dy * dz) + (dz * dx));
+    }
+
+    bool rayEntersBox(const Math3D::Vec3& origin,
+                      const Math3D::Vec3& invDir,
+                      const Math3D::Vec3& minV,
+                      const Math3D::Vec3& maxV,
+                      float maxDistance,
+                      float& outEntry){
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+        const float o[3] = {origin.x, origin.y, origin.z};
+        const float inv[3] = {invDir.x, invDir.y, invDir.z};
+        const float lo[3] = {minV.x, minV.y, minV.z};
+        const float hi[3] = {maxV.x, maxV.y, maxV.z};
+        for(int axis = 0; axis < 3; ++axis){
+            if(std::isinf(inv[axis])){
+                // Ray parallel to this slab: it only hits when the origin lies between the planes.
+                if(o[axis] < lo[axis] || o[axis] > hi[axis]){
+                    return false;
+                }
+                continue;
+            }
+            float t0 = (lo[axis] - o[axis]) * inv[axis];
+            float t1 = (hi[axis] - o[axis]) * inv[axis];
+            if(t0 > t1){
+                std::swap(t0, t1);
+            }
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+            if(tMin > tMax){
+                return false;
+            }
+        }
+        outEntry = tMin;
+        return true;
+    }
+}
+
+void BoundsBVH::clear(){
+    sourceMin = nullptr;
+    sourceMax = nullptr;
+    nodes.clear();
+    itemOrder.clear();
+    unboundedItems.clear();
+    boundedMask.clear();
+    itemCount = 0;
+    builtSurfaceArea = 0.0f;
+}
+
+void BoundsBVH::update(const Math3D::Vec3* boundsMin,
+                       const Math3D::Vec3* boundsMax,
+                       const std::uint8_t* flags,
+                       std::uint8_t testFlag,
+                       size_t count){
+    bool needsRebuild = (count != itemCount);
+    if(!needsRebuild){
+        for(size_t i = 0; i < count; ++i){
+            const bool bounded = (!flags || (flags[i] & testFlag) != 0) &&
+                                 isFiniteBox(boundsMin[i], boundsMax[i]);
+            if(bounded != (boundedMask[i] != 0)){
+                needsRebuild = true;
+                break;
+            }
+        }
+    }
+    if(needsRebuild){
+        rebuild(boundsMin, boundsMax, flags, testFlag, count);
+        return;
+    }
+
+    sourceMin = boundsMin;
+    sourceMax = boundsMax;
+    refit();
+    lastUpdateRebuilt = false;
+    if(computeSurfaceAreaSum() > builtSurfaceArea * kRebuildSurfaceAreaRatio){
+        rebuild(boundsMin, boundsMax, flags, testFlag, count);
+    }
+}
+
+void BoundsBVH::rebuild(const Math3D::Vec3* boundsMin,
+                        const Math3D::Vec3* boundsMax,
+                        const std::uint8_t* flags,
+                        std::uint8_t testFlag,
+                        size_t count){
+    clear();
+    sourceMin = boundsMin;
+    sourceMax = boundsMax;
+    itemCount = count;
+    lastUpdateRebuilt = true;
+
+    boundedMask.assign(count, 0);
+    itemOrder.reserve(count);
+    centroids.resize(count);
+    for(size_t i = 0; i < count; ++i){
+        const bool bounded = (!flags || (flags[i] & testFlag) != 0) &&
+                             isFiniteBox(boundsMin[i], boundsMax[i]);
+        if(!bounded){
+            unboundedItems.push_back(static_cast<std::uint32_t>(i));
+            continue;
+        }
+        boundedMask[i] = 1;
+        itemOrder.push_back(static_cast<std::uint32_t>(i));
+        centroids[i] = Math3D::Vec3((boundsMin[i].x + boundsMax[i].x) * 0.5f,
+                                    (boundsMin[i].y + boundsMax[i].y) * 0.5f,
+                                    (boundsMin[i].z + boundsMax[i].z) * 0.5f);
+    }
+
+    if(itemOrder.empty()){
+        return;
+    }
+
+    // Median splits give at most ceil(n / kMaxLeafItems) leaves, so 2n nodes always fit.
+    nodes.reserve(itemOrder.size() * 2);
+    nodes.emplace_back();
+    buildRange(0, 0, static_cast<std::uint32_t>(itemOrder.size()));
+    builtSurfaceArea = computeSurfaceAreaSum();
+}
+
+void BoundsBVH::buildRange(std::uint32_t nodeIndex, std::uint32_t begin, std::uint32_t end){
+    Math3D::Vec3 nodeMin = sourceMin[itemOrder[begin]];
+    Math3D::Vec3 nodeMax = sourceMax[itemOrder[begin]];
+    Math3D::Vec3 centroidMin = centroids[itemOrder[begin]];
+    Math3D::Vec3 centroidMax = centroidMin;
+    for(std::uint32_t i = begin + 1; i < end; ++i){
+        const std::uint32_t item = itemOrder[i];
+        expandBox(nodeMin, nodeMax, sourceMin[item], sourceMax[item]);
+        expandBox(centroidMin, centroidMax, centroids[item], centroids[item]);
+    }
+    nodes[nodeIndex].boundsMin = nodeMin;
+    nodes[nodeIndex].boundsMax = nodeMax;
+
+    const std::uint32_t itemSpan = end - begin;
+    if(itemSpan <= kMaxLeafItems){
+        nodes[nodeIndex].firstOrLeft = begin;
+        nodes[nodeIndex].count = itemSpan;
+        return;
+    }
+
+    const float extentX = centroidMax.x - centroidMin.x;
+    const float extentY = centroidMax.y - centroidMin.y;
+    const float extentZ = centroidMax.z - centroidMin.z;
+    int axis = 0;
+    if(extentY > extentX && extentY >= extentZ){
+        axis = 1;
+    }else if(extentZ > extentX && extentZ > extentY){
+        axis = 2;
+    }
+
+    const std::uint32_t mid = begin + (itemSpan / 2);
+    auto axisValue = [this, axis](std::uint32_t item){
+        const Math3D::Vec3& c = centroids[item];
+        return (axis == 0) ? c.x : ((axis == 1) ? c.y : c.z);
+    };
+    std::nth_element(itemOrder.begin() + begin,
+                     itemOrder.begin() + mid,
+                     itemOrder.begin() + end,
+                     [&axisValue](std::uint32_t a, std::uint32_t b){
+                         return axisValue(a) < axisValue(b);
+                     });
+
+    // Children are allocated as a pair after their parent, so reverse order visits children first.
+    const std::uint32_t leftIndex = static_cast<std::uint32_t>(nodes.size());
+    nodes.emplace_back();
+    nodes.emplace_back();
+    nodes[nodeIndex].firstOrLeft = leftIndex;
+    nodes[nodeIndex].count = 0;
+    buildRange(leftIndex, begin, mid);
+    buildRange(leftIndex + 1, mid, end);
+}
+
+void BoundsBVH::refit(){
+    for(size_t n = nodes.size(); n-- > 0;){
+        Node& node = nodes[n];
+        if(node.count > 0){
+            const std::uint32_t first = itemOrder[node.firstOrLeft];
+            node.boundsMin = sourceMin[first];
+            node.boundsMax = sourceMax[first];
+            for(std::uint32_t i = 1; i < node.count; ++i){
+                const std::uint32_t item = itemOrder[node.firstOrLeft + i];
+                expandBox(node.boundsMin, node.boundsMax, sourceMin[item], sourceMax[item]);
+            }
+        }else{
+            const Node& left = nodes[node.firstOrLeft];
+            const Node& right = nodes[node.firstOrLeft + 1];
+            node.boundsMin = left.boundsMin;
+            node.boundsMax = left.boundsMax;
+            expandBox(node.boundsMin, node.boundsMax, right.boundsMin, right.boundsMax);
+        }
+    }
+}
+
+float BoundsBVH::computeSurfaceAreaSum() const{
+    float sum = 0.0f;
+    for(const Node& node : nodes){
+        sum += boxSurfaceArea(node.boundsMin, node.boundsMax);
+    }
+    return sum;
+}
+
+void BoundsBVH::queryFrustum(const Math3D::Mat4& clipMatrix, std::vector<std::uint32_t>& outVisible) const{
+    const size_t firstOut = outVisible.size();
+    outVisible.insert(outVisible.end(), unboundedItems.begin(), unboundedItems.end());
+
+    if(!nodes.empty()){
+        std::uint32_t stack[64];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+        while(stackSize > 0){
+            const Node& node = nodes[stack[--stackSize]];
+            if(!FrustumCulling::AabbIntersectsClip(node.boundsMin, node.boundsMax, clipMatrix)){
+                continue;
+            }
+            if(node.count > 0){
+                for(std::uint32_t i = 0; i < node.count; ++i){
+                    const std::uint32_t item = itemOrder[node.firstOrLeft + i];
+                    if(node.count == 1 ||
+                       FrustumCulling::AabbIntersectsClip(sourceMin[item], sourceMax[item], clipMatrix)){
+                        outVisible.push_back(item);
+                    }
+                }
+                continue;
+            }
+            stack[stackSize++] = node.firstOrLeft + 1;
+            stack[stackSize++] = node.firstOrLeft;
+        }
+    }
+
+    std::sort(outVisible.begin() + static_cast<std::ptrdiff_t>(firstOut), outVisible.end());
+}
+
+void BoundsBVH::queryRay(const Math3D::Vec3& origin,
+                         const Math3D::Vec3& direction,
+                         float maxDistance,
+                         std::vector<RayCandidate>& outCandidates) const{
+    outCandidates.clear();
+    if(nodes.empty()){
+        return;
+    }
+
+    const Math3D::Vec3 invDir(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    std::uint32_t stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize > 0){
+        const Node& node = nodes[stack[--stackSize]];
+        float entry = 0.0f;
+        if(!rayEntersBox(origin, invDir, node.boundsMin, node.boundsMax, maxDistance, entry)){
+            continue;
+        }
+        if(node.count > 0){
+            for(std::uint32_t i = 0; i < node.count; ++i){
+                const std::uint32_t item = itemOrder[node.firstOrLeft + i];
+                float itemEntry = 0.0f;
+                if(rayEntersBox(origin, invDir, sourceMin[item], sourceMax[item], maxDistance, itemEntry)){
+                    outCandidates.push_back({item, itemEntry});
+                }
+            }
+            continue;
+        }
+        stack[stackSize++] = node.firstOrLeft + 1;
+        stack[stackSize++] = node.firstOrLeft;
+    }
+
+    std::sort(outCandidates.begin(), outCandidates.end(), [](const RayCandidate& a, const RayCandidate& b){
+        return a.entryDistance < b.entryDistance;
+    });
+}
+
+bool BoundsBVH::getRootBounds(Math3D::Vec3& outMin, Math3D::Vec3& outMax) const{
+    if(nodes.empty()){
+        return false;
+    }
+    outMin = nodes[0].boundsMin;
+    outMax = nodes[0].boundsMax;
+    return true;
+}
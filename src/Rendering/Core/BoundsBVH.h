@@ -0,0 +1,131 @@
+/**
+ * @file src/Rendering/Core/BoundsBVH.h
+ * @brief Refittable bounding volume hierarchy over indexed world-space boxes.
+ */
+
+#ifndef RENDERING_CORE_BOUNDS_BVH_H
+#define RENDERING_CORE_BOUNDS_BVH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Foundation/Math/Math3D.h"
+
+/**
+ * @brief Binary AABB tree over caller-owned box arrays.
+ *
+ * update() refits node bounds in place when the item set keeps its shape and only
+ * rebuilds when the item count or the set of bounded items changes, or when refitting
+ * has inflated the tree too far. Items that are not testable (no bounds or non-finite
+ * bounds) are kept aside and returned by every frustum query, matching
+ * FrustumCulling::CullAabbs().
+ */
+class BoundsBVH {
+    public:
+        /// @brief Holds data for RayCandidate.
+        struct RayCandidate {
+            std::uint32_t index = 0;
+            float entryDistance = 0.0f;
+        };
+
+        /**
+         * @brief Refits or rebuilds the tree for the given boxes.
+         * @param boundsMin Box minimums, `count` entries.
+         * @param boundsMax Box maximums, `count` entries.
+         * @param flags Optional per-entry flag bytes; entries lacking `testFlag` are unbounded.
+         * @param testFlag Bit that marks an entry as having bounds.
+         * @param count Number of entries.
+         */
+        void update(const Math3D::Vec3* boundsMin,
+                    const Math3D::Vec3* boundsMax,
+                    const std::uint8_t* flags,
+                    std::uint8_t testFlag,
+                    size_t count);
+
+        /**
+         * @brief Discards the current topology and builds a new tree.
+         * @param boundsMin Box minimums, `count` entries.
+         * @param boundsMax Box maximums, `count` entries.
+         * @param flags Optional per-entry flag bytes; entries lacking `testFlag` are unbounded.
+         * @param testFlag Bit that marks an entry as having bounds.
+         * @param count Number of entries.
+         */
+        void rebuild(const Math3D::Vec3* boundsMin,
+                     const Math3D::Vec3* boundsMax,
+                     const std::uint8_t* flags,
+                     std::uint8_t testFlag,
+                     size_t count);
+
+        /**
+         * @brief Clears the tree.
+         */
+        void clear();
+
+        /**
+         * @brief Appends every item that may be visible through a clip matrix.
+         *
+         * Output is sorted ascending so callers keep the input order of the items.
+         * @param clipMatrix Projection * view matrix.
+         * @param outVisible Receives item indices (appended, not cleared).
+         */
+        void queryFrustum(const Math3D::Mat4& clipMatrix, std::vector<std::uint32_t>& outVisible) const;
+
+        /**
+         * @brief Collects bounded items whose box the ray enters within `maxDistance`.
+         * @param origin Ray origin.
+         * @param direction Ray direction (need not be normalized; distances are in its units).
+         * @param maxDistance Farthest entry distance to report.
+         * @param outCandidates Receives candidates sorted by entry distance (cleared first).
+         */
+        void queryRay(const Math3D::Vec3& origin,
+                      const Math3D::Vec3& direction,
+                      float maxDistance,
+                      std::vector<RayCandidate>& outCandidates) const;
+
+        /**
+         * @brief Returns the bounds enclosing every bounded item.
+         * @param outMin Receives the minimum corner.
+         * @param outMax Receives the maximum corner.
+         * @return False when the tree holds no bounded items.
+         */
+        bool getRootBounds(Math3D::Vec3& outMin, Math3D::Vec3& outMax) const;
+
+        /**
+         * @brief Returns the number of items the tree was last updated with.
+         * @return Item count.
+         */
+        size_t getItemCount() const { return itemCount; }
+
+        /**
+         * @brief Returns whether the last update() rebuilt the tree instead of refitting it.
+         * @return True after a rebuild.
+         */
+        bool wasLastUpdateRebuild() const { return lastUpdateRebuilt; }
+
+    private:
+        /// @brief Holds data for Node. Leaves have `count > 0` and index `itemOrder`; inner nodes store the left child.
+        struct Node {
+            Math3D::Vec3 boundsMin;
+            Math3D::Vec3 boundsMax;
+            std::uint32_t firstOrLeft = 0;
+            std::uint32_t count = 0;
+        };
+
+        void buildRange(std::uint32_t nodeIndex, std::uint32_t begin, std::uint32_t end);
+        void refit();
+        float computeSurfaceAreaSum() const;
+
+        const Math3D::Vec3* sourceMin = nullptr;
+        const Math3D::Vec3* sourceMax = nullptr;
+        std::vector<Node> nodes;
+        std::vector<std::uint32_t> itemOrder;
+        std::vector<std::uint32_t> unboundedItems;
+        std::vector<std::uint8_t> boundedMask;
+        std::vector<Math3D::Vec3> centroids;
+        size_t itemCount = 0;
+        float builtSurfaceArea = 0.0f;
+        bool lastUpdateRebuilt = false;
+};
+
+#endif // RENDERING_CORE_BOUNDS_BVH_H
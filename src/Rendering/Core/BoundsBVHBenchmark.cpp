@@ -0,0 +1,243 @@
+/**
+ * @file src/Rendering/Core/BoundsBVHBenchmark.cpp
+ * @brief Implementation for BoundsBVHBenchmark.
+ */
+
+#include "Rendering/Core/BoundsBVHBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+#include "Foundation/Logging/Logbot.h"
+#include "Rendering/Core/BoundsBVH.h"
+#include "Rendering/Core/FrustumCulling.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    constexpr std::uint32_t kSeed = 0xB0A1D5u;
+    constexpr size_t kItemCounts[] = {1000, 10000, 100000};
+    constexpr int kRepeats = 5;
+    constexpr int kCameraStops = 16;
+    constexpr int kPickRays = 64;
+    constexpr float kWorldHalfExtent = 1000.0f;
+    constexpr std::uint8_t kTestFlag = 1u << 6;
+
+    double elapsedMs(const BenchClock::time_point& start){
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    // Open world: mostly small props scattered over a wide ground plane, a few large volumes.
+    void buildWorld(std::mt19937& rng,
+                    size_t count,
+                    std::vector<Math3D::Vec3>& outMin,
+                    std::vector<Math3D::Vec3>& outMax,
+                    std::vector<std::uint8_t>& outFlags){
+        std::uniform_real_distribution<float> ground(-kWorldHalfExtent, kWorldHalfExtent);
+        std::uniform_real_distribution<float> height(0.0f, 30.0f);
+        std::uniform_real_distribution<float> propExtent(0.25f, 3.0f);
+        std::uniform_int_distribution<int> kind(0, 99);
+
+        outMin.resize(count);
+        outMax.resize(count);
+        outFlags.assign(count, kTestFlag);
+        for(size_t i = 0; i < count; ++i){
+            const Math3D::Vec3 center(ground(rng), height(rng), ground(rng));
+            Math3D::Vec3 half(propExtent(rng), propExtent(rng), propExtent(rng));
+            if(kind(rng) == 0){
+                half = half * 20.0f;
+            }
+            outMin[i] = center - half;
+            outMax[i] = center + half;
+        }
+    }
+
+    Math3D::Mat4 cameraClip(int stop){
+        const float angle = (static_cast<float>(stop) / static_cast<float>(kCameraStops)) * 6.2831853f;
+        const float radius = kWorldHalfExtent * 0.5f;
+        const glm::vec3 eye(std::cos(angle) * radius, 10.0f, std::sin(angle) * radius);
+        const glm::vec3 target(0.0f, 0.0f, 0.0f);
+        const glm::mat4 view = glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+        return Math3D::Mat4(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f) * view);
+    }
+
+    // Same slab test as BoundsBVH, applied to every box.
+    bool rayEntersBox(const Math3D::Vec3& origin,
+                      const Math3D::Vec3& invDir,
+                      const Math3D::Vec3& minV,
+                      const Math3D::Vec3& maxV,
+                      float maxDistance){
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+        const float o[3] = {origin.x, origin.y, origin.z};
+        const float inv[3] = {invDir.x, invDir.y, invDir.z};
+        const float lo[3] = {minV.x, minV.y, minV.z};
+        const float hi[3] = {maxV.x, maxV.y, maxV.z};
+        for(int axis = 0; axis < 3; ++axis){
+            if(std::isinf(inv[axis])){
+                if(o[axis] < lo[axis] || o[axis] > hi[axis]){
+                    return false;
+                }
+                continue;
+            }
+            float t0 = (lo[axis] - o[axis]) * inv[axis];
+            float t1 = (hi[axis] - o[axis]) * inv[axis];
+            if(t0 > t1){
+                std::swap(t0, t1);
+            }
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+            if(tMin > tMax){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Holds data for PickRay.
+    struct PickRay {
+        Math3D::Vec3 origin;
+        Math3D::Vec3 direction;
+    };
+
+    std::vector<PickRay> buildPickRays(std::mt19937& rng){
+        std::uniform_real_distribution<float> ground(-kWorldHalfExtent, kWorldHalfExtent);
+        std::uniform_real_distribution<float> spread(-1.0f, 1.0f);
+        std::vector<PickRay> rays(kPickRays);
+        for(PickRay& ray : rays){
+            // Mouse picks: from eye height, angled down into the world.
+            ray.origin = Math3D::Vec3(ground(rng), 40.0f, ground(rng));
+            const Math3D::Vec3 direction(spread(rng), -0.5f, spread(rng));
+            const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+            ray.direction = direction * (1.0f / length);
+        }
+        return rays;
+    }
+}
+
+BoundsBVHBenchmark::Result BoundsBVHBenchmark::Run(){
+    Result result;
+    result.matched = true;
+    std::mt19937 rng(kSeed);
+    const std::vector<PickRay> pickRays = buildPickRays(rng);
+    const float pickDistance = kWorldHalfExtent * 4.0f;
+
+    std::vector<Math3D::Vec3> boundsMin;
+    std::vector<Math3D::Vec3> boundsMax;
+    std::vector<std::uint8_t> flags;
+    std::vector<std::uint32_t> linearVisible;
+    std::vector<std::uint32_t> bvhVisible;
+    std::vector<std::uint32_t> linearHits;
+    std::vector<std::uint32_t> bvhHits;
+    std::vector<BoundsBVH::RayCandidate> candidates;
+
+    for(size_t itemCount : kItemCounts){
+        buildWorld(rng, itemCount, boundsMin, boundsMax, flags);
+        Sample sample;
+        sample.itemCount = itemCount;
+
+        BoundsBVH bvh;
+        sample.rebuildMs = 1.0e30;
+        for(int repeat = 0; repeat < kRepeats; ++repeat){
+            const BenchClock::time_point start = BenchClock::now();
+            bvh.rebuild(boundsMin.data(), boundsMax.data(), flags.data(), kTestFlag, itemCount);
+            sample.rebuildMs = std::min(sample.rebuildMs, elapsedMs(start));
+        }
+
+        // Nudge every box as a frame of animation would, then let update() refit.
+        sample.refitMs = 1.0e30;
+        for(int repeat = 0; repeat < kRepeats; ++repeat){
+            const Math3D::Vec3 nudge((repeat & 1) ? 0.05f : -0.05f, 0.0f, 0.02f);
+            for(size_t i = 0; i < itemCount; ++i){
+                boundsMin[i] = boundsMin[i] + nudge;
+                boundsMax[i] = boundsMax[i] + nudge;
+            }
+            const BenchClock::time_point start = BenchClock::now();
+            bvh.update(boundsMin.data(), boundsMax.data(), flags.data(), kTestFlag, itemCount);
+            sample.refitMs = std::min(sample.refitMs, elapsedMs(start));
+        }
+        if(bvh.wasLastUpdateRebuild()){
+            LogBot.Log(LOG_WARN, "BVH benchmark: %llu items rebuilt instead of refitting after small moves.",
+                       static_cast<unsigned long long>(itemCount));
+        }
+
+        size_t visibleTotal = 0;
+        double linearCullTotal = 0.0;
+        double bvhCullTotal = 0.0;
+        for(int stop = 0; stop < kCameraStops; ++stop){
+            const Math3D::Mat4 clip = cameraClip(stop);
+
+            linearVisible.clear();
+            BenchClock::time_point start = BenchClock::now();
+            FrustumCulling::CullAabbs(boundsMin.data(), boundsMax.data(), flags.data(), kTestFlag, itemCount, clip, linearVisible);
+            linearCullTotal += elapsedMs(start);
+
+            bvhVisible.clear();
+            start = BenchClock::now();
+            bvh.queryFrustum(clip, bvhVisible);
+            bvhCullTotal += elapsedMs(start);
+
+            visibleTotal += linearVisible.size();
+            if(bvhVisible != linearVisible){
+                sample.cullMismatches++;
+            }
+        }
+        sample.linearCullMs = linearCullTotal / kCameraStops;
+        sample.bvhCullMs = bvhCullTotal / kCameraStops;
+        sample.averageVisible = visibleTotal / kCameraStops;
+
+        double linearRayTotal = 0.0;
+        double bvhRayTotal = 0.0;
+        for(const PickRay& ray : pickRays){
+            const Math3D::Vec3 invDir(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+            linearHits.clear();
+            BenchClock::time_point start = BenchClock::now();
+            for(size_t i = 0; i < itemCount; ++i){
+                if(rayEntersBox(ray.origin, invDir, boundsMin[i], boundsMax[i], pickDistance)){
+                    linearHits.push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+            linearRayTotal += elapsedMs(start);
+
+            start = BenchClock::now();
+            bvh.queryRay(ray.origin, ray.direction, pickDistance, candidates);
+            bvhRayTotal += elapsedMs(start);
+
+            // Compare hit sets by index; equal entry distances make the BVH's order unstable.
+            bvhHits.clear();
+            for(const BoundsBVH::RayCandidate& candidate : candidates){
+                bvhHits.push_back(candidate.index);
+            }
+            std::sort(bvhHits.begin(), bvhHits.end());
+            if(bvhHits != linearHits){
+                sample.rayMismatches++;
+            }
+        }
+        sample.linearRayMs = linearRayTotal / kPickRays;
+        sample.bvhRayMs = bvhRayTotal / kPickRays;
+
+        if(sample.cullMismatches > 0 || sample.rayMismatches > 0){
+            result.matched = false;
+            LogBot.Log(LOG_ERRO, "BVH benchmark: %llu items, %llu frustum and %llu ray result(s) differ from the linear scan.",
+                       static_cast<unsigned long long>(itemCount),
+                       static_cast<unsigned long long>(sample.cullMismatches),
+                       static_cast<unsigned long long>(sample.rayMismatches));
+        }
+        LogBot.Log(LOG_INFO, "BVH benchmark: %llu items | rebuild %.3f ms, refit %.3f ms | cull %.3f ms linear vs %.3f ms BVH (%llu visible) | ray %.4f ms linear vs %.4f ms BVH",
+                   static_cast<unsigned long long>(itemCount),
+                   sample.rebuildMs,
+                   sample.refitMs,
+                   sample.linearCullMs,
+                   sample.bvhCullMs,
+                   static_cast<unsigned long long>(sample.averageVisible),
+                   sample.linearRayMs,
+                   sample.bvhRayMs);
+        result.samples.push_back(sample);
+    }
+    return result;
+}
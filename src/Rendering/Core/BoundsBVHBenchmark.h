@@ -0,0 +1,50 @@
+/**
+ * @file src/Rendering/Core/BoundsBVHBenchmark.h
+ * @brief Declarations for BoundsBVHBenchmark.
+ */
+
+#ifndef RENDERING_CORE_BOUNDS_BVH_BENCHMARK_H
+#define RENDERING_CORE_BOUNDS_BVH_BENCHMARK_H
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Measures BoundsBVH against the linear culling and picking scans it replaces.
+namespace BoundsBVHBenchmark {
+    /// @brief Holds data for Sample: one synthetic world at a given item count.
+    struct Sample {
+        size_t itemCount = 0;
+        /// Best time for a full rebuild, and for a refit after every box moved slightly.
+        double rebuildMs = 0.0;
+        double refitMs = 0.0;
+        /// Average time per frustum query over the camera path, per method.
+        double linearCullMs = 0.0;
+        double bvhCullMs = 0.0;
+        /// Average time per pick ray, per method.
+        double linearRayMs = 0.0;
+        double bvhRayMs = 0.0;
+        size_t averageVisible = 0;
+        /// Queries whose BVH output differed from the linear scan.
+        size_t cullMismatches = 0;
+        size_t rayMismatches = 0;
+    };
+
+    /// @brief Holds data for Result.
+    struct Result {
+        std::vector<Sample> samples;
+        /// True when every query matched the linear reference.
+        bool matched = false;
+    };
+
+    /**
+     * @brief Times build, refit, frustum queries and ray picks on open-world box sets of
+     * 1k, 10k and 100k items. GL-free.
+     *
+     * Frustum output is compared index-for-index with FrustumCulling::CullAabbs, and the
+     * nearest ray hit with a brute-force slab test over every box.
+     * @return Measured values.
+     */
+    Result Run();
+}
+
+#endif // RENDERING_CORE_BOUNDS_BVH_BENCHMARK_H
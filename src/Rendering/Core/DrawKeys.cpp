@@ -0,0 +1,111 @@
+/**
+ * @file src/Rendering/Core/DrawKeys.cpp
+ * @brief Implementation for DrawKeys.
+ */
+
+#include "Rendering/Core/DrawKeys.h"
+
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace {
+    constexpr std::uint64_t fieldBits(std::uint32_t value, unsigned width){
+        return static_cast<std::uint64_t>(value) & ((std::uint64_t(1) << width) - 1u);
+    }
+
+    std::uint64_t passBits(DrawKeys::Pass pass){
+        return static_cast<std::uint64_t>(pass) << 62;
+    }
+}
+
+std::uint16_t DrawKeys::QuantizeDepth(float viewDepth, float farPlane){
+    if(!(viewDepth > 0.0f)){
+        return 0;
+    }
+    if(!(farPlane > 0.0f)){
+        farPlane = 1.0f;
+    }
+
+    // Log spacing keeps nearby items distinct while distant ones share buckets.
+    const float t = std::log2(1.0f + viewDepth) / std::log2(1.0f + farPlane);
+    if(t >= 1.0f){
+        return 0xFFFFu;
+    }
+    return static_cast<std::uint16_t>(t * 65535.0f);
+}
+
+std::uint64_t DrawKeys::MakeStateKey(Pass pass,
+                                     bool backfaceCulling,
+                                     std::uint32_t shaderId,
+                                     std::uint32_t materialId,
+                                     std::uint32_t meshId,
+                                     std::uint16_t depth){
+    return passBits(pass) |
+           (static_cast<std::uint64_t>(backfaceCulling ? 0u : 1u) << 61) |
+           (fieldBits(shaderId, 12) << 49) |
+           (fieldBits(materialId, 16) << 33) |
+           (fieldBits(meshId, 17) << 16) |
+           static_cast<std::uint64_t>(depth);
+}
+
+std::uint64_t DrawKeys::MakeTransparentKey(bool backfaceCulling,
+                                           std::uint32_t materialId,
+                                           std::uint32_t meshId,
+                                           std::uint16_t depth){
+    const std::uint16_t farFirst = static_cast<std::uint16_t>(0xFFFFu - depth);
+    return passBits(Pass::Transparent) |
+           (static_cast<std::uint64_t>(farFirst) << 46) |
+           (static_cast<std::uint64_t>(backfaceCulling ? 0u : 1u) << 45) |
+           (fieldBits(materialId, 16) << 29) |
+           (fieldBits(meshId, 17) << 12);
+}
+
+std::uint64_t DrawKeys::MakeShadowKey(std::uint8_t layerMask, bool backfaceCulling, std::uint32_t meshId){
+    return passBits(Pass::Shadow) |
+           (static_cast<std::uint64_t>(layerMask) << 54) |
+           (static_cast<std::uint64_t>(backfaceCulling ? 0u : 1u) << 53) |
+           (fieldBits(meshId, 17) << 36);
+}
+
+void DrawKeys::RadixSort(std::vector<Entry>& entries, std::vector<Entry>& scratch){
+    const size_t count = entries.size();
+    if(count < 2){
+        return;
+    }
+
+    // One read builds all eight byte histograms.
+    std::array<std::array<std::uint32_t, 256>, 8> histograms{};
+    for(const Entry& entry : entries){
+        for(unsigned byte = 0; byte < 8; ++byte){
+            histograms[byte][(entry.key >> (byte * 8)) & 0xFFu]++;
+        }
+    }
+
+    scratch.resize(count);
+    Entry* src = entries.data();
+    Entry* dst = scratch.data();
+    for(unsigned byte = 0; byte < 8; ++byte){
+        std::array<std::uint32_t, 256>& histogram = histograms[byte];
+        const unsigned firstDigit = static_cast<unsigned>((src[0].key >> (byte * 8)) & 0xFFu);
+        if(histogram[firstDigit] == count){
+            continue;
+        }
+
+        std::uint32_t offset = 0;
+        for(std::uint32_t& bucket : histogram){
+            const std::uint32_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for(size_t i = 0; i < count; ++i){
+            const unsigned digit = static_cast<unsigned>((src[i].key >> (byte * 8)) & 0xFFu);
+            dst[histogram[digit]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if(src != entries.data()){
+        entries.swap(scratch);
+    }
+}
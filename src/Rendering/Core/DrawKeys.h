@@ -0,0 +1,94 @@
+/**
+ * @file src/Rendering/Core/DrawKeys.h
+ * @brief 64-bit draw sort keys and the radix sort that orders them.
+ */
+
+#ifndef RENDERING_CORE_DRAW_KEYS_H
+#define RENDERING_CORE_DRAW_KEYS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DrawKeys {
+    /// @brief Pass bucket stored in the top two key bits.
+    enum class Pass : std::uint8_t {
+        Opaque = 0,
+        Deferred = 1,
+        Shadow = 2,
+        Transparent = 3
+    };
+
+    /// @brief Holds data for Entry: a sort key and the draw item it orders.
+    struct Entry {
+        std::uint64_t key = 0;
+        std::uint32_t item = 0;
+    };
+
+    /**
+     * @brief Maps a view-space distance to 16 bits with more precision near the camera.
+     * @param viewDepth Distance along the view direction; negative values clamp to 0.
+     * @param farPlane Distance that maps to the largest value.
+     * @return Quantized depth, increasing with distance.
+     */
+    std::uint16_t QuantizeDepth(float viewDepth, float farPlane);
+
+    /**
+     * @brief Builds a state-first key: pass, cull, shader, material, mesh, then front-to-back depth.
+     *
+     * Ids wider than their field are truncated. Collisions only cost state changes, because
+     * callers still compare real ids when grouping.
+     * Layout: pass 63-62 | no-cull 61 | shader 60-49 | material 48-33 | mesh 32-16 | depth 15-0.
+     * @param pass Pass bucket.
+     * @param backfaceCulling Culled items sort before double-sided ones.
+     * @param shaderId Program id (12 bits).
+     * @param materialId Material id (16 bits).
+     * @param meshId Mesh id (17 bits).
+     * @param depth Quantized depth from QuantizeDepth().
+     * @return Sort key.
+     */
+    std::uint64_t MakeStateKey(Pass pass,
+                               bool backfaceCulling,
+                               std::uint32_t shaderId,
+                               std::uint32_t materialId,
+                               std::uint32_t meshId,
+                               std::uint16_t depth);
+
+    /**
+     * @brief Builds a back-to-front key: pass, inverted depth, cull, material, mesh.
+     *
+     * Layout: pass 63-62 | far-first depth 61-46 | no-cull 45 | material 44-29 | mesh 28-12.
+     * @param backfaceCulling Culled items sort first among equal depths.
+     * @param materialId Material id (16 bits).
+     * @param meshId Mesh id (17 bits).
+     * @param depth Quantized depth from QuantizeDepth().
+     * @return Sort key.
+     */
+    std::uint64_t MakeTransparentKey(bool backfaceCulling,
+                                     std::uint32_t materialId,
+                                     std::uint32_t meshId,
+                                     std::uint16_t depth);
+
+    /**
+     * @brief Builds a shadow caster key: pass, layer mask, cull, mesh.
+     *
+     * Layout: pass 63-62 | layer mask 61-54 | no-cull 53 | mesh 52-36.
+     * @param layerMask Layers the caster reaches (0 for single-layer passes).
+     * @param backfaceCulling Culled casters sort first.
+     * @param meshId Mesh id (17 bits).
+     * @return Sort key.
+     */
+    std::uint64_t MakeShadowKey(std::uint8_t layerMask, bool backfaceCulling, std::uint32_t meshId);
+
+    /**
+     * @brief Stable LSD radix sort of entries by key, 8 bits per pass.
+     *
+     * Byte positions where every key agrees are skipped, so keys that only use a few fields
+     * cost only a few passes.
+     * @param entries Entries to sort in place.
+     * @param scratch Reusable buffer; resized to entries.size().
+     */
+    void RadixSort(std::vector<Entry>& entries, std::vector<Entry>& scratch);
+}
+
+#endif // RENDERING_CORE_DRAW_KEYS_H
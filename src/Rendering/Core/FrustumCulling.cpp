@@ -0,0 +1,268 @@
+/**
+ * @file src/Rendering/Core/FrustumCulling.cpp
+ * @brief Implementation for FrustumCulling.
+ */
+
+#include "Rendering/Core/FrustumCulling.h"
+
+#include <array>
+#include <cmath>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define FRUSTUM_CULLING_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FRUSTUM_CULLING_SSE2 1
+#endif
+
+namespace {
+    bool isTestable(const std::uint8_t* flags, std::uint8_t testFlag, size_t index){
+        return !flags || (flags[index] & testFlag) != 0;
+    }
+
+    void cullScalarRange(const Math3D::Vec3* boundsMin,
+                         const Math3D::Vec3* boundsMax,
+                         const std::uint8_t* flags,
+                         std::uint8_t testFlag,
+                         size_t begin,
+                         size_t end,
+                         const Math3D::Mat4& clipMatrix,
+                         std::vector<std::uint32_t>& outVisible){
+        for(size_t i = begin; i < end; ++i){
+            if(!isTestable(flags, testFlag, i) ||
+               FrustumCulling::AabbIntersectsClip(boundsMin[i], boundsMax[i], clipMatrix)){
+                outVisible.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+    }
+
+#if defined(FRUSTUM_CULLING_AVX2)
+    constexpr size_t kLaneCount = 8;
+    typedef __m256 LaneFloat;
+
+    inline LaneFloat laneSet1(float v){ return _mm256_set1_ps(v); }
+    inline LaneFloat laneMul(LaneFloat a, LaneFloat b){ return _mm256_mul_ps(a, b); }
+    inline LaneFloat laneAdd(LaneFloat a, LaneFloat b){ return _mm256_add_ps(a, b); }
+    inline LaneFloat laneAnd(LaneFloat a, LaneFloat b){ return _mm256_and_ps(a, b); }
+    inline LaneFloat laneOr(LaneFloat a, LaneFloat b){ return _mm256_or_ps(a, b); }
+    inline LaneFloat laneXor(LaneFloat a, LaneFloat b){ return _mm256_xor_ps(a, b); }
+    inline LaneFloat laneLess(LaneFloat a, LaneFloat b){ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    inline LaneFloat laneAllOnes(){ return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    inline int laneMoveMask(LaneFloat v){ return _mm256_movemask_ps(v); }
+    inline LaneFloat laneGather(const Math3D::Vec3* v, size_t base, int axis){
+        const float* p = &v[base].x + axis;
+        // Vec3 is three packed floats, so consecutive boxes are 3 floats apart.
+        return _mm256_setr_ps(p[0], p[3], p[6], p[9], p[12], p[15], p[18], p[21]);
+    }
+    inline LaneFloat laneTestMask(const std::uint8_t* flags, std::uint8_t testFlag, size_t base){
+        if(!flags){
+            return laneAllOnes();
+        }
+        const __m256i bytes = _mm256_setr_epi32(flags[base + 0], flags[base + 1], flags[base + 2], flags[base + 3],
+                                                flags[base + 4], flags[base + 5], flags[base + 6], flags[base + 7]);
+        const __m256i tested = _mm256_and_si256(bytes, _mm256_set1_epi32(testFlag));
+        return _mm256_castsi256_ps(_mm256_xor_si256(_mm256_cmpeq_epi32(tested, _mm256_setzero_si256()),
+                                                    _mm256_set1_epi32(-1)));
+    }
+#elif defined(FRUSTUM_CULLING_SSE2)
+    constexpr size_t kLaneCount = 4;
+    typedef __m128 LaneFloat;
+
+    inline LaneFloat laneSet1(float v){ return _mm_set1_ps(v); }
+    inline LaneFloat laneMul(LaneFloat a, LaneFloat b){ return _mm_mul_ps(a, b); }
+    inline LaneFloat laneAdd(LaneFloat a, LaneFloat b){ return _mm_add_ps(a, b); }
+    inline LaneFloat laneAnd(LaneFloat a, LaneFloat b){ return _mm_and_ps(a, b); }
+    inline LaneFloat laneOr(LaneFloat a, LaneFloat b){ return _mm_or_ps(a, b); }
+    inline LaneFloat laneXor(LaneFloat a, LaneFloat b){ return _mm_xor_ps(a, b); }
+    inline LaneFloat laneLess(LaneFloat a, LaneFloat b){ return _mm_cmplt_ps(a, b); }
+    inline LaneFloat laneAllOnes(){ return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    inline int laneMoveMask(LaneFloat v){ return _mm_movemask_ps(v); }
+    inline LaneFloat laneGather(const Math3D::Vec3* v, size_t base, int axis){
+        const float* p = &v[base].x + axis;
+        return _mm_setr_ps(p[0], p[3], p[6], p[9]);
+    }
+    inline LaneFloat laneTestMask(const std::uint8_t* flags, std::uint8_t testFlag, size_t base){
+        if(!flags){
+            return laneAllOnes();
+        }
+        const __m128i bytes = _mm_setr_epi32(flags[base + 0], flags[base + 1], flags[base + 2], flags[base + 3]);
+        const __m128i tested = _mm_and_si128(bytes, _mm_set1_epi32(testFlag));
+        return _mm_castsi128_ps(_mm_xor_si128(_mm_cmpeq_epi32(tested, _mm_setzero_si128()), _mm_set1_epi32(-1)));
+    }
+#endif
+
+#if defined(FRUSTUM_CULLING_AVX2) || defined(FRUSTUM_CULLING_SSE2)
+    // Column-major copy of the clip matrix: m[column][row], as in glm.
+    struct ClipMatrix {
+        float m[4][4];
+    };
+
+    ClipMatrix toClipMatrix(const Math3D::Mat4& clipMatrix){
+        const glm::mat4 source = static_cast<glm::mat4>(clipMatrix);
+        ClipMatrix out;
+        for(int column = 0; column < 4; ++column){
+            for(int row = 0; row < 4; ++row){
+                out.m[column][row] = source[column][row];
+            }
+        }
+        return out;
+    }
+
+    // Tests kLaneCount boxes per iteration with boxes spread across lanes. Each clip
+    // component is summed in the same order glm uses for mat4 * vec4, so lane results
+    // are bit-identical to AabbIntersectsClip().
+    size_t cullSimdRange(const Math3D::Vec3* boundsMin,
+                         const Math3D::Vec3* boundsMax,
+                         const std::uint8_t* flags,
+                         std::uint8_t testFlag,
+                         size_t count,
+                         const ClipMatrix& clip,
+                         std::vector<std::uint32_t>& outVisible){
+        static_assert(sizeof(Math3D::Vec3) == sizeof(float) * 3, "laneGather expects packed Vec3");
+
+        const LaneFloat signMask = laneSet1(-0.0f);
+        const LaneFloat absMask = laneXor(laneAllOnes(), signMask);
+        const LaneFloat infinity = laneSet1(INFINITY);
+
+        size_t i = 0;
+        for(; i + kLaneCount <= count; i += kLaneCount){
+            const LaneFloat axisValues[3][2] = {
+                { laneGather(boundsMin, i, 0), laneGather(boundsMax, i, 0) },
+                { laneGather(boundsMin, i, 1), laneGather(boundsMax, i, 1) },
+                { laneGather(boundsMin, i, 2), laneGather(boundsMax, i, 2) }
+            };
+
+            // products[row][axis][minOrMax] = m[axis][row] * corner[axis]
+            LaneFloat products[4][3][2];
+            LaneFloat translation[4];
+            for(int row = 0; row < 4; ++row){
+                for(int axis = 0; axis < 3; ++axis){
+                    const LaneFloat coefficient = laneSet1(clip.m[axis][row]);
+                    products[row][axis][0] = laneMul(coefficient, axisValues[axis][0]);
+                    products[row][axis][1] = laneMul(coefficient, axisValues[axis][1]);
+                }
+                translation[row] = laneSet1(clip.m[3][row]);
+            }
+
+            LaneFloat allOutside[6];
+            for(auto& plane : allOutside){
+                plane = laneAllOnes();
+            }
+            LaneFloat anyNonFinite = laneXor(signMask, signMask);
+
+            for(int corner = 0; corner < 8; ++corner){
+                const int sx = corner & 1;
+                const int sy = (corner >> 1) & 1;
+                const int sz = (corner >> 2) & 1;
+
+                LaneFloat clipValue[4];
+                for(int row = 0; row < 4; ++row){
+                    clipValue[row] = laneAdd(
+                        laneAdd(products[row][0][sx], products[row][1][sy]),
+                        laneAdd(products[row][2][sz], translation[row])
+                    );
+                    const LaneFloat finite = laneLess(laneAnd(clipValue[row], absMask), infinity);
+                    anyNonFinite = laneOr(anyNonFinite, laneXor(finite, laneAllOnes()));
+                }
+
+                const LaneFloat negW = laneXor(clipValue[3], signMask);
+                allOutside[0] = laneAnd(allOutside[0], laneLess(clipValue[0], negW));
+                allOutside[1] = laneAnd(allOutside[1], laneLess(clipValue[3], clipValue[0]));
+                allOutside[2] = laneAnd(allOutside[2], laneLess(clipValue[1], negW));
+                allOutside[3] = laneAnd(allOutside[3], laneLess(clipValue[3], clipValue[1]));
+                allOutside[4] = laneAnd(allOutside[4], laneLess(clipValue[2], negW));
+                allOutside[5] = laneAnd(allOutside[5], laneLess(clipValue[3], clipValue[2]));
+            }
+
+            const LaneFloat culled = laneOr(
+                laneOr(laneOr(allOutside[0], allOutside[1]), laneOr(allOutside[2], allOutside[3])),
+                laneOr(allOutside[4], allOutside[5])
+            );
+            const LaneFloat visible = laneOr(
+                laneOr(anyNonFinite, laneXor(culled, laneAllOnes())),
+                laneXor(laneTestMask(flags, testFlag, i), laneAllOnes())
+            );
+
+            int mask = laneMoveMask(visible);
+            while(mask != 0){
+                int lane = 0;
+                while(((mask >> lane) & 1) == 0){
+                    ++lane;
+                }
+                outVisible.push_back(static_cast<std::uint32_t>(i + static_cast<size_t>(lane)));
+                mask &= mask - 1;
+            }
+        }
+        return i;
+    }
+#endif
+}
+
+namespace FrustumCulling {
+    bool AabbIntersectsClip(const Math3D::Vec3& minV, const Math3D::Vec3& maxV, const Math3D::Mat4& clipMatrix){
+        const std::array<glm::vec3, 8> corners = {{
+            glm::vec3(minV.x, minV.y, minV.z),
+            glm::vec3(maxV.x, minV.y, minV.z),
+            glm::vec3(minV.x, maxV.y, minV.z),
+            glm::vec3(maxV.x, maxV.y, minV.z),
+            glm::vec3(minV.x, minV.y, maxV.z),
+            glm::vec3(maxV.x, minV.y, maxV.z),
+            glm::vec3(minV.x, maxV.y, maxV.z),
+            glm::vec3(maxV.x, maxV.y, maxV.z)
+        }};
+
+        const glm::mat4 m = static_cast<glm::mat4>(clipMatrix);
+
+        bool allLeft = true;
+        bool allRight = true;
+        bool allBottom = true;
+        bool allTop = true;
+        bool allNear = true;
+        bool allFar = true;
+
+        for(const glm::vec3& corner : corners){
+            const glm::vec4 clip = m * glm::vec4(corner, 1.0f);
+            if(!std::isfinite(clip.x) || !std::isfinite(clip.y) || !std::isfinite(clip.z) || !std::isfinite(clip.w)){
+                return true; // Fail open on invalid math rather than dropping geometry.
+            }
+
+            allLeft = allLeft && (clip.x < -clip.w);
+            allRight = allRight && (clip.x > clip.w);
+            allBottom = allBottom && (clip.y < -clip.w);
+            allTop = allTop && (clip.y > clip.w);
+            allNear = allNear && (clip.z < -clip.w);
+            allFar = allFar && (clip.z > clip.w);
+        }
+
+        return !(allLeft || allRight || allBottom || allTop || allNear || allFar);
+    }
+
+    void CullAabbs(const Math3D::Vec3* boundsMin,
+                   const Math3D::Vec3* boundsMax,
+                   const std::uint8_t* flags,
+                   std::uint8_t testFlag,
+                   size_t count,
+                   const Math3D::Mat4& clipMatrix,
+                   std::vector<std::uint32_t>& outVisible){
+        if(count == 0 || !boundsMin || !boundsMax){
+            return;
+        }
+
+        size_t processed = 0;
+#if defined(FRUSTUM_CULLING_AVX2) || defined(FRUSTUM_CULLING_SSE2)
+        processed = cullSimdRange(boundsMin, boundsMax, flags, testFlag, count, toClipMatrix(clipMatrix), outVisible);
+#endif
+        cullScalarRange(boundsMin, boundsMax, flags, testFlag, processed, count, clipMatrix, outVisible);
+    }
+
+    const char* GetBackendName(){
+#if defined(FRUSTUM_CULLING_AVX2)
+        return "AVX2";
+#elif defined(FRUSTUM_CULLING_SSE2)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file src/Rendering/Core/FrustumCulling.h
+ * @brief Batched AABB-vs-clip-frustum tests shared by the render and shadow passes.
+ */
+
+#ifndef RENDERING_CORE_FRUSTUM_CULLING_H
+#define RENDERING_CORE_FRUSTUM_CULLING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Foundation/Math/Math3D.h"
+
+namespace FrustumCulling {
+    /**
+     * @brief Scalar reference test: transforms the 8 box corners to clip space and rejects
+     * the box only when every corner lies outside the same clip plane.
+     *
+     * Non-finite clip coordinates fail open (the box counts as visible).
+     * @param minV World-space box minimum.
+     * @param maxV World-space box maximum.
+     * @param clipMatrix Projection * view (or light view-projection) matrix.
+     * @return True when the box may be visible.
+     */
+    bool AabbIntersectsClip(const Math3D::Vec3& minV, const Math3D::Vec3& maxV, const Math3D::Mat4& clipMatrix);
+
+    /**
+     * @brief Appends the index of every potentially visible box to `outVisible`, in input order.
+     *
+     * Boxes are tested 8 (AVX2) or 4 (SSE2) at a time, with a scalar tail; results match
+     * AabbIntersectsClip() exactly. When `flags` is given, entries whose flag byte lacks
+     * `testFlag` skip the test and are always kept (for example items without bounds).
+     * @param boundsMin Box minimums, `count` entries.
+     * @param boundsMax Box maximums, `count` entries.
+     * @param flags Optional per-entry flag bytes, `count` entries.
+     * @param testFlag Bit that marks an entry as testable.
+     * @param count Number of entries.
+     * @param clipMatrix Clip matrix to test against.
+     * @param outVisible Receives visible indices (appended, not cleared).
+     */
+    void CullAabbs(const Math3D::Vec3* boundsMin,
+                   const Math3D::Vec3* boundsMax,
+                   const std::uint8_t* flags,
+                   std::uint8_t testFlag,
+                   size_t count,
+                   const Math3D::Mat4& clipMatrix,
+                   std::vector<std::uint32_t>& outVisible);
+
+    /**
+     * @brief Returns the instruction set CullAabbs() was built for.
+     * @return "AVX2", "SSE2" or "Scalar".
+     */
+    const char* GetBackendName();
+}
+
+#endif // RENDERING_CORE_FRUSTUM_CULLING_H
@@ -0,0 +1,137 @@
+/**
+ * @file src/Rendering/Core/FrustumCullingSelfTest.cpp
+ * @brief Implementation for FrustumCullingSelfTest.
+ */
+
+#include "Rendering/Core/FrustumCullingSelfTest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Foundation/Logging/Logbot.h"
+#include "Rendering/Core/FrustumCulling.h"
+
+namespace {
+    constexpr std::uint32_t kSeed = 0x5EEDC011u;
+    // Odd sizes exercise the scalar tail after the 8- and 4-wide batches.
+    constexpr size_t kBoxCounts[] = {0, 1, 3, 7, 8, 9, 31, 1000, 4099};
+    constexpr std::uint8_t kTestFlag = 1u << 6;
+    constexpr size_t kMaxLoggedMismatches = 8;
+
+    /// @brief Holds data for ClipCase.
+    struct ClipCase {
+        const char* name;
+        Math3D::Mat4 clip;
+    };
+
+    std::vector<ClipCase> buildClipCases(){
+        std::vector<ClipCase> cases;
+        const glm::vec3 up(0.0f, 1.0f, 0.0f);
+
+        const glm::mat4 cameraView = glm::lookAt(glm::vec3(0.0f, 2.0f, 10.0f), glm::vec3(0.0f, 0.0f, 0.0f), up);
+        cases.push_back({"camera", Math3D::Mat4(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f) * cameraView)});
+        cases.push_back({"camera-narrow", Math3D::Mat4(glm::perspective(glm::radians(15.0f), 1.0f, 1.0f, 30.0f) * cameraView)});
+
+        // Directional cascade: orthographic light view-projection, as ShadowRenderer builds it.
+        const glm::mat4 lightView = glm::lookAt(glm::vec3(20.0f, 40.0f, 20.0f), glm::vec3(0.0f, 0.0f, 0.0f), up);
+        cases.push_back({"cascade", Math3D::Mat4(glm::ortho(-25.0f, 25.0f, -25.0f, 25.0f, 1.0f, 120.0f) * lightView)});
+
+        // Spot light: square perspective looking straight down.
+        const glm::mat4 spotView = glm::lookAt(glm::vec3(5.0f, 15.0f, -5.0f), glm::vec3(5.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        cases.push_back({"spot", Math3D::Mat4(glm::perspective(glm::radians(70.0f), 1.0f, 0.5f, 40.0f) * spotView)});
+        return cases;
+    }
+
+    void buildBoxes(std::mt19937& rng,
+                    size_t count,
+                    std::vector<Math3D::Vec3>& outMin,
+                    std::vector<Math3D::Vec3>& outMax,
+                    std::vector<std::uint8_t>& outFlags){
+        std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+        std::uniform_real_distribution<float> extent(0.0f, 6.0f);
+        std::uniform_int_distribution<int> kind(0, 15);
+
+        outMin.resize(count);
+        outMax.resize(count);
+        outFlags.resize(count);
+        for(size_t i = 0; i < count; ++i){
+            const Math3D::Vec3 center(position(rng), position(rng) * 0.5f, position(rng));
+            Math3D::Vec3 half(extent(rng), extent(rng), extent(rng));
+            switch(kind(rng)){
+                case 0: half = Math3D::Vec3(0.0f, 0.0f, 0.0f); break;       // Degenerate point.
+                case 1: half = Math3D::Vec3(500.0f, 500.0f, 500.0f); break; // Encloses the camera.
+                default: break;
+            }
+            outMin[i] = center - half;
+            outMax[i] = center + half;
+            outFlags[i] = (kind(rng) == 0) ? 0 : kTestFlag;
+        }
+
+        // Non-finite bounds must fail open in both paths.
+        if(count > 2){
+            outMin[count / 2] = Math3D::Vec3(std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f);
+            outMax[count - 1] = Math3D::Vec3(std::numeric_limits<float>::infinity(), 1.0f, 1.0f);
+        }
+    }
+}
+
+FrustumCullingSelfTest::Result FrustumCullingSelfTest::Run(){
+    Result result;
+    std::mt19937 rng(kSeed);
+    const std::vector<ClipCase> clipCases = buildClipCases();
+
+    std::vector<Math3D::Vec3> boundsMin;
+    std::vector<Math3D::Vec3> boundsMax;
+    std::vector<std::uint8_t> flags;
+    std::vector<std::uint32_t> expected;
+    std::vector<std::uint32_t> actual;
+
+    for(size_t count : kBoxCounts){
+        buildBoxes(rng, count, boundsMin, boundsMax, flags);
+        for(const ClipCase& clipCase : clipCases){
+            for(int useFlags = 0; useFlags < 2; ++useFlags){
+                const std::uint8_t* flagData = useFlags ? flags.data() : nullptr;
+
+                expected.clear();
+                for(size_t i = 0; i < count; ++i){
+                    const bool tested = !flagData || (flagData[i] & kTestFlag);
+                    if(!tested || FrustumCulling::AabbIntersectsClip(boundsMin[i], boundsMax[i], clipCase.clip)){
+                        expected.push_back(static_cast<std::uint32_t>(i));
+                    }
+                }
+
+                // Seed the output so the append-only contract is checked too.
+                actual.assign(1, 0xFFFFFFFFu);
+                FrustumCulling::CullAabbs(boundsMin.data(), boundsMax.data(), flagData, kTestFlag, count, clipCase.clip, actual);
+
+                result.casesRun++;
+                result.boxesTested += count;
+                const bool same = actual.size() == expected.size() + 1 &&
+                                  actual.front() == 0xFFFFFFFFu &&
+                                  std::equal(expected.begin(), expected.end(), actual.begin() + 1);
+                if(!same){
+                    if(result.mismatches < kMaxLoggedMismatches){
+                        LogBot.Log(LOG_ERRO, "FrustumCulling self-test: %s, %llu boxes, flags %s: %llu visible expected, %llu returned.",
+                                   clipCase.name,
+                                   static_cast<unsigned long long>(count),
+                                   useFlags ? "on" : "off",
+                                   static_cast<unsigned long long>(expected.size()),
+                                   static_cast<unsigned long long>(actual.empty() ? 0 : actual.size() - 1));
+                    }
+                    result.mismatches++;
+                }
+            }
+        }
+    }
+
+    result.passed = result.mismatches == 0;
+    LogBot.Log(result.passed ? LOG_INFO : LOG_ERRO, "FrustumCulling self-test (%s): %llu case(s), %llu box test(s), %llu mismatch(es).",
+               FrustumCulling::GetBackendName(),
+               static_cast<unsigned long long>(result.casesRun),
+               static_cast<unsigned long long>(result.boxesTested),
+               static_cast<unsigned long long>(result.mismatches));
+    return result;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file src/Rendering/Core/FrustumCullingSelfTest.h
+ * @brief Declarations for FrustumCullingSelfTest.
+ */
+
+#ifndef RENDERING_CORE_FRUSTUM_CULLING_SELF_TEST_H
+#define RENDERING_CORE_FRUSTUM_CULLING_SELF_TEST_H
+
+#include <cstddef>
+
+/// @brief Golden comparison of the batched culler against the scalar AabbIntersectsClip() test.
+namespace FrustumCullingSelfTest {
+    /// @brief Holds data for Result.
+    struct Result {
+        bool passed = false;
+        size_t casesRun = 0;
+        size_t boxesTested = 0;
+        size_t mismatches = 0;
+    };
+
+    /**
+     * @brief Culls seeded random box sets against camera, cascade and spot-light matrices and
+     * checks every visible list index-for-index against the scalar reference. GL-free.
+     *
+     * Logs the first mismatches and a summary.
+     * @return Counts and the overall verdict.
+     */
+    Result Run();
+}
+
+#endif // RENDERING_CORE_FRUSTUM_CULLING_SELF_TEST_H
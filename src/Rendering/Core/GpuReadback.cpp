@@ -0,0 +1,182 @@
+/**
+ * @file src/Rendering/Core/GpuReadback.cpp
+ * @brief Implementation for GpuReadback.
+ */
+
+#include "Rendering/Core/GpuReadback.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Foundation/Math/Math3D.h"
+
+namespace {
+    GpuReadback::Stats g_readbackStats;
+
+    size_t componentsFor(GpuReadback::Format format){
+        return (format == GpuReadback::Format::Color) ? 4u : 1u;
+    }
+}
+
+GpuReadback::~GpuReadback(){
+    dispose();
+}
+
+bool GpuReadback::submit(PTexture texture, Format format, const std::vector<Tap>& taps){
+    if(!texture || texture->getID() == 0 || texture->getWidth() <= 0 || texture->getHeight() <= 0 || taps.empty()){
+        return false;
+    }
+    if(pending >= RING_SIZE){
+        g_readbackStats.skipped++;
+        return false;
+    }
+    if(readFbo == 0){
+        glGenFramebuffers(1, &readFbo);
+    }
+    if(readFbo == 0){
+        return false;
+    }
+
+    GLint prevReadFbo = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, readFbo);
+    if(format == Format::Depth){
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, texture->getID(), 0);
+        glReadBuffer(GL_NONE);
+    }else{
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, 0, 0);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->getID(), 0);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+    }
+    if(glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE){
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevReadFbo));
+        return false;
+    }
+
+    Slot& slot = slots[(head + pending) % RING_SIZE];
+    const size_t tapBytes = componentsFor(format) * sizeof(float);
+    const size_t byteCount = taps.size() * tapBytes;
+    if(slot.buffer == 0){
+        glGenBuffers(1, &slot.buffer);
+    }
+    if(slot.timestampQuery == 0){
+        glGenQueries(1, &slot.timestampQuery);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if(byteCount > slot.capacityBytes){
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(byteCount), nullptr, GL_STREAM_READ);
+        slot.capacityBytes = byteCount;
+    }
+
+    // GL_TIMESTAMP is the GPU clock now; the query below records when the reads actually ran.
+    glGetInteger64v(GL_TIMESTAMP, &slot.issueGpuTime);
+    const int maxX = texture->getWidth() - 1;
+    const int maxY = texture->getHeight() - 1;
+    const GLenum pixelFormat = (format == Format::Depth) ? GL_DEPTH_COMPONENT : GL_RGBA;
+    for(size_t i = 0; i < taps.size(); ++i){
+        const int x = Math3D::Clamp(taps[i].x, 0, maxX);
+        const int y = Math3D::Clamp(taps[i].y, 0, maxY);
+        glReadPixels(x, y, 1, 1, pixelFormat, GL_FLOAT, reinterpret_cast<void*>(i * tapBytes));
+    }
+    glQueryCounter(slot.timestampQuery, GL_TIMESTAMP);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.tapCount = taps.size();
+    slot.format = format;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevReadFbo));
+
+    pending++;
+    g_readbackStats.submitted++;
+    return true;
+}
+
+bool GpuReadback::poll(std::vector<float>& outValues, Format* outFormat){
+    bool completedAny = false;
+    while(pending > 0){
+        Slot& slot = slots[head];
+        const GLenum status = slot.fence ? glClientWaitSync(slot.fence, 0, 0) : GL_WAIT_FAILED;
+        if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED){
+            if(status == GL_WAIT_FAILED){
+                retire(slot, nullptr);
+                head = (head + 1) % RING_SIZE;
+                pending--;
+                continue;
+            }
+            break;
+        }
+
+        if(outFormat){
+            *outFormat = slot.format;
+        }
+        retire(slot, &outValues);
+        head = (head + 1) % RING_SIZE;
+        pending--;
+        completedAny = true;
+    }
+    return completedAny;
+}
+
+void GpuReadback::retire(Slot& slot, std::vector<float>* outValues){
+    if(outValues){
+        const size_t floatCount = slot.tapCount * componentsFor(slot.format);
+        outValues->resize(floatCount);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        const void* mapped = glMapBufferRange(
+            GL_PIXEL_PACK_BUFFER,
+            0,
+            static_cast<GLsizeiptr>(floatCount * sizeof(float)),
+            GL_MAP_READ_BIT
+        );
+        if(mapped){
+            std::memcpy(outValues->data(), mapped, floatCount * sizeof(float));
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }else{
+            std::fill(outValues->begin(), outValues->end(), 0.0f);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        GLint64 executedGpuTime = 0;
+        glGetQueryObjecti64v(slot.timestampQuery, GL_QUERY_RESULT, &executedGpuTime);
+        const GLint64 lagNs = executedGpuTime - slot.issueGpuTime;
+        if(lagNs > 0){
+            g_readbackStats.stallAvoidedMs += static_cast<double>(lagNs) / 1000000.0;
+        }
+        g_readbackStats.completed++;
+    }
+
+    if(slot.fence){
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+    slot.tapCount = 0;
+}
+
+void GpuReadback::dispose(){
+    for(Slot& slot : slots){
+        if(slot.fence){
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        if(slot.buffer != 0){
+            glDeleteBuffers(1, &slot.buffer);
+            slot.buffer = 0;
+        }
+        if(slot.timestampQuery != 0){
+            glDeleteQueries(1, &slot.timestampQuery);
+            slot.timestampQuery = 0;
+        }
+        slot.capacityBytes = 0;
+        slot.tapCount = 0;
+    }
+    head = 0;
+    pending = 0;
+    if(readFbo != 0){
+        glDeleteFramebuffers(1, &readFbo);
+        readFbo = 0;
+    }
+}
+
+GpuReadback::Stats GpuReadback::GetStats(){
+    return g_readbackStats;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file src/Rendering/Core/GpuReadback.h
+ * @brief Non-blocking pixel readback through a ring of pixel-pack buffers and fences.
+ */
+
+#ifndef RENDERING_CORE_GPU_READBACK_H
+#define RENDERING_CORE_GPU_READBACK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "Rendering/Textures/Texture.h"
+
+/**
+ * @brief Reads a handful of texels without stalling on the GPU.
+ *
+ * submit() records glReadPixels into a pixel-pack buffer and fences it; poll() hands back
+ * the newest request whose fence has signaled, typically one or two frames later. Each
+ * client owns its ring. When every slot is still in flight, submit() skips the request
+ * rather than waiting.
+ */
+class GpuReadback {
+    public:
+        /// @brief Requests kept in flight before submit() starts skipping.
+        static constexpr size_t RING_SIZE = 3;
+
+        /// @brief Enumerates values for Format.
+        enum class Format {
+            Depth, ///< One float per tap from the depth attachment.
+            Color  ///< Four floats (RGBA) per tap from color attachment 0.
+        };
+
+        /// @brief Holds data for Tap: one texel position, in pixels from the lower-left corner.
+        struct Tap {
+            int x = 0;
+            int y = 0;
+        };
+
+        /// @brief Holds data for Stats: process-wide totals across every readback ring.
+        struct Stats {
+            std::uint64_t submitted = 0;
+            std::uint64_t completed = 0;
+            std::uint64_t skipped = 0;
+            /// GPU time between issuing a read and the read executing, summed over completed reads;
+            /// a synchronous glReadPixels would have blocked the CPU for this long.
+            double stallAvoidedMs = 0.0;
+        };
+
+        GpuReadback() = default;
+        GpuReadback(const GpuReadback&) = delete;
+        GpuReadback& operator=(const GpuReadback&) = delete;
+        ~GpuReadback();
+
+        /**
+         * @brief Queues reads of `taps` from `texture`.
+         *
+         * The current read framebuffer binding is preserved.
+         * @param texture Texture to read; must be attachable as `format` requires.
+         * @param format Depth or color read.
+         * @param taps Texel positions, clamped to the texture.
+         * @return True when the request was queued.
+         */
+        bool submit(PTexture texture, Format format, const std::vector<Tap>& taps);
+
+        /**
+         * @brief Collects finished requests without blocking.
+         *
+         * Completed requests are retired oldest first; the newest one's values are returned.
+         * @param outValues Receives 1 (Depth) or 4 (Color) floats per tap of the returned request.
+         * @param outFormat Optional; receives the format of the returned request.
+         * @return True when at least one request completed since the last call.
+         */
+        bool poll(std::vector<float>& outValues, Format* outFormat = nullptr);
+
+        /**
+         * @brief Drops pending requests and releases GL objects.
+         */
+        void dispose();
+
+        /**
+         * @brief Returns process-wide readback totals.
+         * @return Accumulated counters.
+         */
+        static Stats GetStats();
+
+    private:
+        /// @brief Holds data for Slot: one in-flight request.
+        struct Slot {
+            GLuint buffer = 0;
+            GLuint timestampQuery = 0;
+            size_t capacityBytes = 0;
+            GLsync fence = nullptr;
+            GLint64 issueGpuTime = 0;
+            size_t tapCount = 0;
+            Format format = Format::Depth;
+        };
+
+        std::array<Slot, RING_SIZE> slots{};
+        size_t head = 0;
+        size_t pending = 0;
+        GLuint readFbo = 0;
+
+        void retire(Slot& slot, std::vector<float>* outValues);
+};
+
+#endif // RENDERING_CORE_GPU_READBACK_H
@@ -21,7 +21,7 @@ void FreeTypeFont::_initFont(){
         return;
     }
 
-    BinaryBuffer rawData = assetPtr->asRaw();
+    const ByteView rawData = assetPtr->view();
     if(rawData.empty()){
         Font::FontLogger.Log(LOG_ERRO, "[Free Type] Font asset empty.");
         FT_Done_FreeType(ft);
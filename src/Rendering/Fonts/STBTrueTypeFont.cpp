@@ -35,7 +35,7 @@ void TrueTypeFont::_initFont(){
     }
 
     // 2. Load the font data
-    BinaryBuffer rawData = assetPtr->asRaw();
+    const ByteView rawData = assetPtr->view();
     if(rawData.empty()){
         Font::FontLogger.Log(LOG_ERRO, "Font asset empty.");
         stbtt_PackEnd(&pc);
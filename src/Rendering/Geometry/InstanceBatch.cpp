@@ -0,0 +1,63 @@
+/**
+ * @file src/Rendering/Geometry/InstanceBatch.cpp
+ * @brief Implementation for InstanceBatch.
+ */
+
+#include "Rendering/Geometry/InstanceBatch.h"
+
+#include <cstring>
+
+void InstanceBatch::begin(){
+    staged.clear();
+}
+
+size_t InstanceBatch::add(const Math3D::Mat4& model){
+    const size_t index = size();
+    const size_t offset = staged.size();
+    staged.resize(offset + 16);
+    std::memcpy(staged.data() + offset, glm::value_ptr(model.data), sizeof(float) * 16);
+    return index;
+}
+
+void InstanceBatch::upload(){
+    if(staged.empty()){
+        return;
+    }
+
+    const size_t byteCount = staged.size() * sizeof(float);
+    if(buffer == 0){
+        glGenBuffers(1, &buffer);
+    }
+    if(byteCount > capacityBytes){
+        capacityBytes = byteCount + (byteCount / 2);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacityBytes), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(byteCount), staged.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBatch::draw(Mesh& mesh, size_t first, size_t count) const{
+    if(count == 0 || first + count > size()){
+        return;
+    }
+    mesh.drawInstanced(buffer, first, static_cast<int>(count));
+}
+
+void InstanceBatch::dispose(){
+    if(buffer != 0){
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+    capacityBytes = 0;
+    staged.clear();
+}
+
+bool InstanceBatch::SupportsInstancing(const std::shared_ptr<ShaderProgram>& program){
+    if(!program || program->getID() == 0){
+        return false;
+    }
+
+    // Cached on the program itself, so a recompiled or recycled program id never answers for another program.
+    return program->getAttributeLocation("aInstanceModel") == static_cast<GLint>(Mesh::INSTANCE_MODEL_ATTRIBUTE);
+}
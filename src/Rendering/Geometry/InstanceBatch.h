@@ -0,0 +1,82 @@
+/**
+ * @file src/Rendering/Geometry/InstanceBatch.h
+ * @brief Declarations for InstanceBatch.
+ */
+
+#ifndef INSTANCE_BATCH_H
+#define INSTANCE_BATCH_H
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Foundation/Math/Math3D.h"
+#include "Rendering/Geometry/Mesh.h"
+#include "Rendering/Shaders/ShaderProgram.h"
+
+/**
+ * @brief Stages per-instance model matrices for a pass and draws meshes from them.
+ *
+ * Callers group their draws into runs, add() every matrix of the runs they want instanced,
+ * upload() once, then draw() each run. The buffer is orphaned on every upload, so a batch can
+ * be refilled several times per frame without waiting on the GPU.
+ */
+class InstanceBatch {
+    public:
+        /// @brief Runs shorter than this are cheaper as plain draws.
+        static constexpr size_t MIN_INSTANCES = 2;
+
+        /**
+         * @brief Drops every staged matrix.
+         */
+        void begin();
+
+        /**
+         * @brief Stages one instance matrix.
+         * @param model World matrix of the instance.
+         * @return Instance index to pass to draw().
+         */
+        size_t add(const Math3D::Mat4& model);
+
+        /**
+         * @brief Uploads the staged matrices to the GPU buffer.
+         */
+        void upload();
+
+        /**
+         * @brief Draws `count` instances of `mesh` starting at staged instance `first`.
+         * @param mesh Mesh to draw.
+         * @param first First staged instance.
+         * @param count Instance count.
+         */
+        void draw(Mesh& mesh, size_t first, size_t count) const;
+
+        /**
+         * @brief Returns how many matrices are staged.
+         * @return Staged instance count.
+         */
+        size_t size() const { return staged.size() / 16; }
+
+        /**
+         * @brief Releases the GPU buffer.
+         */
+        void dispose();
+
+        /**
+         * @brief Returns whether a program reads `aInstanceModel` at Mesh::INSTANCE_MODEL_ATTRIBUTE.
+         *
+         * Custom shaders without the attribute fall back to one draw per item.
+         * @param program Program to test; the lookup is cached on the program until it recompiles.
+         * @return True when the program can draw instanced.
+         */
+        static bool SupportsInstancing(const std::shared_ptr<ShaderProgram>& program);
+
+    private:
+        std::vector<float> staged;
+        GLuint buffer = 0;
+        size_t capacityBytes = 0;
+};
+
+#endif // INSTANCE_BATCH_H
@@ -6,17 +6,24 @@
 
 #include "Rendering/Geometry/Mesh.h"
 
+#include <atomic>
 #include <stdexcept> 
 #include <cfloat>
 #include <cmath>
 #include <utility>
 
+namespace {
+    // Shared across meshes so a new mesh reusing a freed address never repeats a stamp.
+    std::atomic<std::uint64_t> g_nextMeshRevision{1};
+}
+
 
 void Mesh::upload(const std::vector<Vertex>& verts, const std::vector<uint32_t>& faces, GLenum usage){
     this->faces = faces;
     this->verticies = verts;
     computeTangents();
     computeLocalBounds();
+    revision = g_nextMeshRevision.fetch_add(1, std::memory_order_relaxed);
 
     if(!_areBuffersBound()){
         _genBuffers(usage);
@@ -54,6 +61,7 @@ void Mesh::upload(std::vector<Vertex>&& verts, std::vector<uint32_t>&& faces, GL
     this->verticies = std::move(verts);
     computeTangents();
     computeLocalBounds();
+    revision = g_nextMeshRevision.fetch_add(1, std::memory_order_relaxed);
 
     if(!_areBuffersBound()){
         _genBuffers(usage);
@@ -88,11 +96,27 @@ void Mesh::upload(std::vector<Vertex>&& verts, std::vector<uint32_t>&& faces, GL
 
 void Mesh::reload(){
     _genBuffers(GL_STATIC_DRAW);
+    revision = g_nextMeshRevision.fetch_add(1, std::memory_order_relaxed);
 }
 
 namespace {
     GLuint g_lastBoundVao = 0;
 
+    // Current (non-array) attribute values are context state: with the instance columns set to
+    // identity, non-instanced draws of instancing-aware shaders reduce to `u_model`. An instanced
+    // draw can leave them undefined, so they are restored after every one.
+    void setInstanceAttributeDefaults(){
+        for(GLuint column = 0; column < 4; ++column){
+            glVertexAttrib4f(
+                Mesh::INSTANCE_MODEL_ATTRIBUTE + column,
+                column == 0 ? 1.0f : 0.0f,
+                column == 1 ? 1.0f : 0.0f,
+                column == 2 ? 1.0f : 0.0f,
+                column == 3 ? 1.0f : 0.0f
+            );
+        }
+    }
+
     glm::vec3 safeNormalizeVec3(const glm::vec3& value, const glm::vec3& fallback){
         float lenSq = glm::dot(value, value);
         if(lenSq <= 1e-12f){
@@ -129,6 +153,35 @@ void Mesh::draw(const Math3D::Mat4& parent, const Math3D::Mat4& view, const Math
     glDrawElements(GL_TRIANGLES, this->faces.size(), GL_UNSIGNED_INT, 0);
 }
 
+void Mesh::drawInstanced(GLuint instanceBuffer, size_t firstInstance, int instanceCount){
+    if(instanceBuffer == 0 || instanceCount <= 0){
+        return;
+    }
+
+    this->bind();
+    // No base-instance draws on GL 4.1, so the attribute offset selects the first matrix.
+    const size_t matrixBytes = sizeof(float) * 16;
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for(GLuint column = 0; column < 4; ++column){
+        const GLuint attribute = INSTANCE_MODEL_ATTRIBUTE + column;
+        glVertexAttribPointer(
+            attribute,
+            4,
+            GL_FLOAT,
+            GL_FALSE,
+            static_cast<GLsizei>(matrixBytes),
+            (void*)(firstInstance * matrixBytes + column * sizeof(float) * 4)
+        );
+        glVertexAttribDivisor(attribute, 1);
+        glEnableVertexAttribArray(attribute);
+    }
+    glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(this->faces.size()), GL_UNSIGNED_INT, 0, instanceCount);
+    for(GLuint column = 0; column < 4; ++column){
+        glDisableVertexAttribArray(INSTANCE_MODEL_ATTRIBUTE + column);
+    }
+    setInstanceAttributeDefaults();
+}
+
 Mesh::~Mesh(){
     dispose();
 }
@@ -138,6 +191,7 @@ void Mesh::_genBuffers(GLenum usage){
     if(_areBuffersBound()){
         dispose(); // time to rebind.
     }
+    setInstanceAttributeDefaults();
 
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -323,6 +377,10 @@ bool Mesh::getLocalBounds(Math3D::Vec3& outMin, Math3D::Vec3& outMax) const{
 }
 
 void Mesh::dispose(){
+    // Never-uploaded meshes (headless scenes, benchmarks) own nothing and may outlive any GL context.
+    if(this->VAO == 0 && this->VBO == 0 && this->tangentVBO == 0 && this->EBO == 0){
+        return;
+    }
     if(g_lastBoundVao == this->VAO){
         g_lastBoundVao = 0;
     }
@@ -330,6 +388,10 @@ void Mesh::dispose(){
     glDeleteBuffers(1,&(this->VBO));
     glDeleteBuffers(1,&(this->tangentVBO));
     glDeleteBuffers(1,&(this->EBO));
+    this->VAO = 0;
+    this->VBO = 0;
+    this->tangentVBO = 0;
+    this->EBO = 0;
 }
 
 void Mesh::Unbind(){
@@ -240,6 +240,7 @@ class Mesh : public IDrawable{
         Math3D::Vec3 localBoundsMin = Math3D::Vec3(0.0f, 0.0f, 0.0f);
         Math3D::Vec3 localBoundsMax = Math3D::Vec3(0.0f, 0.0f, 0.0f);
         bool hasLocalBounds = false;
+        std::uint64_t revision = 0;
 
         /**
          * @brief Generates mesh GPU buffers.
@@ -272,12 +273,25 @@ class Mesh : public IDrawable{
         void upload(std::vector<Vertex>&& verts, std::vector<uint32_t>&& faces, GLenum usage = GL_STATIC_DRAW);
         void reload();
 
+        /// @brief First of the four vertex attributes (one per column) carrying `aInstanceModel`.
+        static constexpr GLuint INSTANCE_MODEL_ATTRIBUTE = 5;
+
         void bind();
         void draw(
             const Math3D::Mat4& parent = Math3D::Mat4(),
             const Math3D::Mat4& view = Math3D::Mat4(),
             const Math3D::Mat4& projection = Math3D::Mat4()
         ) override;
+        /**
+         * @brief Draws several copies in one call, one column-major model matrix per instance.
+         *
+         * Shaders multiply `u_model` by `aInstanceModel`; outside this call the attribute reads
+         * identity, so plain draws keep using `u_model` alone.
+         * @param instanceBuffer Buffer of tightly packed 4x4 float matrices.
+         * @param firstInstance Index of the first matrix used.
+         * @param instanceCount Number of instances to draw.
+         */
+        void drawInstanced(GLuint instanceBuffer, size_t firstInstance, int instanceCount);
 
         void dispose();
         
@@ -290,6 +304,11 @@ class Mesh : public IDrawable{
         std::vector<Vertex>& getVertecies() {return this->verticies;}
         const std::vector<uint32_t>& getFaces() const { return faces; }
         bool getLocalBounds(Math3D::Vec3& outMin, Math3D::Vec3& outMax) const;
+        /**
+         * @brief Returns a process-unique stamp that changes whenever the GPU geometry is re-uploaded.
+         * @return Revision stamp, 0 before the first upload.
+         */
+        std::uint64_t getRevision() const { return revision; }
 
         static void Unbind();
 
@@ -25,7 +25,8 @@ enum class ShadowType {
     Smooth
 };
 
-#define MAX_LIGHTS 128
+// Upper bound on lights uploaded per frame; shaders read them through clustered lists.
+#define MAX_LIGHTS 4096
 
 /// @brief Holds data for Light.
 struct Light {
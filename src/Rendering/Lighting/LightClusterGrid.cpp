@@ -0,0 +1,384 @@
+/**
+ * @file src/Rendering/Lighting/LightClusterGrid.cpp
+ * @brief Implementation for LightClusterGrid.
+ */
+
+#include "Rendering/Lighting/LightClusterGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Foundation/Threading/WorkerPool.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define LIGHT_CLUSTER_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LIGHT_CLUSTER_SSE2 1
+#endif
+
+namespace {
+    // Light bounds grow slightly so fragments on a cluster face never miss a light through
+    // rounding differences between the CPU bounds and the shader's cluster lookup.
+    constexpr float kRadiusPaddingScale = 1.001f;
+    constexpr float kRadiusPaddingBias = 0.01f;
+    // Wider cones fall back to the sphere test; the cone test assumes a half angle below 90.
+    constexpr float kMaxConeTestAngleDegrees = 89.0f;
+
+    /// @brief Holds per-row constants shared by every cluster in one (slice, y) row.
+    struct RowBounds {
+        float distanceSq = 0.0f;   // squared sphere distance along y and z
+        float radiusSq = 0.0f;
+        float extentSq = 0.0f;     // squared half extents of the cluster along y and z
+        float offsetSq = 0.0f;     // squared light-to-cluster-center offset along y and z
+        float axialOffset = 0.0f;  // light-to-cluster-center offset along y and z, dotted with the cone axis
+    };
+
+    void transformPoint(const glm::mat4& m, float x, float y, float z, float w, float out[3]){
+        for(int row = 0; row < 3; ++row){
+            out[row] = (m[0][row] * x) + (m[1][row] * y) + (m[2][row] * z) + (m[3][row] * w);
+        }
+    }
+
+    bool isFinite(const Math3D::Vec3& v){
+        return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+    }
+
+    template<typename LightT>
+    bool clusterHitScalar(const LightT& light, const RowBounds& row, float minX, float maxX){
+        const float dx = std::max(std::max(minX - light.center[0], light.center[0] - maxX), 0.0f);
+        if(row.distanceSq + (dx * dx) > row.radiusSq){
+            return false;
+        }
+        if(!light.cone){
+            return true;
+        }
+
+        // Cone against the cluster's bounding sphere: signed distance to the cone surface,
+        // plus a reject for clusters wholly behind the apex.
+        const float halfX = 0.5f * (maxX - minX);
+        const float boundRadius = std::sqrt((halfX * halfX) + row.extentSq);
+        const float offsetX = (0.5f * (minX + maxX)) - light.center[0];
+        const float offsetSq = (offsetX * offsetX) + row.offsetSq;
+        const float axial = (offsetX * light.axis[0]) + row.axialOffset;
+        const float lateral = std::sqrt(std::max(offsetSq - (axial * axial), 0.0f));
+        const float coneDistance = (light.cosAngle * lateral) - (axial * light.sinAngle);
+        return coneDistance <= boundRadius && axial >= -boundRadius;
+    }
+
+#if defined(LIGHT_CLUSTER_AVX2)
+    constexpr int kLaneCount = 8;
+    typedef __m256 LaneFloat;
+
+    inline LaneFloat laneSet1(float v){ return _mm256_set1_ps(v); }
+    inline LaneFloat laneLoad(const float* p){ return _mm256_loadu_ps(p); }
+    inline LaneFloat laneAdd(LaneFloat a, LaneFloat b){ return _mm256_add_ps(a, b); }
+    inline LaneFloat laneSub(LaneFloat a, LaneFloat b){ return _mm256_sub_ps(a, b); }
+    inline LaneFloat laneMul(LaneFloat a, LaneFloat b){ return _mm256_mul_ps(a, b); }
+    inline LaneFloat laneMax(LaneFloat a, LaneFloat b){ return _mm256_max_ps(a, b); }
+    inline LaneFloat laneSqrt(LaneFloat a){ return _mm256_sqrt_ps(a); }
+    inline LaneFloat laneAnd(LaneFloat a, LaneFloat b){ return _mm256_and_ps(a, b); }
+    inline LaneFloat laneLessEqual(LaneFloat a, LaneFloat b){ return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    inline int laneMoveMask(LaneFloat v){ return _mm256_movemask_ps(v); }
+#elif defined(LIGHT_CLUSTER_SSE2)
+    constexpr int kLaneCount = 4;
+    typedef __m128 LaneFloat;
+
+    inline LaneFloat laneSet1(float v){ return _mm_set1_ps(v); }
+    inline LaneFloat laneLoad(const float* p){ return _mm_loadu_ps(p); }
+    inline LaneFloat laneAdd(LaneFloat a, LaneFloat b){ return _mm_add_ps(a, b); }
+    inline LaneFloat laneSub(LaneFloat a, LaneFloat b){ return _mm_sub_ps(a, b); }
+    inline LaneFloat laneMul(LaneFloat a, LaneFloat b){ return _mm_mul_ps(a, b); }
+    inline LaneFloat laneMax(LaneFloat a, LaneFloat b){ return _mm_max_ps(a, b); }
+    inline LaneFloat laneSqrt(LaneFloat a){ return _mm_sqrt_ps(a); }
+    inline LaneFloat laneAnd(LaneFloat a, LaneFloat b){ return _mm_and_ps(a, b); }
+    inline LaneFloat laneLessEqual(LaneFloat a, LaneFloat b){ return _mm_cmple_ps(a, b); }
+    inline int laneMoveMask(LaneFloat v){ return _mm_movemask_ps(v); }
+#endif
+
+    // Tests one row of clusters against a light and returns the x of every hit, in order.
+    // SIMD lanes follow the scalar operation order, so both paths agree exactly.
+    template<typename LightT>
+    void collectRowHits(const LightT& light,
+                        const RowBounds& row,
+                        const float* minX,
+                        const float* maxX,
+                        int tilesX,
+                        std::vector<std::uint32_t>& outHits){
+        int x = 0;
+#if defined(LIGHT_CLUSTER_AVX2) || defined(LIGHT_CLUSTER_SSE2)
+        const LaneFloat centerX = laneSet1(light.center[0]);
+        const LaneFloat zero = laneSet1(0.0f);
+        const LaneFloat half = laneSet1(0.5f);
+        const LaneFloat distanceSq = laneSet1(row.distanceSq);
+        const LaneFloat radiusSq = laneSet1(row.radiusSq);
+        for(; x + kLaneCount <= tilesX; x += kLaneCount){
+            const LaneFloat laneMinX = laneLoad(minX + x);
+            const LaneFloat laneMaxX = laneLoad(maxX + x);
+            const LaneFloat dx = laneMax(laneMax(laneSub(laneMinX, centerX), laneSub(centerX, laneMaxX)), zero);
+            LaneFloat hit = laneLessEqual(laneAdd(distanceSq, laneMul(dx, dx)), radiusSq);
+
+            if(light.cone && laneMoveMask(hit) != 0){
+                const LaneFloat halfX = laneMul(half, laneSub(laneMaxX, laneMinX));
+                const LaneFloat boundRadius = laneSqrt(laneAdd(laneMul(halfX, halfX), laneSet1(row.extentSq)));
+                const LaneFloat offsetX = laneSub(laneMul(half, laneAdd(laneMinX, laneMaxX)), centerX);
+                const LaneFloat offsetSq = laneAdd(laneMul(offsetX, offsetX), laneSet1(row.offsetSq));
+                const LaneFloat axial = laneAdd(laneMul(offsetX, laneSet1(light.axis[0])), laneSet1(row.axialOffset));
+                const LaneFloat lateral = laneSqrt(laneMax(laneSub(offsetSq, laneMul(axial, axial)), zero));
+                const LaneFloat coneDistance = laneSub(
+                    laneMul(laneSet1(light.cosAngle), lateral),
+                    laneMul(axial, laneSet1(light.sinAngle))
+                );
+                hit = laneAnd(hit, laneLessEqual(coneDistance, boundRadius));
+                hit = laneAnd(hit, laneLessEqual(laneSub(zero, boundRadius), axial));
+            }
+
+            int mask = laneMoveMask(hit);
+            while(mask != 0){
+                int lane = 0;
+                while(((mask >> lane) & 1) == 0){
+                    ++lane;
+                }
+                outHits.push_back(static_cast<std::uint32_t>(x + lane));
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for(; x < tilesX; ++x){
+            if(clusterHitScalar(light, row, minX[x], maxX[x])){
+                outHits.push_back(static_cast<std::uint32_t>(x));
+            }
+        }
+    }
+}
+
+void LightClusterGrid::clear(){
+    valid = false;
+    tilesX = 0;
+    tilesY = 0;
+    clusterOffsets.clear();
+    clusterCounts.clear();
+    lightIndices.clear();
+}
+
+int LightClusterGrid::sliceForDepth(float depth) const {
+    if(!(depth > 0.0f)){
+        return 0;
+    }
+    const int slice = static_cast<int>(std::floor((std::log(depth) * sliceScale) + sliceBias));
+    return std::min(std::max(slice, 0), SliceCount - 1);
+}
+
+bool LightClusterGrid::build(const Math3D::Mat4& newViewMatrix,
+                             float fovDegrees,
+                             float aspect,
+                             float newNearPlane,
+                             float newFarPlane,
+                             int newViewportWidth,
+                             int newViewportHeight,
+                             const std::vector<Light>& lights){
+    const bool usable =
+        newViewportWidth > 0 && newViewportHeight > 0 &&
+        std::isfinite(fovDegrees) && fovDegrees > 0.0f && fovDegrees < 180.0f &&
+        std::isfinite(aspect) && aspect > 0.0f &&
+        std::isfinite(newNearPlane) && std::isfinite(newFarPlane) &&
+        newNearPlane > 0.0f && newFarPlane > newNearPlane;
+    if(!usable){
+        clear();
+        return false;
+    }
+
+    viewMatrix = newViewMatrix;
+    viewportWidth = newViewportWidth;
+    viewportHeight = newViewportHeight;
+    nearPlane = newNearPlane;
+    farPlane = newFarPlane;
+    tilesX = (viewportWidth + TileSize - 1) / TileSize;
+    tilesY = (viewportHeight + TileSize - 1) / TileSize;
+    tanHalfFovY = std::tan(fovDegrees * 0.5f * (Math3D::PI / 180.0f));
+    tanHalfFovX = tanHalfFovY * aspect;
+
+    const float depthRatio = farPlane / nearPlane;
+    sliceScale = static_cast<float>(SliceCount) / std::log(depthRatio);
+    sliceBias = -std::log(nearPlane) * sliceScale;
+
+    sliceNear.resize(SliceCount);
+    sliceFar.resize(SliceCount);
+    for(int slice = 0; slice < SliceCount; ++slice){
+        sliceNear[slice] = nearPlane * std::pow(depthRatio, static_cast<float>(slice) / SliceCount);
+        sliceFar[slice] = (slice + 1 < SliceCount)
+            ? nearPlane * std::pow(depthRatio, static_cast<float>(slice + 1) / SliceCount)
+            : farPlane;
+    }
+
+    // A tile spans an NDC interval; its view-space extent at depth z is ndc * z * tan(fov / 2),
+    // so the widest point of each froxel sits on its near or far face depending on the sign.
+    auto fillAxisBounds = [&](std::vector<float>& outMin, std::vector<float>& outMax, int tileCount, int pixels, float tanHalfFov){
+        outMin.resize(static_cast<size_t>(tileCount) * SliceCount);
+        outMax.resize(static_cast<size_t>(tileCount) * SliceCount);
+        for(int slice = 0; slice < SliceCount; ++slice){
+            for(int tile = 0; tile < tileCount; ++tile){
+                const float ndcMin = ((static_cast<float>(tile * TileSize) / pixels) * 2.0f) - 1.0f;
+                const float ndcMax = std::min(1.0f, ((static_cast<float>((tile + 1) * TileSize) / pixels) * 2.0f) - 1.0f);
+                const size_t index = (static_cast<size_t>(slice) * tileCount) + tile;
+                outMin[index] = ndcMin * tanHalfFov * ((ndcMin < 0.0f) ? sliceFar[slice] : sliceNear[slice]);
+                outMax[index] = ndcMax * tanHalfFov * ((ndcMax > 0.0f) ? sliceFar[slice] : sliceNear[slice]);
+            }
+        }
+    };
+    fillAxisBounds(boundsMinX, boundsMaxX, tilesX, viewportWidth, tanHalfFovX);
+    fillAxisBounds(boundsMinY, boundsMaxY, tilesY, viewportHeight, tanHalfFovY);
+
+    const glm::mat4 view = static_cast<glm::mat4>(viewMatrix);
+    frameLights.assign(lights.size(), ClusterLight());
+    sliceLights.resize(SliceCount);
+    for(auto& bucket : sliceLights){
+        bucket.clear();
+    }
+
+    for(size_t i = 0; i < lights.size(); ++i){
+        const Light& light = lights[i];
+        ClusterLight& clusterLight = frameLights[i];
+        int firstSlice = 0;
+        int lastSlice = SliceCount - 1;
+
+        if(light.type == LightType::DIRECTIONAL || !isFinite(light.position) || !std::isfinite(light.range)){
+            // Non-finite lights are sanitized at upload, so keep them everywhere rather than guess.
+            clusterLight.global = true;
+        }else{
+            clusterLight.radius = (Math3D::Max(light.range, 0.1f) * kRadiusPaddingScale) + kRadiusPaddingBias;
+            transformPoint(view, light.position.x, light.position.y, light.position.z, 1.0f, clusterLight.center);
+
+            const float depth = -clusterLight.center[2];
+            if(depth + clusterLight.radius < nearPlane || depth - clusterLight.radius > farPlane){
+                continue;
+            }
+            firstSlice = sliceForDepth(Math3D::Max(depth - clusterLight.radius, nearPlane));
+            lastSlice = sliceForDepth(Math3D::Min(depth + clusterLight.radius, farPlane));
+
+            const float spotAngle = std::isfinite(light.spotAngle) ? Math3D::Clamp(light.spotAngle, 1.0f, 170.0f) : 170.0f;
+            if(light.type == LightType::SPOT && spotAngle < kMaxConeTestAngleDegrees && isFinite(light.direction)){
+                float axis[3];
+                transformPoint(view, light.direction.x, light.direction.y, light.direction.z, 0.0f, axis);
+                const float axisLength = std::sqrt((axis[0] * axis[0]) + (axis[1] * axis[1]) + (axis[2] * axis[2]));
+                if(axisLength > Math3D::EPSILON){
+                    const float angle = spotAngle * (Math3D::PI / 180.0f);
+                    for(int axisIndex = 0; axisIndex < 3; ++axisIndex){
+                        clusterLight.axis[axisIndex] = axis[axisIndex] / axisLength;
+                    }
+                    clusterLight.cosAngle = std::cos(angle);
+                    clusterLight.sinAngle = std::sin(angle);
+                    clusterLight.cone = true;
+                }
+            }
+        }
+
+        for(int slice = firstSlice; slice <= lastSlice; ++slice){
+            sliceLights[slice].push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    sliceBins.resize(SliceCount);
+    WorkerPool::Instance().parallelFor(static_cast<size_t>(SliceCount), 1, [&](size_t, size_t begin, size_t end){
+        for(size_t slice = begin; slice < end; ++slice){
+            binSlice(static_cast<int>(slice));
+        }
+    });
+
+    const size_t clustersPerSlice = static_cast<size_t>(tilesX) * tilesY;
+    clusterOffsets.resize(clustersPerSlice * SliceCount);
+    clusterCounts.resize(clustersPerSlice * SliceCount);
+    size_t totalIndices = 0;
+    for(const SliceBins& bins : sliceBins){
+        totalIndices += bins.indices.size();
+    }
+    lightIndices.resize(totalIndices);
+
+    std::uint32_t running = 0;
+    for(int slice = 0; slice < SliceCount; ++slice){
+        const SliceBins& bins = sliceBins[slice];
+        std::copy(bins.indices.begin(), bins.indices.end(), lightIndices.begin() + running);
+        for(size_t local = 0; local < clustersPerSlice; ++local){
+            const size_t cluster = (static_cast<size_t>(slice) * clustersPerSlice) + local;
+            clusterOffsets[cluster] = running;
+            clusterCounts[cluster] = bins.counts[local];
+            running += bins.counts[local];
+        }
+    }
+
+    valid = true;
+    return true;
+}
+
+void LightClusterGrid::binSlice(int slice){
+    SliceBins& bins = sliceBins[slice];
+    bins.hitClusters.clear();
+    bins.hitLights.clear();
+
+    const std::uint32_t clustersPerSlice = static_cast<std::uint32_t>(tilesX * tilesY);
+    const float* minX = boundsMinX.data() + (static_cast<size_t>(slice) * tilesX);
+    const float* maxX = boundsMaxX.data() + (static_cast<size_t>(slice) * tilesX);
+    const float* minY = boundsMinY.data() + (static_cast<size_t>(slice) * tilesY);
+    const float* maxY = boundsMaxY.data() + (static_cast<size_t>(slice) * tilesY);
+    const float minZ = -sliceFar[slice];
+    const float maxZ = -sliceNear[slice];
+    const float centerZ = 0.5f * (minZ + maxZ);
+    const float halfZ = 0.5f * (maxZ - minZ);
+
+    std::vector<std::uint32_t> rowHits;
+    rowHits.reserve(static_cast<size_t>(tilesX));
+    for(std::uint32_t lightIndex : sliceLights[slice]){
+        const ClusterLight& light = frameLights[lightIndex];
+        if(light.global){
+            for(std::uint32_t cluster = 0; cluster < clustersPerSlice; ++cluster){
+                bins.hitClusters.push_back(cluster);
+                bins.hitLights.push_back(lightIndex);
+            }
+            continue;
+        }
+
+        const float dz = std::max(std::max(minZ - light.center[2], light.center[2] - maxZ), 0.0f);
+        const float radiusSq = light.radius * light.radius;
+        const float offsetZ = centerZ - light.center[2];
+        for(int y = 0; y < tilesY; ++y){
+            const float dy = std::max(std::max(minY[y] - light.center[1], light.center[1] - maxY[y]), 0.0f);
+            RowBounds row;
+            row.distanceSq = (dy * dy) + (dz * dz);
+            row.radiusSq = radiusSq;
+            if(row.distanceSq > radiusSq){
+                continue;
+            }
+
+            const float halfY = 0.5f * (maxY[y] - minY[y]);
+            const float offsetY = (0.5f * (minY[y] + maxY[y])) - light.center[1];
+            row.extentSq = (halfY * halfY) + (halfZ * halfZ);
+            row.offsetSq = (offsetY * offsetY) + (offsetZ * offsetZ);
+            row.axialOffset = (offsetY * light.axis[1]) + (offsetZ * light.axis[2]);
+
+            rowHits.clear();
+            collectRowHits(light, row, minX, maxX, tilesX, rowHits);
+            const std::uint32_t rowBase = static_cast<std::uint32_t>(y * tilesX);
+            for(std::uint32_t x : rowHits){
+                bins.hitClusters.push_back(rowBase + x);
+                bins.hitLights.push_back(lightIndex);
+            }
+        }
+    }
+
+    // Stable counting sort by cluster keeps each cluster's lights in ascending order.
+    bins.counts.assign(clustersPerSlice, 0u);
+    for(std::uint32_t cluster : bins.hitClusters){
+        bins.counts[cluster]++;
+    }
+    std::vector<std::uint32_t> cursor(clustersPerSlice, 0u);
+    std::uint32_t running = 0;
+    for(std::uint32_t cluster = 0; cluster < clustersPerSlice; ++cluster){
+        cursor[cluster] = running;
+        running += bins.counts[cluster];
+    }
+    bins.indices.resize(bins.hitClusters.size());
+    for(size_t hit = 0; hit < bins.hitClusters.size(); ++hit){
+        bins.indices[cursor[bins.hitClusters[hit]]++] = bins.hitLights[hit];
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file src/Rendering/Lighting/LightClusterGrid.h
+ * @brief Depth-sliced froxel grid that bins lights for clustered shading.
+ */
+
+#ifndef RENDERING_LIGHTING_LIGHT_CLUSTER_GRID_H
+#define RENDERING_LIGHTING_LIGHT_CLUSTER_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Rendering/Lighting/Light.h"
+
+/**
+ * @brief Bins lights into view-space clusters: screen tiles split into logarithmic depth slices.
+ *
+ * Every cluster stores an offset/count range into one shared light index list. Point lights
+ * are tested as spheres and spot lights as cones against each cluster's bounds, several
+ * clusters per SIMD lane set; directional lights land in every cluster. Slices are binned on
+ * WorkerPool threads. Shaders locate a cluster from a world position with the same view
+ * matrix and projection parameters, so lookups stay correct for any camera that renders
+ * with the uploaded light list. Has no GL dependency.
+ */
+class LightClusterGrid {
+    public:
+        static constexpr int TileSize = 64;
+        static constexpr int SliceCount = 24;
+
+        /**
+         * @brief Rebuilds every cluster for one view.
+         * @param viewMatrix World-to-view matrix of the camera.
+         * @param fovDegrees Vertical field of view.
+         * @param aspect Viewport width / height.
+         * @param nearPlane First slice start (view-space depth).
+         * @param farPlane Last slice end (view-space depth).
+         * @param viewportWidth Viewport width in pixels.
+         * @param viewportHeight Viewport height in pixels.
+         * @param lights Lights to bin; cluster entries are indices into this list.
+         * @return False when the view is degenerate (the grid is cleared).
+         */
+        bool build(const Math3D::Mat4& viewMatrix,
+                   float fovDegrees,
+                   float aspect,
+                   float nearPlane,
+                   float farPlane,
+                   int viewportWidth,
+                   int viewportHeight,
+                   const std::vector<Light>& lights);
+
+        /**
+         * @brief Drops every cluster; isValid() returns false afterwards.
+         */
+        void clear();
+
+        /**
+         * @brief Returns whether the last build() succeeded.
+         * @return True when the cluster data is usable.
+         */
+        bool isValid() const { return valid; }
+
+        int getTilesX() const { return tilesX; }
+        int getTilesY() const { return tilesY; }
+        int getViewportWidth() const { return viewportWidth; }
+        int getViewportHeight() const { return viewportHeight; }
+        float getNearPlane() const { return nearPlane; }
+        float getFarPlane() const { return farPlane; }
+        float getTanHalfFovX() const { return tanHalfFovX; }
+        float getTanHalfFovY() const { return tanHalfFovY; }
+        /// @brief Slice of view depth `z` is floor(log(z) * getSliceScale() + getSliceBias()).
+        float getSliceScale() const { return sliceScale; }
+        float getSliceBias() const { return sliceBias; }
+        const Math3D::Mat4& getViewMatrix() const { return viewMatrix; }
+
+        /**
+         * @brief Returns tilesX * tilesY * SliceCount.
+         * @return Cluster count, or 0 when invalid.
+         */
+        size_t getClusterCount() const { return clusterOffsets.size(); }
+
+        /// @brief Per cluster (x + y * tilesX + slice * tilesX * tilesY) start in getLightIndices().
+        const std::vector<std::uint32_t>& getClusterOffsets() const { return clusterOffsets; }
+        /// @brief Per cluster light count.
+        const std::vector<std::uint32_t>& getClusterCounts() const { return clusterCounts; }
+        /// @brief Light indices of every cluster, ascending within a cluster.
+        const std::vector<std::uint32_t>& getLightIndices() const { return lightIndices; }
+
+    private:
+        /// @brief Holds data for one light in view space.
+        struct ClusterLight {
+            float center[3] = {0.0f, 0.0f, 0.0f};
+            float axis[3] = {0.0f, 0.0f, -1.0f};
+            float radius = 0.0f;
+            float cosAngle = -1.0f;
+            float sinAngle = 0.0f;
+            bool global = false;
+            bool cone = false;
+        };
+
+        /// @brief Holds data for one slice's binning output.
+        struct SliceBins {
+            std::vector<std::uint32_t> hitClusters;
+            std::vector<std::uint32_t> hitLights;
+            std::vector<std::uint32_t> counts;
+            std::vector<std::uint32_t> indices;
+        };
+
+        int sliceForDepth(float depth) const;
+        void binSlice(int slice);
+
+        bool valid = false;
+        Math3D::Mat4 viewMatrix;
+        int tilesX = 0;
+        int tilesY = 0;
+        int viewportWidth = 0;
+        int viewportHeight = 0;
+        float nearPlane = 0.0f;
+        float farPlane = 0.0f;
+        float tanHalfFovX = 0.0f;
+        float tanHalfFovY = 0.0f;
+        float sliceScale = 0.0f;
+        float sliceBias = 0.0f;
+
+        // View-space cluster bounds, per slice: x extents use [slice * tilesX + x], y extents
+        // use [slice * tilesY + y]. Clusters span view z in [-sliceFar, -sliceNear].
+        std::vector<float> boundsMinX;
+        std::vector<float> boundsMaxX;
+        std::vector<float> boundsMinY;
+        std::vector<float> boundsMaxY;
+        std::vector<float> sliceNear;
+        std::vector<float> sliceFar;
+
+        std::vector<ClusterLight> frameLights;
+        std::vector<std::vector<std::uint32_t>> sliceLights;
+        std::vector<SliceBins> sliceBins;
+
+        std::vector<std::uint32_t> clusterOffsets;
+        std::vector<std::uint32_t> clusterCounts;
+        std::vector<std::uint32_t> lightIndices;
+};
+
+#endif // RENDERING_LIGHTING_LIGHT_CLUSTER_GRID_H
@@ -10,35 +10,48 @@
 #include <unordered_set>
 #include <cstring>
 #include "Foundation/Logging/Logbot.h"
+#include "Rendering/Lighting/LightClusterGrid.h"
 #include "Rendering/Lighting/ShadowRenderer.h"
 #include "Foundation/Math/Math3D.h"
 #include <cmath>
 
 namespace {
     constexpr GLuint LIGHT_UBO_BINDING = 0;
+    // Materials and reflection inputs use units 0-11; shadow samplers start at 13.
+    constexpr int LIGHT_BUFFER_TEX_UNIT = 12;
+    // The record layouts below are read back by fetchLight() and the cluster helpers pasted into
+    // Shader_Frag_{FlatColor,FlatImage,LitColor,LitImage,PBR,DeferredLight}.frag; keep them in step.
+    constexpr int LIGHT_RECORD_TEXELS = 7;
+    constexpr int LIGHT_SHADOW_TEXELS = 20;
+    constexpr int FLOATS_PER_TEXEL = 4;
     constexpr bool LIGHT_UBO_VERBOSE_LOGGING = false;
 
-    struct alignas(16) LightUBO {
+    /// @brief Holds data for one light in the light buffer texture (LIGHT_RECORD_TEXELS RGBA32F texels).
+    struct LightRecord {
         float meta[4] = {0.0f, 0.0f, -1.0f, 1.0f};     // x=type, y=shadowType, z=shadowMapIndex, w=shadowStrength
-        float position[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float position[4] = {0.0f, 0.0f, 0.0f, -1.0f}; // w=first texel of the shadow record, or -1
         float direction[4] = {0.0f, 0.0f, 0.0f, 0.0f};
         float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
         float params[4] = {1.0f, 10.0f, 1.0f, 45.0f};  // intensity, range, falloff, spotAngle
-        float shadow[4] = {0.0025f, 0.005f, 1.0f, 0.0f}; // bias, normalBias, cascadeCount, unused
+        float shadow[4] = {0.0025f, 0.005f, 1.0f, 0.0f}; // bias, normalBias, cascadeCount, debugMode
         float cascadeSplits[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-        float lightMatrices[16 * 4] = {
-            1,0,0,0,
-            0,1,0,0,
-            0,0,1,0,
-            0,0,0,1,
-            1,0,0,0,
-            0,1,0,0,
-            0,0,1,0,
-            0,0,0,1,
-            1,0,0,0,
-            0,1,0,0,
-            0,0,1,0,
-            0,0,0,1,
+    };
+
+    /// @brief Holds data for a shadowed light's matrices and atlas tiles (LIGHT_SHADOW_TEXELS texels).
+    struct LightShadowRecord {
+        float lightMatrices[16 * 4] = {0.0f};           // directional cascades / spot uses [0], column-major
+        float shadowAtlasRects[4 * 4] = {0.0f};         // per cascade: uv offset xy, uv scale zw
+    };
+
+    static_assert(sizeof(LightRecord) == sizeof(float) * FLOATS_PER_TEXEL * LIGHT_RECORD_TEXELS, "LightRecord must be whole texels");
+    static_assert(sizeof(LightShadowRecord) == sizeof(float) * FLOATS_PER_TEXEL * LIGHT_SHADOW_TEXELS, "LightShadowRecord must be whole texels");
+
+    struct alignas(16) LightBlockUBO {
+        float header[4] = {0.0f, 0.0f, 0.0f, 0.0f};            // x=lightCount, y=clustersEnabled, z=cluster range texel, w=cluster index texel
+        float clusterGrid[4] = {0.0f, 0.0f, 0.0f, 0.0f};       // x=tilesX, y=tilesY, z=sliceCount, w=tile size in pixels
+        float clusterDepth[4] = {0.0f, 0.0f, 0.0f, 0.0f};      // x=near, y=far, z=slice scale, w=slice bias
+        float clusterProjection[4] = {0.0f, 0.0f, 0.0f, 0.0f}; // x=tan(fovX/2), y=tan(fovY/2), z=viewport width, w=viewport height
+        float clusterView[16] = {
             1,0,0,0,
             0,1,0,0,
             0,0,1,0,
@@ -46,12 +59,14 @@ namespace {
         };
     };
 
-    struct alignas(16) LightBlockUBO {
-        float header[4] = {0.0f, 0.0f, 0.0f, 0.0f};    // x=lightCount
-        LightUBO lights[MAX_LIGHTS];
-    };
-
     GLuint g_lightUbo = 0;
+    GLuint g_lightBuffer = 0;
+    GLuint g_lightBufferTexture = 0;
+    size_t g_lightBufferCapacity = 0;
+    GLint g_maxTextureBufferTexels = 0;
+    std::vector<float> g_lightBufferData;
+    std::vector<float> g_lastLightBufferData;
+    std::vector<float> g_shadowRecordData;
     std::unordered_set<GLuint> g_boundPrograms;
     std::unordered_set<GLuint> g_loggedPrograms;
     std::unordered_map<GLuint, int> g_lastLightCount;
@@ -61,6 +76,13 @@ namespace {
     uint64_t g_lastShadowFrameUploaded = 0;
     const std::vector<Light>* g_lastLightsRef = nullptr;
 
+    LightClusterGrid g_clusterGrid;
+    const std::vector<Light>* g_clusterLightsRef = nullptr;
+    size_t g_clusterLightCount = 0;
+    uint64_t g_clusterGeneration = 0;
+    uint64_t g_lastClusterGenerationUploaded = 0;
+    bool g_loggedClusterOverflow = false;
+
     void ensureLightUboCreated() {
         if(g_lightUbo != 0){
             return;
@@ -73,7 +95,45 @@ namespace {
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
     }
 
-    void ensureProgramBoundToLightBlock(GLuint programId) {
+    void ensureLightBufferCreated() {
+        if(g_lightBuffer != 0){
+            return;
+        }
+
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &g_maxTextureBufferTexels);
+        if(g_maxTextureBufferTexels <= 0){
+            g_maxTextureBufferTexels = 65536;
+        }
+
+        g_lightBufferCapacity = sizeof(LightRecord);
+        glGenBuffers(1, &g_lightBuffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, g_lightBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(g_lightBufferCapacity), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+        glGenTextures(1, &g_lightBufferTexture);
+        glActiveTexture(GL_TEXTURE0 + LIGHT_BUFFER_TEX_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, g_lightBufferTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, g_lightBuffer);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    void uploadLightBuffer(const std::vector<float>& data) {
+        const size_t byteCount = data.size() * sizeof(float);
+        glBindBuffer(GL_TEXTURE_BUFFER, g_lightBuffer);
+        if(byteCount > g_lightBufferCapacity){
+            g_lightBufferCapacity = byteCount + (byteCount / 2);
+        }
+        // Orphan the old store so a frame still reading it never stalls this upload.
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(g_lightBufferCapacity), nullptr, GL_DYNAMIC_DRAW);
+        if(byteCount > 0){
+            glBufferSubData(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(byteCount), data.data());
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+
+    void ensureProgramBoundToLightBlock(const std::shared_ptr<ShaderProgram>& program) {
+        const GLuint programId = program->getID();
         if(programId == 0){
             return;
         }
@@ -87,9 +147,17 @@ namespace {
             glUniformBlockBinding(programId, blockIndex, LIGHT_UBO_BINDING);
         }
 
+        GLint bufferLocation = glGetUniformLocation(programId, "u_lightBuffer");
+        if(bufferLocation != -1){
+            program->bind();
+            glUniform1i(bufferLocation, LIGHT_BUFFER_TEX_UNIT);
+        }
+
         if(g_loggedPrograms.find(programId) == g_loggedPrograms.end()){
             if(blockIndex == GL_INVALID_INDEX){
                 LogBot.Log(LOG_ERRO, "LightBlock uniform block not found for program %u", programId);
+            }else if(bufferLocation == -1){
+                LogBot.Log(LOG_ERRO, "u_lightBuffer sampler not found for program %u", programId);
             }else if(LIGHT_UBO_VERBOSE_LOGGING){
                 GLint blockSize = 0;
                 GLint activeUniforms = 0;
@@ -102,6 +170,93 @@ namespace {
 
         g_boundPrograms.insert(programId);
     }
+
+    void bindLightBufferTexture() {
+        glActiveTexture(GL_TEXTURE0 + LIGHT_BUFFER_TEX_UNIT);
+        glBindTexture(GL_TEXTURE_BUFFER, g_lightBufferTexture);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    template<typename T>
+    void appendTexels(std::vector<float>& out, const T& record) {
+        const float* values = reinterpret_cast<const float*>(&record);
+        out.insert(out.end(), values, values + (sizeof(T) / sizeof(float)));
+    }
+
+    // Appends the cluster ranges (one texel per cluster: offset, count) and the packed light
+    // index list (four indices per texel) behind the light records. Indices and offsets are
+    // stored as floats, which stay exact far beyond any texture buffer size limit.
+    bool appendClusterTexels(LightBlockUBO& block, std::vector<float>& out) {
+        const auto& offsets = g_clusterGrid.getClusterOffsets();
+        const auto& counts = g_clusterGrid.getClusterCounts();
+        const auto& indices = g_clusterGrid.getLightIndices();
+        const size_t baseTexel = out.size() / FLOATS_PER_TEXEL;
+        const size_t indexTexel = baseTexel + offsets.size();
+        const size_t totalTexels = indexTexel + ((indices.size() + FLOATS_PER_TEXEL - 1) / FLOATS_PER_TEXEL);
+        if(totalTexels > static_cast<size_t>(g_maxTextureBufferTexels)){
+            if(!g_loggedClusterOverflow){
+                LogBot.Log(LOG_WARN, "Light clusters need %zu texels (limit %d); shading with the full light list.",
+                    totalTexels, g_maxTextureBufferTexels);
+                g_loggedClusterOverflow = true;
+            }
+            return false;
+        }
+
+        out.reserve(totalTexels * FLOATS_PER_TEXEL);
+        for(size_t cluster = 0; cluster < offsets.size(); ++cluster){
+            out.push_back(static_cast<float>(offsets[cluster]));
+            out.push_back(static_cast<float>(counts[cluster]));
+            out.push_back(0.0f);
+            out.push_back(0.0f);
+        }
+        for(std::uint32_t lightIndex : indices){
+            out.push_back(static_cast<float>(lightIndex));
+        }
+        out.resize(totalTexels * FLOATS_PER_TEXEL, 0.0f);
+
+        block.header[1] = 1.0f;
+        block.header[2] = static_cast<float>(baseTexel);
+        block.header[3] = static_cast<float>(indexTexel);
+        block.clusterGrid[0] = static_cast<float>(g_clusterGrid.getTilesX());
+        block.clusterGrid[1] = static_cast<float>(g_clusterGrid.getTilesY());
+        block.clusterGrid[2] = static_cast<float>(LightClusterGrid::SliceCount);
+        block.clusterGrid[3] = static_cast<float>(LightClusterGrid::TileSize);
+        block.clusterDepth[0] = g_clusterGrid.getNearPlane();
+        block.clusterDepth[1] = g_clusterGrid.getFarPlane();
+        block.clusterDepth[2] = g_clusterGrid.getSliceScale();
+        block.clusterDepth[3] = g_clusterGrid.getSliceBias();
+        block.clusterProjection[0] = g_clusterGrid.getTanHalfFovX();
+        block.clusterProjection[1] = g_clusterGrid.getTanHalfFovY();
+        block.clusterProjection[2] = static_cast<float>(g_clusterGrid.getViewportWidth());
+        block.clusterProjection[3] = static_cast<float>(g_clusterGrid.getViewportHeight());
+        std::memcpy(block.clusterView, glm::value_ptr(g_clusterGrid.getViewMatrix().data), sizeof(block.clusterView));
+        return true;
+    }
+}
+
+void LightUniformUploader::BuildClusters(const std::shared_ptr<Camera>& camera, int viewportWidth, int viewportHeight, const std::vector<Light>& lights) {
+    g_clusterGeneration++;
+    g_clusterLightsRef = &lights;
+    g_clusterLightCount = lights.size();
+    if(!camera || camera->getSettings().isOrtho || lights.size() > MAX_LIGHTS){
+        g_clusterGrid.clear();
+        return;
+    }
+
+    const CameraSettings& settings = camera->getSettings();
+    float nearPlane = settings.nearPlane;
+    float farPlane = settings.farPlane;
+    Camera::SanitizePerspectivePlanes(nearPlane, farPlane);
+    g_clusterGrid.build(
+        camera->getViewMatrix(),
+        settings.fov,
+        settings.aspect,
+        nearPlane,
+        farPlane,
+        viewportWidth,
+        viewportHeight,
+        lights
+    );
 }
 
 void LightUniformUploader::UploadLights(std::shared_ptr<ShaderProgram> program, const std::vector<Light>& lights) {
@@ -112,15 +267,20 @@ void LightUniformUploader::UploadLights(std::shared_ptr<ShaderProgram> program,
     g_lightUploadFrame++;
 
     ensureLightUboCreated();
-    ensureProgramBoundToLightBlock(program->getID());
+    ensureLightBufferCreated();
+    ensureProgramBoundToLightBlock(program);
+    bindLightBufferTexture();
 
     const uint64_t shadowFrame = ShadowRenderer::GetFrameId();
-    if(g_hasLastBlock && shadowFrame != 0 && g_lastShadowFrameUploaded == shadowFrame && g_lastLightsRef == &lights){
+    if(g_hasLastBlock &&
+       shadowFrame != 0 &&
+       g_lastShadowFrameUploaded == shadowFrame &&
+       g_lastLightsRef == &lights &&
+       g_lastClusterGenerationUploaded == g_clusterGeneration){
         return;
     }
 
     LightBlockUBO block;
-    std::memset(&block, 0, sizeof(LightBlockUBO));
     int lightCount = static_cast<int>(lights.size());
     if(lightCount > MAX_LIGHTS) lightCount = MAX_LIGHTS;
     block.header[0] = static_cast<float>(lightCount);
@@ -134,9 +294,14 @@ void LightUniformUploader::UploadLights(std::shared_ptr<ShaderProgram> program,
         g_lastLightCount[program->getID()] = lightCount;
     }
 
+    g_lightBufferData.clear();
+    g_lightBufferData.reserve(static_cast<size_t>(lightCount) * LIGHT_RECORD_TEXELS * FLOATS_PER_TEXEL);
+    g_shadowRecordData.clear();
+    const size_t shadowRecordBase = static_cast<size_t>(lightCount) * LIGHT_RECORD_TEXELS;
+
     for(int i = 0; i < lightCount; ++i){
         const Light& src = lights[i];
-        LightUBO& dst = block.lights[i];
+        LightRecord dst;
 
         auto safeFloat = [](float v, float fallback){
             return std::isfinite(v) ? v : fallback;
@@ -216,7 +381,7 @@ void LightUniformUploader::UploadLights(std::shared_ptr<ShaderProgram> program,
         dst.position[0] = safePos.x;
         dst.position[1] = safePos.y;
         dst.position[2] = safePos.z;
-        dst.position[3] = 0.0f;
+        dst.position[3] = -1.0f;
 
         dst.direction[0] = safeDir.x;
         dst.direction[1] = safeDir.y;
@@ -243,12 +408,43 @@ void LightUniformUploader::UploadLights(std::shared_ptr<ShaderProgram> program,
         dst.cascadeSplits[2] = shadowData.cascadeSplits.z;
         dst.cascadeSplits[3] = shadowData.cascadeSplits.w;
 
-        for(int m = 0; m < 4; ++m){
-            const float* matPtr = glm::value_ptr(shadowData.lightMatrices[m].data);
-            for(int k = 0; k < 16; ++k){
-                dst.lightMatrices[m * 16 + k] = matPtr[k];
+        // Only lights that sample a shadow map carry matrices, so unshadowed lights stay 7 texels.
+        if(shadowData.shadowMapIndex >= 0){
+            LightShadowRecord shadowRecord;
+            for(int m = 0; m < 4; ++m){
+                const float* matPtr = glm::value_ptr(shadowData.lightMatrices[m].data);
+                for(int k = 0; k < 16; ++k){
+                    shadowRecord.lightMatrices[m * 16 + k] = matPtr[k];
+                }
+                shadowRecord.shadowAtlasRects[m * 4 + 0] = shadowData.atlasRects[m].x;
+                shadowRecord.shadowAtlasRects[m * 4 + 1] = shadowData.atlasRects[m].y;
+                shadowRecord.shadowAtlasRects[m * 4 + 2] = shadowData.atlasRects[m].z;
+                shadowRecord.shadowAtlasRects[m * 4 + 3] = shadowData.atlasRects[m].w;
             }
+            const size_t shadowTexel = shadowRecordBase + (g_shadowRecordData.size() / FLOATS_PER_TEXEL);
+            dst.position[3] = static_cast<float>(shadowTexel);
+            appendTexels(g_shadowRecordData, shadowRecord);
         }
+
+        appendTexels(g_lightBufferData, dst);
+    }
+    g_lightBufferData.insert(g_lightBufferData.end(), g_shadowRecordData.begin(), g_shadowRecordData.end());
+
+    const bool clustersMatchLights =
+        g_clusterGrid.isValid() &&
+        g_clusterLightsRef == &lights &&
+        g_clusterLightCount == lights.size() &&
+        lightCount == static_cast<int>(lights.size());
+    if(clustersMatchLights){
+        appendClusterTexels(block, g_lightBufferData);
+    }
+
+    if(g_lightBufferData.size() != g_lastLightBufferData.size() ||
+       (!g_lightBufferData.empty() &&
+        std::memcmp(g_lightBufferData.data(), g_lastLightBufferData.data(), g_lightBufferData.size() * sizeof(float)) != 0)){
+        uploadLightBuffer(g_lightBufferData);
+        g_lastLightBufferData.swap(g_lightBufferData);
+        GLUniformUpload::UploadCounter()++;
     }
 
     if(!g_hasLastBlock || std::memcmp(&block, &g_lastBlock, sizeof(LightBlockUBO)) != 0){
@@ -259,8 +455,10 @@ void LightUniformUploader::UploadLights(std::shared_ptr<ShaderProgram> program,
 
         g_lastBlock = block;
         g_hasLastBlock = true;
+        GLUniformUpload::UploadCounter()++;
     }
 
     g_lastShadowFrameUploaded = shadowFrame;
     g_lastLightsRef = &lights;
+    g_lastClusterGenerationUploaded = g_clusterGeneration;
 }
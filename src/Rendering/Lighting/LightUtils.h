@@ -8,6 +8,7 @@
 
 #include "Rendering/Lighting/Light.h"
 #include "Rendering/Shaders/ShaderProgram.h"
+#include "Scene/Camera.h"
 #include <memory>
 
 /// @brief Represents the LightUniformUploader type.
@@ -15,10 +16,26 @@ class LightUniformUploader {
 public:
     /**
      * @brief Uploads light data to shader uniforms.
+     *
+     * Light records, shadow records and the light clusters from BuildClusters() go into one
+     * RGBA32F buffer texture (`u_lightBuffer`); the LightBlock UBO only holds the counts and
+     * the cluster grid parameters. Clusters are used when they were built from `lights`.
      * @param program Value for program.
      * @param lights Value for lights.
      */
     static void UploadLights(std::shared_ptr<ShaderProgram> program, const std::vector<Light>& lights);
+
+    /**
+     * @brief Bins lights into the clustered-shading grid for this frame's camera.
+     *
+     * Call once per frame before drawing, with the same list later passed to UploadLights().
+     * Orthographic cameras clear the grid, so shaders fall back to the full light list.
+     * @param camera Camera the clusters follow.
+     * @param viewportWidth Viewport width in pixels.
+     * @param viewportHeight Viewport height in pixels.
+     * @param lights Lights to bin.
+     */
+    static void BuildClusters(const std::shared_ptr<Camera>& camera, int viewportWidth, int viewportHeight, const std::vector<Light>& lights);
 };
 
 #endif // LIGHT_UTILS_H
@@ -0,0 +1,258 @@
+/**
+ * @file src/Rendering/Lighting/ShadowAtlasAllocator.cpp
+ * @brief Implementation for ShadowAtlasAllocator.
+ */
+
+#include "Rendering/Lighting/ShadowAtlasAllocator.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+namespace {
+    int floorPowerOfTwo(int value){
+        int result = 1;
+        while(result <= value / 2){
+            result <<= 1;
+        }
+        return result;
+    }
+
+    int ceilPowerOfTwo(int value){
+        int result = 1;
+        while(result < value){
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::uint32_t encodeNode(int level, int nodeX, int nodeY){
+        return static_cast<std::uint32_t>(nodeY) * (1u << level) + static_cast<std::uint32_t>(nodeX);
+    }
+
+    std::uint64_t tileArea(int size){
+        return static_cast<std::uint64_t>(size) * static_cast<std::uint64_t>(size);
+    }
+}
+
+void ShadowAtlasAllocator::reset(int newAtlasSize, int newMinTileSize){
+    atlasSize = (newAtlasSize > 0) ? floorPowerOfTwo(newAtlasSize) : 0;
+    minTileSize = std::min(ceilPowerOfTwo(std::max(1, newMinTileSize)), std::max(1, atlasSize));
+    levelCount = 0;
+    for(int size = atlasSize; size >= minTileSize && size > 0; size >>= 1){
+        levelCount++;
+    }
+    clearTiles();
+}
+
+void ShadowAtlasAllocator::clearTiles(){
+    tiles.clear();
+    freeNodes.assign(static_cast<size_t>(levelCount), {});
+    if(levelCount > 0){
+        freeNodes[0].insert(0u);
+    }
+}
+
+int ShadowAtlasAllocator::levelForSize(int size) const {
+    int level = 0;
+    while(level + 1 < levelCount && sizeForLevel(level) > size){
+        level++;
+    }
+    return level;
+}
+
+bool ShadowAtlasAllocator::allocate(int level, Rect& outRect){
+    int sourceLevel = level;
+    while(sourceLevel >= 0 && freeNodes[sourceLevel].empty()){
+        sourceLevel--;
+    }
+    if(sourceLevel < 0){
+        return false;
+    }
+
+    // Lowest key first keeps tiles packed toward the atlas origin.
+    const std::uint32_t node = *freeNodes[sourceLevel].begin();
+    freeNodes[sourceLevel].erase(freeNodes[sourceLevel].begin());
+    const std::uint32_t rowNodes = 1u << sourceLevel;
+    int nodeX = static_cast<int>(node % rowNodes);
+    int nodeY = static_cast<int>(node / rowNodes);
+
+    for(int splitLevel = sourceLevel + 1; splitLevel <= level; ++splitLevel){
+        nodeX *= 2;
+        nodeY *= 2;
+        freeNodes[splitLevel].insert(encodeNode(splitLevel, nodeX + 1, nodeY));
+        freeNodes[splitLevel].insert(encodeNode(splitLevel, nodeX, nodeY + 1));
+        freeNodes[splitLevel].insert(encodeNode(splitLevel, nodeX + 1, nodeY + 1));
+    }
+
+    const int size = sizeForLevel(level);
+    outRect.x = nodeX * size;
+    outRect.y = nodeY * size;
+    outRect.size = size;
+    return true;
+}
+
+void ShadowAtlasAllocator::release(const Rect& rect){
+    if(rect.size <= 0 || levelCount <= 0){
+        return;
+    }
+
+    int level = levelForSize(rect.size);
+    int nodeX = rect.x / rect.size;
+    int nodeY = rect.y / rect.size;
+    while(level > 0){
+        const int baseX = nodeX & ~1;
+        const int baseY = nodeY & ~1;
+        std::uint32_t siblings[3];
+        int siblingCount = 0;
+        for(int dy = 0; dy < 2; ++dy){
+            for(int dx = 0; dx < 2; ++dx){
+                if(baseX + dx != nodeX || baseY + dy != nodeY){
+                    siblings[siblingCount++] = encodeNode(level, baseX + dx, baseY + dy);
+                }
+            }
+        }
+
+        auto& levelFree = freeNodes[level];
+        const bool mergeable =
+            levelFree.count(siblings[0]) != 0 &&
+            levelFree.count(siblings[1]) != 0 &&
+            levelFree.count(siblings[2]) != 0;
+        if(!mergeable){
+            break;
+        }
+        for(std::uint32_t sibling : siblings){
+            levelFree.erase(sibling);
+        }
+        nodeX >>= 1;
+        nodeY >>= 1;
+        level--;
+    }
+    freeNodes[level].insert(encodeNode(level, nodeX, nodeY));
+}
+
+void ShadowAtlasAllocator::assign(std::vector<Request>& requests){
+    for(Request& request : requests){
+        request.rect = Rect{};
+        request.retained = false;
+    }
+    if(levelCount <= 0){
+        clearTiles();
+        return;
+    }
+
+    // Fit pass: settle every size first so placement never has to revisit a decision.
+    std::vector<int> sizes(requests.size(), 0);
+    std::vector<size_t> byPriority(requests.size());
+    std::iota(byPriority.begin(), byPriority.end(), size_t(0));
+    std::stable_sort(byPriority.begin(), byPriority.end(), [&](size_t a, size_t b){
+        return requests[a].priority > requests[b].priority;
+    });
+
+    const std::uint64_t atlasArea = tileArea(atlasSize);
+    std::uint64_t totalArea = 0;
+    for(size_t i = 0; i < requests.size(); ++i){
+        if(requests[i].desiredSize <= 0){
+            continue;
+        }
+        sizes[i] = std::min(atlasSize, std::max(minTileSize, ceilPowerOfTwo(requests[i].desiredSize)));
+        totalArea += tileArea(sizes[i]);
+    }
+
+    while(totalArea > atlasArea){
+        bool shrunk = false;
+        for(auto it = byPriority.rbegin(); it != byPriority.rend(); ++it){
+            int& size = sizes[*it];
+            if(size > minTileSize){
+                totalArea -= tileArea(size) - tileArea(size / 2);
+                size /= 2;
+                shrunk = true;
+                break;
+            }
+        }
+        if(shrunk){
+            continue;
+        }
+        for(auto it = byPriority.rbegin(); it != byPriority.rend(); ++it){
+            int& size = sizes[*it];
+            if(size > 0){
+                totalArea -= tileArea(size);
+                size = 0;
+                break;
+            }
+        }
+    }
+
+    // Keep last frame's tile for unchanged requests, then hand the freed space to the rest.
+    std::unordered_set<std::uint64_t> retainedKeys;
+    for(size_t i = 0; i < requests.size(); ++i){
+        if(sizes[i] <= 0){
+            continue;
+        }
+        auto tileIt = tiles.find(requests[i].key);
+        if(tileIt != tiles.end() && tileIt->second.size == sizes[i]){
+            requests[i].rect = tileIt->second;
+            requests[i].retained = true;
+            retainedKeys.insert(requests[i].key);
+        }
+    }
+    for(const auto& entry : tiles){
+        if(retainedKeys.count(entry.first) == 0){
+            release(entry.second);
+        }
+    }
+
+    std::vector<size_t> placeOrder;
+    placeOrder.reserve(requests.size());
+    for(size_t index : byPriority){
+        if(sizes[index] > 0 && !requests[index].retained){
+            placeOrder.push_back(index);
+        }
+    }
+    std::stable_sort(placeOrder.begin(), placeOrder.end(), [&](size_t a, size_t b){
+        return sizes[a] > sizes[b];
+    });
+
+    bool placedAll = true;
+    for(size_t index : placeOrder){
+        if(!allocate(levelForSize(sizes[index]), requests[index].rect)){
+            placedAll = false;
+            break;
+        }
+    }
+
+    if(!placedAll){
+        // Retained tiles fragmented the free space. Power-of-two squares placed largest
+        // first always fit once their total area does, so repack everything from empty.
+        clearTiles();
+        placeOrder.clear();
+        for(size_t index : byPriority){
+            if(sizes[index] > 0){
+                requests[index].retained = false;
+                requests[index].rect = Rect{};
+                placeOrder.push_back(index);
+            }
+        }
+        std::stable_sort(placeOrder.begin(), placeOrder.end(), [&](size_t a, size_t b){
+            return sizes[a] > sizes[b];
+        });
+        for(size_t index : placeOrder){
+            allocate(levelForSize(sizes[index]), requests[index].rect);
+        }
+    }
+
+    tiles.clear();
+    for(const Request& request : requests){
+        if(request.rect.size > 0){
+            tiles[request.key] = request.rect;
+        }
+    }
+}
+
+std::uint64_t ShadowAtlasAllocator::getFreeArea() const {
+    std::uint64_t area = 0;
+    for(int level = 0; level < levelCount; ++level){
+        area += tileArea(sizeForLevel(level)) * freeNodes[level].size();
+    }
+    return area;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file src/Rendering/Lighting/ShadowAtlasAllocator.h
+ * @brief Quadtree tile allocator that packs per-light shadow maps into one atlas.
+ */
+
+#ifndef RENDERING_LIGHTING_SHADOW_ATLAS_ALLOCATOR_H
+#define RENDERING_LIGHTING_SHADOW_ATLAS_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Packs square power-of-two tiles into a square atlas.
+ *
+ * Tiles are quadtree nodes: allocating splits a larger free node into four children and
+ * releasing merges four free siblings back into their parent. assign() is called once per
+ * frame with every tile the frame wants; a request whose key and size match the previous
+ * frame keeps its old tile so cached shadow contents stay valid. Has no GL dependency.
+ */
+class ShadowAtlasAllocator {
+    public:
+        /// @brief Holds data for Rect, in atlas texels.
+        struct Rect {
+            int x = 0;
+            int y = 0;
+            int size = 0;
+        };
+
+        /// @brief Holds data for Request. `rect` and `retained` are outputs of assign().
+        struct Request {
+            std::uint64_t key = 0;
+            int desiredSize = 0;
+            float priority = 0.0f;
+            Rect rect;
+            bool retained = false;
+        };
+
+        /**
+         * @brief Clears every tile and sets the atlas geometry.
+         * @param atlasSize Atlas edge in texels; rounded down to a power of two.
+         * @param minTileSize Smallest tile edge handed out; rounded up to a power of two.
+         */
+        void reset(int atlasSize, int minTileSize);
+
+        /**
+         * @brief Places every request for this frame.
+         *
+         * Sizes are rounded to powers of two inside [minTileSize, atlasSize]. When the total
+         * area does not fit, the lowest-priority tiles are halved first and, once every tile
+         * is at the minimum, dropped (their rect size is 0).
+         * @param requests Frame requests; keys must be unique. Updated in place.
+         */
+        void assign(std::vector<Request>& requests);
+
+        /**
+         * @brief Returns the atlas edge in texels.
+         * @return Atlas size, or 0 before reset().
+         */
+        int getAtlasSize() const { return atlasSize; }
+
+        /**
+         * @brief Returns the smallest tile edge in texels.
+         * @return Minimum tile size.
+         */
+        int getMinTileSize() const { return minTileSize; }
+
+        /**
+         * @brief Returns how many tiles are currently allocated.
+         * @return Tile count.
+         */
+        size_t getTileCount() const { return tiles.size(); }
+
+        /**
+         * @brief Returns how many texels are not covered by an allocated tile.
+         * @return Free texel count.
+         */
+        std::uint64_t getFreeArea() const;
+
+    private:
+        int levelForSize(int size) const;
+        int sizeForLevel(int level) const { return atlasSize >> level; }
+        bool allocate(int level, Rect& outRect);
+        void release(const Rect& rect);
+        void clearTiles();
+
+        int atlasSize = 0;
+        int minTileSize = 0;
+        int levelCount = 0;
+        // Free nodes per level, keyed by (y * nodesPerRow + x) in that level's node grid.
+        std::vector<std::set<std::uint32_t>> freeNodes;
+        std::unordered_map<std::uint64_t, Rect> tiles;
+};
+
+#endif // RENDERING_LIGHTING_SHADOW_ATLAS_ALLOCATOR_H
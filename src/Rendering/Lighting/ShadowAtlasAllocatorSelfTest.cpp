@@ -0,0 +1,310 @@
+/**
+ * @file src/Rendering/Lighting/ShadowAtlasAllocatorSelfTest.cpp
+ * @brief Implementation for ShadowAtlasAllocatorSelfTest.
+ */
+
+#include "Rendering/Lighting/ShadowAtlasAllocatorSelfTest.h"
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "Foundation/Logging/Logbot.h"
+#include "Rendering/Lighting/ShadowAtlasAllocator.h"
+
+namespace {
+    constexpr std::uint32_t kSeed = 0x5A7A5u;
+    constexpr int kRandomFrames = 300;
+    constexpr std::uint64_t kRandomKeys = 48;
+    constexpr size_t kMaxLoggedFailures = 8;
+
+    using Request = ShadowAtlasAllocator::Request;
+    using Rect = ShadowAtlasAllocator::Rect;
+
+    /// @brief Holds data for Checker: counts failures and logs the first few.
+    struct Checker {
+        ShadowAtlasAllocatorSelfTest::Result& result;
+        const char* caseName = "";
+
+        void expect(bool condition, const char* what){
+            if(condition){
+                return;
+            }
+            if(result.failures < kMaxLoggedFailures){
+                LogBot.Log(LOG_ERRO, "ShadowAtlasAllocator self-test: %s: %s.", caseName, what);
+            }
+            result.failures++;
+        }
+    };
+
+    bool isPowerOfTwo(int value){
+        return value > 0 && (value & (value - 1)) == 0;
+    }
+
+    bool overlaps(const Rect& a, const Rect& b){
+        return a.x < b.x + b.size && b.x < a.x + a.size &&
+               a.y < b.y + b.size && b.y < a.y + a.size;
+    }
+
+    Request makeRequest(std::uint64_t key, int desiredSize, float priority){
+        Request request;
+        request.key = key;
+        request.desiredSize = desiredSize;
+        request.priority = priority;
+        return request;
+    }
+
+    const Request* findRequest(const std::vector<Request>& requests, std::uint64_t key){
+        for(const Request& request : requests){
+            if(request.key == key){
+                return &request;
+            }
+        }
+        return nullptr;
+    }
+
+    // Geometry and bookkeeping every assign() must satisfy, whatever the requests were.
+    void checkFrame(Checker& checker, const ShadowAtlasAllocator& allocator, const std::vector<Request>& requests){
+        checker.result.framesAssigned++;
+        const int atlasSize = allocator.getAtlasSize();
+        const int minTileSize = allocator.getMinTileSize();
+        std::uint64_t usedArea = 0;
+        size_t placed = 0;
+        for(size_t i = 0; i < requests.size(); ++i){
+            const Rect& rect = requests[i].rect;
+            if(rect.size == 0){
+                checker.expect(!requests[i].retained, "a dropped request is marked retained");
+                continue;
+            }
+            placed++;
+            usedArea += static_cast<std::uint64_t>(rect.size) * static_cast<std::uint64_t>(rect.size);
+            checker.expect(isPowerOfTwo(rect.size) && rect.size >= minTileSize && rect.size <= atlasSize,
+                           "tile size is not a power of two inside [minTileSize, atlasSize]");
+            checker.expect(rect.x >= 0 && rect.y >= 0 && rect.x + rect.size <= atlasSize && rect.y + rect.size <= atlasSize,
+                           "tile lies outside the atlas");
+            checker.expect(rect.x % rect.size == 0 && rect.y % rect.size == 0, "tile is not aligned to its size");
+            for(size_t j = i + 1; j < requests.size(); ++j){
+                if(requests[j].rect.size > 0 && overlaps(rect, requests[j].rect)){
+                    checker.expect(false, "two tiles overlap");
+                }
+            }
+        }
+        const std::uint64_t atlasArea = static_cast<std::uint64_t>(atlasSize) * static_cast<std::uint64_t>(atlasSize);
+        checker.expect(allocator.getTileCount() == placed, "tile count does not match the placed requests");
+        checker.expect(usedArea + allocator.getFreeArea() == atlasArea, "free area plus tile area is not the atlas area");
+    }
+
+    void runResetCase(Checker& checker){
+        checker.caseName = "reset";
+        ShadowAtlasAllocator allocator;
+        allocator.reset(3000, 100);
+        checker.expect(allocator.getAtlasSize() == 2048, "atlas size was not rounded down to 2048");
+        checker.expect(allocator.getMinTileSize() == 128, "minimum tile was not rounded up to 128");
+        checker.expect(allocator.getFreeArea() == 2048ull * 2048ull, "a reset atlas is not entirely free");
+
+        allocator.reset(256, 1000);
+        checker.expect(allocator.getMinTileSize() == 256, "minimum tile was not clamped to the atlas size");
+
+        allocator.reset(0, 64);
+        std::vector<Request> requests = {makeRequest(1, 64, 1.0f)};
+        allocator.assign(requests);
+        checker.expect(allocator.getAtlasSize() == 0 && requests[0].rect.size == 0 && allocator.getTileCount() == 0,
+                       "an empty atlas placed a tile");
+    }
+
+    void runPlacementCase(Checker& checker){
+        checker.caseName = "placement";
+        ShadowAtlasAllocator allocator;
+        allocator.reset(1024, 64);
+        std::vector<Request> requests = {
+            makeRequest(10, 100, 1.0f),  // Rounds up to 128.
+            makeRequest(11, 5000, 0.5f), // Clamped to the atlas, then shrunk to fit as the lowest priority.
+            makeRequest(12, 1, 1.0f),    // Rounds up to the minimum tile.
+            makeRequest(13, 0, 9.0f)     // No tile wanted.
+        };
+        allocator.assign(requests);
+        checkFrame(checker, allocator, requests);
+        checker.expect(requests[0].rect.size == 128, "desired 100 did not get a 128 tile");
+        checker.expect(requests[1].rect.size == 512, "the atlas-sized request was not halved to 512 to fit");
+        checker.expect(requests[2].rect.size == 64, "desired 1 did not get the minimum tile");
+        checker.expect(requests[3].rect.size == 0, "a zero-size request got a tile");
+    }
+
+    void runRetentionCase(Checker& checker){
+        checker.caseName = "retention";
+        ShadowAtlasAllocator allocator;
+        allocator.reset(2048, 64);
+        std::vector<Request> requests;
+        for(std::uint64_t key = 0; key < 12; ++key){
+            requests.push_back(makeRequest(key, 64 << (key % 4), static_cast<float>(key)));
+        }
+        allocator.assign(requests);
+        checkFrame(checker, allocator, requests);
+        const std::vector<Request> first = requests;
+
+        // Same keys and sizes in a different order and with new priorities keep their tiles.
+        std::vector<Request> reordered;
+        for(auto it = first.rbegin(); it != first.rend(); ++it){
+            reordered.push_back(makeRequest(it->key, it->desiredSize, 100.0f - it->priority));
+        }
+        allocator.assign(reordered);
+        checkFrame(checker, allocator, reordered);
+        for(const Request& request : reordered){
+            const Request* previous = findRequest(first, request.key);
+            checker.expect(request.retained, "an unchanged request was not retained");
+            checker.expect(previous && request.rect.x == previous->rect.x && request.rect.y == previous->rect.y &&
+                           request.rect.size == previous->rect.size,
+                           "a retained request moved");
+        }
+
+        // A size change gives up the old tile; a dropped key frees its space.
+        std::vector<Request> changed = reordered;
+        changed[0].desiredSize *= 2;
+        changed.pop_back();
+        allocator.assign(changed);
+        checkFrame(checker, allocator, changed);
+        checker.expect(!changed[0].retained && changed[0].rect.size == first.back().rect.size * 2,
+                       "a resized request was retained or got the wrong size");
+        for(size_t i = 1; i < changed.size(); ++i){
+            checker.expect(changed[i].retained, "an unchanged request lost its tile when a neighbour resized");
+        }
+
+        std::vector<Request> none;
+        allocator.assign(none);
+        checker.expect(allocator.getTileCount() == 0 && allocator.getFreeArea() == 2048ull * 2048ull,
+                       "releasing every tile did not merge back to one free atlas");
+    }
+
+    void runOverflowCase(Checker& checker){
+        checker.caseName = "overflow";
+        ShadowAtlasAllocator allocator;
+        allocator.reset(1024, 128);
+        std::vector<Request> requests = {
+            makeRequest(1, 1024, 3.0f),
+            makeRequest(2, 1024, 2.0f),
+            makeRequest(3, 1024, 1.0f)
+        };
+        allocator.assign(requests);
+        checkFrame(checker, allocator, requests);
+        // Lowest priority halves to the minimum first, then the next, then the highest.
+        checker.expect(requests[2].rect.size == 128 && requests[1].rect.size == 128 && requests[0].rect.size == 512,
+                       "overflow did not halve the lowest priorities first");
+
+        checker.caseName = "drop";
+        allocator.reset(256, 128);
+        std::vector<Request> dropped;
+        for(std::uint64_t key = 0; key < 5; ++key){
+            dropped.push_back(makeRequest(key, 128, 5.0f - static_cast<float>(key)));
+        }
+        allocator.assign(dropped);
+        checkFrame(checker, allocator, dropped);
+        for(size_t i = 0; i < 4; ++i){
+            checker.expect(dropped[i].rect.size == 128, "a higher-priority minimum tile was dropped");
+        }
+        checker.expect(dropped[4].rect.size == 0, "the lowest-priority tile was not dropped");
+    }
+
+    void runRepackCase(Checker& checker){
+        checker.caseName = "repack";
+        ShadowAtlasAllocator allocator;
+        allocator.reset(256, 64);
+        std::vector<Request> requests;
+        for(std::uint64_t key = 0; key < 16; ++key){
+            requests.push_back(makeRequest(key, 64, 1.0f));
+        }
+        allocator.assign(requests);
+        checkFrame(checker, allocator, requests);
+
+        // Keep one minimum tile per quadrant so no 128 node is free, then ask for two 128 tiles.
+        std::vector<Request> fragmented;
+        bool quadrantUsed[4] = {};
+        for(const Request& request : requests){
+            const int quadrant = (request.rect.x >= 128 ? 1 : 0) + (request.rect.y >= 128 ? 2 : 0);
+            if(!quadrantUsed[quadrant]){
+                quadrantUsed[quadrant] = true;
+                fragmented.push_back(makeRequest(request.key, 64, 1.0f));
+            }
+        }
+        checker.expect(fragmented.size() == 4, "the first frame did not fill every quadrant");
+        fragmented.push_back(makeRequest(100, 128, 1.0f));
+        fragmented.push_back(makeRequest(101, 128, 1.0f));
+        allocator.assign(fragmented);
+        checkFrame(checker, allocator, fragmented);
+        for(const Request& request : fragmented){
+            checker.expect(request.rect.size > 0, "a request that fits by area was not placed after repacking");
+            checker.expect(!request.retained, "a repacked frame reported a retained tile");
+        }
+    }
+
+    void runRandomCase(Checker& checker){
+        checker.caseName = "random";
+        std::mt19937 rng(kSeed);
+        std::uniform_int_distribution<int> sizeShift(0, 6);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        ShadowAtlasAllocator allocator;
+        allocator.reset(4096, 64);
+        std::unordered_map<std::uint64_t, int> desiredSizes;
+        std::unordered_map<std::uint64_t, Rect> previousRects;
+        std::vector<Request> requests;
+        for(int frame = 0; frame < kRandomFrames; ++frame){
+            requests.clear();
+            for(std::uint64_t key = 0; key < kRandomKeys; ++key){
+                if(unit(rng) < 0.3f){
+                    continue;
+                }
+                auto sizeIt = desiredSizes.find(key);
+                if(sizeIt == desiredSizes.end() || unit(rng) < 0.1f){
+                    desiredSizes[key] = 64 << sizeShift(rng);
+                }
+                requests.push_back(makeRequest(key, desiredSizes[key], unit(rng)));
+            }
+            allocator.assign(requests);
+            checkFrame(checker, allocator, requests);
+
+            bool anyRetained = false;
+            bool unchangedMoved = false;
+            for(const Request& request : requests){
+                auto previousIt = previousRects.find(request.key);
+                const bool hadSameTile = previousIt != previousRects.end() && previousIt->second.size == request.rect.size;
+                if(request.retained){
+                    anyRetained = true;
+                    checker.expect(hadSameTile && previousIt->second.x == request.rect.x && previousIt->second.y == request.rect.y,
+                                   "a retained tile moved or had no tile last frame");
+                }else if(hadSameTile && request.rect.size > 0){
+                    unchangedMoved = true;
+                }
+            }
+            // Unchanged tiles only move when the frame fell back to a full repack.
+            checker.expect(!(anyRetained && unchangedMoved), "an unchanged tile moved without a full repack");
+
+            previousRects.clear();
+            for(const Request& request : requests){
+                if(request.rect.size > 0){
+                    previousRects[request.key] = request.rect;
+                }
+            }
+        }
+    }
+}
+
+ShadowAtlasAllocatorSelfTest::Result ShadowAtlasAllocatorSelfTest::Run(){
+    Result result;
+    Checker checker{result};
+
+    runResetCase(checker);
+    runPlacementCase(checker);
+    runRetentionCase(checker);
+    runOverflowCase(checker);
+    runRepackCase(checker);
+    runRandomCase(checker);
+    result.casesRun = 6;
+
+    result.passed = result.failures == 0;
+    LogBot.Log(result.passed ? LOG_INFO : LOG_ERRO, "ShadowAtlasAllocator self-test: %llu case(s), %llu frame(s), %llu failure(s).",
+               static_cast<unsigned long long>(result.casesRun),
+               static_cast<unsigned long long>(result.framesAssigned),
+               static_cast<unsigned long long>(result.failures));
+    return result;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file src/Rendering/Lighting/ShadowAtlasAllocatorSelfTest.h
+ * @brief Declarations for ShadowAtlasAllocatorSelfTest.
+ */
+
+#ifndef RENDERING_LIGHTING_SHADOW_ATLAS_ALLOCATOR_SELF_TEST_H
+#define RENDERING_LIGHTING_SHADOW_ATLAS_ALLOCATOR_SELF_TEST_H
+
+#include <cstddef>
+
+/// @brief Checks ShadowAtlasAllocator reset, placement, retention, overflow and repacking.
+namespace ShadowAtlasAllocatorSelfTest {
+    /// @brief Holds data for Result.
+    struct Result {
+        bool passed = false;
+        size_t casesRun = 0;
+        size_t framesAssigned = 0;
+        size_t failures = 0;
+    };
+
+    /**
+     * @brief Runs fixed scenarios and seeded random frames through the allocator. GL-free.
+     *
+     * Every frame is checked for tiles inside the atlas, aligned to their size and not
+     * overlapping, for free area plus tile area equal to the atlas area, and for retained
+     * tiles keeping last frame's rect. Logs the first failures and a summary.
+     * @return Counts and the overall verdict.
+     */
+    Result Run();
+}
+
+#endif // RENDERING_LIGHTING_SHADOW_ATLAS_ALLOCATOR_SELF_TEST_H
@@ -209,6 +209,16 @@ void ShadowMapCube::bindFace(GLenum face) const {
     glReadBuffer(GL_NONE);
 }
 
+void ShadowMapCube::bindLayered() const {
+    if(fbo == 0 || depthCube == 0){
+        return;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthCube, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+}
+
 void ShadowMapCube::unbind() const {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
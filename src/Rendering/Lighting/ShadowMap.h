@@ -136,6 +136,10 @@ public:
      * @param face Value for face.
      */
     void bindFace(GLenum face) const;
+    /**
+     * @brief Binds the whole cube as a layered target; geometry shaders pick the face via gl_Layer.
+     */
+    void bindLayered() const;
     /**
      * @brief Unbinds this resource.
      */
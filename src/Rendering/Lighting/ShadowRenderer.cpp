@@ -7,15 +7,21 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <limits>
 #include <string>
 #include <unordered_map>
 
 #include "Rendering/Lighting/Light.h"
+#include "Rendering/Lighting/ShadowAtlasAllocator.h"
 #include "Rendering/Materials/Material.h"
+#include "Rendering/Geometry/InstanceBatch.h"
 #include "Rendering/Geometry/Mesh.h"
 #include "Rendering/Shaders/ShaderProgram.h"
 #include "Rendering/Core/Screen.h"
+#include "Rendering/Core/BoundsBVH.h"
+#include "Rendering/Core/DrawKeys.h"
+#include "Rendering/Core/FrustumCulling.h"
 #include "Foundation/Logging/Logbot.h"
 #include "Rendering/Geometry/ModelPart.h"
 #include <cmath>
@@ -23,31 +29,39 @@
 namespace {
     constexpr int MAX_SHADOW_MAPS_2D = 16;
     constexpr int MAX_SHADOW_MAPS_CUBE = 2;
-    // Reserve units 8-11 for reflection inputs used by forward/deferred composites:
+    // Reserve units 8-12 for reflection and lighting inputs used by forward/deferred composites:
     // 8 = scene color / planar fallback, 9 = scene depth / deferred local probe,
-    // 10 = planar reflection, 11 = forward local probe.
+    // 10 = planar reflection, 11 = forward local probe, 12 = light buffer texture.
     // Shadow samplers must stay above those slots or reflection captures can stomp shadow bindings.
-    constexpr int SHADOW_TEX_UNIT_BASE_2D = 12;
+    constexpr int SHADOW_TEX_UNIT_BASE_2D = 13;
     // Hybrid defaults: keep high-quality directional/spot shadows, trim point shadows first.
     constexpr int SHADOW_MAP_SIZE_DIRECTIONAL = 4096;
-    constexpr int SHADOW_MAP_SIZE_SPOT = 1536;
     constexpr int SHADOW_MAP_SIZE_CUBE = 512;
     constexpr int DIRECTIONAL_CASCADE_COUNT = 4;
-
-    /// @brief Represents Shadow Slot2 D data.
+    // Directional and spot maps share one atlas; spots get a tile sized by how much of the
+    // screen their range covers, between the allocator minimum and SHADOW_ATLAS_MAX_SPOT_TILE.
+    constexpr int SHADOW_ATLAS_SIZE = 8192;
+    constexpr int SHADOW_ATLAS_MIN_TILE = 256;
+    constexpr int SHADOW_ATLAS_MAX_SPOT_TILE = 2048;
+    constexpr float SHADOW_ATLAS_DIRECTIONAL_PRIORITY = 1.0e6f;
+
+    /// @brief Represents Shadow Slot2 D data. `contentKey` describes what the atlas tile currently holds.
     struct ShadowSlot2D {
-        ShadowMap2D map;
+        ShadowAtlasAllocator::Rect tile;
+        std::uint64_t tileKey = 0;
         Math3D::Mat4 matrix;
         int lightIndex = -1;
+        std::uint64_t contentKey = 0;
     };
 
-    /// @brief Represents Shadow Slot Cube data.
+    /// @brief Represents Shadow Slot Cube data. `faceContentKeys` describe what each face currently holds.
     struct ShadowSlotCube {
         ShadowMapCube map;
         std::vector<Math3D::Mat4> matrices;
         Math3D::Vec3 lightPos;
         float farPlane = 25.0f;
         int lightIndex = -1;
+        std::array<std::uint64_t, 6> faceContentKeys{};
     };
 
     bool g_enabled = false;
@@ -56,6 +70,10 @@ namespace {
     GLint g_savedViewport[4] = {0,0,0,0};
 
     std::vector<ShadowSlot2D> g_shadow2D;
+    ShadowMap2D g_shadowAtlas;
+    ShadowAtlasAllocator g_shadowAtlasAllocator;
+    std::vector<ShadowAtlasAllocator::Request> g_shadowAtlasRequests;
+    std::unordered_map<std::uint64_t, std::uint64_t> g_previousTileContent;
     std::vector<ShadowSlotCube> g_shadowCube;
     std::vector<ShadowLightData> g_lightData;
     int g_active2D = 0;
@@ -63,6 +81,8 @@ namespace {
 
     std::shared_ptr<ShaderProgram> g_shadow2DProgram;
     std::shared_ptr<ShaderProgram> g_shadowCubeProgram;
+    std::shared_ptr<ShaderProgram> g_shadowCascadeLayeredProgram;
+    std::shared_ptr<ShaderProgram> g_shadowCubeLayeredProgram;
 
     std::shared_ptr<Texture> g_debugDepthTexture;
     std::shared_ptr<ShaderProgram> g_shadowDebugProgram;
@@ -70,6 +90,7 @@ namespace {
     GLuint g_debugFbo = 0;
     GLuint g_debugColorTex = 0;
     int g_debugSize = 0;
+    constexpr int kShadowDebugMaxSize = 2048;
     bool g_debugShadowsOverrideEnabled = false;
     int g_debugShadowsOverrideMode = 1; // 1=visibility,2=cascade index,3=proj bounds
     int g_debugSelectedLightIndex = -1;
@@ -80,6 +101,10 @@ namespace {
     std::unordered_map<GLuint, uint64_t> g_shadowSamplersBoundFrame;
     float g_directionalCascadeKernelMarginTexels = 8.0f;
     float g_shadowReceiverNormalBlend = 1.0f;
+    bool g_shadowCacheEnabled = true;
+    ShadowCacheStats g_shadowCacheStats;
+    bool g_layeredShadowsEnabled = true;
+    ShadowPassStats g_shadowPassStats;
 
     /// @brief Represents Light Debug State data.
     struct LightDebugState {
@@ -94,6 +119,252 @@ namespace {
         float shadowRange = 0.0f;
     };
     std::vector<LightDebugState> g_lastLightDebug;
+    // Per-batch caster bounds in array form so each slot/face culls them in one sweep.
+    constexpr std::uint8_t kCasterHasBounds = 1u;
+    std::vector<Math3D::Vec3> g_casterBoundsMin;
+    std::vector<Math3D::Vec3> g_casterBoundsMax;
+    std::vector<std::uint8_t> g_casterFlags;
+    std::vector<std::uint32_t> g_visibleCasters;
+    // Per-caster bitmask of the cascades or cube faces a layered submission should reach.
+    std::vector<std::uint8_t> g_casterLayerMasks;
+    constexpr std::uint8_t kAllCubeFacesMask = 0x3F;
+    // Casters of one submission ordered by shadow draw key (layer mask, cull, mesh), and their instance matrices.
+    std::vector<std::uint32_t> g_casterDrawOrder;
+    std::vector<DrawKeys::Entry> g_casterKeys;
+    std::vector<DrawKeys::Entry> g_casterKeyScratch;
+    InstanceBatch g_casterInstances;
+    // Below this many casters a linear SIMD sweep beats walking a BVH.
+    constexpr size_t kCasterBvhMinItems = 128;
+    BoundsBVH g_casterBvh;
+    // Frame-wide caster bounds from BeginFrame, used to pick cascade depth-fit candidates.
+    std::vector<Math3D::Vec3> g_frameCasterMin;
+    std::vector<Math3D::Vec3> g_frameCasterMax;
+    BoundsBVH g_frameCasterBvh;
+    std::vector<std::uint32_t> g_cascadeCasterCandidates;
+
+    const BoundsBVH* updateFrameCasterBvh(const std::vector<ShadowCasterBounds>* casters){
+        if(!casters || casters->size() < kCasterBvhMinItems){
+            return nullptr;
+        }
+        g_frameCasterMin.clear();
+        g_frameCasterMax.clear();
+        for(const auto& caster : *casters){
+            g_frameCasterMin.push_back(caster.min);
+            g_frameCasterMax.push_back(caster.max);
+        }
+        g_frameCasterBvh.update(g_frameCasterMin.data(), g_frameCasterMax.data(), nullptr, 0, casters->size());
+        return &g_frameCasterBvh;
+    }
+
+    // Content keys are never 0, so a zeroed key always means "re-render".
+    constexpr std::uint64_t kShadowKeySeed = 1469598103934665603ull;
+    constexpr std::uint64_t kShadowKeyPrime = 1099511628211ull;
+
+    std::uint64_t hashShadowKey(std::uint64_t hash, const void* data, size_t size){
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        size_t offset = 0;
+        for(; offset + sizeof(std::uint32_t) <= size; offset += sizeof(std::uint32_t)){
+            std::uint32_t word = 0;
+            std::memcpy(&word, bytes + offset, sizeof(word));
+            hash = (hash ^ word) * kShadowKeyPrime;
+        }
+        for(; offset < size; ++offset){
+            hash = (hash ^ bytes[offset]) * kShadowKeyPrime;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    std::uint64_t hashShadowValue(std::uint64_t hash, const T& value){
+        return hashShadowKey(hash, &value, sizeof(T));
+    }
+
+    std::uint64_t hashShadowCasters(std::uint64_t hash,
+                                    const std::vector<const ShadowRenderer::ShadowDrawItem*>& items,
+                                    const std::vector<std::uint32_t>& drawn){
+        hash = hashShadowValue(hash, drawn.size());
+        for(std::uint32_t itemIndex : drawn){
+            const ShadowRenderer::ShadowDrawItem* item = items[itemIndex];
+            const std::uintptr_t meshAddress = reinterpret_cast<std::uintptr_t>(item->mesh);
+            hash = hashShadowValue(hash, meshAddress);
+            hash = hashShadowValue(hash, item->mesh->getRevision());
+            hash = hashShadowKey(hash, glm::value_ptr(item->model.data), sizeof(float) * 16);
+            hash = hashShadowValue(hash, static_cast<std::uint8_t>(item->enableBackfaceCulling ? 1 : 0));
+        }
+        return hash ? hash : 1;
+    }
+
+    std::uint64_t computeTileContentKey(const ShadowSlot2D& slot,
+                                        float slopeScale,
+                                        float depthUnits,
+                                        const std::vector<const ShadowRenderer::ShadowDrawItem*>& items,
+                                        const std::vector<std::uint32_t>& drawn){
+        std::uint64_t key = kShadowKeySeed;
+        key = hashShadowValue(key, g_shadowAtlas.getDepthTexture());
+        key = hashShadowValue(key, slot.tile.x);
+        key = hashShadowValue(key, slot.tile.y);
+        key = hashShadowValue(key, slot.tile.size);
+        key = hashShadowKey(key, glm::value_ptr(slot.matrix.data), sizeof(float) * 16);
+        key = hashShadowValue(key, slopeScale);
+        key = hashShadowValue(key, depthUnits);
+        return hashShadowCasters(key, items, drawn);
+    }
+
+    std::uint64_t computeCubeFaceContentKey(const ShadowSlotCube& slot,
+                                            size_t face,
+                                            const std::vector<const ShadowRenderer::ShadowDrawItem*>& items,
+                                            const std::vector<std::uint32_t>& drawn){
+        std::uint64_t key = kShadowKeySeed;
+        key = hashShadowValue(key, slot.map.getDepthTexture());
+        key = hashShadowValue(key, slot.map.getSize());
+        key = hashShadowValue(key, face);
+        key = hashShadowKey(key, glm::value_ptr(slot.matrices[face].data), sizeof(float) * 16);
+        key = hashShadowValue(key, slot.lightPos.x);
+        key = hashShadowValue(key, slot.lightPos.y);
+        key = hashShadowValue(key, slot.lightPos.z);
+        key = hashShadowValue(key, slot.farPlane);
+        return hashShadowCasters(key, items, drawn);
+    }
+
+    /// @brief Represents Caster Cull State data, so face culling only changes between casters that differ.
+    struct CasterCullState {
+        bool known = false;
+        bool enabled = true;
+    };
+
+    void applyCasterCull(bool enableBackfaceCulling, CasterCullState& cullState){
+        if(!cullState.known || cullState.enabled != enableBackfaceCulling){
+            if(enableBackfaceCulling){
+                glEnable(GL_CULL_FACE);
+                glCullFace(GL_BACK);
+            }else{
+                glDisable(GL_CULL_FACE);
+            }
+            cullState.enabled = enableBackfaceCulling;
+            cullState.known = true;
+            g_shadowPassStats.stateChanges++;
+        }
+    }
+
+    void drawShadowCaster(const ShadowRenderer::ShadowDrawItem& item, GLint modelLoc, CasterCullState& cullState){
+        applyCasterCull(item.enableBackfaceCulling, cullState);
+        if(modelLoc != -1){
+            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(item.model.data));
+        }
+        item.mesh->draw();
+    }
+
+    /**
+     * @brief Draws casters, merging runs that share mesh, cull state and layer mask into instanced draws.
+     * @param items Active casters.
+     * @param casterIndices Indices into `items` to draw.
+     * @param layerMasks Per-item layer masks for layered programs, or nullptr.
+     * @param modelLoc `u_model` location of the bound program.
+     * @param layerMaskLoc `u_layerMask` location of the bound program, or -1.
+     * @return Number of draw calls issued.
+     */
+    int drawShadowCasters(const std::vector<const ShadowRenderer::ShadowDrawItem*>& items,
+                          const std::vector<std::uint32_t>& casterIndices,
+                          const std::uint8_t* layerMasks,
+                          GLint modelLoc,
+                          GLint layerMaskLoc){
+        auto maskOf = [&](std::uint32_t index) -> std::uint8_t {
+            return layerMasks ? layerMasks[index] : std::uint8_t(0);
+        };
+        g_casterKeys.clear();
+        g_casterKeys.reserve(casterIndices.size());
+        for(std::uint32_t index : casterIndices){
+            DrawKeys::Entry entry;
+            entry.key = DrawKeys::MakeShadowKey(maskOf(index), items[index]->enableBackfaceCulling, items[index]->meshId);
+            entry.item = index;
+            g_casterKeys.push_back(entry);
+        }
+        DrawKeys::RadixSort(g_casterKeys, g_casterKeyScratch);
+        g_casterDrawOrder.clear();
+        for(const DrawKeys::Entry& entry : g_casterKeys){
+            g_casterDrawOrder.push_back(entry.item);
+        }
+        auto runEndAt = [&](size_t begin){
+            const ShadowRenderer::ShadowDrawItem& first = *items[g_casterDrawOrder[begin]];
+            const std::uint8_t firstMask = maskOf(g_casterDrawOrder[begin]);
+            size_t end = begin + 1;
+            while(end < g_casterDrawOrder.size()){
+                const ShadowRenderer::ShadowDrawItem& next = *items[g_casterDrawOrder[end]];
+                if(next.mesh != first.mesh ||
+                   next.enableBackfaceCulling != first.enableBackfaceCulling ||
+                   maskOf(g_casterDrawOrder[end]) != firstMask){
+                    break;
+                }
+                end++;
+            }
+            return end;
+        };
+
+        g_casterInstances.begin();
+        for(size_t begin = 0; begin < g_casterDrawOrder.size();){
+            const size_t end = runEndAt(begin);
+            if(end - begin >= InstanceBatch::MIN_INSTANCES){
+                for(size_t i = begin; i < end; ++i){
+                    g_casterInstances.add(items[g_casterDrawOrder[i]]->model);
+                }
+            }
+            begin = end;
+        }
+        g_casterInstances.upload();
+
+        static const Math3D::Mat4 IDENTITY;
+        CasterCullState cullState;
+        size_t nextInstance = 0;
+        int drawCalls = 0;
+        int lastMask = -1;
+        for(size_t begin = 0; begin < g_casterDrawOrder.size();){
+            const size_t end = runEndAt(begin);
+            const ShadowRenderer::ShadowDrawItem& first = *items[g_casterDrawOrder[begin]];
+            const int mask = maskOf(g_casterDrawOrder[begin]);
+            if(layerMaskLoc != -1 && layerMasks && mask != lastMask){
+                glUniform1i(layerMaskLoc, mask);
+                lastMask = mask;
+                g_shadowPassStats.stateChanges++;
+            }
+            if(end - begin >= InstanceBatch::MIN_INSTANCES){
+                applyCasterCull(first.enableBackfaceCulling, cullState);
+                if(modelLoc != -1){
+                    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(IDENTITY.data));
+                }
+                g_casterInstances.draw(*first.mesh, nextInstance, end - begin);
+                nextInstance += end - begin;
+                drawCalls++;
+            }else{
+                for(size_t i = begin; i < end; ++i){
+                    drawShadowCaster(*items[g_casterDrawOrder[i]], modelLoc, cullState);
+                    drawCalls++;
+                }
+            }
+            begin = end;
+        }
+        return drawCalls;
+    }
+
+    std::uint64_t getShadowCasterTriangles(const ShadowRenderer::ShadowDrawItem& item){
+        return static_cast<std::uint64_t>(item.mesh->getFaces().size() / 3);
+    }
+
+    std::uint64_t countLayerBits(std::uint8_t mask){
+        std::uint64_t count = 0;
+        for(; mask != 0; mask &= static_cast<std::uint8_t>(mask - 1)){
+            count++;
+        }
+        return count;
+    }
+
+    // Zeroes the depth row so a clip-space test only checks the light-space footprint.
+    Math3D::Mat4 withoutDepthClip(const Math3D::Mat4& clipMatrix){
+        Math3D::Mat4 result = clipMatrix;
+        for(int column = 0; column < 4; ++column){
+            result.data[column][2] = 0.0f;
+        }
+        return result;
+    }
 
     bool shouldCheckShadowGlErrors(){
         return g_debugShadowLogging;
@@ -113,6 +384,18 @@ namespace {
         return maxSize;
     }
 
+    bool supportsLayeredCascades(){
+        static bool cached = false;
+        static bool supported = false;
+        if(!cached){
+            GLint maxViewports = 0;
+            glGetIntegerv(GL_MAX_VIEWPORTS, &maxViewports);
+            supported = maxViewports >= DIRECTIONAL_CASCADE_COUNT;
+            cached = true;
+        }
+        return supported;
+    }
+
     int getMaxShadowMapSizeCube(){
         static bool cached = false;
         static int maxSize = 0;
@@ -127,9 +410,49 @@ namespace {
         return maxSize;
     }
 
-    int getShadowMapSize2D(const Light& light) {
-        int target = (light.type == LightType::DIRECTIONAL) ? SHADOW_MAP_SIZE_DIRECTIONAL : SHADOW_MAP_SIZE_SPOT;
-        return Math3D::Min(target, getMaxShadowMapSize2D());
+    bool ensureShadowAtlas(){
+        const int atlasSize = Math3D::Min(SHADOW_ATLAS_SIZE, getMaxShadowMapSize2D());
+        if(g_shadowAtlas.getSize() != atlasSize){
+            g_shadowAtlas.resize(atlasSize);
+            g_shadowAtlasAllocator.reset(atlasSize, SHADOW_ATLAS_MIN_TILE);
+            g_previousTileContent.clear();
+            for(auto& slot : g_shadow2D){
+                slot.contentKey = 0;
+            }
+        }
+        return g_shadowAtlas.getDepthTexture() != 0 && g_shadowAtlasAllocator.getAtlasSize() > 0;
+    }
+
+    std::uint64_t makeAtlasTileKey(size_t lightIndex, int cascadeIndex){
+        return (static_cast<std::uint64_t>(lightIndex) << 2) | static_cast<std::uint64_t>(cascadeIndex & 3);
+    }
+
+    const ShadowAtlasAllocator::Request* findAtlasTile(std::uint64_t key){
+        for(const auto& request : g_shadowAtlasRequests){
+            if(request.key == key){
+                return (request.rect.size > 0) ? &request : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    // A tile keeps last frame's contents only if the allocator never released it in between;
+    // otherwise another light may have drawn over that region.
+    void assignAtlasTile(ShadowSlot2D& slot, const ShadowAtlasAllocator::Request& request){
+        slot.tile = request.rect;
+        slot.tileKey = request.key;
+        auto previousIt = g_previousTileContent.find(request.key);
+        slot.contentKey = (request.retained && previousIt != g_previousTileContent.end()) ? previousIt->second : 0;
+    }
+
+    Math3D::Vec4 getAtlasUvRect(const ShadowAtlasAllocator::Rect& tile){
+        const float invAtlasSize = 1.0f / static_cast<float>(Math3D::Max(1, g_shadowAtlasAllocator.getAtlasSize()));
+        return Math3D::Vec4(
+            static_cast<float>(tile.x) * invAtlasSize,
+            static_cast<float>(tile.y) * invAtlasSize,
+            static_cast<float>(tile.size) * invAtlasSize,
+            static_cast<float>(tile.size) * invAtlasSize
+        );
     }
 
     int getShadowMapSizeCube() {
@@ -188,43 +511,6 @@ namespace {
         outCorners[7] = glm::vec3(maxV.x, maxV.y, maxV.z);
     }
 
-    bool aabbIntersectsClipFrustum(const Math3D::Vec3& minV, const Math3D::Vec3& maxV, const Math3D::Mat4& clipMatrix){
-        std::array<glm::vec3, 8> corners;
-        fillAabbCorners(minV, maxV, corners);
-
-        const glm::mat4 m = static_cast<glm::mat4>(clipMatrix);
-
-        bool allLeft = true;
-        bool allRight = true;
-        bool allBottom = true;
-        bool allTop = true;
-        bool allNear = true;
-        bool allFar = true;
-
-        for(const glm::vec3& corner : corners){
-            const glm::vec4 clip = m * glm::vec4(corner, 1.0f);
-            if(!std::isfinite(clip.x) || !std::isfinite(clip.y) || !std::isfinite(clip.z) || !std::isfinite(clip.w)){
-                return true; // Fail open on invalid math to avoid incorrect missing shadows.
-            }
-
-            allLeft = allLeft && (clip.x < -clip.w);
-            allRight = allRight && (clip.x > clip.w);
-            allBottom = allBottom && (clip.y < -clip.w);
-            allTop = allTop && (clip.y > clip.w);
-            allNear = allNear && (clip.z < -clip.w);
-            allFar = allFar && (clip.z > clip.w);
-        }
-
-        return !(allLeft || allRight || allBottom || allTop || allNear || allFar);
-    }
-
-    bool shadowItemIntersectsFrustum(const ShadowRenderer::ShadowDrawItem& item, const Math3D::Mat4& clipMatrix){
-        if(!item.hasBounds){
-            return true;
-        }
-        return aabbIntersectsClipFrustum(item.boundsMin, item.boundsMax, clipMatrix);
-    }
-
     bool shouldSkipLocalDirectionalCaster(const Light& light, const ShadowRenderer::ShadowDrawItem& item){
         if(!item.hasBounds){
             return false;
@@ -268,6 +554,16 @@ namespace {
         return distanceToCamera / safeRange;
     }
 
+    // Approximate fraction of the screen height covered by a light's shadow range; 1 or more
+    // once the camera is inside it.
+    float getShadowScreenCoverage(const Light& light, float distanceToCamera, PCamera camera){
+        float shadowRange = (light.shadowRange > 0.0f) ? light.shadowRange : light.range;
+        shadowRange = Math3D::Max(0.1f, safeFloat(shadowRange, 1.0f));
+        const float fov = camera ? camera->getSettings().fov : 45.0f;
+        const float tanHalfFov = Math3D::Max(0.01f, std::tan(glm::radians(Math3D::Clamp(fov, 1.0f, 170.0f) * 0.5f)));
+        return shadowRange / (Math3D::Max(0.001f, distanceToCamera) * tanHalfFov);
+    }
+
     bool shadowCandidateLess(const ShadowCandidate& a, const ShadowCandidate& b){
         int typePriorityA = getShadowTypePriority(a.type);
         int typePriorityB = getShadowTypePriority(b.type);
@@ -467,10 +763,11 @@ void ShadowRenderer::ensureShadowPrograms() {
         g_shadow2DProgram->setVertexShader(R"(
             #version 410 core
             layout (location = 0) in vec3 aPos;
+            layout (location = 5) in mat4 aInstanceModel;
             uniform mat4 u_model;
             uniform mat4 u_lightMatrix;
             void main() {
-                gl_Position = u_lightMatrix * u_model * vec4(aPos, 1.0);
+                gl_Position = u_lightMatrix * u_model * aInstanceModel * vec4(aPos, 1.0);
             }
         )");
         g_shadow2DProgram->setFragmentShader(R"(
@@ -488,11 +785,12 @@ void ShadowRenderer::ensureShadowPrograms() {
         g_shadowCubeProgram->setVertexShader(R"(
             #version 410 core
             layout (location = 0) in vec3 aPos;
+            layout (location = 5) in mat4 aInstanceModel;
             uniform mat4 u_model;
             uniform mat4 u_lightMatrix;
             out vec3 v_worldPos;
             void main() {
-                vec4 world = u_model * vec4(aPos, 1.0);
+                vec4 world = u_model * aInstanceModel * vec4(aPos, 1.0);
                 v_worldPos = world.xyz;
                 gl_Position = u_lightMatrix * world;
             }
@@ -513,6 +811,96 @@ void ShadowRenderer::ensureShadowPrograms() {
         }
     }
 
+    // Layered variants: the vertex stage stays in world space and an instanced geometry stage
+    // re-projects each triangle once per cascade viewport or cube face set in u_layerMask.
+    if(!g_shadowCascadeLayeredProgram){
+        g_shadowCascadeLayeredProgram = std::make_shared<ShaderProgram>();
+        g_shadowCascadeLayeredProgram->setVertexShader(R"(
+            #version 410 core
+            layout (location = 0) in vec3 aPos;
+            layout (location = 5) in mat4 aInstanceModel;
+            uniform mat4 u_model;
+            void main() {
+                gl_Position = u_model * aInstanceModel * vec4(aPos, 1.0);
+            }
+        )");
+        g_shadowCascadeLayeredProgram->setGeometryShader(R"(
+            #version 410 core
+            layout (triangles, invocations = 4) in;
+            layout (triangle_strip, max_vertices = 3) out;
+            uniform mat4 u_layerMatrices[4];
+            uniform int u_layerMask;
+            void main() {
+                if((u_layerMask & (1 << gl_InvocationID)) == 0){
+                    return;
+                }
+                for(int i = 0; i < 3; ++i){
+                    gl_ViewportIndex = gl_InvocationID;
+                    gl_Position = u_layerMatrices[gl_InvocationID] * gl_in[i].gl_Position;
+                    EmitVertex();
+                }
+                EndPrimitive();
+            }
+        )");
+        g_shadowCascadeLayeredProgram->setFragmentShader(R"(
+            #version 410 core
+            void main() { }
+        )");
+        g_shadowCascadeLayeredProgram->compile();
+        if(g_shadowCascadeLayeredProgram->getID() == 0){
+            LogBot.Log(LOG_WARN, "Layered cascade shadow shader failed to compile/link, using per-cascade passes: \n%s",
+                g_shadowCascadeLayeredProgram->getLog().c_str());
+        }
+    }
+
+    if(!g_shadowCubeLayeredProgram){
+        g_shadowCubeLayeredProgram = std::make_shared<ShaderProgram>();
+        g_shadowCubeLayeredProgram->setVertexShader(R"(
+            #version 410 core
+            layout (location = 0) in vec3 aPos;
+            layout (location = 5) in mat4 aInstanceModel;
+            uniform mat4 u_model;
+            void main() {
+                gl_Position = u_model * aInstanceModel * vec4(aPos, 1.0);
+            }
+        )");
+        g_shadowCubeLayeredProgram->setGeometryShader(R"(
+            #version 410 core
+            layout (triangles, invocations = 6) in;
+            layout (triangle_strip, max_vertices = 3) out;
+            uniform mat4 u_layerMatrices[6];
+            uniform int u_layerMask;
+            out vec3 v_worldPos;
+            void main() {
+                if((u_layerMask & (1 << gl_InvocationID)) == 0){
+                    return;
+                }
+                for(int i = 0; i < 3; ++i){
+                    gl_Layer = gl_InvocationID;
+                    v_worldPos = gl_in[i].gl_Position.xyz;
+                    gl_Position = u_layerMatrices[gl_InvocationID] * gl_in[i].gl_Position;
+                    EmitVertex();
+                }
+                EndPrimitive();
+            }
+        )");
+        g_shadowCubeLayeredProgram->setFragmentShader(R"(
+            #version 410 core
+            in vec3 v_worldPos;
+            uniform vec3 u_lightPos;
+            uniform float u_farPlane;
+            void main() {
+                float dist = length(v_worldPos - u_lightPos);
+                gl_FragDepth = dist / u_farPlane;
+            }
+        )");
+        g_shadowCubeLayeredProgram->compile();
+        if(g_shadowCubeLayeredProgram->getID() == 0){
+            LogBot.Log(LOG_WARN, "Layered cube shadow shader failed to compile/link, using per-face passes: \n%s",
+                g_shadowCubeLayeredProgram->getLog().c_str());
+        }
+    }
+
 }
 
 Math3D::Mat4 ShadowRenderer::computeDirectionalMatrix(const Light& light, PCamera camera) {
@@ -592,7 +980,8 @@ static void computeDirectionalCascades(
     int cascadeCount,
     std::vector<float>& outSplits,
     std::vector<Math3D::Mat4>& outMatrices,
-    const std::vector<ShadowCasterBounds>* casters
+    const std::vector<ShadowCasterBounds>* casters,
+    const BoundsBVH* casterTree
 ){
     outSplits.clear();
     outMatrices.clear();
@@ -766,7 +1155,38 @@ static void computeDirectionalCascades(
             const float stableMaxY = halfSize;
             const float marginX = (stableMaxX - stableMinX) * kCascadeCasterXYMarginFactor;
             const float marginY = (stableMaxY - stableMinY) * kCascadeCasterXYMarginFactor;
-            for(const auto& caster : *casters){
+
+            g_cascadeCasterCandidates.clear();
+            Math3D::Vec3 rootMin;
+            Math3D::Vec3 rootMax;
+            if(casterTree && casterTree->getRootBounds(rootMin, rootMax)){
+                // Light-space ortho box over the XY window below and the depth of every caster, so the
+                // tree query only drops casters the exact XY test rejects. The slack absorbs rounding.
+                fillAabbCorners(rootMin, rootMax, casterCorners);
+                float rootMinZ = FLT_MAX;
+                float rootMaxZ = -FLT_MAX;
+                for(const auto& corner : casterCorners){
+                    const float z = (lightView * glm::vec4(corner, 1.0f)).z;
+                    rootMinZ = std::min(rootMinZ, z);
+                    rootMaxZ = std::max(rootMaxZ, z);
+                }
+                const float slackXY = (halfSize + marginX) * 1e-3f + 1e-3f;
+                const float slackZ = (rootMaxZ - rootMinZ) * 1e-3f + 1.0f;
+                const glm::mat4 candidateProj = glm::ortho(
+                    stableMinX - marginX - slackXY, stableMaxX + marginX + slackXY,
+                    stableMinY - marginY - slackXY, stableMaxY + marginY + slackXY,
+                    -rootMaxZ - slackZ, -rootMinZ + slackZ
+                );
+                casterTree->queryFrustum(Math3D::Mat4(candidateProj * lightView), g_cascadeCasterCandidates);
+            }else{
+                g_cascadeCasterCandidates.resize(casters->size());
+                for(size_t casterIndex = 0; casterIndex < casters->size(); ++casterIndex){
+                    g_cascadeCasterCandidates[casterIndex] = static_cast<std::uint32_t>(casterIndex);
+                }
+            }
+
+            for(std::uint32_t casterIndex : g_cascadeCasterCandidates){
+                const auto& caster = (*casters)[casterIndex];
                 fillAabbCorners(caster.min, caster.max, casterCorners);
 
                 glm::vec3 casterMinLS(FLT_MAX);
@@ -877,18 +1297,24 @@ void ShadowRenderer::computePointMatrices(const Light& light, std::vector<Math3D
 
 void ShadowRenderer::BeginFrame(PCamera camera, const std::vector<ShadowCasterBounds>* casters) {
     g_shadowFrameId++;
+    g_shadowCacheStats = ShadowCacheStats{};
+    g_shadowPassStats = ShadowPassStats{};
     g_enabled = (camera != nullptr && !camera->getSettings().isOrtho);
     if(!g_enabled){
         return;
     }
 
     g_lightData.clear();
-    g_lightData.resize(MAX_LIGHTS);
 
     ensureShadowPrograms();
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &g_savedFbo);
     glGetIntegerv(GL_VIEWPORT, g_savedViewport);
 
+    // Atlas tiles move between slots as lights come and go, so cached contents follow the tile key.
+    g_previousTileContent.clear();
+    for(int i = 0; i < g_active2D && i < static_cast<int>(g_shadow2D.size()); ++i){
+        g_previousTileContent[g_shadow2D[i].tileKey] = g_shadow2D[i].contentKey;
+    }
     g_active2D = 0;
     g_activeCube = 0;
 
@@ -897,6 +1323,10 @@ void ShadowRenderer::BeginFrame(PCamera camera, const std::vector<ShadowCasterBo
         g_enabled = false;
         return;
     }
+    g_lightData.resize(Math3D::Min(lights.size(), static_cast<size_t>(MAX_LIGHTS)));
+
+    const BoundsBVH* frameCasterTree = nullptr;
+    bool frameCasterTreeReady = false;
 
     if(g_lastLightDebug.size() != lights.size()){
         g_lastLightDebug.clear();
@@ -953,8 +1383,9 @@ void ShadowRenderer::BeginFrame(PCamera camera, const std::vector<ShadowCasterBo
     std::sort(candidates2D.begin(), candidates2D.end(), shadowCandidateLess);
     std::sort(candidatesCube.begin(), candidatesCube.end(), shadowCandidateLess);
 
+    // Every 2D map lives in the atlas, so directional and spot shadows need one sampler unit between them.
     const int samplerBudget = getAvailableShadowSamplerUnits();
-    const int max2DSlots = Math3D::Min(MAX_SHADOW_MAPS_2D, samplerBudget);
+    const int max2DSlots = (samplerBudget > 0 && !candidates2D.empty() && ensureShadowAtlas()) ? MAX_SHADOW_MAPS_2D : 0;
     int remaining2DSlots = max2DSlots;
     for(const ShadowCandidate& candidate : candidates2D){
         if(candidate.slotCost <= remaining2DSlots){
@@ -963,8 +1394,36 @@ void ShadowRenderer::BeginFrame(PCamera camera, const std::vector<ShadowCasterBo
         }
     }
 
-    const int used2DSlots = max2DSlots - remaining2DSlots;
-    const int remainingSamplerSlots = Math3D::Max(0, samplerBudget - used2DSlots);
+    g_shadowAtlasRequests.clear();
+    for(const ShadowCandidate& candidate : candidates2D){
+        if(!allow2D[candidate.lightIndex]){
+            continue;
+        }
+        const Light& light = lights[candidate.lightIndex];
+        for(int c = 0; c < candidate.slotCost; ++c){
+            ShadowAtlasAllocator::Request request;
+            request.key = makeAtlasTileKey(candidate.lightIndex, c);
+            if(light.type == LightType::DIRECTIONAL){
+                // Directional cascades outrank every spot; later cascades give way first.
+                request.desiredSize = SHADOW_MAP_SIZE_DIRECTIONAL;
+                request.priority = SHADOW_ATLAS_DIRECTIONAL_PRIORITY - static_cast<float>(c);
+            }else{
+                const float coverage = getShadowScreenCoverage(light, candidate.distanceToCamera, camera);
+                request.desiredSize = Math3D::Max(
+                    SHADOW_ATLAS_MIN_TILE,
+                    static_cast<int>(static_cast<float>(SHADOW_ATLAS_MAX_SPOT_TILE) * Math3D::Clamp(coverage, 0.0f, 1.0f))
+                );
+                request.priority = coverage;
+            }
+            g_shadowAtlasRequests.push_back(request);
+        }
+    }
+    if(g_shadowAtlasAllocator.getAtlasSize() > 0){
+        g_shadowAtlasAllocator.assign(g_shadowAtlasRequests);
+    }
+
+    const int used2DSamplers = (remaining2DSlots < max2DSlots) ? 1 : 0;
+    const int remainingSamplerSlots = Math3D::Max(0, samplerBudget - used2DSamplers);
     int remainingCubeSlots = Math3D::Min(MAX_SHADOW_MAPS_CUBE, remainingSamplerSlots);
     for(const ShadowCandidate& candidate : candidatesCube){
         if(candidate.slotCost <= remainingCubeSlots){
@@ -999,30 +1458,29 @@ void ShadowRenderer::BeginFrame(PCamera camera, const std::vector<ShadowCasterBo
                         splits.push_back(Math3D::Min(camera->getSettings().farPlane, shadowRange));
                         cascadeCount = 1;
                     }else{
-                        computeDirectionalCascades(light, camera, cascadeCount, splits, matrices, casters);
+                        if(!frameCasterTreeReady){
+                            frameCasterTree = updateFrameCasterBvh(casters);
+                            frameCasterTreeReady = true;
+                        }
+                        computeDirectionalCascades(light, camera, cascadeCount, splits, matrices, casters, frameCasterTree);
                         cascadeCount = Math3D::Max(1, static_cast<int>(matrices.size()));
                     }
 
                     if(g_active2D + cascadeCount <= MAX_SHADOW_MAPS_2D){
-                        if(static_cast<int>(g_shadow2D.size()) < g_active2D + cascadeCount){
-                            while(static_cast<int>(g_shadow2D.size()) < g_active2D + cascadeCount){
-                                g_shadow2D.push_back(ShadowSlot2D{ShadowMap2D(getShadowMapSize2D(light))});
-                            }
+                        while(static_cast<int>(g_shadow2D.size()) < g_active2D + cascadeCount){
+                            g_shadow2D.push_back(ShadowSlot2D{});
                         }
 
-                        int mapSize = getShadowMapSize2D(light);
                         bool hasValidMap = true;
-                        for(int c = 0; c < cascadeCount; ++c){
+                        for(int c = 0; c < cascadeCount && hasValidMap; ++c){
+                            hasValidMap = (findAtlasTile(makeAtlasTileKey(i, c)) != nullptr);
+                        }
+                        for(int c = 0; c < cascadeCount && hasValidMap; ++c){
                             ShadowSlot2D& slot = g_shadow2D[g_active2D];
-                            if(slot.map.getSize() != mapSize){
-                                slot.map.resize(mapSize);
-                            }
-                            if(slot.map.getDepthTexture() == 0 || slot.map.getSize() <= 0){
-                                hasValidMap = false;
-                                break;
-                            }
+                            assignAtlasTile(slot, *findAtlasTile(makeAtlasTileKey(i, c)));
                             slot.lightIndex = static_cast<int>(i);
                             slot.matrix = (c < static_cast<int>(matrices.size())) ? matrices[c] : Math3D::Mat4(1.0f);
+                            data.atlasRects[c] = getAtlasUvRect(slot.tile);
                             if(c == 0){
                                 data.shadowMapIndex = g_active2D;
                             }
@@ -1044,6 +1502,9 @@ void ShadowRenderer::BeginFrame(PCamera camera, const std::vector<ShadowCasterBo
                         if(!hasValidMap){
                             data.shadowMapIndex = -1;
                             data.cascadeCount = 0;
+                            if(g_debugShadowLogging){
+                                LogBot.Log(LOG_INFO, "[Shadow] Directional dropped from atlas idx=%zu", i);
+                            }
                         }
                     }
                 }else if(g_debugShadowLogging){
@@ -1055,26 +1516,29 @@ void ShadowRenderer::BeginFrame(PCamera camera, const std::vector<ShadowCasterBo
                         LogBot.Log(LOG_INFO, "[Shadow] Spot skipped by budget idx=%zu", i);
                     }
                 }else if(g_active2D < MAX_SHADOW_MAPS_2D && isValidLightDir(light.direction)){
-                    int mapSize = getShadowMapSize2D(light);
-                    if(static_cast<int>(g_shadow2D.size()) <= g_active2D){
-                        g_shadow2D.push_back(ShadowSlot2D{ShadowMap2D(mapSize)});
-                    }else if(g_shadow2D[g_active2D].map.getSize() != mapSize){
-                        g_shadow2D[g_active2D].map.resize(mapSize);
-                    }
+                    const ShadowAtlasAllocator::Request* tile = findAtlasTile(makeAtlasTileKey(i, 0));
+                    if(tile){
+                        if(static_cast<int>(g_shadow2D.size()) <= g_active2D){
+                            g_shadow2D.push_back(ShadowSlot2D{});
+                        }
 
-                    ShadowSlot2D& slot = g_shadow2D[g_active2D];
-                    slot.lightIndex = static_cast<int>(i);
-                    slot.matrix = computeSpotMatrix(light);
-                    if(slot.map.getDepthTexture() != 0 && slot.map.getSize() > 0){
+                        ShadowSlot2D& slot = g_shadow2D[g_active2D];
+                        assignAtlasTile(slot, *tile);
+                        slot.lightIndex = static_cast<int>(i);
+                        slot.matrix = computeSpotMatrix(light);
                         data.shadowMapIndex = g_active2D;
                         data.cascadeCount = 1;
                         float shadowRange = (light.shadowRange > 0.0f) ? light.shadowRange : light.range;
                         data.cascadeSplits = Math3D::Vec4(shadowRange, shadowRange, shadowRange, shadowRange);
                         data.lightMatrices[0] = slot.matrix;
+                        data.atlasRects[0] = getAtlasUvRect(slot.tile);
                         if(g_debugShadowLogging){
-                            LogBot.Log(LOG_INFO, "[Shadow] Spot alloc idx=%zu mapIndex=%d mapSize=%d", i, g_active2D, mapSize);
+                            LogBot.Log(LOG_INFO, "[Shadow] Spot alloc idx=%zu mapIndex=%d tile=(%d,%d,%d)", i, g_active2D,
+                                slot.tile.x, slot.tile.y, slot.tile.size);
                         }
                         g_active2D++;
+                    }else if(g_debugShadowLogging){
+                        LogBot.Log(LOG_INFO, "[Shadow] Spot dropped from atlas idx=%zu", i);
                     }
                 }else if(!isValidLightDir(light.direction)){
                     if(g_debugShadowLogging){
@@ -1093,6 +1557,7 @@ void ShadowRenderer::BeginFrame(PCamera camera, const std::vector<ShadowCasterBo
                         g_shadowCube.push_back(ShadowSlotCube{ShadowMapCube(mapSize)});
                     }else if(g_shadowCube[g_activeCube].map.getSize() != mapSize){
                         g_shadowCube[g_activeCube].map.resize(mapSize);
+                        g_shadowCube[g_activeCube].faceContentKeys.fill(0);
                     }
 
                     ShadowSlotCube& slot = g_shadowCube[g_activeCube];
@@ -1181,9 +1646,9 @@ void ShadowRenderer::RenderShadows(const std::shared_ptr<Mesh>& mesh, const Math
     std::vector<ShadowDrawItem> items;
     items.reserve(1);
     ShadowDrawItem item;
-    item.mesh = mesh;
+    item.mesh = mesh.get();
     item.model = model;
-    item.material = material;
+    item.material = material.get();
     items.push_back(std::move(item));
     RenderShadowsBatch(items);
 }
@@ -1215,6 +1680,41 @@ void ShadowRenderer::RenderShadowsBatch(const std::vector<ShadowDrawItem>& items
         return;
     }
 
+    g_casterBoundsMin.clear();
+    g_casterBoundsMax.clear();
+    g_casterFlags.clear();
+    for(const ShadowDrawItem* item : activeItems){
+        g_casterBoundsMin.push_back(item->boundsMin);
+        g_casterBoundsMax.push_back(item->boundsMax);
+        g_casterFlags.push_back(item->hasBounds ? kCasterHasBounds : 0);
+    }
+    const bool useCasterBvh = activeItems.size() >= kCasterBvhMinItems;
+    if(useCasterBvh){
+        g_casterBvh.update(
+            g_casterBoundsMin.data(),
+            g_casterBoundsMax.data(),
+            g_casterFlags.data(),
+            kCasterHasBounds,
+            activeItems.size()
+        );
+    }
+    auto cullCasters = [&](const Math3D::Mat4& clipMatrix){
+        g_visibleCasters.clear();
+        if(useCasterBvh){
+            g_casterBvh.queryFrustum(clipMatrix, g_visibleCasters);
+            return;
+        }
+        FrustumCulling::CullAabbs(
+            g_casterBoundsMin.data(),
+            g_casterBoundsMax.data(),
+            g_casterFlags.data(),
+            kCasterHasBounds,
+            activeItems.size(),
+            clipMatrix,
+            g_visibleCasters
+        );
+    };
+
     g_inShadowPass = true;
     glEnable(GL_DEPTH_TEST);
     glDepthMask(GL_TRUE);
@@ -1225,7 +1725,13 @@ void ShadowRenderer::RenderShadowsBatch(const std::vector<ShadowDrawItem>& items
     glEnable(GL_POLYGON_OFFSET_FILL);
     glPolygonOffset(0.0f, 0.0f);
 
-    if(g_shadow2DProgram && g_shadow2DProgram->getID() != 0){
+    const bool layeredCascades = g_layeredShadowsEnabled && supportsLayeredCascades() &&
+        g_shadowCascadeLayeredProgram && g_shadowCascadeLayeredProgram->getID() != 0;
+    const bool layeredCubes = g_layeredShadowsEnabled &&
+        g_shadowCubeLayeredProgram && g_shadowCubeLayeredProgram->getID() != 0;
+    g_casterLayerMasks.assign(activeItems.size(), 0);
+
+    if(g_active2D > 0 && g_shadowAtlas.getDepthTexture() != 0 && g_shadow2DProgram && g_shadow2DProgram->getID() != 0){
         // Directional/spot maps: tune raster slope bias per light type.
         glPolygonOffset(0.6f, 1.5f);
         g_shadow2DProgram->bind();
@@ -1237,10 +1743,32 @@ void ShadowRenderer::RenderShadowsBatch(const std::vector<ShadowDrawItem>& items
             s_2dLightMatrixLoc = glGetUniformLocation(s_cached2DProgram, "u_lightMatrix");
             s_2dModelLoc = glGetUniformLocation(s_cached2DProgram, "u_model");
         }
+        static GLuint s_cachedCascadeProgram = 0;
+        static GLint s_cascadeMatricesLoc = -1;
+        static GLint s_cascadeMaskLoc = -1;
+        static GLint s_cascadeModelLoc = -1;
+        if(layeredCascades && s_cachedCascadeProgram != g_shadowCascadeLayeredProgram->getID()){
+            s_cachedCascadeProgram = g_shadowCascadeLayeredProgram->getID();
+            s_cascadeMatricesLoc = getSamplerArrayLocation(s_cachedCascadeProgram, "u_layerMatrices");
+            s_cascadeMaskLoc = glGetUniformLocation(s_cachedCascadeProgram, "u_layerMask");
+            s_cascadeModelLoc = glGetUniformLocation(s_cachedCascadeProgram, "u_model");
+        }
         const auto& activeLights = getActiveLights();
+        // Each slot draws into its own atlas tile; the scissor keeps clears inside the tile.
+        const GLboolean scissorWasEnabled = glIsEnabled(GL_SCISSOR_TEST);
+        GLint savedScissor[4] = {0,0,0,0};
+        glGetIntegerv(GL_SCISSOR_BOX, savedScissor);
+        bool atlasBound = false;
+        auto bindAtlas = [&](){
+            if(!atlasBound){
+                g_shadowAtlas.bind();
+                glEnable(GL_SCISSOR_TEST);
+                atlasBound = true;
+            }
+        };
         for(int i = 0; i < g_active2D; ++i){
-            const auto& slot = g_shadow2D[i];
-            if(slot.map.getDepthTexture() == 0 || slot.map.getSize() <= 0){
+            auto& slot = g_shadow2D[i];
+            if(slot.tile.size <= 0){
                 continue;
             }
             bool directionalSlot = false;
@@ -1276,40 +1804,125 @@ void ShadowRenderer::RenderShadowsBatch(const std::vector<ShadowDrawItem>& items
                     slotDepthUnits = 2.30f * shadowTypeScale;
                 }
             }
+
+            if(layeredCascades && directionalSlot && !directionalSingleCascade){
+                // All cascades of this light go out in one submission; each caster only reaches
+                // the dirty cascades whose footprint it overlaps.
+                int runEnd = i + 1;
+                while(runEnd < g_active2D && runEnd - i < DIRECTIONAL_CASCADE_COUNT &&
+                      g_shadow2D[runEnd].lightIndex == slot.lightIndex && g_shadow2D[runEnd].tile.size > 0){
+                    runEnd++;
+                }
+                const int layerCount = runEnd - i;
+                std::uint8_t dirtyMask = 0;
+                std::fill(g_casterLayerMasks.begin(), g_casterLayerMasks.end(), std::uint8_t(0));
+                for(int layer = 0; layer < layerCount; ++layer){
+                    ShadowSlot2D& cascadeSlot = g_shadow2D[i + layer];
+                    cullCasters(withoutDepthClip(cascadeSlot.matrix));
+                    const std::uint64_t cascadeKey = computeTileContentKey(cascadeSlot, slotSlopeScale, slotDepthUnits, activeItems, g_visibleCasters);
+                    if(g_shadowCacheEnabled && cascadeSlot.contentKey == cascadeKey){
+                        g_shadowCacheStats.reused2D++;
+                        continue;
+                    }
+                    cascadeSlot.contentKey = cascadeKey;
+                    g_shadowCacheStats.rendered2D++;
+                    dirtyMask |= static_cast<std::uint8_t>(1u << layer);
+                    for(std::uint32_t itemIndex : g_visibleCasters){
+                        g_casterLayerMasks[itemIndex] |= static_cast<std::uint8_t>(1u << layer);
+                    }
+                }
+
+                if(dirtyMask != 0){
+                    bindAtlas();
+                    float layerMatrices[16 * DIRECTIONAL_CASCADE_COUNT] = {0.0f};
+                    for(int layer = 0; layer < layerCount; ++layer){
+                        const ShadowSlot2D& cascadeSlot = g_shadow2D[i + layer];
+                        const ShadowAtlasAllocator::Rect& tile = cascadeSlot.tile;
+                        if(dirtyMask & (1u << layer)){
+                            glScissor(tile.x, tile.y, tile.size, tile.size);
+                            glClear(GL_DEPTH_BUFFER_BIT);
+                        }
+                        std::memcpy(layerMatrices + layer * 16, glm::value_ptr(cascadeSlot.matrix.data), sizeof(float) * 16);
+                    }
+                    for(int layer = 0; layer < layerCount; ++layer){
+                        const ShadowAtlasAllocator::Rect& tile = g_shadow2D[i + layer].tile;
+                        glViewportIndexedf(static_cast<GLuint>(layer), static_cast<float>(tile.x), static_cast<float>(tile.y),
+                                           static_cast<float>(tile.size), static_cast<float>(tile.size));
+                        glScissorIndexed(static_cast<GLuint>(layer), tile.x, tile.y, tile.size, tile.size);
+                    }
+
+                    g_shadowCascadeLayeredProgram->bind();
+                    glPolygonOffset(slotSlopeScale, slotDepthUnits);
+                    if(s_cascadeMatricesLoc != -1){
+                        glUniformMatrix4fv(s_cascadeMatricesLoc, layerCount, GL_FALSE, layerMatrices);
+                    }
+                    g_visibleCasters.clear();
+                    for(size_t itemIndex = 0; itemIndex < activeItems.size(); ++itemIndex){
+                        g_casterLayerMasks[itemIndex] &= dirtyMask;
+                        const std::uint8_t layerMask = g_casterLayerMasks[itemIndex];
+                        if(layerMask == 0){
+                            continue;
+                        }
+                        g_visibleCasters.push_back(static_cast<std::uint32_t>(itemIndex));
+                        const std::uint64_t triangles = getShadowCasterTriangles(*activeItems[itemIndex]);
+                        g_shadowPassStats.triangles2D += triangles;
+                        g_shadowPassStats.layerTriangles2D += triangles * countLayerBits(layerMask);
+                    }
+                    g_shadowPassStats.drawCalls2D += drawShadowCasters(
+                        activeItems, g_visibleCasters, g_casterLayerMasks.data(), s_cascadeModelLoc, s_cascadeMaskLoc
+                    );
+                    glEnable(GL_CULL_FACE);
+                    glCullFace(GL_BACK);
+                    g_shadow2DProgram->bind();
+                    if(shouldCheckShadowGlErrors()){
+                        GLenum err = glGetError();
+                        if(err != GL_NO_ERROR){
+                            LogBot.Log(LOG_ERRO, "[Shadow] GL error during layered cascade draw slot %d: 0x%X", i, err);
+                        }
+                    }
+                }
+                i = runEnd - 1;
+                continue;
+            }
+
+            if(directionalSlot && !directionalSingleCascade){
+                // Cascades are orthographic, so only the footprint matters; casters in front of
+                // the near plane still have to be drawn.
+                cullCasters(withoutDepthClip(slot.matrix));
+            }else{
+                cullCasters(slot.matrix);
+            }
+            if(directionalSlot && directionalSingleCascade && slotLight){
+                g_visibleCasters.erase(
+                    std::remove_if(g_visibleCasters.begin(), g_visibleCasters.end(), [&](std::uint32_t itemIndex){
+                        return shouldSkipLocalDirectionalCaster(*slotLight, *activeItems[itemIndex]);
+                    }),
+                    g_visibleCasters.end()
+                );
+            }
+
+            const std::uint64_t slotKey = computeTileContentKey(slot, slotSlopeScale, slotDepthUnits, activeItems, g_visibleCasters);
+            if(g_shadowCacheEnabled && slot.contentKey == slotKey){
+                g_shadowCacheStats.reused2D++;
+                continue;
+            }
+            slot.contentKey = slotKey;
+            g_shadowCacheStats.rendered2D++;
+
             glPolygonOffset(slotSlopeScale, slotDepthUnits);
-            slot.map.bind();
-            glViewport(0, 0, slot.map.getSize(), slot.map.getSize());
+            bindAtlas();
+            glViewport(slot.tile.x, slot.tile.y, slot.tile.size, slot.tile.size);
+            glScissor(slot.tile.x, slot.tile.y, slot.tile.size, slot.tile.size);
             glClear(GL_DEPTH_BUFFER_BIT);
             if(s_2dLightMatrixLoc != -1){
                 glUniformMatrix4fv(s_2dLightMatrixLoc, 1, GL_FALSE, glm::value_ptr(slot.matrix.data));
             }
-            bool cullStateKnown = false;
-            bool cullEnabled = true;
-            for(const ShadowDrawItem* item : activeItems){
-                const bool shouldCullByFrustum = (!directionalSlot) || directionalSingleCascade;
-                if(shouldCullByFrustum && !shadowItemIntersectsFrustum(*item, slot.matrix)){
-                    continue;
-                }
-                if(directionalSlot && directionalSingleCascade && slotLight &&
-                   shouldSkipLocalDirectionalCaster(*slotLight, *item)){
-                    continue;
-                }
-                if(!cullStateKnown || cullEnabled != item->enableBackfaceCulling){
-                    if(item->enableBackfaceCulling){
-                        glEnable(GL_CULL_FACE);
-                        glCullFace(GL_BACK);
-                        cullEnabled = true;
-                    }else{
-                        glDisable(GL_CULL_FACE);
-                        cullEnabled = false;
-                    }
-                    cullStateKnown = true;
-                }
-                if(s_2dModelLoc != -1){
-                    glUniformMatrix4fv(s_2dModelLoc, 1, GL_FALSE, glm::value_ptr(item->model.data));
-                }
-                item->mesh->draw();
+            for(std::uint32_t itemIndex : g_visibleCasters){
+                const std::uint64_t triangles = getShadowCasterTriangles(*activeItems[itemIndex]);
+                g_shadowPassStats.triangles2D += triangles;
+                g_shadowPassStats.layerTriangles2D += triangles;
             }
+            g_shadowPassStats.drawCalls2D += drawShadowCasters(activeItems, g_visibleCasters, nullptr, s_2dModelLoc, -1);
             glEnable(GL_CULL_FACE);
             glCullFace(GL_BACK);
             if(shouldCheckShadowGlErrors()){
@@ -1319,27 +1932,38 @@ void ShadowRenderer::RenderShadowsBatch(const std::vector<ShadowDrawItem>& items
                 }
             }
         }
+        if(atlasBound){
+            glScissor(savedScissor[0], savedScissor[1], savedScissor[2], savedScissor[3]);
+            if(!scissorWasEnabled){
+                glDisable(GL_SCISSOR_TEST);
+            }
+        }
     }
 
-    if(g_shadowCubeProgram && g_shadowCubeProgram->getID() != 0){
+    std::shared_ptr<ShaderProgram> cubeProgram = layeredCubes ? g_shadowCubeLayeredProgram : g_shadowCubeProgram;
+    if(g_activeCube > 0 && cubeProgram && cubeProgram->getID() != 0){
         // Point maps: mild raster bias; shader-side kernel and bias handle the rest.
         glCullFace(GL_BACK);
         glPolygonOffset(0.4f, 0.8f);
-        g_shadowCubeProgram->bind();
+        cubeProgram->bind();
         static GLuint s_cachedCubeProgram = 0;
         static GLint s_lightPosLoc = -1;
         static GLint s_farPlaneLoc = -1;
         static GLint s_cubeLightMatrixLoc = -1;
         static GLint s_cubeModelLoc = -1;
-        if(s_cachedCubeProgram != g_shadowCubeProgram->getID()){
-            s_cachedCubeProgram = g_shadowCubeProgram->getID();
+        static GLint s_cubeLayerMatricesLoc = -1;
+        static GLint s_cubeLayerMaskLoc = -1;
+        if(s_cachedCubeProgram != cubeProgram->getID()){
+            s_cachedCubeProgram = cubeProgram->getID();
             s_lightPosLoc = glGetUniformLocation(s_cachedCubeProgram, "u_lightPos");
             s_farPlaneLoc = glGetUniformLocation(s_cachedCubeProgram, "u_farPlane");
             s_cubeLightMatrixLoc = glGetUniformLocation(s_cachedCubeProgram, "u_lightMatrix");
             s_cubeModelLoc = glGetUniformLocation(s_cachedCubeProgram, "u_model");
+            s_cubeLayerMatricesLoc = getSamplerArrayLocation(s_cachedCubeProgram, "u_layerMatrices");
+            s_cubeLayerMaskLoc = glGetUniformLocation(s_cachedCubeProgram, "u_layerMask");
         }
         for(int i = 0; i < g_activeCube; ++i){
-            const auto& slot = g_shadowCube[i];
+            auto& slot = g_shadowCube[i];
             if(slot.map.getDepthTexture() == 0 || slot.map.getSize() <= 0){
                 continue;
             }
@@ -1349,35 +1973,100 @@ void ShadowRenderer::RenderShadowsBatch(const std::vector<ShadowDrawItem>& items
             if(s_farPlaneLoc != -1){
                 glUniform1f(s_farPlaneLoc, slot.farPlane);
             }
-            for(size_t face = 0; face < slot.matrices.size(); ++face){
+
+            if(layeredCubes){
+                // One submission per caster; the geometry stage fans it out to the dirty faces it touches.
+                std::uint8_t dirtyMask = 0;
+                std::fill(g_casterLayerMasks.begin(), g_casterLayerMasks.end(), std::uint8_t(0));
+                const size_t faceCount = Math3D::Min(slot.matrices.size(), slot.faceContentKeys.size());
+                for(size_t face = 0; face < faceCount; ++face){
+                    cullCasters(slot.matrices[face]);
+                    const std::uint64_t faceKey = computeCubeFaceContentKey(slot, face, activeItems, g_visibleCasters);
+                    if(g_shadowCacheEnabled && slot.faceContentKeys[face] == faceKey){
+                        g_shadowCacheStats.reusedCubeFaces++;
+                        continue;
+                    }
+                    slot.faceContentKeys[face] = faceKey;
+                    g_shadowCacheStats.renderedCubeFaces++;
+                    dirtyMask |= static_cast<std::uint8_t>(1u << face);
+                    for(std::uint32_t itemIndex : g_visibleCasters){
+                        g_casterLayerMasks[itemIndex] |= static_cast<std::uint8_t>(1u << face);
+                    }
+                }
+                if(dirtyMask == 0){
+                    continue;
+                }
+
+                glViewport(0, 0, slot.map.getSize(), slot.map.getSize());
+                if(dirtyMask == kAllCubeFacesMask){
+                    slot.map.bindLayered();
+                    glClear(GL_DEPTH_BUFFER_BIT);
+                }else{
+                    for(size_t face = 0; face < faceCount; ++face){
+                        if(dirtyMask & (1u << face)){
+                            slot.map.bindFace(GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<int>(face));
+                            glClear(GL_DEPTH_BUFFER_BIT);
+                        }
+                    }
+                    slot.map.bindLayered();
+                }
+
+                float layerMatrices[16 * 6] = {0.0f};
+                for(size_t face = 0; face < faceCount; ++face){
+                    std::memcpy(layerMatrices + face * 16, glm::value_ptr(slot.matrices[face].data), sizeof(float) * 16);
+                }
+                if(s_cubeLayerMatricesLoc != -1){
+                    glUniformMatrix4fv(s_cubeLayerMatricesLoc, static_cast<GLsizei>(faceCount), GL_FALSE, layerMatrices);
+                }
+                g_visibleCasters.clear();
+                for(size_t itemIndex = 0; itemIndex < activeItems.size(); ++itemIndex){
+                    g_casterLayerMasks[itemIndex] &= dirtyMask;
+                    const std::uint8_t layerMask = g_casterLayerMasks[itemIndex];
+                    if(layerMask == 0){
+                        continue;
+                    }
+                    g_visibleCasters.push_back(static_cast<std::uint32_t>(itemIndex));
+                    const std::uint64_t triangles = getShadowCasterTriangles(*activeItems[itemIndex]);
+                    g_shadowPassStats.trianglesCube += triangles;
+                    g_shadowPassStats.layerTrianglesCube += triangles * countLayerBits(layerMask);
+                }
+                g_shadowPassStats.drawCallsCube += drawShadowCasters(
+                    activeItems, g_visibleCasters, g_casterLayerMasks.data(), s_cubeModelLoc, s_cubeLayerMaskLoc
+                );
+                glEnable(GL_CULL_FACE);
+                glCullFace(GL_BACK);
+                if(shouldCheckShadowGlErrors()){
+                    GLenum err = glGetError();
+                    if(err != GL_NO_ERROR){
+                        LogBot.Log(LOG_ERRO, "[Shadow] GL error during layered cube shadow draw slot %d: 0x%X", i, err);
+                    }
+                }
+                continue;
+            }
+
+            for(size_t face = 0; face < slot.matrices.size() && face < slot.faceContentKeys.size(); ++face){
+                cullCasters(slot.matrices[face]);
+
+                const std::uint64_t faceKey = computeCubeFaceContentKey(slot, face, activeItems, g_visibleCasters);
+                if(g_shadowCacheEnabled && slot.faceContentKeys[face] == faceKey){
+                    g_shadowCacheStats.reusedCubeFaces++;
+                    continue;
+                }
+                slot.faceContentKeys[face] = faceKey;
+                g_shadowCacheStats.renderedCubeFaces++;
+
                 slot.map.bindFace(GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<int>(face));
                 glViewport(0, 0, slot.map.getSize(), slot.map.getSize());
                 glClear(GL_DEPTH_BUFFER_BIT);
                 if(s_cubeLightMatrixLoc != -1){
                     glUniformMatrix4fv(s_cubeLightMatrixLoc, 1, GL_FALSE, glm::value_ptr(slot.matrices[face].data));
                 }
-                bool cullStateKnown = false;
-                bool cullEnabled = true;
-                for(const ShadowDrawItem* item : activeItems){
-                    if(!shadowItemIntersectsFrustum(*item, slot.matrices[face])){
-                        continue;
-                    }
-                    if(!cullStateKnown || cullEnabled != item->enableBackfaceCulling){
-                        if(item->enableBackfaceCulling){
-                            glEnable(GL_CULL_FACE);
-                            glCullFace(GL_BACK);
-                            cullEnabled = true;
-                        }else{
-                            glDisable(GL_CULL_FACE);
-                            cullEnabled = false;
-                        }
-                        cullStateKnown = true;
-                    }
-                    if(s_cubeModelLoc != -1){
-                        glUniformMatrix4fv(s_cubeModelLoc, 1, GL_FALSE, glm::value_ptr(item->model.data));
-                    }
-                    item->mesh->draw();
+                for(std::uint32_t itemIndex : g_visibleCasters){
+                    const std::uint64_t triangles = getShadowCasterTriangles(*activeItems[itemIndex]);
+                    g_shadowPassStats.trianglesCube += triangles;
+                    g_shadowPassStats.layerTrianglesCube += triangles;
                 }
+                g_shadowPassStats.drawCallsCube += drawShadowCasters(activeItems, g_visibleCasters, nullptr, s_cubeModelLoc, -1);
                 glEnable(GL_CULL_FACE);
                 glCullFace(GL_BACK);
                 if(shouldCheckShadowGlErrors()){
@@ -1408,10 +2097,10 @@ void ShadowRenderer::BindShadowSamplers(const std::shared_ptr<ShaderProgram>& pr
     const GLuint programId = program->getID();
     const int activeDebugMode = g_debugShadowsOverrideEnabled ? Math3D::Clamp(g_debugShadowsOverrideMode, 1, 3) : 0;
     const int selectedLightIndex = g_debugSelectedLightIndex;
-    const uint64_t selectedBits = static_cast<uint64_t>((selectedLightIndex + 1) & 0x1FF);
+    const uint64_t selectedBits = static_cast<uint64_t>((selectedLightIndex + 1) & 0x1FFF);
     const uint64_t samplerStamp =
-        (g_shadowFrameId << 16) |
-        (static_cast<uint64_t>(activeDebugMode & 0x7F) << 9) |
+        (g_shadowFrameId << 20) |
+        (static_cast<uint64_t>(activeDebugMode & 0x7F) << 13) |
         selectedBits;
     auto stampIt = g_shadowSamplersBoundFrame.find(programId);
     if(stampIt != g_shadowSamplersBoundFrame.end() && stampIt->second == samplerStamp){
@@ -1433,78 +2122,50 @@ void ShadowRenderer::BindShadowSamplers(const std::shared_ptr<ShaderProgram>& pr
         glUniform1f(locReceiverNormalBlend, Math3D::Clamp(g_shadowReceiverNormalBlend, 0.0f, 1.0f));
     }
 
-    GLint loc2D = getSamplerArrayLocation(programId, "u_shadowMaps2D");
+    GLint locAtlas = glGetUniformLocation(programId, "u_shadowAtlas");
     GLint locCube = getSamplerArrayLocation(programId, "u_shadowMapsCube");
-    const int size2D = (loc2D != -1) ? MAX_SHADOW_MAPS_2D : 0;
     const int sizeCube = (locCube != -1) ? MAX_SHADOW_MAPS_CUBE : 0;
 
-    if(size2D == 0 && sizeCube == 0){
+    if(locAtlas == -1 && sizeCube == 0){
         glActiveTexture(GL_TEXTURE0);
         return;
     }
 
     const int shadowUnitCount = getAvailableShadowSamplerUnits();
-    if((size2D > 0 || sizeCube > 0) && shadowUnitCount < 1){
+    if(shadowUnitCount < 1){
         glActiveTexture(GL_TEXTURE0);
         return;
     }
 
     ensureFallbackShadowTextures();
 
-    const int realUnitsStart = SHADOW_TEX_UNIT_BASE_2D;
-    const int realUnitsCount = shadowUnitCount;
-    const int default2DUnit = SHADOW_TEX_UNIT_BASE_2D;
+    // The atlas always takes the first shadow unit; cube maps follow it and any unused
+    // cube entries share the last unit with a fallback cube so sampler types never collide.
+    const int atlasUnit = SHADOW_TEX_UNIT_BASE_2D;
+    const int cubeUnitsStart = SHADOW_TEX_UNIT_BASE_2D + 1;
     const int defaultCubeUnit = SHADOW_TEX_UNIT_BASE_2D + shadowUnitCount - 1;
-
-    int want2D = Math3D::Min(g_active2D, size2D);
-    int wantCube = Math3D::Min(g_activeCube, sizeCube);
-    int real2D = Math3D::Min(want2D, realUnitsCount);
-    int remaining = realUnitsCount - real2D;
-    int realCube = Math3D::Min(wantCube, remaining);
-    if(wantCube > 0 && realCube == 0 && real2D > 0){
-        real2D--;
-        realCube = 1;
-    }
-
-    std::vector<int> units2D(static_cast<size_t>(size2D), default2DUnit);
-    for(int i = 0; i < real2D; ++i){
-        units2D[i] = realUnitsStart + i;
-    }
+    const int realCube = Math3D::Min(Math3D::Min(g_activeCube, sizeCube), shadowUnitCount - 1);
 
     std::vector<int> unitsCube(static_cast<size_t>(sizeCube), defaultCubeUnit);
-    const int cubeUnitsStart = realUnitsStart + real2D;
     for(int i = 0; i < realCube; ++i){
         unitsCube[i] = cubeUnitsStart + i;
     }
 
-    if(loc2D != -1 && size2D > 0){
-        glUniform1iv(loc2D, size2D, units2D.data());
+    if(locAtlas != -1){
+        glUniform1i(locAtlas, atlasUnit);
+        GLuint atlasTex = g_shadowAtlas.getDepthTexture();
+        glActiveTexture(GL_TEXTURE0 + atlasUnit);
+        glBindTexture(GL_TEXTURE_2D, (g_active2D > 0 && atlasTex != 0) ? atlasTex : g_fallbackShadowTex2D);
     }
     if(locCube != -1 && sizeCube > 0){
         glUniform1iv(locCube, sizeCube, unitsCube.data());
     }
 
-    if(size2D > 0 && real2D == 0){
-        glActiveTexture(GL_TEXTURE0 + default2DUnit);
-        glBindTexture(GL_TEXTURE_2D, g_fallbackShadowTex2D);
-    }
-    if(sizeCube > 0 && realCube == 0 && defaultCubeUnit >= (realUnitsStart + real2D)){
+    if(sizeCube > 0 && defaultCubeUnit >= (cubeUnitsStart + realCube)){
         glActiveTexture(GL_TEXTURE0 + defaultCubeUnit);
         glBindTexture(GL_TEXTURE_CUBE_MAP, g_fallbackShadowTexCube);
     }
 
-    for(int i = 0; i < real2D; ++i){
-        GLuint texId = g_fallbackShadowTex2D;
-        if(i < static_cast<int>(g_shadow2D.size())){
-            GLuint mapTex = g_shadow2D[i].map.getDepthTexture();
-            if(mapTex != 0){
-                texId = mapTex;
-            }
-        }
-        glActiveTexture(GL_TEXTURE0 + units2D[i]);
-        glBindTexture(GL_TEXTURE_2D, texId);
-    }
-
     for(int i = 0; i < realCube; ++i){
         GLuint texId = g_fallbackShadowTexCube;
         if(i < static_cast<int>(g_shadowCube.size())){
@@ -1541,11 +2202,11 @@ std::shared_ptr<Texture> ShadowRenderer::GetDepthBuffer() {
         return nullptr;
     }
 
-    const auto& slot = g_shadow2D[0];
-    GLuint id = slot.map.getDepthTexture();
-    int size = slot.map.getSize();
+    // Shows the whole atlas, downsampled so the debug copy stays a reasonable size.
+    GLuint id = g_shadowAtlas.getDepthTexture();
+    int size = Math3D::Min(g_shadowAtlas.getSize(), kShadowDebugMaxSize);
 
-    if(size <= 0){
+    if(size <= 0 || id == 0){
         return nullptr;
     }
 
@@ -1703,6 +2364,39 @@ float ShadowRenderer::GetShadowReceiverNormalBlend() {
     return Math3D::Clamp(g_shadowReceiverNormalBlend, 0.0f, 1.0f);
 }
 
+void ShadowRenderer::SetShadowCacheEnabled(bool enabled) {
+    g_shadowCacheEnabled = enabled;
+}
+
+bool ShadowRenderer::GetShadowCacheEnabled() {
+    return g_shadowCacheEnabled;
+}
+
+void ShadowRenderer::InvalidateShadowCache() {
+    for(auto& slot : g_shadow2D){
+        slot.contentKey = 0;
+    }
+    for(auto& slot : g_shadowCube){
+        slot.faceContentKeys.fill(0);
+    }
+}
+
+ShadowCacheStats ShadowRenderer::GetCacheStats() {
+    return g_shadowCacheStats;
+}
+
+void ShadowRenderer::SetLayeredShadowsEnabled(bool enabled) {
+    g_layeredShadowsEnabled = enabled;
+}
+
+bool ShadowRenderer::GetLayeredShadowsEnabled() {
+    return g_layeredShadowsEnabled;
+}
+
+ShadowPassStats ShadowRenderer::GetPassStats() {
+    return g_shadowPassStats;
+}
+
 void ShadowRenderer::SetDebugLogging(bool enabled) {
     g_debugShadowLogging = enabled;
 }
@@ -22,7 +22,7 @@ class Mesh;
 
 /// @brief Holds data for ShadowLightData.
 struct ShadowLightData {
-    int shadowMapIndex = -1;       // Index into 2D or cube shadow arrays
+    int shadowMapIndex = -1;       // 2D shadow slot or cube shadow array index
     ShadowType shadowType = ShadowType::Standard;
     float shadowStrength = 1.0f;
     float shadowBias = 0.0025f;
@@ -35,6 +35,12 @@ struct ShadowLightData {
         Math3D::Mat4(1.0f),
         Math3D::Mat4(1.0f)
     };
+    Math3D::Vec4 atlasRects[4] = {     // Per cascade atlas tile: xy = UV offset, zw = UV scale
+        Math3D::Vec4(0,0,0,0),
+        Math3D::Vec4(0,0,0,0),
+        Math3D::Vec4(0,0,0,0),
+        Math3D::Vec4(0,0,0,0)
+    };
 };
 
 /// @brief Holds data for ShadowCasterBounds.
@@ -43,14 +49,50 @@ struct ShadowCasterBounds {
     Math3D::Vec3 max;
 };
 
-/// @brief Represents the ShadowRenderer type.
+/// @brief Holds data for ShadowCacheStats. Counts cover the most recent frame's shadow batches.
+struct ShadowCacheStats {
+    int rendered2D = 0;
+    int reused2D = 0;
+    int renderedCubeFaces = 0;
+    int reusedCubeFaces = 0;
+};
+
+/// @brief Holds data for ShadowPassStats. `triangles` counts submitted triangles once per draw; `layerTriangles` counts them once per layer they reach; `stateChanges` counts cull toggles and layer-mask uploads.
+struct ShadowPassStats {
+    int drawCalls2D = 0;
+    std::uint64_t triangles2D = 0;
+    std::uint64_t layerTriangles2D = 0;
+    int drawCallsCube = 0;
+    std::uint64_t trianglesCube = 0;
+    std::uint64_t layerTrianglesCube = 0;
+    int stateChanges = 0;
+};
+
+/**
+ * @brief Represents the ShadowRenderer type.
+ *
+ * Directional cascades and spot maps are tiles of a single depth atlas packed by
+ * ShadowAtlasAllocator; spot tiles are sized by how much of the screen the light covers.
+ * Point lights keep their own cube maps.
+ *
+ * When layered rendering is available, all cascades of a directional light (through a
+ * viewport array) and all faces of a point light (through gl_Layer) are drawn with one
+ * submission per caster; a geometry shader only emits to the layers the caster touches.
+ *
+ * Each 2D tile and cube face remembers a key built from its light matrix, raster bias and
+ * the mesh revision, transform and cull mode of every caster drawn into it. When the key
+ * matches the previous render the map is left untouched, so static lights over static
+ * geometry cost nothing after their first frame.
+ */
 class ShadowRenderer {
 public:
-    /// @brief Holds data for ShadowDrawItem.
+    /// @brief Holds data for ShadowDrawItem; mesh and material are borrowed for the duration of the batch.
     struct ShadowDrawItem {
-        std::shared_ptr<Mesh> mesh;
+        Mesh* mesh = nullptr;
+        /// @brief Dense mesh id used for draw-key sorting; 0 when the caller has none.
+        std::uint32_t meshId = 0;
         Math3D::Mat4 model;
-        std::shared_ptr<Material> material;
+        Material* material = nullptr;
         bool enableBackfaceCulling = true;
         bool hasBounds = false;
         Math3D::Vec3 boundsMin = Math3D::Vec3(0.0f, 0.0f, 0.0f);
@@ -176,6 +218,40 @@ public:
      * @return Computed numeric result.
      */
     static float GetShadowReceiverNormalBlend();
+    /**
+     * @brief Enables or disables reuse of unchanged shadow maps.
+     * @param enabled Flag controlling enabled.
+     */
+    static void SetShadowCacheEnabled(bool enabled);
+    /**
+     * @brief Returns whether unchanged shadow maps are reused.
+     * @return True when caching is enabled.
+     */
+    static bool GetShadowCacheEnabled();
+    /**
+     * @brief Forces every shadow map to re-render on its next batch.
+     */
+    static void InvalidateShadowCache();
+    /**
+     * @brief Returns how many maps were re-rendered or reused this frame.
+     * @return Cache counters.
+     */
+    static ShadowCacheStats GetCacheStats();
+    /**
+     * @brief Enables or disables single-submission rendering of cascades and cube faces.
+     * @param enabled Flag controlling enabled.
+     */
+    static void SetLayeredShadowsEnabled(bool enabled);
+    /**
+     * @brief Returns whether layered shadow rendering is requested.
+     * @return True when layered rendering is enabled; it still falls back per layer without driver support.
+     */
+    static bool GetLayeredShadowsEnabled();
+    /**
+     * @brief Returns draw-call and triangle counts for this frame's shadow passes.
+     * @return Pass counters.
+     */
+    static ShadowPassStats GetPassStats();
     /**
      * @brief Sets the debug logging.
      * @param enabled Flag controlling enabled.
@@ -6,9 +6,11 @@
 #ifndef MATERIAL_H
 #define MATERIAL_H
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 #include "Rendering/Shaders/ShaderProgram.h"
 
@@ -21,6 +23,12 @@ struct IMaterialProperty{
      * @param assumeBound Value for assume bound.
      */
     virtual void apply(ShaderProgram& shader, const std::string& name, bool assumeBound) = 0;
+    /**
+     * @brief Uploads the value to an already resolved location of the bound program.
+     * @param shader Bound shader program.
+     * @param location Uniform location from ShaderProgram::getUniformLocation().
+     */
+    virtual void upload(ShaderProgram& shader, GLint location) = 0;
     /**
      * @brief Destroys this IMaterialProperty instance.
      */
@@ -46,15 +54,61 @@ struct MaterialProperty : public IMaterialProperty{
             shader.setUniform(name,uni);
         }
     }
+
+    void upload(ShaderProgram& shader, GLint location) override{
+        shader.setUniformFast(location, Uniform<T>(this->value));
+    }
 };
 
 /// @brief Represents the Material type.
 class Material{
     private:
         std::shared_ptr<ShaderProgram> programObjPtr;
+        // Permutation of programObjPtr a subclass picked for the current state; bound in its place.
+        std::shared_ptr<ShaderProgram> variantProgramPtr;
         std::unordered_map<std::string, std::shared_ptr<IMaterialProperty>> properties;
         bool castsShadowsFlag = true;
         bool receivesShadowsFlag = true;
+
+        /// @brief Holds data for CompiledProperty: a property resolved against one program.
+        struct CompiledProperty{
+            GLint location = -1;
+            IMaterialProperty* property = nullptr;
+        };
+
+        /// @brief Holds data for CompiledLayout: every property one program declares, with its location.
+        struct CompiledLayout{
+            // Identifies the program the ids were resolved for; a weak_ptr keeps its control block,
+            // so a later program that reuses the GL id never compares equal.
+            std::weak_ptr<ShaderProgram> program;
+            std::uint64_t propertiesRevision = 0;
+            std::vector<CompiledProperty> properties;
+        };
+
+        // Resolved layouts per program id, so switching between variants reuses them. A layout is
+        // rebuilt when a property is added or replaced, or when its id now names another program.
+        std::unordered_map<Shader, CompiledLayout> compiledLayouts;
+        std::uint64_t propertiesRevision = 1;
+
+        const std::vector<CompiledProperty>& compiledPropertiesFor(const std::shared_ptr<ShaderProgram>& program){
+            CompiledLayout& layout = compiledLayouts[program->getID()];
+            const bool sameProgram = !layout.program.owner_before(program) && !program.owner_before(layout.program);
+            if(sameProgram && layout.propertiesRevision == propertiesRevision){
+                return layout.properties;
+            }
+
+            layout.program = program;
+            layout.propertiesRevision = propertiesRevision;
+            layout.properties.clear();
+            layout.properties.reserve(properties.size());
+            for(auto const& [name, prop] : properties){
+                const GLint location = program->getUniformLocation(name);
+                if(location != -1){
+                    layout.properties.push_back(CompiledProperty{location, prop.get()});
+                }
+            }
+            return layout.properties;
+        }
     public:
         /**
          * @brief Constructs a new Material instance.
@@ -88,32 +142,51 @@ class Material{
             }
 
             properties[name] = std::make_shared<MaterialProperty<T>>(value);
+            propertiesRevision++;
             return true;
         }
 
         virtual void bind(){
-            if(!programObjPtr || programObjPtr->getID() == 0){
+            const std::shared_ptr<ShaderProgram>& program = variantProgramPtr ? variantProgramPtr : programObjPtr;
+            if(!program || program->getID() == 0){
                 return;
             }
-            programObjPtr->bind();
+            program->bind();
 
-            for(auto const& [name, prop] : properties){
-                prop->apply(*programObjPtr, name, true);
+            for(const CompiledProperty& compiled : compiledPropertiesFor(program)){
+                compiled.property->upload(*program, compiled.location);
             }
         };
 
+        /**
+         * @brief Picks the program bind() will use for the active pass, without binding or uploading.
+         *
+         * Draw sorting calls this so its keys use the program that actually draws. Plain
+         * materials always draw their assigned shader, so there is nothing to pick.
+         */
+        virtual void selectPassVariant(){}
+
         void unbind(){
-            if(programObjPtr){
-                programObjPtr->unbind();
+            if(std::shared_ptr<ShaderProgram> program = getShader()){
+                program->unbind();
             }
         }
 
+        /**
+         * @brief Returns the program bind() uses: the selected permutation, or the assigned shader.
+         * @return Shared pointer to the program.
+         */
         std::shared_ptr<ShaderProgram> getShader(){
-            return this->programObjPtr;
+            return variantProgramPtr ? variantProgramPtr : programObjPtr;
         }
 
         void setShader(std::shared_ptr<ShaderProgram> program){
+            // Re-assigning what getShader() returned keeps the assignment and its permutations.
+            if(program && program == variantProgramPtr){
+                return;
+            }
             programObjPtr = program;
+            variantProgramPtr.reset();
             if(programObjPtr && programObjPtr->getID() == 0){
                 if(programObjPtr->compile() == 0){
                     LogBot.Log(LOG_ERRO, "Failed to Compile Shader / Shader Program: \n\n%s", programObjPtr->getLog().c_str());
@@ -130,9 +203,26 @@ class Material{
         }
         bool receivesShadows() const { return receivesShadowsFlag; }
 
+    protected:
+        /**
+         * @brief Returns the shader last passed to setShader() or the constructor.
+         * @return Shared pointer to the assigned program.
+         */
+        const std::shared_ptr<ShaderProgram>& getAssignedShader() const { return programObjPtr; }
+
+        /**
+         * @brief Binds `program` in place of the assigned shader until the next setShader().
+         * @param program Compiled permutation of the assigned shader, or null for the shader itself.
+         */
+        void selectVariant(const std::shared_ptr<ShaderProgram>& program){
+            variantProgramPtr = (program == programObjPtr) ? nullptr : program;
+        }
+
+    public:
+
         static std::shared_ptr<Material> Copy(std::shared_ptr<Material> material){
             if(!material) return nullptr;
-            auto n_material = std::make_shared<Material>(material->getShader());
+            auto n_material = std::make_shared<Material>(material->programObjPtr);
             n_material->properties = material->properties;
             return n_material;
         }
@@ -10,6 +10,7 @@
 #include "Rendering/Core/Screen.h"
 #include "Rendering/Lighting/LightUtils.h"
 #include "Rendering/Lighting/ShadowRenderer.h"
+#include "Rendering/Shaders/PassUniforms.h"
 #include "Rendering/Textures/SkyBox.h"
 
 #include <chrono>
@@ -23,6 +24,9 @@ namespace {
     constexpr int ENV_SLOT = 5;
     constexpr int HEIGHT_SLOT = 6;
     constexpr int ROUGHNESS_SLOT = 7;
+    constexpr int SCENE_COLOR_SLOT = 8;
+    constexpr int SCENE_DEPTH_SLOT = 9;
+    constexpr int PLANAR_REFLECTION_SLOT = 10;
     constexpr int LOCAL_PROBE_SLOT = 11;
 
     const std::vector<Light>& GetActiveLights(){
@@ -54,6 +58,52 @@ namespace {
         );
     }
 
+    const char* const kPbrProgramName = "PBRMaterialLit_v3";
+
+    // Indexed by PBRShaderKeyword bit; must match the USE_* switches in Shader_Frag_PBR.frag.
+    const std::vector<std::string>& pbrKeywordNames(){
+        static const std::vector<std::string> NAMES = {
+            "USE_BASE_COLOR_TEX",
+            "USE_ROUGHNESS_TEX",
+            "USE_METALLIC_ROUGHNESS_TEX",
+            "USE_NORMAL_TEX",
+            "USE_HEIGHT_TEX",
+            "USE_EMISSIVE_TEX",
+            "USE_OCCLUSION_TEX",
+            "USE_ENV_MAP",
+            "USE_SCENE_COLOR",
+            "USE_SCENE_DEPTH",
+            "USE_SSR",
+            "USE_PLANAR_REFLECTION",
+            "USE_LOCAL_PROBE"
+        };
+        return NAMES;
+    }
+
+    // The material's own cube map, else the current environment's skybox.
+    std::shared_ptr<CubeMap> resolveEnvMap(const std::shared_ptr<CubeMap>& ownEnvMap){
+        if(ownEnvMap){
+            return ownEnvMap;
+        }
+        if(auto env = Screen::GetCurrentEnvironment()){
+            if(auto skybox = env->getSkyBox()){
+                return skybox->getCubeMap();
+            }
+        }
+        return nullptr;
+    }
+
+    std::uint32_t passKeywordMask(){
+        const PassUniformState& pass = PassUniformUploader::GetActiveState();
+        std::uint32_t mask = 0;
+        if(pass.useSceneColor) mask |= PBRKeyword_SceneColor;
+        if(pass.useSceneDepth) mask |= PBRKeyword_SceneDepth;
+        if(pass.useSsr) mask |= PBRKeyword_Ssr;
+        if(pass.usePlanarReflection) mask |= PBRKeyword_PlanarReflection;
+        if(pass.useLocalProbe) mask |= PBRKeyword_LocalProbe;
+        return mask;
+    }
+
     float getMaterialTimeSeconds(){
         using clock = std::chrono::steady_clock;
         static const clock::time_point START = clock::now();
@@ -70,6 +120,7 @@ PBRMaterial::PBRMaterial(std::shared_ptr<ShaderProgram> program) : Material(prog
     });
 
     BaseColorTex.onChange([this](std::shared_ptr<Texture>, std::shared_ptr<Texture> newValue) -> bool{
+        materialKeywordsDirty = true;
         set<GLUniformUpload::TextureSlot>("u_baseColorTex", GLUniformUpload::TextureSlot(newValue, BASE_COLOR_SLOT));
         set<int>("u_useBaseColorTex", newValue ? 1 : 0);
         return true;
@@ -91,18 +142,21 @@ PBRMaterial::PBRMaterial(std::shared_ptr<ShaderProgram> program) : Material(prog
     });
 
     RoughnessTex.onChange([this](std::shared_ptr<Texture>, std::shared_ptr<Texture> newValue) -> bool{
+        materialKeywordsDirty = true;
         set<GLUniformUpload::TextureSlot>("u_roughnessTex", GLUniformUpload::TextureSlot(newValue, ROUGHNESS_SLOT));
         set<int>("u_useRoughnessTex", newValue ? 1 : 0);
         return true;
     });
 
     MetallicRoughnessTex.onChange([this](std::shared_ptr<Texture>, std::shared_ptr<Texture> newValue) -> bool{
+        materialKeywordsDirty = true;
         set<GLUniformUpload::TextureSlot>("u_metallicRoughnessTex", GLUniformUpload::TextureSlot(newValue, METAL_ROUGH_SLOT));
         set<int>("u_useMetallicRoughnessTex", newValue ? 1 : 0);
         return true;
     });
 
     NormalTex.onChange([this](std::shared_ptr<Texture>, std::shared_ptr<Texture> newValue) -> bool{
+        materialKeywordsDirty = true;
         set<GLUniformUpload::TextureSlot>("u_normalTex", GLUniformUpload::TextureSlot(newValue, NORMAL_SLOT));
         set<int>("u_useNormalTex", newValue ? 1 : 0);
         return true;
@@ -114,6 +168,7 @@ PBRMaterial::PBRMaterial(std::shared_ptr<ShaderProgram> program) : Material(prog
     });
 
     HeightTex.onChange([this](std::shared_ptr<Texture>, std::shared_ptr<Texture> newValue) -> bool{
+        materialKeywordsDirty = true;
         set<GLUniformUpload::TextureSlot>("u_heightTex", GLUniformUpload::TextureSlot(newValue, HEIGHT_SLOT));
         set<int>("u_useHeightTex", newValue ? 1 : 0);
         return true;
@@ -125,6 +180,7 @@ PBRMaterial::PBRMaterial(std::shared_ptr<ShaderProgram> program) : Material(prog
     });
 
     EmissiveTex.onChange([this](std::shared_ptr<Texture>, std::shared_ptr<Texture> newValue) -> bool{
+        materialKeywordsDirty = true;
         set<GLUniformUpload::TextureSlot>("u_emissiveTex", GLUniformUpload::TextureSlot(newValue, EMISSIVE_SLOT));
         set<int>("u_useEmissiveTex", newValue ? 1 : 0);
         return true;
@@ -141,6 +197,7 @@ PBRMaterial::PBRMaterial(std::shared_ptr<ShaderProgram> program) : Material(prog
     });
 
     OcclusionTex.onChange([this](std::shared_ptr<Texture>, std::shared_ptr<Texture> newValue) -> bool{
+        materialKeywordsDirty = true;
         set<GLUniformUpload::TextureSlot>("u_occlusionTex", GLUniformUpload::TextureSlot(newValue, OCCLUSION_SLOT));
         set<int>("u_useOcclusionTex", newValue ? 1 : 0);
         return true;
@@ -346,31 +403,12 @@ PBRMaterial::PBRMaterial(std::shared_ptr<ShaderProgram> program) : Material(prog
     set<float>("u_waveTextureInfluence", 0.6f);
     set<Math3D::Vec2>("u_waveTextureSpeed", Math3D::Vec2(0.03f, 0.01f));
     set<float>("u_time", 0.0f);
-    set<GLUniformUpload::TextureSlot>("u_ssrColor", GLUniformUpload::TextureSlot(nullptr, 8));
-    set<int>("u_useSceneColor", 0);
-    set<GLUniformUpload::TextureSlot>("u_sceneDepth", GLUniformUpload::TextureSlot(nullptr, 9));
-    set<int>("u_useSceneDepth", 0);
-    set<int>("u_useSsr", 0);
-    set<float>("u_ssrIntensity", 0.0f);
-    set<float>("u_ssrMaxDistance", 80.0f);
-    set<float>("u_ssrThickness", 0.18f);
-    set<float>("u_ssrStride", 0.75f);
-    set<float>("u_ssrJitter", 0.35f);
-    set<int>("u_ssrMaxSteps", 56);
-    set<float>("u_ssrRoughnessCutoff", 0.82f);
-    set<float>("u_ssrEdgeFade", 0.18f);
-    set<Math3D::Mat4>("u_invProjection", Math3D::Mat4());
-    set<GLUniformUpload::TextureSlot>("u_planarReflectionTex", GLUniformUpload::TextureSlot(nullptr, 8));
-    set<int>("u_usePlanarReflection", 0);
-    set<Math3D::Mat4>("u_planarReflectionMatrix", Math3D::Mat4());
-    set<float>("u_planarReflectionStrength", 1.0f);
+    // Reflection and SSR parameters live in the shared PassBlock (PassUniformUploader);
+    // only their samplers stay per material.
+    set<GLUniformUpload::TextureSlot>("u_ssrColor", GLUniformUpload::TextureSlot(nullptr, SCENE_COLOR_SLOT));
+    set<GLUniformUpload::TextureSlot>("u_sceneDepth", GLUniformUpload::TextureSlot(nullptr, SCENE_DEPTH_SLOT));
+    set<GLUniformUpload::TextureSlot>("u_planarReflectionTex", GLUniformUpload::TextureSlot(nullptr, PLANAR_REFLECTION_SLOT));
     set<GLUniformUpload::CubeMapSlot>("u_localProbe", GLUniformUpload::CubeMapSlot(nullptr, LOCAL_PROBE_SLOT));
-    set<int>("u_useLocalProbe", 0);
-    set<Math3D::Vec3>("u_localProbeCenter", Math3D::Vec3(0.0f, 0.0f, 0.0f));
-    set<Math3D::Vec3>("u_localProbeCaptureMin", Math3D::Vec3(0.0f, 0.0f, 0.0f));
-    set<Math3D::Vec3>("u_localProbeCaptureMax", Math3D::Vec3(0.0f, 0.0f, 0.0f));
-    set<Math3D::Vec3>("u_localProbeInfluenceMin", Math3D::Vec3(0.0f, 0.0f, 0.0f));
-    set<Math3D::Vec3>("u_localProbeInfluenceMax", Math3D::Vec3(0.0f, 0.0f, 0.0f));
     set<int>("u_useBaseColorTex", 0);
     set<int>("u_useRoughnessTex", 0);
     set<int>("u_useMetallicRoughnessTex", 0);
@@ -381,6 +419,40 @@ PBRMaterial::PBRMaterial(std::shared_ptr<ShaderProgram> program) : Material(prog
     set<int>("u_useEnvMap", 0);
 }
 
+std::uint32_t PBRMaterial::computeMaterialKeywordMask(){
+    std::uint32_t mask = 0;
+    if(BaseColorTex.get()) mask |= PBRKeyword_BaseColorTex;
+    if(RoughnessTex.get()) mask |= PBRKeyword_RoughnessTex;
+    if(MetallicRoughnessTex.get()) mask |= PBRKeyword_MetallicRoughnessTex;
+    if(NormalTex.get()) mask |= PBRKeyword_NormalTex;
+    if(HeightTex.get()) mask |= PBRKeyword_HeightTex;
+    if(EmissiveTex.get()) mask |= PBRKeyword_EmissiveTex;
+    if(OcclusionTex.get()) mask |= PBRKeyword_OcclusionTex;
+    return mask;
+}
+
+void PBRMaterial::updateVariantSelection(bool useBoundEnvMap){
+    // Only the stock program is permuted; a shader assigned from elsewhere is bound as is.
+    if(!variantSet || getAssignedShader() != variantSet->getBaseProgram()){
+        return;
+    }
+    if(materialKeywordsDirty){
+        materialKeywordMask = computeMaterialKeywordMask();
+        materialKeywordsDirty = false;
+    }
+    const std::uint32_t mask = materialKeywordMask | (useBoundEnvMap ? PBRKeyword_EnvMap : 0u) | passKeywordMask();
+    // A setShader() since the last selection dropped it, so re-apply it.
+    if(!selectedVariant || mask != selectedKeywordMask || getShader() != selectedVariant){
+        selectedVariant = variantSet->getVariant(mask);
+        selectedKeywordMask = mask;
+        selectVariant(selectedVariant);
+    }
+}
+
+void PBRMaterial::selectPassVariant(){
+    updateVariantSelection(UseEnvMap.get() != 0 && resolveEnvMap(EnvMap.get()));
+}
+
 void PBRMaterial::bind(){
     if(Screen::GetCurrentCamera()){
         ViewPos = Screen::GetCurrentCamera()->transform().position;
@@ -389,15 +461,7 @@ void PBRMaterial::bind(){
     }
     set<float>("u_time", getMaterialTimeSeconds());
 
-    std::shared_ptr<CubeMap> activeEnvMap = EnvMap.get();
-    if(!activeEnvMap){
-        if(auto env = Screen::GetCurrentEnvironment()){
-            if(auto skybox = env->getSkyBox()){
-                activeEnvMap = skybox->getCubeMap();
-            }
-        }
-    }
-
+    std::shared_ptr<CubeMap> activeEnvMap = resolveEnvMap(EnvMap.get());
     const int useBoundEnvMap = (UseEnvMap.get() != 0 && activeEnvMap) ? 1 : 0;
     set<GLUniformUpload::CubeMapSlot>(
         "u_envMap",
@@ -405,18 +469,38 @@ void PBRMaterial::bind(){
     );
     set<int>("u_useEnvMap", useBoundEnvMap);
 
+    updateVariantSelection(useBoundEnvMap != 0);
+
     Material::bind();
+    PassUniformUploader::BindProgram(this->getShader());
     LightUniformUploader::UploadLights(this->getShader(), GetActiveLights());
     ShadowRenderer::BindShadowSamplers(this->getShader());
 }
 
+std::shared_ptr<ShaderVariantSet> PBRMaterial::GetVariantSet(){
+    static std::shared_ptr<ShaderVariantSet> SET;
+    if(!SET){
+        auto vertexShader = AssetManager::Instance.getOrLoad("@assets/shader/Shader_Vert_Lit.vert");
+        auto fragmentShader = AssetManager::Instance.getOrLoad("@assets/shader/Shader_Frag_PBR.frag");
+        if(!vertexShader || !fragmentShader){
+            LogBot.Log(LOG_ERRO, "[PBRMaterial] Missing shader asset(s) for '%s'.", kPbrProgramName);
+            return nullptr;
+        }
+        SET = std::make_shared<ShaderVariantSet>(
+            kPbrProgramName,
+            vertexShader->asString(),
+            fragmentShader->asString(),
+            pbrKeywordNames()
+        );
+    }
+    return SET;
+}
+
 std::shared_ptr<PBRMaterial> PBRMaterial::Create(Math3D::Vec4 baseColor){
-    auto program = compileShaderProgramSafe(
-        "PBRMaterialLit_v3",
-        "@assets/shader/Shader_Vert_Lit.vert",
-        "@assets/shader/Shader_Frag_PBR.frag"
-    );
+    std::shared_ptr<ShaderVariantSet> variants = GetVariantSet();
+    auto program = variants ? variants->getBaseProgram() : nullptr;
     if(!program || program->getID() == 0){
+        variants.reset();
         if(program){
             LogBot.Log(LOG_ERRO, "Failed to link PBRMaterialLit: \n%s", program->getLog().c_str());
         }
@@ -439,6 +523,7 @@ std::shared_ptr<PBRMaterial> PBRMaterial::Create(Math3D::Vec4 baseColor){
     }
 
     auto material = std::make_shared<PBRMaterial>(program);
+    material->variantSet = variants;
     material->BaseColor = baseColor;
     material->BsdfModel = static_cast<int>(PBRBsdfModel::Standard);
     material->Transmission = Math3D::Clamp(1.0f - baseColor.w, 0.0f, 1.0f);
@@ -6,9 +6,11 @@
 #ifndef PBR_MATERIAL_H
 #define PBR_MATERIAL_H
 
+#include <cstdint>
 #include <memory>
 
 #include "Rendering/Materials/Material.h"
+#include "Rendering/Shaders/ShaderVariants.h"
 #include "Rendering/Textures/Texture.h"
 #include "Rendering/Textures/CubeMap.h"
 #include "Foundation/Util/ValueContainer.h"
@@ -21,8 +23,38 @@ enum class PBRBsdfModel {
     Water = 2
 };
 
+/// @brief Enumerates the Shader_Frag_PBR.frag permutation keywords, as mask bits.
+enum PBRShaderKeyword : std::uint32_t {
+    PBRKeyword_BaseColorTex         = 1u << 0,
+    PBRKeyword_RoughnessTex         = 1u << 1,
+    PBRKeyword_MetallicRoughnessTex = 1u << 2,
+    PBRKeyword_NormalTex            = 1u << 3,
+    PBRKeyword_HeightTex            = 1u << 4,
+    PBRKeyword_EmissiveTex          = 1u << 5,
+    PBRKeyword_OcclusionTex         = 1u << 6,
+    PBRKeyword_EnvMap               = 1u << 7,
+    // Pass-level features, taken from the PassBlock state the scene uploaded.
+    PBRKeyword_SceneColor           = 1u << 8,
+    PBRKeyword_SceneDepth           = 1u << 9,
+    PBRKeyword_Ssr                  = 1u << 10,
+    PBRKeyword_PlanarReflection     = 1u << 11,
+    PBRKeyword_LocalProbe           = 1u << 12
+};
+
 /// @brief Represents the PBRMaterial type.
 class PBRMaterial : public Material {
+    private:
+        std::shared_ptr<ShaderVariantSet> variantSet;
+        // Last permutation handed to selectVariant(), looked up again only when its mask changes.
+        std::shared_ptr<ShaderProgram> selectedVariant;
+        std::uint32_t selectedKeywordMask = 0;
+        // Texture keywords, recomputed only after a texture slot changes.
+        std::uint32_t materialKeywordMask = 0;
+        bool materialKeywordsDirty = true;
+
+        std::uint32_t computeMaterialKeywordMask();
+        void updateVariantSelection(bool useBoundEnvMap);
+
     public:
         ValueContainer<Math3D::Vec4> BaseColor;
         ValueContainer<std::shared_ptr<Texture>> BaseColorTex;
@@ -71,8 +103,16 @@ class PBRMaterial : public Material {
         PBRMaterial(std::shared_ptr<ShaderProgram> program);
         /**
          * @brief Binds this resource.
+         *
+         * While the material uses the stock PBR program, this binds the permutation matching its
+         * textures, environment map and the active pass features in place of it. getShader()
+         * returns that permutation afterwards. A shader assigned from elsewhere is left untouched.
          */
         void bind() override;
+        /**
+         * @brief Selects the permutation bind() would use for the active pass, without uploading.
+         */
+        void selectPassVariant() override;
 
         /**
          * @brief Creates a new object.
@@ -92,6 +132,12 @@ class PBRMaterial : public Material {
          * @return Pointer to the resulting object.
          */
         static std::shared_ptr<PBRMaterial> CreateWater(Math3D::Vec4 baseColor = Math3D::Vec4(0.10f, 0.34f, 0.52f, 0.22f));
+
+        /**
+         * @brief Returns the shared Shader_Frag_PBR.frag permutation set.
+         * @return Pointer to the set, or null when the shader assets are missing.
+         */
+        static std::shared_ptr<ShaderVariantSet> GetVariantSet();
 };
 
 #endif // PBR_MATERIAL_H
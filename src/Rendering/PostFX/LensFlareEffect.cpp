@@ -159,10 +159,7 @@ LensFlareEffect::LensFlareEffect(){
 }
 
 LensFlareEffect::~LensFlareEffect(){
-    if(depthReadFbo != 0){
-        glDeleteFramebuffers(1, &depthReadFbo);
-        depthReadFbo = 0;
-    }
+    depthReadback.dispose();
 }
 
 void LensFlareEffect::setEmitters(const std::vector<FlareEmitter>& newEmitters){
@@ -192,41 +189,6 @@ bool LensFlareEffect::ensureShadersCompiled(){
     return compositeShader->getID() != 0 && spriteShader->getID() != 0;
 }
 
-bool LensFlareEffect::beginDepthRead(PTexture depthTex){
-    depthReadPrepared = false;
-    depthReadPrevFbo = 0;
-    if(!depthTex || depthTex->getID() == 0 || depthTex->getWidth() <= 0 || depthTex->getHeight() <= 0){
-        return false;
-    }
-    if(depthReadFbo == 0){
-        glGenFramebuffers(1, &depthReadFbo);
-    }
-    if(depthReadFbo == 0){
-        return false;
-    }
-
-    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &depthReadPrevFbo);
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, depthReadFbo);
-    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTex->getID(), 0);
-    glReadBuffer(GL_NONE);
-    if(glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE){
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(depthReadPrevFbo));
-        depthReadPrevFbo = 0;
-        return false;
-    }
-
-    depthReadPrepared = true;
-    return true;
-}
-
-void LensFlareEffect::endDepthRead(){
-    if(depthReadPrepared){
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(depthReadPrevFbo));
-    }
-    depthReadPrepared = false;
-    depthReadPrevFbo = 0;
-}
-
 LensFlareEffect::CachedFlareAsset* LensFlareEffect::resolveAsset(const std::string& assetRef){
     if(assetRef.empty()){
         return nullptr;
@@ -285,33 +247,17 @@ PTexture LensFlareEffect::resolveTexture(CachedFlareAsset& asset, const std::str
     return texture;
 }
 
-float LensFlareEffect::sampleDepthAtUv(PTexture depthTex, const Math3D::Vec2& uv){
-    if(!depthTex || depthTex->getID() == 0 || depthTex->getWidth() <= 0 || depthTex->getHeight() <= 0){
-        return 1.0f;
-    }
-
-    const int width = depthTex->getWidth();
-    const int height = depthTex->getHeight();
-    const int x = Math3D::Clamp(static_cast<int>(std::round(uv.x * static_cast<float>(width - 1))), 0, width - 1);
-    const int y = Math3D::Clamp(static_cast<int>(std::round(uv.y * static_cast<float>(height - 1))), 0, height - 1);
-
-    float sampledDepth = 1.0f;
-    if(depthReadPrepared){
-        glReadPixels(x, y, 1, 1, GL_DEPTH_COMPONENT, GL_FLOAT, &sampledDepth);
-        return sampledDepth;
-    }
-
-    if(!beginDepthRead(depthTex)){
+float LensFlareEffect::laggedDepthForEmitter(size_t emitterIndex) const{
+    // Results from a different emitter count cannot be matched up; treat the source as unoccluded.
+    if(laggedDepths.size() != emitters.size() || emitterIndex >= laggedDepths.size()){
         return 1.0f;
     }
-    if(depthReadPrepared){
-        glReadPixels(x, y, 1, 1, GL_DEPTH_COMPONENT, GL_FLOAT, &sampledDepth);
-    }
-    endDepthRead();
-    return sampledDepth;
+    const float depth = laggedDepths[emitterIndex];
+    return std::isfinite(depth) ? depth : 1.0f;
 }
 
 bool LensFlareEffect::buildProjectedEmitterSource(const FlareEmitter& emitter,
+                                                  size_t emitterIndex,
                                                   PTexture depthTex,
                                                   ProjectedEmitterSource& outSource){
     PCamera camera = Screen::GetCurrentCamera();
@@ -348,7 +294,14 @@ bool LensFlareEffect::buildProjectedEmitterSource(const FlareEmitter& emitter,
         (ndc.y * 0.5f) + 0.5f
     );
     const float sourceDepth = (ndc.z * 0.5f) + 0.5f;
-    const float sceneDepth = sampleDepthAtUv(depthTex, uv);
+    float sceneDepth = 1.0f;
+    if(depthTex && depthTex->getWidth() > 0 && depthTex->getHeight() > 0 && emitterIndex < depthTaps.size()){
+        const int width = depthTex->getWidth();
+        const int height = depthTex->getHeight();
+        depthTaps[emitterIndex].x = Math3D::Clamp(static_cast<int>(std::round(uv.x * static_cast<float>(width - 1))), 0, width - 1);
+        depthTaps[emitterIndex].y = Math3D::Clamp(static_cast<int>(std::round(uv.y * static_cast<float>(height - 1))), 0, height - 1);
+        sceneDepth = laggedDepthForEmitter(emitterIndex);
+    }
 
     float visibility = 1.0f;
     if(emitter.type == LightType::DIRECTIONAL){
@@ -445,9 +398,11 @@ bool LensFlareEffect::apply(PTexture inputTex,
     float glareThresholdAccumulator = 0.0f;
     float glareFalloffAccumulator = 0.0f;
     int glareCount = 0;
-    beginDepthRead(depthTex);
+    depthReadback.poll(laggedDepths);
+    depthTaps.assign(emitters.size(), GpuReadback::Tap{});
 
-    for(const FlareEmitter& emitter : emitters){
+    for(size_t emitterIndex = 0; emitterIndex < emitters.size(); ++emitterIndex){
+        const FlareEmitter& emitter = emitters[emitterIndex];
         CachedFlareAsset* asset = resolveAsset(emitter.assetRef);
         if(!asset || !asset->valid){
             continue;
@@ -455,7 +410,7 @@ bool LensFlareEffect::apply(PTexture inputTex,
         hasAnyValidAsset = true;
 
         ProjectedEmitterSource emitterSource;
-        if(buildProjectedEmitterSource(emitter, depthTex, emitterSource)){
+        if(buildProjectedEmitterSource(emitter, emitterIndex, depthTex, emitterSource)){
             glare.enabled = true;
             const float glareVisibilityScale = Math3D::Clamp(
                 emitterSource.visibility * (0.50f + (emitterSource.brightnessScale * 0.35f)),
@@ -473,7 +428,7 @@ bool LensFlareEffect::apply(PTexture inputTex,
             appendSpriteSources(emitter, *asset, emitterSource, spriteSources);
         }
     }
-    endDepthRead();
+    depthReadback.submit(depthTex, GpuReadback::Format::Depth, depthTaps);
 
     if(!hasAnyValidAsset){
         return false;
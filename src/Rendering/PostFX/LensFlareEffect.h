@@ -16,6 +16,7 @@
 
 #include "Assets/Descriptors/LensFlareAsset.h"
 #include "Foundation/Math/Math3D.h"
+#include "Rendering/Core/GpuReadback.h"
 #include "Rendering/Core/Graphics.h"
 #include "Rendering/Lighting/Light.h"
 #include "Rendering/Shaders/ShaderProgram.h"
@@ -97,17 +98,18 @@ class LensFlareEffect : public Graphics::PostProcessing::PostProcessingEffect {
         std::shared_ptr<ShaderProgram> spriteShader;
         bool compositeCompileAttempted = false;
         bool spriteCompileAttempted = false;
-        GLuint depthReadFbo = 0;
-        GLint depthReadPrevFbo = 0;
-        bool depthReadPrepared = false;
+        // One depth tap per emitter, read back asynchronously; occlusion uses the newest
+        // finished read, so it trails the camera by a frame or two.
+        GpuReadback depthReadback;
+        std::vector<GpuReadback::Tap> depthTaps;
+        std::vector<float> laggedDepths;
 
         bool ensureShadersCompiled();
-        bool beginDepthRead(PTexture depthTex);
-        void endDepthRead();
         CachedFlareAsset* resolveAsset(const std::string& assetRef);
         PTexture resolveTexture(CachedFlareAsset& asset, const std::string& textureRef);
-        float sampleDepthAtUv(PTexture depthTex, const Math3D::Vec2& uv);
+        float laggedDepthForEmitter(size_t emitterIndex) const;
         bool buildProjectedEmitterSource(const FlareEmitter& emitter,
+                                         size_t emitterIndex,
                                          PTexture depthTex,
                                          ProjectedEmitterSource& outSource);
         void appendSpriteSources(const FlareEmitter& emitter,
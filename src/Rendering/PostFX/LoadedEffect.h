@@ -75,6 +75,7 @@ class LoadedEffect : public Graphics::PostProcessing::PostProcessingEffect {
             }
             shader->setVertexShader(vertexCode);
             shader->setFragmentShader(fragmentCode);
+            // compile() loads the linked binary from ProgramBinaryCache when one matches these sources.
             if(shader->compile() == 0){
                 LogBot.Log(LOG_ERRO,
                            "Failed to compile loaded effect shader '%s':\n%s",
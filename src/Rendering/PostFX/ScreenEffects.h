@@ -7,6 +7,7 @@
 #define SCREENEFFECTS_H
 
 #include "Rendering/Core/Graphics.h"
+#include "Rendering/Core/GpuReadback.h"
 #include "Rendering/Shaders/ShaderProgram.h"
 #include "Foundation/Math/Color.h"
 #include "Foundation/Logging/Logbot.h"
@@ -1136,7 +1137,9 @@ class DepthOfFieldEffect : public Graphics::PostProcessing::PostProcessingEffect
     private:
         std::shared_ptr<ShaderProgram> shader;
         bool compileAttempted = false;
-        GLuint adaptiveDepthReadFbo = 0;
+        GpuReadback adaptiveDepthReadback;
+        std::vector<GpuReadback::Tap> adaptiveDepthTaps;
+        std::vector<float> adaptiveDepthSamples;
         float resolvedFocusDistance = 8.0f;
         float resolvedFocusRange = 4.0f;
         bool focusAdaptationInitialized = false;
@@ -1366,35 +1369,6 @@ class DepthOfFieldEffect : public Graphics::PostProcessing::PostProcessingEffect
             if(width <= 0 || height <= 0){
                 return false;
             }
-            if(adaptiveDepthReadFbo == 0){
-                glGenFramebuffers(1, &adaptiveDepthReadFbo);
-            }
-            if(adaptiveDepthReadFbo == 0){
-                return false;
-            }
-
-            GLint prevReadFbo = 0;
-            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, adaptiveDepthReadFbo);
-            glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTex->getID(), 0);
-            glReadBuffer(GL_NONE);
-            const bool complete = (glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
-            if(!complete){
-                glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevReadFbo));
-                return false;
-            }
-
-            const float kSkyDepthCutoff = 0.9995f;
-            auto readDepthAt = [&](int x, int y, float& outDepth) -> bool {
-                float depth = 1.0f;
-                glReadPixels(x, y, 1, 1, GL_DEPTH_COMPONENT, GL_FLOAT, &depth);
-                if(!std::isfinite(depth) || depth >= kSkyDepthCutoff){
-                    return false;
-                }
-                outDepth = depth;
-                return true;
-            };
-
             const int centerX = Math3D::Clamp(
                 static_cast<int>(std::round(focusUv.x * static_cast<float>(width - 1))),
                 0,
@@ -1406,23 +1380,38 @@ class DepthOfFieldEffect : public Graphics::PostProcessing::PostProcessingEffect
                 height - 1
             );
 
-            float resolvedDepth = 1.0f;
-            bool gotDepth = readDepthAt(centerX, centerY, resolvedDepth);
+            // Queue this frame's taps (center first, then the fallback ring) and use the newest
+            // finished read; focus trails the image by a frame or two instead of stalling.
+            static const int OFFSETS[8][2] = {
+                { 1,  0}, {-1,  0},
+                { 0,  1}, { 0, -1},
+                { 2,  0}, {-2,  0},
+                { 0,  2}, { 0, -2}
+            };
+            adaptiveDepthTaps.clear();
+            adaptiveDepthTaps.push_back(GpuReadback::Tap{centerX, centerY});
+            for(const auto& offset : OFFSETS){
+                adaptiveDepthTaps.push_back(GpuReadback::Tap{centerX + offset[0], centerY + offset[1]});
+            }
+            adaptiveDepthReadback.poll(adaptiveDepthSamples);
+            adaptiveDepthReadback.submit(depthTex, GpuReadback::Format::Depth, adaptiveDepthTaps);
+            if(adaptiveDepthSamples.size() != adaptiveDepthTaps.size()){
+                return false;
+            }
+
+            const float kSkyDepthCutoff = 0.9995f;
+            auto usableDepth = [&](float depth) -> bool {
+                return std::isfinite(depth) && depth < kSkyDepthCutoff;
+            };
+
+            float resolvedDepth = adaptiveDepthSamples[0];
+            bool gotDepth = usableDepth(resolvedDepth);
             if(!gotDepth){
-                static const int OFFSETS[8][2] = {
-                    { 1,  0}, {-1,  0},
-                    { 0,  1}, { 0, -1},
-                    { 2,  0}, {-2,  0},
-                    { 0,  2}, { 0, -2}
-                };
                 float accum = 0.0f;
                 int count = 0;
-                for(const auto& offset : OFFSETS){
-                    const int sx = Math3D::Clamp(centerX + offset[0], 0, width - 1);
-                    const int sy = Math3D::Clamp(centerY + offset[1], 0, height - 1);
-                    float sampleDepth = 1.0f;
-                    if(readDepthAt(sx, sy, sampleDepth)){
-                        accum += sampleDepth;
+                for(size_t i = 1; i < adaptiveDepthSamples.size(); ++i){
+                    if(usableDepth(adaptiveDepthSamples[i])){
+                        accum += adaptiveDepthSamples[i];
                         count++;
                     }
                 }
@@ -1432,7 +1421,6 @@ class DepthOfFieldEffect : public Graphics::PostProcessing::PostProcessingEffect
                 }
             }
 
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevReadFbo));
             if(!gotDepth){
                 return false;
             }
@@ -1471,12 +1459,7 @@ class DepthOfFieldEffect : public Graphics::PostProcessing::PostProcessingEffect
         /**
          * @brief Destroys this DepthOfFieldEffect instance.
          */
-        ~DepthOfFieldEffect() override {
-            if(adaptiveDepthReadFbo != 0){
-                glDeleteFramebuffers(1, &adaptiveDepthReadFbo);
-                adaptiveDepthReadFbo = 0;
-            }
-        }
+        ~DepthOfFieldEffect() override = default;
 
         /**
          * @brief Returns the resolved focus distance.
@@ -1790,7 +1773,9 @@ class BloomEffect : public Graphics::PostProcessing::PostProcessingEffect {
                 FragColor = vec4(max(color, vec3(0.0)), 1.0);
             }
         )";
-        GLuint adaptationReadFbo = 0;
+        GpuReadback adaptationReadback;
+        std::vector<GpuReadback::Tap> adaptationTaps;
+        std::vector<float> adaptationSamples;
         bool adaptationInitialized = false;
         float adaptedLuminance = 0.35f;
         float filteredLuminance = 0.35f;
@@ -1810,42 +1795,34 @@ class BloomEffect : public Graphics::PostProcessing::PostProcessingEffect {
             if(!tex || tex->getID() == 0 || tex->getWidth() <= 0 || tex->getHeight() <= 0){
                 return false;
             }
-            if(adaptationReadFbo == 0){
-                glGenFramebuffers(1, &adaptationReadFbo);
-            }
-            if(adaptationReadFbo == 0){
-                return false;
-            }
-
-            GLint prevReadFbo = 0;
-            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, adaptationReadFbo);
-            glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex->getID(), 0);
-            if(glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE){
-                glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevReadFbo));
+            const int width = tex->getWidth();
+            const int height = tex->getHeight();
+            adaptationTaps.clear();
+            adaptationTaps.push_back(GpuReadback::Tap{width / 2, height / 2});
+            adaptationTaps.push_back(GpuReadback::Tap{width / 4, height / 4});
+            adaptationTaps.push_back(GpuReadback::Tap{(width * 3) / 4, height / 4});
+            adaptationTaps.push_back(GpuReadback::Tap{width / 4, (height * 3) / 4});
+            adaptationTaps.push_back(GpuReadback::Tap{(width * 3) / 4, (height * 3) / 4});
+
+            // Meter from the newest finished read; this frame's taps land a frame or two later.
+            const bool hasNewSamples = adaptationReadback.poll(adaptationSamples);
+            adaptationReadback.submit(tex, GpuReadback::Format::Color, adaptationTaps);
+            if(!hasNewSamples || adaptationSamples.size() != adaptationTaps.size() * 4){
                 return false;
             }
 
-            glReadBuffer(GL_COLOR_ATTACHMENT0);
-            auto readLumaAt = [](int x, int y) -> float {
-                float pixel[4] = {0.0f, 0.0f, 0.0f, 1.0f};
-                glReadPixels(x, y, 1, 1, GL_RGBA, GL_FLOAT, pixel);
+            auto lumaAt = [&](size_t tap) -> float {
+                const float* pixel = adaptationSamples.data() + (tap * 4);
                 return (pixel[0] * 0.2126f) + (pixel[1] * 0.7152f) + (pixel[2] * 0.0722f);
             };
 
-            const int width = tex->getWidth();
-            const int height = tex->getHeight();
-            const int centerX = width / 2;
-            const int centerY = height / 2;
-
             float luma = 0.0f;
-            luma += readLumaAt(centerX, centerY) * 0.50f;
-            luma += readLumaAt(width / 4, height / 4) * 0.125f;
-            luma += readLumaAt((width * 3) / 4, height / 4) * 0.125f;
-            luma += readLumaAt(width / 4, (height * 3) / 4) * 0.125f;
-            luma += readLumaAt((width * 3) / 4, (height * 3) / 4) * 0.125f;
+            luma += lumaAt(0) * 0.50f;
+            luma += lumaAt(1) * 0.125f;
+            luma += lumaAt(2) * 0.125f;
+            luma += lumaAt(3) * 0.125f;
+            luma += lumaAt(4) * 0.125f;
 
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevReadFbo));
             if(!std::isfinite(luma)){
                 return false;
             }
@@ -1985,12 +1962,7 @@ class BloomEffect : public Graphics::PostProcessing::PostProcessingEffect {
         /**
          * @brief Destroys this BloomEffect instance.
          */
-        ~BloomEffect() override {
-            if(adaptationReadFbo != 0){
-                glDeleteFramebuffers(1, &adaptationReadFbo);
-                adaptationReadFbo = 0;
-            }
-        }
+        ~BloomEffect() override = default;
 
         /**
          * @brief Applies current settings.
@@ -2079,7 +2051,9 @@ class AutoExposureEffect : public Graphics::PostProcessing::PostProcessingEffect
         static constexpr int METER_INTERVAL_FRAMES = 6;
         std::shared_ptr<ShaderProgram> shader;
         bool compileAttempted = false;
-        GLuint meteringReadFbo = 0;
+        GpuReadback meteringReadback;
+        std::vector<GpuReadback::Tap> meteringTaps;
+        std::vector<float> meteringSamples;
         bool adaptationInitialized = false;
         float adaptedExposure = 1.0f;
         float filteredLogLuminance = std::log2(0.18f);
@@ -2127,24 +2101,6 @@ class AutoExposureEffect : public Graphics::PostProcessing::PostProcessingEffect
             if(!tex || tex->getID() == 0 || tex->getWidth() <= 0 || tex->getHeight() <= 0){
                 return false;
             }
-            if(meteringReadFbo == 0){
-                glGenFramebuffers(1, &meteringReadFbo);
-            }
-            if(meteringReadFbo == 0){
-                return false;
-            }
-
-            GLint prevReadFbo = 0;
-            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, meteringReadFbo);
-            glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex->getID(), 0);
-            if(glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE){
-                glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevReadFbo));
-                return false;
-            }
-
-            glReadBuffer(GL_COLOR_ATTACHMENT0);
-
             /// @brief Holds data for MeterTap.
             struct MeterTap {
                 float u;
@@ -2164,26 +2120,35 @@ class AutoExposureEffect : public Graphics::PostProcessing::PostProcessingEffect
                 {0.88f, 0.88f, 0.035f}
             }};
 
-            std::array<float, kMeterTaps.size()> logLuminance{};
-            std::array<float, kMeterTaps.size()> weights{};
-            size_t sampleCount = 0;
-
             const int width = tex->getWidth();
             const int height = tex->getHeight();
+            meteringTaps.clear();
             for(const MeterTap& tap : kMeterTaps){
-                int x = Math3D::Clamp(static_cast<int>(std::round(tap.u * static_cast<float>(width - 1))), 0, width - 1);
-                int y = Math3D::Clamp(static_cast<int>(std::round(tap.v * static_cast<float>(height - 1))), 0, height - 1);
-                float pixel[4] = {0.0f, 0.0f, 0.0f, 1.0f};
-                glReadPixels(x, y, 1, 1, GL_RGBA, GL_FLOAT, pixel);
+                meteringTaps.push_back(GpuReadback::Tap{
+                    Math3D::Clamp(static_cast<int>(std::round(tap.u * static_cast<float>(width - 1))), 0, width - 1),
+                    Math3D::Clamp(static_cast<int>(std::round(tap.v * static_cast<float>(height - 1))), 0, height - 1)
+                });
+            }
+
+            // Meter from the newest finished read; this frame's taps land a frame or two later.
+            const bool hasNewSamples = meteringReadback.poll(meteringSamples);
+            meteringReadback.submit(tex, GpuReadback::Format::Color, meteringTaps);
+            if(!hasNewSamples || meteringSamples.size() != kMeterTaps.size() * 4){
+                return false;
+            }
+
+            std::array<float, kMeterTaps.size()> logLuminance{};
+            std::array<float, kMeterTaps.size()> weights{};
+            size_t sampleCount = 0;
+            for(size_t i = 0; i < kMeterTaps.size(); ++i){
+                const float* pixel = meteringSamples.data() + (i * 4);
                 float luminance = (pixel[0] * 0.2126f) + (pixel[1] * 0.7152f) + (pixel[2] * 0.0722f);
                 luminance = Math3D::Clamp(luminance, 0.0001f, 64.0f);
                 logLuminance[sampleCount] = std::log2(luminance);
-                weights[sampleCount] = tap.weight;
+                weights[sampleCount] = kMeterTaps[i].weight;
                 sampleCount++;
             }
 
-            glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(prevReadFbo));
-
             if(sampleCount == 0){
                 return false;
             }
@@ -2319,12 +2284,7 @@ class AutoExposureEffect : public Graphics::PostProcessing::PostProcessingEffect
         /**
          * @brief Destroys this AutoExposureEffect instance.
          */
-        ~AutoExposureEffect() override {
-            if(meteringReadFbo != 0){
-                glDeleteFramebuffers(1, &meteringReadFbo);
-                meteringReadFbo = 0;
-            }
-        }
+        ~AutoExposureEffect() override = default;
 
         /**
          * @brief Resets adaptation.
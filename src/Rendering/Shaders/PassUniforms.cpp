@@ -0,0 +1,146 @@
+/**
+ * @file src/Rendering/Shaders/PassUniforms.cpp
+ * @brief Implementation for PassUniforms.
+ */
+
+#include "Rendering/Shaders/PassUniforms.h"
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <cstring>
+#include <unordered_set>
+
+namespace {
+    constexpr GLuint PASS_UBO_BINDING = 1;
+
+    // Mirrors `PassBlock` in Shader_Frag_PBR.frag under std140: each vec3 shares its 16-byte
+    // slot with the scalar declared after it.
+    struct alignas(16) PassBlockUBO {
+        float invProjection[16];
+        float planarReflectionMatrix[16];
+        float localProbeCenter[3];
+        std::int32_t useLocalProbe;
+        float localProbeCaptureMin[3];
+        std::int32_t usePlanarReflection;
+        float localProbeCaptureMax[3];
+        float planarReflectionStrength;
+        float localProbeInfluenceMin[3];
+        float planarReflectionReceiverFadeDistance;
+        float localProbeInfluenceMax[3];
+        std::int32_t useSceneColor;
+        float planarReflectionCenter[3];
+        std::int32_t useSceneDepth;
+        float planarReflectionNormal[3];
+        std::int32_t useSsr;
+        float ssrIntensity;
+        float ssrMaxDistance;
+        float ssrThickness;
+        float ssrStride;
+        float ssrJitter;
+        std::int32_t ssrMaxSteps;
+        float ssrRoughnessCutoff;
+        float ssrEdgeFade;
+    };
+
+    static_assert(sizeof(PassBlockUBO) == 272, "PassBlockUBO must match the std140 PassBlock layout");
+
+    GLuint g_passUbo = 0;
+    bool g_hasLastBlock = false;
+    PassBlockUBO g_lastBlock;
+    PassUniformState g_activeState;
+    std::unordered_set<GLuint> g_boundPrograms;
+
+    void copyVec3(float* dst, const Math3D::Vec3& v){
+        dst[0] = v.x;
+        dst[1] = v.y;
+        dst[2] = v.z;
+    }
+
+    PassBlockUBO packBlock(const PassUniformState& state){
+        PassBlockUBO block;
+        std::memset(&block, 0, sizeof(block));
+        std::memcpy(block.invProjection, glm::value_ptr(state.invProjection.data), sizeof(block.invProjection));
+        std::memcpy(block.planarReflectionMatrix, glm::value_ptr(state.planarReflectionMatrix.data), sizeof(block.planarReflectionMatrix));
+        copyVec3(block.localProbeCenter, state.localProbeCenter);
+        copyVec3(block.localProbeCaptureMin, state.localProbeCaptureMin);
+        copyVec3(block.localProbeCaptureMax, state.localProbeCaptureMax);
+        copyVec3(block.localProbeInfluenceMin, state.localProbeInfluenceMin);
+        copyVec3(block.localProbeInfluenceMax, state.localProbeInfluenceMax);
+        copyVec3(block.planarReflectionCenter, state.planarReflectionCenter);
+        copyVec3(block.planarReflectionNormal, state.planarReflectionNormal);
+        block.useLocalProbe = state.useLocalProbe ? 1 : 0;
+        block.usePlanarReflection = state.usePlanarReflection ? 1 : 0;
+        block.planarReflectionStrength = state.planarReflectionStrength;
+        block.planarReflectionReceiverFadeDistance = state.planarReflectionReceiverFadeDistance;
+        block.useSceneColor = state.useSceneColor ? 1 : 0;
+        block.useSceneDepth = state.useSceneDepth ? 1 : 0;
+        block.useSsr = state.useSsr ? 1 : 0;
+        block.ssrIntensity = state.ssrIntensity;
+        block.ssrMaxDistance = state.ssrMaxDistance;
+        block.ssrThickness = state.ssrThickness;
+        block.ssrStride = state.ssrStride;
+        block.ssrJitter = state.ssrJitter;
+        block.ssrMaxSteps = state.ssrMaxSteps;
+        block.ssrRoughnessCutoff = state.ssrRoughnessCutoff;
+        block.ssrEdgeFade = state.ssrEdgeFade;
+        return block;
+    }
+
+    void writeBlock(const PassBlockUBO& block){
+        glBindBuffer(GL_UNIFORM_BUFFER, g_passUbo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(PassBlockUBO), &block);
+        glBindBufferRange(GL_UNIFORM_BUFFER, PASS_UBO_BINDING, g_passUbo, 0, sizeof(PassBlockUBO));
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        g_lastBlock = block;
+        g_hasLastBlock = true;
+        GLUniformUpload::UploadCounter()++;
+    }
+
+    void ensurePassUboCreated(){
+        if(g_passUbo != 0){
+            return;
+        }
+
+        glGenBuffers(1, &g_passUbo);
+        glBindBuffer(GL_UNIFORM_BUFFER, g_passUbo);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(PassBlockUBO), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        writeBlock(packBlock(PassUniformState{}));
+    }
+}
+
+void PassUniformUploader::Upload(const PassUniformState& state){
+    ensurePassUboCreated();
+    g_activeState = state;
+
+    const PassBlockUBO block = packBlock(state);
+    if(g_hasLastBlock && std::memcmp(&block, &g_lastBlock, sizeof(PassBlockUBO)) == 0){
+        return;
+    }
+    writeBlock(block);
+}
+
+const PassUniformState& PassUniformUploader::GetActiveState(){
+    return g_activeState;
+}
+
+void PassUniformUploader::BindProgram(const std::shared_ptr<ShaderProgram>& program){
+    if(!program || program->getID() == 0){
+        return;
+    }
+
+    ensurePassUboCreated();
+
+    const GLuint programId = program->getID();
+    if(g_boundPrograms.find(programId) != g_boundPrograms.end()){
+        return;
+    }
+    g_boundPrograms.insert(programId);
+
+    // Only PBR-style programs declare the block; the simple lit and flat shaders never do.
+    GLuint blockIndex = glGetUniformBlockIndex(programId, "PassBlock");
+    if(blockIndex == GL_INVALID_INDEX){
+        return;
+    }
+    glUniformBlockBinding(programId, blockIndex, PASS_UBO_BINDING);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file src/Rendering/Shaders/PassUniforms.h
+ * @brief Declarations for PassUniforms.
+ */
+
+#ifndef PASS_UNIFORMS_H
+#define PASS_UNIFORMS_H
+
+#include <memory>
+
+#include "Foundation/Math/Math3D.h"
+#include "Rendering/Shaders/ShaderProgram.h"
+
+/// @brief Holds data for PassUniformState: reflection and SSR inputs shared by every draw of a pass.
+struct PassUniformState {
+    Math3D::Mat4 invProjection;
+
+    bool useSceneColor = false;
+    bool useSceneDepth = false;
+    bool useSsr = false;
+    float ssrIntensity = 0.0f;
+    float ssrMaxDistance = 80.0f;
+    float ssrThickness = 0.18f;
+    float ssrStride = 0.75f;
+    float ssrJitter = 0.35f;
+    int ssrMaxSteps = 56;
+    float ssrRoughnessCutoff = 0.82f;
+    float ssrEdgeFade = 0.18f;
+
+    bool useLocalProbe = false;
+    Math3D::Vec3 localProbeCenter = Math3D::Vec3(0.0f, 0.0f, 0.0f);
+    Math3D::Vec3 localProbeCaptureMin = Math3D::Vec3(0.0f, 0.0f, 0.0f);
+    Math3D::Vec3 localProbeCaptureMax = Math3D::Vec3(0.0f, 0.0f, 0.0f);
+    Math3D::Vec3 localProbeInfluenceMin = Math3D::Vec3(0.0f, 0.0f, 0.0f);
+    Math3D::Vec3 localProbeInfluenceMax = Math3D::Vec3(0.0f, 0.0f, 0.0f);
+
+    bool usePlanarReflection = false;
+    Math3D::Mat4 planarReflectionMatrix;
+    float planarReflectionStrength = 1.0f;
+    Math3D::Vec3 planarReflectionCenter = Math3D::Vec3(0.0f, 0.0f, 0.0f);
+    Math3D::Vec3 planarReflectionNormal = Math3D::Vec3(0.0f, 1.0f, 0.0f);
+    float planarReflectionReceiverFadeDistance = 1.0f;
+};
+
+/// @brief Represents the PassUniformUploader type.
+class PassUniformUploader {
+public:
+    /**
+     * @brief Writes the PassBlock uniform buffer for the draws that follow.
+     *
+     * The block is shared by every program declaring `PassBlock`, so one upload replaces the
+     * per-draw string-keyed uniforms. Unchanged state is skipped.
+     * @param state Pass state to upload.
+     */
+    static void Upload(const PassUniformState& state);
+
+    /**
+     * @brief Returns the state most recently passed to Upload(), or defaults before the first one.
+     *
+     * Materials read the feature flags from it to pick the shader permutation for the pass.
+     * @return Active pass state.
+     */
+    static const PassUniformState& GetActiveState();
+
+    /**
+     * @brief Points a program's `PassBlock` at the shared buffer (once per program).
+     *
+     * Creates the buffer with default state on first use, so programs drawn outside a pass
+     * still read defined values. Programs without a `PassBlock` are skipped silently.
+     * @param program Program to bind.
+     */
+    static void BindProgram(const std::shared_ptr<ShaderProgram>& program);
+};
+
+#endif // PASS_UNIFORMS_H
@@ -0,0 +1,322 @@
+/**
+ * @file src/Rendering/Shaders/ProgramBinaryCache.cpp
+ * @brief Implementation for ProgramBinaryCache.
+ */
+
+#include "Rendering/Shaders/ProgramBinaryCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#include "Foundation/IO/File.h"
+#include "Foundation/Logging/Logbot.h"
+
+namespace ProgramBinaryCache {
+
+namespace {
+    /*
+     * Entry layout (little-endian), followed by `binaryLength` bytes of driver blob:
+     *   0  char[8] magic "RTPRGBIN"
+     *   8  u32     entry version
+     *  12  u32     GL binary format
+     *  16  u64     cache key (must match the file name)
+     *  24  u64     GL context identity hash
+     *  32  u32     binary length
+     *  36  u32     reserved
+     *  40  f64     source compile milliseconds
+     */
+    constexpr char kMagic[8] = {'R', 'T', 'P', 'R', 'G', 'B', 'I', 'N'};
+    constexpr std::uint32_t kEntryVersion = 1;
+    constexpr size_t kHeaderSize = 48;
+    // Anything larger is treated as corrupt rather than allocated.
+    constexpr std::uint32_t kMaxBinaryLength = 64u * 1024u * 1024u;
+
+    constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+    constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+    using CacheClock = std::chrono::steady_clock;
+
+    bool g_enabled = true;
+    bool g_probed = false;
+    bool g_supported = false;
+    std::uint64_t g_contextHash = 0;
+    std::filesystem::path g_directory;
+    Stats g_stats;
+
+    void hashBytes(std::uint64_t& hash, const void* data, size_t size){
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for(size_t i = 0; i < size; ++i){
+            hash ^= bytes[i];
+            hash *= kFnvPrime;
+        }
+    }
+
+    void hashString(std::uint64_t& hash, const char* text){
+        const char* value = text ? text : "";
+        // Length first, so adjacent strings cannot shift into each other.
+        const std::uint64_t length = std::strlen(value);
+        hashBytes(hash, &length, sizeof(length));
+        hashBytes(hash, value, static_cast<size_t>(length));
+    }
+
+    const char* glString(GLenum name){
+        const GLubyte* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+
+    double elapsedMs(const CacheClock::time_point& start){
+        return std::chrono::duration<double, std::milli>(CacheClock::now() - start).count();
+    }
+
+    // Queries driver support and the context identity once, on the first lookup.
+    void probe(){
+        if(g_probed){
+            return;
+        }
+        g_probed = true;
+
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        g_supported = formatCount > 0;
+
+        g_contextHash = kFnvOffset;
+        hashString(g_contextHash, glString(GL_VENDOR));
+        hashString(g_contextHash, glString(GL_RENDERER));
+        hashString(g_contextHash, glString(GL_VERSION));
+        hashString(g_contextHash, glString(GL_SHADING_LANGUAGE_VERSION));
+
+        if(g_directory.empty()){
+            g_directory = std::filesystem::path(File::GetCWD()) / "cache" / "shaders";
+        }
+
+        if(!g_supported){
+            LogBot.Log(LOG_WARN, "[ProgramBinaryCache] Driver reports no program binary formats; compiling all shaders from source.");
+            return;
+        }
+        std::error_code ec;
+        std::filesystem::create_directories(g_directory, ec);
+        if(ec){
+            LogBot.Log(LOG_WARN, "[ProgramBinaryCache] Cannot create '%s' (%s); cache disabled.",
+                       g_directory.u8string().c_str(), ec.message().c_str());
+            g_supported = false;
+            return;
+        }
+        LogBot.Log(LOG_INFO, "[ProgramBinaryCache] Using '%s' for %s / %s.",
+                   g_directory.u8string().c_str(), glString(GL_VENDOR), glString(GL_RENDERER));
+    }
+
+    std::filesystem::path entryPath(std::uint64_t key){
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+        return g_directory / name;
+    }
+
+    template <typename T>
+    T readField(const std::vector<char>& bytes, size_t offset){
+        T value;
+        std::memcpy(&value, bytes.data() + offset, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void writeField(std::vector<char>& bytes, size_t offset, T value){
+        std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+
+    void dropEntry(const std::filesystem::path& path){
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    bool readEntry(const std::filesystem::path& path, std::vector<char>& outBytes){
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if(!in){
+            return false;
+        }
+        const std::streamoff size = in.tellg();
+        if(size < static_cast<std::streamoff>(kHeaderSize) ||
+           size > static_cast<std::streamoff>(kHeaderSize) + static_cast<std::streamoff>(kMaxBinaryLength)){
+            return false;
+        }
+        outBytes.resize(static_cast<size_t>(size));
+        in.seekg(0);
+        return static_cast<bool>(in.read(outBytes.data(), size));
+    }
+}
+
+void SetEnabled(bool enabled){
+    g_enabled = enabled;
+}
+
+bool IsAvailable(){
+    if(!g_enabled){
+        return false;
+    }
+    probe();
+    return g_supported;
+}
+
+void SetDirectory(const std::filesystem::path& directory){
+    g_directory = directory;
+}
+
+std::filesystem::path GetDirectory(){
+    return g_directory;
+}
+
+std::uint64_t ComputeKey(const std::vector<StageSource>& stages){
+    probe();
+    std::uint64_t hash = kFnvOffset;
+    hashBytes(hash, &g_contextHash, sizeof(g_contextHash));
+    for(const StageSource& stage : stages){
+        hashBytes(hash, &stage.type, sizeof(stage.type));
+        const std::uint64_t length = stage.code ? stage.code->size() : 0;
+        hashBytes(hash, &length, sizeof(length));
+        if(stage.code){
+            hashBytes(hash, stage.code->data(), stage.code->size());
+        }
+    }
+    return hash;
+}
+
+bool TryLoad(GLuint program, std::uint64_t key){
+    if(program == 0 || !IsAvailable()){
+        return false;
+    }
+
+    const auto start = CacheClock::now();
+    const std::filesystem::path path = entryPath(key);
+    std::vector<char> bytes;
+    if(!readEntry(path, bytes)){
+        return false;
+    }
+
+    const bool headerValid =
+        std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) == 0 &&
+        readField<std::uint32_t>(bytes, 8) == kEntryVersion &&
+        readField<std::uint64_t>(bytes, 16) == key &&
+        readField<std::uint64_t>(bytes, 24) == g_contextHash &&
+        readField<std::uint32_t>(bytes, 32) == bytes.size() - kHeaderSize;
+    GLint linked = 0;
+    if(headerValid){
+        const GLenum binaryFormat = static_cast<GLenum>(readField<std::uint32_t>(bytes, 12));
+        glProgramBinary(program, binaryFormat, bytes.data() + kHeaderSize, static_cast<GLsizei>(bytes.size() - kHeaderSize));
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    }
+    if(!linked){
+        // Stale after a driver update, or truncated; compile from source and overwrite it.
+        g_stats.rejected++;
+        dropEntry(path);
+        return false;
+    }
+
+    g_stats.hits++;
+    g_stats.loadMs += elapsedMs(start);
+    g_stats.recordedCompileMs += readField<double>(bytes, 40);
+    return true;
+}
+
+void RecordCompile(double compileMs){
+    g_stats.misses++;
+    g_stats.compileMs += compileMs;
+}
+
+bool Store(GLuint program, std::uint64_t key, double compileMs){
+    if(program == 0 || !IsAvailable()){
+        return false;
+    }
+
+    GLint binaryLength = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if(binaryLength <= 0 || static_cast<std::uint32_t>(binaryLength) > kMaxBinaryLength){
+        g_stats.storeFailures++;
+        return false;
+    }
+
+    std::vector<char> bytes(kHeaderSize + static_cast<size_t>(binaryLength), 0);
+    GLsizei written = 0;
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(program, binaryLength, &written, &binaryFormat, bytes.data() + kHeaderSize);
+    if(written <= 0){
+        g_stats.storeFailures++;
+        return false;
+    }
+    bytes.resize(kHeaderSize + static_cast<size_t>(written));
+
+    std::memcpy(bytes.data(), kMagic, sizeof(kMagic));
+    writeField<std::uint32_t>(bytes, 8, kEntryVersion);
+    writeField<std::uint32_t>(bytes, 12, static_cast<std::uint32_t>(binaryFormat));
+    writeField<std::uint64_t>(bytes, 16, key);
+    writeField<std::uint64_t>(bytes, 24, g_contextHash);
+    writeField<std::uint32_t>(bytes, 32, static_cast<std::uint32_t>(written));
+    writeField<std::uint32_t>(bytes, 36, 0);
+    writeField<double>(bytes, 40, compileMs);
+
+    // Write beside the entry and rename, so a crash never leaves a half-written binary behind.
+    const std::filesystem::path path = entryPath(key);
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if(!out || !out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()))){
+            g_stats.storeFailures++;
+            out.close();
+            dropEntry(tempPath);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if(ec){
+        g_stats.storeFailures++;
+        dropEntry(tempPath);
+        return false;
+    }
+
+    g_stats.stored++;
+    return true;
+}
+
+size_t Clear(){
+    if(g_directory.empty()){
+        g_directory = std::filesystem::path(File::GetCWD()) / "cache" / "shaders";
+    }
+
+    size_t removed = 0;
+    std::error_code ec;
+    for(std::filesystem::directory_iterator it(g_directory, ec), end; !ec && it != end; it.increment(ec)){
+        if(it->path().extension() == ".bin" && std::filesystem::remove(it->path(), ec)){
+            removed++;
+        }
+    }
+    return removed;
+}
+
+const Stats& GetStats(){
+    return g_stats;
+}
+
+void LogStats(const char* label){
+    if(!g_enabled){
+        LogBot.Log(LOG_INFO, "[ProgramBinaryCache] %s: disabled, %llu program(s) compiled from source in %.1f ms.",
+                   label ? label : "stats",
+                   static_cast<unsigned long long>(g_stats.misses),
+                   g_stats.compileMs);
+        return;
+    }
+    LogBot.Log(LOG_INFO,
+               "[ProgramBinaryCache] %s: %llu hit(s) loaded in %.1f ms (%.1f ms as source) | %llu miss(es) compiled in %.1f ms, %llu rejected | %llu stored",
+               label ? label : "stats",
+               static_cast<unsigned long long>(g_stats.hits),
+               g_stats.loadMs,
+               g_stats.recordedCompileMs,
+               static_cast<unsigned long long>(g_stats.misses),
+               g_stats.compileMs,
+               static_cast<unsigned long long>(g_stats.rejected),
+               static_cast<unsigned long long>(g_stats.stored));
+}
+
+} // namespace ProgramBinaryCache
@@ -0,0 +1,134 @@
+/**
+ * @file src/Rendering/Shaders/ProgramBinaryCache.h
+ * @brief Declarations for ProgramBinaryCache.
+ */
+
+#ifndef PROGRAM_BINARY_CACHE_H
+#define PROGRAM_BINARY_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+/**
+ * @brief Persistent cache of linked GL program binaries.
+ *
+ * ShaderProgram::compile() asks it for a binary before compiling from source, and stores the
+ * binary of every program it links. Entries are keyed by a hash of every stage's type and
+ * source plus the GL vendor, renderer and version strings, so a driver or GPU change misses
+ * instead of loading an incompatible blob. A binary the driver rejects is deleted and the
+ * program is compiled from source as if it had never been cached.
+ *
+ * One `<key>.bin` file per program, under `<working dir>/cache/shaders` by default.
+ * GL thread only.
+ */
+namespace ProgramBinaryCache {
+
+/// @brief Holds data for StageSource: one shader stage fed into the cache key.
+struct StageSource {
+    std::uint32_t type = 0;
+    const std::string* code = nullptr;
+};
+
+/// @brief Holds data for Stats.
+struct Stats {
+    std::uint64_t hits = 0;
+    /// Programs compiled from source because no usable binary existed.
+    std::uint64_t misses = 0;
+    /// Binaries the driver refused or that failed validation; the program then counts as a miss.
+    std::uint64_t rejected = 0;
+    std::uint64_t stored = 0;
+    std::uint64_t storeFailures = 0;
+    /// Time spent reading and loading binaries on hits.
+    double loadMs = 0.0;
+    /// Source compile time the hits would have cost, as recorded when each binary was stored.
+    double recordedCompileMs = 0.0;
+    /// Source compile time of the misses.
+    double compileMs = 0.0;
+};
+
+/**
+ * @brief Enables or disables the cache. Disabled, every program compiles from source.
+ * @param enabled New state.
+ */
+void SetEnabled(bool enabled);
+
+/**
+ * @brief Returns whether the cache is enabled and the driver supports program binaries.
+ *
+ * The first call queries the GL context, so it must run on the GL thread.
+ * @return True when lookups and stores are active.
+ */
+bool IsAvailable();
+
+/**
+ * @brief Overrides the cache directory. Call before the first program compiles.
+ * @param directory Directory that holds the `.bin` files.
+ */
+void SetDirectory(const std::filesystem::path& directory);
+
+/**
+ * @brief Returns the cache directory.
+ * @return Directory path.
+ */
+std::filesystem::path GetDirectory();
+
+/**
+ * @brief Hashes the stage sources and the GL context identity into a cache key.
+ * @param stages Stages attached to the program.
+ * @return 64-bit key.
+ */
+std::uint64_t ComputeKey(const std::vector<StageSource>& stages);
+
+/**
+ * @brief Loads the binary stored for `key` into `program` and checks that it links.
+ *
+ * A missing, corrupt or driver-rejected entry returns false; rejected entries are deleted.
+ * @param program Freshly created program object with nothing attached.
+ * @param key Cache key from ComputeKey().
+ * @return True when `program` is linked and ready to use.
+ */
+bool TryLoad(GLuint program, std::uint64_t key);
+
+/**
+ * @brief Counts a program compiled from source as a miss, with its cost.
+ *
+ * Called for every source compile, including while the cache is disabled.
+ * @param compileMs Source compile and link time.
+ */
+void RecordCompile(double compileMs);
+
+/**
+ * @brief Writes the binary of a linked program to the cache.
+ *
+ * The program must have been linked with `GL_PROGRAM_BINARY_RETRIEVABLE_HINT` set.
+ * @param program Linked program.
+ * @param key Cache key from ComputeKey().
+ * @param compileMs Source compile time, kept so later hits can report what they saved.
+ * @return True when the entry was written.
+ */
+bool Store(GLuint program, std::uint64_t key, double compileMs);
+
+/**
+ * @brief Deletes every cached binary.
+ * @return Number of files removed.
+ */
+size_t Clear();
+
+/**
+ * @brief Returns totals since startup.
+ * @return Cache counters.
+ */
+const Stats& GetStats();
+
+/**
+ * @brief Logs the counters with a short label, e.g. "first frame" or "session".
+ * @param label Label for the log line.
+ */
+void LogStats(const char* label);
+
+} // namespace ProgramBinaryCache
+
+#endif // PROGRAM_BINARY_CACHE_H
@@ -6,12 +6,44 @@
 
 #include "Rendering/Shaders/ShaderProgram.h"
 
+#include <chrono>
 #include <iostream>
 
 #include "Foundation/Logging/Logbot.h"
+#include "Rendering/Shaders/ProgramBinaryCache.h"
 
 namespace {
     GLuint g_boundProgramCache = 0;
+
+    constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+    constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+    void hashBytes(std::uint64_t& hash, const std::string& text){
+        for(unsigned char c : text){
+            hash ^= c;
+            hash *= kFnvPrime;
+        }
+    }
+
+    // Offset just past the line holding `#version`, or npos when the source has none.
+    size_t findVersionLineEnd(const std::string& glsl, size_t& outVersionLine){
+        size_t lineStart = 0;
+        size_t lineNumber = 1;
+        while(lineStart < glsl.size()){
+            size_t lineEnd = glsl.find('\n', lineStart);
+            if(lineEnd == std::string::npos){
+                lineEnd = glsl.size();
+            }
+            const size_t first = glsl.find_first_not_of(" \t", lineStart);
+            if(first != std::string::npos && first < lineEnd && glsl.compare(first, 8, "#version") == 0){
+                outVersionLine = lineNumber;
+                return (lineEnd < glsl.size()) ? lineEnd + 1 : lineEnd;
+            }
+            lineStart = lineEnd + 1;
+            lineNumber++;
+        }
+        return std::string::npos;
+    }
 }
 
 void ShaderProgram::setVertexShader(std::string glsl){
@@ -83,13 +115,65 @@ std::string ShaderProgram::getLog(){
     return this->shaderLog;
 }
 
+std::string ShaderProgram::InjectDefines(const std::string& glsl, const std::vector<std::string>& defines){
+    if(defines.empty()){
+        return glsl;
+    }
+
+    size_t versionLine = 0;
+    const size_t insertAt = findVersionLineEnd(glsl, versionLine);
+
+    std::string block;
+    if(insertAt != std::string::npos && insertAt == glsl.size() && (glsl.empty() || glsl.back() != '\n')){
+        block += "\n";
+    }
+    for(const std::string& define : defines){
+        block += "#define " + define + " 1\n";
+    }
+    // Keep compiler log line numbers pointing at the original source.
+    block += "#line " + std::to_string(insertAt != std::string::npos ? versionLine + 1 : 1) + "\n";
+
+    if(insertAt == std::string::npos){
+        return block + glsl;
+    }
+    std::string result;
+    result.reserve(glsl.size() + block.size());
+    result.append(glsl, 0, insertAt);
+    result += block;
+    result.append(glsl, insertAt, std::string::npos);
+    return result;
+}
+
 Shader ShaderProgram::compile(){
+    const auto compileStart = std::chrono::steady_clock::now();
 
     this->programHandle = glCreateProgram();
+    // Locations belong to the previous handle; drop them before either the binary or the source path returns.
+    this->uniformLocationCache.clear();
+    this->attributeLocationCache.clear();
 
     bool anyShaderFailed = false;
 
     auto bundles = _getShaderBundles();
+
+    const bool binaryCacheActive = ProgramBinaryCache::IsAvailable();
+    std::uint64_t binaryKey = 0;
+    if(binaryCacheActive){
+        std::vector<ProgramBinaryCache::StageSource> stages;
+        for(const auto& bundle : bundles){
+            if(bundle.valid){
+                stages.push_back({static_cast<std::uint32_t>(bundle.type), &bundle.shader_code});
+            }
+        }
+        binaryKey = ProgramBinaryCache::ComputeKey(stages);
+        if(ProgramBinaryCache::TryLoad(this->programHandle, binaryKey)){
+            this->shaderLog += "Loaded from program binary cache.\n";
+            this->compileMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compileStart).count();
+            return this->programHandle;
+        }
+        glProgramParameteri(this->programHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     for(auto& bundle : bundles){
         if(bundle.valid){
             bundle.shaderHandle = this->_createShader(bundle.shader_code, bundle.type);
@@ -118,7 +202,6 @@ Shader ShaderProgram::compile(){
 
     this->shaderLog += this->_generateProgramLog(this->programHandle);
     this->shaderLog += "\n";
-    this->uniformLocationCache.clear();
 
     GLint linkSuccess = 0;
     glGetProgramiv(this->programHandle, GL_LINK_STATUS, &linkSuccess);
@@ -127,6 +210,11 @@ Shader ShaderProgram::compile(){
         this->programHandle = 0;
     }
 
+    this->compileMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compileStart).count();
+    ProgramBinaryCache::RecordCompile(this->compileMilliseconds);
+    if(binaryCacheActive && this->programHandle != 0){
+        ProgramBinaryCache::Store(this->programHandle, binaryKey, this->compileMilliseconds);
+    }
     return this->programHandle;
 }
 
@@ -163,6 +251,20 @@ GLint ShaderProgram::getUniformLocationCached(const std::string& name){
     return loc;
 }
 
+GLint ShaderProgram::getAttributeLocation(const std::string& name){
+    if(getID() == 0){
+        return -1;
+    }
+    auto it = attributeLocationCache.find(name);
+    if(it != attributeLocationCache.end()){
+        return it->second;
+    }
+
+    GLint loc = glGetAttribLocation(getID(), name.c_str());
+    attributeLocationCache.emplace(name, loc);
+    return loc;
+}
+
 void ShaderProgram::unbind(){
     if(g_boundProgramCache == 0){
         return;
@@ -171,3 +273,65 @@ void ShaderProgram::unbind(){
     g_boundProgramCache = 0;
 }
 
+ShaderCacheStats& ShaderCache::Stats(){
+    static ShaderCacheStats stats;
+    return stats;
+}
+
+std::uint64_t ShaderCache::HashSources(const std::string& vtx, const std::string& frag){
+    std::uint64_t hash = kFnvOffset;
+    hashBytes(hash, vtx);
+    hash ^= 0xFFu; // Stage separator, so moving text between stages changes the hash.
+    hash *= kFnvPrime;
+    hashBytes(hash, frag);
+    return hash;
+}
+
+std::shared_ptr<ShaderProgram> ShaderCache::getOrCompileVariant(
+    const std::string& name,
+    std::uint64_t sourceHash,
+    const std::vector<std::string>& keywords,
+    std::uint32_t keywordMask,
+    const std::string& vtx,
+    const std::string& frag
+){
+    const ShaderVariantKey key{sourceHash, keywordMask};
+    auto it = variantCache.find(key);
+    if(it != variantCache.end()){
+        return it->second;
+    }
+
+    std::vector<std::string> defines;
+    defines.reserve(keywords.size() + 1);
+    defines.push_back("SHADER_VARIANT");
+    for(size_t i = 0; i < keywords.size() && i < 32; ++i){
+        if(keywordMask & (1u << i)){
+            defines.push_back(keywords[i]);
+        }
+    }
+
+    auto program = std::make_shared<ShaderProgram>();
+    if(!vtx.empty()) program->setVertexShader(ShaderProgram::InjectDefines(vtx, defines));
+    if(!frag.empty()) program->setFragmentShader(ShaderProgram::InjectDefines(frag, defines));
+    program->compile();
+    variantCache.emplace(key, program);
+
+    ShaderCacheStats& stats = Stats();
+    stats.variantCompileMs += program->getCompileMilliseconds();
+    if(program->getID() == 0){
+        stats.variantsFailed++;
+        LogBot.Log(LOG_ERRO, "[ShaderCache] Variant %s#%08X failed to compile: \n%s",
+                   name.c_str(), keywordMask, program->getLog().c_str());
+        return program;
+    }
+
+    stats.variantsCompiled++;
+    LogBot.Log(LOG_INFO, "[ShaderCache] Compiled variant %s#%08X (%u keyword(s)) in %.2f ms | %llu variant(s), %.1f ms total",
+               name.c_str(),
+               keywordMask,
+               static_cast<unsigned int>(defines.size() - 1),
+               program->getCompileMilliseconds(),
+               static_cast<unsigned long long>(stats.variantsCompiled),
+               stats.variantCompileMs);
+    return program;
+}
@@ -6,6 +6,7 @@
 #ifndef SHADER_PROGRAM_H
 #define SHADER_PROGRAM_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <glad/glad.h>
@@ -42,6 +43,17 @@ class Uniform {
 };
 
 namespace GLUniformUpload {
+    /**
+     * @brief Returns the running count of uniform uploads (plain uniforms and uniform block updates).
+     *
+     * Never reset; sample it before and after a frame to get that frame's upload count.
+     * @return Reference to the counter.
+     */
+    inline std::uint64_t& UploadCounter(){
+        static std::uint64_t counter = 0;
+        return counter;
+    }
+
     /// @brief Holds data for TextureSlot.
     struct TextureSlot {
         std::shared_ptr<Texture> texture;
@@ -252,7 +264,9 @@ class ShaderProgram{
     
         Shader programHandle = 0;
         std::string shaderLog;
+        double compileMilliseconds = 0.0;
         std::unordered_map<std::string, GLint> uniformLocationCache;
+        std::unordered_map<std::string, GLint> attributeLocationCache;
 
         /**
          * @brief Returns a cached uniform location, querying OpenGL if needed.
@@ -432,6 +446,20 @@ class ShaderProgram{
          * @return Log message text.
          */
         std::string getLog();
+        /**
+         * @brief Returns the wall time the last compile() spent compiling and linking.
+         * @return Milliseconds, or `0` before the first compile.
+         */
+        double getCompileMilliseconds() const { return compileMilliseconds; }
+        /**
+         * @brief Inserts one `#define <name> 1` line per entry after the `#version` directive.
+         *
+         * Sources without a `#version` directive get the defines at the very top.
+         * @param glsl GLSL source code.
+         * @param defines Macro names to define.
+         * @return Source with the defines injected.
+         */
+        static std::string InjectDefines(const std::string& glsl, const std::vector<std::string>& defines);
         /**
          * @brief Compiles and links all configured shader stages.
          * @return Program handle, or `0` on failure.
@@ -457,6 +485,7 @@ class ShaderProgram{
             GLint loc = getUniformLocationCached(name);
             if(loc != -1){
                 GLUniformUpload::upload(loc, uniform.get());
+                GLUniformUpload::UploadCounter()++;
             }
             //unbind();
         }
@@ -468,12 +497,38 @@ class ShaderProgram{
          */
         template<typename T>
         void setUniformFast(const std::string& name, const Uniform<T>& uniform){
-            GLint loc = getUniformLocationCached(name);
-            if(loc != -1){
-                GLUniformUpload::upload(loc, uniform.get());
+            setUniformFast(getUniformLocationCached(name), uniform);
+        }
+
+        /**
+         * @brief Sets the uniform fast at a location from getUniformLocation().
+         * @param location Uniform location; `-1` is ignored.
+         * @param uniform Uniform wrapper containing the value.
+         */
+        template<typename T>
+        void setUniformFast(GLint location, const Uniform<T>& uniform){
+            if(location != -1){
+                GLUniformUpload::upload(location, uniform.get());
+                GLUniformUpload::UploadCounter()++;
             }
         }
 
+        /**
+         * @brief Returns a uniform location for repeated setUniformFast() calls.
+         * @param name Uniform name.
+         * @return Uniform location, or `-1` when missing.
+         */
+        GLint getUniformLocation(const std::string& name){
+            return getUniformLocationCached(name);
+        }
+
+        /**
+         * @brief Returns a vertex attribute location, cached until the program is recompiled.
+         * @param name Attribute name.
+         * @return Attribute location, or `-1` when missing.
+         */
+        GLint getAttributeLocation(const std::string& name);
+
         /**
          * @brief Returns the OpenGL program id.
          * @return Program handle.
@@ -495,9 +550,73 @@ class ShaderProgram{
 };
 
 
+/// @brief Holds data for ShaderVariantKey: one keyword permutation of a shader source pair.
+struct ShaderVariantKey{
+    std::uint64_t sourceHash = 0;
+    std::uint32_t keywordMask = 0;
+
+    bool operator==(const ShaderVariantKey& other) const{
+        return sourceHash == other.sourceHash && keywordMask == other.keywordMask;
+    }
+};
+
+/// @brief Hashes ShaderVariantKey for unordered containers.
+struct ShaderVariantKeyHash{
+    size_t operator()(const ShaderVariantKey& key) const{
+        return static_cast<size_t>(key.sourceHash ^ (static_cast<std::uint64_t>(key.keywordMask) * 0x9E3779B97F4A7C15ull));
+    }
+};
+
+/// @brief Holds data for ShaderCacheStats.
+struct ShaderCacheStats{
+    std::uint64_t programsCompiled = 0;
+    std::uint64_t variantsCompiled = 0;
+    std::uint64_t variantsFailed = 0;
+    double programCompileMs = 0.0;
+    double variantCompileMs = 0.0;
+};
+
 /// @brief Holds data for ShaderCache.
 struct ShaderCache{
     std::map<std::string, std::shared_ptr<ShaderProgram>> programCache;
+    /// Keyword permutations, keyed by (source hash, keyword mask). Failed variants stay cached with ID 0.
+    std::unordered_map<ShaderVariantKey, std::shared_ptr<ShaderProgram>, ShaderVariantKeyHash> variantCache;
+
+    /**
+     * @brief Returns compile counters summed over every ShaderCache in the process.
+     * @return Reference to the process-wide counters.
+     */
+    static ShaderCacheStats& Stats();
+
+    /**
+     * @brief Hashes a vertex/fragment source pair for use in a ShaderVariantKey.
+     * @param vtx Vertex shader source.
+     * @param frag Fragment shader source.
+     * @return 64-bit FNV-1a hash.
+     */
+    static std::uint64_t HashSources(const std::string& vtx, const std::string& frag);
+
+    /**
+     * @brief Returns a keyword permutation of a vertex/fragment pair, compiling it on first request.
+     *
+     * Bit `i` of `keywordMask` injects `keywords[i]` into both stages, together with `SHADER_VARIANT`.
+     * A variant that fails to compile is cached as is (ID 0) and not retried.
+     * @param name Display name used in log messages.
+     * @param sourceHash HashSources() of `vtx` and `frag`.
+     * @param keywords Keyword names, indexed by mask bit.
+     * @param keywordMask Enabled keywords.
+     * @param vtx Vertex shader source.
+     * @param frag Fragment shader source.
+     * @return Shared pointer to the variant program.
+     */
+    std::shared_ptr<ShaderProgram> getOrCompileVariant(
+        const std::string& name,
+        std::uint64_t sourceHash,
+        const std::vector<std::string>& keywords,
+        std::uint32_t keywordMask,
+        const std::string& vtx,
+        const std::string& frag
+    );
 
     /**
      * @brief Returns a cached shader program, compiling and caching if missing.
@@ -542,6 +661,8 @@ struct ShaderCache{
 
 
         program->compile();
+        Stats().programsCompiled++;
+        Stats().programCompileMs += program->getCompileMilliseconds();
 
         programCache[name] = program;
 
@@ -553,6 +674,7 @@ struct ShaderCache{
      */
     void clear(){
         programCache.clear();
+        variantCache.clear();
     }
 };
 
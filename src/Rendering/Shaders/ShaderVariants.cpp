@@ -0,0 +1,65 @@
+/**
+ * @file src/Rendering/Shaders/ShaderVariants.cpp
+ * @brief Implementation for ShaderVariants.
+ */
+
+#include "Rendering/Shaders/ShaderVariants.h"
+
+#include <utility>
+
+#include "Foundation/Logging/Logbot.h"
+
+namespace {
+    constexpr size_t kMaxKeywords = 32;
+}
+
+ShaderVariantSet::ShaderVariantSet(std::string name,
+                                   std::string vertexSource,
+                                   std::string fragmentSource,
+                                   std::vector<std::string> keywords)
+    : name(std::move(name)),
+      vertexSource(std::move(vertexSource)),
+      fragmentSource(std::move(fragmentSource)),
+      keywords(std::move(keywords)){
+    if(this->keywords.size() > kMaxKeywords){
+        LogBot.Log(LOG_WARN, "[ShaderVariantSet] '%s' declares %llu keywords; only the first %llu are used.",
+                   this->name.c_str(),
+                   static_cast<unsigned long long>(this->keywords.size()),
+                   static_cast<unsigned long long>(kMaxKeywords));
+        this->keywords.resize(kMaxKeywords);
+    }
+    validMask = (this->keywords.size() >= kMaxKeywords)
+        ? 0xFFFFFFFFu
+        : ((1u << this->keywords.size()) - 1u);
+    sourceHash = ShaderCache::HashSources(this->vertexSource, this->fragmentSource);
+}
+
+std::shared_ptr<ShaderProgram> ShaderVariantSet::getBaseProgram(){
+    if(!baseProgram || baseProgram->getID() == 0){
+        baseProgram = ShaderCacheManager::INSTANCE.getOrCompile(name, vertexSource, fragmentSource);
+    }
+    return baseProgram;
+}
+
+std::shared_ptr<ShaderProgram> ShaderVariantSet::getVariant(std::uint32_t keywordMask){
+    keywordMask &= validMask;
+    auto it = variants.find(keywordMask);
+    if(it != variants.end()){
+        return it->second;
+    }
+
+    std::shared_ptr<ShaderProgram> program = ShaderCacheManager::INSTANCE.getOrCompileVariant(
+        name,
+        sourceHash,
+        keywords,
+        keywordMask,
+        vertexSource,
+        fragmentSource
+    );
+    if(!program || program->getID() == 0){
+        // The cache already logged the compile error; keep drawing with the runtime-branching program.
+        program = getBaseProgram();
+    }
+    variants.emplace(keywordMask, program);
+    return program;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file src/Rendering/Shaders/ShaderVariants.h
+ * @brief Declarations for ShaderVariants.
+ */
+
+#ifndef SHADER_VARIANTS_H
+#define SHADER_VARIANTS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Rendering/Shaders/ShaderProgram.h"
+
+/**
+ * @brief Keyword permutations of one vertex/fragment shader pair.
+ *
+ * The plain program (no keywords, cached under the set name) branches on runtime uniforms
+ * and always works. Each keyword mask selects a permutation compiled with `SHADER_VARIANT`
+ * and the matching keywords defined, so the shader can fold disabled features away.
+ * Permutations compile lazily on first request and live in ShaderCacheManager::INSTANCE,
+ * keyed by (source hash, keyword mask). GL thread only.
+ */
+class ShaderVariantSet {
+    public:
+        /**
+         * @brief Constructs a new ShaderVariantSet instance.
+         * @param name Cache name of the plain program; also used in log messages.
+         * @param vertexSource Vertex shader source.
+         * @param fragmentSource Fragment shader source.
+         * @param keywords Keyword names, indexed by mask bit (at most 32).
+         */
+        ShaderVariantSet(std::string name,
+                         std::string vertexSource,
+                         std::string fragmentSource,
+                         std::vector<std::string> keywords);
+
+        /**
+         * @brief Returns the plain program, compiling it on first use.
+         * @return Shared pointer to the program (ID 0 when it failed to link).
+         */
+        std::shared_ptr<ShaderProgram> getBaseProgram();
+
+        /**
+         * @brief Returns the permutation for `keywordMask`, compiling it on first use.
+         *
+         * Falls back to the plain program when the permutation fails to compile.
+         * @param keywordMask Enabled keywords; bits beyond the keyword list are ignored.
+         * @return Shared pointer to the program.
+         */
+        std::shared_ptr<ShaderProgram> getVariant(std::uint32_t keywordMask);
+
+        const std::string& getName() const { return name; }
+        const std::vector<std::string>& getKeywords() const { return keywords; }
+        /**
+         * @brief Returns how many permutations this set has requested so far.
+         * @return Permutation count, failed ones included.
+         */
+        size_t getVariantCount() const { return variants.size(); }
+
+    private:
+        std::string name;
+        std::string vertexSource;
+        std::string fragmentSource;
+        std::vector<std::string> keywords;
+        std::uint64_t sourceHash = 0;
+        std::uint32_t validMask = 0;
+        std::shared_ptr<ShaderProgram> baseProgram;
+        std::unordered_map<std::uint32_t, std::shared_ptr<ShaderProgram>> variants;
+};
+
+#endif // SHADER_VARIANTS_H
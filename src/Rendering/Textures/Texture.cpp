@@ -206,7 +206,7 @@ std::shared_ptr<Graphics::Image::Image> Texture::LoadImage(PAsset asset, bool fl
         return nullptr;
     }
 
-    BinaryBuffer fileBuffer = asset->asRaw();
+    const ByteView fileBuffer = asset->view();
     if(fileBuffer.empty()){
         textureLogger.Log(LOG_ERRO,"File was Empty (Reached EOF before data was found.)");
         return nullptr;
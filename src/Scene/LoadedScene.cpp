@@ -31,7 +31,13 @@ void LoadedScene::init(){
     }
 
     sceneLoaded = loadSceneDocument();
-    if(sceneLoaded){
+    if(sceneLoaded && incrementalLoad){
+        // Populated by render(); keep the half-built scene out of ECS updates until then.
+        sceneLoaded = false;
+        setECSUpdatesSuspended(true);
+        LogBot.Log(LOG_INFO, "LoadedScene loading '%s' incrementally (%.1f ms per frame).",
+                   sceneRefOrPath.c_str(), incrementalLoadBudgetMs);
+    }else if(sceneLoaded){
         refreshRenderState();
         LogBot.Log(LOG_INFO, "LoadedScene initialized from '%s'.", sceneRefOrPath.c_str());
     }else if(!lastLoadError.empty()){
@@ -40,6 +46,7 @@ void LoadedScene::init(){
 }
 
 bool LoadedScene::loadSceneDocument(){
+    incrementalLoad.reset();
     lastLoadError.clear();
     sourceScenePath.clear();
     sourceSceneAsset.reset();
@@ -58,12 +65,20 @@ bool LoadedScene::loadSceneDocument(){
     loadOptions.registry = &Serialization::DefaultComponentSerializationRegistry();
 
     const bool usesAssetRef = AssetDescriptorUtils::IsAssetRef(sceneRefOrPath);
+    const bool incremental = incrementalLoadBudgetMs > 0.0f;
+    if(incremental){
+        incrementalLoad = std::make_unique<SceneIO::IncrementalSceneLoad>();
+    }
     if(usesAssetRef){
         std::filesystem::path resolvedSourcePath;
         if(AssetDescriptorUtils::AssetRefToAbsolutePath(sceneRefOrPath, resolvedSourcePath)){
             sourceScenePath = resolvedSourcePath.lexically_normal();
         }
-        if(!SceneIO::LoadSceneFromAssetRef(self, sceneRefOrPath, loadOptions, nullptr, &lastLoadError)){
+        const bool started = incremental
+            ? incrementalLoad->beginFromAssetRef(self, sceneRefOrPath, loadOptions, &lastLoadError)
+            : SceneIO::LoadSceneFromAssetRef(self, sceneRefOrPath, loadOptions, nullptr, &lastLoadError);
+        if(!started){
+            incrementalLoad.reset();
             return false;
         }
     }else{
@@ -78,11 +93,22 @@ bool LoadedScene::loadSceneDocument(){
         absolutePath = absolutePath.lexically_normal();
         sourceScenePath = absolutePath;
 
-        if(!SceneIO::LoadSceneFromAbsolutePath(self, absolutePath, loadOptions, nullptr, &lastLoadError)){
+        const bool started = incremental
+            ? incrementalLoad->beginFromAbsolutePath(self, absolutePath, loadOptions, &lastLoadError)
+            : SceneIO::LoadSceneFromAbsolutePath(self, absolutePath, loadOptions, nullptr, &lastLoadError);
+        if(!started){
+            incrementalLoad.reset();
             return false;
         }
     }
 
+    if(!incremental){
+        finishSceneLoad();
+    }
+    return true;
+}
+
+void LoadedScene::finishSceneLoad(){
     ensureCameraAfterLoad();
     if(!sourceScenePath.empty()){
         std::error_code ec;
@@ -94,7 +120,25 @@ bool LoadedScene::loadSceneDocument(){
             sourceSceneAsset = AssetManager::Instance.getOrLoad(sourceScenePath.generic_string());
         }
     }
-    return true;
+}
+
+void LoadedScene::stepIncrementalLoad(){
+    if(!incrementalLoad->step(incrementalLoadBudgetMs, &lastLoadError)){
+        LogBot.Log(LOG_ERRO, "LoadedScene incremental load failed: %s", lastLoadError.c_str());
+        incrementalLoad.reset();
+        setECSUpdatesSuspended(false);
+        return;
+    }
+    if(!incrementalLoad->isDone()){
+        return;
+    }
+
+    incrementalLoad.reset();
+    finishSceneLoad();
+    setECSUpdatesSuspended(false);
+    sceneLoaded = true;
+    refreshRenderState();
+    LogBot.Log(LOG_INFO, "LoadedScene initialized from '%s'.", sceneRefOrPath.c_str());
 }
 
 void LoadedScene::ensureCameraAfterLoad(){
@@ -125,6 +169,10 @@ void LoadedScene::ensureCameraAfterLoad(){
 }
 
 void LoadedScene::render(){
+    // Stepped here rather than in update() so component restores that create GL objects stay on the GL thread.
+    if(incrementalLoad){
+        stepIncrementalLoad();
+    }
     if(!getWindow()){
         return;
     }
@@ -133,3 +181,9 @@ void LoadedScene::render(){
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     renderViewportContents();
 }
+
+void LoadedScene::dispose(){
+    // The running load holds a reference to this scene; drop it so the scene can be released.
+    incrementalLoad.reset();
+    Scene3D::dispose();
+}
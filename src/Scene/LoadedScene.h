@@ -7,10 +7,12 @@
 #define SCENE_LOADED_SCENE_H
 
 #include <filesystem>
+#include <memory>
 #include <string>
 
 #include "Assets/Core/Asset.h"
 #include "Scene/Scene.h"
+#include "Serialization/IO/SceneIO.h"
 
 /// @brief Represents the LoadedScene type.
 class LoadedScene : public Scene3D {
@@ -45,11 +47,29 @@ class LoadedScene : public Scene3D {
         bool didLoadSuccessfully() const { return sceneLoaded; }
         const std::string& getLastLoadError() const { return lastLoadError; }
 
+        /**
+         * @brief Spreads the scene load over frames, spending at most `budgetMs` per frame.
+         *
+         * Takes effect at the next init(); 0 (the default) loads synchronously inside init().
+         * @param budgetMs Per-frame load budget in milliseconds.
+         */
+        void setIncrementalLoadBudgetMs(float budgetMs) { incrementalLoadBudgetMs = budgetMs; }
+        float getIncrementalLoadBudgetMs() const { return incrementalLoadBudgetMs; }
+        /// @brief Returns true while an incremental load is still running.
+        bool isLoading() const { return incrementalLoad != nullptr; }
+        /// @brief Returns progress of the running incremental load.
+        SceneIO::IncrementalLoadProgress getLoadProgress() const {
+            return incrementalLoad ? incrementalLoad->getProgress() : SceneIO::IncrementalLoadProgress{};
+        }
+
         void init() override;
         void render() override;
+        void dispose() override;
 
     private:
         bool loadSceneDocument();
+        void finishSceneLoad();
+        void stepIncrementalLoad();
         void ensureCameraAfterLoad();
 
         std::string sceneRefOrPath;
@@ -58,6 +78,8 @@ class LoadedScene : public Scene3D {
         PAsset sourceSceneAsset;
         bool sceneLoaded = false;
         std::string lastLoadError;
+        float incrementalLoadBudgetMs = 0.0f;
+        std::unique_ptr<SceneIO::IncrementalSceneLoad> incrementalLoad;
 };
 
 #endif // SCENE_LOADED_SCENE_H
@@ -0,0 +1,84 @@
+/**
+ * @file src/Scene/RenderTables.cpp
+ * @brief Implementation for RenderEntityHandleTable.
+ */
+
+#include "Scene/RenderTables.h"
+
+namespace {
+    const std::string kEmptyEntityId;
+}
+
+std::uint32_t RenderEntityHandleTable::acquire(NeoECS::ECSEntity* entity){
+    if(!entity){
+        return kInvalidHandle;
+    }
+
+    const std::string entityId = entity->getNodeUniqueID();
+    auto it = handleByEntity.find(entity);
+    if(it != handleByEntity.end()){
+        Slot& slot = slots[it->second];
+        // A deleted entity's address can be reused within one tick; the id tells them apart.
+        if(slot.id == entityId){
+            slot.lastSeenBuild = currentBuild;
+            return it->second;
+        }
+        auto idIt = handleById.find(slot.id);
+        if(idIt != handleById.end() && idIt->second == it->second){
+            handleById.erase(idIt);
+        }
+        slot.entity = nullptr;
+        slot.id.clear();
+        freeHandles.push_back(it->second);
+        handleByEntity.erase(it);
+    }
+
+    std::uint32_t handle = kInvalidHandle;
+    if(!freeHandles.empty()){
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }else{
+        handle = static_cast<std::uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    Slot& slot = slots[handle];
+    slot.entity = entity;
+    slot.id = entityId;
+    slot.lastSeenBuild = currentBuild;
+    handleByEntity[entity] = handle;
+    handleById[entityId] = handle;
+    return handle;
+}
+
+void RenderEntityHandleTable::releaseUnseen(){
+    for(std::uint32_t handle = 1; handle < static_cast<std::uint32_t>(slots.size()); ++handle){
+        Slot& slot = slots[handle];
+        if(!slot.entity || slot.lastSeenBuild == currentBuild){
+            continue;
+        }
+        handleByEntity.erase(slot.entity);
+        auto idIt = handleById.find(slot.id);
+        if(idIt != handleById.end() && idIt->second == handle){
+            handleById.erase(idIt);
+        }
+        slot.entity = nullptr;
+        slot.id.clear();
+        freeHandles.push_back(handle);
+    }
+}
+
+std::uint32_t RenderEntityHandleTable::findById(const std::string& entityId) const{
+    if(entityId.empty()){
+        return kInvalidHandle;
+    }
+    auto it = handleById.find(entityId);
+    return (it != handleById.end()) ? it->second : kInvalidHandle;
+}
+
+const std::string& RenderEntityHandleTable::getId(std::uint32_t handle) const{
+    if(handle == kInvalidHandle || handle >= slots.size()){
+        return kEmptyEntityId;
+    }
+    return slots[handle].id;
+}
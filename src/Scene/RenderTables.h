@@ -0,0 +1,187 @@
+/**
+ * @file src/Scene/RenderTables.h
+ * @brief Stable index tables backing the structure-of-arrays render snapshot.
+ */
+
+#ifndef RENDER_TABLES_H
+#define RENDER_TABLES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "neoecs.hpp"
+
+/**
+ * @brief Maps shared render resources (meshes, materials) to stable 32-bit indices.
+ *
+ * The table owns one reference per live resource, so snapshot items store a plain
+ * index instead of a shared_ptr copy. Indices stay valid until the resource goes
+ * unused for more builds than the snapshot ring is deep.
+ *
+ * find() is read-only and may run concurrently with other find() calls; every other
+ * member must run on the thread that owns the snapshot build.
+ */
+template <typename T>
+class RenderResourceTable {
+    public:
+        static constexpr std::uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+        /**
+         * @brief Starts a new build generation; resources acquired or touched afterwards count as used.
+         */
+        void beginBuild(){ ++currentBuild; }
+
+        /**
+         * @brief Looks up an existing index without inserting.
+         * @param resource Resource to find.
+         * @return Index, or kInvalidIndex when the resource is not in the table.
+         */
+        std::uint32_t find(const T* resource) const {
+            auto it = indexByResource.find(resource);
+            return (it != indexByResource.end()) ? it->second : kInvalidIndex;
+        }
+
+        /**
+         * @brief Returns the index for a resource, inserting it when missing, and marks it used.
+         * @param resource Resource to register.
+         * @return Stable index, or kInvalidIndex for a null resource.
+         */
+        std::uint32_t acquire(const std::shared_ptr<T>& resource){
+            if(!resource){
+                return kInvalidIndex;
+            }
+            std::uint32_t index = find(resource.get());
+            if(index == kInvalidIndex){
+                if(!freeSlots.empty()){
+                    index = freeSlots.back();
+                    freeSlots.pop_back();
+                }else{
+                    index = static_cast<std::uint32_t>(slots.size());
+                    slots.emplace_back();
+                }
+                slots[index].resource = resource;
+                indexByResource.emplace(resource.get(), index);
+                ++liveCount;
+            }
+            slots[index].lastUsedBuild = currentBuild;
+            return index;
+        }
+
+        /**
+         * @brief Marks an index returned by find() as used by the current build.
+         * @param index Live index.
+         */
+        void touch(std::uint32_t index){ slots[index].lastUsedBuild = currentBuild; }
+
+        /**
+         * @brief Drops resources no snapshot can still reference.
+         * @param keepBuilds Number of most recent builds whose resources must stay alive.
+         */
+        void releaseUnused(std::uint64_t keepBuilds){
+            for(std::uint32_t index = 0; index < static_cast<std::uint32_t>(slots.size()); ++index){
+                Slot& slot = slots[index];
+                if(!slot.resource || slot.lastUsedBuild + keepBuilds > currentBuild){
+                    continue;
+                }
+                indexByResource.erase(slot.resource.get());
+                slot.resource.reset();
+                freeSlots.push_back(index);
+                --liveCount;
+            }
+        }
+
+        /**
+         * @brief Returns the raw resource for an index.
+         * @param index Live index.
+         * @return Non-owning resource pointer.
+         */
+        T* get(std::uint32_t index) const { return slots[index].resource.get(); }
+
+        /**
+         * @brief Returns the owning pointer for an index.
+         * @param index Live index.
+         * @return Shared resource reference.
+         */
+        const std::shared_ptr<T>& getShared(std::uint32_t index) const { return slots[index].resource; }
+
+        /**
+         * @brief Returns how many resources the table currently keeps alive.
+         * @return Live resource count.
+         */
+        size_t size() const { return liveCount; }
+
+    private:
+        /// @brief Holds data for Slot.
+        struct Slot {
+            std::shared_ptr<T> resource;
+            std::uint64_t lastUsedBuild = 0;
+        };
+
+        std::vector<Slot> slots;
+        std::vector<std::uint32_t> freeSlots;
+        std::unordered_map<const T*, std::uint32_t> indexByResource;
+        std::uint64_t currentBuild = 0;
+        size_t liveCount = 0;
+};
+
+/**
+ * @brief Assigns stable 32-bit handles to ECS entities seen by the snapshot build.
+ *
+ * Render passes compare handles instead of entity id strings. A handle lives as long
+ * as its entity keeps appearing in builds; handle 0 is never assigned.
+ */
+class RenderEntityHandleTable {
+    public:
+        static constexpr std::uint32_t kInvalidHandle = 0;
+
+        /**
+         * @brief Starts a new build generation.
+         */
+        void beginBuild(){ ++currentBuild; }
+
+        /**
+         * @brief Returns the handle for an entity, assigning one when it is new.
+         * @param entity Entity seen by the current build.
+         * @return Stable handle.
+         */
+        std::uint32_t acquire(NeoECS::ECSEntity* entity);
+
+        /**
+         * @brief Releases handles for entities that were not seen by the current build.
+         */
+        void releaseUnseen();
+
+        /**
+         * @brief Looks up the handle of an entity id.
+         * @param entityId Entity unique id.
+         * @return Handle, or kInvalidHandle when no live entity has that id.
+         */
+        std::uint32_t findById(const std::string& entityId) const;
+
+        /**
+         * @brief Returns the entity id behind a handle.
+         * @param handle Live handle.
+         * @return Entity unique id, or an empty string for an unknown handle.
+         */
+        const std::string& getId(std::uint32_t handle) const;
+
+    private:
+        /// @brief Holds data for Slot.
+        struct Slot {
+            NeoECS::ECSEntity* entity = nullptr;
+            std::string id;
+            std::uint64_t lastSeenBuild = 0;
+        };
+
+        std::vector<Slot> slots{1};
+        std::vector<std::uint32_t> freeHandles;
+        std::unordered_map<const NeoECS::ECSEntity*, std::uint32_t> handleByEntity;
+        std::unordered_map<std::string, std::uint32_t> handleById;
+        std::uint64_t currentBuild = 0;
+};
+
+#endif // RENDER_TABLES_H
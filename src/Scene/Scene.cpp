@@ -6,6 +6,7 @@
 #include "Scene/Scene.h"
 
 #include "Rendering/Core/Screen.h"
+#include "Rendering/Core/FrustumCulling.h"
 #include "Rendering/Lighting/ShadowRenderer.h"
 #include "Foundation/Logging/Logbot.h"
 #include "Rendering/Textures/SkyBox.h"
@@ -23,19 +24,55 @@
 #include "Rendering/Materials/PBRMaterial.h"
 #include "Rendering/Lighting/LightUtils.h"
 #include "Rendering/PostFX/LensFlareEffect.h"
+#include "Rendering/Shaders/PassUniforms.h"
 #include "Rendering/Shaders/ShaderProgram.h"
 #include "Assets/Core/Asset.h"
 #include "Foundation/Util/StringUtils.h"
+#include "Foundation/Threading/WorkerPool.h"
 #include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cfloat>
+#include <iterator>
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace {
     const Math3D::Vec4 kSelectionOutlineColor(0.20392157f, 0.59607846f, 0.85882354f, 0.95f);
-    constexpr int kDeferredLightTileSize = 16;
+    constexpr size_t kSnapshotEntitiesPerChunk = 256;
+    // Marks a chunk-local index into SnapshotChunk::pendingMeshes/pendingMaterials.
+    constexpr std::uint32_t kPendingResourceBit = 0x80000000u;
+    // Resources stay in the snapshot tables for the last builds; the renderer only dereferences
+    // the newest snapshot it acquired, which is always among them.
+    constexpr std::uint64_t kSnapshotResourceKeepBuilds = 2;
+    // Snapshots published further apart than this (stalls, editor-driven rebuilds) are not blended.
+    constexpr float kSnapshotInterpolationMaxInterval = 0.25f;
+    // Presentation-slot revisions never collide with published ones in per-revision caches.
+    constexpr std::uint64_t kPresentedRevisionBit = std::uint64_t(1) << 63;
+    // Shader_Frag_DeferredLight.frag permutation keywords, indexed by the bits below.
+    const char* const kDeferredLightKeywords[] = {"USE_ENV_MAP", "USE_LOCAL_PROBE", "USE_FOG", "USE_SSAO", "USE_GI"};
+    constexpr std::uint32_t kDeferredLightKeyword_EnvMap = 1u << 0;
+    constexpr std::uint32_t kDeferredLightKeyword_LocalProbe = 1u << 1;
+    constexpr std::uint32_t kDeferredLightKeyword_Fog = 1u << 2;
+    constexpr std::uint32_t kDeferredLightKeyword_Ssao = 1u << 3;
+    constexpr std::uint32_t kDeferredLightKeyword_Gi = 1u << 4;
+
+    Math3D::Mat4 interpolateModelMatrix(const Math3D::Mat4& from, const Math3D::Mat4& to, float alpha){
+        if(from.data == to.data){
+            return to;
+        }
+        Math3D::Vec3 fromPosition, toPosition, fromScale, toScale;
+        Math3D::Quat fromRotation, toRotation;
+        from.decompose(fromPosition, fromRotation, fromScale);
+        to.decompose(toPosition, toRotation, toScale);
+        const glm::vec3 position = glm::mix(static_cast<glm::vec3>(fromPosition), static_cast<glm::vec3>(toPosition), alpha);
+        const glm::vec3 scale = glm::mix(static_cast<glm::vec3>(fromScale), static_cast<glm::vec3>(toScale), alpha);
+        const glm::quat rotation = glm::slerp(static_cast<glm::quat>(fromRotation), static_cast<glm::quat>(toRotation), alpha);
+        if(!std::isfinite(position.x) || !std::isfinite(scale.x) || !std::isfinite(rotation.w)){
+            return to;
+        }
+        return Math3D::Mat4(glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale));
+    }
     constexpr int kDeferredSsrLocalProbeSize = 256;
     const std::array<Math3D::Vec3, 6> kDeferredSsrLocalProbeDirs = {{
         Math3D::Vec3( 1.0f,  0.0f,  0.0f),
@@ -579,45 +616,8 @@ namespace {
         return true;
     }
 
-    void fillAabbCorners(const Math3D::Vec3& minV, const Math3D::Vec3& maxV, std::array<glm::vec3, 8>& outCorners){
-        outCorners[0] = glm::vec3(minV.x, minV.y, minV.z);
-        outCorners[1] = glm::vec3(maxV.x, minV.y, minV.z);
-        outCorners[2] = glm::vec3(minV.x, maxV.y, minV.z);
-        outCorners[3] = glm::vec3(maxV.x, maxV.y, minV.z);
-        outCorners[4] = glm::vec3(minV.x, minV.y, maxV.z);
-        outCorners[5] = glm::vec3(maxV.x, minV.y, maxV.z);
-        outCorners[6] = glm::vec3(minV.x, maxV.y, maxV.z);
-        outCorners[7] = glm::vec3(maxV.x, maxV.y, maxV.z);
-    }
-
     bool aabbIntersectsClipFrustum(const Math3D::Vec3& minV, const Math3D::Vec3& maxV, const Math3D::Mat4& clipMatrix){
-        std::array<glm::vec3, 8> corners;
-        fillAabbCorners(minV, maxV, corners);
-
-        const glm::mat4 m = static_cast<glm::mat4>(clipMatrix);
-
-        bool allLeft = true;
-        bool allRight = true;
-        bool allBottom = true;
-        bool allTop = true;
-        bool allNear = true;
-        bool allFar = true;
-
-        for(const glm::vec3& corner : corners){
-            const glm::vec4 clip = m * glm::vec4(corner, 1.0f);
-            if(!std::isfinite(clip.x) || !std::isfinite(clip.y) || !std::isfinite(clip.z) || !std::isfinite(clip.w)){
-                return true;
-            }
-
-            allLeft = allLeft && (clip.x < -clip.w);
-            allRight = allRight && (clip.x > clip.w);
-            allBottom = allBottom && (clip.y < -clip.w);
-            allTop = allTop && (clip.y > clip.w);
-            allNear = allNear && (clip.z < -clip.w);
-            allFar = allFar && (clip.z > clip.w);
-        }
-
-        return !(allLeft || allRight || allBottom || allTop || allNear || allFar);
+        return FrustumCulling::AabbIntersectsClip(minV, maxV, clipMatrix);
     }
 
     bool lightLikelyAffectsCamera(const Light& light, const PCamera& camera){
@@ -659,89 +659,6 @@ namespace {
         return intensityScore + rangeScore + distanceScore;
     }
 
-    bool projectAabbToTileRect(const Math3D::Vec3& minV,
-                               const Math3D::Vec3& maxV,
-                               const Math3D::Mat4& clipMatrix,
-                               int viewportWidth,
-                               int viewportHeight,
-                               int tileSize,
-                               int& outMinTileX,
-                               int& outMinTileY,
-                               int& outMaxTileX,
-                               int& outMaxTileY){
-        if(viewportWidth <= 0 || viewportHeight <= 0 || tileSize <= 0){
-            return false;
-        }
-        if(!aabbIntersectsClipFrustum(minV, maxV, clipMatrix)){
-            return false;
-        }
-
-        std::array<glm::vec3, 8> corners;
-        fillAabbCorners(minV, maxV, corners);
-
-        const glm::mat4 m = static_cast<glm::mat4>(clipMatrix);
-        float minNdcX = 1.0f;
-        float minNdcY = 1.0f;
-        float maxNdcX = -1.0f;
-        float maxNdcY = -1.0f;
-        bool anyValidCorner = false;
-        bool fallbackToFullscreen = false;
-
-        for(const glm::vec3& corner : corners){
-            const glm::vec4 clip = m * glm::vec4(corner, 1.0f);
-            if(!std::isfinite(clip.x) || !std::isfinite(clip.y) || !std::isfinite(clip.z) || !std::isfinite(clip.w)){
-                fallbackToFullscreen = true;
-                break;
-            }
-            if(clip.w <= 1e-5f){
-                fallbackToFullscreen = true;
-                break;
-            }
-
-            const glm::vec3 ndc = glm::vec3(clip) / clip.w;
-            minNdcX = std::min(minNdcX, ndc.x);
-            minNdcY = std::min(minNdcY, ndc.y);
-            maxNdcX = std::max(maxNdcX, ndc.x);
-            maxNdcY = std::max(maxNdcY, ndc.y);
-            anyValidCorner = true;
-        }
-
-        const int tilesX = Math3D::Max(1, (viewportWidth + tileSize - 1) / tileSize);
-        const int tilesY = Math3D::Max(1, (viewportHeight + tileSize - 1) / tileSize);
-        if(fallbackToFullscreen || !anyValidCorner){
-            outMinTileX = 0;
-            outMinTileY = 0;
-            outMaxTileX = tilesX - 1;
-            outMaxTileY = tilesY - 1;
-            return true;
-        }
-
-        if(maxNdcX < -1.0f || minNdcX > 1.0f || maxNdcY < -1.0f || minNdcY > 1.0f){
-            return false;
-        }
-
-        minNdcX = Math3D::Clamp(minNdcX, -1.0f, 1.0f);
-        minNdcY = Math3D::Clamp(minNdcY, -1.0f, 1.0f);
-        maxNdcX = Math3D::Clamp(maxNdcX, -1.0f, 1.0f);
-        maxNdcY = Math3D::Clamp(maxNdcY, -1.0f, 1.0f);
- 
-        
-        // Expand by one tile in pixel space so small camera movements don't cause
-        // lights to pop in/out of tiles at boundaries (reduces banding when camera
-        // position/look flickers between two values).
-        const float marginPx = static_cast<float>(tileSize);
-        const float minPx = std::max(0.0f, (minNdcX * 0.5f + 0.5f) * static_cast<float>(viewportWidth) - marginPx);
-        const float minPy = std::max(0.0f, (minNdcY * 0.5f + 0.5f) * static_cast<float>(viewportHeight) - marginPx);
-        const float maxPx = std::min(static_cast<float>(viewportWidth), (maxNdcX * 0.5f + 0.5f) * static_cast<float>(viewportWidth) + marginPx);
-        const float maxPy = std::min(static_cast<float>(viewportHeight), (maxNdcY * 0.5f + 0.5f) * static_cast<float>(viewportHeight) + marginPx);
-
-        outMinTileX = Math3D::Clamp(static_cast<int>(std::floor(minPx / static_cast<float>(tileSize))), 0, tilesX - 1);
-        outMinTileY = Math3D::Clamp(static_cast<int>(std::floor(minPy / static_cast<float>(tileSize))), 0, tilesY - 1);
-        outMaxTileX = Math3D::Clamp(static_cast<int>(std::floor(Math3D::Max(maxPx - 1.0f, 0.0f) / static_cast<float>(tileSize))), 0, tilesX - 1);
-        outMaxTileY = Math3D::Clamp(static_cast<int>(std::floor(Math3D::Max(maxPy - 1.0f, 0.0f) / static_cast<float>(tileSize))), 0, tilesY - 1);
-        return true;
-    }
-
     PostProcessingEffectEntry* findPostEffectEntry(PostProcessingStackComponent* stack, PostProcessingEffectKind kind){
         if(!stack){
             return nullptr;
@@ -977,6 +894,31 @@ namespace {
         outMax = Math3D::Vec3(maxV);
     }
 
+    // Read-only table lookup for snapshot workers; misses are queued for the serial merge.
+    template <typename T>
+    std::uint32_t findSnapshotResource(const RenderResourceTable<T>& table,
+                                       const std::shared_ptr<T>& resource,
+                                       std::vector<std::shared_ptr<T>>& pending){
+        const std::uint32_t index = table.find(resource.get());
+        if(index != RenderResourceTable<T>::kInvalidIndex){
+            return index;
+        }
+        pending.push_back(resource);
+        return kPendingResourceBit | static_cast<std::uint32_t>(pending.size() - 1);
+    }
+
+    // Turns a chunk index into a table index and marks it used by the current build.
+    template <typename T>
+    std::uint32_t resolveSnapshotResource(RenderResourceTable<T>& table,
+                                          const std::vector<std::shared_ptr<T>>& pending,
+                                          std::uint32_t index){
+        if(index & kPendingResourceBit){
+            return table.acquire(pending[index & ~kPendingResourceBit]);
+        }
+        table.touch(index);
+        return index;
+    }
+
     bool rayIntersectsAabb(const Math3D::Vec3& origin,
                            const Math3D::Vec3& direction,
                            const Math3D::Vec3& boundsMin,
@@ -1014,6 +956,79 @@ namespace {
         return true;
     }
 
+    bool rayIntersectsTriangle(const glm::vec3& origin,
+                               const glm::vec3& direction,
+                               const glm::vec3& v0,
+                               const glm::vec3& v1,
+                               const glm::vec3& v2,
+                               float& outDistance){
+        const glm::vec3 edge1 = v1 - v0;
+        const glm::vec3 edge2 = v2 - v0;
+        const glm::vec3 p = glm::cross(direction, edge2);
+        const float det = glm::dot(edge1, p);
+        if(std::abs(det) < 1e-12f){
+            return false;
+        }
+        const float invDet = 1.0f / det;
+        const glm::vec3 s = origin - v0;
+        const float u = glm::dot(s, p) * invDet;
+        if(u < 0.0f || u > 1.0f){
+            return false;
+        }
+        const glm::vec3 q = glm::cross(s, edge1);
+        const float v = glm::dot(direction, q) * invDet;
+        if(v < 0.0f || (u + v) > 1.0f){
+            return false;
+        }
+        const float t = glm::dot(edge2, q) * invDet;
+        if(t < 0.0f || !std::isfinite(t)){
+            return false;
+        }
+        outDistance = t;
+        return true;
+    }
+
+    // Two-sided test against every triangle; indexed meshes use faces, others consecutive vertex triples.
+    bool rayIntersectsMesh(Mesh& mesh,
+                           const glm::vec3& origin,
+                           const glm::vec3& direction,
+                           float maxDistance,
+                           float& outDistance){
+        const std::vector<Vertex>& vertices = mesh.getVertecies();
+        const std::vector<uint32_t>& faces = mesh.getFaces();
+        const size_t vertexCount = vertices.size();
+        const size_t indexCount = faces.empty() ? vertexCount : faces.size();
+
+        float nearest = maxDistance;
+        bool found = false;
+        for(size_t i = 0; i + 2 < indexCount; i += 3){
+            const size_t i0 = faces.empty() ? i : faces[i];
+            const size_t i1 = faces.empty() ? i + 1 : faces[i + 1];
+            const size_t i2 = faces.empty() ? i + 2 : faces[i + 2];
+            if(i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount){
+                continue;
+            }
+            float hitDistance = 0.0f;
+            if(rayIntersectsTriangle(origin,
+                                     direction,
+                                     static_cast<glm::vec3>(vertices[i0].Position),
+                                     static_cast<glm::vec3>(vertices[i1].Position),
+                                     static_cast<glm::vec3>(vertices[i2].Position),
+                                     hitDistance) &&
+               hitDistance < nearest){
+                nearest = hitDistance;
+                found = true;
+            }
+        }
+        if(found){
+            outDistance = nearest;
+        }
+        return found;
+    }
+
+    // Below this many draw items a linear SIMD sweep beats walking the BVH.
+    constexpr size_t kDrawItemBvhMinItems = 128;
+
 }
 
 Scene::Scene(RenderWindow* window) : View(window) {
@@ -1088,7 +1103,7 @@ NeoECS::GameObject* Scene::createModelGameObject(const std::string& name, const
 
     root->addComponent<TransformComponent>();
     if(auto* transform = root->getComponent<TransformComponent>()){
-        transform->local = model->transform();
+        transform->setLocal(model->transform());
     }
 
     root->addComponent<MeshRendererComponent>();
@@ -1117,7 +1132,7 @@ NeoECS::GameObject* Scene::createLightGameObject(const std::string& name, const
     root->addComponent<TransformComponent>();
     if(auto* transform = root->getComponent<TransformComponent>()){
         if(syncTransform){
-            transform->local.setPosition(light.position);
+            transform->editLocal().setPosition(light.position);
         }
     }
 
@@ -1315,61 +1330,40 @@ void Scene::dispose(){
 }
 
 Math3D::Mat4 Scene::buildWorldMatrix(NeoECS::ECSEntity* entity, NeoECS::ECSComponentManager* manager) const{
-    Math3D::Mat4 world(1.0f);
-    std::vector<NeoECS::ECSEntity*> chain;
-    for(auto* current = entity; current != nullptr; current = current->getParent()){
-        chain.push_back(current);
-    }
-    for(auto it = chain.rbegin(); it != chain.rend(); ++it){
-        auto* transform = manager->getECSComponent<TransformComponent>(*it);
-        if(transform){
-            world = world * transform->local.toMat4();
-        }
-    }
-    return world;
+    return TransformHierarchy::ResolveWorldMatrix(entity, manager);
 }
 
 void Scene::updateECS(float deltaTime){
     ensureAssetChangeListenerRegistered();
-    if(!ecsInstance) return;
+    if(!ecsInstance || ecsUpdatesSuspended) return;
     ecsInstance->update(deltaTime);
     refreshRenderState();
 }
 
-void Scene::refreshRenderState(){
-    ensureAssetChangeListenerRegistered();
-    if(!ecsInstance) return;
-    auto snapshotStart = std::chrono::steady_clock::now();
-
-    auto mainScreen = getMainScreen();
-    PCamera activeCamera = mainScreen ? mainScreen->getCamera() : nullptr;
-
-    const int backIndex = 1 - renderSnapshotIndex.load(std::memory_order_acquire);
-    auto& snapshot = renderSnapshots[backIndex];
-    snapshot.drawItems.clear();
-    snapshot.lights.clear();
+void Scene::buildSnapshotChunk(size_t begin, size_t end, const PCamera& activeCamera, SnapshotChunk& out) const{
+    out.drawItems.clear();
+    out.pendingMeshes.clear();
+    out.pendingMaterials.clear();
+    out.reflectionProbes.clear();
+    out.lights.clear();
+    out.entitiesMissingProperties.clear();
+    out.selectedLightIndex = -1;
+    out.firstEnabledCameraEntity = nullptr;
+    out.firstEnabledCamera = nullptr;
+    out.preferredEnabledCameraEntity = nullptr;
+    out.preferredEnabledCamera = nullptr;
+    out.activeCameraEntity = nullptr;
 
     auto* componentManager = ecsInstance->getComponentManager();
-    auto& entities = ecsInstance->getEntityManager()->getEntities();
-    snapshot.drawItems.reserve(entities.size());
-    snapshot.lights.reserve(entities.size());
-    NeoECS::ECSEntity* resolvedActiveCameraEntity = nullptr;
-    NeoECS::ECSEntity* firstEnabledCameraEntity = nullptr;
-    NeoECS::ECSEntity* preferredEnabledCameraEntity = nullptr;
-    PCamera firstEnabledCamera = nullptr;
-    PCamera preferredEnabledCamera = nullptr;
-    int resolvedSelectedLightIndex = -1;
-
-    for(const auto& entityPtr : entities){
-        auto* entity = entityPtr.get();
+    for(size_t entityIndex = begin; entityIndex < end; ++entityIndex){
+        auto* entity = snapshotEntities[entityIndex];
         if(!entity) continue;
 
+        // Adding components mutates the ECS, so missing properties are created on the
+        // calling thread after the chunks merge; their defaults match "absent" here.
         auto* entityProperties = componentManager->getECSComponent<EntityPropertiesComponent>(entity);
         if(!entityProperties){
-            std::unique_ptr<NeoECS::GameObject> wrapper(NeoECS::GameObject::CreateFromECSEntity(ecsInstance->getContext(), entity));
-            if(wrapper && wrapper->addComponent<EntityPropertiesComponent>()){
-                entityProperties = componentManager->getECSComponent<EntityPropertiesComponent>(entity);
-            }
+            out.entitiesMissingProperties.push_back(entity);
         }
 
         auto* transform = componentManager->getECSComponent<TransformComponent>(entity);
@@ -1398,6 +1392,9 @@ void Scene::refreshRenderState(){
         if(rendererActive && renderer && renderer->visible){
             Math3D::Mat4 base = world * renderer->localOffset.toMat4();
             bool cull = renderer->enableBackfaceCulling;
+            if(renderer->model){
+                cull = cull && renderer->model->isBackfaceCullingEnabled();
+            }
 
             bool hasOverrideBounds = false;
             Math3D::Vec3 overrideMin;
@@ -1409,59 +1406,58 @@ void Scene::refreshRenderState(){
                 hasOverrideBounds = true;
             }
 
+            std::uint8_t entityFlags = 0;
+            if(cull) entityFlags |= RenderItemFlag_BackfaceCulling;
+            if(renderer->planarReflectionSurface) entityFlags |= RenderItemFlag_PlanarReflectionSource;
+            if(entityPropertiesActive && entityProperties && entityProperties->ignoreRaycastHit){
+                entityFlags |= RenderItemFlag_IgnoreRaycastHit;
+            }
+            const std::uint32_t entityHandle = snapshotEntityHandles[entityIndex];
+
+            auto appendDrawItem = [&](const std::shared_ptr<Mesh>& mesh,
+                                      const std::shared_ptr<Material>& material,
+                                      const Math3D::Mat4& model){
+                std::uint8_t flags = entityFlags;
+                if(isMaterialTransparent(material)) flags |= RenderItemFlag_Transparent;
+                if(isDeferredCompatibleMaterial(material)) flags |= RenderItemFlag_DeferredCompatible;
+                if(material->castsShadows()) flags |= RenderItemFlag_CastsShadows;
+
+                Math3D::Vec3 itemBoundsMin(0.0f, 0.0f, 0.0f);
+                Math3D::Vec3 itemBoundsMax(0.0f, 0.0f, 0.0f);
+                if(hasOverrideBounds){
+                    flags |= RenderItemFlag_HasBounds;
+                    itemBoundsMin = overrideMin;
+                    itemBoundsMax = overrideMax;
+                }else if(mesh->getLocalBounds(localMin, localMax)){
+                    transformAabb(model, localMin, localMax, itemBoundsMin, itemBoundsMax);
+                    flags |= RenderItemFlag_HasBounds;
+                }
+
+                RenderItemArrays& items = out.drawItems;
+                items.models.push_back(model);
+                items.boundsMin.push_back(itemBoundsMin);
+                items.boundsMax.push_back(itemBoundsMax);
+                items.flags.push_back(flags);
+                items.meshIndices.push_back(findSnapshotResource(snapshotMeshes, mesh, out.pendingMeshes));
+                items.materialIndices.push_back(findSnapshotResource(snapshotMaterials, material, out.pendingMaterials));
+                items.entityHandles.push_back(entityHandle);
+            };
+
             if(renderer->model){
-                cull = cull && renderer->model->isBackfaceCullingEnabled();
                 const auto& parts = renderer->model->getParts();
                 for(const auto& part : parts){
                     if(!part || !part->visible || !part->mesh || !part->material) continue;
-                    RenderItem item;
-                    item.mesh = part->mesh;
-                    item.material = part->material;
-                    item.model = base * part->localTransform.toMat4();
-                    item.enableBackfaceCulling = cull;
-                    item.isTransparent = isMaterialTransparent(item.material);
-                    item.isDeferredCompatible = isDeferredCompatibleMaterial(item.material);
-                    item.planarReflectionSource = renderer->planarReflectionSurface;
-                    item.entityId = entity->getNodeUniqueID();
-                    item.ignoreRaycastHit = (entityPropertiesActive && entityProperties && entityProperties->ignoreRaycastHit);
-                    item.castsShadows = item.material->castsShadows();
-                    if(hasOverrideBounds){
-                        item.hasBounds = true;
-                        item.boundsMin = overrideMin;
-                        item.boundsMax = overrideMax;
-                    }else if(item.mesh->getLocalBounds(localMin, localMax)){
-                        transformAabb(item.model, localMin, localMax, item.boundsMin, item.boundsMax);
-                        item.hasBounds = true;
-                    }
-                    snapshot.drawItems.push_back(std::move(item));
+                    appendDrawItem(part->mesh, part->material, base * part->localTransform.toMat4());
                 }
             }else if(renderer->mesh && renderer->material){
-                RenderItem item;
-                item.mesh = renderer->mesh;
-                item.material = renderer->material;
-                item.model = base;
-                item.enableBackfaceCulling = cull;
-                item.isTransparent = isMaterialTransparent(item.material);
-                item.isDeferredCompatible = isDeferredCompatibleMaterial(item.material);
-                item.planarReflectionSource = renderer->planarReflectionSurface;
-                item.entityId = entity->getNodeUniqueID();
-                item.ignoreRaycastHit = (entityPropertiesActive && entityProperties && entityProperties->ignoreRaycastHit);
-                item.castsShadows = item.material->castsShadows();
-                if(hasOverrideBounds){
-                    item.hasBounds = true;
-                    item.boundsMin = overrideMin;
-                    item.boundsMax = overrideMax;
-                }else if(item.mesh->getLocalBounds(localMin, localMax)){
-                    transformAabb(item.model, localMin, localMax, item.boundsMin, item.boundsMax);
-                    item.hasBounds = true;
-                }
-                snapshot.drawItems.push_back(std::move(item));
+                appendDrawItem(renderer->mesh, renderer->material, base);
             }
         }
 
         if(reflectionProbeActive && reflectionProbeComponent && transform){
             ReflectionProbeSnapshot probe;
             probe.entityId = entity->getNodeUniqueID();
+            probe.entityHandle = snapshotEntityHandles[entityIndex];
             probe.resolution = Math3D::Clamp(reflectionProbeComponent->resolution, 64, 512);
             probe.priority = reflectionProbeComponent->priority;
             probe.autoUpdate = reflectionProbeComponent->autoUpdate;
@@ -1484,10 +1480,11 @@ void Scene::refreshRenderState(){
             probe.captureBoundsMax = probe.center + captureExtents;
             probe.influenceBoundsMin = probe.center - influenceExtents;
             probe.influenceBoundsMax = probe.center + influenceExtents;
-            snapshot.reflectionProbes.push_back(std::move(probe));
+            out.reflectionProbes.push_back(std::move(probe));
         }
 
         if(lightActive && lightComponent){
+            // Write-backs below only touch this entity's own component, so chunks never race.
             Light light = lightComponent->light;
             light.shadowDebugMode = Math3D::Clamp(light.shadowDebugMode, 0, 3);
             lightComponent->light.shadowDebugMode = light.shadowDebugMode;
@@ -1515,9 +1512,9 @@ void Scene::refreshRenderState(){
                 lightComponent->light.direction = light.direction;
             }
             if(entity->getNodeUniqueID() == selectedEntityId){
-                resolvedSelectedLightIndex = static_cast<int>(snapshot.lights.size());
+                out.selectedLightIndex = static_cast<int>(out.lights.size());
             }
-            snapshot.lights.push_back(light);
+            out.lights.push_back(light);
         }
 
         if(cameraComponent && cameraComponent->camera){
@@ -1525,20 +1522,127 @@ void Scene::refreshRenderState(){
                 cameraComponent->camera->setTransform(Math3D::Transform::fromMat4(world));
             }
             if(cameraActive){
-                if(!firstEnabledCamera){
-                    firstEnabledCamera = cameraComponent->camera;
-                    firstEnabledCameraEntity = entity;
+                if(!out.firstEnabledCamera){
+                    out.firstEnabledCamera = cameraComponent->camera;
+                    out.firstEnabledCameraEntity = entity;
                 }
                 if(preferredCamera && cameraComponent->camera == preferredCamera){
-                    preferredEnabledCamera = cameraComponent->camera;
-                    preferredEnabledCameraEntity = entity;
+                    out.preferredEnabledCamera = cameraComponent->camera;
+                    out.preferredEnabledCameraEntity = entity;
                 }
                 if(activeCamera && cameraComponent->camera == activeCamera){
-                    resolvedActiveCameraEntity = entity;
+                    out.activeCameraEntity = entity;
                 }
             }
         }
     }
+}
+
+void Scene::refreshRenderState(){
+    ensureAssetChangeListenerRegistered();
+    if(!ecsInstance) return;
+    auto snapshotStart = std::chrono::steady_clock::now();
+
+    auto mainScreen = getMainScreen();
+    PCamera activeCamera = mainScreen ? mainScreen->getCamera() : nullptr;
+
+    // The write slot belongs to this thread until publish(); the renderer never reads it.
+    auto& snapshot = renderSnapshots[renderSnapshotRing.writeIndex()];
+    snapshot.drawItems.clear();
+    snapshot.reflectionProbes.clear();
+    snapshot.lights.clear();
+
+    auto* componentManager = ecsInstance->getComponentManager();
+    auto& entities = ecsInstance->getEntityManager()->getEntities();
+
+    // Bring every cached world matrix up to date once, parents first, so the
+    // per-entity lookups below only read clean caches.
+    transformHierarchy.update(ecsInstance->getEntityManager(), componentManager);
+
+    snapshotMeshes.beginBuild();
+    snapshotMaterials.beginBuild();
+    snapshotEntityHandleTable.beginBuild();
+
+    snapshotEntities.clear();
+    snapshotEntityHandles.clear();
+    snapshotEntities.reserve(entities.size());
+    snapshotEntityHandles.reserve(entities.size());
+    for(const auto& entityPtr : entities){
+        snapshotEntities.push_back(entityPtr.get());
+        snapshotEntityHandles.push_back(snapshotEntityHandleTable.acquire(entityPtr.get()));
+    }
+    snapshotEntityHandleTable.releaseUnseen();
+
+    // Chunks are built on the worker pool into per-chunk buffers and merged in chunk
+    // order, so the resulting snapshot matches a serial walk of the entity list.
+    const size_t chunkCount = WorkerPool::ChunkCount(snapshotEntities.size(), kSnapshotEntitiesPerChunk);
+    if(snapshotChunks.size() < chunkCount){
+        snapshotChunks.resize(chunkCount);
+    }
+    WorkerPool::Instance().parallelFor(
+        snapshotEntities.size(),
+        kSnapshotEntitiesPerChunk,
+        [&](size_t chunkIndex, size_t begin, size_t end){
+            buildSnapshotChunk(begin, end, activeCamera, snapshotChunks[chunkIndex]);
+        }
+    );
+
+    size_t totalDrawItems = 0;
+    size_t totalLights = 0;
+    size_t totalProbes = 0;
+    for(size_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex){
+        totalDrawItems += snapshotChunks[chunkIndex].drawItems.size();
+        totalLights += snapshotChunks[chunkIndex].lights.size();
+        totalProbes += snapshotChunks[chunkIndex].reflectionProbes.size();
+    }
+    snapshot.drawItems.reserve(totalDrawItems);
+    snapshot.lights.reserve(totalLights);
+    snapshot.reflectionProbes.reserve(totalProbes);
+
+    NeoECS::ECSEntity* resolvedActiveCameraEntity = nullptr;
+    NeoECS::ECSEntity* firstEnabledCameraEntity = nullptr;
+    NeoECS::ECSEntity* preferredEnabledCameraEntity = nullptr;
+    PCamera firstEnabledCamera = nullptr;
+    PCamera preferredEnabledCamera = nullptr;
+    int resolvedSelectedLightIndex = -1;
+
+    for(size_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex){
+        SnapshotChunk& chunk = snapshotChunks[chunkIndex];
+        if(chunk.selectedLightIndex >= 0){
+            resolvedSelectedLightIndex = static_cast<int>(snapshot.lights.size()) + chunk.selectedLightIndex;
+        }
+        // Later chunks overwrite preferred/active matches and only the first enabled
+        // camera sticks, mirroring what the serial loop resolved.
+        if(!firstEnabledCamera && chunk.firstEnabledCamera){
+            firstEnabledCamera = chunk.firstEnabledCamera;
+            firstEnabledCameraEntity = chunk.firstEnabledCameraEntity;
+        }
+        if(chunk.preferredEnabledCamera){
+            preferredEnabledCamera = chunk.preferredEnabledCamera;
+            preferredEnabledCameraEntity = chunk.preferredEnabledCameraEntity;
+        }
+        if(chunk.activeCameraEntity){
+            resolvedActiveCameraEntity = chunk.activeCameraEntity;
+        }
+
+        RenderItemArrays& chunkItems = chunk.drawItems;
+        for(size_t i = 0; i < chunkItems.size(); ++i){
+            chunkItems.meshIndices[i] = resolveSnapshotResource(snapshotMeshes, chunk.pendingMeshes, chunkItems.meshIndices[i]);
+            chunkItems.materialIndices[i] = resolveSnapshotResource(snapshotMaterials, chunk.pendingMaterials, chunkItems.materialIndices[i]);
+        }
+        snapshot.drawItems.append(chunkItems);
+        chunk.pendingMeshes.clear();
+        chunk.pendingMaterials.clear();
+        std::move(chunk.reflectionProbes.begin(), chunk.reflectionProbes.end(), std::back_inserter(snapshot.reflectionProbes));
+        snapshot.lights.insert(snapshot.lights.end(), chunk.lights.begin(), chunk.lights.end());
+
+        for(auto* entity : chunk.entitiesMissingProperties){
+            std::unique_ptr<NeoECS::GameObject> wrapper(NeoECS::GameObject::CreateFromECSEntity(ecsInstance->getContext(), entity));
+            if(wrapper){
+                wrapper->addComponent<EntityPropertiesComponent>();
+            }
+        }
+    }
 
     NeoECS::ECSEntity* resolvedCameraEntity = nullptr;
     PCamera resolvedCamera = nullptr;
@@ -1559,16 +1663,169 @@ void Scene::refreshRenderState(){
         mainScreen->setCamera(resolvedCamera);
     }
 
+    // Anything untouched by this build and the previous one is not referenced by a snapshot the renderer can acquire.
+    snapshotMeshes.releaseUnused(kSnapshotResourceKeepBuilds);
+    snapshotMaterials.releaseUnused(kSnapshotResourceKeepBuilds);
+
     updateActiveCameraEffects(resolvedCameraEntity, componentManager);
     selectedLightUploadIndex = resolvedSelectedLightIndex;
 
-    renderSnapshotIndex.store(backIndex, std::memory_order_release);
+    snapshot.revision = ++renderSnapshotRevision;
+    snapshot.publishTime = std::chrono::steady_clock::now();
+    const size_t drawCount = snapshot.drawItems.size();
+    const size_t lightCount = snapshot.lights.size();
+    renderSnapshotRing.publish();
 
     auto snapshotEnd = std::chrono::steady_clock::now();
     std::chrono::duration<float, std::milli> snapshotMs = snapshotEnd - snapshotStart;
     debugStats.snapshotMs.store(snapshotMs.count(), std::memory_order_relaxed);
-    debugStats.drawCount.store(static_cast<int>(snapshot.drawItems.size()), std::memory_order_relaxed);
-    debugStats.lightCount.store(static_cast<int>(snapshot.lights.size()), std::memory_order_relaxed);
+    debugStats.snapshotChunkCount.store(static_cast<int>(chunkCount), std::memory_order_relaxed);
+    debugStats.drawCount.store(static_cast<int>(drawCount), std::memory_order_relaxed);
+    debugStats.lightCount.store(static_cast<int>(lightCount), std::memory_order_relaxed);
+    debugStats.worldMatrixUpdateCount.store(static_cast<int>(transformHierarchy.getLastRecomputedCount()), std::memory_order_relaxed);
+}
+
+void Scene::acquireRenderSnapshot(){
+    renderSnapshotRing.acquire();
+    const size_t currentIndex = renderSnapshotRing.readIndex(0);
+    if(currentIndex == RenderSnapshotRing::INVALID_INDEX){
+        return;
+    }
+
+    const size_t previousIndex = renderSnapshotRing.readIndex(1);
+    const RenderSnapshot& current = renderSnapshots[currentIndex];
+    float alpha = 1.0f;
+    if(previousIndex != RenderSnapshotRing::INVALID_INDEX && !shouldTickOnRenderThread()){
+        const RenderSnapshot& previous = renderSnapshots[previousIndex];
+        const float interval = std::chrono::duration<float>(current.publishTime - previous.publishTime).count();
+        if(interval > 0.0001f && interval <= kSnapshotInterpolationMaxInterval){
+            const float sinceCurrent = std::chrono::duration<float>(std::chrono::steady_clock::now() - current.publishTime).count();
+            alpha = Math3D::Clamp(sinceCurrent / interval, 0.0f, 1.0f);
+        }
+    }
+    if(alpha >= 1.0f){
+        renderSnapshotIndex.store(static_cast<int>(currentIndex), std::memory_order_release);
+        return;
+    }
+
+    // Render one tick behind, blending each item that persisted between the two snapshots.
+    const RenderSnapshot& previous = renderSnapshots[previousIndex];
+    RenderSnapshot& presented = renderSnapshots[kPresentedSnapshotSlot];
+    presented.drawItems = current.drawItems;
+    presented.reflectionProbes = current.reflectionProbes;
+    presented.lights = current.lights;
+    presented.publishTime = current.publishTime;
+    presented.revision = kPresentedRevisionBit | ++presentedSnapshotRevision;
+
+    const RenderItemArrays& from = previous.drawItems;
+    RenderItemArrays& to = presented.drawItems;
+    const size_t matchCount = std::min(from.size(), to.size());
+    for(size_t i = 0; i < matchCount; ++i){
+        if(from.entityHandles[i] != to.entityHandles[i] || from.meshIndices[i] != to.meshIndices[i]){
+            continue;
+        }
+        to.models[i] = interpolateModelMatrix(from.models[i], to.models[i], alpha);
+        if((from.flags[i] & RenderItemFlag_HasBounds) && (to.flags[i] & RenderItemFlag_HasBounds)){
+            // The union of both boxes covers every blended pose, so culling stays conservative.
+            to.boundsMin[i] = Math3D::Vec3(glm::min(static_cast<glm::vec3>(from.boundsMin[i]), static_cast<glm::vec3>(to.boundsMin[i])));
+            to.boundsMax[i] = Math3D::Vec3(glm::max(static_cast<glm::vec3>(from.boundsMax[i]), static_cast<glm::vec3>(to.boundsMax[i])));
+        }
+    }
+    renderSnapshotIndex.store(static_cast<int>(kPresentedSnapshotSlot), std::memory_order_release);
+}
+
+const std::vector<std::uint32_t>& Scene::getVisibleDrawItems(const Math3D::Mat4& clipMatrix){
+    const int frontIndex = renderSnapshotIndex.load(std::memory_order_acquire);
+    const auto& snapshot = renderSnapshots[frontIndex];
+    const glm::mat4 clip = static_cast<glm::mat4>(clipMatrix);
+    for(auto& cache : visibleItemCaches){
+        if(cache.snapshotRevision == snapshot.revision && static_cast<glm::mat4>(cache.clipMatrix) == clip){
+            return cache.indices;
+        }
+    }
+
+    VisibleItemCache& cache = visibleItemCaches[nextVisibleItemCache];
+    nextVisibleItemCache = (nextVisibleItemCache + 1) % visibleItemCaches.size();
+    cache.snapshotRevision = snapshot.revision;
+    cache.clipMatrix = clipMatrix;
+    cache.indices.clear();
+    const auto& items = snapshot.drawItems;
+    if(items.size() >= kDrawItemBvhMinItems){
+        getDrawItemBvh().queryFrustum(clipMatrix, cache.indices);
+        return cache.indices;
+    }
+    FrustumCulling::CullAabbs(
+        items.boundsMin.data(),
+        items.boundsMax.data(),
+        items.flags.data(),
+        RenderItemFlag_HasBounds,
+        items.size(),
+        clipMatrix,
+        cache.indices
+    );
+    return cache.indices;
+}
+
+const BoundsBVH& Scene::getDrawItemBvh() const{
+    const int frontIndex = renderSnapshotIndex.load(std::memory_order_acquire);
+    const auto& snapshot = renderSnapshots[frontIndex];
+    if(drawItemBvhRevision != snapshot.revision){
+        const auto& items = snapshot.drawItems;
+        drawItemBvh.update(
+            items.boundsMin.data(),
+            items.boundsMax.data(),
+            items.flags.data(),
+            RenderItemFlag_HasBounds,
+            items.size()
+        );
+        drawItemBvhRevision = snapshot.revision;
+    }
+    return drawItemBvh;
+}
+
+bool Scene::raycastDrawItems(const Math3D::Vec3& origin,
+                             const Math3D::Vec3& direction,
+                             float maxDistance,
+                             bool includeIgnoredItems,
+                             DrawItemRayHit& outHit) const{
+    const BoundsBVH& bvh = getDrawItemBvh();
+    const int frontIndex = renderSnapshotIndex.load(std::memory_order_acquire);
+    const auto& items = renderSnapshots[frontIndex].drawItems;
+    bvh.queryRay(origin, direction, maxDistance, rayCandidateScratch);
+
+    float nearestDistance = maxDistance;
+    std::uint32_t nearestHandle = RenderEntityHandleTable::kInvalidHandle;
+    for(const auto& candidate : rayCandidateScratch){
+        if(candidate.entryDistance > nearestDistance){
+            break;
+        }
+        const size_t i = candidate.index;
+        if(!includeIgnoredItems && (items.flags[i] & RenderItemFlag_IgnoreRaycastHit)){
+            continue;
+        }
+        Mesh* mesh = snapshotMeshes.get(items.meshIndices[i]);
+        if(!mesh){
+            continue;
+        }
+
+        // Test in mesh space. The direction is mapped without renormalizing, so hit distances stay in world units.
+        const glm::mat4 inverseModel = glm::inverse(static_cast<glm::mat4>(items.models[i]));
+        const glm::vec3 localOrigin = glm::vec3(inverseModel * glm::vec4(origin.x, origin.y, origin.z, 1.0f));
+        const glm::vec3 localDirection = glm::vec3(inverseModel * glm::vec4(direction.x, direction.y, direction.z, 0.0f));
+        float hitDistance = 0.0f;
+        if(rayIntersectsMesh(*mesh, localOrigin, localDirection, nearestDistance, hitDistance)){
+            nearestDistance = hitDistance;
+            nearestHandle = items.entityHandles[i];
+        }
+    }
+
+    const std::string& entityId = snapshotEntityHandleTable.getId(nearestHandle);
+    if(entityId.empty()){
+        return false;
+    }
+    outHit.entityId = entityId;
+    outHit.distance = nearestDistance;
+    return true;
 }
 
 void Scene::renderViewportContents(){
@@ -1743,27 +2000,30 @@ bool Scene::computeAdaptiveFocusDistanceFromSnapshot(NeoECS::ECSEntity* cameraEn
     }
     up = up.normalize();
 
-    const std::string cameraId = cameraEntity ? cameraEntity->getNodeUniqueID() : std::string();
+    const std::uint32_t cameraHandle = cameraEntity
+        ? snapshotEntityHandleTable.findById(cameraEntity->getNodeUniqueID())
+        : RenderEntityHandleTable::kInvalidHandle;
+    const BoundsBVH& drawItemTree = getDrawItemBvh();
     const int frontIndex = renderSnapshotIndex.load(std::memory_order_acquire);
-    const auto& snapshot = renderSnapshots[frontIndex];
+    const auto& items = renderSnapshots[frontIndex].drawItems;
     auto findNearestHitDistance = [&](const Math3D::Vec3& rayOrigin,
                                       const Math3D::Vec3& rayDirection,
                                       float& outHitDistance) -> bool {
         float nearestDistance = FLT_MAX;
         bool found = false;
-        for(const auto& item : snapshot.drawItems){
-            if(!item.hasBounds){
+        drawItemTree.queryRay(rayOrigin, rayDirection, FLT_MAX, rayCandidateScratch);
+        for(const auto& candidate : rayCandidateScratch){
+            const size_t i = candidate.index;
+            const std::uint8_t flags = items.flags[i];
+            if(flags & RenderItemFlag_IgnoreRaycastHit){
                 continue;
             }
-            if(item.ignoreRaycastHit){
-                continue;
-            }
-            if(!cameraId.empty() && item.entityId == cameraId){
+            if(cameraHandle != RenderEntityHandleTable::kInvalidHandle && items.entityHandles[i] == cameraHandle){
                 continue;
             }
 
             float hitDistance = 0.0f;
-            if(rayIntersectsAabb(rayOrigin, rayDirection, item.boundsMin, item.boundsMax, hitDistance) &&
+            if(rayIntersectsAabb(rayOrigin, rayDirection, items.boundsMin[i], items.boundsMax[i], hitDistance) &&
                hitDistance >= 0.01f &&
                hitDistance < nearestDistance){
                 nearestDistance = hitDistance;
@@ -2212,9 +2472,16 @@ void Scene::ensureDeferredResources(PScreen screen){
         auto vertexShader = AssetManager::Instance.getOrLoad("@assets/shader/Shader_Vert_Default.vert");
         auto fragmentShader = AssetManager::Instance.getOrLoad("@assets/shader/Shader_Frag_DeferredLight.frag");
         if(vertexShader && fragmentShader){
-            deferredLightShader = ShaderCacheManager::INSTANCE.getOrCompile("DeferredLightPass_v8", vertexShader->asString(), fragmentShader->asString());
+            deferredLightVariants = std::make_shared<ShaderVariantSet>(
+                "DeferredLightPass_v8",
+                vertexShader->asString(),
+                fragmentShader->asString(),
+                std::vector<std::string>(std::begin(kDeferredLightKeywords), std::end(kDeferredLightKeywords))
+            );
+            deferredLightShader = deferredLightVariants->getBaseProgram();
             if(deferredLightShader && deferredLightShader->getID() == 0){
                 LogBot.Log(LOG_ERRO, "Failed to link DeferredLightPass shader: \n%s", deferredLightShader->getLog().c_str());
+                deferredLightVariants.reset();
             }
         }else{
             LogBot.Log(LOG_ERRO, "DeferredLightPass shader assets missing.");
@@ -2232,123 +2499,6 @@ void Scene::ensureDeferredResources(PScreen screen){
     }
 }
 
-void Scene::ensureDeferredLightTileResources(int width, int height){
-    GLint maxTextureSize = 16384;
-    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
-    if(maxTextureSize <= 0){
-        maxTextureSize = 16384;
-    }
-
-    int tileSize = kDeferredLightTileSize;
-    int tilesX = Math3D::Max(1, (width + tileSize - 1) / tileSize);
-    int tilesY = Math3D::Max(1, (height + tileSize - 1) / tileSize);
-    int tileCount = tilesX * tilesY;
-    while(tileCount > maxTextureSize && tileSize < 256){
-        tileSize += kDeferredLightTileSize;
-        tilesX = Math3D::Max(1, (width + tileSize - 1) / tileSize);
-        tilesY = Math3D::Max(1, (height + tileSize - 1) / tileSize);
-        tileCount = tilesX * tilesY;
-    }
-
-    const int tileStride = MAX_LIGHTS + 1;
-
-    if(!deferredLightTileTexture ||
-       deferredLightTileGridWidth != tilesX ||
-       deferredLightTileGridHeight != tilesY ||
-       deferredLightTileTexture->getWidth() != tileStride ||
-       deferredLightTileTexture->getHeight() != tileCount){
-        deferredLightTileTexture = Texture::CreateRenderTarget(tileStride, tileCount, GL_R32I, GL_RED_INTEGER, GL_INT);
-        deferredLightTileGridWidth = tilesX;
-        deferredLightTileGridHeight = tilesY;
-        deferredLightTileSize = tileSize;
-    }else{
-        deferredLightTileSize = tileSize;
-    }
-
-    deferredLightTileCpuData.assign(static_cast<size_t>(tileCount) * tileStride, -1);
-    for(int tileIndex = 0; tileIndex < tileCount; ++tileIndex){
-        deferredLightTileCpuData[static_cast<size_t>(tileIndex) * tileStride] = 0;
-    }
-}
-
-bool Scene::buildDeferredLightTiles(PCamera cam, const std::vector<Light>& lights){
-    if(!cam || gBufferWidth <= 0 || gBufferHeight <= 0){
-        return false;
-    }
-
-    ensureDeferredLightTileResources(gBufferWidth, gBufferHeight);
-    if(!deferredLightTileTexture || deferredLightTileTexture->getID() == 0 || deferredLightTileCpuData.empty()){
-        return false;
-    }
-
-    const int tilesX = deferredLightTileGridWidth;
-    const int tilesY = deferredLightTileGridHeight;
-    const int tileStride = MAX_LIGHTS + 1;
-    const Math3D::Mat4 clipMatrix = cam->getProjectionMatrix() * cam->getViewMatrix();
-
-    for(size_t lightIndex = 0; lightIndex < lights.size() && lightIndex < MAX_LIGHTS; ++lightIndex){
-        const Light& light = lights[lightIndex];
-        int minTileX = 0;
-        int minTileY = 0;
-        int maxTileX = tilesX - 1;
-        int maxTileY = tilesY - 1;
-
-        if(light.type != LightType::DIRECTIONAL){
-            float influenceRange = Math3D::Max(light.range, 0.1f);
-            if(light.shadowRange > 0.0f){
-                influenceRange = Math3D::Max(influenceRange, light.shadowRange);
-            }
-
-            const Math3D::Vec3 extent(influenceRange, influenceRange, influenceRange);
-            if(!projectAabbToTileRect(
-                light.position - extent,
-                light.position + extent,
-                clipMatrix,
-                gBufferWidth,
-                gBufferHeight,
-                deferredLightTileSize,
-                minTileX,
-                minTileY,
-                maxTileX,
-                maxTileY
-            )){
-                continue;
-            }
-        }
-
-        for(int tileY = minTileY; tileY <= maxTileY; ++tileY){
-            for(int tileX = minTileX; tileX <= maxTileX; ++tileX){
-                const int tileIndex = tileX + (tileY * tilesX);
-                int& lightCount = deferredLightTileCpuData[static_cast<size_t>(tileIndex) * tileStride];
-                if(lightCount < 0){
-                    lightCount = 0;
-                }
-                if(lightCount >= MAX_LIGHTS){
-                    continue;
-                }
-                const size_t writeIndex = (static_cast<size_t>(tileIndex) * tileStride) + 1 + static_cast<size_t>(lightCount);
-                deferredLightTileCpuData[writeIndex] = static_cast<int>(lightIndex);
-                ++lightCount;
-            }
-        }
-    }
-
-    glBindTexture(GL_TEXTURE_2D, deferredLightTileTexture->getID());
-    glTexSubImage2D(
-        GL_TEXTURE_2D,
-        0,
-        0,
-        0,
-        deferredLightTileTexture->getWidth(),
-        deferredLightTileTexture->getHeight(),
-        GL_RED_INTEGER,
-        GL_INT,
-        deferredLightTileCpuData.data()
-    );
-    glBindTexture(GL_TEXTURE_2D, 0);
-    return true;
-}
-
 void Scene::clearLocalReflectionProbe(){
     deferredLocalReflectionProbe.valid = false;
     deferredLocalReflectionProbe.anchorEntityId.clear();
@@ -2428,7 +2578,7 @@ bool Scene::ensureLocalReflectionProbeResources(int faceSize){
 
 void Scene::clearPlanarReflection(){
     activePlanarReflection.valid = false;
-    activePlanarReflection.entityId.clear();
+    activePlanarReflection.entityHandle = RenderEntityHandleTable::kInvalidHandle;
     activePlanarReflection.center = Math3D::Vec3(0.0f, 0.0f, 0.0f);
     activePlanarReflection.normal = Math3D::Vec3(0.0f, 1.0f, 0.0f);
     activePlanarReflection.viewProjection = Math3D::Mat4();
@@ -2481,28 +2631,28 @@ bool Scene::updatePlanarReflection(PScreen screen, PCamera cam){
     }
 
     const int frontIndex = renderSnapshotIndex.load(std::memory_order_acquire);
-    const auto& snapshot = renderSnapshots[frontIndex];
+    const auto& items = renderSnapshots[frontIndex].drawItems;
     const Math3D::Mat4 viewMatrix = cam->getViewMatrix();
     const Math3D::Mat4 projectionMatrix = cam->getProjectionMatrix();
     const Math3D::Mat4 clipMatrix = projectionMatrix * viewMatrix;
     const Math3D::Vec3 cameraPosition = cam->transform().position;
 
-    const RenderItem* bestItem = nullptr;
+    size_t bestItem = items.size();
     Math3D::Vec3 bestCenter;
     Math3D::Vec3 bestNormal = Math3D::Vec3(0.0f, 1.0f, 0.0f);
     float bestReflectivity = 1.0f;
     float bestReceiverFadeDistance = 1.0f;
     float bestScore = -1.0f;
-    auto resolvePlanarReflectionSurface = [&](const RenderItem& item,
+    auto resolvePlanarReflectionSurface = [&](size_t item,
                                               Math3D::Vec3& outCenter,
                                               Math3D::Vec3& outNormal,
                                               float& outReceiverFadeDistance) -> bool {
-        if(!item.hasBounds){
+        if(!(items.flags[item] & RenderItemFlag_HasBounds)){
             return false;
         }
 
-        outCenter = (item.boundsMin + item.boundsMax) * 0.5f;
-        Math3D::Vec3 worldExtents = item.boundsMax - item.boundsMin;
+        outCenter = (items.boundsMin[item] + items.boundsMax[item]) * 0.5f;
+        Math3D::Vec3 worldExtents = items.boundsMax[item] - items.boundsMin[item];
         Math3D::Vec3 worldNormal = Math3D::Vec3::up();
         float dominantExtent = Math3D::Max(
             Math3D::Max(worldExtents.x, worldExtents.y),
@@ -2511,7 +2661,7 @@ bool Scene::updatePlanarReflection(PScreen screen, PCamera cam){
 
         Math3D::Vec3 localMin;
         Math3D::Vec3 localMax;
-        if(item.mesh && item.mesh->getLocalBounds(localMin, localMax)){
+        if(snapshotMeshes.get(items.meshIndices[item])->getLocalBounds(localMin, localMax)){
             const Math3D::Vec3 localExtents = localMax - localMin;
             dominantExtent = Math3D::Max(
                 dominantExtent,
@@ -2530,7 +2680,7 @@ bool Scene::updatePlanarReflection(PScreen screen, PCamera cam){
                     localNormal = Math3D::Vec3::forward();
                     break;
             }
-            worldNormal = transformDirection(item.model, localNormal);
+            worldNormal = transformDirection(items.models[item], localNormal);
         }else{
             switch(findSmallestExtentAxis(worldExtents)){
                 case 0:
@@ -2551,8 +2701,9 @@ bool Scene::updatePlanarReflection(PScreen screen, PCamera cam){
         return true;
     };
 
-    for(const auto& item : snapshot.drawItems){
-        if(!item.mesh || !item.material || !item.planarReflectionSource || !item.hasBounds){
+    for(size_t item = 0; item < items.size(); ++item){
+        const std::uint8_t requiredFlags = RenderItemFlag_PlanarReflectionSource | RenderItemFlag_HasBounds;
+        if((items.flags[item] & requiredFlags) != requiredFlags){
             continue;
         }
 
@@ -2563,7 +2714,7 @@ bool Scene::updatePlanarReflection(PScreen screen, PCamera cam){
             continue;
         }
 
-        const Math3D::Vec3 worldExtents = item.boundsMax - item.boundsMin;
+        const Math3D::Vec3 worldExtents = items.boundsMax[item] - items.boundsMin[item];
         if(Math3D::Max(Math3D::Max(worldExtents.x, worldExtents.y), worldExtents.z) <= 0.10f){
             continue;
         }
@@ -2592,7 +2743,7 @@ bool Scene::updatePlanarReflection(PScreen screen, PCamera cam){
         }
 
         const float centerWeight = Math3D::Clamp(1.0f - (screenDistance / 1.75f), 0.0f, 1.0f);
-        const float projectedRadius = Math3D::Clamp(((item.boundsMax - item.boundsMin).length() * 0.5f / distanceToCenter) * 6.0f, 0.10f, 2.50f);
+        const float projectedRadius = Math3D::Clamp(((items.boundsMax[item] - items.boundsMin[item]).length() * 0.5f / distanceToCenter) * 6.0f, 0.10f, 2.50f);
         const float score =
             (0.25f + (0.75f * facingWeight)) *
             projectedRadius *
@@ -2601,22 +2752,22 @@ bool Scene::updatePlanarReflection(PScreen screen, PCamera cam){
             continue;
         }
 
-        bestItem = &item;
+        bestItem = item;
         bestCenter = center;
         bestNormal = worldNormal;
         bestReceiverFadeDistance = receiverFadeDistance;
         bestReflectivity = 1.0f;
-        if(auto pbr = Material::GetAs<PBRMaterial>(item.material)){
+        if(auto pbr = Material::GetAs<PBRMaterial>(snapshotMaterials.getShared(items.materialIndices[item]))){
             bestReflectivity = Math3D::Max(1.0f, computePlanarReflectivityScore(pbr));
         }
         bestScore = score;
     }
 
-    if(!bestItem || !activePlanarReflection.buffer || !activePlanarReflection.buffer->getTexture()){
+    if(bestItem >= items.size() || !activePlanarReflection.buffer || !activePlanarReflection.buffer->getTexture()){
         return false;
     }
 
-    activePlanarReflection.entityId = bestItem->entityId;
+    activePlanarReflection.entityHandle = items.entityHandles[bestItem];
     activePlanarReflection.center = bestCenter;
     activePlanarReflection.normal = bestNormal;
     activePlanarReflection.strength = Math3D::Clamp(0.75f + (bestReflectivity * 0.18f), 0.85f, 1.35f);
@@ -2695,7 +2846,7 @@ bool Scene::updatePlanarReflection(PScreen screen, PCamera cam){
         Math3D::Max(reflectionCamera->getSettings().nearPlane * 0.35f, 0.01f)
     );
     glEnable(GL_CLIP_DISTANCE0);
-    drawModels3D(reflectionCamera, RenderFilter::Opaque, false, &activePlanarReflection.entityId);
+    drawModels3D(reflectionCamera, RenderFilter::Opaque, false, activePlanarReflection.entityHandle);
     userClipPlaneActive = false;
     if(!wasClipDistance0){
         glDisable(GL_CLIP_DISTANCE0);
@@ -2781,7 +2932,7 @@ bool Scene::updateLocalReflectionProbe(PScreen screen, PCamera cam){
         return Math3D::Vec3::distance(a, b) <= 0.01f;
     };
 
-    auto captureProbeFaces = [&](const std::string* excludedEntityId) -> bool {
+    auto captureProbeFaces = [&](std::uint32_t excludedEntityHandle) -> bool {
         const Math3D::Vec3 captureExtent = (probe.captureBoundsMax - probe.captureBoundsMin) * 0.5f;
         const float captureRadius = captureExtent.length();
         const float nearPlane = Math3D::Clamp(captureRadius * 0.035f, 0.03f, 0.30f);
@@ -2857,7 +3008,7 @@ bool Scene::updateLocalReflectionProbe(PScreen screen, PCamera cam){
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
             drawSkybox(faceCamera, true);
-            drawModels3D(faceCamera, RenderFilter::Opaque, false, excludedEntityId);
+            drawModels3D(faceCamera, RenderFilter::Opaque, false, excludedEntityHandle);
         }
 
         localReflectionProbeCaptureActive = false;
@@ -2896,14 +3047,14 @@ bool Scene::updateLocalReflectionProbe(PScreen screen, PCamera cam){
         return true;
     }
 
-    const std::string* excludedEntityId = probe.anchorEntityId.empty() ? nullptr : &probe.anchorEntityId;
-    return captureProbeFaces(excludedEntityId);
+    return captureProbeFaces(bestProbe->entityHandle);
 }
 
 Scene::~Scene(){
     clearPlanarReflection();
     activePlanarReflection.buffer.reset();
     releaseLocalReflectionProbeResources();
+    drawInstanceBatch.dispose();
     if(assetChangeListenerHandle >= 0){
         AssetManager::Instance.removeChangeListener(assetChangeListenerHandle);
         assetChangeListenerHandle = -1;
@@ -2965,7 +3116,7 @@ void Scene::ensureOutlineResources(PScreen screen){
     }
 }
 
-void Scene::drawDeferredGeometry(PCamera cam, const std::string* excludedEntityId){
+void Scene::drawDeferredGeometry(PCamera cam, std::uint32_t excludedEntityHandle){
     if(!cam || !gBuffer || !gBufferShader || gBufferShader->getID() == 0) return;
 
     gBuffer->bind();
@@ -2987,41 +3138,29 @@ void Scene::drawDeferredGeometry(PCamera cam, const std::string* excludedEntityI
     gBufferShader->setUniformFast("u_time", Uniform<float>(shaderTimeSeconds));
 
     const int frontIndex = renderSnapshotIndex.load(std::memory_order_acquire);
-    const auto& snapshot = renderSnapshots[frontIndex];
-    std::vector<const RenderItem*> deferredItems;
-    deferredItems.reserve(snapshot.drawItems.size());
-    for(const auto& item : snapshot.drawItems){
-        if(!item.mesh || !item.material) continue;
-        if(excludedEntityId && !excludedEntityId->empty() && item.entityId == *excludedEntityId) continue;
-        if(item.isTransparent) continue;
-        if(!item.isDeferredCompatible) continue;
-        if(item.hasBounds && !aabbIntersectsClipFrustum(item.boundsMin, item.boundsMax, clipMatrix)) continue;
-        deferredItems.push_back(&item);
-    }
-    std::sort(deferredItems.begin(), deferredItems.end(), [](const RenderItem* a, const RenderItem* b){
-        if(a->enableBackfaceCulling != b->enableBackfaceCulling){
-            return a->enableBackfaceCulling > b->enableBackfaceCulling;
-        }
-        auto shaderA = a->material ? a->material->getShader().get() : nullptr;
-        auto shaderB = b->material ? b->material->getShader().get() : nullptr;
-        if(shaderA != shaderB){
-            return shaderA < shaderB;
-        }
-        if(a->material.get() != b->material.get()){
-            return a->material.get() < b->material.get();
-        }
-        return a->mesh.get() < b->mesh.get();
-    });
+    const auto& items = renderSnapshots[frontIndex].drawItems;
+    std::vector<std::uint32_t>& deferredItems = visibleItemScratch;
+    deferredItems.clear();
+    deferredItems.reserve(items.size());
+    for(std::uint32_t i : getVisibleDrawItems(clipMatrix)){
+        const std::uint8_t flags = items.flags[i];
+        if(excludedEntityHandle != RenderEntityHandleTable::kInvalidHandle && items.entityHandles[i] == excludedEntityHandle) continue;
+        if(flags & RenderItemFlag_Transparent) continue;
+        if(!(flags & RenderItemFlag_DeferredCompatible)) continue;
+        deferredItems.push_back(i);
+    }
+    sortDrawItems(items, deferredItems, DrawKeys::Pass::Deferred, viewMatrix, cam->getSettings().farPlane, gBufferShader);
+    const std::vector<DrawRun>& runs = buildDrawRuns(items, deferredItems, gBufferShader);
+    const GLint modelLocation = gBufferShader->getUniformLocation("u_model");
     std::shared_ptr<Material> lastMaterial = nullptr;
     bool cullStateKnown = false;
     bool cullEnabled = true;
 
-    for(const RenderItem* itemPtr : deferredItems){
-        if(!itemPtr) continue;
-        const auto& item = *itemPtr;
-
-        if(!cullStateKnown || cullEnabled != item.enableBackfaceCulling){
-            if(item.enableBackfaceCulling){
+    for(const DrawRun& run : runs){
+        const std::uint32_t item = deferredItems[run.begin];
+        const bool itemCull = (items.flags[item] & RenderItemFlag_BackfaceCulling) != 0;
+        if(!cullStateKnown || cullEnabled != itemCull){
+            if(itemCull){
                 glEnable(GL_CULL_FACE);
                 glCullFace(GL_BACK);
                 cullEnabled = true;
@@ -3030,12 +3169,11 @@ void Scene::drawDeferredGeometry(PCamera cam, const std::string* excludedEntityI
                 cullEnabled = false;
             }
             cullStateKnown = true;
+            cullChangeCounter++;
         }
 
-        gBufferShader->setUniformFast("u_model", Uniform<Math3D::Mat4>(item.model));
-
-        if(item.material != lastMaterial){
-            const auto& material = item.material;
+        const auto& material = snapshotMaterials.getShared(items.materialIndices[item]);
+        if(material != lastMaterial){
             Math3D::Vec4 baseColor = Color::WHITE;
             PTexture baseColorTex = nullptr;
             int useBaseColorTex = 0;
@@ -3199,9 +3337,21 @@ void Scene::drawDeferredGeometry(PCamera cam, const std::string* excludedEntityI
             gBufferShader->setUniformFast("u_bsdfModel", Uniform<int>(bsdfModel));
             gBufferShader->setUniformFast("u_surfaceMode", Uniform<int>(surfaceMode));
             lastMaterial = material;
+            materialChangeCounter++;
         }
 
-        item.mesh->draw();
+        Mesh* mesh = snapshotMeshes.get(items.meshIndices[item]);
+        if(run.instanced){
+            gBufferShader->setUniformFast(modelLocation, Uniform<Math3D::Mat4>(Math3D::Mat4()));
+            drawInstanceBatch.draw(*mesh, run.firstInstance, run.count);
+            drawCallCounter++;
+            continue;
+        }
+        for(size_t k = run.begin; k < run.begin + run.count; ++k){
+            gBufferShader->setUniformFast(modelLocation, Uniform<Math3D::Mat4>(items.models[deferredItems[k]]));
+            mesh->draw();
+            drawCallCounter++;
+        }
     }
 
     glEnable(GL_CULL_FACE);
@@ -3228,87 +3378,89 @@ void Scene::drawDeferredLighting(PFrameBuffer targetBuffer,
     glDisable(GL_CULL_FACE);
     glDepthMask(GL_FALSE);
 
-    deferredLightShader->bind();
+    auto env = Screen::GetCurrentEnvironment();
+    EnvironmentSettings environmentSettings;
+    if(env){
+        environmentSettings = env->getSettings();
+    }
+    PCubeMap envMap = (env && env->getSkyBox()) ? env->getSkyBox()->getCubeMap() : nullptr;
+    const bool useLocalProbe =
+        deferredLocalReflectionProbe.valid &&
+        deferredLocalReflectionProbe.cubeMap &&
+        deferredLocalReflectionProbe.cubeMap->getID() != 0;
+    PTexture ssaoRawTex = ssaoPass ? ssaoPass->getRawAoTexture() : nullptr;
+    PTexture ssaoBlurTex = ssaoPass ? ssaoPass->getBlurAoTexture() : nullptr;
+    int useSsao = (ssaoRawTex && ssaoBlurTex) ? 1 : 0;
+
+    // Pick the permutation with the disabled features compiled out; the plain program stays the fallback.
+    std::shared_ptr<ShaderProgram> lightShader = deferredLightShader;
+    if(deferredLightVariants){
+        std::uint32_t keywordMask = 0;
+        if(envMap) keywordMask |= kDeferredLightKeyword_EnvMap;
+        if(useLocalProbe) keywordMask |= kDeferredLightKeyword_LocalProbe;
+        if(environmentSettings.fogEnabled) keywordMask |= kDeferredLightKeyword_Fog;
+        if(useSsao) keywordMask |= kDeferredLightKeyword_Ssao;
+        if(giTexture) keywordMask |= kDeferredLightKeyword_Gi;
+        lightShader = deferredLightVariants->getVariant(keywordMask);
+    }
+    lightShader->bind();
 
     const Math3D::Mat4 viewMatrix = cam->getViewMatrix();
     const Math3D::Mat4 projectionMatrix = cam->getProjectionMatrix();
     const Math3D::Mat4 inverseProjectionMatrix = Math3D::Mat4(glm::inverse(glm::mat4(projectionMatrix)));
     const Math3D::Mat4 inverseViewMatrix = Math3D::Mat4(glm::inverse(glm::mat4(viewMatrix)));
     const int ssaoDebugView = (lightPassMode == 0 && ssaoSettings) ? Math3D::Clamp(ssaoSettings->debugView, 0, 4) : 0;
-    deferredLightShader->setUniformFast("u_viewPos", Uniform<Math3D::Vec3>(cam->transform().position));
-    deferredLightShader->setUniformFast("u_cameraView", Uniform<Math3D::Mat4>(viewMatrix));
-    deferredLightShader->setUniformFast("u_invProjection", Uniform<Math3D::Mat4>(inverseProjectionMatrix));
-    deferredLightShader->setUniformFast("u_invView", Uniform<Math3D::Mat4>(inverseViewMatrix));
-    deferredLightShader->setUniformFast("gAlbedo", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getGBufferTexture(0), 0)));
-    deferredLightShader->setUniformFast("gNormal", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getGBufferTexture(1), 1)));
-    deferredLightShader->setUniformFast("gMaterial", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getGBufferTexture(2), 2)));
+    lightShader->setUniformFast("u_viewPos", Uniform<Math3D::Vec3>(cam->transform().position));
+    lightShader->setUniformFast("u_cameraView", Uniform<Math3D::Mat4>(viewMatrix));
+    lightShader->setUniformFast("u_invProjection", Uniform<Math3D::Mat4>(inverseProjectionMatrix));
+    lightShader->setUniformFast("u_invView", Uniform<Math3D::Mat4>(inverseViewMatrix));
+    lightShader->setUniformFast("gAlbedo", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getGBufferTexture(0), 0)));
+    lightShader->setUniformFast("gNormal", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getGBufferTexture(1), 1)));
+    lightShader->setUniformFast("gMaterial", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getGBufferTexture(2), 2)));
     // Use a dedicated slot for gSurface. It must not alias u_envMap or shadow samplers.
-    deferredLightShader->setUniformFast("gSurface", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getGBufferTexture(3), 8)));
-    deferredLightShader->setUniformFast("gDepth", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getDepthTexture(), 3)));
-    deferredLightShader->setUniformFast("gTileLightData", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(deferredLightTileTexture, 4)));
-    PTexture ssaoRawTex = ssaoPass ? ssaoPass->getRawAoTexture() : nullptr;
-    PTexture ssaoBlurTex = ssaoPass ? ssaoPass->getBlurAoTexture() : nullptr;
-    int useSsao = (ssaoRawTex && ssaoBlurTex) ? 1 : 0;
+    lightShader->setUniformFast("gSurface", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getGBufferTexture(3), 8)));
+    lightShader->setUniformFast("gDepth", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(gBuffer->getDepthTexture(), 3)));
     PTexture sharedAuxTexture = giTexture;
     if(!sharedAuxTexture || ssaoDebugView == 2){
         sharedAuxTexture = ssaoRawTex;
     }
-    deferredLightShader->setUniformFast("gSsaoRaw", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(sharedAuxTexture, 6)));
-    deferredLightShader->setUniformFast("gSsao", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(ssaoBlurTex, 5)));
-    deferredLightShader->setUniformFast("gGi", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(sharedAuxTexture, 6)));
-    deferredLightShader->setUniformFast("u_useSsao", Uniform<int>(useSsao));
-    deferredLightShader->setUniformFast("u_ssaoIntensity", Uniform<float>(ssaoSettings ? Math3D::Clamp(ssaoSettings->intensity, 0.0f, 10.0f) : 0.0f));
-    deferredLightShader->setUniformFast("u_useGi", Uniform<int>(giTexture ? 1 : 0));
-    deferredLightShader->setUniformFast("u_ssaoDebugView", Uniform<int>(ssaoDebugView));
-    deferredLightShader->setUniformFast("u_lightPassMode", Uniform<int>(lightPassMode));
-    // Tile-light culling can introduce visible screen-space boundaries on broad surfaces
-    // when light bounds projection misses edge tiles. Keep visual output stable by
-    // using the full light list in shading until tiled culling is reworked.
-    deferredLightShader->setUniformFast("u_useLightTiles", Uniform<int>(0));
-    deferredLightShader->setUniformFast("u_tileGrid", Uniform<Math3D::Vec2>(Math3D::Vec2(
-        static_cast<float>(deferredLightTileGridWidth),
-        static_cast<float>(deferredLightTileGridHeight)
-    )));
-    deferredLightShader->setUniformFast("u_tileSize", Uniform<int>(deferredLightTileSize));
-
-    auto env = Screen::GetCurrentEnvironment();
-    EnvironmentSettings environmentSettings;
-    if(env){
-        environmentSettings = env->getSettings();
-    }
-    PCubeMap envMap = (env && env->getSkyBox()) ? env->getSkyBox()->getCubeMap() : nullptr;
-    const bool useLocalProbe =
-        deferredLocalReflectionProbe.valid &&
-        deferredLocalReflectionProbe.cubeMap &&
-        deferredLocalReflectionProbe.cubeMap->getID() != 0;
-    deferredLightShader->setUniformFast("u_useEnvMap", Uniform<int>(envMap ? 1 : 0));
-    deferredLightShader->setUniformFast("u_envMap", Uniform<GLUniformUpload::CubeMapSlot>(GLUniformUpload::CubeMapSlot(envMap, 7)));
-    deferredLightShader->setUniformFast("u_useLocalProbe", Uniform<int>(useLocalProbe ? 1 : 0));
-    deferredLightShader->setUniformFast("u_localProbe", Uniform<GLUniformUpload::CubeMapSlot>(GLUniformUpload::CubeMapSlot(
+    lightShader->setUniformFast("gSsaoRaw", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(sharedAuxTexture, 6)));
+    lightShader->setUniformFast("gSsao", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(ssaoBlurTex, 5)));
+    lightShader->setUniformFast("gGi", Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(sharedAuxTexture, 6)));
+    lightShader->setUniformFast("u_useSsao", Uniform<int>(useSsao));
+    lightShader->setUniformFast("u_ssaoIntensity", Uniform<float>(ssaoSettings ? Math3D::Clamp(ssaoSettings->intensity, 0.0f, 10.0f) : 0.0f));
+    lightShader->setUniformFast("u_useGi", Uniform<int>(giTexture ? 1 : 0));
+    lightShader->setUniformFast("u_ssaoDebugView", Uniform<int>(ssaoDebugView));
+    lightShader->setUniformFast("u_lightPassMode", Uniform<int>(lightPassMode));
+
+    lightShader->setUniformFast("u_useEnvMap", Uniform<int>(envMap ? 1 : 0));
+    lightShader->setUniformFast("u_envMap", Uniform<GLUniformUpload::CubeMapSlot>(GLUniformUpload::CubeMapSlot(envMap, 7)));
+    lightShader->setUniformFast("u_useLocalProbe", Uniform<int>(useLocalProbe ? 1 : 0));
+    lightShader->setUniformFast("u_localProbe", Uniform<GLUniformUpload::CubeMapSlot>(GLUniformUpload::CubeMapSlot(
         useLocalProbe ? deferredLocalReflectionProbe.cubeMap : nullptr,
         9
     )));
-    deferredLightShader->setUniformFast("u_localProbeCenter", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.center));
-    deferredLightShader->setUniformFast("u_localProbeCaptureMin", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.captureBoundsMin));
-    deferredLightShader->setUniformFast("u_localProbeCaptureMax", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.captureBoundsMax));
-    deferredLightShader->setUniformFast("u_localProbeInfluenceMin", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.influenceBoundsMin));
-    deferredLightShader->setUniformFast("u_localProbeInfluenceMax", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.influenceBoundsMax));
-    deferredLightShader->setUniformFast("u_ambientColor", Uniform<Math3D::Vec4>(environmentSettings.ambientColor));
-    deferredLightShader->setUniformFast("u_ambientIntensity", Uniform<float>(environmentSettings.ambientIntensity));
-    deferredLightShader->setUniformFast("u_fogEnabled", Uniform<int>(environmentSettings.fogEnabled ? 1 : 0));
-    deferredLightShader->setUniformFast("u_fogColor", Uniform<Math3D::Vec4>(environmentSettings.fogColor));
-    deferredLightShader->setUniformFast("u_fogStart", Uniform<float>(environmentSettings.fogStart));
-    deferredLightShader->setUniformFast("u_fogStop", Uniform<float>(environmentSettings.fogStop));
-    deferredLightShader->setUniformFast("u_fogEnd", Uniform<float>(environmentSettings.fogEnd));
+    lightShader->setUniformFast("u_localProbeCenter", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.center));
+    lightShader->setUniformFast("u_localProbeCaptureMin", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.captureBoundsMin));
+    lightShader->setUniformFast("u_localProbeCaptureMax", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.captureBoundsMax));
+    lightShader->setUniformFast("u_localProbeInfluenceMin", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.influenceBoundsMin));
+    lightShader->setUniformFast("u_localProbeInfluenceMax", Uniform<Math3D::Vec3>(deferredLocalReflectionProbe.influenceBoundsMax));
+    lightShader->setUniformFast("u_ambientColor", Uniform<Math3D::Vec4>(environmentSettings.ambientColor));
+    lightShader->setUniformFast("u_ambientIntensity", Uniform<float>(environmentSettings.ambientIntensity));
+    lightShader->setUniformFast("u_fogEnabled", Uniform<int>(environmentSettings.fogEnabled ? 1 : 0));
+    lightShader->setUniformFast("u_fogColor", Uniform<Math3D::Vec4>(environmentSettings.fogColor));
+    lightShader->setUniformFast("u_fogStart", Uniform<float>(environmentSettings.fogStart));
+    lightShader->setUniformFast("u_fogStop", Uniform<float>(environmentSettings.fogStop));
+    lightShader->setUniformFast("u_fogEnd", Uniform<float>(environmentSettings.fogEnd));
     static const std::vector<Light> EMPTY_LIGHTS;
     const std::vector<Light>& lights = (env && env->isLightingEnabled()) ? env->getLightsForUpload() : EMPTY_LIGHTS;
-    LightUniformUploader::UploadLights(deferredLightShader, lights);
-    ShadowRenderer::BindShadowSamplers(deferredLightShader);
+    LightUniformUploader::UploadLights(lightShader, lights);
+    ShadowRenderer::BindShadowSamplers(lightShader);
 
     static const Math3D::Mat4 IDENTITY;
-    deferredLightShader->setUniformFast("u_model", Uniform<Math3D::Mat4>(IDENTITY));
-    deferredLightShader->setUniformFast("u_view", Uniform<Math3D::Mat4>(IDENTITY));
-    deferredLightShader->setUniformFast("u_projection", Uniform<Math3D::Mat4>(IDENTITY));
+    lightShader->setUniformFast("u_model", Uniform<Math3D::Mat4>(IDENTITY));
+    lightShader->setUniformFast("u_view", Uniform<Math3D::Mat4>(IDENTITY));
+    lightShader->setUniformFast("u_projection", Uniform<Math3D::Mat4>(IDENTITY));
 
     deferredQuad->draw(IDENTITY, IDENTITY, IDENTITY);
 }
@@ -3369,16 +3521,16 @@ void Scene::drawOutlines(PScreen screen, PCamera cam){
     bool drewMask = false;
     bool cullStateKnown = false;
     bool cullEnabled = true;
-    for(const auto& item : snapshot.drawItems){
-        if(!item.mesh || !item.material){
-            continue;
-        }
-        if(item.entityId != selectedEntityId){
+    const auto& items = snapshot.drawItems;
+    const std::uint32_t selectedHandle = snapshotEntityHandleTable.findById(selectedEntityId);
+    for(size_t i = 0; i < items.size(); ++i){
+        if(selectedHandle == RenderEntityHandleTable::kInvalidHandle || items.entityHandles[i] != selectedHandle){
             continue;
         }
 
-        if(!cullStateKnown || cullEnabled != item.enableBackfaceCulling){
-            if(item.enableBackfaceCulling){
+        const bool itemCull = (items.flags[i] & RenderItemFlag_BackfaceCulling) != 0;
+        if(!cullStateKnown || cullEnabled != itemCull){
+            if(itemCull){
                 glEnable(GL_CULL_FACE);
                 glCullFace(GL_BACK);
                 cullEnabled = true;
@@ -3389,8 +3541,8 @@ void Scene::drawOutlines(PScreen screen, PCamera cam){
             cullStateKnown = true;
         }
 
-        outlineMaskShader->setUniformFast("u_model", Uniform<Math3D::Mat4>(item.model));
-        item.mesh->draw();
+        outlineMaskShader->setUniformFast("u_model", Uniform<Math3D::Mat4>(items.models[i]));
+        snapshotMeshes.get(items.meshIndices[i])->draw();
         drewMask = true;
     }
 
@@ -3503,11 +3655,11 @@ void Scene::renderDeferred(PScreen screen, PCamera cam){
         }
     };
 
-    const std::string* deferredExcludedEntityId =
-        (activePlanarReflection.valid && !activePlanarReflection.entityId.empty())
-            ? &activePlanarReflection.entityId
-            : nullptr;
-    drawDeferredGeometry(cam, deferredExcludedEntityId);
+    const std::uint32_t deferredExcludedEntityHandle =
+        activePlanarReflection.valid
+            ? activePlanarReflection.entityHandle
+            : RenderEntityHandleTable::kInvalidHandle;
+    drawDeferredGeometry(cam, deferredExcludedEntityHandle);
     checkGlError("geometry pass");
     if(deferredDisabled){
         drawSkybox(cam);
@@ -3616,9 +3768,6 @@ void Scene::renderDeferred(PScreen screen, PCamera cam){
     PTexture giTexture = nullptr;
     auto env = screen ? screen->getEnvironment() : nullptr;
     PCubeMap giEnvMap = (env && env->getSkyBox()) ? env->getSkyBox()->getCubeMap() : nullptr;
-    static const std::vector<Light> EMPTY_LIGHTS;
-    const std::vector<Light>& uploadedLights = (env && env->isLightingEnabled()) ? env->getLightsForUpload() : EMPTY_LIGHTS;
-    buildDeferredLightTiles(cam, uploadedLights);
     const Math3D::Mat4 inverseViewMatrix = Math3D::Mat4(glm::inverse(glm::mat4(cam->getViewMatrix())));
     if(useSsao &&
        deferredQuad &&
@@ -3940,6 +4089,12 @@ void Scene::render3DPass(){
     auto screen = getMainScreen();
     if(!screen) return;
 
+    acquireRenderSnapshot();
+    const std::uint64_t uniformUploadsStart = GLUniformUpload::UploadCounter();
+    drawCallCounter = 0;
+    shaderChangeCounter = 0;
+    materialChangeCounter = 0;
+    cullChangeCounter = 0;
     screen->bind();
 
     updateSceneLights();
@@ -3958,20 +4113,26 @@ void Scene::render3DPass(){
         }
 
         const int frontIndex = renderSnapshotIndex.load(std::memory_order_acquire);
-        const auto& snapshot = renderSnapshots[frontIndex];
+        const auto& items = renderSnapshots[frontIndex].drawItems;
         std::vector<ShadowCasterBounds> casterBounds;
-        casterBounds.reserve(snapshot.drawItems.size());
-        for(const auto& item : snapshot.drawItems){
-            if(item.castsShadows && item.hasBounds){
+        casterBounds.reserve(items.size());
+        const std::uint8_t casterFlags = RenderItemFlag_CastsShadows | RenderItemFlag_HasBounds;
+        for(size_t i = 0; i < items.size(); ++i){
+            if((items.flags[i] & casterFlags) == casterFlags){
                 ShadowCasterBounds bounds;
-                bounds.min = item.boundsMin;
-                bounds.max = item.boundsMax;
+                bounds.min = items.boundsMin[i];
+                bounds.max = items.boundsMax[i];
                 casterBounds.push_back(bounds);
             }
         }
 
         ShadowRenderer::BeginFrame(cam, &casterBounds);
 
+        auto env = screen->getEnvironment();
+        static const std::vector<Light> EMPTY_LIGHTS;
+        const std::vector<Light>& uploadedLights = (env && env->isLightingEnabled()) ? env->getLightsForUpload() : EMPTY_LIGHTS;
+        LightUniformUploader::BuildClusters(cam, screen->getWidth(), screen->getHeight(), uploadedLights);
+
         auto shadowStart = std::chrono::steady_clock::now();
         drawShadowsPass();
         auto shadowEnd = std::chrono::steady_clock::now();
@@ -3999,13 +4160,110 @@ void Scene::render3DPass(){
     screen->unbind();
     debugStats.postFxMs.store(screen->getLastPostProcessMs(), std::memory_order_relaxed);
     debugStats.postFxEffectCount.store(screen->getLastPostProcessEffectCount(), std::memory_order_relaxed);
+    debugStats.uniformUploadCount.store(
+        static_cast<int>(GLUniformUpload::UploadCounter() - uniformUploadsStart),
+        std::memory_order_relaxed
+    );
+    debugStats.drawCallCount.store(drawCallCounter, std::memory_order_relaxed);
+    debugStats.shaderChangeCount.store(shaderChangeCounter, std::memory_order_relaxed);
+    debugStats.materialChangeCount.store(materialChangeCounter, std::memory_order_relaxed);
+    debugStats.cullChangeCount.store(cullChangeCounter, std::memory_order_relaxed);
+    debugStats.shadowStateChangeCount.store(ShadowRenderer::GetPassStats().stateChanges, std::memory_order_relaxed);
+}
+
+void Scene::sortDrawItems(const RenderItemArrays& items,
+                          std::vector<std::uint32_t>& order,
+                          DrawKeys::Pass pass,
+                          const Math3D::Mat4& viewMatrix,
+                          float farPlane,
+                          const std::shared_ptr<ShaderProgram>& programOverride){
+    std::vector<DrawKeys::Entry>& keys = drawKeyScratch;
+    keys.clear();
+    keys.reserve(order.size());
+    const glm::mat4 view = static_cast<glm::mat4>(viewMatrix);
+    for(std::uint32_t item : order){
+        const std::uint8_t flags = items.flags[item];
+        Math3D::Vec3 center = items.models[item].getPosition();
+        if(flags & RenderItemFlag_HasBounds){
+            center = (items.boundsMin[item] + items.boundsMax[item]) * 0.5f;
+        }
+        const glm::vec4 viewCenter = view * static_cast<glm::vec4>(Math3D::Vec4(center, 1.0f));
+        const std::uint16_t depth = DrawKeys::QuantizeDepth(-viewCenter.z, farPlane);
+        const bool cull = (flags & RenderItemFlag_BackfaceCulling) != 0;
+
+        DrawKeys::Entry entry;
+        entry.item = item;
+        if(pass == DrawKeys::Pass::Transparent){
+            entry.key = DrawKeys::MakeTransparentKey(cull, items.materialIndices[item], items.meshIndices[item], depth);
+        }else{
+            std::uint32_t shaderId = 0;
+            if(!programOverride){
+                // Key on the permutation this pass draws with, not the one the previous pass left.
+                Material* material = snapshotMaterials.get(items.materialIndices[item]);
+                material->selectPassVariant();
+                auto shader = material->getShader();
+                shaderId = shader ? shader->getID() : 0;
+            }
+            entry.key = DrawKeys::MakeStateKey(pass, cull, shaderId, items.materialIndices[item], items.meshIndices[item], depth);
+        }
+        keys.push_back(entry);
+    }
+
+    DrawKeys::RadixSort(keys, drawKeySortScratch);
+    for(size_t i = 0; i < keys.size(); ++i){
+        order[i] = keys[i].item;
+    }
+}
+
+const std::vector<Scene::DrawRun>& Scene::buildDrawRuns(const RenderItemArrays& items,
+                                                        const std::vector<std::uint32_t>& order,
+                                                        const std::shared_ptr<ShaderProgram>& programOverride){
+    std::vector<DrawRun>& runs = drawRunScratch;
+    runs.clear();
+    drawInstanceBatch.begin();
+
+    const std::uint8_t cullFlag = RenderItemFlag_BackfaceCulling;
+    for(size_t i = 0; i < order.size();){
+        const std::uint32_t first = order[i];
+        size_t end = i + 1;
+        while(end < order.size() &&
+              items.meshIndices[order[end]] == items.meshIndices[first] &&
+              items.materialIndices[order[end]] == items.materialIndices[first] &&
+              (items.flags[order[end]] & cullFlag) == (items.flags[first] & cullFlag)){
+            ++end;
+        }
+
+        DrawRun run;
+        run.begin = i;
+        run.count = end - i;
+        if(run.count >= InstanceBatch::MIN_INSTANCES){
+            std::shared_ptr<ShaderProgram> program = programOverride;
+            if(!program){
+                Material* material = snapshotMaterials.get(items.materialIndices[first]);
+                material->selectPassVariant();
+                program = material->getShader();
+            }
+            if(InstanceBatch::SupportsInstancing(program)){
+                run.instanced = true;
+                run.firstInstance = drawInstanceBatch.size();
+                for(size_t k = i; k < end; ++k){
+                    drawInstanceBatch.add(items.models[order[k]]);
+                }
+            }
+        }
+        runs.push_back(run);
+        i = end;
+    }
+
+    drawInstanceBatch.upload();
+    return runs;
 }
 
-void Scene::drawModels3D(PCamera cam, RenderFilter filter, bool skipDeferredCompatible, const std::string* excludedEntityId){
+void Scene::drawModels3D(PCamera cam, RenderFilter filter, bool skipDeferredCompatible, std::uint32_t excludedEntityHandle){
     if(!cam) return;
 
     const int frontIndex = renderSnapshotIndex.load(std::memory_order_acquire);
-    const auto& snapshot = renderSnapshots[frontIndex];
+    const auto& items = renderSnapshots[frontIndex].drawItems;
     const Math3D::Mat4 viewMatrix = cam->getViewMatrix();
     const Math3D::Mat4 projectionMatrix = cam->getProjectionMatrix();
     const Math3D::Mat4 inverseProjectionMatrix = Math3D::Mat4(glm::inverse(glm::mat4(projectionMatrix)));
@@ -4025,14 +4283,6 @@ void Scene::drawModels3D(PCamera cam, RenderFilter filter, bool skipDeferredComp
     const bool useTransparentSsr = hasTransparentSceneColor && transparentSsrSettings.enabled;
     PTexture transparentSsrColor = hasTransparentSceneColor ? transparentSsrSourceBuffer->getTexture() : nullptr;
     PTexture transparentSceneDepth = hasTransparentSceneDepth ? gBuffer->getDepthTexture() : nullptr;
-    const float transparentSsrIntensity = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.intensity, 0.0f, 4.0f) : 0.0f;
-    const float transparentSsrMaxDistance = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.maxDistance, 0.5f, 2500.0f) : 0.0f;
-    const float transparentSsrThickness = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.thickness, 0.005f, 4.0f) : 0.18f;
-    const float transparentSsrStride = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.stride, 0.1f, 8.0f) : 0.75f;
-    const float transparentSsrJitter = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.jitter, 0.0f, 1.0f) : 0.35f;
-    const int transparentSsrMaxSteps = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.maxSteps, 8, 256) : 56;
-    const float transparentSsrRoughnessCutoff = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.roughnessCutoff, 0.05f, 1.0f) : 0.05f;
-    const float transparentSsrEdgeFade = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.edgeFade, 0.001f, 0.5f) : 0.001f;
     const bool hasPlanarReflection =
         activePlanarReflection.valid &&
         activePlanarReflection.buffer &&
@@ -4042,57 +4292,79 @@ void Scene::drawModels3D(PCamera cam, RenderFilter filter, bool skipDeferredComp
         deferredLocalReflectionProbe.valid &&
         deferredLocalReflectionProbe.cubeMap &&
         deferredLocalReflectionProbe.cubeMap->getID() != 0;
-    static const Math3D::Mat4 IDENTITY;
-    std::vector<const RenderItem*> drawItems;
-    drawItems.reserve(snapshot.drawItems.size());
-    for(const auto& item : snapshot.drawItems){
-        if(!item.mesh || !item.material) continue;
-        if(excludedEntityId && !excludedEntityId->empty() && item.entityId == *excludedEntityId) continue;
-        if(filter == RenderFilter::Opaque && item.isTransparent) continue;
-        if(filter == RenderFilter::Transparent && !item.isTransparent) continue;
-        const bool isPlanarReflectorItem = hasPlanarReflection && item.entityId == activePlanarReflection.entityId;
-        if(skipDeferredCompatible && item.isDeferredCompatible && !isPlanarReflectorItem) continue;
-        if(item.hasBounds && !aabbIntersectsClipFrustum(item.boundsMin, item.boundsMax, clipMatrix)) continue;
-        drawItems.push_back(&item);
-    }
-    if(filter == RenderFilter::Transparent){
-        std::sort(drawItems.begin(), drawItems.end(), [&](const RenderItem* a, const RenderItem* b){
-            Math3D::Vec3 centerA = a->model.getPosition();
-            Math3D::Vec3 centerB = b->model.getPosition();
-            if(a->hasBounds){
-                centerA = (a->boundsMin + a->boundsMax) * 0.5f;
-            }
-            if(b->hasBounds){
-                centerB = (b->boundsMin + b->boundsMax) * 0.5f;
-            }
+    PTexture planarReflectionTexture = hasPlanarReflection ? activePlanarReflection.buffer->getTexture() : nullptr;
+    PCubeMap localProbeCubeMap = hasLocalReflectionProbe ? deferredLocalReflectionProbe.cubeMap : nullptr;
+
+    // Everything below is constant for the pass, so it goes into PassBlock once instead of
+    // being set by name on every draw.
+    PassUniformState passState;
+    passState.invProjection = inverseProjectionMatrix;
+    passState.useSceneColor = hasTransparentSceneColor;
+    passState.useSceneDepth = hasTransparentSceneDepth;
+    passState.useSsr = useTransparentSsr;
+    passState.ssrIntensity = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.intensity, 0.0f, 4.0f) : 0.0f;
+    passState.ssrMaxDistance = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.maxDistance, 0.5f, 2500.0f) : 0.0f;
+    passState.ssrThickness = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.thickness, 0.005f, 4.0f) : 0.18f;
+    passState.ssrStride = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.stride, 0.1f, 8.0f) : 0.75f;
+    passState.ssrJitter = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.jitter, 0.0f, 1.0f) : 0.35f;
+    passState.ssrMaxSteps = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.maxSteps, 8, 256) : 56;
+    passState.ssrRoughnessCutoff = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.roughnessCutoff, 0.05f, 1.0f) : 0.05f;
+    passState.ssrEdgeFade = useTransparentSsr ? Math3D::Clamp(transparentSsrSettings.edgeFade, 0.001f, 0.5f) : 0.001f;
+    if(hasLocalReflectionProbe){
+        passState.useLocalProbe = true;
+        passState.localProbeCenter = deferredLocalReflectionProbe.center;
+        passState.localProbeCaptureMin = deferredLocalReflectionProbe.captureBoundsMin;
+        passState.localProbeCaptureMax = deferredLocalReflectionProbe.captureBoundsMax;
+        passState.localProbeInfluenceMin = deferredLocalReflectionProbe.influenceBoundsMin;
+        passState.localProbeInfluenceMax = deferredLocalReflectionProbe.influenceBoundsMax;
+    }
+    if(hasPlanarReflection){
+        passState.usePlanarReflection = true;
+        passState.planarReflectionMatrix = activePlanarReflection.viewProjection;
+        passState.planarReflectionStrength = activePlanarReflection.strength;
+        passState.planarReflectionCenter = activePlanarReflection.center;
+        passState.planarReflectionNormal = activePlanarReflection.normal;
+        passState.planarReflectionReceiverFadeDistance = activePlanarReflection.receiverFadeDistance;
+    }
+    const std::uint32_t planarReflectorHandle =
+        hasPlanarReflection ? activePlanarReflection.entityHandle : RenderEntityHandleTable::kInvalidHandle;
+    std::vector<std::uint32_t>& drawItems = visibleItemScratch;
+    drawItems.clear();
+    drawItems.reserve(items.size());
+    for(std::uint32_t i : getVisibleDrawItems(clipMatrix)){
+        const std::uint8_t flags = items.flags[i];
+        const std::uint32_t entityHandle = items.entityHandles[i];
+        if(excludedEntityHandle != RenderEntityHandleTable::kInvalidHandle && entityHandle == excludedEntityHandle) continue;
+        if(filter == RenderFilter::Opaque && (flags & RenderItemFlag_Transparent)) continue;
+        if(filter == RenderFilter::Transparent && !(flags & RenderItemFlag_Transparent)) continue;
+        const bool isPlanarReflectorItem = planarReflectorHandle != RenderEntityHandleTable::kInvalidHandle && entityHandle == planarReflectorHandle;
+        if(skipDeferredCompatible && (flags & RenderItemFlag_DeferredCompatible) && !isPlanarReflectorItem) continue;
+        drawItems.push_back(i);
+    }
+    // Uploaded before sorting: materials pick their pass permutation from the active PassBlock state.
+    PassUniformUploader::Upload(passState);
+    // Opaque order is free, so state-first keys cluster equal shader/material/mesh runs;
+    // transparent keys keep back-to-front order.
+    sortDrawItems(
+        items,
+        drawItems,
+        filter == RenderFilter::Transparent ? DrawKeys::Pass::Transparent : DrawKeys::Pass::Opaque,
+        viewMatrix,
+        cam->getSettings().farPlane,
+        nullptr
+    );
+    const std::vector<DrawRun>& runs = buildDrawRuns(items, drawItems, nullptr);
 
-            const glm::vec4 viewCenterA = static_cast<glm::mat4>(viewMatrix) * static_cast<glm::vec4>(Math3D::Vec4(centerA, 1.0f));
-            const glm::vec4 viewCenterB = static_cast<glm::mat4>(viewMatrix) * static_cast<glm::vec4>(Math3D::Vec4(centerB, 1.0f));
-            const float depthA = -viewCenterA.z;
-            const float depthB = -viewCenterB.z;
-            if(std::abs(depthA - depthB) > 1e-4f){
-                return depthA > depthB;
-            }
-            if(a->enableBackfaceCulling != b->enableBackfaceCulling){
-                return a->enableBackfaceCulling > b->enableBackfaceCulling;
-            }
-            if(a->material.get() != b->material.get()){
-                return a->material.get() < b->material.get();
-            }
-            return a->mesh.get() < b->mesh.get();
-        });
-    }
     bool cullStateKnown = false;
     bool cullEnabled = true;
     std::shared_ptr<Material> lastBoundMaterial = nullptr;
-    for(const RenderItem* itemPtr : drawItems){
-        if(!itemPtr){
-            continue;
-        }
-        const RenderItem& item = *itemPtr;
-
-        if(!cullStateKnown || cullEnabled != item.enableBackfaceCulling){
-            if(item.enableBackfaceCulling){
+    GLuint lastShaderId = 0;
+    GLint modelLocation = -1;
+    for(const DrawRun& run : runs){
+        const std::uint32_t item = drawItems[run.begin];
+        const bool itemCull = (items.flags[item] & RenderItemFlag_BackfaceCulling) != 0;
+        if(!cullStateKnown || cullEnabled != itemCull){
+            if(itemCull){
                 glEnable(GL_CULL_FACE);
                 glCullFace(GL_BACK);
                 cullEnabled = true;
@@ -4101,18 +4373,32 @@ void Scene::drawModels3D(PCamera cam, RenderFilter filter, bool skipDeferredComp
                 cullEnabled = false;
             }
             cullStateKnown = true;
-        }
-
-        auto shader = item.material ? item.material->getShader() : nullptr;
-        if(item.material != lastBoundMaterial){
-            item.material->bind();
-            lastBoundMaterial = item.material;
+            cullChangeCounter++;
+        }
+
+        const auto& material = snapshotMaterials.getShared(items.materialIndices[item]);
+        auto shader = material->getShader();
+        if(material != lastBoundMaterial){
+            material->bind();
+            // bind() may switch the material to another shader permutation.
+            shader = material->getShader();
+            lastBoundMaterial = material;
+            materialChangeCounter++;
+            const GLuint shaderId = shader ? shader->getID() : 0;
+            if(shaderId != lastShaderId){
+                lastShaderId = shaderId;
+                shaderChangeCounter++;
+            }
+            modelLocation = -1;
             if(shader && shader->getID() != 0){
+                PassUniformUploader::BindProgram(shader);
+                modelLocation = shader->getUniformLocation("u_model");
+                // Vertex-stage uniforms stay plain: the same vertex shaders are drawn outside scene passes.
                 shader->setUniformFast("u_view", Uniform<Math3D::Mat4>(viewMatrix));
                 shader->setUniformFast("u_projection", Uniform<Math3D::Mat4>(projectionMatrix));
-                shader->setUniformFast("u_useSceneColor", Uniform<int>(hasTransparentSceneColor ? 1 : 0));
-                shader->setUniformFast("u_useSceneDepth", Uniform<int>(hasTransparentSceneDepth ? 1 : 0));
-                shader->setUniformFast("u_useSsr", Uniform<int>(useTransparentSsr ? 1 : 0));
+                shader->setUniformFast("u_useUserClipPlane", Uniform<int>(userClipPlaneActive ? 1 : 0));
+                shader->setUniformFast("u_userClipPlane", Uniform<Math3D::Vec4>(userClipPlane));
+                // material->bind() resets its samplers to empty slots, so rebind the pass textures.
                 shader->setUniformFast(
                     "u_ssrColor",
                     Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(transparentSsrColor, 8))
@@ -4121,105 +4407,62 @@ void Scene::drawModels3D(PCamera cam, RenderFilter filter, bool skipDeferredComp
                     "u_sceneDepth",
                     Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(transparentSceneDepth, 9))
                 );
-                shader->setUniformFast("u_ssrIntensity", Uniform<float>(transparentSsrIntensity));
-                shader->setUniformFast("u_ssrMaxDistance", Uniform<float>(transparentSsrMaxDistance));
-                shader->setUniformFast("u_ssrThickness", Uniform<float>(transparentSsrThickness));
-                shader->setUniformFast("u_ssrStride", Uniform<float>(transparentSsrStride));
-                shader->setUniformFast("u_ssrJitter", Uniform<float>(transparentSsrJitter));
-                shader->setUniformFast("u_ssrMaxSteps", Uniform<int>(transparentSsrMaxSteps));
-                shader->setUniformFast("u_ssrRoughnessCutoff", Uniform<float>(transparentSsrRoughnessCutoff));
-                shader->setUniformFast("u_ssrEdgeFade", Uniform<float>(transparentSsrEdgeFade));
-                shader->setUniformFast("u_invProjection", Uniform<Math3D::Mat4>(inverseProjectionMatrix));
-                shader->setUniformFast("u_useUserClipPlane", Uniform<int>(userClipPlaneActive ? 1 : 0));
-                shader->setUniformFast("u_userClipPlane", Uniform<Math3D::Vec4>(userClipPlane));
+                shader->setUniformFast(
+                    "u_planarReflectionTex",
+                    Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(planarReflectionTexture, 10))
+                );
+                shader->setUniformFast(
+                    "u_localProbe",
+                    Uniform<GLUniformUpload::CubeMapSlot>(GLUniformUpload::CubeMapSlot(localProbeCubeMap, 11))
+                );
             }
         }
-        if(shader && shader->getID() != 0){
-            shader->setUniformFast("u_model", Uniform<Math3D::Mat4>(item.model));
-            shader->setUniformFast("u_useLocalProbe", Uniform<int>(hasLocalReflectionProbe ? 1 : 0));
-            shader->setUniformFast(
-                "u_localProbe",
-                Uniform<GLUniformUpload::CubeMapSlot>(GLUniformUpload::CubeMapSlot(
-                    hasLocalReflectionProbe ? deferredLocalReflectionProbe.cubeMap : nullptr,
-                    11
-                ))
-            );
-            shader->setUniformFast(
-                "u_localProbeCenter",
-                Uniform<Math3D::Vec3>(hasLocalReflectionProbe ? deferredLocalReflectionProbe.center : Math3D::Vec3(0.0f, 0.0f, 0.0f))
-            );
-            shader->setUniformFast(
-                "u_localProbeCaptureMin",
-                Uniform<Math3D::Vec3>(hasLocalReflectionProbe ? deferredLocalReflectionProbe.captureBoundsMin : Math3D::Vec3(0.0f, 0.0f, 0.0f))
-            );
-            shader->setUniformFast(
-                "u_localProbeCaptureMax",
-                Uniform<Math3D::Vec3>(hasLocalReflectionProbe ? deferredLocalReflectionProbe.captureBoundsMax : Math3D::Vec3(0.0f, 0.0f, 0.0f))
-            );
-            shader->setUniformFast(
-                "u_localProbeInfluenceMin",
-                Uniform<Math3D::Vec3>(hasLocalReflectionProbe ? deferredLocalReflectionProbe.influenceBoundsMin : Math3D::Vec3(0.0f, 0.0f, 0.0f))
-            );
-            shader->setUniformFast(
-                "u_localProbeInfluenceMax",
-                Uniform<Math3D::Vec3>(hasLocalReflectionProbe ? deferredLocalReflectionProbe.influenceBoundsMax : Math3D::Vec3(0.0f, 0.0f, 0.0f))
-            );
-            shader->setUniformFast("u_usePlanarReflection", Uniform<int>(hasPlanarReflection ? 1 : 0));
-            shader->setUniformFast(
-                "u_planarReflectionTex",
-                Uniform<GLUniformUpload::TextureSlot>(GLUniformUpload::TextureSlot(
-                    hasPlanarReflection ? activePlanarReflection.buffer->getTexture() : nullptr,
-                    10
-                ))
-            );
-            shader->setUniformFast(
-                "u_planarReflectionMatrix",
-                Uniform<Math3D::Mat4>(hasPlanarReflection ? activePlanarReflection.viewProjection : IDENTITY)
-            );
-            shader->setUniformFast(
-                "u_planarReflectionStrength",
-                Uniform<float>(hasPlanarReflection ? activePlanarReflection.strength : 1.0f)
-            );
-            shader->setUniformFast(
-                "u_planarReflectionCenter",
-                Uniform<Math3D::Vec3>(hasPlanarReflection ? activePlanarReflection.center : Math3D::Vec3(0.0f, 0.0f, 0.0f))
-            );
-            shader->setUniformFast(
-                "u_planarReflectionNormal",
-                Uniform<Math3D::Vec3>(hasPlanarReflection ? activePlanarReflection.normal : Math3D::Vec3(0.0f, 1.0f, 0.0f))
-            );
-            shader->setUniformFast(
-                "u_planarReflectionReceiverFadeDistance",
-                Uniform<float>(hasPlanarReflection ? activePlanarReflection.receiverFadeDistance : 1.0f)
-            );
-        }
 
         // The current transmissive shader solves a single screen-space composite.
         // Drawing both front and back faces double-applies that composite and causes
         // view-dependent opacity swings on closed glass meshes, so keep one stable pass.
-        item.mesh->draw();
+        Mesh* mesh = snapshotMeshes.get(items.meshIndices[item]);
+        if(run.instanced){
+            shader->setUniformFast(modelLocation, Uniform<Math3D::Mat4>(Math3D::Mat4()));
+            drawInstanceBatch.draw(*mesh, run.firstInstance, run.count);
+            drawCallCounter++;
+            continue;
+        }
+        for(size_t k = run.begin; k < run.begin + run.count; ++k){
+            if(shader && shader->getID() != 0){
+                shader->setUniformFast(modelLocation, Uniform<Math3D::Mat4>(items.models[drawItems[k]]));
+            }
+            mesh->draw();
+            drawCallCounter++;
+        }
     }
 
+    // Programs drawn outside scene passes expect the material defaults.
+    PassUniformUploader::Upload(PassUniformState{});
+
     glEnable(GL_CULL_FACE);
     glCullFace(GL_BACK);
 }
 
 void Scene::drawShadowsPass(){
     const int frontIndex = renderSnapshotIndex.load(std::memory_order_acquire);
-    const auto& snapshot = renderSnapshots[frontIndex];
-    std::vector<ShadowRenderer::ShadowDrawItem> drawItems;
-    drawItems.reserve(snapshot.drawItems.size());
-    for(const auto& item : snapshot.drawItems){
-        if(!item.mesh || !item.material || !item.castsShadows) continue;
+    const auto& items = renderSnapshots[frontIndex].drawItems;
+    std::vector<ShadowRenderer::ShadowDrawItem>& drawItems = shadowDrawItemScratch;
+    drawItems.clear();
+    drawItems.reserve(items.size());
+    for(size_t i = 0; i < items.size(); ++i){
+        const std::uint8_t flags = items.flags[i];
+        if(!(flags & RenderItemFlag_CastsShadows)) continue;
         ShadowRenderer::ShadowDrawItem drawItem;
-        drawItem.mesh = item.mesh;
-        drawItem.model = item.model;
-        drawItem.material = item.material;
-        drawItem.enableBackfaceCulling = item.enableBackfaceCulling;
-        drawItem.hasBounds = item.hasBounds;
-        drawItem.boundsMin = item.boundsMin;
-        drawItem.boundsMax = item.boundsMax;
-        drawItems.push_back(std::move(drawItem));
+        drawItem.mesh = snapshotMeshes.get(items.meshIndices[i]);
+        drawItem.meshId = items.meshIndices[i];
+        drawItem.model = items.models[i];
+        drawItem.material = snapshotMaterials.get(items.materialIndices[i]);
+        drawItem.enableBackfaceCulling = (flags & RenderItemFlag_BackfaceCulling) != 0;
+        drawItem.hasBounds = (flags & RenderItemFlag_HasBounds) != 0;
+        drawItem.boundsMin = items.boundsMin[i];
+        drawItem.boundsMax = items.boundsMax[i];
+        drawItems.push_back(drawItem);
     }
 
     if(!drawItems.empty()){
@@ -8,13 +8,20 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "ECS/Core/TransformHierarchy.h"
+#include "Foundation/Threading/SnapshotRing.h"
 #include "Foundation/Math/Color.h"
 #include "Rendering/Core/View.h"
+#include "Rendering/Core/BoundsBVH.h"
+#include "Rendering/Core/DrawKeys.h"
 #include "Platform/Input/InputManager.h"
+#include "Rendering/Geometry/InstanceBatch.h"
 #include "Rendering/Geometry/Model.h"
 #include "Rendering/Lighting/DeferredScreenGI.h"
 #include "Rendering/Lighting/DeferredSSR.h"
@@ -22,6 +29,8 @@
 #include "Rendering/Lighting/Light.h"
 #include "neoecs.hpp"
 #include "Rendering/Materials/MaterialDefaults.h"
+#include "Rendering/Shaders/ShaderVariants.h"
+#include "Scene/RenderTables.h"
 
 class Scene;
 typedef std::shared_ptr<Scene> PScene;
@@ -84,6 +93,11 @@ class Scene : public View {
          * @param deltaTime Delta time in seconds.
          */
         void updateECS(float deltaTime);
+        /**
+         * @brief Pauses updateECS() while the scene is still being populated.
+         * @param suspended True to skip ECS updates and render-state rebuilds.
+         */
+        void setECSUpdatesSuspended(bool suspended) { ecsUpdatesSuspended = suspended; }
         /**
          * @brief Rebuilds the render snapshot used by the render pass.
          */
@@ -195,6 +209,30 @@ class Scene : public View {
          */
         bool isSceneRootEntity(NeoECS::ECSEntity* entity) const;
 
+        /// @brief Holds data for DrawItemRayHit.
+        struct DrawItemRayHit {
+            std::string entityId;
+            float distance = 0.0f;
+        };
+
+        /**
+         * @brief Casts a ray against the mesh triangles of the last rendered draw items.
+         *
+         * Candidates come from the draw-item BVH in box-entry order, so only meshes whose
+         * bounds the ray reaches before the current nearest hit are tested.
+         * @param origin Ray origin in world space.
+         * @param direction Ray direction in world space.
+         * @param maxDistance Farthest hit distance to accept, in units of `direction`.
+         * @param includeIgnoredItems True to also test items flagged to ignore raycast hits.
+         * @param outHit Receives the nearest hit.
+         * @return True when a triangle was hit.
+         */
+        bool raycastDrawItems(const Math3D::Vec3& origin,
+                              const Math3D::Vec3& direction,
+                              float maxDistance,
+                              bool includeIgnoredItems,
+                              DrawItemRayHit& outHit) const;
+
         /// @brief Holds data for DebugStats.
         struct DebugStats {
             std::atomic<float> snapshotMs{0.0f};
@@ -204,6 +242,14 @@ class Scene : public View {
             std::atomic<int> drawCount{0};
             std::atomic<int> lightCount{0};
             std::atomic<int> postFxEffectCount{0};
+            std::atomic<int> worldMatrixUpdateCount{0};
+            std::atomic<int> snapshotChunkCount{0};
+            std::atomic<int> uniformUploadCount{0};
+            std::atomic<int> drawCallCount{0};
+            std::atomic<int> shaderChangeCount{0};
+            std::atomic<int> materialChangeCount{0};
+            std::atomic<int> cullChangeCount{0};
+            std::atomic<int> shadowStateChangeCount{0};
         };
 
         /**
@@ -223,7 +269,7 @@ class Scene : public View {
 
     protected:
         /**
-         * @brief Builds a world transform matrix for an entity.
+         * @brief Returns the cached world transform matrix for an entity.
          * @param entity Entity to evaluate.
          * @param manager ECS component manager.
          * @return World transform matrix.
@@ -231,30 +277,73 @@ class Scene : public View {
         Math3D::Mat4 buildWorldMatrix(NeoECS::ECSEntity* entity, NeoECS::ECSComponentManager* manager) const;
 
         std::shared_ptr<InputManager> inputManager;
+        TransformHierarchy transformHierarchy;
         NeoECS::NeoECS* ecsInstance = nullptr;
         NeoECS::NeoAPI* ecsAPI = nullptr;
         NeoECS::GameObject* sceneRootObject = nullptr;
 
-        /// @brief Holds data for RenderItem.
-        struct RenderItem {
-            std::shared_ptr<Mesh> mesh;
-            std::shared_ptr<Material> material;
-            Math3D::Mat4 model;
-            bool enableBackfaceCulling = true;
-            bool isTransparent = false;
-            bool isDeferredCompatible = false;
-            bool planarReflectionSource = false;
-            std::string entityId;
-            bool ignoreRaycastHit = false;
-            bool castsShadows = true;
-            bool hasBounds = false;
-            Math3D::Vec3 boundsMin = Math3D::Vec3(0.0f, 0.0f, 0.0f);
-            Math3D::Vec3 boundsMax = Math3D::Vec3(0.0f, 0.0f, 0.0f);
+        /// @brief Bit flags packed per snapshot draw item.
+        enum RenderItemFlags : std::uint8_t {
+            RenderItemFlag_BackfaceCulling = 1u << 0,
+            RenderItemFlag_Transparent = 1u << 1,
+            RenderItemFlag_DeferredCompatible = 1u << 2,
+            RenderItemFlag_PlanarReflectionSource = 1u << 3,
+            RenderItemFlag_IgnoreRaycastHit = 1u << 4,
+            RenderItemFlag_CastsShadows = 1u << 5,
+            RenderItemFlag_HasBounds = 1u << 6
+        };
+
+        /**
+         * @brief Structure-of-arrays draw-item storage; index `i` of every array describes one item.
+         *
+         * Meshes and materials are indices into the scene's resource tables and entities
+         * are RenderEntityHandleTable handles, so rebuilding the arrays never copies a
+         * string or touches a reference count.
+         */
+        struct RenderItemArrays {
+            std::vector<Math3D::Mat4> models;
+            std::vector<Math3D::Vec3> boundsMin;
+            std::vector<Math3D::Vec3> boundsMax;
+            std::vector<std::uint8_t> flags;
+            std::vector<std::uint32_t> meshIndices;
+            std::vector<std::uint32_t> materialIndices;
+            std::vector<std::uint32_t> entityHandles;
+
+            size_t size() const { return models.size(); }
+            bool empty() const { return models.empty(); }
+            void clear(){
+                models.clear();
+                boundsMin.clear();
+                boundsMax.clear();
+                flags.clear();
+                meshIndices.clear();
+                materialIndices.clear();
+                entityHandles.clear();
+            }
+            void reserve(size_t count){
+                models.reserve(count);
+                boundsMin.reserve(count);
+                boundsMax.reserve(count);
+                flags.reserve(count);
+                meshIndices.reserve(count);
+                materialIndices.reserve(count);
+                entityHandles.reserve(count);
+            }
+            void append(const RenderItemArrays& other){
+                models.insert(models.end(), other.models.begin(), other.models.end());
+                boundsMin.insert(boundsMin.end(), other.boundsMin.begin(), other.boundsMin.end());
+                boundsMax.insert(boundsMax.end(), other.boundsMax.begin(), other.boundsMax.end());
+                flags.insert(flags.end(), other.flags.begin(), other.flags.end());
+                meshIndices.insert(meshIndices.end(), other.meshIndices.begin(), other.meshIndices.end());
+                materialIndices.insert(materialIndices.end(), other.materialIndices.begin(), other.materialIndices.end());
+                entityHandles.insert(entityHandles.end(), other.entityHandles.begin(), other.entityHandles.end());
+            }
         };
 
         /// @brief Holds data for ReflectionProbeSnapshot.
         struct ReflectionProbeSnapshot {
             std::string entityId;
+            std::uint32_t entityHandle = RenderEntityHandleTable::kInvalidHandle;
             int resolution = 128;
             int priority = 0;
             bool autoUpdate = false;
@@ -268,13 +357,151 @@ class Scene : public View {
 
         /// @brief Holds data for RenderSnapshot.
         struct RenderSnapshot {
-            std::vector<RenderItem> drawItems;
+            std::uint64_t revision = 0;
+            std::chrono::steady_clock::time_point publishTime{};
+            RenderItemArrays drawItems;
+            std::vector<ReflectionProbeSnapshot> reflectionProbes;
+            std::vector<Light> lights;
+        };
+
+        /// @brief Per-chunk output of the parallel snapshot build, merged in chunk order.
+        struct SnapshotChunk {
+            RenderItemArrays drawItems;
+            // Resources missing from the scene tables; indices tagged with kPendingResourceBit point here.
+            std::vector<std::shared_ptr<Mesh>> pendingMeshes;
+            std::vector<std::shared_ptr<Material>> pendingMaterials;
             std::vector<ReflectionProbeSnapshot> reflectionProbes;
             std::vector<Light> lights;
+            std::vector<NeoECS::ECSEntity*> entitiesMissingProperties;
+            int selectedLightIndex = -1;
+            NeoECS::ECSEntity* firstEnabledCameraEntity = nullptr;
+            PCamera firstEnabledCamera = nullptr;
+            NeoECS::ECSEntity* preferredEnabledCameraEntity = nullptr;
+            PCamera preferredEnabledCamera = nullptr;
+            NeoECS::ECSEntity* activeCameraEntity = nullptr;
+        };
+
+        /**
+         * @brief Builds snapshot data for a contiguous range of `snapshotEntities`.
+         *
+         * Safe to run concurrently for disjoint ranges once the transform hierarchy is clean.
+         * @param begin First entity index.
+         * @param end One past the last entity index.
+         * @param activeCamera Camera currently bound to the main screen.
+         * @param out Chunk buffers to fill (cleared first).
+         */
+        void buildSnapshotChunk(size_t begin, size_t end, const PCamera& activeCamera, SnapshotChunk& out) const;
+
+        /// @brief Frustum-culled draw-item indices for one clip matrix of one snapshot.
+        struct VisibleItemCache {
+            std::uint64_t snapshotRevision = 0;
+            Math3D::Mat4 clipMatrix;
+            std::vector<std::uint32_t> indices;
         };
 
-        std::array<RenderSnapshot, 2> renderSnapshots{};
-        std::atomic<int> renderSnapshotIndex{0};
+        /**
+         * @brief Takes the newest published snapshot and selects what this frame renders.
+         *
+         * Called on the render thread before a 3D pass. When the logic thread ticks on its
+         * own, the two newest snapshots are blended by publish time into the presentation slot,
+         * so a fixed-rate update renders smoothly at a higher frame rate.
+         */
+        void acquireRenderSnapshot();
+
+        /**
+         * @brief Returns front-snapshot draw items that may be visible through a clip matrix.
+         *
+         * Lists are cached per snapshot revision and clip matrix, so passes that draw from
+         * the same view share one batched cull. Items without bounds are always included.
+         * Lists live in a small ring shared by every pass, so the reference is only valid
+         * until the next call; consume or copy it before requesting another list.
+         * @param clipMatrix Projection * view matrix.
+         * @return Visible item indices in snapshot order.
+         */
+        const std::vector<std::uint32_t>& getVisibleDrawItems(const Math3D::Mat4& clipMatrix);
+
+        /// @brief Holds data for DrawRun: consecutive sorted items sharing mesh, material and cull state.
+        struct DrawRun {
+            size_t begin = 0;
+            size_t count = 0;
+            size_t firstInstance = 0;
+            bool instanced = false;
+        };
+
+        /**
+         * @brief Orders draw items by 64-bit draw key with a radix sort.
+         *
+         * Opaque and deferred passes use state-first keys (cull, shader, material, mesh, then
+         * front-to-back depth); the transparent pass uses back-to-front keys. Depth is computed
+         * once per item rather than per comparison.
+         * @param items Front-snapshot item arrays.
+         * @param order Item indices to sort in place.
+         * @param pass Pass bucket selecting the key layout.
+         * @param viewMatrix View matrix used for depth.
+         * @param farPlane Camera far plane used to quantize depth.
+         * @param programOverride Program used for every item, or null to key on each material's shader.
+         */
+        void sortDrawItems(const RenderItemArrays& items,
+                           std::vector<std::uint32_t>& order,
+                           DrawKeys::Pass pass,
+                           const Math3D::Mat4& viewMatrix,
+                           float farPlane,
+                           const std::shared_ptr<ShaderProgram>& programOverride);
+
+        /**
+         * @brief Groups sorted draw items into runs and stages instance matrices for long runs.
+         *
+         * Runs of at least InstanceBatch::MIN_INSTANCES items whose program reads `aInstanceModel`
+         * are staged into drawInstanceBatch, which is uploaded once before returning.
+         * @param items Front-snapshot item arrays.
+         * @param order Sorted item indices to group.
+         * @param programOverride Program used for every item, or null to use each material's shader.
+         * @return Runs in draw order (backed by drawRunScratch).
+         */
+        const std::vector<DrawRun>& buildDrawRuns(const RenderItemArrays& items,
+                                                  const std::vector<std::uint32_t>& order,
+                                                  const std::shared_ptr<ShaderProgram>& programOverride);
+
+        /**
+         * @brief Returns the BVH over front-snapshot draw-item bounds.
+         *
+         * The tree is refitted (or rebuilt when the item set changed) once per snapshot revision.
+         * @return Draw-item BVH for the front snapshot.
+         */
+        const BoundsBVH& getDrawItemBvh() const;
+
+        // Ring slots first, then one reader-owned slot for interpolated presentation.
+        using RenderSnapshotRing = SnapshotRing<2>;
+        static constexpr size_t kPresentedSnapshotSlot = RenderSnapshotRing::SLOT_COUNT;
+        std::array<RenderSnapshot, RenderSnapshotRing::SLOT_COUNT + 1> renderSnapshots{};
+        RenderSnapshotRing renderSnapshotRing;
+        std::uint64_t presentedSnapshotRevision = 0;
+        std::vector<NeoECS::ECSEntity*> snapshotEntities;
+        std::vector<std::uint32_t> snapshotEntityHandles;
+        std::vector<std::uint32_t> visibleItemScratch;
+        std::array<VisibleItemCache, 4> visibleItemCaches{};
+        size_t nextVisibleItemCache = 0;
+        std::uint64_t renderSnapshotRevision = 0;
+        mutable BoundsBVH drawItemBvh;
+        mutable std::uint64_t drawItemBvhRevision = 0;
+        mutable std::vector<BoundsBVH::RayCandidate> rayCandidateScratch;
+        std::vector<ShadowRenderer::ShadowDrawItem> shadowDrawItemScratch;
+        std::vector<DrawRun> drawRunScratch;
+        InstanceBatch drawInstanceBatch;
+        std::vector<DrawKeys::Entry> drawKeyScratch;
+        std::vector<DrawKeys::Entry> drawKeySortScratch;
+        int drawCallCounter = 0;
+        int shaderChangeCounter = 0;
+        int materialChangeCounter = 0;
+        int cullChangeCounter = 0;
+        // Shared by every ring slot, not versioned per slot: refreshRenderState() and the render
+        // passes may only touch them while GameEngine's scene execution lock serializes tick and render.
+        RenderResourceTable<Mesh> snapshotMeshes;
+        RenderResourceTable<Material> snapshotMaterials;
+        RenderEntityHandleTable snapshotEntityHandleTable;
+        std::vector<SnapshotChunk> snapshotChunks;
+        // Slot the render passes read this frame; owned by the reader side of renderSnapshotRing.
+        std::atomic<int> renderSnapshotIndex{static_cast<int>(kPresentedSnapshotSlot)};
         DebugStats debugStats{};
         std::atomic<bool> closeRequested{false};
         std::string selectedEntityId;
@@ -282,6 +509,7 @@ class Scene : public View {
         int assetChangeListenerHandle = -1;
         std::shared_ptr<MaterialDefaults::ColorMaterial> deferredIncompatibleMaterial;
         bool outlineEnabled = false;
+        bool ecsUpdatesSuspended = false;
         PFrameBuffer outlineMaskBuffer;
         std::shared_ptr<ShaderProgram> outlineMaskShader;
         std::shared_ptr<ShaderProgram> outlineCompositeShader;
@@ -292,14 +520,10 @@ class Scene : public View {
         PFrameBuffer deferredDirectLightBuffer;
         std::shared_ptr<ShaderProgram> gBufferShader;
         std::shared_ptr<ShaderProgram> deferredLightShader;
+        std::shared_ptr<ShaderVariantSet> deferredLightVariants;
         std::shared_ptr<ModelPart> deferredQuad;
-        PTexture deferredLightTileTexture;
-        std::vector<int> deferredLightTileCpuData;
         int gBufferWidth = 0;
         int gBufferHeight = 0;
-        int deferredLightTileGridWidth = 0;
-        int deferredLightTileGridHeight = 0;
-        int deferredLightTileSize = 16;
         bool gBufferValidationDirty = true;
         bool gBufferValidated = false;
         bool deferredDisabled = false;
@@ -310,7 +534,7 @@ class Scene : public View {
         std::shared_ptr<DeferredSSR> deferredSsrPass;
         struct PlanarReflectionSurface {
             PFrameBuffer buffer = nullptr;
-            std::string entityId;
+            std::uint32_t entityHandle = RenderEntityHandleTable::kInvalidHandle;
             Math3D::Vec3 center = Math3D::Vec3(0.0f, 0.0f, 0.0f);
             Math3D::Vec3 normal = Math3D::Vec3(0.0f, 1.0f, 0.0f);
             Math3D::Mat4 viewProjection;
@@ -375,19 +599,6 @@ class Scene : public View {
          * @param screen Active screen target.
          */
         void ensureDeferredResources(PScreen screen);
-        /**
-         * @brief Allocates or resizes tiled deferred-light metadata resources.
-         * @param width Active deferred viewport width.
-         * @param height Active deferred viewport height.
-         */
-        void ensureDeferredLightTileResources(int width, int height);
-        /**
-         * @brief Builds per-tile deferred light lists for the active screen-space lighting pass.
-         * @param cam Active camera.
-         * @param lights Lights uploaded for the current frame.
-         * @return True when tile metadata is ready for the deferred shader.
-         */
-        bool buildDeferredLightTiles(PCamera cam, const std::vector<Light>& lights);
         /**
          * @brief Allocates or resizes the selection-outline mask/composite resources.
          * @param screen Active screen target.
@@ -430,8 +641,9 @@ class Scene : public View {
         /**
          * @brief Draws geometry into deferred G-buffer targets.
          * @param cam Active camera.
+         * @param excludedEntityHandle Optional entity handle to exclude from the draw.
          */
-        void drawDeferredGeometry(PCamera cam, const std::string* excludedEntityId = nullptr);
+        void drawDeferredGeometry(PCamera cam, std::uint32_t excludedEntityHandle = RenderEntityHandleTable::kInvalidHandle);
         /**
          * @brief Executes deferred lighting over the populated G-buffer.
          * @param screen Destination screen.
@@ -477,12 +689,12 @@ class Scene : public View {
          * @param cam Active camera.
          * @param filter Opaque/transparent filter selection.
          * @param skipDeferredCompatible True to skip deferred-compatible items.
-         * @param excludedEntityId Optional entity id to exclude from the draw.
+         * @param excludedEntityHandle Optional entity handle to exclude from the draw.
          */
         void drawModels3D(PCamera cam,
                           RenderFilter filter = RenderFilter::All,
                           bool skipDeferredCompatible = false,
-                          const std::string* excludedEntityId = nullptr);
+                          std::uint32_t excludedEntityHandle = RenderEntityHandleTable::kInvalidHandle);
         /**
          * @brief Renders shadow maps for shadow-casting lights.
          */
@@ -537,7 +749,7 @@ class Scene : public View {
          */
         PCamera getPreferredCamera() const { return preferredCamera; }
         /**
-         * @brief Returns world matrix for an entity.
+         * @brief Returns world matrix for an entity from the transform-hierarchy cache.
          * @param entity Entity to evaluate.
          * @param manager ECS component manager.
          * @return World transform matrix.
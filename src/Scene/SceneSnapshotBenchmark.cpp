@@ -0,0 +1,307 @@
+/**
+ * @file src/Scene/SceneSnapshotBenchmark.cpp
+ * @brief Implementation for SceneSnapshotBenchmark.
+ */
+
+#include "Scene/SceneSnapshotBenchmark.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "ECS/Core/ECSComponents.h"
+#include "Foundation/Logging/Logbot.h"
+#include "Foundation/Threading/WorkerPool.h"
+#include "Rendering/Core/FrustumCulling.h"
+#include "Scene/Scene.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    constexpr size_t kEntityCounts[] = {1000, 10000, 100000};
+    constexpr int kRepeats = 5;
+    constexpr int kGridWidth = 100;
+    constexpr float kGridSpacing = 2.5f;
+
+    double elapsedMs(const BenchClock::time_point& start){
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    // The snapshot item as it was stored before the structure-of-arrays layout.
+    struct LegacyRenderItem {
+        std::shared_ptr<Mesh> mesh;
+        std::shared_ptr<Material> material;
+        Math3D::Mat4 model;
+        bool enableBackfaceCulling = true;
+        bool isTransparent = false;
+        bool isDeferredCompatible = false;
+        bool planarReflectionSource = false;
+        std::string entityId;
+        bool ignoreRaycastHit = false;
+        bool castsShadows = true;
+        bool hasBounds = false;
+        Math3D::Vec3 boundsMin = Math3D::Vec3(0.0f, 0.0f, 0.0f);
+        Math3D::Vec3 boundsMax = Math3D::Vec3(0.0f, 0.0f, 0.0f);
+    };
+
+    // Same members as Scene::RenderItemArrays, which is internal to Scene.
+    struct ItemArrays {
+        std::vector<Math3D::Mat4> models;
+        std::vector<Math3D::Vec3> boundsMin;
+        std::vector<Math3D::Vec3> boundsMax;
+        std::vector<std::uint8_t> flags;
+        std::vector<std::uint32_t> meshIndices;
+        std::vector<std::uint32_t> materialIndices;
+        std::vector<std::uint32_t> entityHandles;
+
+        void clear(){
+            models.clear();
+            boundsMin.clear();
+            boundsMax.clear();
+            flags.clear();
+            meshIndices.clear();
+            materialIndices.clear();
+            entityHandles.clear();
+        }
+    };
+
+    /// @brief Holds data for SourceEntity: what the snapshot build reads per entity.
+    struct SourceEntity {
+        std::string entityId;
+        std::uint32_t handle = 0;
+        Math3D::Mat4 model;
+        Math3D::Vec3 boundsMin;
+        Math3D::Vec3 boundsMax;
+    };
+
+    constexpr std::uint8_t kFlagDeferredCompatible = 1u << 2;
+    constexpr std::uint8_t kFlagHasBounds = 1u << 6;
+    constexpr std::uint32_t kInvalidHandle = 0xFFFFFFFFu;
+    constexpr int kLayoutRepeats = 10;
+
+    template <typename Fn>
+    double bestOf(int repeats, Fn&& fn){
+        double best = 0.0;
+        for(int repeat = 0; repeat < repeats; ++repeat){
+            const auto start = BenchClock::now();
+            fn();
+            const double ms = elapsedMs(start);
+            if(repeat == 0 || ms < best){
+                best = ms;
+            }
+        }
+        return best;
+    }
+
+    // One shared mesh and material, like a level of instanced props; bounds come from BoundsComponent.
+    void populate(Scene& scene, size_t entityCount, const std::shared_ptr<Mesh>& mesh, const std::shared_ptr<Material>& material){
+        for(size_t i = 0; i < entityCount; ++i){
+            NeoECS::GameObject* object = scene.createECSGameObject("BenchEntity");
+            if(!object){
+                continue;
+            }
+
+            object->addComponent<TransformComponent>();
+            if(auto* transform = object->getComponent<TransformComponent>()){
+                const float x = static_cast<float>(static_cast<int>(i) % kGridWidth) * kGridSpacing;
+                const float z = static_cast<float>(static_cast<int>(i) / kGridWidth) * kGridSpacing;
+                transform->editLocal().setPosition(Math3D::Vec3(x, 0.0f, z));
+            }
+
+            object->addComponent<MeshRendererComponent>();
+            if(auto* renderer = object->getComponent<MeshRendererComponent>()){
+                renderer->mesh = mesh;
+                renderer->material = material;
+            }
+
+            object->addComponent<BoundsComponent>();
+            if(auto* bounds = object->getComponent<BoundsComponent>()){
+                bounds->type = BoundsType::Box;
+                bounds->size = Math3D::Vec3(0.5f, 0.5f, 0.5f);
+            }
+        }
+    }
+
+    double measureSnapshot(Scene& scene, size_t workerCount){
+        WorkerPool& pool = WorkerPool::Instance();
+        pool.stop();
+        if(workerCount > 0){
+            pool.start(workerCount);
+        }
+
+        // The first build after a pool change pays for chunk buffers and handle tables; skip it.
+        scene.refreshRenderState();
+        double best = 0.0;
+        for(int repeat = 0; repeat < kRepeats; ++repeat){
+            const auto start = BenchClock::now();
+            scene.refreshRenderState();
+            const double ms = elapsedMs(start);
+            if(repeat == 0 || ms < best){
+                best = ms;
+            }
+        }
+        return best;
+    }
+}
+
+SceneSnapshotBenchmark::Result SceneSnapshotBenchmark::Run(size_t maxWorkers){
+    if(maxWorkers == 0){
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        maxWorkers = (hardwareThreads > 1) ? static_cast<size_t>(hardwareThreads - 1) : 1;
+    }
+
+    // Serial, then powers of two, plus the full pool size when it is not one.
+    std::vector<size_t> workerCounts = {0};
+    for(size_t workers = 1; workers < maxWorkers; workers *= 2){
+        workerCounts.push_back(workers);
+    }
+    workerCounts.push_back(maxWorkers);
+
+    auto mesh = std::make_shared<Mesh>();
+    auto material = std::make_shared<Material>(nullptr);
+
+    Result result;
+    for(size_t entityCount : kEntityCounts){
+        auto scene = std::make_shared<Scene3D>(nullptr);
+        const auto populateStart = BenchClock::now();
+        populate(*scene, entityCount, mesh, material);
+        LogBot.Log(LOG_INFO, "Snapshot benchmark: created %llu entities in %.1f ms.",
+                   static_cast<unsigned long long>(entityCount),
+                   elapsedMs(populateStart));
+
+        double serialMs = 0.0;
+        for(size_t workers : workerCounts){
+            Sample sample;
+            sample.entityCount = entityCount;
+            sample.workerCount = workers;
+            sample.milliseconds = measureSnapshot(*scene, workers);
+            sample.drawCount = static_cast<size_t>(scene->getDebugStats().drawCount.load(std::memory_order_relaxed));
+            if(workers == 0){
+                serialMs = sample.milliseconds;
+            }
+            sample.speedup = (sample.milliseconds > 0.0) ? (serialMs / sample.milliseconds) : 0.0;
+            result.samples.push_back(sample);
+
+            LogBot.Log(LOG_INFO, "Snapshot benchmark: %llu entities, %llu worker(s): %.2f ms (x%.2f, %llu draws)",
+                       static_cast<unsigned long long>(sample.entityCount),
+                       static_cast<unsigned long long>(sample.workerCount),
+                       sample.milliseconds,
+                       sample.speedup,
+                       static_cast<unsigned long long>(sample.drawCount));
+        }
+    }
+
+    WorkerPool::Instance().stop();
+    return result;
+}
+
+SceneSnapshotBenchmark::LayoutResult SceneSnapshotBenchmark::RunLayoutComparison(size_t itemCount){
+    LayoutResult result;
+    result.itemCount = itemCount;
+
+    auto mesh = std::make_shared<Mesh>();
+    auto material = std::make_shared<Material>(nullptr);
+
+    // Entity ids share a long prefix like real node ids, so string compares cost what they did in drawModels3D.
+    std::vector<SourceEntity> sources(itemCount);
+    for(size_t i = 0; i < itemCount; ++i){
+        SourceEntity& source = sources[i];
+        source.entityId = "node-0000-0000-" + std::to_string(i);
+        source.handle = static_cast<std::uint32_t>(i);
+        const float x = static_cast<float>(static_cast<int>(i) % kGridWidth) * kGridSpacing;
+        const float z = static_cast<float>(static_cast<int>(i) / kGridWidth) * kGridSpacing;
+        source.model = Math3D::Mat4(1.0f);
+        source.boundsMin = Math3D::Vec3(x - 0.5f, -0.5f, z - 0.5f);
+        source.boundsMax = Math3D::Vec3(x + 0.5f, 0.5f, z + 0.5f);
+    }
+    const std::string excludedEntityId = sources.empty() ? std::string() : sources.back().entityId;
+    const std::string planarEntityId = "node-0000-0000-planar";
+    const std::uint32_t excludedHandle = sources.empty() ? kInvalidHandle : sources.back().handle;
+    const std::uint32_t planarHandle = kInvalidHandle;
+
+    // A camera over the middle of the grid that sees part of it.
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(125.0f, 20.0f, -10.0f),
+                                       glm::vec3(125.0f, 0.0f, 60.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    const Math3D::Mat4 clipMatrix(projection * view);
+
+    std::vector<LegacyRenderItem> legacyItems;
+    result.legacyBuildMs = bestOf(kLayoutRepeats, [&](){
+        legacyItems.clear();
+        for(const SourceEntity& source : sources){
+            LegacyRenderItem item;
+            item.mesh = mesh;
+            item.material = material;
+            item.model = source.model;
+            item.entityId = source.entityId;
+            item.hasBounds = true;
+            item.boundsMin = source.boundsMin;
+            item.boundsMax = source.boundsMax;
+            legacyItems.push_back(std::move(item));
+        }
+    });
+
+    ItemArrays arrays;
+    result.arraysBuildMs = bestOf(kLayoutRepeats, [&](){
+        arrays.clear();
+        for(const SourceEntity& source : sources){
+            arrays.models.push_back(source.model);
+            arrays.boundsMin.push_back(source.boundsMin);
+            arrays.boundsMax.push_back(source.boundsMax);
+            arrays.flags.push_back(kFlagHasBounds);
+            arrays.meshIndices.push_back(0);
+            arrays.materialIndices.push_back(0);
+            arrays.entityHandles.push_back(source.handle);
+        }
+    });
+
+    std::vector<const LegacyRenderItem*> legacyVisible;
+    legacyVisible.reserve(itemCount);
+    result.legacyCullMs = bestOf(kLayoutRepeats, [&](){
+        legacyVisible.clear();
+        for(const LegacyRenderItem& item : legacyItems){
+            if(!excludedEntityId.empty() && item.entityId == excludedEntityId) continue;
+            const bool isPlanarReflector = !planarEntityId.empty() && item.entityId == planarEntityId;
+            if(item.isDeferredCompatible && !isPlanarReflector) continue;
+            if(item.hasBounds && !FrustumCulling::AabbIntersectsClip(item.boundsMin, item.boundsMax, clipMatrix)) continue;
+            legacyVisible.push_back(&item);
+        }
+    });
+
+    std::vector<std::uint32_t> arraysVisible;
+    arraysVisible.reserve(itemCount);
+    result.arraysCullMs = bestOf(kLayoutRepeats, [&](){
+        arraysVisible.clear();
+        const size_t count = arrays.models.size();
+        for(size_t i = 0; i < count; ++i){
+            const std::uint32_t entityHandle = arrays.entityHandles[i];
+            if(excludedHandle != kInvalidHandle && entityHandle == excludedHandle) continue;
+            const std::uint8_t flags = arrays.flags[i];
+            const bool isPlanarReflector = planarHandle != kInvalidHandle && entityHandle == planarHandle;
+            if((flags & kFlagDeferredCompatible) && !isPlanarReflector) continue;
+            if((flags & kFlagHasBounds) &&
+               !FrustumCulling::AabbIntersectsClip(arrays.boundsMin[i], arrays.boundsMax[i], clipMatrix)) continue;
+            arraysVisible.push_back(static_cast<std::uint32_t>(i));
+        }
+    });
+
+    result.visibleCount = arraysVisible.size();
+    if(legacyVisible.size() != arraysVisible.size()){
+        LogBot.Log(LOG_WARN, "Snapshot layout benchmark: visible counts differ (%llu legacy vs %llu arrays).",
+                   static_cast<unsigned long long>(legacyVisible.size()),
+                   static_cast<unsigned long long>(arraysVisible.size()));
+    }
+
+    LogBot.Log(LOG_INFO, "Snapshot layout benchmark (%llu items, %llu visible): build %.2f ms structs vs %.2f ms arrays | cull %.2f ms structs vs %.2f ms arrays",
+               static_cast<unsigned long long>(result.itemCount),
+               static_cast<unsigned long long>(result.visibleCount),
+               result.legacyBuildMs,
+               result.arraysBuildMs,
+               result.legacyCullMs,
+               result.arraysCullMs);
+    return result;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file src/Scene/SceneSnapshotBenchmark.h
+ * @brief Declarations for SceneSnapshotBenchmark.
+ */
+
+#ifndef SCENE_SNAPSHOT_BENCHMARK_H
+#define SCENE_SNAPSHOT_BENCHMARK_H
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Measures how Scene::refreshRenderState scales with entity count and worker count.
+namespace SceneSnapshotBenchmark {
+    /// @brief Holds data for Sample: one snapshot build at a given scene size and pool size.
+    struct Sample {
+        size_t entityCount = 0;
+        /// Pool workers; 0 builds every chunk on the calling thread.
+        size_t workerCount = 0;
+        size_t drawCount = 0;
+        double milliseconds = 0.0;
+        /// Serial time of the same scene divided by this sample's time.
+        double speedup = 1.0;
+    };
+
+    /// @brief Holds data for Result.
+    struct Result {
+        std::vector<Sample> samples;
+    };
+
+    /// @brief Holds data for LayoutResult: old per-item structs against the structure-of-arrays snapshot.
+    struct LayoutResult {
+        size_t itemCount = 0;
+        size_t visibleCount = 0;
+        /// Best time to rebuild the item list once, per layout.
+        double legacyBuildMs = 0.0;
+        double arraysBuildMs = 0.0;
+        /// Best time for the drawModels3D exclusion and frustum loop, per layout.
+        double legacyCullMs = 0.0;
+        double arraysCullMs = 0.0;
+    };
+
+    /**
+     * @brief Times item-list rebuild and the per-item cull loop for both snapshot layouts.
+     *
+     * The legacy layout is the RenderItem struct the snapshot stored before it moved to
+     * arrays: two shared_ptrs, an entity id string and the flags as bools. Both loops use
+     * FrustumCulling::AabbIntersectsClip, so only the data layout differs.
+     * @param itemCount Synthetic draw items per list.
+     * @return Measured values.
+     */
+    LayoutResult RunLayoutComparison(size_t itemCount = 100000);
+
+    /**
+     * @brief Builds headless scenes of 1k, 10k and 100k synthetic entities and times their snapshots.
+     *
+     * Each entity has a transform, a mesh renderer and box bounds, so no GL context is needed.
+     * WorkerPool::Instance() is restarted at every measured size and left stopped afterwards.
+     * @param maxWorkers Largest pool size to measure, or 0 for hardware concurrency minus one.
+     * @return Measured values.
+     */
+    Result Run(size_t maxWorkers = 0);
+}
+
+#endif // SCENE_SNAPSHOT_BENCHMARK_H
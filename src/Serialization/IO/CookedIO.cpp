@@ -0,0 +1,902 @@
+/**
+ * @file src/Serialization/IO/CookedIO.cpp
+ * @brief Implementation for CookedIO.
+ */
+
+#include "Serialization/IO/CookedIO.h"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Foundation/IO/MappedFile.h"
+#include "Serialization/Json/JsonUtils.h"
+
+// Layout (all integers little-endian, every section 8-byte aligned):
+//
+//   Header      magic "RTCOOKED", u32 formatVersion, u32 kind, u32 schemaVersion, u32 fileSize,
+//               then one {u32 offset, u32 count} pair per section, in Section order.
+//   Strings     {u32 byteOffset, u32 length} per interned string, pointing into StringData.
+//   StringData  UTF-8 bytes, each string followed by a NUL. Count is the byte size.
+//   Entities    40 bytes: u64 id, u64 parentId, u32 name, u32 flags, u32 firstTag, u32 tagCount,
+//               u32 firstComponent, u32 componentCount.
+//   Components  16 bytes: u32 type, i32 version, u32 firstNode, u32 nodeCount.
+//   Nodes       16 bytes: u32 kind, u32 a, u64 b. A component payload is its root node followed
+//               by its descendants in document order; object members are a String key node
+//               followed by the value. Arrays and objects store their element count in `a`.
+//   Indices     u32 string indices for entity tags, metadata tags and dependencies.
+//   RootIds     u64 root entity ids.
+//   Scalars     32-bit floats or uints referenced by packed array nodes (`a` = count, `b` = first).
+//   Document    u32 fields, see DocumentField.
+//
+// String indices equal to kNoString mean "absent".
+
+namespace {
+
+constexpr std::uint8_t kMagic[8] = {'R', 'T', 'C', 'O', 'O', 'K', 'E', 'D'};
+constexpr std::uint32_t kNoString = 0xFFFFFFFFu;
+constexpr size_t kSectionAlignment = 8;
+// Numeric arrays at least this long (vertex and index data) are packed as raw 32-bit scalars.
+constexpr size_t kMinPackedArrayLength = 4;
+// Payload nesting limit, so a corrupt file cannot drive the decoder arbitrarily deep.
+constexpr int kMaxPayloadDepth = 128;
+
+constexpr std::uint32_t kEntityEnabled = 1u << 0;
+constexpr std::uint32_t kEntityHasParent = 1u << 1;
+
+enum Section : size_t {
+    SectionStrings = 0,
+    SectionStringData,
+    SectionEntities,
+    SectionComponents,
+    SectionNodes,
+    SectionIndices,
+    SectionRootIds,
+    SectionScalars,
+    SectionDocument,
+    SectionCount
+};
+
+constexpr size_t kSectionStride[SectionCount] = {8, 1, 40, 16, 16, 4, 8, 4, 4};
+constexpr size_t kHeaderSize = 24 + (SectionCount * 8);
+
+enum class NodeKind : std::uint32_t {
+    Null = 0,
+    False,
+    True,
+    UInt,
+    SInt,
+    Real,
+    String,
+    Array,
+    Object,
+    F32Array,
+    U32Array
+};
+
+// Fields shared by scenes and prefabs. Settings is sceneSettings/prefabSettings; Extra is editorState/variant.
+enum DocumentField : size_t {
+    DocName = 0,
+    DocDescription,
+    DocSourceAssetRef,
+    DocCreatedUtc,
+    DocModifiedUtc,
+    DocFirstMetadataTag,
+    DocMetadataTagCount,
+    DocFirstDependency,
+    DocDependencyCount,
+    DocSettings,
+    DocExtra,
+    DocumentFieldCount
+};
+
+void setCookedError(std::string* outError, const std::string& message){
+    if(outError){
+        *outError = message;
+    }
+}
+
+std::uint32_t readLE32(const std::uint8_t* data){
+    return static_cast<std::uint32_t>(data[0]) |
+           (static_cast<std::uint32_t>(data[1]) << 8) |
+           (static_cast<std::uint32_t>(data[2]) << 16) |
+           (static_cast<std::uint32_t>(data[3]) << 24);
+}
+
+std::uint64_t readLE64(const std::uint8_t* data){
+    return static_cast<std::uint64_t>(readLE32(data)) |
+           (static_cast<std::uint64_t>(readLE32(data + 4)) << 32);
+}
+
+void appendLE32(BinaryBuffer& data, std::uint32_t value){
+    data.push_back(static_cast<std::uint8_t>(value & 0xffu));
+    data.push_back(static_cast<std::uint8_t>((value >> 8) & 0xffu));
+    data.push_back(static_cast<std::uint8_t>((value >> 16) & 0xffu));
+    data.push_back(static_cast<std::uint8_t>((value >> 24) & 0xffu));
+}
+
+void appendLE64(BinaryBuffer& data, std::uint64_t value){
+    appendLE32(data, static_cast<std::uint32_t>(value & 0xffffffffu));
+    appendLE32(data, static_cast<std::uint32_t>(value >> 32));
+}
+
+size_t alignSectionOffset(size_t offset){
+    return (offset + (kSectionAlignment - 1)) & ~(kSectionAlignment - 1);
+}
+
+bool writeFileBytes(const std::filesystem::path& path, const BinaryBuffer& data, std::string* outError){
+    std::error_code ec;
+    std::filesystem::path parent = path.parent_path();
+    if(!parent.empty() && !std::filesystem::exists(parent, ec)){
+        if(!std::filesystem::create_directories(parent, ec)){
+            setCookedError(outError, "Failed to create directory: " + parent.generic_string());
+            return false;
+        }
+    }
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if(!stream.is_open()){
+        setCookedError(outError, "Failed to open cooked file for write: " + path.generic_string());
+        return false;
+    }
+    if(!data.empty()){
+        stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+    if(!stream.good()){
+        setCookedError(outError, "Failed to write cooked file: " + path.generic_string());
+        return false;
+    }
+    return true;
+}
+
+/// @brief Builds the sections of one cooked container.
+class CookWriter {
+    public:
+        void writeDocument(
+            const JsonSchema::DocumentMetadata& metadata,
+            const std::vector<std::string>& dependencies,
+            const JsonSchema::RawJsonValue& settings,
+            const JsonSchema::RawJsonValue& extra
+        ){
+            std::uint32_t fields[DocumentFieldCount] = {};
+            fields[DocName] = internString(metadata.name);
+            fields[DocDescription] = internString(metadata.description);
+            fields[DocSourceAssetRef] = internString(metadata.sourceAssetRef);
+            fields[DocCreatedUtc] = internString(metadata.createdUtc);
+            fields[DocModifiedUtc] = internString(metadata.modifiedUtc);
+            fields[DocFirstMetadataTag] = appendIndexList(metadata.tags);
+            fields[DocMetadataTagCount] = static_cast<std::uint32_t>(metadata.tags.size());
+            fields[DocFirstDependency] = appendIndexList(dependencies);
+            fields[DocDependencyCount] = static_cast<std::uint32_t>(dependencies.size());
+            // Settings objects are tiny and read once per load, so they stay JSON text.
+            fields[DocSettings] = settings.hasValue ? internString(settings.json) : kNoString;
+            fields[DocExtra] = extra.hasValue ? internString(extra.json) : kNoString;
+            for(std::uint32_t field : fields){
+                appendLE32(sections[SectionDocument], field);
+            }
+            counts[SectionDocument] += DocumentFieldCount;
+        }
+
+        bool writeSnapshot(const JsonSchema::EntitySnapshotSchemaBase& schema, std::string* outError){
+            for(std::uint64_t rootId : schema.rootEntityIds){
+                appendLE64(sections[SectionRootIds], rootId);
+                counts[SectionRootIds]++;
+            }
+
+            for(size_t entityIndex = 0; entityIndex < schema.entities.size(); ++entityIndex){
+                const auto& entity = schema.entities[entityIndex];
+                const std::uint32_t name = entity.name.empty() ? kNoString : internString(entity.name);
+                const std::uint32_t firstTag = appendIndexList(entity.tags);
+                const std::uint32_t firstComponent = counts[SectionComponents];
+
+                for(size_t componentIndex = 0; componentIndex < entity.components.size(); ++componentIndex){
+                    const auto& component = entity.components[componentIndex];
+                    const std::uint32_t type = internString(component.type);
+                    const std::uint32_t firstNode = counts[SectionNodes];
+                    if(!writePayload(component, outError)){
+                        if(outError && !outError->empty()){
+                            *outError = "entities[" + std::to_string(entityIndex) + "].components[" +
+                                        std::to_string(componentIndex) + "]: " + *outError;
+                        }
+                        return false;
+                    }
+
+                    BinaryBuffer& out = sections[SectionComponents];
+                    appendLE32(out, type);
+                    appendLE32(out, static_cast<std::uint32_t>(component.version));
+                    appendLE32(out, firstNode);
+                    appendLE32(out, counts[SectionNodes] - firstNode);
+                    counts[SectionComponents]++;
+                }
+
+                std::uint32_t flags = 0;
+                if(entity.enabled){
+                    flags |= kEntityEnabled;
+                }
+                if(entity.hasParentId){
+                    flags |= kEntityHasParent;
+                }
+
+                BinaryBuffer& out = sections[SectionEntities];
+                appendLE64(out, entity.id);
+                appendLE64(out, entity.hasParentId ? entity.parentId : 0);
+                appendLE32(out, name);
+                appendLE32(out, flags);
+                appendLE32(out, firstTag);
+                appendLE32(out, static_cast<std::uint32_t>(entity.tags.size()));
+                appendLE32(out, firstComponent);
+                appendLE32(out, static_cast<std::uint32_t>(entity.components.size()));
+                counts[SectionEntities]++;
+            }
+            return true;
+        }
+
+        bool finish(CookedIO::DocumentKind kind, int schemaVersion, BinaryBuffer& outBytes, std::string* outError) const{
+            size_t offsets[SectionCount] = {};
+            size_t totalSize = kHeaderSize;
+            for(size_t section = 0; section < SectionCount; ++section){
+                totalSize = alignSectionOffset(totalSize);
+                offsets[section] = totalSize;
+                totalSize += sections[section].size();
+            }
+            if(totalSize > static_cast<size_t>(std::numeric_limits<std::uint32_t>::max())){
+                setCookedError(outError, "Cooked document exceeds the 4 GB container limit.");
+                return false;
+            }
+
+            outBytes.clear();
+            outBytes.reserve(totalSize);
+            outBytes.insert(outBytes.end(), std::begin(kMagic), std::end(kMagic));
+            appendLE32(outBytes, CookedIO::FormatVersion);
+            appendLE32(outBytes, static_cast<std::uint32_t>(kind));
+            appendLE32(outBytes, static_cast<std::uint32_t>(schemaVersion));
+            appendLE32(outBytes, static_cast<std::uint32_t>(totalSize));
+            for(size_t section = 0; section < SectionCount; ++section){
+                appendLE32(outBytes, static_cast<std::uint32_t>(offsets[section]));
+                appendLE32(outBytes, counts[section]);
+            }
+            for(size_t section = 0; section < SectionCount; ++section){
+                outBytes.resize(offsets[section], 0);
+                outBytes.insert(outBytes.end(), sections[section].begin(), sections[section].end());
+            }
+            return true;
+        }
+
+    private:
+        std::uint32_t internString(std::string_view value){
+            auto it = stringIndexByValue.find(std::string(value));
+            if(it != stringIndexByValue.end()){
+                return it->second;
+            }
+
+            const std::uint32_t index = counts[SectionStrings]++;
+            BinaryBuffer& data = sections[SectionStringData];
+            appendLE32(sections[SectionStrings], static_cast<std::uint32_t>(data.size()));
+            appendLE32(sections[SectionStrings], static_cast<std::uint32_t>(value.size()));
+            data.insert(data.end(), value.begin(), value.end());
+            data.push_back(0);
+            counts[SectionStringData] = static_cast<std::uint32_t>(data.size());
+            stringIndexByValue.emplace(std::string(value), index);
+            return index;
+        }
+
+        std::uint32_t appendIndexList(const std::vector<std::string>& values){
+            const std::uint32_t first = counts[SectionIndices];
+            for(const std::string& value : values){
+                appendLE32(sections[SectionIndices], internString(value));
+                counts[SectionIndices]++;
+            }
+            return first;
+        }
+
+        void appendNode(NodeKind kind, std::uint32_t a, std::uint64_t b){
+            appendLE32(sections[SectionNodes], static_cast<std::uint32_t>(kind));
+            appendLE32(sections[SectionNodes], a);
+            appendLE64(sections[SectionNodes], b);
+            counts[SectionNodes]++;
+        }
+
+        bool writePayload(const JsonSchema::EntitySnapshotSchemaBase::ComponentRecord& record, std::string* outError){
+            JsonUtils::Document payloadDoc;
+            JsonUtils::JsonVal* payload = record.payloadValue.get();
+            if(!payload){
+                if(!JsonUtils::LoadDocumentFromText(record.payloadJson, payloadDoc, outError)){
+                    if(outError && !outError->empty()){
+                        *outError = "Failed to parse component payload JSON: " + *outError;
+                    }
+                    return false;
+                }
+                payload = payloadDoc.root();
+            }
+            if(!payload || !yyjson_is_obj(payload)){
+                setCookedError(outError, "Component payload root must be an object.");
+                return false;
+            }
+            writeValue(payload);
+            return true;
+        }
+
+        void writeValue(JsonUtils::JsonVal* value){
+            switch(yyjson_get_type(value)){
+                case YYJSON_TYPE_BOOL:
+                    appendNode(yyjson_get_bool(value) ? NodeKind::True : NodeKind::False, 0, 0);
+                    return;
+                case YYJSON_TYPE_NUM:
+                    if(yyjson_is_uint(value)){
+                        appendNode(NodeKind::UInt, 0, yyjson_get_uint(value));
+                    }else if(yyjson_is_sint(value)){
+                        appendNode(NodeKind::SInt, 0, static_cast<std::uint64_t>(yyjson_get_sint(value)));
+                    }else{
+                        const double real = yyjson_get_real(value);
+                        std::uint64_t bits = 0;
+                        std::memcpy(&bits, &real, sizeof(bits));
+                        appendNode(NodeKind::Real, 0, bits);
+                    }
+                    return;
+                case YYJSON_TYPE_STR:
+                    appendNode(NodeKind::String, internString(std::string_view(yyjson_get_str(value), yyjson_get_len(value))), 0);
+                    return;
+                case YYJSON_TYPE_ARR:{
+                    if(tryWritePackedArray(value)){
+                        return;
+                    }
+                    appendNode(NodeKind::Array, static_cast<std::uint32_t>(yyjson_arr_size(value)), 0);
+                    size_t idx = 0;
+                    size_t max = 0;
+                    JsonUtils::JsonVal* item = nullptr;
+                    yyjson_arr_foreach(value, idx, max, item){
+                        writeValue(item);
+                    }
+                    return;
+                }
+                case YYJSON_TYPE_OBJ:{
+                    appendNode(NodeKind::Object, static_cast<std::uint32_t>(yyjson_obj_size(value)), 0);
+                    size_t idx = 0;
+                    size_t max = 0;
+                    JsonUtils::JsonVal* key = nullptr;
+                    JsonUtils::JsonVal* item = nullptr;
+                    yyjson_obj_foreach(value, idx, max, key, item){
+                        writeValue(key);
+                        writeValue(item);
+                    }
+                    return;
+                }
+                default:
+                    appendNode(NodeKind::Null, 0, 0);
+                    return;
+            }
+        }
+
+        // Packs arrays of float-exact reals or 32-bit uints; decoding restores the same JSON types.
+        bool tryWritePackedArray(JsonUtils::JsonVal* arr){
+            const size_t size = yyjson_arr_size(arr);
+            if(size < kMinPackedArrayLength){
+                return false;
+            }
+
+            bool allFloat = true;
+            bool allU32 = true;
+            size_t idx = 0;
+            size_t max = 0;
+            JsonUtils::JsonVal* item = nullptr;
+            yyjson_arr_foreach(arr, idx, max, item){
+                if(allFloat){
+                    allFloat = yyjson_is_real(item) &&
+                               static_cast<double>(static_cast<float>(yyjson_get_real(item))) == yyjson_get_real(item);
+                }
+                if(allU32){
+                    allU32 = yyjson_is_uint(item) && yyjson_get_uint(item) <= std::numeric_limits<std::uint32_t>::max();
+                }
+                if(!allFloat && !allU32){
+                    return false;
+                }
+            }
+
+            appendNode(allFloat ? NodeKind::F32Array : NodeKind::U32Array, static_cast<std::uint32_t>(size), counts[SectionScalars]);
+            yyjson_arr_foreach(arr, idx, max, item){
+                std::uint32_t bits = 0;
+                if(allFloat){
+                    const float value = static_cast<float>(yyjson_get_real(item));
+                    std::memcpy(&bits, &value, sizeof(bits));
+                }else{
+                    bits = static_cast<std::uint32_t>(yyjson_get_uint(item));
+                }
+                appendLE32(sections[SectionScalars], bits);
+                counts[SectionScalars]++;
+            }
+            return true;
+        }
+
+        std::unordered_map<std::string, std::uint32_t> stringIndexByValue;
+        BinaryBuffer sections[SectionCount];
+        std::uint32_t counts[SectionCount] = {};
+};
+
+/// @brief Validates a cooked container and reads its tables in place.
+class CookReader {
+    public:
+        bool open(ByteView data, CookedIO::DocumentKind expectedKind, const JsonSchema::ISchema& schema, std::string* outError){
+            bytes = data;
+            if(!CookedIO::IsCookedData(bytes) || bytes.size() < kHeaderSize){
+                setCookedError(outError, "Not a cooked document.");
+                return false;
+            }
+
+            const std::uint8_t* header = bytes.data();
+            const std::uint32_t formatVersion = readLE32(header + 8);
+            const std::uint32_t kind = readLE32(header + 12);
+            const int schemaVersion = static_cast<int>(readLE32(header + 16));
+            const std::uint32_t fileSize = readLE32(header + 20);
+            if(formatVersion != CookedIO::FormatVersion){
+                setCookedError(outError, "Unsupported cooked format version " + std::to_string(formatVersion) +
+                                         " (expected " + std::to_string(CookedIO::FormatVersion) + "); re-cook the source document.");
+                return false;
+            }
+            if(kind != static_cast<std::uint32_t>(expectedKind)){
+                setCookedError(outError, std::string("Cooked document is not a ") + schema.SchemaType() + ".");
+                return false;
+            }
+            if(!schema.SupportsReadVersion(schemaVersion)){
+                setCookedError(outError, "Unsupported cooked " + std::string(schema.SchemaType()) +
+                                         " schema version " + std::to_string(schemaVersion) + ".");
+                return false;
+            }
+            if(fileSize != bytes.size()){
+                setCookedError(outError, "Cooked document is truncated or has trailing data.");
+                return false;
+            }
+
+            for(size_t section = 0; section < SectionCount; ++section){
+                offsets[section] = readLE32(header + 24 + (section * 8));
+                counts[section] = readLE32(header + 28 + (section * 8));
+                const std::uint64_t end = static_cast<std::uint64_t>(offsets[section]) +
+                                          (static_cast<std::uint64_t>(counts[section]) * kSectionStride[section]);
+                if(offsets[section] < kHeaderSize || end > bytes.size()){
+                    setCookedError(outError, "Cooked document section " + std::to_string(section) + " is out of bounds.");
+                    return false;
+                }
+            }
+            if(counts[SectionDocument] < DocumentFieldCount){
+                setCookedError(outError, "Cooked document is missing its document fields.");
+                return false;
+            }
+            return true;
+        }
+
+        bool readDocument(
+            JsonSchema::DocumentMetadata& outMetadata,
+            std::vector<std::string>& outDependencies,
+            JsonSchema::RawJsonValue& outSettings,
+            JsonSchema::RawJsonValue& outExtra,
+            std::string* outError
+        ) const{
+            const std::uint8_t* fields = sectionData(SectionDocument);
+            auto field = [fields](DocumentField index){ return readLE32(fields + (static_cast<size_t>(index) * 4)); };
+
+            return readOptionalString(field(DocName), outMetadata.name, outError) &&
+                   readOptionalString(field(DocDescription), outMetadata.description, outError) &&
+                   readOptionalString(field(DocSourceAssetRef), outMetadata.sourceAssetRef, outError) &&
+                   readOptionalString(field(DocCreatedUtc), outMetadata.createdUtc, outError) &&
+                   readOptionalString(field(DocModifiedUtc), outMetadata.modifiedUtc, outError) &&
+                   readIndexList(field(DocFirstMetadataTag), field(DocMetadataTagCount), outMetadata.tags, outError) &&
+                   readIndexList(field(DocFirstDependency), field(DocDependencyCount), outDependencies, outError) &&
+                   readRawJson(field(DocSettings), outSettings, outError) &&
+                   readRawJson(field(DocExtra), outExtra, outError);
+        }
+
+        bool readSnapshot(JsonSchema::EntitySnapshotSchemaBase& outSchema, std::string* outError) const{
+            const std::uint8_t* rootIds = sectionData(SectionRootIds);
+            outSchema.rootEntityIds.resize(counts[SectionRootIds]);
+            for(size_t i = 0; i < outSchema.rootEntityIds.size(); ++i){
+                outSchema.rootEntityIds[i] = readLE64(rootIds + (i * 8));
+            }
+
+            const std::uint8_t* entities = sectionData(SectionEntities);
+            const std::uint8_t* components = sectionData(SectionComponents);
+            outSchema.entities.resize(counts[SectionEntities]);
+            for(size_t entityIndex = 0; entityIndex < outSchema.entities.size(); ++entityIndex){
+                const std::uint8_t* entry = entities + (entityIndex * kSectionStride[SectionEntities]);
+                auto& entity = outSchema.entities[entityIndex];
+                const std::uint32_t flags = readLE32(entry + 20);
+                entity.id = readLE64(entry);
+                entity.hasParentId = (flags & kEntityHasParent) != 0;
+                entity.parentId = entity.hasParentId ? readLE64(entry + 8) : 0;
+                entity.enabled = (flags & kEntityEnabled) != 0;
+                if(!readOptionalString(readLE32(entry + 16), entity.name, outError) ||
+                   !readIndexList(readLE32(entry + 24), readLE32(entry + 28), entity.tags, outError)){
+                    return false;
+                }
+
+                const std::uint32_t firstComponent = readLE32(entry + 32);
+                const std::uint32_t componentCount = readLE32(entry + 36);
+                if(static_cast<std::uint64_t>(firstComponent) + componentCount > counts[SectionComponents]){
+                    setCookedError(outError, "entities[" + std::to_string(entityIndex) + "]: component range is out of bounds.");
+                    return false;
+                }
+                entity.components.resize(componentCount);
+                for(std::uint32_t i = 0; i < componentCount; ++i){
+                    const std::uint8_t* componentEntry = components + ((static_cast<size_t>(firstComponent) + i) * kSectionStride[SectionComponents]);
+                    auto& component = entity.components[i];
+                    if(!readString(readLE32(componentEntry), component.type, outError)){
+                        return false;
+                    }
+                    component.version = static_cast<int>(readLE32(componentEntry + 4));
+                    component.payloadJson.clear();
+                }
+            }
+
+            return readPayloads(outSchema, outError);
+        }
+
+    private:
+        const std::uint8_t* sectionData(Section section) const{
+            return bytes.data() + offsets[section];
+        }
+
+        bool readStringView(std::uint32_t index, std::string_view& outValue, std::string* outError) const{
+            if(index >= counts[SectionStrings]){
+                setCookedError(outError, "String index " + std::to_string(index) + " is out of bounds.");
+                return false;
+            }
+            const std::uint8_t* entry = sectionData(SectionStrings) + (static_cast<size_t>(index) * kSectionStride[SectionStrings]);
+            const std::uint32_t offset = readLE32(entry);
+            const std::uint32_t length = readLE32(entry + 4);
+            if(static_cast<std::uint64_t>(offset) + length > counts[SectionStringData]){
+                setCookedError(outError, "String " + std::to_string(index) + " is out of bounds.");
+                return false;
+            }
+            outValue = std::string_view(reinterpret_cast<const char*>(sectionData(SectionStringData) + offset), length);
+            return true;
+        }
+
+        bool readString(std::uint32_t index, std::string& outValue, std::string* outError) const{
+            std::string_view value;
+            if(!readStringView(index, value, outError)){
+                return false;
+            }
+            outValue.assign(value.data(), value.size());
+            return true;
+        }
+
+        bool readOptionalString(std::uint32_t index, std::string& outValue, std::string* outError) const{
+            if(index == kNoString){
+                outValue.clear();
+                return true;
+            }
+            return readString(index, outValue, outError);
+        }
+
+        bool readRawJson(std::uint32_t index, JsonSchema::RawJsonValue& outValue, std::string* outError) const{
+            outValue.Clear();
+            if(index == kNoString){
+                return true;
+            }
+            outValue.hasValue = true;
+            return readString(index, outValue.json, outError);
+        }
+
+        bool readIndexList(std::uint32_t first, std::uint32_t count, std::vector<std::string>& outValues, std::string* outError) const{
+            if(static_cast<std::uint64_t>(first) + count > counts[SectionIndices]){
+                setCookedError(outError, "String list is out of bounds.");
+                return false;
+            }
+            const std::uint8_t* indices = sectionData(SectionIndices) + (static_cast<size_t>(first) * kSectionStride[SectionIndices]);
+            outValues.resize(count);
+            for(std::uint32_t i = 0; i < count; ++i){
+                if(!readString(readLE32(indices + (static_cast<size_t>(i) * 4)), outValues[i], outError)){
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Decodes every payload into one document and hands each record an aliasing pointer into it.
+        bool readPayloads(JsonSchema::EntitySnapshotSchemaBase& outSchema, std::string* outError) const{
+            JsonUtils::MutableDocument scratch(yyjson_mut_doc_new(nullptr));
+            yyjson_mut_doc* doc = scratch.get();
+            yyjson_mut_val* payloads = doc ? yyjson_mut_arr(doc) : nullptr;
+            if(!payloads){
+                setCookedError(outError, "Failed to allocate cooked payload document.");
+                return false;
+            }
+            yyjson_mut_doc_set_root(doc, payloads);
+
+            const std::uint8_t* components = sectionData(SectionComponents);
+            for(std::uint32_t componentIndex = 0; componentIndex < counts[SectionComponents]; ++componentIndex){
+                const std::uint8_t* entry = components + (static_cast<size_t>(componentIndex) * kSectionStride[SectionComponents]);
+                const std::uint32_t firstNode = readLE32(entry + 8);
+                const std::uint32_t nodeCount = readLE32(entry + 12);
+                const std::uint64_t end = static_cast<std::uint64_t>(firstNode) + nodeCount;
+                if(end > counts[SectionNodes]){
+                    setCookedError(outError, "components[" + std::to_string(componentIndex) + "]: payload range is out of bounds.");
+                    return false;
+                }
+
+                std::uint32_t cursor = firstNode;
+                yyjson_mut_val* payload = decodeValue(doc, cursor, static_cast<std::uint32_t>(end), 0, outError);
+                if(!payload){
+                    if(outError && !outError->empty()){
+                        *outError = "components[" + std::to_string(componentIndex) + "]: " + *outError;
+                    }
+                    return false;
+                }
+                if(cursor != end || !yyjson_mut_is_obj(payload)){
+                    setCookedError(outError, "components[" + std::to_string(componentIndex) + "]: payload is not a single object.");
+                    return false;
+                }
+                yyjson_mut_arr_append(payloads, payload);
+            }
+
+            // One copy into an immutable document, which is what component deserializers read.
+            yyjson_doc* frozen = yyjson_mut_doc_imut_copy(doc, nullptr);
+            if(!frozen){
+                setCookedError(outError, "Failed to build cooked payload document.");
+                return false;
+            }
+            auto document = std::make_shared<JsonUtils::Document>(frozen);
+
+            std::vector<JsonUtils::JsonVal*> payloadValues;
+            payloadValues.reserve(counts[SectionComponents]);
+            size_t idx = 0;
+            size_t max = 0;
+            JsonUtils::JsonVal* item = nullptr;
+            yyjson_arr_foreach(document->root(), idx, max, item){
+                payloadValues.push_back(item);
+            }
+            if(payloadValues.size() != counts[SectionComponents]){
+                setCookedError(outError, "Cooked payload count does not match the component table.");
+                return false;
+            }
+
+            const std::uint8_t* entities = sectionData(SectionEntities);
+            for(size_t entityIndex = 0; entityIndex < outSchema.entities.size(); ++entityIndex){
+                const std::uint32_t firstComponent = readLE32(entities + (entityIndex * kSectionStride[SectionEntities]) + 32);
+                auto& records = outSchema.entities[entityIndex].components;
+                for(size_t i = 0; i < records.size(); ++i){
+                    records[i].payloadValue = std::shared_ptr<JsonUtils::JsonVal>(document, payloadValues[firstComponent + i]);
+                }
+            }
+            return true;
+        }
+
+        yyjson_mut_val* decodeValue(yyjson_mut_doc* doc, std::uint32_t& cursor, std::uint32_t end, int depth, std::string* outError) const{
+            if(depth > kMaxPayloadDepth){
+                setCookedError(outError, "Payload nesting is too deep.");
+                return nullptr;
+            }
+            if(cursor >= end){
+                setCookedError(outError, "Payload is truncated.");
+                return nullptr;
+            }
+
+            const std::uint8_t* node = sectionData(SectionNodes) + (static_cast<size_t>(cursor) * kSectionStride[SectionNodes]);
+            cursor++;
+            const std::uint32_t a = readLE32(node + 4);
+            const std::uint64_t b = readLE64(node + 8);
+
+            yyjson_mut_val* value = nullptr;
+            switch(static_cast<NodeKind>(readLE32(node))){
+                case NodeKind::Null:
+                    value = yyjson_mut_null(doc);
+                    break;
+                case NodeKind::False:
+                case NodeKind::True:
+                    value = yyjson_mut_bool(doc, static_cast<NodeKind>(readLE32(node)) == NodeKind::True);
+                    break;
+                case NodeKind::UInt:
+                    value = yyjson_mut_uint(doc, b);
+                    break;
+                case NodeKind::SInt:
+                    value = yyjson_mut_sint(doc, static_cast<std::int64_t>(b));
+                    break;
+                case NodeKind::Real:{
+                    double real = 0.0;
+                    std::memcpy(&real, &b, sizeof(real));
+                    value = yyjson_mut_real(doc, real);
+                    break;
+                }
+                case NodeKind::String:{
+                    // Not copied here; the immutable copy made in readPayloads() copies string bytes.
+                    std::string_view text;
+                    if(!readStringView(a, text, outError)){
+                        return nullptr;
+                    }
+                    value = yyjson_mut_strn(doc, text.data(), text.size());
+                    break;
+                }
+                case NodeKind::Array:{
+                    value = yyjson_mut_arr(doc);
+                    for(std::uint32_t i = 0; value && i < a; ++i){
+                        yyjson_mut_val* item = decodeValue(doc, cursor, end, depth + 1, outError);
+                        if(!item){
+                            return nullptr;
+                        }
+                        yyjson_mut_arr_append(value, item);
+                    }
+                    break;
+                }
+                case NodeKind::Object:{
+                    value = yyjson_mut_obj(doc);
+                    for(std::uint32_t i = 0; value && i < a; ++i){
+                        yyjson_mut_val* key = decodeValue(doc, cursor, end, depth + 1, outError);
+                        if(!key){
+                            return nullptr;
+                        }
+                        if(!yyjson_mut_is_str(key)){
+                            setCookedError(outError, "Object key is not a string.");
+                            return nullptr;
+                        }
+                        yyjson_mut_val* item = decodeValue(doc, cursor, end, depth + 1, outError);
+                        if(!item){
+                            return nullptr;
+                        }
+                        yyjson_mut_obj_add(value, key, item);
+                    }
+                    break;
+                }
+                case NodeKind::F32Array:
+                case NodeKind::U32Array:{
+                    if(b > counts[SectionScalars] || a > counts[SectionScalars] - b){
+                        setCookedError(outError, "Packed array is out of bounds.");
+                        return nullptr;
+                    }
+                    const bool isFloat = static_cast<NodeKind>(readLE32(node)) == NodeKind::F32Array;
+                    const std::uint8_t* scalars = sectionData(SectionScalars) + (static_cast<size_t>(b) * kSectionStride[SectionScalars]);
+                    value = yyjson_mut_arr(doc);
+                    for(std::uint32_t i = 0; value && i < a; ++i){
+                        const std::uint32_t bits = readLE32(scalars + (static_cast<size_t>(i) * 4));
+                        if(isFloat){
+                            float real = 0.0f;
+                            std::memcpy(&real, &bits, sizeof(real));
+                            yyjson_mut_arr_add_real(doc, value, static_cast<double>(real));
+                        }else{
+                            yyjson_mut_arr_add_uint(doc, value, bits);
+                        }
+                    }
+                    break;
+                }
+                default:
+                    setCookedError(outError, "Unknown payload node kind " + std::to_string(readLE32(node)) + ".");
+                    return nullptr;
+            }
+
+            if(!value){
+                setCookedError(outError, "Failed to allocate payload value.");
+            }
+            return value;
+        }
+
+        ByteView bytes;
+        std::uint32_t offsets[SectionCount] = {};
+        std::uint32_t counts[SectionCount] = {};
+};
+
+} // namespace
+
+namespace CookedIO {
+
+bool IsCookedData(ByteView bytes){
+    return bytes.size() >= sizeof(kMagic) && std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) == 0;
+}
+
+bool IsCookedFile(const std::filesystem::path& path){
+    std::ifstream stream(path, std::ios::binary);
+    std::uint8_t magic[sizeof(kMagic)] = {};
+    if(!stream.read(reinterpret_cast<char*>(magic), sizeof(magic))){
+        return false;
+    }
+    return IsCookedData(ByteView(magic, sizeof(magic)));
+}
+
+bool CookScene(const JsonSchema::SceneSchema& schema, BinaryBuffer& outBytes, std::string* outError){
+    CookWriter writer;
+    writer.writeDocument(schema.metadata, schema.dependencies, schema.sceneSettings, schema.editorState);
+    if(!writer.writeSnapshot(schema, outError)){
+        return false;
+    }
+    return writer.finish(DocumentKind::Scene, schema.CurrentVersion(), outBytes, outError);
+}
+
+bool CookPrefab(const JsonSchema::PrefabSchema& schema, BinaryBuffer& outBytes, std::string* outError){
+    CookWriter writer;
+    writer.writeDocument(schema.metadata, schema.dependencies, schema.prefabSettings, schema.variant);
+    if(!writer.writeSnapshot(schema, outError)){
+        return false;
+    }
+    return writer.finish(DocumentKind::Prefab, schema.CurrentVersion(), outBytes, outError);
+}
+
+bool ReadScene(ByteView bytes, JsonSchema::SceneSchema& outSchema, std::string* outError){
+    outSchema.Clear();
+    CookReader reader;
+    if(!reader.open(bytes, DocumentKind::Scene, outSchema, outError) ||
+       !reader.readDocument(outSchema.metadata, outSchema.dependencies, outSchema.sceneSettings, outSchema.editorState, outError) ||
+       !reader.readSnapshot(outSchema, outError) ||
+       !outSchema.ValidateLoadedState(outError)){
+        outSchema.Clear();
+        return false;
+    }
+    return true;
+}
+
+bool ReadPrefab(ByteView bytes, JsonSchema::PrefabSchema& outSchema, std::string* outError){
+    outSchema.Clear();
+    CookReader reader;
+    if(!reader.open(bytes, DocumentKind::Prefab, outSchema, outError) ||
+       !reader.readDocument(outSchema.metadata, outSchema.dependencies, outSchema.prefabSettings, outSchema.variant, outError) ||
+       !reader.readSnapshot(outSchema, outError) ||
+       !outSchema.ValidateLoadedState(outError)){
+        outSchema.Clear();
+        return false;
+    }
+    return true;
+}
+
+bool LoadSceneFromAbsolutePath(const std::filesystem::path& path, JsonSchema::SceneSchema& outSchema, std::string* outError){
+    std::shared_ptr<MappedFile> mapping = MappedFile::Open(path.string(), outError);
+    if(!mapping){
+        return false;
+    }
+    if(!ReadScene(mapping->view(), outSchema, outError)){
+        if(outError && !outError->empty()){
+            *outError = "Failed to load cooked scene '" + path.generic_string() + "': " + *outError;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool LoadPrefabFromAbsolutePath(const std::filesystem::path& path, JsonSchema::PrefabSchema& outSchema, std::string* outError){
+    std::shared_ptr<MappedFile> mapping = MappedFile::Open(path.string(), outError);
+    if(!mapping){
+        return false;
+    }
+    if(!ReadPrefab(mapping->view(), outSchema, outError)){
+        if(outError && !outError->empty()){
+            *outError = "Failed to load cooked prefab '" + path.generic_string() + "': " + *outError;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool ExportScene(const JsonSchema::SceneSchema& schema, const std::filesystem::path& path, std::string* outError){
+    BinaryBuffer bytes;
+    return CookScene(schema, bytes, outError) && writeFileBytes(path, bytes, outError);
+}
+
+bool ExportPrefab(const JsonSchema::PrefabSchema& schema, const std::filesystem::path& path, std::string* outError){
+    BinaryBuffer bytes;
+    return CookPrefab(schema, bytes, outError) && writeFileBytes(path, bytes, outError);
+}
+
+bool CookFile(const std::filesystem::path& sourcePath, const std::filesystem::path& cookedPath, std::string* outError){
+    JsonUtils::Document doc;
+    if(!JsonUtils::LoadDocumentFromAbsolutePath(sourcePath, doc, outError)){
+        return false;
+    }
+
+    std::string type;
+    int version = 0;
+    if(!JsonUtils::ReadStandardDocumentHeader(doc, type, version, nullptr, outError)){
+        return false;
+    }
+
+    JsonSchema::SceneSchema sceneSchema;
+    if(type == sceneSchema.SchemaType()){
+        return sceneSchema.LoadFromDocument(doc, outError) && ExportScene(sceneSchema, cookedPath, outError);
+    }
+    JsonSchema::PrefabSchema prefabSchema;
+    if(type == prefabSchema.SchemaType()){
+        return prefabSchema.LoadFromDocument(doc, outError) && ExportPrefab(prefabSchema, cookedPath, outError);
+    }
+
+    setCookedError(outError, "Cannot cook document type '" + type + "'; only scenes and prefabs are supported.");
+    return false;
+}
+
+} // namespace CookedIO
@@ -0,0 +1,139 @@
+/**
+ * @file src/Serialization/IO/CookedIO.h
+ * @brief Declarations for CookedIO.
+ */
+
+#ifndef SERIALIZATION_IO_COOKED_IO_H
+#define SERIALIZATION_IO_COOKED_IO_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "Foundation/Util/Types.h"
+#include "Serialization/Schema/PrefabSceneSchemas.h"
+
+/**
+ * @brief Binary "cooked" container for scene and prefab schemas.
+ *
+ * A cooked file carries the same data as the JSON document, laid out as fixed-size tables:
+ * a header, an interned string table, an entity table, a component table, and every component
+ * payload flattened into 16-byte value nodes (numeric arrays are packed as raw 32-bit scalars).
+ * Reading walks the tables straight out of a memory-mapped file; no text is parsed, and each
+ * component record comes back with its payload already decoded (ComponentRecord::payloadValue).
+ *
+ * Cooked files are load-only build products. SceneIO and PrefabIO detect them by their magic
+ * bytes, so any scene or prefab path or asset ref may point at either format. All integers are
+ * little-endian; see CookedIO.cpp for the exact layout.
+ */
+namespace CookedIO {
+
+/// @brief Container layout version written to and required from every cooked file.
+constexpr std::uint32_t FormatVersion = 1;
+
+/// @brief Schema stored in a cooked file.
+enum class DocumentKind : std::uint32_t {
+    Scene = 1,
+    Prefab = 2
+};
+
+/**
+ * @brief Returns whether `bytes` start with the cooked container magic.
+ * @param bytes File contents.
+ * @return True for cooked data.
+ */
+bool IsCookedData(ByteView bytes);
+
+/**
+ * @brief Returns whether the file at `path` starts with the cooked container magic.
+ * @param path Filesystem path for path.
+ * @return True for a readable cooked file.
+ */
+bool IsCookedFile(const std::filesystem::path& path);
+
+/**
+ * @brief Encodes a scene schema into a cooked container.
+ * @param schema Schema to encode.
+ * @param outBytes Receives the container bytes.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; otherwise false.
+ */
+bool CookScene(const JsonSchema::SceneSchema& schema, BinaryBuffer& outBytes, std::string* outError = nullptr);
+
+/**
+ * @brief Encodes a prefab schema into a cooked container.
+ * @param schema Schema to encode.
+ * @param outBytes Receives the container bytes.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; otherwise false.
+ */
+bool CookPrefab(const JsonSchema::PrefabSchema& schema, BinaryBuffer& outBytes, std::string* outError = nullptr);
+
+/**
+ * @brief Decodes a cooked scene container.
+ *
+ * `bytes` only has to stay valid for the duration of the call.
+ * @param bytes Container bytes.
+ * @param outSchema Receives the schema; component payloads arrive pre-decoded.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; otherwise false.
+ */
+bool ReadScene(ByteView bytes, JsonSchema::SceneSchema& outSchema, std::string* outError = nullptr);
+
+/**
+ * @brief Decodes a cooked prefab container.
+ * @param bytes Container bytes.
+ * @param outSchema Receives the schema; component payloads arrive pre-decoded.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; otherwise false.
+ */
+bool ReadPrefab(ByteView bytes, JsonSchema::PrefabSchema& outSchema, std::string* outError = nullptr);
+
+/**
+ * @brief Maps a cooked scene file and decodes it.
+ * @param path Filesystem path for path.
+ * @param outSchema Receives the schema.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; otherwise false.
+ */
+bool LoadSceneFromAbsolutePath(const std::filesystem::path& path, JsonSchema::SceneSchema& outSchema, std::string* outError = nullptr);
+
+/**
+ * @brief Maps a cooked prefab file and decodes it.
+ * @param path Filesystem path for path.
+ * @param outSchema Receives the schema.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; otherwise false.
+ */
+bool LoadPrefabFromAbsolutePath(const std::filesystem::path& path, JsonSchema::PrefabSchema& outSchema, std::string* outError = nullptr);
+
+/**
+ * @brief Cooks a scene schema and writes it to disk.
+ * @param schema Schema to export.
+ * @param path Destination file.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; otherwise false.
+ */
+bool ExportScene(const JsonSchema::SceneSchema& schema, const std::filesystem::path& path, std::string* outError = nullptr);
+
+/**
+ * @brief Cooks a prefab schema and writes it to disk.
+ * @param schema Schema to export.
+ * @param path Destination file.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; otherwise false.
+ */
+bool ExportPrefab(const JsonSchema::PrefabSchema& schema, const std::filesystem::path& path, std::string* outError = nullptr);
+
+/**
+ * @brief Cooks a JSON `.scene` or `.prefab` document, picking the schema from its header type.
+ * @param sourcePath JSON document to read.
+ * @param cookedPath Destination file.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; otherwise false.
+ */
+bool CookFile(const std::filesystem::path& sourcePath, const std::filesystem::path& cookedPath, std::string* outError = nullptr);
+
+} // namespace CookedIO
+
+#endif // SERIALIZATION_IO_COOKED_IO_H
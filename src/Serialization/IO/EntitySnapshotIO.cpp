@@ -12,8 +12,13 @@
 #include <memory>
 #include <unordered_set>
 
+#include "Foundation/Threading/WorkerPool.h"
+
 namespace {
 
+// Records per worker chunk when pre-parsing component payloads.
+constexpr size_t kPayloadParseRecordsPerChunk = 32;
+
 void setSnapshotError(std::string* outError, const std::string& message){
     if(outError){
         *outError = message;
@@ -229,6 +234,76 @@ bool BuildSnapshotFromEntityRoots(
     return true;
 }
 
+bool BuildParentFirstOrder(
+    const std::vector<EntityRecord>& entities,
+    std::vector<size_t>& outOrder,
+    std::string* outError
+){
+    outOrder.clear();
+    const size_t count = entities.size();
+
+    std::unordered_map<std::uint64_t, size_t> indexById;
+    indexById.reserve(count);
+    for(size_t i = 0; i < count; ++i){
+        const EntityRecord& record = entities[i];
+        if(record.id == 0){
+            setSnapshotError(outError, "Snapshot entity has invalid id (0).");
+            return false;
+        }
+        if(!indexById.emplace(record.id, i).second){
+            setSnapshotError(outError, "Snapshot contains duplicate entity id: " + std::to_string(record.id));
+            return false;
+        }
+    }
+
+    // Children of each record, in record order, packed into one array.
+    std::vector<size_t> parentIndex(count, count);
+    std::vector<size_t> childStart(count + 1, 0);
+    for(size_t i = 0; i < count; ++i){
+        const EntityRecord& record = entities[i];
+        if(!record.hasParentId){
+            continue;
+        }
+        auto parentIt = indexById.find(record.parentId);
+        if(parentIt == indexById.end()){
+            setSnapshotError(outError, "Snapshot entity references missing parent id: " + std::to_string(record.parentId));
+            return false;
+        }
+        parentIndex[i] = parentIt->second;
+        childStart[parentIt->second + 1]++;
+    }
+    for(size_t i = 0; i < count; ++i){
+        childStart[i + 1] += childStart[i];
+    }
+    std::vector<size_t> children(childStart[count]);
+    std::vector<size_t> childFill(childStart.begin(), childStart.end() - 1);
+    for(size_t i = 0; i < count; ++i){
+        if(parentIndex[i] != count){
+            children[childFill[parentIndex[i]]++] = i;
+        }
+    }
+
+    outOrder.reserve(count);
+    for(size_t i = 0; i < count; ++i){
+        if(parentIndex[i] == count){
+            outOrder.push_back(i);
+        }
+    }
+    for(size_t head = 0; head < outOrder.size(); ++head){
+        const size_t parent = outOrder[head];
+        for(size_t c = childStart[parent]; c < childStart[parent + 1]; ++c){
+            outOrder.push_back(children[c]);
+        }
+    }
+
+    if(outOrder.size() != count){
+        outOrder.clear();
+        setSnapshotError(outError, "Failed to resolve parent dependencies while instantiating snapshot (possible parent cycle).");
+        return false;
+    }
+    return true;
+}
+
 bool InstantiateSnapshotIntoScene(
     PScene scene,
     const std::vector<EntityRecord>& entities,
@@ -250,84 +325,62 @@ bool InstantiateSnapshotIntoScene(
 
     const ComponentSerializationRegistry& registry = resolveRegistry(options.registry);
 
-    std::unordered_map<std::uint64_t, const EntityRecord*> recordsById;
-    recordsById.reserve(entities.size());
-    for(const EntityRecord& entityRecord : entities){
-        if(entityRecord.id == 0){
-            setSnapshotError(outError, "Snapshot entity has invalid id (0).");
-            return false;
-        }
-        if(recordsById.find(entityRecord.id) != recordsById.end()){
-            setSnapshotError(outError, "Snapshot contains duplicate entity id: " + std::to_string(entityRecord.id));
-            return false;
-        }
-        recordsById[entityRecord.id] = &entityRecord;
+    std::vector<size_t> creationOrder;
+    if(!BuildParentFirstOrder(entities, creationOrder, outError)){
+        return false;
     }
 
+    std::unordered_set<std::uint64_t> recordIds;
+    recordIds.reserve(entities.size());
+    for(const EntityRecord& record : entities){
+        recordIds.insert(record.id);
+    }
     for(std::uint64_t rootId : rootEntityIds){
-        if(recordsById.find(rootId) == recordsById.end()){
+        if(recordIds.find(rootId) == recordIds.end()){
             setSnapshotError(outError, "Snapshot root id not found in entity records: " + std::to_string(rootId));
             return false;
         }
     }
 
-    std::vector<const EntityRecord*> pending;
-    pending.reserve(entities.size());
-    for(const EntityRecord& record : entities){
-        pending.push_back(&record);
-    }
+    // Payload JSON parsing touches no ECS state, so it runs on the worker pool ahead of the serial restore below.
+    std::vector<std::vector<ComponentSerializationRegistry::ParsedPayload>> parsedPayloads(entities.size());
+    WorkerPool::Instance().parallelFor(entities.size(), kPayloadParseRecordsPerChunk, [&](size_t, size_t begin, size_t end){
+        for(size_t i = begin; i < end; ++i){
+            const auto& components = entities[i].components;
+            parsedPayloads[i].resize(components.size());
+            for(size_t c = 0; c < components.size(); ++c){
+                registry.parseComponentPayload(components[c], parsedPayloads[i][c]);
+            }
+        }
+    });
 
     std::unordered_map<std::uint64_t, NeoECS::GameObject*> gameObjectBySnapshotId;
     gameObjectBySnapshotId.reserve(entities.size());
-
-    while(!pending.empty()){
-        size_t createdThisPass = 0;
-        for(size_t i = 0; i < pending.size();){
-            const EntityRecord* record = pending[i];
-            if(!record){
-                pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(i));
-                continue;
-            }
-
-            NeoECS::GameObject* parentObject = options.destinationParent;
-            if(record->hasParentId){
-                auto parentCreated = gameObjectBySnapshotId.find(record->parentId);
-                if(parentCreated == gameObjectBySnapshotId.end()){
-                    auto parentExists = recordsById.find(record->parentId);
-                    if(parentExists == recordsById.end()){
-                        setSnapshotError(outError, "Snapshot entity references missing parent id: " + std::to_string(record->parentId));
-                        return false;
-                    }
-                    ++i;
-                    continue;
-                }
-                parentObject = parentCreated->second;
-            }
-
-            const std::string entityName = record->name.empty() ? std::string("GameObject") : record->name;
-            NeoECS::GameObject* createdObject = scene->createECSGameObject(entityName, parentObject);
-            if(!createdObject || !createdObject->gameobject()){
-                setSnapshotError(outError, "Failed to instantiate snapshot entity: " + entityName);
-                return false;
-            }
-
-            gameObjectBySnapshotId[record->id] = createdObject;
-            outResult.snapshotIdToEntity[record->id] = createdObject->gameobject();
-            if(!record->hasParentId){
-                outResult.rootObjects.push_back(createdObject);
-            }
-
-            pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(i));
-            ++createdThisPass;
+    for(size_t index : creationOrder){
+        const EntityRecord& record = entities[index];
+        NeoECS::GameObject* parentObject = options.destinationParent;
+        if(record.hasParentId){
+            parentObject = gameObjectBySnapshotId[record.parentId];
         }
 
-        if(createdThisPass == 0){
-            setSnapshotError(outError, "Failed to resolve parent dependencies while instantiating snapshot (possible parent cycle).");
+        const std::string entityName = record.name.empty() ? std::string("GameObject") : record.name;
+        NeoECS::GameObject* createdObject = scene->createECSGameObject(entityName, parentObject);
+        if(!createdObject || !createdObject->gameobject()){
+            setSnapshotError(outError, "Failed to instantiate snapshot entity: " + entityName);
             return false;
         }
-    }
 
+        gameObjectBySnapshotId[record.id] = createdObject;
+        outResult.snapshotIdToEntity[record.id] = createdObject->gameobject();
+    }
     for(const EntityRecord& record : entities){
+        if(!record.hasParentId){
+            outResult.rootObjects.push_back(gameObjectBySnapshotId[record.id]);
+        }
+    }
+
+    for(size_t i = 0; i < entities.size(); ++i){
+        const EntityRecord& record = entities[i];
         auto entityIt = outResult.snapshotIdToEntity.find(record.id);
         if(entityIt == outResult.snapshotIdToEntity.end() || !entityIt->second){
             setSnapshotError(outError, "Internal snapshot instantiate error: missing runtime entity for id " + std::to_string(record.id));
@@ -339,12 +392,14 @@ bool InstantiateSnapshotIntoScene(
                 manager,
                 entityIt->second,
                 record.components,
+                parsedPayloads[i],
                 outError)){
             if(outError && !outError->empty()){
                 *outError = "Entity '" + record.name + "' component restore failed: " + *outError;
             }
             return false;
         }
+        parsedPayloads[i].clear();
     }
 
     return true;
@@ -60,6 +60,22 @@ bool BuildSnapshotFromEntityRoots(
     std::string* outError = nullptr
 );
 
+/**
+ * @brief Orders snapshot records so every parent comes before its children.
+ *
+ * Validates ids (non-zero, unique) and parent references in one pass. Roots keep their
+ * record order, followed by each depth level in record order.
+ * @param entities Snapshot records.
+ * @param outOrder Receives indices into `entities`.
+ * @param outError Output value for error.
+ * @return True when the operation succeeds; false on invalid ids, missing parents or cycles.
+ */
+bool BuildParentFirstOrder(
+    const std::vector<EntityRecord>& entities,
+    std::vector<size_t>& outOrder,
+    std::string* outError = nullptr
+);
+
 /**
  * @brief Checks whether instantiate snapshot into scene.
  * @param scene Value for scene.
@@ -5,7 +5,9 @@
 
 #include "Serialization/IO/PrefabIO.h"
 
+#include "Assets/Core/Asset.h"
 #include "Serialization/IO/ComponentDependencyCollector.h"
+#include "Serialization/IO/CookedIO.h"
 #include "Serialization/IO/EntitySnapshotIO.h"
 #include "Serialization/Json/JsonUtils.h"
 
@@ -653,6 +655,9 @@ bool LoadSchemaFromAbsolutePath(
     std::string* outError
 ){
     outSchema.Clear();
+    if(CookedIO::IsCookedFile(path)){
+        return CookedIO::LoadPrefabFromAbsolutePath(path, outSchema, outError);
+    }
     return outSchema.LoadFromAbsolutePath(path, outError);
 }
 
@@ -662,6 +667,17 @@ bool LoadSchemaFromAssetRef(
     std::string* outError
 ){
     outSchema.Clear();
+    // Cooked files are recognized by their magic bytes, so an asset ref may name either format.
+    std::shared_ptr<Asset> asset = AssetManager::Instance.getOrLoad(assetRef);
+    if(asset && CookedIO::IsCookedData(asset->view())){
+        if(!CookedIO::ReadPrefab(asset->view(), outSchema, outError)){
+            if(outError && !outError->empty()){
+                *outError = "Failed to load cooked prefab from asset ref '" + assetRef + "': " + *outError;
+            }
+            return false;
+        }
+        return true;
+    }
     return outSchema.LoadFromAssetRef(assetRef, outError);
 }
 
@@ -689,6 +705,9 @@ bool InstantiateSchemaIntoScene(
         return false;
     }
 
+    // Variant merging unions dependencies, so this covers the whole base chain.
+    AssetManager::Instance.prefetch(resolvedSchema.dependencies);
+
     Serialization::SnapshotIO::SnapshotInstantiateResult instantiateResult;
     Serialization::SnapshotIO::SnapshotInstantiateOptions instantiateOptions;
     instantiateOptions.destinationParent = options.parent;
@@ -119,6 +119,8 @@ bool SaveEntitySubtreeToAssetRef(
 
 /**
  * @brief Loads schema from absolute path.
+ *
+ * Accepts the JSON document or a cooked file (see CookedIO); the format is detected from the content.
  * @param path Filesystem path for path.
  * @param outSchema Output value for schema.
  * @param outError Output value for error.
@@ -132,6 +134,8 @@ bool LoadSchemaFromAbsolutePath(
 
 /**
  * @brief Loads schema from asset ref.
+ *
+ * Accepts the JSON document or a cooked file (see CookedIO); the format is detected from the content.
  * @param assetRef Reference to asset.
  * @param outSchema Output value for schema.
  * @param outError Output value for error.
@@ -6,14 +6,20 @@
 #include "Serialization/IO/SceneIO.h"
 
 #include <algorithm>
+#include <unordered_set>
 
+#include "Assets/Core/Asset.h"
 #include "ECS/Core/ECSComponents.h"
 #include "Serialization/IO/ComponentDependencyCollector.h"
+#include "Serialization/IO/CookedIO.h"
 #include "Serialization/IO/EntitySnapshotIO.h"
 #include "Serialization/Json/JsonUtils.h"
 
 namespace {
 
+// Records per worker job when pre-parsing component payloads for an incremental load.
+constexpr size_t kIncrementalParseRecordsPerChunk = 32;
+
 void setSceneIoError(std::string* outError, const std::string& message){
     if(outError){
         *outError = message;
@@ -294,6 +300,9 @@ bool LoadSchemaFromAbsolutePath(
     std::string* outError
 ){
     outSchema.Clear();
+    if(CookedIO::IsCookedFile(path)){
+        return CookedIO::LoadSceneFromAbsolutePath(path, outSchema, outError);
+    }
     return outSchema.LoadFromAbsolutePath(path, outError);
 }
 
@@ -303,6 +312,17 @@ bool LoadSchemaFromAssetRef(
     std::string* outError
 ){
     outSchema.Clear();
+    // Cooked files are recognized by their magic bytes, so an asset ref may name either format.
+    std::shared_ptr<Asset> asset = AssetManager::Instance.getOrLoad(assetRef);
+    if(asset && CookedIO::IsCookedData(asset->view())){
+        if(!CookedIO::ReadScene(asset->view(), outSchema, outError)){
+            if(outError && !outError->empty()){
+                *outError = "Failed to load cooked scene from asset ref '" + assetRef + "': " + *outError;
+            }
+            return false;
+        }
+        return true;
+    }
     return outSchema.LoadFromAssetRef(assetRef, outError);
 }
 
@@ -324,6 +344,9 @@ bool ApplySchemaToScene(
         }
     }
 
+    // Read recorded dependencies in the background; component loads below join them or hit the cache.
+    AssetManager::Instance.prefetch(schema.dependencies);
+
     Serialization::SnapshotIO::SnapshotInstantiateResult instantiateResult;
     Serialization::SnapshotIO::SnapshotInstantiateOptions instantiateOptions;
     instantiateOptions.registry = options.registry;
@@ -383,4 +406,258 @@ bool LoadSceneFromAssetRef(
     return ApplySchemaToScene(scene, schema, options, outResult, outError);
 }
 
+IncrementalSceneLoad::~IncrementalSceneLoad(){
+    cancel();
+}
+
+void IncrementalSceneLoad::reset(){
+    // Parse jobs reference the schema and payload slots; let them drain first.
+    WorkerPool::Instance().wait(parseCounter);
+
+    scene.reset();
+    schema.Clear();
+    options = SceneLoadOptions{};
+    registry = nullptr;
+    phase = Phase::None;
+    creationOrder.clear();
+    createIndex = 0;
+    deserializeIndex = 0;
+    gameObjectsBySnapshotId.clear();
+    result = SceneLoadResult{};
+    parsedPayloads.clear();
+    parsedChunkReady.reset();
+    totalWorkUnits = 0;
+    completedWorkUnits = 0;
+}
+
+void IncrementalSceneLoad::cancel(){
+    reset();
+}
+
+bool IncrementalSceneLoad::begin(
+    PScene targetScene,
+    JsonSchema::SceneSchema sourceSchema,
+    const SceneLoadOptions& loadOptions,
+    std::string* outError
+){
+    reset();
+    if(!targetScene || !targetScene->getECS()){
+        setSceneIoError(outError, "Cannot apply scene schema: scene/ECS is null.");
+        return false;
+    }
+
+    if(loadOptions.clearExistingScene){
+        if(!Serialization::SnapshotIO::DestroySceneRootChildren(targetScene, outError)){
+            return false;
+        }
+    }
+
+    scene = std::move(targetScene);
+    schema = std::move(sourceSchema);
+    options = loadOptions;
+    registry = options.registry ? options.registry : &Serialization::DefaultComponentSerializationRegistry();
+
+    if(!Serialization::SnapshotIO::BuildParentFirstOrder(schema.entities, creationOrder, outError)){
+        if(outError && !outError->empty()){
+            *outError = "Failed to instantiate scene snapshot: " + *outError;
+        }
+        reset();
+        return false;
+    }
+    std::unordered_set<std::uint64_t> recordIds;
+    recordIds.reserve(schema.entities.size());
+    for(const auto& record : schema.entities){
+        recordIds.insert(record.id);
+    }
+    for(std::uint64_t rootId : schema.rootEntityIds){
+        if(recordIds.find(rootId) == recordIds.end()){
+            setSceneIoError(outError, "Failed to instantiate scene snapshot: Snapshot root id not found in entity records: " + std::to_string(rootId));
+            reset();
+            return false;
+        }
+    }
+
+    // Read recorded dependencies in the background; component loads join them or hit the cache.
+    AssetManager::Instance.prefetch(schema.dependencies);
+
+    const size_t entityCount = schema.entities.size();
+    totalWorkUnits = entityCount + 1;
+    for(const auto& record : schema.entities){
+        totalWorkUnits += 1 + record.components.size();
+    }
+    gameObjectsBySnapshotId.reserve(entityCount);
+    result.snapshotIdToEntity.reserve(entityCount);
+
+    // Payloads parse on workers in the order step() restores them; each chunk flags itself ready.
+    parsedPayloads.resize(entityCount);
+    const size_t chunkCount = WorkerPool::ChunkCount(entityCount, kIncrementalParseRecordsPerChunk);
+    parsedChunkReady.reset(new std::atomic<bool>[chunkCount]);
+    for(size_t chunk = 0; chunk < chunkCount; ++chunk){
+        parsedChunkReady[chunk].store(false, std::memory_order_relaxed);
+    }
+    for(size_t chunk = 0; chunk < chunkCount; ++chunk){
+        WorkerPool::Instance().submit([this, chunk, entityCount](){
+            const size_t begin = chunk * kIncrementalParseRecordsPerChunk;
+            const size_t end = std::min(entityCount, begin + kIncrementalParseRecordsPerChunk);
+            for(size_t i = begin; i < end; ++i){
+                const auto& components = schema.entities[i].components;
+                parsedPayloads[i].resize(components.size());
+                for(size_t c = 0; c < components.size(); ++c){
+                    registry->parseComponentPayload(components[c], parsedPayloads[i][c]);
+                }
+            }
+            parsedChunkReady[chunk].store(true, std::memory_order_release);
+        }, &parseCounter);
+    }
+
+    beginTime = std::chrono::steady_clock::now();
+    phase = Phase::CreateEntities;
+    return true;
+}
+
+bool IncrementalSceneLoad::beginFromAbsolutePath(
+    PScene targetScene,
+    const std::filesystem::path& path,
+    const SceneLoadOptions& loadOptions,
+    std::string* outError
+){
+    JsonSchema::SceneSchema loadedSchema;
+    if(!LoadSchemaFromAbsolutePath(path, loadedSchema, outError)){
+        return false;
+    }
+    return begin(std::move(targetScene), std::move(loadedSchema), loadOptions, outError);
+}
+
+bool IncrementalSceneLoad::beginFromAssetRef(
+    PScene targetScene,
+    const std::string& assetRef,
+    const SceneLoadOptions& loadOptions,
+    std::string* outError
+){
+    JsonSchema::SceneSchema loadedSchema;
+    if(!LoadSchemaFromAssetRef(assetRef, loadedSchema, outError)){
+        return false;
+    }
+    return begin(std::move(targetScene), std::move(loadedSchema), loadOptions, outError);
+}
+
+bool IncrementalSceneLoad::step(float budgetMs, std::string* outError){
+    if(phase == Phase::Done){
+        return true;
+    }
+    if(phase == Phase::None || !scene || !scene->getECS()){
+        setSceneIoError(outError, "No incremental scene load is active.");
+        return false;
+    }
+
+    using clock = std::chrono::steady_clock;
+    const clock::time_point deadline = clock::now() +
+        std::chrono::duration_cast<clock::duration>(std::chrono::duration<float, std::milli>(std::max(budgetMs, 0.0f)));
+    bool madeProgress = false;
+    auto withinBudget = [&](){
+        return !madeProgress || clock::now() < deadline;
+    };
+
+    while(phase == Phase::CreateEntities && withinBudget()){
+        if(createIndex >= creationOrder.size()){
+            for(const auto& record : schema.entities){
+                if(!record.hasParentId){
+                    result.rootObjects.push_back(gameObjectsBySnapshotId[record.id]);
+                }
+            }
+            phase = Phase::DeserializeComponents;
+            break;
+        }
+
+        const auto& record = schema.entities[creationOrder[createIndex]];
+        NeoECS::GameObject* parentObject = record.hasParentId ? gameObjectsBySnapshotId[record.parentId] : nullptr;
+        const std::string entityName = record.name.empty() ? std::string("GameObject") : record.name;
+        NeoECS::GameObject* createdObject = scene->createECSGameObject(entityName, parentObject);
+        if(!createdObject || !createdObject->gameobject()){
+            setSceneIoError(outError, "Failed to instantiate scene snapshot: Failed to instantiate snapshot entity: " + entityName);
+            return false;
+        }
+
+        gameObjectsBySnapshotId[record.id] = createdObject;
+        result.snapshotIdToEntity[record.id] = createdObject->gameobject();
+        ++createIndex;
+        ++completedWorkUnits;
+        madeProgress = true;
+    }
+
+    if(phase == Phase::DeserializeComponents){
+        auto* manager = scene->getECS()->getComponentManager();
+        auto* context = scene->getECS()->getContext();
+        if(!manager || !context){
+            setSceneIoError(outError, "Cannot instantiate snapshot: missing ECS component manager.");
+            return false;
+        }
+
+        while(deserializeIndex < schema.entities.size() && withinBudget()){
+            // Workers are still parsing this record; come back next step.
+            if(!parsedChunkReady[deserializeIndex / kIncrementalParseRecordsPerChunk].load(std::memory_order_acquire)){
+                break;
+            }
+
+            const auto& record = schema.entities[deserializeIndex];
+            if(!registry->deserializeEntityComponents(
+                    context,
+                    manager,
+                    result.snapshotIdToEntity[record.id],
+                    record.components,
+                    parsedPayloads[deserializeIndex],
+                    outError)){
+                if(outError && !outError->empty()){
+                    *outError = "Failed to instantiate scene snapshot: Entity '" + record.name + "' component restore failed: " + *outError;
+                }
+                return false;
+            }
+
+            parsedPayloads[deserializeIndex].clear();
+            completedWorkUnits += 1 + record.components.size();
+            ++deserializeIndex;
+            madeProgress = true;
+        }
+
+        if(deserializeIndex >= schema.entities.size()){
+            phase = Phase::Finalize;
+        }
+    }
+
+    if(phase == Phase::Finalize && withinBudget()){
+        if(options.applySceneSettings){
+            if(!applySceneSettingsRawJson(scene, schema.sceneSettings, result.snapshotIdToEntity, outError)){
+                return false;
+            }
+        }
+        result.editorState = schema.editorState;
+        parsedPayloads.clear();
+        ++completedWorkUnits;
+        phase = Phase::Done;
+    }
+    return true;
+}
+
+IncrementalLoadProgress IncrementalSceneLoad::getProgress() const{
+    IncrementalLoadProgress progress;
+    progress.entityCount = schema.entities.size();
+    progress.entitiesCreated = createIndex;
+    progress.entitiesDeserialized = deserializeIndex;
+    if(phase == Phase::Done){
+        progress.fraction = 1.0f;
+        progress.etaSeconds = 0.0f;
+        return progress;
+    }
+    if(totalWorkUnits == 0 || completedWorkUnits == 0){
+        return progress;
+    }
+
+    progress.fraction = static_cast<float>(completedWorkUnits) / static_cast<float>(totalWorkUnits);
+    // Wall time so far, scaled by the work left; frames spent rendering between steps count too.
+    const float elapsedSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - beginTime).count();
+    progress.etaSeconds = elapsedSeconds * static_cast<float>(totalWorkUnits - completedWorkUnits) /
+                          static_cast<float>(completedWorkUnits);
+    return progress;
+}
+
 } // namespace SceneIO
@@ -6,12 +6,16 @@
 #ifndef SERIALIZATION_IO_SCENE_IO_H
 #define SERIALIZATION_IO_SCENE_IO_H
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "Foundation/Threading/WorkerPool.h"
 #include "Scene/Scene.h"
 #include "Serialization/Schema/ComponentSerializationRegistry.h"
 #include "Serialization/Schema/PrefabSceneSchemas.h"
@@ -91,6 +95,8 @@ bool SaveSceneToAssetRef(
 
 /**
  * @brief Loads schema from absolute path.
+ *
+ * Accepts the JSON document or a cooked file (see CookedIO); the format is detected from the content.
  * @param path Filesystem path for path.
  * @param outSchema Output value for schema.
  * @param outError Output value for error.
@@ -104,6 +110,8 @@ bool LoadSchemaFromAbsolutePath(
 
 /**
  * @brief Loads schema from asset ref.
+ *
+ * Accepts the JSON document or a cooked file (see CookedIO); the format is detected from the content.
  * @param assetRef Reference to asset.
  * @param outSchema Output value for schema.
  * @param outError Output value for error.
@@ -166,6 +174,149 @@ bool LoadSceneFromAssetRef(
     std::string* outError = nullptr
 );
 
+/// @brief Holds data for IncrementalLoadProgress.
+struct IncrementalLoadProgress {
+    size_t entityCount = 0;
+    size_t entitiesCreated = 0;
+    size_t entitiesDeserialized = 0;
+    /// Completed share of the load in [0, 1], weighted by component count.
+    float fraction = 0.0f;
+    /// Estimated seconds until completion, or a negative value before any work finished.
+    float etaSeconds = -1.0f;
+};
+
+/**
+ * @brief Applies a scene schema over several frames, a few milliseconds at a time.
+ *
+ * begin() validates the snapshot, orders records parent-first and queues component payload
+ * parsing on WorkerPool. Each step() then creates entities and restores their components on
+ * the calling thread until its time budget runs out; ECS and GL state are only touched there.
+ * The finished scene matches what ApplySchemaToScene() produces.
+ */
+class IncrementalSceneLoad {
+    public:
+        /// @brief Enumerates values for Phase.
+        enum class Phase {
+            None = 0,
+            CreateEntities,
+            DeserializeComponents,
+            Finalize,
+            Done
+        };
+
+        IncrementalSceneLoad() = default;
+        /**
+         * @brief Waits for queued payload parsing before releasing the schema.
+         */
+        ~IncrementalSceneLoad();
+
+        IncrementalSceneLoad(const IncrementalSceneLoad&) = delete;
+        IncrementalSceneLoad& operator=(const IncrementalSceneLoad&) = delete;
+
+        /**
+         * @brief Starts loading `schema` into `scene`, cancelling any load in progress.
+         * @param scene Destination scene.
+         * @param schema Schema to apply; kept until the load finishes.
+         * @param options Configuration options.
+         * @param outError Output value for error.
+         * @return True when the operation succeeds; otherwise false.
+         */
+        bool begin(
+            PScene scene,
+            JsonSchema::SceneSchema schema,
+            const SceneLoadOptions& options = SceneLoadOptions{},
+            std::string* outError = nullptr
+        );
+
+        /**
+         * @brief Reads a scene file and starts loading it into `scene`.
+         * @param scene Destination scene.
+         * @param path Filesystem path for path.
+         * @param options Configuration options.
+         * @param outError Output value for error.
+         * @return True when the operation succeeds; otherwise false.
+         */
+        bool beginFromAbsolutePath(
+            PScene scene,
+            const std::filesystem::path& path,
+            const SceneLoadOptions& options = SceneLoadOptions{},
+            std::string* outError = nullptr
+        );
+
+        /**
+         * @brief Reads a scene asset and starts loading it into `scene`.
+         * @param scene Destination scene.
+         * @param assetRef Reference to asset.
+         * @param options Configuration options.
+         * @param outError Output value for error.
+         * @return True when the operation succeeds; otherwise false.
+         */
+        bool beginFromAssetRef(
+            PScene scene,
+            const std::string& assetRef,
+            const SceneLoadOptions& options = SceneLoadOptions{},
+            std::string* outError = nullptr
+        );
+
+        /**
+         * @brief Advances the load until `budgetMs` elapsed; always makes some progress.
+         *
+         * Must run on the thread that owns the scene (and the GL context).
+         * @param budgetMs Time budget for this call in milliseconds.
+         * @param outError Output value for error.
+         * @return False when the load failed; true while it is running or once it is done.
+         */
+        bool step(float budgetMs, std::string* outError = nullptr);
+
+        /**
+         * @brief Abandons the load; entities created so far stay in the scene.
+         */
+        void cancel();
+
+        /// @brief Returns the current phase.
+        Phase getPhase() const { return phase; }
+        /// @brief Returns true between a successful begin() and completion or cancel().
+        bool isActive() const { return phase != Phase::None && phase != Phase::Done; }
+        /// @brief Returns true once every phase completed.
+        bool isDone() const { return phase == Phase::Done; }
+
+        /**
+         * @brief Returns progress and an estimate of the remaining time.
+         * @return Progress snapshot.
+         */
+        IncrementalLoadProgress getProgress() const;
+
+        /// @brief Returns the schema being applied.
+        const JsonSchema::SceneSchema& getSchema() const { return schema; }
+        /// @brief Returns created roots and the snapshot id map; complete once isDone().
+        const SceneLoadResult& getResult() const { return result; }
+
+    private:
+        using ParsedPayload = Serialization::ComponentSerializationRegistry::ParsedPayload;
+
+        void reset();
+
+        PScene scene;
+        JsonSchema::SceneSchema schema;
+        SceneLoadOptions options;
+        const Serialization::ComponentSerializationRegistry* registry = nullptr;
+        Phase phase = Phase::None;
+
+        std::vector<size_t> creationOrder;
+        size_t createIndex = 0;
+        size_t deserializeIndex = 0;
+        std::unordered_map<std::uint64_t, NeoECS::GameObject*> gameObjectsBySnapshotId;
+        SceneLoadResult result;
+
+        std::vector<std::vector<ParsedPayload>> parsedPayloads;
+        std::unique_ptr<std::atomic<bool>[]> parsedChunkReady;
+        WorkerPool::Counter parseCounter;
+
+        size_t totalWorkUnits = 0;
+        size_t completedWorkUnits = 0;
+        std::chrono::steady_clock::time_point beginTime{};
+};
+
 } // namespace SceneIO
 
 #endif // SERIALIZATION_IO_SCENE_IO_H
@@ -0,0 +1,122 @@
+/**
+ * @file src/Serialization/IO/SceneLoadBenchmark.cpp
+ * @brief Implementation for SceneLoadBenchmark.
+ */
+
+#include "Serialization/IO/SceneLoadBenchmark.h"
+
+#include <chrono>
+#include <system_error>
+#include <vector>
+
+#include "Foundation/Logging/Logbot.h"
+#include "Serialization/IO/CookedIO.h"
+#include "Serialization/IO/SceneIO.h"
+#include "Serialization/Schema/ComponentSerializationRegistry.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    double elapsedMs(const BenchClock::time_point& start){
+        return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+    }
+
+    // Loads a scene document up to the point where every component payload is ready to deserialize.
+    bool loadDocument(const std::filesystem::path& path,
+                      const Serialization::ComponentSerializationRegistry& registry,
+                      size_t& outComponentCount,
+                      std::string* outError){
+        JsonSchema::SceneSchema schema;
+        if(!SceneIO::LoadSchemaFromAbsolutePath(path, schema, outError)){
+            return false;
+        }
+
+        outComponentCount = 0;
+        Serialization::ComponentSerializationRegistry::ParsedPayload parsed;
+        for(const auto& entity : schema.entities){
+            for(const auto& record : entity.components){
+                if(!registry.parseComponentPayload(record, parsed)){
+                    if(outError){
+                        *outError = parsed.error;
+                    }
+                    return false;
+                }
+                outComponentCount++;
+            }
+        }
+        return true;
+    }
+
+    bool timeLoads(const std::filesystem::path& path,
+                   int iterations,
+                   const Serialization::ComponentSerializationRegistry& registry,
+                   size_t& outComponentCount,
+                   double& outBestMs,
+                   std::string* outError){
+        outBestMs = 0.0;
+        for(int i = 0; i < iterations; ++i){
+            const auto start = BenchClock::now();
+            if(!loadDocument(path, registry, outComponentCount, outError)){
+                return false;
+            }
+            const double ms = elapsedMs(start);
+            if(i == 0 || ms < outBestMs){
+                outBestMs = ms;
+            }
+        }
+        return true;
+    }
+}
+
+SceneLoadBenchmark::Result SceneLoadBenchmark::Run(const std::filesystem::path& scenePath, int iterations){
+    Result result;
+    if(iterations < 1){
+        iterations = 1;
+    }
+
+    const auto& registry = Serialization::DefaultComponentSerializationRegistry();
+    JsonSchema::SceneSchema schema;
+    if(!SceneIO::LoadSchemaFromAbsolutePath(scenePath, schema, &result.error)){
+        LogBot.Log(LOG_ERRO, "Scene load benchmark: %s", result.error.c_str());
+        return result;
+    }
+    result.entityCount = schema.entities.size();
+
+    std::error_code ec;
+    const std::filesystem::path cookedPath =
+        std::filesystem::temp_directory_path(ec) / (scenePath.filename().string() + ".cooked");
+    if(ec || !CookedIO::ExportScene(schema, cookedPath, &result.error)){
+        if(ec){
+            result.error = "No temporary directory for the cooked copy.";
+        }
+        LogBot.Log(LOG_ERRO, "Scene load benchmark: %s", result.error.c_str());
+        return result;
+    }
+    result.jsonBytes = static_cast<size_t>(std::filesystem::file_size(scenePath, ec));
+    result.cookedBytes = static_cast<size_t>(std::filesystem::file_size(cookedPath, ec));
+
+    size_t cookedComponents = 0;
+    result.valid =
+        timeLoads(scenePath, iterations, registry, result.componentCount, result.jsonMs, &result.error) &&
+        timeLoads(cookedPath, iterations, registry, cookedComponents, result.cookedMs, &result.error);
+    std::filesystem::remove(cookedPath, ec);
+    if(!result.valid){
+        LogBot.Log(LOG_ERRO, "Scene load benchmark: %s", result.error.c_str());
+        return result;
+    }
+
+    result.speedup = (result.cookedMs > 0.0) ? (result.jsonMs / result.cookedMs) : 0.0;
+    LogBot.Log(LOG_INFO, "Scene load benchmark '%s' (%llu entities, %llu components, best of %d):",
+               scenePath.generic_string().c_str(),
+               static_cast<unsigned long long>(result.entityCount),
+               static_cast<unsigned long long>(result.componentCount),
+               iterations);
+    LogBot.Log(LOG_INFO, "  JSON   %8llu bytes  %.3f ms",
+               static_cast<unsigned long long>(result.jsonBytes),
+               result.jsonMs);
+    LogBot.Log(LOG_INFO, "  cooked %8llu bytes  %.3f ms (x%.2f)",
+               static_cast<unsigned long long>(result.cookedBytes),
+               result.cookedMs,
+               result.speedup);
+    return result;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file src/Serialization/IO/SceneLoadBenchmark.h
+ * @brief Declarations for SceneLoadBenchmark.
+ */
+
+#ifndef SCENE_LOAD_BENCHMARK_H
+#define SCENE_LOAD_BENCHMARK_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+/// @brief Compares reading a scene from its JSON document against reading its cooked form.
+namespace SceneLoadBenchmark {
+    /// @brief Holds data for Result.
+    struct Result {
+        bool valid = false;
+        size_t entityCount = 0;
+        size_t componentCount = 0;
+        size_t jsonBytes = 0;
+        size_t cookedBytes = 0;
+        /// Best time to load the JSON schema and parse every component payload.
+        double jsonMs = 0.0;
+        /// Best time to map the cooked file and decode the schema with its payloads.
+        double cookedMs = 0.0;
+        double speedup = 0.0;
+        std::string error;
+    };
+
+    /**
+     * @brief Cooks `scenePath` to a temporary file, times both loads and logs a summary.
+     *
+     * Only the document side of a load is measured (everything before entities and components
+     * are created), since the ECS and GL work afterwards is the same for both formats.
+     * @param scenePath JSON `.scene` document.
+     * @param iterations Loads per format; the fastest one is reported.
+     * @return Measured values, or `valid == false` with `error` set.
+     */
+    Result Run(const std::filesystem::path& scenePath, int iterations = 20);
+}
+
+#endif // SCENE_LOAD_BENCHMARK_H
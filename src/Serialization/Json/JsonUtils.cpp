@@ -194,7 +194,7 @@ JsonMutVal* MutableDocument::setRootArray(){
     return arr;
 }
 
-bool LoadDocumentFromText(const std::string& jsonText, Document& outDoc, std::string* outError){
+bool LoadDocumentFromText(std::string_view jsonText, Document& outDoc, std::string* outError){
     yyjson_read_err err{};
     yyjson_doc* doc = yyjson_read_opts(
         (char*)(void*)jsonText.data(),
@@ -237,12 +237,16 @@ bool LoadDocumentFromAbsolutePath(const std::filesystem::path& path, Document& o
 }
 
 bool LoadDocumentFromAssetRef(const std::string& assetRef, Document& outDoc, std::string* outError){
-    std::string text;
-    if(!AssetDescriptorUtils::ReadTextAsset(assetRef, text, outError)){
+    // Parse straight from the asset bytes; yyjson does not modify its input without INSITU.
+    std::shared_ptr<Asset> asset = AssetManager::Instance.getOrLoad(assetRef);
+    if(!asset){
+        if(outError){
+            *outError = "Failed to load asset: " + assetRef;
+        }
         outDoc.reset();
         return false;
     }
-    return LoadDocumentFromText(text, outDoc, outError);
+    return LoadDocumentFromText(asset->view().asStringView(), outDoc, outError);
 }
 
 bool WriteDocumentToString(const MutableDocument& doc, std::string& outJson, std::string* outError, bool pretty){
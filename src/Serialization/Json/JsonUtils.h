@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <string>
+#include <string_view>
 
 #include "Foundation/Math/Math3D.h"
 #include "yyjson.h"
@@ -162,7 +163,7 @@ struct StandardDocumentRefs {
  * @param outError Output value for error.
  * @return True when the operation succeeds; otherwise false.
  */
-bool LoadDocumentFromText(const std::string& jsonText, Document& outDoc, std::string* outError = nullptr);
+bool LoadDocumentFromText(std::string_view jsonText, Document& outDoc, std::string* outError = nullptr);
 /**
  * @brief Loads document from absolute path.
  * @param path Filesystem path for path.
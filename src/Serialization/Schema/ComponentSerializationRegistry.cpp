@@ -1034,26 +1034,26 @@ bool registerDefaultTransformSerializer(Serialization::ComponentSerializationReg
         "TransformComponent",
         1,
         [](const TransformComponent& component, yyjson_mut_doc* doc, JsonUtils::JsonMutVal* payload, std::string* error) -> bool {
-            Math3D::Vec3 rotationEuler = component.local.rotation.ToEuler();
-            return JsonUtils::MutObjAddVec3(doc, payload, "position", component.local.position) &&
+            Math3D::Vec3 rotationEuler = component.getLocal().rotation.ToEuler();
+            return JsonUtils::MutObjAddVec3(doc, payload, "position", component.getLocal().position) &&
                    JsonUtils::MutObjAddVec3(doc, payload, "rotationEuler", rotationEuler) &&
-                   JsonUtils::MutObjAddVec3(doc, payload, "scale", component.local.scale) &&
+                   JsonUtils::MutObjAddVec3(doc, payload, "scale", component.getLocal().scale) &&
                    writeEditorComponentStateFields(component, doc, payload, error);
         },
         [](TransformComponent& component, JsonUtils::JsonVal* payload, int version, std::string* error) -> bool {
             (void)version;
             (void)error;
-            Math3D::Vec3 position = component.local.position;
-            Math3D::Vec3 scale = component.local.scale;
-            Math3D::Vec3 rotationEuler = component.local.rotation.ToEuler();
+            Math3D::Vec3 position = component.getLocal().position;
+            Math3D::Vec3 scale = component.getLocal().scale;
+            Math3D::Vec3 rotationEuler = component.getLocal().rotation.ToEuler();
 
             JsonUtils::TryGetVec3(payload, "position", position);
             JsonUtils::TryGetVec3(payload, "rotationEuler", rotationEuler);
             JsonUtils::TryGetVec3(payload, "scale", scale);
 
-            component.local.position = position;
-            component.local.setRotation(rotationEuler);
-            component.local.scale = scale;
+            component.editLocal().position = position;
+            component.editLocal().setRotation(rotationEuler);
+            component.editLocal().scale = scale;
             readEditorComponentStateFields(component, payload);
             return true;
         },
@@ -2124,7 +2124,7 @@ bool ComponentSerializationRegistry::deserializeEntityComponents(
     }
 
     for(size_t i = 0; i < records.size(); ++i){
-        if(!deserializeComponentRecordWithWrapper(wrapper.get(), manager, entity, records[i], outError)){
+        if(!deserializeComponentRecordWithWrapper(wrapper.get(), manager, entity, records[i], nullptr, outError)){
             if(outError && !outError->empty()){
                 *outError = "components[" + std::to_string(i) + "]: " + *outError;
             }
@@ -2134,6 +2134,55 @@ bool ComponentSerializationRegistry::deserializeEntityComponents(
     return true;
 }
 
+bool ComponentSerializationRegistry::deserializeEntityComponents(
+    NeoECS::ECSContext* context,
+    NeoECS::ECSComponentManager* manager,
+    NeoECS::ECSEntity* entity,
+    const std::vector<ComponentRecord>& records,
+    const std::vector<ParsedPayload>& parsedPayloads,
+    std::string* outError
+) const{
+    if(!context || !manager || !entity){
+        setComponentSerializationError(outError, "Cannot deserialize components for null context/manager/entity.");
+        return false;
+    }
+    if(parsedPayloads.size() != records.size()){
+        setComponentSerializationError(outError, "Parsed payload count does not match component record count.");
+        return false;
+    }
+
+    std::unique_ptr<NeoECS::GameObject> wrapper(NeoECS::GameObject::CreateFromECSEntity(context, entity));
+    if(!wrapper){
+        setComponentSerializationError(outError, "Failed to create GameObject wrapper for entity component deserialization.");
+        return false;
+    }
+
+    for(size_t i = 0; i < records.size(); ++i){
+        if(!deserializeComponentRecordWithWrapper(wrapper.get(), manager, entity, records[i], &parsedPayloads[i], outError)){
+            if(outError && !outError->empty()){
+                *outError = "components[" + std::to_string(i) + "]: " + *outError;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ComponentSerializationRegistry::parseComponentPayload(const ComponentRecord& record, ParsedPayload& outPayload) const{
+    outPayload.parsed = false;
+    outPayload.error.clear();
+    if(serializerIndexByType.find(record.type) == serializerIndexByType.end() || record.payloadValue){
+        return true;
+    }
+
+    JsonUtils::JsonVal* payload = nullptr;
+    if(!readPayloadFromJsonString(record.payloadJson, outPayload.document, payload, &outPayload.error)){
+        return false;
+    }
+    outPayload.parsed = true;
+    return true;
+}
+
 bool ComponentSerializationRegistry::serializeComponentRecord(
     const std::string& typeName,
     const NeoECS::ECSComponent* component,
@@ -2197,7 +2246,7 @@ bool ComponentSerializationRegistry::deserializeComponentRecord(
         setComponentSerializationError(outError, "Failed to create GameObject wrapper for component record deserialization.");
         return false;
     }
-    return deserializeComponentRecordWithWrapper(wrapper.get(), manager, entity, record, outError);
+    return deserializeComponentRecordWithWrapper(wrapper.get(), manager, entity, record, nullptr, outError);
 }
 
 bool ComponentSerializationRegistry::deserializeComponentRecordWithWrapper(
@@ -2205,6 +2254,7 @@ bool ComponentSerializationRegistry::deserializeComponentRecordWithWrapper(
     NeoECS::ECSComponentManager* manager,
     NeoECS::ECSEntity* entity,
     const ComponentRecord& record,
+    const ParsedPayload* parsedPayload,
     std::string* outError
 ) const{
     auto serializerIt = serializerIndexByType.find(record.type);
@@ -2229,7 +2279,18 @@ bool ComponentSerializationRegistry::deserializeComponentRecordWithWrapper(
 
     JsonUtils::Document payloadDoc;
     JsonUtils::JsonVal* payload = nullptr;
-    if(!readPayloadFromJsonString(record.payloadJson, payloadDoc, payload, outError)){
+    if(parsedPayload && parsedPayload->parsed){
+        payload = parsedPayload->document.root();
+    }else if(parsedPayload && !parsedPayload->error.empty()){
+        setComponentSerializationError(outError, "Invalid payload for component '" + record.type + "': " + parsedPayload->error);
+        return false;
+    }else if(record.payloadValue){
+        payload = record.payloadValue.get();
+        if(!yyjson_is_obj(payload)){
+            setComponentSerializationError(outError, "Invalid payload for component '" + record.type + "': cooked payload root must be an object.");
+            return false;
+        }
+    }else if(!readPayloadFromJsonString(record.payloadJson, payloadDoc, payload, outError)){
         if(outError && !outError->empty()){
             *outError = "Invalid payload for component '" + record.type + "': " + *outError;
         }
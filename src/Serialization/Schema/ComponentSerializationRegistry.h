@@ -26,6 +26,13 @@ class ComponentSerializationRegistry {
         using GetComponentFn = std::function<NeoECS::ECSComponent*(NeoECS::ECSComponentManager* manager, NeoECS::ECSEntity* entity)>;
         using EnsureComponentFn = std::function<bool(NeoECS::GameObject* wrapper, std::string* outError)>;
 
+        /// @brief Holds data for ParsedPayload: a record's payload JSON parsed ahead of deserialization.
+        struct ParsedPayload {
+            JsonUtils::Document document;
+            bool parsed = false;
+            std::string error;
+        };
+
         /// @brief Holds data for SerializerEntry.
         struct SerializerEntry {
             std::string typeName;
@@ -150,6 +157,30 @@ class ComponentSerializationRegistry {
             std::string* outError = nullptr
         ) const;
 
+        /**
+         * @brief Deserializes components from payloads parsed by parseComponentPayload().
+         * @param parsedPayloads One entry per record, in the same order.
+         */
+        bool deserializeEntityComponents(
+            NeoECS::ECSContext* context,
+            NeoECS::ECSComponentManager* manager,
+            NeoECS::ECSEntity* entity,
+            const std::vector<ComponentRecord>& records,
+            const std::vector<ParsedPayload>& parsedPayloads,
+            std::string* outError = nullptr
+        ) const;
+
+        /**
+         * @brief Parses a record's payload JSON without touching ECS state, so it may run on a worker thread.
+         *
+         * Records of unregistered types are left unparsed; deserialization ignores them anyway.
+         * Records loaded from a cooked file already carry a decoded payload and are skipped too.
+         * @param record Record to parse.
+         * @param outPayload Receives the parsed document or the parse error.
+         * @return True when the payload parsed or needs no parsing.
+         */
+        bool parseComponentPayload(const ComponentRecord& record, ParsedPayload& outPayload) const;
+
         bool serializeComponentRecord(
             const std::string& typeName,
             const NeoECS::ECSComponent* component,
@@ -173,6 +204,7 @@ class ComponentSerializationRegistry {
             NeoECS::ECSComponentManager* manager,
             NeoECS::ECSEntity* entity,
             const ComponentRecord& record,
+            const ParsedPayload* parsedPayload,
             std::string* outError
         ) const;
 
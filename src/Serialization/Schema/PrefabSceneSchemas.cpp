@@ -165,6 +165,23 @@ bool WriteMetadataBlock(
     return true;
 }
 
+// Compact JSON text of a component payload, written from the cooked value when there is no text.
+bool ComponentPayloadText(const JsonSchema::EntitySnapshotSchemaBase::ComponentRecord& component, std::string& outJson){
+    if(!component.payloadValue || !component.payloadJson.empty()){
+        outJson = component.payloadJson;
+        return true;
+    }
+
+    size_t len = 0;
+    char* json = yyjson_val_write_opts(component.payloadValue.get(), YYJSON_WRITE_NOFLAG, nullptr, &len, nullptr);
+    if(!json){
+        return false;
+    }
+    outJson.assign(json, len);
+    std::free(json);
+    return true;
+}
+
 } // namespace
 
 namespace JsonSchema {
@@ -185,6 +202,10 @@ bool EntitySnapshotSchemaBase::DeserializePayload(JsonUtils::JsonVal* payload, i
         return false;
     }
 
+    return ValidateLoadedState(outError);
+}
+
+bool EntitySnapshotSchemaBase::ValidateLoadedState(std::string* outError){
     DeriveRootEntityIdsIfMissing();
 
     if(!ValidateSnapshotState(outError)){
@@ -193,6 +214,19 @@ bool EntitySnapshotSchemaBase::DeserializePayload(JsonUtils::JsonVal* payload, i
     return ValidateDocumentState(outError);
 }
 
+bool EntitySnapshotSchemaBase::ComponentPayloadsEqual(const ComponentRecord& a, const ComponentRecord& b){
+    if(!a.payloadValue && !b.payloadValue){
+        return a.payloadJson == b.payloadJson;
+    }
+    if(a.payloadValue == b.payloadValue){
+        return true;
+    }
+
+    std::string aJson;
+    std::string bJson;
+    return ComponentPayloadText(a, aJson) && ComponentPayloadText(b, bJson) && aJson == bJson;
+}
+
 bool EntitySnapshotSchemaBase::SerializePayload(yyjson_mut_doc* doc, JsonUtils::JsonMutVal* payload, int version, std::string* outError) const{
     (void)version;
 
@@ -560,7 +594,7 @@ bool EntitySnapshotSchemaBase::ValidateSnapshotState(std::string* outError) cons
                 SetDocSchemaError(outError, compLabel + ".version must be > 0.");
                 return false;
             }
-            if(component.payloadJson.empty()){
+            if(component.payloadJson.empty() && !component.payloadValue){
                 SetDocSchemaError(outError, compLabel + ".payloadJson must not be empty.");
                 return false;
             }
@@ -749,7 +783,13 @@ bool EntitySnapshotSchemaBase::WriteComponentRecord(yyjson_mut_doc* doc, JsonUti
     }
 
     JsonUtils::JsonMutVal* payload = nullptr;
-    if(!CopyRawJsonToMutableValue(doc, component.payloadJson, payload, outError, "payload", false)){
+    if(component.payloadValue){
+        payload = yyjson_val_mut_copy(doc, component.payloadValue.get());
+        if(!payload){
+            SetDocSchemaError(outError, "Failed to copy cooked component payload.");
+            return false;
+        }
+    }else if(!CopyRawJsonToMutableValue(doc, component.payloadJson, payload, outError, "payload", false)){
         return false;
     }
     if(!yyjson_mut_obj_add_val(doc, obj, "payload", payload)){
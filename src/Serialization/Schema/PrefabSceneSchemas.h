@@ -7,6 +7,7 @@
 #define SERIALIZATION_SCHEMA_PREFAB_SCENE_SCHEMAS_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -58,6 +59,9 @@ class EntitySnapshotSchemaBase : public ISchema {
             std::string type;
             int version = 1;
             std::string payloadJson = "{}"; // Raw JSON payload serialized as compact text.
+            // Payload already decoded from a cooked file; when set it is used instead of payloadJson.
+            // Shares ownership of the document that holds it.
+            std::shared_ptr<JsonUtils::JsonVal> payloadValue;
         };
 
         /// @brief Holds data for EntityRecord.
@@ -79,6 +83,24 @@ class EntitySnapshotSchemaBase : public ISchema {
          */
         void ClearSnapshot();
 
+        /**
+         * @brief Derives missing root ids and validates the snapshot and document fields.
+         *
+         * DeserializePayload() runs this after reading JSON; loaders that fill the schema
+         * directly (cooked documents) must run it themselves.
+         * @param outError Output value for error.
+         * @return True when the operation succeeds; otherwise false.
+         */
+        bool ValidateLoadedState(std::string* outError);
+
+        /**
+         * @brief Compares two component payloads, whether held as JSON text or as a cooked value.
+         * @param a First component.
+         * @param b Second component.
+         * @return True when both payloads serialize to the same compact JSON.
+         */
+        static bool ComponentPayloadsEqual(const ComponentRecord& a, const ComponentRecord& b);
+
     protected:
         /**
          * @brief Deserializes payload.